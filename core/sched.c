@@ -32,6 +32,10 @@
 #include "mpu.h"
 #endif
 
+#ifdef MODULE_SCHEDLATENCY
+#include "schedlatency.h"
+#endif
+
 #define ENABLE_DEBUG (0)
 #include "debug.h"
 
@@ -89,6 +93,12 @@ int __attribute__((used)) sched_run(void)
     thread_t *next_thread = container_of(sched_runqueues[nextrq].next->next,
                                          thread_t, rq_entry);
 
+#ifdef MODULE_SCHEDLATENCY
+    /* before the check below, the active thread might have been woken up
+     * again before it was switched away from */
+    schedlatency_scheduled(next_thread->pid);
+#endif
+
     DEBUG(
         "sched_run: active thread: %" PRIkernel_pid ", next thread: %" PRIkernel_pid "\n",
         (kernel_pid_t)((active_thread == NULL)
@@ -154,6 +164,9 @@ void sched_set_status(thread_t *process, thread_status_t status)
             clist_rpush(&sched_runqueues[process->priority],
                         &(process->rq_entry));
             runqueue_bitcache |= 1 << process->priority;
+#ifdef MODULE_SCHEDLATENCY
+            schedlatency_woken(process->pid);
+#endif
         }
     }
     else {
@@ -50,6 +50,13 @@ extern "C" {
 #endif /* OS */
 /** @} */
 
+/**
+ * @brief   Use the compiler builtin for bitarithm_lsb()
+ *
+ * This is used e.g. by the scheduler to find the highest priority run queue.
+ */
+#define BITARITHM_LSB_BUILTIN
+
 /**
  * @brief   Native internal Ethernet protocol number
  */
@@ -44,6 +44,8 @@ typedef struct netdev_tap {
     int tap_fd;                         /**< host file descriptor for the TAP */
     uint8_t addr[ETHERNET_ADDR_LEN];    /**< The MAC address of the TAP */
     uint8_t promiscuous;                 /**< Flag for promiscuous mode */
+    uint8_t rx_drain;                   /**< Flag for draining mode, see
+                                             @ref NETOPT_RX_DRAIN */
 } netdev_tap_t;
 
 /**
@@ -40,14 +40,19 @@ typedef struct {
     netdev_event_t last_event;      /**< event triggered */
     uint32_t seq;                   /**< ZEP sequence number */
     /**
-     * @brief   Receive buffer
+     * @brief   Buffer for receive header
+     *
+     * The frame itself is read directly into the buffer provided to
+     * netdev_driver_t::recv() or netdev_driver_t::recv_iolist().
      */
-    uint8_t rcv_buf[sizeof(zep_v2_data_hdr_t) + IEEE802154_FRAME_LEN_MAX];
+    uint8_t rcv_buf[sizeof(zep_v2_data_hdr_t)];
     /**
      * @brief   Buffer for send header
      */
     uint8_t snd_hdr_buf[sizeof(zep_v2_data_hdr_t)];
     uint16_t chksum_buf;            /**< buffer for send checksum calculation */
+    uint8_t rx_drain;               /**< Flag for draining mode, see
+                                         @ref NETOPT_RX_DRAIN */
 } socket_zep_t;
 
 /**
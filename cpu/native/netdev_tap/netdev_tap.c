@@ -68,6 +68,7 @@
 static int _init(netdev_t *netdev);
 static int _send(netdev_t *netdev, const iolist_t *iolist);
 static int _recv(netdev_t *netdev, void *buf, size_t n, void *info);
+static int _recv_iolist(netdev_t *netdev, const iolist_t *iolist, void *info);
 
 static inline void _get_mac_addr(netdev_t *netdev, uint8_t *dst)
 {
@@ -124,6 +125,11 @@ static int _get(netdev_t *dev, netopt_t opt, void *value, size_t max_len)
             *((bool*)value) = (bool)_get_promiscous(dev);
             res = sizeof(bool);
             break;
+        case NETOPT_RX_DRAIN:
+            *((netopt_enable_t *)value) = ((netdev_tap_t *)dev)->rx_drain
+                                        ? NETOPT_ENABLE : NETOPT_DISABLE;
+            res = sizeof(netopt_enable_t);
+            break;
         default:
             res = netdev_eth_get(dev, opt, value, max_len);
             break;
@@ -147,6 +153,12 @@ static int _set(netdev_t *dev, netopt_t opt, const void *value, size_t value_len
             _set_promiscous(dev, ((const bool *)value)[0]);
             res = sizeof(netopt_enable_t);
             break;
+        case NETOPT_RX_DRAIN:
+            /* _recv() returns -1 on EAGAIN */
+            ((netdev_tap_t *)dev)->rx_drain =
+                (*((const netopt_enable_t *)value) == NETOPT_ENABLE);
+            res = sizeof(netopt_enable_t);
+            break;
         default:
             res = netdev_eth_set(dev, opt, value, value_len);
             break;
@@ -162,16 +174,17 @@ static const netdev_driver_t netdev_driver_tap = {
     .isr = _isr,
     .get = _get,
     .set = _set,
+    .recv_iolist = _recv_iolist,
 };
 
 /* driver implementation */
-static inline bool _is_addr_broadcast(uint8_t *addr)
+static inline bool _is_addr_broadcast(const uint8_t *addr)
 {
     return ((addr[0] == 0xff) && (addr[1] == 0xff) && (addr[2] == 0xff) &&
             (addr[3] == 0xff) && (addr[4] == 0xff) && (addr[5] == 0xff));
 }
 
-static inline bool _is_addr_multicast(uint8_t *addr)
+static inline bool _is_addr_multicast(const uint8_t *addr)
 {
     /* source: http://ieee802.org/secmail/pdfocSP2xXA6d.pdf */
     return (addr[0] & 0x01);
@@ -204,6 +217,49 @@ static void _continue_reading(netdev_tap_t *dev)
     _native_in_syscall--;
 }
 
+/* handles the result of reading a frame with destination address dst */
+static int _recv_done(netdev_tap_t *dev, int nread, const uint8_t *dst)
+{
+    if (nread > 0) {
+        if (!(dev->promiscuous) && !_is_addr_multicast(dst) &&
+            !_is_addr_broadcast(dst) &&
+            (memcmp(dst, dev->addr, ETHERNET_ADDR_LEN) != 0)) {
+            DEBUG("netdev_tap: received for %02x:%02x:%02x:%02x:%02x:%02x\n"
+                  "That's not me => Dropped\n",
+                  dst[0], dst[1], dst[2], dst[3], dst[4], dst[5]);
+
+            native_async_read_continue(dev->tap_fd);
+
+            return 0;
+        }
+
+        /* when draining, the reader calls recv() until EAGAIN, which
+         * re-arms the asynchronous read */
+        if (!dev->rx_drain) {
+            _continue_reading(dev);
+        }
+
+        return nread;
+    }
+    else if (nread == -1) {
+        if ((errno == EAGAIN) || (errno == EWOULDBLOCK)) {
+            /* device was drained */
+            native_async_read_continue(dev->tap_fd);
+        }
+        else {
+            err(EXIT_FAILURE, "netdev_tap: read");
+        }
+    }
+    else if (nread == 0) {
+        DEBUG("_native_handle_tap_input: ignoring null-event\n");
+    }
+    else {
+        errx(EXIT_FAILURE, "internal error _rx_event");
+    }
+
+    return -1;
+}
+
 static int _recv(netdev_t *netdev, void *buf, size_t len, void *info)
 {
     netdev_tap_t *dev = (netdev_tap_t*)netdev;
@@ -237,40 +293,25 @@ static int _recv(netdev_t *netdev, void *buf, size_t len, void *info)
     int nread = real_read(dev->tap_fd, buf, len);
     DEBUG("netdev_tap: read %d bytes\n", nread);
 
-    if (nread > 0) {
-        ethernet_hdr_t *hdr = (ethernet_hdr_t *)buf;
-        if (!(dev->promiscuous) && !_is_addr_multicast(hdr->dst) &&
-            !_is_addr_broadcast(hdr->dst) &&
-            (memcmp(hdr->dst, dev->addr, ETHERNET_ADDR_LEN) != 0)) {
-            DEBUG("netdev_tap: received for %02x:%02x:%02x:%02x:%02x:%02x\n"
-                  "That's not me => Dropped\n",
-                  hdr->dst[0], hdr->dst[1], hdr->dst[2],
-                  hdr->dst[3], hdr->dst[4], hdr->dst[5]);
-
-            native_async_read_continue(dev->tap_fd);
+    return _recv_done(dev, nread, ((ethernet_hdr_t *)buf)->dst);
+}
 
-            return 0;
-        }
+static int _recv_iolist(netdev_t *netdev, const iolist_t *iolist, void *info)
+{
+    netdev_tap_t *dev = (netdev_tap_t*)netdev;
+    struct iovec iov[iolist_count(iolist)];
+    uint8_t dst[ETHERNET_ADDR_LEN] = { 0 };
+    unsigned n;
+    (void)info;
 
-        _continue_reading(dev);
+    iolist_to_iovec(iolist, iov, &n);
+    int nread = real_readv(dev->tap_fd, iov, n);
+    DEBUG("netdev_tap: read %d bytes into %u buffers\n", nread, n);
 
-        return nread;
-    }
-    else if (nread == -1) {
-        if ((errno == EAGAIN) || (errno == EWOULDBLOCK)) {
-        }
-        else {
-            err(EXIT_FAILURE, "netdev_tap: read");
-        }
-    }
-    else if (nread == 0) {
-        DEBUG("_native_handle_tap_input: ignoring null-event\n");
-    }
-    else {
-        errx(EXIT_FAILURE, "internal error _rx_event");
+    if (nread > 0) {
+        iolist_copy(iolist, dst, sizeof(dst));
     }
-
-    return -1;
+    return _recv_done(dev, nread, dst);
 }
 
 static int _send(netdev_t *netdev, const iolist_t *iolist)
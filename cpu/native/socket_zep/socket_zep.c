@@ -174,14 +174,106 @@ static inline bool _dst_not_me(socket_zep_t *dev, const void *buf)
     }
 }
 
+static int _recv_iolist(netdev_t *netdev, const iolist_t *iolist, void *info)
+{
+    socket_zep_t *dev = (socket_zep_t *)netdev;
+    unsigned n = iolist_count(iolist);
+    /* ZEP header, frame, and space for the FCS if it does not fit the frame
+     * buffers: the frame is read directly into the buffers of iolist */
+    struct iovec v[n + 2];
+    uint16_t fcs;
+    size_t len;
+    int size;
+
+    DEBUG("socket_zep::recv_iolist(%p, %p, %u, %p)\n", (void *)netdev,
+          (void *)iolist, n, (void *)info);
+    v[0].iov_base = dev->rcv_buf;
+    v[0].iov_len = sizeof(dev->rcv_buf);
+    len = iolist_to_iovec(iolist, &v[1], &n);
+    v[n + 1].iov_base = &fcs;
+    v[n + 1].iov_len = sizeof(fcs);
+    size = real_readv(dev->sock_fd, v, n + 2);
+
+    if (size > 0) {
+        zep_hdr_t *tmp = (zep_hdr_t *)&dev->rcv_buf;
+        uint8_t mhr[IEEE802154_MAX_HDR_LEN];
+
+        if (((unsigned)size < sizeof(zep_hdr_t)) ||
+            (tmp->preamble[0] != 'E') || (tmp->preamble[1] != 'X')) {
+            DEBUG("socket_zep::recv: invalid ZEP header");
+            size = -1;
+            goto out;
+        }
+        switch (tmp->version) {
+            case 2: {
+                zep_v2_data_hdr_t *zep = (zep_v2_data_hdr_t *)tmp;
+
+                if (zep->type != ZEP_V2_TYPE_DATA) {
+                    DEBUG("socket_zep::recv: unexpected ZEP type\n");
+                    /* don't support ACK frames for now*/
+                    size = -1;
+                    goto out;
+                }
+                iolist_copy(iolist, mhr, sizeof(mhr));
+                /* the FCS is not handed to the stack, so it only needs to fit
+                 * the frame buffers and the fcs slot together */
+                if (((sizeof(zep_v2_data_hdr_t) + zep->length) != (unsigned)size) ||
+                    (zep->length < sizeof(fcs)) ||
+                    (zep->length > (len + sizeof(fcs))) ||
+                    (zep->chan != dev->netdev.chan) ||
+                    /* TODO promiscuous mode */
+                    _dst_not_me(dev, mhr)) {
+                    /* TODO: check checksum */
+                    size = -1;
+                    goto out;
+                }
+                /* don't hand FCS to stack */
+                size = zep->length - sizeof(uint16_t);
+                if (info != NULL) {
+                    struct netdev_radio_rx_info *rx_info = info;
+                    rx_info->lqi = zep->lqi_val;
+                    rx_info->rssi = UINT8_MAX;
+                }
+                break;
+            }
+            default:
+                DEBUG("socket_zep::recv: unexpected ZEP version\n");
+                size = -1;
+                goto out;
+        }
+    }
+    else if (size == 0) {
+        DEBUG("socket_zep::recv: ignoring null-event\n");
+        size = -1;
+    }
+    else if (size == -1) {
+        if ((errno == EAGAIN) || (errno == EWOULDBLOCK)) {
+        }
+        else {
+            err(EXIT_FAILURE, "zep: read");
+        }
+    }
+    else {
+        errx(EXIT_FAILURE, "internal error _rx_event");
+    }
+out:
+    /* when draining, the reader calls recv() until no frame is pending,
+     * which re-arms the asynchronous read */
+    if (!dev->rx_drain || (size <= 0)) {
+        _continue_reading(dev);
+    }
+
+    return size;
+}
+
 static int _recv(netdev_t *netdev, void *buf, size_t len, void *info)
 {
     socket_zep_t *dev = (socket_zep_t *)netdev;
-    int size = 0;
 
     DEBUG("socket_zep::recv(%p, %p, %u, %p)\n", (void *)netdev, buf,
           (unsigned)len, (void *)info);
     if ((buf == NULL) || (len == 0)) {
+        int size = 0;
         int res = real_ioctl(dev->sock_fd, FIONREAD, &size);
 #if ENABLE_DEBUG
         if (res < 0) {
@@ -191,70 +283,17 @@ static int _recv(netdev_t *netdev, void *buf, size_t len, void *info)
 #else
         (void)res;
 #endif
+        if (dev->rx_drain && (size == 0)) {
+            /* drained */
+            _continue_reading(dev);
+        }
         return size;
     }
-    else if (len > 0) {
-        size = real_read(dev->sock_fd, dev->rcv_buf, sizeof(dev->rcv_buf));
-
-        if (size > 0) {
-            zep_hdr_t *tmp = (zep_hdr_t *)&dev->rcv_buf;
+    else {
+        iolist_t iol = { .iol_base = buf, .iol_len = len };
 
-            if ((tmp->preamble[0] != 'E') || (tmp->preamble[1] != 'X')) {
-                DEBUG("socket_zep::recv: invalid ZEP header");
-                return -1;
-            }
-            switch (tmp->version) {
-                case 2: {
-                    zep_v2_data_hdr_t *zep = (zep_v2_data_hdr_t *)tmp;
-                    void *payload = &dev->rcv_buf[sizeof(zep_v2_data_hdr_t)];
-
-                    if (zep->type != ZEP_V2_TYPE_DATA) {
-                        DEBUG("socket_zep::recv: unexpected ZEP type\n");
-                        /* don't support ACK frames for now*/
-                        return -1;
-                    }
-                    if (((sizeof(zep_v2_data_hdr_t) + zep->length) != (unsigned)size) ||
-                        (zep->length > len) || (zep->chan != dev->netdev.chan) ||
-                        /* TODO promiscuous mode */
-                        _dst_not_me(dev, payload)) {
-                        /* TODO: check checksum */
-                        return -1;
-                    }
-                    /* don't hand FCS to stack */
-                    size = zep->length - sizeof(uint16_t);
-                    if (buf != NULL) {
-                        memcpy(buf, payload, size);
-                        if (info != NULL) {
-                            struct netdev_radio_rx_info *rx_info = info;
-                            rx_info->lqi = zep->lqi_val;
-                            rx_info->rssi = UINT8_MAX;
-                        }
-                    }
-                    break;
-                }
-                default:
-                    DEBUG("socket_zep::recv: unexpected ZEP version\n");
-                    return -1;
-            }
-        }
-        else if (size == 0) {
-            DEBUG("socket_zep::recv: ignoring null-event\n");
-            return -1;
-        }
-        else if (size == -1) {
-            if ((errno == EAGAIN) || (errno == EWOULDBLOCK)) {
-            }
-            else {
-                err(EXIT_FAILURE, "zep: read");
-            }
-        }
-        else {
-            errx(EXIT_FAILURE, "internal error _rx_event");
-        }
+        return _recv_iolist(netdev, &iol, info);
     }
-    _continue_reading(dev);
-
-    return size;
 }
 
 static void _isr(netdev_t *netdev)
@@ -302,15 +341,33 @@ static int _init(netdev_t *netdev)
 static int _get(netdev_t *netdev, netopt_t opt, void *value, size_t max_len)
 {
     assert(netdev != NULL);
-    return netdev_ieee802154_get((netdev_ieee802154_t *)netdev, opt, value, max_len);
+    switch (opt) {
+        case NETOPT_RX_DRAIN:
+            assert(max_len >= sizeof(netopt_enable_t));
+            *((netopt_enable_t *)value) = ((socket_zep_t *)netdev)->rx_drain
+                                        ? NETOPT_ENABLE : NETOPT_DISABLE;
+            return sizeof(netopt_enable_t);
+        default:
+            return netdev_ieee802154_get((netdev_ieee802154_t *)netdev, opt,
+                                         value, max_len);
+    }
 }
 
 static int _set(netdev_t *netdev, netopt_t opt, const void *value,
                 size_t value_len)
 {
     assert(netdev != NULL);
-    return netdev_ieee802154_set((netdev_ieee802154_t *)netdev, opt,
-                                  value, value_len);
+    switch (opt) {
+        case NETOPT_RX_DRAIN:
+            /* _recv() returns FIONREAD, i.e. 0 if no frame is pending */
+            assert(value_len >= sizeof(netopt_enable_t));
+            ((socket_zep_t *)netdev)->rx_drain =
+                (*((const netopt_enable_t *)value) == NETOPT_ENABLE);
+            return sizeof(netopt_enable_t);
+        default:
+            return netdev_ieee802154_set((netdev_ieee802154_t *)netdev, opt,
+                                         value, value_len);
+    }
 }
 
 static const netdev_driver_t socket_zep_driver = {
@@ -320,6 +377,7 @@ static const netdev_driver_t socket_zep_driver = {
     .isr = _isr,
     .get = _get,
     .set = _set,
+    .recv_iolist = _recv_iolist,
 };
 
 void socket_zep_setup(socket_zep_t *dev, const socket_zep_params_t *params)
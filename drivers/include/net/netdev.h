@@ -427,6 +427,33 @@ typedef struct netdev_driver {
      */
     int (*set)(netdev_t *dev, netopt_t opt,
                const void *value, size_t value_len);
+
+    /**
+     * @brief   Get a received frame, scattered over multiple buffers
+     *
+     * @pre `(dev != NULL) && (iolist != NULL)`
+     *
+     * Optional, may be NULL. Does the same as
+     * @ref netdev_driver_t::recv "recv()" with `buf != NULL`, but writes the
+     * frame into the buffers of @p iolist in order. This allows a network
+     * stack to receive the link-layer header and the payload of a frame
+     * directly into separate buffers, e.g. into the packet buffer, without
+     * copying the frame afterwards.
+     *
+     * As for @ref netdev_driver_t::recv "recv()", the size of the frame can
+     * be retrieved beforehand by calling `recv(dev, NULL, 0, NULL)`.
+     *
+     * @param[in]   dev     network device descriptor. Must not be NULL.
+     * @param[in]   iolist  buffers to write into. Elements of this list may
+     *                      have iolist_t::iol_len == 0.
+     * @param[out]  info    status information for the received packet. Might
+     *                      be of different type for different netdev devices.
+     *                      May be NULL if not needed or applicable.
+     *
+     * @return number of bytes read
+     * @return `< 0` on error
+     */
+    int (*recv_iolist)(netdev_t *dev, const iolist_t *iolist, void *info);
 } netdev_driver_t;
 
 /**
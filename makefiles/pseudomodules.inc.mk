@@ -38,14 +38,21 @@ PSEUDOMODULES += gnrc_pktbuf_cmd
 PSEUDOMODULES += gnrc_netif_6lo
 PSEUDOMODULES += gnrc_netif_ipv6
 PSEUDOMODULES += gnrc_netif_mac
+PSEUDOMODULES += gnrc_netif_rx_batch
+PSEUDOMODULES += gnrc_netif_txq
 PSEUDOMODULES += gnrc_netif_cmd_%
 PSEUDOMODULES += gnrc_netif_dedup
+PSEUDOMODULES += gnrc_netif_etx
+PSEUDOMODULES += gnrc_netreg_hash
 PSEUDOMODULES += gnrc_nettype_%
+PSEUDOMODULES += gnrc_rpl_mrhof
+PSEUDOMODULES += gnrc_rpl_source_routing
 PSEUDOMODULES += gnrc_sixloenc
 PSEUDOMODULES += gnrc_sixlowpan_border_router_default
 PSEUDOMODULES += gnrc_sixlowpan_default
 PSEUDOMODULES += gnrc_sixlowpan_frag_hint
 PSEUDOMODULES += gnrc_sixlowpan_iphc_nhc
+PSEUDOMODULES += gnrc_sixlowpan_iphc_ref
 PSEUDOMODULES += gnrc_sixlowpan_nd_border_router
 PSEUDOMODULES += gnrc_sixlowpan_router
 PSEUDOMODULES += gnrc_sixlowpan_router_default
@@ -19,6 +19,7 @@
 
 #include "byteorder.h"
 #include "evproc.h"
+#include "iolist.h"
 #include "msg.h"
 #include "mutex.h"
 #include "net/af.h"
@@ -38,13 +39,16 @@ typedef struct {
     struct udp_socket *sock;
     const sock_udp_ep_t *remote;
     int res;
-    const void *data;
+    const iolist_t *snips;
     size_t len;
 } _send_cmd_t;
 
 extern uint16_t uip_slen;
 
 static bool send_registered = false;
+/* udp_socket_send() takes the payload from a single buffer, messages
+ * gathered from several buffers are assembled here in emb6 thread context */
+static uint8_t _send_buf[UIP_BUFSIZE - (UIP_LLH_LEN + UIP_IPUDPH_LEN)];
 
 static void _timeout_callback(void *arg);
 static void _input_callback(struct udp_socket *c, void *ptr,
@@ -200,15 +204,25 @@ int sock_udp_recv(sock_udp_t *sock, void *data, size_t max_len,
 
 int sock_udp_send(sock_udp_t *sock, const void *data, size_t len,
                   const sock_udp_ep_t *remote)
+{
+    const iolist_t snip = { NULL, (void *)data, len };
+
+    assert((len == 0) || (data != NULL));   /* (len != 0) => (data != NULL) */
+
+    return sock_udp_sendv(sock, &snip, remote);
+}
+
+ssize_t sock_udp_sendv(sock_udp_t *sock, const iolist_t *snips,
+                       const sock_udp_ep_t *remote)
 {
     struct udp_socket tmp;
+    size_t len = iolist_size(snips);
     _send_cmd_t send_cmd = { .block = MUTEX_INIT,
                              .remote = remote,
-                             .data = data,
+                             .snips = snips,
                              .len = len };
 
     assert((sock != NULL) || (remote != NULL));
-    assert((len == 0) || (data != NULL));   /* (len != 0) => (data != NULL) */
     /* we want the send in the uip thread (which udp_socket_send does not offer)
      * so we need to do it manually */
     if (!send_registered) {
@@ -305,17 +319,28 @@ static void _output_callback(c_event_t c_event, p_data_t p_data)
     }
 
     _send_cmd_t *send_cmd = (_send_cmd_t *)p_data;
+    const iolist_t *snips = send_cmd->snips;
+    const void *data = NULL;
 
+    if ((snips != NULL) && (snips->iol_next == NULL)) {
+        /* a single buffer is sent as is */
+        data = snips->iol_base;
+    }
+    else if (snips != NULL) {
+        /* send_cmd->len was previously checked to fit */
+        iolist_copy(snips, _send_buf, send_cmd->len);
+        data = _send_buf;
+    }
     if (send_cmd->remote != NULL) {
         /* send_cmd->len was previously checked */
-        send_cmd->res = udp_socket_sendto(send_cmd->sock, send_cmd->data,
+        send_cmd->res = udp_socket_sendto(send_cmd->sock, data,
                                           (uint16_t)send_cmd->len,
                                           (uip_ipaddr_t *)&send_cmd->remote->addr,
                                           send_cmd->remote->port);
     }
     else {
         /* send_cmd->len was previously checked */
-        send_cmd->res = udp_socket_send(send_cmd->sock, send_cmd->data,
+        send_cmd->res = udp_socket_send(send_cmd->sock, data,
                                         (uint16_t)send_cmd->len);
     }
     send_cmd->res = (send_cmd->res < 0) ? -EHOSTUNREACH : send_cmd->res;
@@ -19,6 +19,7 @@
 #include "net/ipv4/addr.h"
 #include "net/ipv6/addr.h"
 #include "net/sock.h"
+#include "iolist.h"
 #include "timex.h"
 
 #include "lwip/err.h"
@@ -562,6 +563,14 @@ int lwip_sock_recv(struct netconn *conn, uint32_t timeout, struct netbuf **buf)
 
 ssize_t lwip_sock_send(struct netconn *conn, const void *data, size_t len,
                        int proto, const struct _sock_tl_ep *remote, int type)
+{
+    const iolist_t snip = { NULL, (void *)data, len };
+
+    return lwip_sock_sendv(conn, &snip, proto, remote, type);
+}
+
+ssize_t lwip_sock_sendv(struct netconn *conn, const iolist_t *snips,
+                        int proto, const struct _sock_tl_ep *remote, int type)
 {
     ip_addr_t remote_addr;
     struct netconn *tmp;
@@ -569,6 +578,7 @@ ssize_t lwip_sock_send(struct netconn *conn, const void *data, size_t len,
     int res;
     err_t err;
     u16_t remote_port = 0;
+    size_t len = iolist_size(snips);
 
 #if LWIP_IPV6
     assert(!(type & NETCONN_TYPE_IPV6));
@@ -585,11 +595,20 @@ ssize_t lwip_sock_send(struct netconn *conn, const void *data, size_t len,
     }
 
     buf = netbuf_new();
-    if ((buf == NULL) || (netbuf_alloc(buf, len) == NULL) ||
-        (netbuf_take(buf, data, len) != ERR_OK)) {
+    if ((buf == NULL) || (netbuf_alloc(buf, len) == NULL)) {
         netbuf_delete(buf);
         return -ENOMEM;
     }
+    /* gather all snips into the netbuf's pbuf chain */
+    for (size_t offset = 0; snips != NULL; snips = snips->iol_next) {
+        if ((snips->iol_len > 0) &&
+            (pbuf_take_at(buf->p, snips->iol_base, snips->iol_len,
+                          offset) != ERR_OK)) {
+            netbuf_delete(buf);
+            return -ENOMEM;
+        }
+        offset += snips->iol_len;
+    }
     if ((conn == NULL) && (remote != NULL)) {
         if ((res = _create(type, proto, 0, &tmp)) < 0) {
             netbuf_delete(buf);
@@ -618,7 +637,10 @@ ssize_t lwip_sock_send(struct netconn *conn, const void *data, size_t len,
     }
 #if LWIP_TCP
     else if (tmp->type & NETCONN_TCP) {
-        err = netconn_write_partly(tmp, data, len, 0, (size_t *)(&res));
+        /* netconn_write_partly() copies from contiguous memory, so hand it
+         * the gathered netbuf */
+        err = netconn_write_partly(tmp, buf->p->payload, len, 0,
+                                   (size_t *)(&res));
     }
 #endif /* LWIP_TCP */
     else {
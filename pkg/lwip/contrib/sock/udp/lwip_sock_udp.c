@@ -14,6 +14,7 @@
  */
 
 #include <errno.h>
+#include <string.h>
 
 #include "net/ipv4/addr.h"
 #include "net/ipv6/addr.h"
@@ -21,6 +22,7 @@
 #include "timex.h"
 
 #include "lwip/api.h"
+#include "lwip/pbuf.h"
 #include "lwip/opt.h"
 #include "lwip/sys.h"
 #include "lwip/sock_internal.h"
@@ -164,6 +166,59 @@ ssize_t sock_udp_send(sock_udp_t *sock, const void *data, size_t len,
                           (struct _sock_tl_ep *)remote, NETCONN_UDP);
 }
 
+ssize_t sock_udp_sendv(sock_udp_t *sock, const iolist_t *snips,
+                       const sock_udp_ep_t *remote)
+{
+    assert((sock != NULL) || (remote != NULL));
+
+    if ((remote != NULL) && (remote->port == 0)) {
+        return -EINVAL;
+    }
+    return lwip_sock_sendv((sock) ? sock->base.conn : NULL, snips, 0,
+                           (struct _sock_tl_ep *)remote, NETCONN_UDP);
+}
+
+int sock_udp_buf_resize(void **data, void **ctx, size_t size)
+{
+    struct netbuf *buf;
+
+    assert((data != NULL) && (ctx != NULL) && (*ctx != NULL));
+    buf = *ctx;
+    if (buf->p->next != NULL) {
+        return -ENOTSUP;
+    }
+    if (size <= buf->p->len) {
+        pbuf_realloc(buf->p, size);
+    }
+    else {
+        struct pbuf *p = pbuf_alloc(PBUF_TRANSPORT, size, PBUF_RAM);
+
+        if (p == NULL) {
+            return -ENOMEM;
+        }
+        memcpy(p->payload, buf->p->payload, buf->p->len);
+        pbuf_free(buf->p);
+        buf->p = p;
+    }
+    buf->ptr = buf->p;
+    *data = buf->p->payload;
+    return 0;
+}
+
+ssize_t sock_udp_send_buf(sock_udp_t *sock, void *ctx, size_t len,
+                          const sock_udp_ep_t *remote)
+{
+    struct netbuf *buf = ctx;
+    ssize_t res;
+
+    assert(((sock != NULL) || (remote != NULL)) && (ctx != NULL));
+    assert(len <= buf->p->len);
+    /* lwip_sock_send() puts the data into a new netbuf */
+    res = sock_udp_send(sock, buf->p->payload, len, remote);
+    netbuf_delete(buf);
+    return res;
+}
+
 #ifdef SOCK_HAS_ASYNC
 void sock_udp_set_cb(sock_udp_t *sock, sock_udp_cb_t cb, void *arg)
 {
@@ -49,6 +49,11 @@ void auto_init(void)
         extern void init_schedstatistics(void);
         init_schedstatistics();
     }
+    if (IS_USED(MODULE_SCHEDLATENCY)) {
+        LOG_DEBUG("Auto init schedlatency.\n");
+        extern void init_schedlatency(void);
+        init_schedlatency();
+    }
     if (IS_USED(MODULE_DUMMY_THREAD)) {
         extern void dummy_thread_create(void);
         dummy_thread_create();
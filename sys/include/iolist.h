@@ -82,6 +82,17 @@ struct iovec;
  */
 size_t iolist_to_iovec(const iolist_t *iolist, struct iovec *iov, unsigned *count);
 
+/**
+ * @brief   Copies the first bytes of an iolist into a buffer
+ *
+ * @param[in]   iolist  iolist to copy from
+ * @param[out]  buf     buffer to copy to
+ * @param[in]   len     number of bytes to copy
+ *
+ * @return  number of bytes copied, less than @p len if the iolist is shorter
+ */
+size_t iolist_copy(const iolist_t *iolist, void *buf, size_t len);
+
 #ifdef __cplusplus
 }
 #endif
@@ -67,6 +67,11 @@
  * reuses the request buffer. See `examples/gcoap/gcoap_cli.c` for a simple
  * example of a callback.
  *
+ * The request is received and the response is built and sent within the
+ * buffer space of the network stack (see sock_udp_recv_buf() and
+ * sock_udp_send_buf()), which provides CONFIG_GCOAP_PDU_BUF_SIZE bytes for
+ * the response. Requests larger than that are dropped.
+ *
  * Here is the expected sequence for a callback function:
  *
  * Read request completely and parse request payload, if any. Use the
@@ -149,6 +149,18 @@ extern "C" {
 #define CONFIG_GNRC_IPV6_MSG_QUEUE_SIZE_EXP    (3U)
 #endif
 
+/**
+ * @brief   Number of entries in the route cache of the IPv6 thread
+ *
+ * The route cache maps recently used destination addresses to the next hop
+ * returned by @ref gnrc_ipv6_nib_get_next_hop_l2addr(), so steady flows
+ * only need to take the NIB's lock when the NIB changed (see
+ * @ref gnrc_ipv6_nib_gen()). Set to 0 to disable the route cache.
+ */
+#ifndef CONFIG_GNRC_IPV6_ROUTE_CACHE_SIZE
+#define CONFIG_GNRC_IPV6_ROUTE_CACHE_SIZE      (0U)
+#endif
+
 #ifdef DOXYGEN
 /**
  * @brief   Add a static IPv6 link local address to any network interface
@@ -217,6 +229,27 @@ extern fib_table_t gnrc_ipv6_fib_table;
  */
 kernel_pid_t gnrc_ipv6_init(void);
 
+#if (CONFIG_GNRC_IPV6_ROUTE_CACHE_SIZE > 0) || DOXYGEN
+/**
+ * @brief   Statistics of the route cache
+ *
+ * @note    Only available if @ref CONFIG_GNRC_IPV6_ROUTE_CACHE_SIZE > 0
+ */
+typedef struct {
+    uint32_t hits;      /**< lookups answered from the route cache */
+    uint32_t misses;    /**< lookups that needed to ask the NIB */
+} gnrc_ipv6_route_cache_stats_t;
+
+/**
+ * @brief   Gets the statistics of the route cache
+ *
+ * @note    Only available if @ref CONFIG_GNRC_IPV6_ROUTE_CACHE_SIZE > 0
+ *
+ * @param[out] stats    The statistics of the route cache.
+ */
+void gnrc_ipv6_route_cache_get_stats(gnrc_ipv6_route_cache_stats_t *stats);
+#endif  /* CONFIG_GNRC_IPV6_ROUTE_CACHE_SIZE > 0 */
+
 /**
  * @brief   Get the IPv6 header from a given list of @ref gnrc_pktsnip_t
  *
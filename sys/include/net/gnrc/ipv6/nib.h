@@ -327,6 +327,23 @@ int gnrc_ipv6_nib_get_next_hop_l2addr(const ipv6_addr_t *dst,
                                       gnrc_netif_t *netif, gnrc_pktsnip_t *pkt,
                                       gnrc_ipv6_nib_nc_t *nce);
 
+/**
+ * @brief   Gets the current generation of the NIB
+ *
+ * The generation changes whenever the forwarding table, the prefix list,
+ * the default router list or the neighbor cache change in a way that might
+ * change the result of @ref gnrc_ipv6_nib_get_next_hop_l2addr(). A result
+ * obtained with the NIB at a given generation can be reused without asking
+ * the NIB again for as long as the generation did not change.
+ *
+ * @note    Read the generation **before** calling
+ *          @ref gnrc_ipv6_nib_get_next_hop_l2addr() so a concurrent change is
+ *          never missed.
+ *
+ * @return  The current generation of the NIB.
+ */
+uint32_t gnrc_ipv6_nib_gen(void);
+
 /**
  * @brief   Handles a received ICMPv6 packet
  *
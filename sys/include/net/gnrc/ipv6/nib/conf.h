@@ -216,6 +216,19 @@ extern "C" {
 #endif
 /** @} */
 
+/**
+ * @brief   Index the NIB for lookups
+ *
+ * Keeps a hash table over the on-link entries and a prefix trie over the
+ * off-link entries, so neighbor cache and forwarding table lookups do not need
+ * to search all entries. This pays off for large values of
+ * @ref CONFIG_GNRC_IPV6_NIB_NUMOF and @ref CONFIG_GNRC_IPV6_NIB_OFFL_NUMOF, e.g.
+ * on border routers, at the cost of some additional RAM.
+ */
+#ifndef CONFIG_GNRC_IPV6_NIB_INDEX
+#define CONFIG_GNRC_IPV6_NIB_INDEX                    0
+#endif
+
 /**
  * @brief   Reset time in milliseconds for the reachability time
  *
@@ -261,6 +274,15 @@ extern "C" {
 #define CONFIG_GNRC_IPV6_NIB_NUMOF                   (4)
 #endif
 
+/**
+ * @brief   Number of hash buckets for the on-link entries
+ *
+ * @note    Only used if @ref CONFIG_GNRC_IPV6_NIB_INDEX != 0.
+ */
+#ifndef CONFIG_GNRC_IPV6_NIB_ONL_HASH_SIZE
+#define CONFIG_GNRC_IPV6_NIB_ONL_HASH_SIZE           (CONFIG_GNRC_IPV6_NIB_NUMOF)
+#endif
+
 /**
  * @brief   Number of off-link entries in NIB
  *
@@ -47,7 +47,13 @@
 #if defined(MODULE_GNRC_NETIF_DEDUP) && (GNRC_NETIF_L2ADDR_MAXLEN > 0)
 #include "net/gnrc/netif/dedup.h"
 #endif
+#if IS_USED(MODULE_GNRC_NETIF_ETX) && (GNRC_NETIF_L2ADDR_MAXLEN > 0)
+#include "net/gnrc/netif/etx.h"
+#endif
 #include "net/gnrc/netif/flags.h"
+#if IS_USED(MODULE_GNRC_NETIF_TXQ)
+#include "net/gnrc/netif/txq.h"
+#endif
 #if IS_USED(MODULE_GNRC_NETIF_IPV6)
 #include "net/gnrc/netif/ipv6.h"
 #endif
@@ -130,6 +136,14 @@ typedef struct {
      * @see net_gnrc_netif_flags
      */
     uint32_t flags;
+#if IS_USED(MODULE_GNRC_NETIF_TXQ) || defined(DOXYGEN)
+    /**
+     * @brief   Queue of packets to send
+     *
+     * @note    Only available with @ref net_gnrc_netif_txq.
+     */
+    gnrc_netif_txq_t txq;
+#endif
 #if IS_USED(MODULE_GNRC_NETIF_EVENTS) || defined(DOXYGEN)
     /**
      * @brief   Event queue for asynchronous events
@@ -163,6 +177,14 @@ typedef struct {
      */
     gnrc_netif_dedup_t last_pkt;
 #endif
+#if IS_USED(MODULE_GNRC_NETIF_ETX) || DOXYGEN
+    /**
+     * @brief   ETX estimates for the neighbors of the interface
+     *
+     * @note    Only available with @ref net_gnrc_netif_etx.
+     */
+    gnrc_netif_etx_t etx;
+#endif
 #endif
 #if IS_USED(MODULE_GNRC_NETIF_6LO) || defined(DOXYGEN)
     gnrc_netif_6lo_t sixlo;                 /**< 6Lo component */
@@ -587,6 +609,42 @@ char *gnrc_netif_addr_to_str(const uint8_t *addr, size_t addr_len, char *out);
  */
 size_t gnrc_netif_addr_from_str(const char *str, uint8_t *out);
 
+#if IS_USED(MODULE_GNRC_NETIF_TXQ) || defined(DOXYGEN)
+/**
+ * @brief   Puts a packet into the send queue of an interface
+ *
+ * @note    Only available with @ref net_gnrc_netif_txq. Use
+ *          gnrc_netif_send() instead.
+ *
+ * @param[in] netif     The network interface.
+ * @param[in] pkt       Packet to send.
+ *
+ * @return  1 if the packet was queued.
+ * @return  0 if the queue is full. @p pkt is not released in that case.
+ */
+int gnrc_netif_txq_put(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt);
+#endif
+
+#if (IS_USED(MODULE_GNRC_NETIF_ETX) && (GNRC_NETIF_L2ADDR_MAXLEN > 0)) || \
+    defined(DOXYGEN)
+/**
+ * @brief   Gets the expected transmission count (ETX) to a neighbor
+ *
+ * @note    Only available with @ref net_gnrc_netif_etx.
+ *
+ * @param[in] netif         The network interface.
+ * @param[in] l2addr        Link-layer address of the neighbor.
+ * @param[in] l2addr_len    Length of @p l2addr.
+ *
+ * @return  The ETX to the neighbor as multiple of
+ *          @ref GNRC_NETIF_ETX_DIVISOR.
+ * @return  @ref GNRC_NETIF_ETX_UNKNOWN, if nothing was sent to the neighbor
+ *          yet.
+ */
+uint16_t gnrc_netif_etx_get(gnrc_netif_t *netif, const uint8_t *l2addr,
+                            size_t l2addr_len);
+#endif
+
 /**
  * @brief   Send a GNRC packet via a given @ref gnrc_netif_t interface.
  *
@@ -594,11 +652,18 @@ size_t gnrc_netif_addr_from_str(const char *str, uint8_t *out);
  * @param pkt           packet to be sent.
  *
  * @return              1 if packet was successfully delivered
+ * @return              0 if the message queue (or with
+ *                      @ref net_gnrc_netif_txq the send queue) of the
+ *                      interface is full
  * @return              -1 on error
  */
 static inline int gnrc_netif_send(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt)
 {
+#if IS_USED(MODULE_GNRC_NETIF_TXQ)
+    return gnrc_netif_txq_put(netif, pkt);
+#else
     return gnrc_netapi_send(netif->pid, pkt);
+#endif
 }
 
 #if defined(MODULE_GNRC_NETIF_BUS) || DOXYGEN
@@ -20,6 +20,10 @@
 
 #include <stdint.h>
 
+#ifdef MODULE_GNRC_SIXLOWPAN_CTX
+#include "net/gnrc/sixlowpan/ctx.h"
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -35,6 +39,17 @@ typedef struct {
      *          @ref net_gnrc_sixlowpan_frag "gnrc_sixlowpan_frag".
      */
     uint16_t max_frag_size;
+#if (defined(MODULE_GNRC_SIXLOWPAN_CTX) && \
+     (CONFIG_GNRC_SIXLOWPAN_CTX_CACHE_SIZE > 0)) || defined(DOXYGEN)
+    /**
+     * @brief   Cache for context look-ups of header compression
+     *
+     * @note    Only available with module
+     *          @ref net_gnrc_sixlowpan_ctx "gnrc_sixlowpan_ctx" and
+     *          @ref CONFIG_GNRC_SIXLOWPAN_CTX_CACHE_SIZE > 0.
+     */
+    gnrc_sixlowpan_ctx_cache_t ctx_cache;
+#endif
 } gnrc_netif_6lo_t;
 
 #ifdef __cplusplus
@@ -26,6 +26,7 @@
 #include "net/ethernet/hdr.h"
 #include "net/gnrc/ipv6/nib/conf.h"
 #include "thread.h"
+#include "timex.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -156,6 +157,21 @@ extern "C" {
 #ifndef CONFIG_GNRC_NETIF_MIN_WAIT_AFTER_SEND_US
 #define CONFIG_GNRC_NETIF_MIN_WAIT_AFTER_SEND_US   (0U)
 #endif
+
+/**
+ * @brief   Maximum number of frames received in one go
+ *
+ * With the `gnrc_netif_rx_batch` module, all frames pending at a device
+ * supporting @ref NETOPT_RX_DRAIN are received on a single
+ * @ref NETDEV_EVENT_RX_COMPLETE, up to this limit, before they are passed
+ * on to the upper layers.
+ *
+ * @note    Every frame of a batch is held in the packet buffer until the batch
+ *          is complete.
+ */
+#ifndef CONFIG_GNRC_NETIF_RX_BATCH_SIZE
+#define CONFIG_GNRC_NETIF_RX_BATCH_SIZE            (8U)
+#endif
 /** @} */
 
 /**
@@ -165,6 +181,49 @@ extern "C" {
 #define GNRC_NETIF_MSG_QUEUE_SIZE   (1 << CONFIG_GNRC_NETIF_MSG_QUEUE_SIZE_EXP)
 #endif
 
+/**
+ * @brief   Default send queue size for network interfaces (as exponent of
+ *          2^n)
+ *
+ *          Only used with @ref net_gnrc_netif_txq. As the queue size ALWAYS
+ *          needs to be power of two, this option represents the exponent of
+ *          2^n, which will be used as the size of the queue.
+ */
+#ifndef CONFIG_GNRC_NETIF_TXQ_SIZE_EXP
+#define CONFIG_GNRC_NETIF_TXQ_SIZE_EXP  (3U)
+#endif
+
+/**
+ * @brief   Send queue size for network interfaces
+ */
+#ifndef GNRC_NETIF_TXQ_SIZE
+#define GNRC_NETIF_TXQ_SIZE         (1 << CONFIG_GNRC_NETIF_TXQ_SIZE_EXP)
+#endif
+
+/**
+ * @brief   Time in microseconds to wait for the device to report the end of a
+ *          transmission
+ *
+ *          Only used with @ref net_gnrc_netif_txq and devices supporting
+ *          @ref NETOPT_TX_END_IRQ. Once it passed, the next queued packet is
+ *          sent even though the end of the previous transmission was not
+ *          reported.
+ */
+#ifndef CONFIG_GNRC_NETIF_TXQ_TX_END_TIMEOUT_US
+#define CONFIG_GNRC_NETIF_TXQ_TX_END_TIMEOUT_US (100U * US_PER_MS)
+#endif
+
+/**
+ * @brief   Number of neighbors per network interface the expected
+ *          transmission count is estimated for
+ *
+ *          Only used with @ref net_gnrc_netif_etx. If the table is full, the
+ *          neighbor sent to least recently is replaced.
+ */
+#ifndef CONFIG_GNRC_NETIF_ETX_NUMOF
+#define CONFIG_GNRC_NETIF_ETX_NUMOF (8U)
+#endif
+
 /**
  * @brief   Enable the usage of non standard MTU for 6LoWPAN network interfaces
  *
@@ -0,0 +1,134 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_netif_etx  Link quality estimation
+ * @ingroup     net_gnrc_netif
+ * @brief       Estimates the expected transmission count (ETX) to neighbors
+ *
+ * To activate, use `USEMODULE += gnrc_netif_etx` in your applications
+ * Makefile.
+ *
+ * The interface remembers the link-layer destination of every unicast frame
+ * it sends. When the device reports the result of the transmission, a sample
+ * of the number of transmissions needed is taken: the retries reported by
+ * @ref NETOPT_TX_RETRIES_NEEDED plus one if the frame was acknowledged,
+ * @ref GNRC_NETIF_ETX_NOACK_PENALTY if it was not. The estimate is an
+ * exponentially weighted moving average of these samples.
+ *
+ * Devices not reporting the number of retries are assumed to need none, so
+ * devices without link-layer acknowledgements always have an ETX of 1.
+ *
+ * @note    The result of a transmission is attributed to the frame sent
+ *          last, so devices reporting it after the next frame was sent
+ *          distort the estimate.
+ *
+ * @see     gnrc_netif_etx_get()
+ *
+ * @{
+ *
+ * @file
+ * @brief   Definitions for link quality estimation
+ */
+#ifndef NET_GNRC_NETIF_ETX_H
+#define NET_GNRC_NETIF_ETX_H
+
+#include <stdint.h>
+
+#include "net/gnrc/netif/conf.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Fixed-point divisor of an ETX value
+ *
+ * An ETX of 1.5 is represented as 192, as in the ETX reliability object of
+ * RPL.
+ *
+ * @see <a href="https://tools.ietf.org/html/rfc6551#section-4.3.2">
+ *          RFC 6551, section 4.3.2
+ *      </a>
+ */
+#define GNRC_NETIF_ETX_DIVISOR          (128U)
+
+/**
+ * @brief   ETX value of a neighbor with no estimate yet
+ */
+#define GNRC_NETIF_ETX_UNKNOWN          (0U)
+
+/**
+ * @brief   Number of transmissions assumed for a frame that was not
+ *          acknowledged
+ */
+#ifndef GNRC_NETIF_ETX_NOACK_PENALTY
+#define GNRC_NETIF_ETX_NOACK_PENALTY    (6U)
+#endif
+
+/**
+ * @brief   Weight of a new sample as 2^-n
+ */
+#ifndef GNRC_NETIF_ETX_EWMA_SHIFT
+#define GNRC_NETIF_ETX_EWMA_SHIFT       (3U)
+#endif
+
+/**
+ * @brief   ETX estimate for a neighbor
+ */
+typedef struct {
+    uint8_t l2addr[GNRC_NETIF_L2ADDR_MAXLEN];   /**< address of the neighbor */
+    uint8_t l2addr_len;                         /**< 0 for unused entries */
+    uint16_t etx;                               /**< ETX estimate */
+    uint16_t last_used;                         /**< time of the last frame
+                                                 *   sent to the neighbor in
+                                                 *   gnrc_netif_etx_t::clock */
+} gnrc_netif_etx_entry_t;
+
+/**
+ * @brief   ETX estimates of an interface
+ */
+typedef struct {
+    /**
+     * @brief   Estimates per neighbor
+     */
+    gnrc_netif_etx_entry_t entries[CONFIG_GNRC_NETIF_ETX_NUMOF];
+    /**
+     * @brief   Neighbor of the frame currently sent, NULL if none
+     */
+    gnrc_netif_etx_entry_t *pending;
+    uint16_t clock;                             /**< number of unicast frames
+                                                 *   sent */
+} gnrc_netif_etx_t;
+
+/**
+ * @brief   Updates an ETX estimate with a new sample
+ *
+ * @param[in] etx       The current estimate, @ref GNRC_NETIF_ETX_UNKNOWN if
+ *                      there is none yet.
+ * @param[in] sample    Transmissions needed for the last frame as multiple
+ *                      of @ref GNRC_NETIF_ETX_DIVISOR.
+ *
+ * @return  The exponentially weighted moving average of @p etx and
+ *          @p sample, @p sample if @p etx is unknown.
+ */
+static inline uint16_t gnrc_netif_etx_update(uint16_t etx, uint16_t sample)
+{
+    if (etx == GNRC_NETIF_ETX_UNKNOWN) {
+        return sample;
+    }
+    return (uint16_t)(((uint32_t)etx * ((1U << GNRC_NETIF_ETX_EWMA_SHIFT) - 1) +
+                       sample) >> GNRC_NETIF_ETX_EWMA_SHIFT);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_GNRC_NETIF_ETX_H */
+/** @} */
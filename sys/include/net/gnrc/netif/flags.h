@@ -135,6 +135,14 @@ enum {
  */
 #define GNRC_NETIF_FLAGS_6LO                       (0x00002000U)
 
+/**
+ * @brief   Pending frames are drained from the device in one go
+ *
+ * Set on start-up if the `gnrc_netif_rx_batch` module is used and the device
+ * supports @ref NETOPT_RX_DRAIN.
+ */
+#define GNRC_NETIF_FLAGS_RX_BATCH                  (0x00004000U)
+
 /**
  * @brief   Network interface is configured in raw mode
  */
@@ -40,6 +40,12 @@ extern "C" {
  */
 #define NETDEV_MSG_TYPE_EVENT   (0x1234)
 
+/**
+ * @brief   Message type to continue receiving frames in batches after
+ *          @ref CONFIG_GNRC_NETIF_RX_BATCH_SIZE frames
+ */
+#define GNRC_NETIF_RX_BATCH_MSG_TYPE    (0x0208)
+
 /**
  * @brief   Acquires exclusive access to the interface
  *
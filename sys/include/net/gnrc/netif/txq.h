@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_netif_txq  Send queue
+ * @ingroup     net_gnrc_netif
+ * @brief       Per-interface queue for outgoing packets
+ *
+ * To activate, use `USEMODULE += gnrc_netif_txq` in your applications
+ * Makefile.
+ *
+ * With this module, gnrc_netif_send() puts the packet into a ring buffer of
+ * the interface instead of sending a @ref GNRC_NETAPI_MSG_TYPE_SND message to
+ * the interface's thread. The thread is only woken up when the queue was
+ * empty. This way the sender does not wait for the interface's thread to
+ * handle a message per packet, and a burst of packets does not fill up the
+ * thread's message queue while the device is busy sending.
+ *
+ * The thread sends the queued packets one at a time and handles the device's
+ * events in between. If the device reports the end of a transmission
+ * (@ref NETOPT_TX_END_IRQ), the next packet is only sent once the previous
+ * one is done. If no such event arrives within
+ * @ref CONFIG_GNRC_NETIF_TXQ_TX_END_TIMEOUT_US, the thread stops waiting and
+ * sends the next packet anyway.
+ *
+ * Packets not fitting into the queue are dropped and counted in
+ * netstats_t::tx_dropped if `netstats_l2` is used.
+ *
+ * @{
+ *
+ * @file
+ * @brief   Definitions for the per-interface send queue
+ */
+#ifndef NET_GNRC_NETIF_TXQ_H
+#define NET_GNRC_NETIF_TXQ_H
+
+#include <stdbool.h>
+
+#include "cib.h"
+#include "msg.h"
+#include "net/gnrc/netif/conf.h"
+#include "net/gnrc/pkt.h"
+#include "xtimer.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Message type to wake up the interface thread to empty its send
+ *          queue
+ */
+#define GNRC_NETIF_TXQ_MSG_TYPE     (0x0207)
+
+/**
+ * @brief   Message type to stop waiting for the end of a transmission the
+ *          device did not report
+ */
+#define GNRC_NETIF_TXQ_TIMEOUT_MSG_TYPE (0x0209)
+
+/**
+ * @brief   Send queue of an interface
+ */
+typedef struct {
+    cib_t cib;                                  /**< index of the queue */
+    gnrc_pktsnip_t *pkts[GNRC_NETIF_TXQ_SIZE];  /**< queued packets */
+    bool tx_end_irq;                            /**< device reports the end
+                                                 *   of a transmission */
+    bool busy;                                  /**< waiting for the end of
+                                                 *   a transmission */
+    xtimer_t timer;                             /**< timeout for the end of
+                                                 *   a transmission */
+    msg_t timeout_msg;                          /**< message of
+                                                 *   gnrc_netif_txq_t::timer,
+                                                 *   its value counts the
+                                                 *   transmissions */
+} gnrc_netif_txq_t;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_GNRC_NETIF_TXQ_H */
+/** @} */
@@ -10,6 +10,17 @@
  * @defgroup    net_gnrc_netreg  Network protocol registry
  * @ingroup     net_gnrc
  * @brief       Registry to receive messages of a specified protocol type by GNRC.
+ *
+ * By default, the entries of every @ref gnrc_nettype_t are kept in a list,
+ * which is searched for the demultiplexing context on every lookup. With many
+ * registered entries of the same type (e.g. many UDP sockets) the
+ * `gnrc_netreg_hash` pseudo-module can be used instead (`USEMODULE +=
+ * gnrc_netreg_hash`). It keeps the entries in a hash table of
+ * @ref GNRC_NETREG_HASH_SIZE buckets indexed by type and demultiplexing
+ * context, so a lookup only walks the entries sharing a bucket. The semantics
+ * of gnrc_netreg_lookup() and gnrc_netreg_getnext() stay the same, at the
+ * cost of an additional field in @ref gnrc_netreg_entry_t.
+ *
  * @{
  *
  * @file
@@ -72,6 +83,25 @@ typedef enum {
 } gnrc_netreg_type_t;
 #endif
 
+/**
+ * @brief   Size of the hash table of @ref net_gnrc_netreg (as exponent of
+ *          2^n)
+ *
+ *          Only used with `gnrc_netreg_hash`. As the table size ALWAYS needs
+ *          to be power of two, this option represents the exponent of 2^n,
+ *          which will be used as the number of buckets of the table.
+ */
+#ifndef CONFIG_GNRC_NETREG_HASH_SIZE_EXP
+#define CONFIG_GNRC_NETREG_HASH_SIZE_EXP    (4U)
+#endif
+
+/**
+ * @brief   Number of buckets of the hash table of @ref net_gnrc_netreg
+ */
+#ifndef GNRC_NETREG_HASH_SIZE
+#define GNRC_NETREG_HASH_SIZE               (1 << CONFIG_GNRC_NETREG_HASH_SIZE_EXP)
+#endif
+
 /**
  * @brief   Demux context value to get all packets of a certain type.
  *
@@ -84,6 +114,17 @@ typedef enum {
  * @anchor  net_gnrc_netreg_init_static
  * @{
  */
+/**
+ * @brief   Initializer of gnrc_netreg_entry_t::nettype, if present
+ *
+ * @internal
+ */
+#if defined(MODULE_GNRC_NETREG_HASH)
+#define GNRC_NETREG_ENTRY_INIT_NETTYPE  , GNRC_NETTYPE_UNDEF
+#else
+#define GNRC_NETREG_ENTRY_INIT_NETTYPE
+#endif
+
 /**
  * @brief   Initializes a netreg entry statically with PID
  *
@@ -96,9 +137,11 @@ typedef enum {
 #if defined(MODULE_GNRC_NETAPI_MBOX) || defined(MODULE_GNRC_NETAPI_CALLBACKS)
 #define GNRC_NETREG_ENTRY_INIT_PID(demux_ctx, pid)  { NULL, demux_ctx, \
                                                       GNRC_NETREG_TYPE_DEFAULT, \
-                                                      { pid } }
+                                                      { pid } \
+                                                      GNRC_NETREG_ENTRY_INIT_NETTYPE }
 #else
-#define GNRC_NETREG_ENTRY_INIT_PID(demux_ctx, pid)  { NULL, demux_ctx, { pid } }
+#define GNRC_NETREG_ENTRY_INIT_PID(demux_ctx, pid)  { NULL, demux_ctx, { pid } \
+                                                      GNRC_NETREG_ENTRY_INIT_NETTYPE }
 #endif
 
 #if defined(MODULE_GNRC_NETAPI_MBOX) || defined(DOXYGEN)
@@ -115,7 +158,8 @@ typedef enum {
  */
 #define GNRC_NETREG_ENTRY_INIT_MBOX(demux_ctx, _mbox) { NULL, demux_ctx, \
                                                        GNRC_NETREG_TYPE_MBOX, \
-                                                       { .mbox = _mbox } }
+                                                       { .mbox = _mbox } \
+                                                       GNRC_NETREG_ENTRY_INIT_NETTYPE }
 #endif
 
 #if defined(MODULE_GNRC_NETAPI_CALLBACKS) || defined(DOXYGEN)
@@ -132,7 +176,8 @@ typedef enum {
  */
 #define GNRC_NETREG_ENTRY_INIT_CB(demux_ctx, _cbd)   { NULL, demux_ctx, \
                                                       GNRC_NETREG_TYPE_CB, \
-                                                      { .cbd = _cbd } }
+                                                      { .cbd = _cbd } \
+                                                      GNRC_NETREG_ENTRY_INIT_NETTYPE }
 /** @} */
 
 /**
@@ -210,6 +255,17 @@ typedef struct gnrc_netreg_entry {
         gnrc_netreg_entry_cbd_t *cbd;
 #endif
     } target;                   /**< Target for the registry entry */
+#if defined(MODULE_GNRC_NETREG_HASH) || defined(DOXYGEN)
+    /**
+     * @brief   Type of the protocol the entry is registered for
+     *
+     * @internal
+     *
+     * @note    Only available with `gnrc_netreg_hash`. Set by
+     *          gnrc_netreg_register().
+     */
+    gnrc_nettype_t nettype;
+#endif
 } gnrc_netreg_entry_t;
 
 /**
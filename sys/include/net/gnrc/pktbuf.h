@@ -62,6 +62,64 @@ extern "C" {
 #ifndef CONFIG_GNRC_PKTBUF_SIZE
 #define CONFIG_GNRC_PKTBUF_SIZE    (6144)
 #endif
+
+/**
+ * @brief   Number of packet snip descriptors in the `gnrc_pktbuf_slab`
+ *          packet buffer
+ */
+#ifndef CONFIG_GNRC_PKTBUF_SLAB_SNIP_NUMOF
+#define CONFIG_GNRC_PKTBUF_SLAB_SNIP_NUMOF      (40U)
+#endif
+
+/**
+ * @brief   Block size of the header size class of `gnrc_pktbuf_slab`
+ *
+ * @details Sized to fit a @ref gnrc_netif_hdr_t with two long link-layer
+ *          addresses and the IPv6 header
+ */
+#ifndef CONFIG_GNRC_PKTBUF_SLAB_HDR_SIZE
+#define CONFIG_GNRC_PKTBUF_SLAB_HDR_SIZE        (48U)
+#endif
+
+/**
+ * @brief   Number of blocks in the header size class of `gnrc_pktbuf_slab`
+ */
+#ifndef CONFIG_GNRC_PKTBUF_SLAB_HDR_NUMOF
+#define CONFIG_GNRC_PKTBUF_SLAB_HDR_NUMOF       (24U)
+#endif
+
+/**
+ * @brief   Block size of the small payload size class of `gnrc_pktbuf_slab`
+ */
+#ifndef CONFIG_GNRC_PKTBUF_SLAB_SMALL_SIZE
+#define CONFIG_GNRC_PKTBUF_SLAB_SMALL_SIZE      (256U)
+#endif
+
+/**
+ * @brief   Number of blocks in the small payload size class of
+ *          `gnrc_pktbuf_slab`
+ */
+#ifndef CONFIG_GNRC_PKTBUF_SLAB_SMALL_NUMOF
+#define CONFIG_GNRC_PKTBUF_SLAB_SMALL_NUMOF     (8U)
+#endif
+
+/**
+ * @brief   Block size of the large payload size class of `gnrc_pktbuf_slab`
+ *
+ * @details This is the maximum size of a single packet snip. The default fits
+ *          a full Ethernet frame.
+ */
+#ifndef CONFIG_GNRC_PKTBUF_SLAB_LARGE_SIZE
+#define CONFIG_GNRC_PKTBUF_SLAB_LARGE_SIZE      (1536U)
+#endif
+
+/**
+ * @brief   Number of blocks in the large payload size class of
+ *          `gnrc_pktbuf_slab`
+ */
+#ifndef CONFIG_GNRC_PKTBUF_SLAB_LARGE_NUMOF
+#define CONFIG_GNRC_PKTBUF_SLAB_LARGE_NUMOF     (2U)
+#endif
 /** @} */
 
 /**
@@ -301,7 +359,9 @@ int gnrc_pktbuf_merge(gnrc_pktsnip_t *pkt);
  *
  * @note    Only available with DEVELHELP defined.
  *
- * @details Statistics include maximum number of reserved bytes.
+ * @details Statistics include maximum number of reserved bytes. For
+ *          `gnrc_pktbuf_slab` the current occupancy and the high-water mark of
+ *          every size class are printed.
  */
 void gnrc_pktbuf_stats(void);
 #endif
@@ -24,6 +24,17 @@
  *   USEMODULE += gnrc_rpl
  *   ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
  *
+ * - Source routing in non-storing mode: nodes send their DAOs straight to
+ *   the root, which keeps the downward routes and sends packets with a
+ *   source routing header. Needs to be used on **all** nodes of a DODAG,
+ *   the root needs the @ref net_gnrc_rpl_sr_table "source routing table"
+ *   (which pulls in this module). Without it, DAOs travel hop by hop in
+ *   non-storing mode as well.
+ *   ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ {.mk}
+ *   USEMODULE += gnrc_rpl_source_routing   # all other nodes
+ *   USEMODULE += gnrc_rpl_sr_table         # root
+ *   ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *
  * - RPL auto-initialization on interface
  *   ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ {.mk}
  *   USEMODULE += auto_init_gnrc_rpl
@@ -204,15 +215,63 @@ extern "C" {
 #define CONFIG_GNRC_RPL_DEFAULT_MAX_RANK_INCREASE (0)
 #endif
 
+/**
+ * @name Objective Code Points
+ * @see <a href="https://www.iana.org/assignments/rpl/rpl.xhtml#ocp">
+ *          IANA, Objective Code Point (OCP)
+ *      </a>
+ * @{
+ */
+#define GNRC_RPL_OCP_OF0        (0x0)   /**< Objective Function Zero */
+#define GNRC_RPL_OCP_MRHOF      (0x1)   /**< Minimum Rank with Hysteresis OF */
+/** @} */
+
 /**
  * @brief   Number of implemented Objective Functions
  */
+#if IS_USED(MODULE_GNRC_RPL_MRHOF)
+#define GNRC_RPL_IMPLEMENTED_OFS_NUMOF (2)
+#else
 #define GNRC_RPL_IMPLEMENTED_OFS_NUMOF (1)
+#endif
+
+/**
+ * @brief   Default Objective Code Point
+ *
+ * MRHOF if the `gnrc_rpl_mrhof` module is used, OF0 otherwise
+ */
+#ifndef GNRC_RPL_DEFAULT_OCP
+#if IS_USED(MODULE_GNRC_RPL_MRHOF)
+#define GNRC_RPL_DEFAULT_OCP GNRC_RPL_OCP_MRHOF
+#else
+#define GNRC_RPL_DEFAULT_OCP GNRC_RPL_OCP_OF0
+#endif
+#endif
+
+/**
+ * @brief   Path cost difference in rank units (ETX * 128) by which a parent
+ *          must be better than the preferred parent to replace it with
+ *          MRHOF
+ *
+ * Changes of the path cost via the preferred parent below this threshold do
+ * not change the rank of the node either, so a fluctuating link does not
+ * reset the DIO trickle timer all the time.
+ *
+ * @see <a href="https://tools.ietf.org/html/rfc6719#section-5">
+ *          RFC 6719, section 5
+ *      </a>
+ */
+#ifndef CONFIG_GNRC_RPL_MRHOF_PARENT_SWITCH_THRESHOLD
+#define CONFIG_GNRC_RPL_MRHOF_PARENT_SWITCH_THRESHOLD   (192)
+#endif
 
 /**
- * @brief   Default Objective Code Point (OF0)
+ * @brief   ETX in rank units (ETX * 128) MRHOF assumes for links nothing was
+ *          sent over yet
  */
-#define GNRC_RPL_DEFAULT_OCP (0)
+#ifndef CONFIG_GNRC_RPL_MRHOF_INIT_ETX
+#define CONFIG_GNRC_RPL_MRHOF_INIT_ETX                  (256)
+#endif
 
 /**
  * @brief   Default Instance ID
@@ -0,0 +1,173 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_rpl_sr_table RPL source routing table
+ * @ingroup     net_gnrc_rpl
+ * @brief       Downward routes of a RPL root in non-storing mode
+ *
+ * To activate, use `USEMODULE += gnrc_rpl_sr_table` in your applications
+ * Makefile. All other nodes of the DODAG need to use the
+ * `gnrc_rpl_source_routing` module, so they report their parent to the root
+ * and can forward source routed packets.
+ *
+ * In non-storing mode every node reports its preferred parent to the root
+ * in the Transit Information option of its DAO. The root keeps one entry per
+ * node that points to the entry of its parent, so the table grows linearly
+ * with the number of nodes while the whole DODAG shares the entries of the
+ * nodes close to the root. Entries are found by a hash of their address, the
+ * source route to a node is the chain of parent pointers from its entry up to
+ * the root.
+ *
+ * The root inserts a @ref net_gnrc_rpl_srh "source routing header" into the
+ * unicast packets it sends to nodes more than one hop away. Packets the root
+ * forwards are routed by the NIB as before.
+ *
+ * @see <a href="https://tools.ietf.org/html/rfc6550#section-9.7">
+ *          RFC 6550, section 9.7
+ *      </a>
+ * @see <a href="https://tools.ietf.org/html/rfc6554">
+ *          RFC 6554
+ *      </a>
+ *
+ * @{
+ *
+ * @file
+ * @brief   Definitions for the RPL source routing table
+ */
+#ifndef NET_GNRC_RPL_SR_TABLE_H
+#define NET_GNRC_RPL_SR_TABLE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "net/gnrc/pkt.h"
+#include "net/gnrc/rpl/srh.h"
+#include "net/ipv6/addr.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup net_gnrc_rpl_sr_table_conf RPL source routing table compile
+ *                                      configurations
+ * @ingroup config
+ * @{
+ */
+/**
+ * @brief   Maximum number of nodes in the table
+ *
+ * Nodes that are only known as the parent of another node occupy an entry as
+ * well.
+ */
+#ifndef CONFIG_GNRC_RPL_SR_TABLE_SIZE
+#define CONFIG_GNRC_RPL_SR_TABLE_SIZE       (32U)
+#endif
+
+/**
+ * @brief   Maximum number of hops of a source route, not counting the root
+ */
+#ifndef CONFIG_GNRC_RPL_SR_TABLE_MAX_HOPS
+#define CONFIG_GNRC_RPL_SR_TABLE_MAX_HOPS   (16U)
+#endif
+/** @} */
+
+/**
+ * @brief   Adds a node to the table or updates its parent
+ *
+ * Targets of the same Transit Information option are expected to be added
+ * one after the other: the entry of the parent is only looked up again when
+ * @p parent changes.
+ *
+ * @param[in] target    Address of the node.
+ * @param[in] parent    Address of the preferred parent of the node. NULL if
+ *                      the parent is the root.
+ * @param[in] lifetime  Lifetime of the route in seconds.
+ *
+ * @return  0 on success.
+ * @return  -ENOMEM if the table is full.
+ * @return  -EINVAL if @p target is a descendant of @p parent already (the
+ *          new route would contain a loop).
+ */
+int gnrc_rpl_sr_table_add(const ipv6_addr_t *target, const ipv6_addr_t *parent,
+                          uint32_t lifetime);
+
+/**
+ * @brief   Removes the route to a node
+ *
+ * The routes to the descendants of the node are invalid until they report a
+ * new parent.
+ *
+ * @param[in] target    Address of the node.
+ */
+void gnrc_rpl_sr_table_del(const ipv6_addr_t *target);
+
+/**
+ * @brief   Removes all routes
+ */
+void gnrc_rpl_sr_table_reset(void);
+
+/**
+ * @brief   Gets the source route to a node
+ *
+ * @param[in] dst       Address of the node.
+ * @param[out] hops     The hops of the route, starting with the child of the
+ *                      root and ending with @p dst.
+ * @param[in] max_hops  Number of addresses @p hops has space for.
+ *
+ * @return  Number of hops in @p hops.
+ * @return  -ENOENT if there is no valid route to @p dst.
+ * @return  -ENOBUFS if the route has more than @p max_hops hops.
+ */
+int gnrc_rpl_sr_table_get_route(const ipv6_addr_t *dst, ipv6_addr_t *hops,
+                                unsigned max_hops);
+
+/**
+ * @brief   Builds the source routing header of a packet to a node
+ *
+ * The addresses in the header are compressed against the first hop, as
+ * described in RFC 6554, section 3.
+ *
+ * @param[in] dst           Destination of the packet.
+ * @param[out] srh          The source routing header. Its next header field is
+ *                          left to the caller.
+ * @param[in] srh_len       Size of @p srh in bytes.
+ * @param[out] first_hop    The first hop of the route, the destination
+ *                          address of the IPv6 header.
+ *
+ * @return  Size of the header in @p srh in bytes.
+ * @return  0 if @p dst is a child of the root and needs no header.
+ * @return  -ENOENT if there is no valid route to @p dst.
+ * @return  -ENOBUFS if the header does not fit into @p srh.
+ */
+int gnrc_rpl_sr_table_build_srh(const ipv6_addr_t *dst, gnrc_rpl_srh_t *srh,
+                                size_t srh_len, ipv6_addr_t *first_hop);
+
+/**
+ * @brief   Inserts a source routing header into a packet sent by the root
+ *
+ * The destination address of the IPv6 header is left unchanged, so the
+ * payload checksum is still calculated over the final destination. Set it to
+ * @p first_hop after the checksum was calculated.
+ *
+ * @param[in] ipv6          The IPv6 header of the packet, write-protected.
+ * @param[out] first_hop    The first hop of the route.
+ *
+ * @return  1 if a header was inserted.
+ * @return  0 if the packet needs no header.
+ * @return  -ENOMEM if the packet buffer is full.
+ */
+int gnrc_rpl_sr_table_insert_srh(gnrc_pktsnip_t *ipv6, ipv6_addr_t *first_hop);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_GNRC_RPL_SR_TABLE_H */
+/** @} */
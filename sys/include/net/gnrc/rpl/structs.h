@@ -292,6 +292,8 @@ typedef struct {
     /**
      * @brief Reset the state of the objective function.
      *
+     * Called when all parents of @p dodag are removed.
+     *
      * @param[in]   dodag   RPL dodag object.
      */
     void (*reset)(gnrc_rpl_dodag_t *dodag);
@@ -164,9 +164,7 @@ extern "C" {
  * @see     https://tools.ietf.org/html/draft-ietf-lwig-6lowpan-virtual-reassembly-01
  *
  * @note    Only applicable with
- *          [gnrc_sixlowpan_frag_vrb](@ref net_gnrc_sixlowpan_frag_vrb) module,
- *          but has also a direct influence on the number of available
- *          gnrc_sixlowpan_frag_rb_int_t entries.
+ *          [gnrc_sixlowpan_frag_vrb](@ref net_gnrc_sixlowpan_frag_vrb) module
  */
 #ifndef CONFIG_GNRC_SIXLOWPAN_FRAG_VRB_SIZE
 #define CONFIG_GNRC_SIXLOWPAN_FRAG_VRB_SIZE        (16U)
@@ -184,6 +182,38 @@ extern "C" {
 #define CONFIG_GNRC_SIXLOWPAN_FRAG_VRB_TIMEOUT_US  (CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_TIMEOUT_US)
 #endif  /* CONFIG_GNRC_SIXLOWPAN_FRAG_VRB_TIMEOUT_US */
 
+/**
+ * @brief   Minimum idle time in microseconds of a VRB entry before it may be
+ *          evicted
+ *
+ * When the VRB is full, the least recently used entry is evicted for a new
+ * datagram, provided no fragment was forwarded with it for at least this
+ * time. Set to @ref CONFIG_GNRC_SIXLOWPAN_FRAG_VRB_TIMEOUT_US or larger to
+ * only free entries by timeout.
+ *
+ * @note    Only applicable with
+ *          [gnrc_sixlowpan_frag_vrb](@ref net_gnrc_sixlowpan_frag_vrb) module.
+ */
+#ifndef CONFIG_GNRC_SIXLOWPAN_FRAG_VRB_EVICT_IDLE_US
+#define CONFIG_GNRC_SIXLOWPAN_FRAG_VRB_EVICT_IDLE_US   (CONFIG_GNRC_SIXLOWPAN_FRAG_VRB_TIMEOUT_US / 4)
+#endif  /* CONFIG_GNRC_SIXLOWPAN_FRAG_VRB_EVICT_IDLE_US */
+
+/**
+ * @brief   Number of context look-up results cached per interface for header
+ *          compression
+ *
+ * IPHC looks up the context for both the source and the destination address
+ * of every packet it compresses. The results for the last addresses are kept
+ * per interface until the context buffer changes. Set to 0 to disable the
+ * cache.
+ *
+ * @note    Only applicable with
+ *          [gnrc_sixlowpan_ctx](@ref net_gnrc_sixlowpan_ctx) module.
+ */
+#ifndef CONFIG_GNRC_SIXLOWPAN_CTX_CACHE_SIZE
+#define CONFIG_GNRC_SIXLOWPAN_CTX_CACHE_SIZE       (2U)
+#endif  /* CONFIG_GNRC_SIXLOWPAN_CTX_CACHE_SIZE */
+
 /**
  * @name Selective fragment recovery configuration
  * @see  [draft-ietf-6lo-fragment-recovery-07, section 7.1]
@@ -220,10 +250,15 @@ extern "C" {
 /**
  * @brief   Indicates whether the sender should react to ECN (UseECN)
  *
- * When the sender reacts to ECN its window size will vary between @ref
- * GNRC_SIXLOWPAN_SFR_MIN_WIN_SIZE and @ref GNRC_SIXLOWPAN_SFR_MAX_WIN_SIZE.
+ * The window size of the sender varies between @ref
+ * GNRC_SIXLOWPAN_SFR_MIN_WIN_SIZE and @ref GNRC_SIXLOWPAN_SFR_MAX_WIN_SIZE
+ * depending on the losses it observes. When the sender reacts to ECN, it
+ * also shrinks its window when an acknowledgment echoes a congestion
+ * notification.
  */
+#ifndef GNRC_SIXLOWPAN_SFR_USE_ECN
 #define GNRC_SIXLOWPAN_SFR_USE_ECN          (0U)
+#endif
 
 /**
  * @brief   Default minimum value of window size that the sender can use
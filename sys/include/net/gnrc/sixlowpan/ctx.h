@@ -29,6 +29,7 @@
 #include <inttypes.h>
 #include <stdbool.h>
 
+#include "net/gnrc/sixlowpan/config.h"
 #include "net/ipv6/addr.h"
 
 #ifdef __cplusplus
@@ -67,6 +68,8 @@ typedef struct {
     /**
      * @brief   Lifetime in minutes this context is valid.
      *
+     * @note    Refreshed once per minute, not on every look-up.
+     *
      * @see     <a href="http://tools.ietf.org/html/rfc6775#section-4.2">
      *              6LoWPAN Context Option
      *          </a>
@@ -74,9 +77,50 @@ typedef struct {
     uint16_t ltime;
 } gnrc_sixlowpan_ctx_t;
 
+#if (CONFIG_GNRC_SIXLOWPAN_CTX_CACHE_SIZE > 0) || defined(DOXYGEN)
+/**
+ * @brief   Context ID of a cache entry for an address without context
+ */
+#define GNRC_SIXLOWPAN_CTX_CACHE_NONE       (0xff)
+
+/**
+ * @brief   Cached result of gnrc_sixlowpan_ctx_lookup_addr()
+ */
+typedef struct {
+    ipv6_addr_t addr;   /**< the address looked up */
+    /**
+     * @brief   Generation of the context buffer the result is valid for
+     *
+     * 0 marks an unused entry.
+     */
+    uint16_t gen;
+    /**
+     * @brief   ID of the context found for gnrc_sixlowpan_ctx_cache_entry_t::addr
+     *          or @ref GNRC_SIXLOWPAN_CTX_CACHE_NONE
+     */
+    uint8_t id;
+} gnrc_sixlowpan_ctx_cache_entry_t;
+
+/**
+ * @brief   Cache for context look-ups by address
+ *
+ * @see @ref CONFIG_GNRC_SIXLOWPAN_CTX_CACHE_SIZE
+ */
+typedef struct {
+    /**
+     * @brief   The cached look-ups
+     */
+    gnrc_sixlowpan_ctx_cache_entry_t entries[CONFIG_GNRC_SIXLOWPAN_CTX_CACHE_SIZE];
+    uint8_t next;       /**< entry to replace next */
+} gnrc_sixlowpan_ctx_cache_t;
+#endif  /* (CONFIG_GNRC_SIXLOWPAN_CTX_CACHE_SIZE > 0) || defined(DOXYGEN) */
+
 /**
  * @brief   Gets a context matching the given IPv6 address best with its prefix.
  *
+ * The contexts are kept sorted by prefix, so the longest matching prefix is
+ * found by binary search.
+ *
  * @param[in] addr  An IPv6 address.
  *
  * @return  The context associated with the best prefix for @p addr.
@@ -84,6 +128,26 @@ typedef struct {
  */
 gnrc_sixlowpan_ctx_t *gnrc_sixlowpan_ctx_lookup_addr(const ipv6_addr_t *addr);
 
+#if (CONFIG_GNRC_SIXLOWPAN_CTX_CACHE_SIZE > 0) || defined(DOXYGEN)
+/**
+ * @brief   Gets a context matching the given IPv6 address best with its
+ *          prefix, using a cache of previous look-ups
+ *
+ * Cached results are dropped as soon as a context is updated or removed, so
+ * the result is always the same as the one of gnrc_sixlowpan_ctx_lookup_addr().
+ *
+ * @note    The cache is not locked, so it must only be used by one thread.
+ *
+ * @param[in,out] cache A context look-up cache.
+ * @param[in] addr      An IPv6 address.
+ *
+ * @return  The context associated with the best prefix for @p addr.
+ * @return  NULL if there is no such context.
+ */
+gnrc_sixlowpan_ctx_t *gnrc_sixlowpan_ctx_lookup_addr_cached(gnrc_sixlowpan_ctx_cache_t *cache,
+                                                            const ipv6_addr_t *addr);
+#endif  /* (CONFIG_GNRC_SIXLOWPAN_CTX_CACHE_SIZE > 0) || defined(DOXYGEN) */
+
 /**
  * @brief   Gets context by ID.
  *
@@ -113,17 +177,12 @@ gnrc_sixlowpan_ctx_t *gnrc_sixlowpan_ctx_update(uint8_t id, const ipv6_addr_t *p
                                                 uint8_t prefix_len, uint16_t ltime,
                                                 bool comp);
 
-#ifdef MODULE_GNRC_SIXLOWPAN_CTX
 /**
  * @brief   Removes context.
  *
  * @param[in] id    A context ID.
  */
-static inline void gnrc_sixlowpan_ctx_remove(uint8_t id)
-{
-    gnrc_sixlowpan_ctx_lookup_id(id)->prefix_len = 0;
-}
-#endif
+void gnrc_sixlowpan_ctx_remove(uint8_t id);
 
 #ifdef TEST_SUITES
 /**
@@ -23,8 +23,10 @@
 #include <stdint.h>
 #include <stdbool.h>
 
+#include "bitfield.h"
 #include "net/gnrc/netif/hdr.h"
 #include "net/gnrc/pkt.h"
+#include "net/sixlowpan.h"
 
 #include "net/gnrc/sixlowpan/config.h"
 
@@ -37,23 +39,16 @@ extern "C" {
 #define GNRC_SIXLOWPAN_FRAG_RB_GC_MSG       (0x0226)
 
 /**
- * @brief   Fragment intervals to identify limits of fragments and duplicates.
+ * @brief   Number of 8-octet blocks a datagram of maximum size spans
  *
- * @note    Fragments MUST NOT overlap and overlapping fragments are to be
- *          discarded
+ * Fragment offsets are given in units of 8 octets, so the coverage of a
+ * datagram can be tracked with one bit per block.
  *
  * @see <a href="https://tools.ietf.org/html/rfc4944#section-5.3">
  *          RFC 4944, section 5.3
  *      </a>
  */
-typedef struct gnrc_sixlowpan_frag_rb_int {
-    /**
-     * @brief   next element in fragment interval list
-     */
-    struct gnrc_sixlowpan_frag_rb_int *next;
-    uint16_t start;             /**< start byte of the fragment interval */
-    uint16_t end;               /**< end byte of the fragment interval */
-} gnrc_sixlowpan_frag_rb_int_t;
+#define GNRC_SIXLOWPAN_FRAG_RB_BLOCKS   ((SIXLOWPAN_FRAG_SIZE_MASK + 1U) / 8U)
 
 /**
  * @brief   Base class for both reassembly buffer and virtual reassembly buffer
@@ -69,7 +64,6 @@ typedef struct gnrc_sixlowpan_frag_rb_int {
  * @see https://tools.ietf.org/html/draft-ietf-lwig-6lowpan-virtual-reassembly-01
  */
 typedef struct {
-    gnrc_sixlowpan_frag_rb_int_t *ints;         /**< intervals of already received fragments */
     uint8_t src[IEEE802154_LONG_ADDRESS_LEN];   /**< source address */
     uint8_t dst[IEEE802154_LONG_ADDRESS_LEN];   /**< destination address */
     uint8_t src_len;                            /**< length of gnrc_sixlowpan_frag_rb_t::src */
@@ -82,6 +76,21 @@ typedef struct {
     uint16_t current_size;
     uint32_t arrival;                           /**< time in microseconds of arrival of
                                                  *   last received fragment */
+#if defined(MODULE_GNRC_SIXLOWPAN_FRAG_SFR) || defined(DOXYGEN)
+    /**
+     * @brief   Difference between the fragment offsets on reception and the
+     *          offsets in the stored datagram
+     *
+     * Offsets of recoverable fragments refer to the compressed datagram, so
+     * for a reassembly buffer entry this is the difference between
+     * uncompressed and compressed headers. For a virtual reassembly buffer
+     * entry it is the difference the recompression of the first fragment
+     * introduced into the outgoing datagram.
+     *
+     * @note    Only available with module `gnrc_sixlowpan_frag_sfr`
+     */
+    int16_t offset_diff;
+#endif
 } gnrc_sixlowpan_frag_rb_base_t;
 
 /**
@@ -96,6 +105,28 @@ typedef struct {
      * @brief   The reassembled packet in the packet buffer
      */
     gnrc_pktsnip_t *pkt;
+    /**
+     * @brief   8-octet blocks of the datagram already covered by received
+     *          fragments
+     *
+     * Fragments MUST NOT overlap and overlapping fragments are to be
+     * discarded, see [RFC 4944, section 5.3]
+     * (https://tools.ietf.org/html/rfc4944#section-5.3).
+     *
+     * For datagrams received as recoverable fragments (see @ref
+     * net_sixlowpan_sfr) the first @ref SIXLOWPAN_SFR_ACK_BITMAP_SIZE bits
+     * instead mark the received fragments by their sequence number, in the
+     * format of the RFRAG acknowledgment bitmap.
+     */
+    BITFIELD(received, GNRC_SIXLOWPAN_FRAG_RB_BLOCKS);
+#if defined(MODULE_GNRC_SIXLOWPAN_FRAG_STATS) || defined(DOXYGEN)
+    /**
+     * @brief   Number of fragments received for the datagram
+     *
+     * @note    Only available with module `gnrc_sixlowpan_frag_stats`
+     */
+    uint8_t frags;
+#endif
 } gnrc_sixlowpan_frag_rb_t;
 
 /**
@@ -107,8 +138,11 @@ typedef struct {
  *                          gnrc_netif_hdr_t::if_pid and its source and
  *                          destination address set.
  * @param[in] frag          The fragment to add. Will be released by the
- *                          function.
- * @param[in] offset        The fragment's offset.
+ *                          function. With module `gnrc_sixlowpan_frag_sfr`
+ *                          this may also be a recoverable fragment.
+ * @param[in] offset        The fragment's offset. For a recoverable fragment
+ *                          this is the offset within the compressed datagram,
+ *                          i.e. 0 for the first fragment.
  * @param[in] page          Current 6Lo dispatch parsing page.
  *
  * @return  The reassembly buffer entry the fragment was added to on success.
@@ -139,6 +173,27 @@ gnrc_sixlowpan_frag_rb_t *gnrc_sixlowpan_frag_rb_add(gnrc_netif_hdr_t *netif_hdr
 bool gnrc_sixlowpan_frag_rb_exists(const gnrc_netif_hdr_t *netif_hdr,
                                    uint16_t tag);
 
+/**
+ * @brief   Gets a reassembly buffer entry with a given link-layer address
+ *          pair and tag
+ *
+ * @pre     `netif_hdr != NULL`
+ *
+ * @param[in] netif_hdr An interface header to provide the (source, destination)
+ *                      link-layer address pair. Must not be NULL.
+ * @param[in] tag       Tag to search for.
+ *
+ * @note    datagram_size is not a search parameter as the primary use case
+ *          for this function is [Selective Fragment Recovery]
+ *          (https://tools.ietf.org/html/draft-ietf-6lo-fragment-recovery-05)
+ *          where this information only exists in the first fragment.
+ *
+ * @return  The reassembly buffer entry identified by the given tuple.
+ * @return  NULL, if no entry with the given tuple exists.
+ */
+gnrc_sixlowpan_frag_rb_t *gnrc_sixlowpan_frag_rb_get_by_datagram(
+        const gnrc_netif_hdr_t *netif_hdr, uint16_t tag);
+
 /**
  * @brief   Removes a reassembly buffer entry with a given link-layer address
  *          pair and tag
@@ -229,18 +284,15 @@ int gnrc_sixlowpan_frag_rb_dispatch_when_complete(gnrc_sixlowpan_frag_rb_t *rbuf
  *
  * @pre `rbuf != NULL`
  *
- * This functions sets rbuf_t::super::pkt to NULL and removes all rbuf::ints.
+ * This functions sets rbuf_t::super::pkt to NULL, clears
+ * gnrc_sixlowpan_frag_rb_t::received and makes the entry unavailable to
+ * look-ups.
  *
  * @note    Does nothing if module `gnrc_sixlowpan_frag_rb` is not included.
  *
  * @param[in] rbuf  A reassembly buffer entry. Must not be NULL.
  */
-static inline void gnrc_sixlowpan_frag_rb_remove(gnrc_sixlowpan_frag_rb_t *rbuf)
-{
-    assert(rbuf != NULL);
-    gnrc_sixlowpan_frag_rb_base_rm(&rbuf->super);
-    rbuf->pkt = NULL;
-}
+void gnrc_sixlowpan_frag_rb_remove(gnrc_sixlowpan_frag_rb_t *rbuf);
 #else
 /* NOPs to be used with gnrc_sixlowpan_iphc if gnrc_sixlowpan_frag_rb is not
  * compiled in */
@@ -0,0 +1,142 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_sixlowpan_frag_sfr 6LoWPAN selective fragment recovery
+ * @ingroup     net_gnrc_sixlowpan_frag
+ * @brief       6LoWPAN selective fragment recovery implementation for GNRC
+ *
+ * With this module, datagrams too large for the link are sent as recoverable
+ * fragments (RFRAG) in windows, the last fragment of a window requests an
+ * RFRAG acknowledgment from the next hop. Fragments missing in the
+ * acknowledgment bitmap are retransmitted selectively and the window size is
+ * adapted to the observed losses. Fragments of an RFRAG datagram are
+ * reassembled in the @ref net_gnrc_sixlowpan_frag_rb "reassembly buffer" or,
+ * with module `gnrc_sixlowpan_frag_vrb`, forwarded using the
+ * @ref net_gnrc_sixlowpan_frag_vrb "virtual reassembly buffer".
+ *
+ * @see [draft-ietf-6lo-fragment-recovery-07]
+ *      (https://tools.ietf.org/html/draft-ietf-6lo-fragment-recovery-07)
+ * @{
+ *
+ * @file
+ * @brief   6LoWPAN selective fragment recovery definitions for GNRC
+ */
+#ifndef NET_GNRC_SIXLOWPAN_FRAG_SFR_H
+#define NET_GNRC_SIXLOWPAN_FRAG_SFR_H
+
+#include "net/gnrc/pkt.h"
+#include "net/gnrc/sixlowpan/config.h"
+#include "net/gnrc/sixlowpan/frag/fb.h"
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_VRB
+#include "net/gnrc/sixlowpan/frag/vrb.h"
+#endif /* MODULE_GNRC_SIXLOWPAN_FRAG_VRB */
+#include "net/sixlowpan/sfr.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Message type for ARQ timeout of a datagram
+ */
+#define GNRC_SIXLOWPAN_FRAG_SFR_ARQ_TIMEOUT_MSG     (0x0227)
+
+/**
+ * @brief   Message type for sending the next fragment of a window after the
+ *          inter-frame gap
+ *
+ * @see @ref GNRC_SIXLOWPAN_SFR_INTER_FRAME_GAP_US
+ */
+#define GNRC_SIXLOWPAN_FRAG_SFR_INTER_FRAG_GAP_MSG  (0x0228)
+
+/**
+ * @brief   Sends a packet via selective fragment recovery
+ *
+ * Starts sending the datagram in @p ctx if its fragments have not been sent
+ * yet, otherwise sends the next fragment of the current window.
+ *
+ * If the datagram needs more fragments than there are sequence numbers, it
+ * is sent using classic fragmentation instead, if module
+ * `gnrc_sixlowpan_frag` is available.
+ *
+ * @pre `ctx != NULL`
+ * @pre gnrc_sixlowpan_frag_fb_t::pkt of @p ctx is equal to @p pkt or
+ *      `pkt == NULL`.
+ *
+ * @param[in] pkt   A packet. May be NULL.
+ * @param[in] ctx   A fragmentation buffer entry. Expected to be of type
+ *                  @ref gnrc_sixlowpan_frag_fb_t, with
+ *                  gnrc_sixlowpan_frag_fb_t set to @p pkt. Must not be NULL.
+ * @param[in] page  Current 6Lo dispatch parsing page.
+ */
+void gnrc_sixlowpan_frag_sfr_send(gnrc_pktsnip_t *pkt, void *ctx,
+                                  unsigned page);
+
+/**
+ * @brief   Handles a packet containing a selective fragment recovery header
+ *
+ * Recoverable fragments are either forwarded, if a VRB entry exists for them,
+ * or added to the reassembly buffer. RFRAG acknowledgments are either
+ * relayed back to the original sender or are handed to the sending datagram
+ * they acknowledge.
+ *
+ * @param[in] pkt   The packet to handle.
+ * @param[in] ctx   Context for the packet. May be NULL.
+ * @param[in] page  Current 6Lo dispatch parsing page.
+ */
+void gnrc_sixlowpan_frag_sfr_recv(gnrc_pktsnip_t *pkt, void *ctx,
+                                  unsigned page);
+
+#if defined(MODULE_GNRC_SIXLOWPAN_FRAG_VRB) || defined(DOXYGEN)
+/**
+ * @brief   Forward a recoverable fragment with a VRB entry
+ *
+ * For the first fragment the difference in size of the recompressed headers
+ * is recorded in @p vrbe, so the offsets of all further fragments can be
+ * adapted.
+ *
+ * @pre `(rfrag != NULL) && (vrbe != NULL)`
+ *
+ * @param[in] pkt       The payload of the fragment, without netif header and
+ *                      recoverable fragment header. May be NULL for an abort
+ *                      fragment.
+ * @param[in] rfrag     The original recoverable fragment header.
+ * @param[in] vrbe      VRB entry to forward the fragment with.
+ * @param[in] page      Current 6Lo dispatch parsing page.
+ *
+ * @note    Only available with module `gnrc_sixlowpan_frag_vrb`.
+ *
+ * @return  0 on success.
+ * @return  -ENOMEM, when the packet buffer is full. @p pkt is released in that
+ *          case.
+ */
+int gnrc_sixlowpan_frag_sfr_forward(gnrc_pktsnip_t *pkt,
+                                    const sixlowpan_sfr_rfrag_t *rfrag,
+                                    gnrc_sixlowpan_frag_vrb_t *vrbe,
+                                    unsigned page);
+#endif /* defined(MODULE_GNRC_SIXLOWPAN_FRAG_VRB) || defined(DOXYGEN) */
+
+/**
+ * @brief   Handles an ARQ timeout of a datagram
+ *
+ * Shrinks the window and retransmits all unacknowledged fragments of the
+ * datagram or, when the retries are exhausted, aborts the datagram.
+ * Fragments are sent with the page stored in gnrc_sixlowpan_frag_sfr_fb_t::page.
+ *
+ * @param[in] fbuf  The fragmentation buffer entry of the datagram. Must not
+ *                  be NULL.
+ */
+void gnrc_sixlowpan_frag_sfr_arq_timeout(gnrc_sixlowpan_frag_fb_t *fbuf);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_GNRC_SIXLOWPAN_FRAG_SFR_H */
+/** @} */
@@ -0,0 +1,87 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @addtogroup  net_gnrc_sixlowpan_frag_sfr
+ * @{
+ *
+ * @file
+ * @brief   Selective fragment recovery type definitions
+ *
+ * Kept separate from @ref net/gnrc/sixlowpan/frag/sfr.h so the fragmentation
+ * buffer can include them without a cyclical include.
+ */
+#ifndef NET_GNRC_SIXLOWPAN_FRAG_SFR_TYPES_H
+#define NET_GNRC_SIXLOWPAN_FRAG_SFR_TYPES_H
+
+#include <stdint.h>
+
+#include "bitfield.h"
+#include "msg.h"
+#include "net/sixlowpan/sfr.h"
+#include "xtimer.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Extension for the fragmentation buffer entry for selective
+ *          fragment recovery
+ *
+ * Fragments are numbered by their sequence number and, apart from the last
+ * one, all carry gnrc_sixlowpan_frag_sfr_fb_t::frag_size bytes of the
+ * compressed datagram. Fragments are sent in rounds of up to
+ * gnrc_sixlowpan_frag_sfr_fb_t::window fragments, the last of which requests
+ * an acknowledgment.
+ */
+typedef struct {
+    /**
+     * @brief   Timer for both the inter-frame gap and the ARQ timeout
+     *
+     * The type of gnrc_sixlowpan_frag_sfr_fb_t::timer_msg tells which one of
+     * both is currently running.
+     */
+    xtimer_t timer;
+    msg_t timer_msg;            /**< message for gnrc_sixlowpan_frag_sfr_fb_t::timer */
+    uint32_t ack_req_sent;      /**< time in microseconds the last
+                                 *   acknowledgment was requested */
+    /**
+     * @brief   Fragments acknowledged by the next hop
+     */
+    BITFIELD(acked, SIXLOWPAN_SFR_ACK_BITMAP_SIZE);
+    /**
+     * @brief   Fragments sent in the current round
+     */
+    BITFIELD(round, SIXLOWPAN_SFR_ACK_BITMAP_SIZE);
+    uint16_t frag_size;         /**< size of a fragment's payload */
+    uint16_t arq_timeout;       /**< current ARQ timeout in milliseconds */
+    uint8_t frags;              /**< number of fragments of the datagram */
+    uint8_t next;               /**< sequence number to send next in round */
+    uint8_t round_left;         /**< fragments left to send in round */
+    uint8_t window;             /**< current window size */
+    /**
+     * @brief   Rounds in a row in which no fragment was acknowledged
+     */
+    uint8_t retrans;
+    uint8_t dg_retries;         /**< number of retries of the datagram */
+    /**
+     * @brief   6Lo dispatch parsing page the datagram is sent with
+     *
+     * Timer events only carry the fragmentation buffer entry, so the page is
+     * kept here for them.
+     */
+    uint8_t page;
+} gnrc_sixlowpan_frag_sfr_fb_t;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_GNRC_SIXLOWPAN_FRAG_SFR_TYPES_H */
+/** @} */
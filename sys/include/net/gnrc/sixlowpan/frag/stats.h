@@ -40,6 +40,9 @@ typedef struct {
 #if defined(MODULE_GNRC_SIXLOWPAN_FRAG_VRB) || DOXYGEN
     unsigned vrb_full;      /**< counts the number of events where the virtual
                              *   reassembly buffer is full */
+    unsigned vrb_hits;      /**< successful VRB look-ups */
+    unsigned vrb_misses;    /**< VRB look-ups without matching entry */
+    unsigned vrb_evictions; /**< VRB entries evicted for a new datagram */
 #endif
 } gnrc_sixlowpan_frag_stats_t;
 
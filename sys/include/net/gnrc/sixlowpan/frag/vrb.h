@@ -69,8 +69,11 @@ typedef struct {
  * @pre `out_dst != NULL`
  * @pre `out_dst_len > 0`
  *
+ * If the VRB is full, the least recently used entry is evicted, provided it
+ * was idle for at least @ref CONFIG_GNRC_SIXLOWPAN_FRAG_VRB_EVICT_IDLE_US.
+ *
  * @return  A new VRB entry.
- * @return  NULL, if VRB is full.
+ * @return  NULL, if VRB is full and no entry could be evicted.
  */
 gnrc_sixlowpan_frag_vrb_t *gnrc_sixlowpan_frag_vrb_add(
         const gnrc_sixlowpan_frag_rb_base_t *base,
@@ -106,6 +109,8 @@ void gnrc_sixlowpan_frag_vrb_gc(void);
 /**
  * @brief   Gets a VRB entry
  *
+ * The entry is looked up by hash and marked as most recently used.
+ *
  * @param[in] src           Link-layer source address of the original fragment.
  * @param[in] src_len       Length of @p src.
  * @param[in] src_tag       Tag of the original fragment.
@@ -117,18 +122,34 @@ void gnrc_sixlowpan_frag_vrb_gc(void);
 gnrc_sixlowpan_frag_vrb_t *gnrc_sixlowpan_frag_vrb_get(
         const uint8_t *src, size_t src_len, unsigned src_tag);
 
+/**
+ * @brief   Reverse VRB lookup
+ *
+ * Finds the VRB entry of a datagram by its outgoing link-layer destination
+ * and outgoing tag, e.g. to relay acknowledgments back to the original
+ * sender.
+ *
+ * @param[in] netif         Network interface the look-up is made for.
+ * @param[in] src           Link-layer source address of the reverse
+ *                          direction, i.e. the link-layer destination of the
+ *                          forwarded fragments.
+ * @param[in] src_len       Length of @p src.
+ * @param[in] tag           Outgoing tag of the forwarded fragments.
+ *
+ * @return  The VRB entry identified by the given parameters.
+ * @return  NULL, if there is no entry in the VRB that could be identified
+ *          by the given parameters.
+ */
+gnrc_sixlowpan_frag_vrb_t *gnrc_sixlowpan_frag_vrb_reverse(
+        const gnrc_netif_t *netif, const uint8_t *src, size_t src_len,
+        unsigned tag);
+
 /**
  * @brief   Removes an entry from the VRB
  *
  * @param[in] vrb   A VRB entry
  */
-static inline void gnrc_sixlowpan_frag_vrb_rm(gnrc_sixlowpan_frag_vrb_t *vrb)
-{
-    if (IS_USED(MODULE_GNRC_SIXLOWPAN_FRAG_RB)) {
-        gnrc_sixlowpan_frag_rb_base_rm(&vrb->super);
-    }
-    vrb->super.src_len = 0;
-}
+void gnrc_sixlowpan_frag_vrb_rm(gnrc_sixlowpan_frag_vrb_t *vrb);
 
 /**
  * @brief   Determines if a VRB entry is empty
@@ -57,6 +57,43 @@ void gnrc_sixlowpan_iphc_recv(gnrc_pktsnip_t *pkt, void *ctx, unsigned page);
  */
 void gnrc_sixlowpan_iphc_send(gnrc_pktsnip_t *pkt, void *ctx, unsigned page);
 
+#if defined(MODULE_GNRC_SIXLOWPAN_IPHC_REF) || defined(DOXYGEN)
+/**
+ * @brief   Decompresses a received 6LoWPAN IPHC frame with the reference
+ *          implementation
+ *
+ * Same as gnrc_sixlowpan_iphc_recv(), but decodes the addresses and the hop
+ * limit with the switch statements the table-driven decoder replaced. Meant
+ * to compare both implementations in benchmarks, so it is only available with
+ * the `gnrc_sixlowpan_iphc_ref` module and should not be called concurrently
+ * with the other IPHC functions.
+ *
+ * @pre (pkt != NULL)
+ *
+ * @param[in] pkt           A received 6LoWPAN IPHC frame.
+ * @param[in,out] ctx       Context for the packet. May be NULL.
+ * @param[in] page          Current 6Lo dispatch parsing page.
+ */
+void gnrc_sixlowpan_iphc_ref_recv(gnrc_pktsnip_t *pkt, void *ctx,
+                                  unsigned page);
+
+/**
+ * @brief   Compresses a 6LoWPAN for IPHC with the reference implementation
+ *
+ * Same as gnrc_sixlowpan_iphc_send(), but looks up the contexts of the
+ * addresses without the per-interface context cache. Only available with the
+ * `gnrc_sixlowpan_iphc_ref` module, see gnrc_sixlowpan_iphc_ref_recv().
+ *
+ * @pre (pkt != NULL)
+ *
+ * @param[in] pkt   A 6LoWPAN frame with an uncompressed IPv6 header to send.
+ * @param[in] ctx   Context for the packet. May be NULL.
+ * @param[in] page  Current 6Lo dispatch parsing page.
+ */
+void gnrc_sixlowpan_iphc_ref_send(gnrc_pktsnip_t *pkt, void *ctx,
+                                  unsigned page);
+#endif  /* defined(MODULE_GNRC_SIXLOWPAN_IPHC_REF) || defined(DOXYGEN) */
+
 #ifdef __cplusplus
 }
 #endif
@@ -11,6 +11,10 @@
  * @ingroup     net_gnrc
  * @brief       RIOT's TCP implementation for the GNRC network stack.
  *
+ * The module `gnrc_sock_tcp` implements @ref net_sock_tcp on top of this API.
+ * Its listening queues consist of TCBs opened by gnrc_tcp_listen(), so a
+ * single thread can serve several connections.
+ *
  * @{
  *
  * @file
@@ -34,6 +38,16 @@
 extern "C" {
 #endif
 
+/**
+ * @brief Events reported to the callback of a TCB, see gnrc_tcp_set_cb().
+ * @{
+ */
+#define GNRC_TCP_EVENT_CONNECTED (0x01)   /**< Connection was established */
+#define GNRC_TCP_EVENT_RECV      (0x02)   /**< Data or the end of the data stream received */
+#define GNRC_TCP_EVENT_SENT      (0x04)   /**< Sent data was acknowledged */
+#define GNRC_TCP_EVENT_CLOSED    (0x08)   /**< Connection was closed or reset */
+/** @} */
+
 /**
  * @brief Address information for a single TCP connection endpoint.
  * @extends sock_tcp_ep_t
@@ -121,7 +135,6 @@ void gnrc_tcp_tcb_init(gnrc_tcp_tcb_t *tcb);
  * @return   -EINVAL if @p address_family is not the same the address_family use by the TCB.
  *                    or @p target_addr is invalid.
  * @return   -EISCONN if TCB is already in use.
- * @return   -ENOMEM if the receive buffer for the TCB could not be allocated.
  * @return   -EADDRINUSE if @p local_port is already used by another connection.
  * @return   -ETIMEDOUT if the connection could not be opened.
  * @return   -ECONNREFUSED if the connection was reset by the peer.
@@ -149,11 +162,87 @@ int gnrc_tcp_open_active(gnrc_tcp_tcb_t *tcb, const gnrc_tcp_ep_t *remote,
  * @return   -EINVAL if @p address_family is not the same the address_family used in TCB.
  *                    or the address in @p local is invalid.
  * @return   -EISCONN if TCB is already in use.
- * @return   -ENOMEM if the receive buffer for the TCB could not be allocated.
- *            Hint: Increase "CONFIG_GNRC_TCP_RCV_BUFFERS".
  */
 int gnrc_tcp_open_passive(gnrc_tcp_tcb_t *tcb, const gnrc_tcp_ep_t *local);
 
+/**
+ * @brief Waits for an incoming connection request without blocking.
+ *
+ * The TCP thread establishes the connection in the background. Connection
+ * attempts that fail or time out are dropped and the TCB waits for the next
+ * one, @ref GNRC_TCP_EVENT_CONNECTED is reported once a connection is
+ * established. Several TCBs may listen on the same endpoint, each of them
+ * accepts one connection.
+ *
+ * gnrc_tcp_close() closes the connection of such a TCB in the background and
+ * the TCB waits for the next connection request afterwards, gnrc_tcp_abort()
+ * stops listening.
+ *
+ * @pre gnrc_tcp_tcb_init() must have been successfully called.
+ * @pre @p tcb must not be NULL.
+ * @pre @p local must not be NULL.
+ * @pre port in @p local must not be zero.
+ *
+ * @param[in,out] tcb     TCB holding the connection information.
+ * @param[in]     local   Endpoint specifying the port and address used to wait for
+ *                        incoming connections.
+ *
+ * @return   0 on success.
+ * @return   -EAFNOSUPPORT if @p address_family is not supported.
+ * @return   -EINVAL if @p address_family is not the same the address_family used in TCB.
+ * @return   -EISCONN if TCB is already in use.
+ */
+int gnrc_tcp_listen(gnrc_tcp_tcb_t *tcb, const gnrc_tcp_ep_t *local);
+
+/**
+ * @brief Sets the event callback of a TCB.
+ *
+ * The callback is called from the thread that caused the events, which is
+ * the TCP thread for all events caused by the peer. It must not call any
+ * function of this API.
+ *
+ * @pre gnrc_tcp_tcb_init() must have been successfully called.
+ * @pre @p tcb must not be NULL.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ * @param[in]     cb    Callback for the events of @p tcb, NULL to disable it.
+ * @param[in]     arg   Argument for @p cb.
+ */
+void gnrc_tcp_set_cb(gnrc_tcp_tcb_t *tcb, gnrc_tcp_cb_t cb, void *arg);
+
+/**
+ * @brief Sets the receive buffer size of a connection.
+ *
+ * Received data is kept in the packet buffer until it is read with
+ * gnrc_tcp_recv(), the receive window announces the free space of the
+ * receive buffer to the peer. The buffer starts with @p min bytes on every
+ * connection establishment. Whenever gnrc_tcp_recv() reads a full buffer at
+ * once, the window limits the peer rather than the user and the buffer
+ * doubles up to @p max bytes.
+ *
+ * Windows of more than 65535 bytes need window scaling (RFC 7323), which is
+ * only used if the peer supports it as well.
+ *
+ * @pre gnrc_tcp_tcb_init() must have been successfully called.
+ * @pre @p tcb must not be NULL.
+ *
+ * @note Defaults to @ref CONFIG_GNRC_TCP_DEFAULT_WINDOW and
+ *       @ref CONFIG_GNRC_TCP_MAX_WINDOW. The packet buffer must be large
+ *       enough to hold the receive buffers of all connections, data that
+ *       does not fit is dropped and retransmitted by the peer.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ * @param[in]     min   Initial receive buffer size in bytes.
+ * @param[in]     max   Maximum receive buffer size in bytes.
+ *
+ * @return   0 on success.
+ * @return   -EINVAL if @p min is smaller than @ref CONFIG_GNRC_TCP_MSS,
+ *           @p max is smaller than @p min or larger than the largest
+ *           window size.
+ * @return   -EISCONN if TCB is in use.
+ */
+int gnrc_tcp_set_rcvbuf(gnrc_tcp_tcb_t *tcb, uint32_t min, uint32_t max);
+
 /**
  * @brief Transmit data to connected peer.
  *
@@ -162,6 +251,8 @@ int gnrc_tcp_open_passive(gnrc_tcp_tcb_t *tcb, const gnrc_tcp_ep_t *local);
  * @pre @p data must not be NULL.
  *
  * @note Blocks until up to @p len bytes were transmitted or an error occurred.
+ *       Transmitted data is retransmitted in the background until the peer
+ *       acknowledged it, gnrc_tcp_close() blocks until all data was acknowledged.
  *
  * @param[in,out] tcb                        TCB holding the connection information.
  * @param[in]     data                       Pointer to the data that should be transmitted.
@@ -216,6 +307,9 @@ ssize_t gnrc_tcp_recv(gnrc_tcp_tcb_t *tcb, void *data, const size_t max_len,
  * @pre gnrc_tcp_tcb_init() must have been successfully called.
  * @pre @p tcb must not be NULL.
  *
+ * @note Blocks until the connection was closed, unless @p tcb was opened
+ *       with gnrc_tcp_listen().
+ *
  * @param[in,out] tcb   TCB holding the connection information.
  */
 void gnrc_tcp_close(gnrc_tcp_tcb_t *tcb);
@@ -78,7 +78,7 @@ extern "C" {
 #endif
 
 /**
- * @brief MSS Multiplicator = Number of MSS sized packets stored in receive buffer
+ * @brief MSS Multiplicator = Number of MSS sized packets in the default receive window
  */
 #ifndef CONFIG_GNRC_TCP_MSS_MULTIPLICATOR
 #define CONFIG_GNRC_TCP_MSS_MULTIPLICATOR (1U)
@@ -86,26 +86,71 @@ extern "C" {
 
 /**
  * @brief Default receive window size
+ *
+ * Initial size of the receive buffer of a connection, see gnrc_tcp_set_rcvbuf().
  */
 #ifndef CONFIG_GNRC_TCP_DEFAULT_WINDOW
 #define CONFIG_GNRC_TCP_DEFAULT_WINDOW (CONFIG_GNRC_TCP_MSS * CONFIG_GNRC_TCP_MSS_MULTIPLICATOR)
 #endif
 
 /**
- * @brief Number of preallocated receive buffers.
+ * @brief Default maximum receive window size
  *
- * This value determines how many parallel TCP connections can be active at the
- * same time.
+ * Received data is kept in the packet buffer until it is read by the user.
+ * The receive buffer of a connection grows from @ref CONFIG_GNRC_TCP_DEFAULT_WINDOW
+ * up to this size if the window limits the peer while the user keeps up with
+ * reading, see gnrc_tcp_set_rcvbuf(). Values up to @ref CONFIG_GNRC_TCP_DEFAULT_WINDOW
+ * disable growing.
  */
-#ifndef CONFIG_GNRC_TCP_RCV_BUFFERS
-#define CONFIG_GNRC_TCP_RCV_BUFFERS (1U)
+#ifndef CONFIG_GNRC_TCP_MAX_WINDOW
+#define CONFIG_GNRC_TCP_MAX_WINDOW (CONFIG_GNRC_TCP_DEFAULT_WINDOW)
 #endif
 
+#ifdef DOXYGEN
 /**
- * @brief Default receive buffer size
+ * @brief Disable window scaling (see RFC 7323)
+ *
+ * If not set, window scaling is offered to the peer on connection
+ * establishment, so receive windows of more than 65535 bytes can be used.
+ */
+#define CONFIG_GNRC_TCP_WITHOUT_WSCALE
+#endif
+
+/**
+ * @brief Maximum number of unacknowledged data segments per connection
+ *
+ * Every unacknowledged segment is kept in the packet buffer until it was
+ * acknowledged, so this value bounds the packet buffer space a single
+ * connection occupies. The amount of data in flight is limited by the send
+ * window of the peer and the congestion window as well.
+ *
+ * @note    The packet buffer must hold this many segments of
+ *          @ref CONFIG_GNRC_TCP_MSS bytes plus the receive buffers of all
+ *          connections. Increase @ref CONFIG_GNRC_PKTBUF_SIZE along with
+ *          this value.
+ */
+#ifndef CONFIG_GNRC_TCP_RTX_QUEUE_SIZE
+#define CONFIG_GNRC_TCP_RTX_QUEUE_SIZE (2U)
+#endif
+
+/**
+ * @brief Number of duplicate ACKs that trigger a fast retransmit
+ *        (see RFC 5681)
+ */
+#ifndef CONFIG_GNRC_TCP_DUPACK_THRESHOLD
+#define CONFIG_GNRC_TCP_DUPACK_THRESHOLD (3U)
+#endif
+
+#ifdef DOXYGEN
+/**
+ * @brief Disable selective acknowledgments (see RFC 2018)
+ *
+ * If not set, SACK is offered to the peer on connection establishment and
+ * SACK options of the peer are used to skip the segments it already received
+ * on retransmissions. Incoming data is only accepted in order, so no SACK
+ * options are sent.
  */
-#ifndef GNRC_TCP_RCV_BUF_SIZE
-#define GNRC_TCP_RCV_BUF_SIZE (CONFIG_GNRC_TCP_DEFAULT_WINDOW)
+#define CONFIG_GNRC_TCP_WITHOUT_SACK
 #endif
 
 /**
@@ -22,7 +22,6 @@
 
 #include <stdint.h>
 #include "kernel_types.h"
-#include "ringbuffer.h"
 #include "xtimer.h"
 #include "mutex.h"
 #include "msg.h"
@@ -59,10 +58,34 @@ extern "C" {
 #define GNRC_TCP_TCB_MBOX_SIZE (1 << CONFIG_GNRC_TCP_TCB_MBOX_SIZE_EXP)
 #endif
 
+/**
+ * @brief Forward declaration of the TCB
+ */
+typedef struct _transmission_control_block gnrc_tcp_tcb_t;
+
+/**
+ * @brief Event callback of a TCB, see gnrc_tcp_set_cb().
+ *
+ * @param[in] tcb      TCB the events occurred on.
+ * @param[in] events   Bitmask of the events (GNRC_TCP_EVENT_*).
+ * @param[in] arg      Argument given to gnrc_tcp_set_cb().
+ */
+typedef void (*gnrc_tcp_cb_t)(gnrc_tcp_tcb_t *tcb, unsigned events, void *arg);
+
+/**
+ * @brief Segment in the retransmission queue of a TCB.
+ */
+typedef struct {
+    gnrc_pktsnip_t *pkt;   /**< The segment, held until it is acknowledged */
+    uint32_t seq;          /**< Sequence number of the segment */
+    uint16_t len;          /**< Sequence space consumed by the segment */
+    uint8_t flags;         /**< State of the segment */
+} gnrc_tcp_rtx_t;
+
 /**
  * @brief Transmission control block of GNRC TCP.
  */
-typedef struct _transmission_control_block {
+struct _transmission_control_block {
     uint8_t address_family;                   /**< Address Family of local_addr / peer_addr */
 #ifdef MODULE_GNRC_IPV6
     uint8_t local_addr[sizeof(ipv6_addr_t)];  /**< Local IP address */
@@ -72,33 +95,55 @@ typedef struct _transmission_control_block {
     uint16_t local_port;   /**< Local connections port number */
     uint16_t peer_port;    /**< Peer connections port number */
     uint8_t state;         /**< Connections state */
-    uint8_t status;        /**< A connections status flags */
+    uint16_t status;       /**< A connections status flags */
     uint32_t snd_una;      /**< Send unacknowledged */
     uint32_t snd_nxt;      /**< Send next */
-    uint16_t snd_wnd;      /**< Send window */
+    uint32_t snd_wnd;      /**< Send window */
     uint32_t snd_wl1;      /**< SeqNo. from last window update */
     uint32_t snd_wl2;      /**< AckNo. from last window update */
     uint32_t rcv_nxt;      /**< Receive next */
-    uint16_t rcv_wnd;      /**< Receive window */
+    uint32_t rcv_wnd;      /**< Receive window */
+    uint8_t snd_wscale;    /**< Window scale of the peer */
+    uint8_t rcv_wscale;    /**< Window scale of the receive window */
     uint32_t iss;          /**< Initial sequence sumber */
     uint32_t irs;          /**< Initial received sequence number */
     uint16_t mss;          /**< The peers MSS */
+    uint32_t cwnd;         /**< Congestion window */
+    uint32_t ssthresh;     /**< Slow start threshold */
+    uint32_t recover;      /**< snd_nxt on entering the last loss recovery */
+    uint8_t dup_acks;      /**< Number of duplicate ACKs received */
     uint32_t rtt_start;    /**< Timer value for rtt estimation */
+    uint32_t rtt_seq;      /**< Sequence number that ends the rtt estimation */
     int32_t rtt_var;       /**< Round trip time variance */
     int32_t srtt;          /**< Smoothed round trip time */
     int32_t rto;           /**< Retransmission timeout duration */
     uint8_t retries;       /**< Number of retransmissions */
     xtimer_t tim_tout;     /**< Timer struct for timeouts */
     msg_t msg_tout;        /**< Message, sent on timeouts */
-    gnrc_pktsnip_t *pkt_retransmit;   /**< Pointer to packet in "retransmit queue" */
+    xtimer_t tim_conn;     /**< Connection timeout of TCBs opened by gnrc_tcp_listen() */
+    msg_t msg_conn;        /**< Message, sent on connection timeouts */
+    /**
+     * @brief Unacknowledged segments, ordered by sequence number
+     *
+     * One more than @ref CONFIG_GNRC_TCP_RTX_QUEUE_SIZE to be able to send a
+     * FIN while the queue is filled with data.
+     */
+    gnrc_tcp_rtx_t rtx[CONFIG_GNRC_TCP_RTX_QUEUE_SIZE + 1];
+    uint8_t rtx_len;       /**< Number of segments in gnrc_tcp_tcb_t::rtx */
     msg_t mbox_raw[GNRC_TCP_TCB_MBOX_SIZE];   /**< Msg queue for mbox */
     mbox_t mbox;             /**< TCB mbox for synchronization */
-    uint8_t *rcv_buf_raw;    /**< Pointer to the receive buffer */
-    ringbuffer_t rcv_buf;    /**< Receive buffer data structure */
+    gnrc_pktsnip_t *rcv_buf; /**< Received data not read by the user, in order */
+    uint32_t rcv_buf_len;    /**< Number of bytes in gnrc_tcp_tcb_t::rcv_buf */
+    uint32_t rcv_buf_size;   /**< Current size of the receive buffer */
+    uint32_t rcv_buf_min;    /**< Initial size of the receive buffer */
+    uint32_t rcv_buf_max;    /**< Maximum size of the receive buffer */
+    uint16_t rcv_buf_off;    /**< Bytes of the first snip of rcv_buf already read */
     mutex_t fsm_lock;        /**< Mutex for FSM access synchronization */
     mutex_t function_lock;   /**< Mutex for function call synchronization */
+    gnrc_tcp_cb_t cb;        /**< Event callback, NULL if unused */
+    void *cb_arg;            /**< Argument of gnrc_tcp_tcb_t::cb */
     struct _transmission_control_block *next;   /**< Pointer next TCB */
-} gnrc_tcp_tcb_t;
+};
 
 #ifdef __cplusplus
 }
@@ -73,6 +73,56 @@ static inline uint16_t inet_csum(uint16_t sum, const uint8_t *buf, uint16_t len)
     return inet_csum_slice(sum, buf, len, 0);
 }
 
+/**
+ * @brief   Updates a checksum field after a 16-bit word of its checksum
+ *          domain was changed.
+ *
+ * @see <a href="https://tools.ietf.org/html/rfc1624#section-3">
+ *          RFC 1624, section 3
+ *      </a>
+ *
+ * @details Uses eqn. 3 of RFC 1624, `HC' = ~(~HC + ~m + m')`, so the result
+ *          is the same a recalculation over the whole domain would yield.
+ *
+ * @param[in] csum      The checksum field (i.e. the normalized checksum) in
+ *                      host byte order.
+ * @param[in] old_val   The old value of the 16-bit word in host byte order.
+ * @param[in] new_val   The new value of the 16-bit word in host byte order.
+ *
+ * @return  The new value for the checksum field in host byte order.
+ */
+static inline uint16_t inet_csum_update16(uint16_t csum, uint16_t old_val,
+                                          uint16_t new_val)
+{
+    uint32_t sum = (uint16_t)~csum + (uint16_t)~old_val + new_val;
+
+    sum = (sum & 0xffff) + (sum >> 16);
+    sum = (sum & 0xffff) + (sum >> 16);
+    return ~sum;
+}
+
+/**
+ * @brief   Updates a checksum field after a field of its checksum domain was
+ *          changed, e.g. an address in the pseudo header.
+ *
+ * @see <a href="https://tools.ietf.org/html/rfc1624#section-3">
+ *          RFC 1624, section 3
+ *      </a>
+ *
+ * @pre     The changed field starts at an even offset of the checksum domain.
+ *
+ * @param[in] csum      The checksum field (i.e. the normalized checksum) in
+ *                      host byte order.
+ * @param[in] old_val   The old content of the field.
+ * @param[in] new_val   The new content of the field.
+ * @param[in] len       Length of the field in byte. An odd length is padded
+ *                      with zero.
+ *
+ * @return  The new value for the checksum field in host byte order.
+ */
+uint16_t inet_csum_update(uint16_t csum, const uint8_t *old_val,
+                          const uint8_t *new_val, uint16_t len);
+
 #ifdef __cplusplus
 }
 #endif
@@ -64,6 +64,12 @@
  * and exact matching should be register, and then a second one with the path
  * `/resource01/` and subtree matching.
  *
+ * The resources of a server must be sorted by their paths as by strcmp(). A
+ * request is dispatched to the first resource in this order that matches its
+ * URI-path and allows its method. The lookup descends through the sorted
+ * resources character by character, so it takes time proportional to the
+ * length of the URI-path and the logarithm of the number of resources.
+ *
  * @{
  *
  * @file
@@ -188,7 +194,7 @@ typedef struct {
     uint8_t *payload;                                 /**< pointer to payload      */
     uint16_t payload_len;                             /**< length of payload       */
     uint16_t options_len;                             /**< length of options array */
-    coap_optpos_t options[CONFIG_NANOCOAP_NOPTS_MAX]; /**< option offset array     */
+    coap_optpos_t options[CONFIG_NANOCOAP_NOPTS_MAX]; /**< sorted option offsets   */
 #ifdef MODULE_GCOAP
     uint32_t observe_value;                           /**< observe value           */
 #endif
@@ -1524,6 +1530,8 @@ ssize_t coap_handle_req(coap_pkt_t *pkt, uint8_t *resp_buf, unsigned resp_buf_le
  * This function will try to find a matching handler in @p resources and call
  * the handler.
  *
+ * @see coap_find_resource()
+ *
  * @param[in]   pkt             pointer to (parsed) CoAP packet
  * @param[out]  resp_buf        buffer for response
  * @param[in]   resp_buf_len    size of response buffer
@@ -1538,6 +1546,27 @@ ssize_t coap_tree_handler(coap_pkt_t *pkt, uint8_t *resp_buf,
                           const coap_resource_t *resources,
                           size_t resources_numof);
 
+/**
+ * @brief   Finds the resource for a request
+ *
+ * @param[in]   resources       Array of coap endpoint resources, sorted by
+ *                              their paths
+ * @param[in]   resources_numof length of the coap endpoint resources
+ * @param[in]   uri             Null-terminated URI-path of the request
+ * @param[in]   method_flag     Method of the request, see coap_method2flag()
+ * @param[out]  resource        The first resource matching @p uri and
+ *                              @p method_flag
+ *
+ * @returns     0 on success
+ * @returns     -ENOENT if no resource matches @p uri
+ * @returns     -ENOTSUP if resources match @p uri, but none of them allows
+ *              @p method_flag
+ */
+int coap_find_resource(const coap_resource_t *resources,
+                       size_t resources_numof, const uint8_t *uri,
+                       coap_method_flags_t method_flag,
+                       const coap_resource_t **resource);
+
 /**
  * @brief   Convert message code (request method) into a corresponding bit field
  *
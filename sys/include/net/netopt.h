@@ -730,6 +730,20 @@ typedef enum {
      */
     NETOPT_LINK_CHECK,
 
+    /**
+     * @brief   (@ref netopt_enable_t) Drain all pending frames on a single
+     *          @ref NETDEV_EVENT_RX_COMPLETE
+     *
+     * A device supporting this reports when no further frame is pending,
+     * i.e. netdev_driver_t::recv() returns a value <= 0 if there is no frame
+     * to read. When enabled, the device does not signal frames that are still
+     * pending after a successful netdev_driver_t::recv(), so the upper layer
+     * must call netdev_driver_t::recv() until it returns a value <= 0.
+     *
+     * Devices that cannot be drained return -ENOTSUP when setting this option.
+     */
+    NETOPT_RX_DRAIN,
+
     /**
      * @brief   maximum number of options defined here.
      *
@@ -48,6 +48,8 @@ typedef struct {
                                      (either acknowledged or unconfirmed
                                      sending operation, e.g. multicast) */
     uint32_t tx_failed;         /**< failed sending operations */
+    uint32_t tx_dropped;        /**< packets dropped before sending,
+                                     e.g. due to a full send queue */
     uint32_t tx_bytes;          /**< sent bytes */
     uint32_t rx_count;          /**< received (data) packets */
     uint32_t rx_bytes;          /**< received bytes */
@@ -280,6 +280,7 @@
 # pragma clang diagnostic ignored "-Wtypedef-redefinition"
 #endif
 
+#include "iolist.h"
 #include "net/sock.h"
 
 #ifdef __cplusplus
@@ -494,6 +495,106 @@ ssize_t sock_udp_recv_buf(sock_udp_t *sock, void **data, void **buf_ctx,
 ssize_t sock_udp_send(sock_udp_t *sock, const void *data, size_t len,
                       const sock_udp_ep_t *remote);
 
+/**
+ * @brief   Sends a UDP message gathered from several buffers to remote end
+ *          point
+ *
+ * The elements of @p snips are concatenated into a single UDP payload, so e.g.
+ * a protocol header and application data held in different buffers can be
+ * sent without assembling them in a scratch buffer first.
+ *
+ * @pre `(sock != NULL) || (remote != NULL)`
+ *
+ * @param[in] sock      A UDP sock object. May be `NULL`.
+ *                      A sensible local end point should be selected by the
+ *                      implementation in that case.
+ * @param[in] snips     List of buffers to send as payload. May be `NULL` to
+ *                      send an empty message.
+ * @param[in] remote    Remote end point for the sent data.
+ *                      May be `NULL`, if @p sock has a remote end point.
+ *                      sock_udp_ep_t::family may be AF_UNSPEC, if local
+ *                      end point of @p sock provides this information.
+ *                      sock_udp_ep_t::port may not be 0.
+ *
+ * @experimental    This function is quite new, not implemented for all stacks
+ *                  yet, and may be subject to sudden API changes. Do not use
+ *                  in production if this is unacceptable.
+ *
+ * @return  The number of bytes sent on success.
+ * @return  The same errors as sock_udp_send().
+ */
+ssize_t sock_udp_sendv(sock_udp_t *sock, const iolist_t *snips,
+                       const sock_udp_ep_t *remote);
+
+/**
+ * @brief   Resizes stack-internal buffer space provided by
+ *          sock_udp_recv_buf(), so it can take a reply
+ *
+ * Together with sock_udp_send_buf() this allows to reply to a received
+ * message without copying it: The reply is written into the buffer space of
+ * the received message which is then handed back to the stack.
+ *
+ * @pre `(data != NULL) && (buf_ctx != NULL) && (*buf_ctx != NULL)`
+ *
+ * @param[in,out] data  Pointer to the buffer space provided by
+ *                      sock_udp_recv_buf(). Is set to the resized buffer
+ *                      space, which keeps the content up to the smaller of
+ *                      the old and the new size.
+ * @param[in,out] buf_ctx  Stack-internal buffer context provided by
+ *                      sock_udp_recv_buf() for the first segment of a
+ *                      message. May be changed by the stack.
+ * @param[in] size      New size of the buffer space.
+ *
+ * @experimental    This function is quite new, not implemented for all stacks
+ *                  yet, and may be subject to sudden API changes. Do not use in
+ *                  production if this is unacceptable.
+ *
+ * @note    Growing the buffer space might require the stack to move it, so
+ *          pointers into the old buffer space must not be used afterwards.
+ *
+ * @return  0 on success.
+ * @return  -ENOMEM, if no memory was available to resize the buffer space.
+ *          The buffer context is still valid.
+ * @return  -ENOTSUP, if the message consists of more than one segment.
+ *          Resizing to the size returned by sock_udp_recv_buf() thus
+ *          checks if a message can be parsed in place.
+ */
+int sock_udp_buf_resize(void **data, void **buf_ctx, size_t size);
+
+/**
+ * @brief   Sends stack-internal buffer space provided by sock_udp_recv_buf()
+ *          as UDP message to remote end point
+ *
+ * This sends the buffer space of a received message, e.g. after a reply was
+ * written into it, without copying it. See also sock_udp_buf_resize().
+ *
+ * @pre `((sock != NULL || remote != NULL)) && (buf_ctx != NULL)`
+ *
+ * @param[in] sock      A UDP sock object. May be `NULL`.
+ *                      A sensible local end point should be selected by the
+ *                      implementation in that case.
+ * @param[in] buf_ctx   Stack-internal buffer context provided by
+ *                      sock_udp_recv_buf() for the first segment of a message
+ *                      or by sock_udp_buf_resize(). It is released in any
+ *                      case and must not be used afterwards.
+ * @param[in] len       Number of bytes at the start of the buffer space to
+ *                      send. Must not exceed the size of the buffer space.
+ * @param[in] remote    Remote end point for the sent data.
+ *                      May be `NULL`, if @p sock has a remote end point.
+ *                      sock_udp_ep_t::family may be AF_UNSPEC, if local
+ *                      end point of @p sock provides this information.
+ *                      sock_udp_ep_t::port may not be 0.
+ *
+ * @experimental    This function is quite new, not implemented for all stacks
+ *                  yet, and may be subject to sudden API changes. Do not use in
+ *                  production if this is unacceptable.
+ *
+ * @return  The number of bytes sent on success.
+ * @return  The same errors as sock_udp_send() otherwise.
+ */
+ssize_t sock_udp_send_buf(sock_udp_t *sock, void *buf_ctx, size_t len,
+                          const sock_udp_ep_t *remote);
+
 #include "sock_types.h"
 
 #ifdef __cplusplus
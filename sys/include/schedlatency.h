@@ -0,0 +1,148 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    schedlatency Scheduling latency statistics
+ * @ingroup     sys
+ * @brief       When including this module, the time from waking up a thread
+ *              until it is scheduled is recorded per thread
+ *              (@ref schedlatency_t).
+ *
+ * A thread is woken up when it is put on the run queue (e.g. by a message,
+ * a mutex or thread flags). The time until it is chosen by @ref sched_run()
+ * is recorded in one of two histograms, depending on whether the thread was
+ * woken up by another thread (which includes the context switch) or from
+ * interrupt context (ISR to thread latency). The statistics are shown by `ps`.
+ *
+ * The time is measured in CPU cycles where a cycle counter is available
+ * (the DWT cycle counter on Cortex-M3/M4/M7, the time stamp counter on native
+ * on x86), and in xtimer ticks otherwise, see @ref SCHEDLATENCY_UNIT.
+ *
+ * @note        If auto_init is disabled `init_schedlatency()` needs to be
+ *              called.
+ * @{
+ *
+ * @file
+ * @brief       Scheduling latency statistics
+ */
+
+#ifndef SCHEDLATENCY_H
+#define SCHEDLATENCY_H
+
+#include <stdint.h>
+
+#include "kernel_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Number of buckets of the latency histograms
+ *
+ * Bucket n counts latencies in [2^n, 2^(n+1)), the last bucket all latencies
+ * larger than that.
+ */
+#ifndef CONFIG_SCHEDLATENCY_BUCKETS
+#define CONFIG_SCHEDLATENCY_BUCKETS     (16U)
+#endif
+
+/**
+ * @brief   Unit the latencies are measured in
+ */
+#if defined(CPU_NATIVE) && (defined(__i386__) || defined(__x86_64__))
+#define SCHEDLATENCY_UNIT               "cycles"
+#define SCHEDLATENCY_TSC                (1)
+#elif defined(CPU_CORE_CORTEX_M3) || defined(CPU_CORE_CORTEX_M4) || \
+      defined(CPU_CORE_CORTEX_M4F) || defined(CPU_CORE_CORTEX_M7)
+#define SCHEDLATENCY_UNIT               "cycles"
+#define SCHEDLATENCY_DWT                (1)
+#else
+#define SCHEDLATENCY_UNIT               "ticks"
+#endif
+
+/**
+ * @brief   Latency histogram
+ */
+typedef struct {
+    uint32_t count;                 /**< number of recorded latencies */
+    uint32_t max;                   /**< maximum latency */
+    uint64_t sum;                   /**< sum of all latencies */
+    /**
+     * @brief   Number of latencies per log2 bucket, saturating
+     */
+    uint16_t buckets[CONFIG_SCHEDLATENCY_BUCKETS];
+} schedlatency_hist_t;
+
+/**
+ * @brief   Scheduling latency statistics of a thread
+ */
+typedef struct {
+    uint32_t woken;                 /**< time stamp of the last wake-up */
+    uint8_t pending;                /**< wake-up not recorded yet, from ISR
+                                         if 2 */
+    schedlatency_hist_t thread;     /**< wake-ups by other threads */
+    schedlatency_hist_t isr;        /**< wake-ups from interrupt context */
+} schedlatency_t;
+
+/**
+ * @brief   Scheduling latency statistics table
+ */
+extern schedlatency_t sched_latency[KERNEL_PID_LAST + 1];
+
+/**
+ * @brief   Initializes the time source for the measurements
+ */
+void init_schedlatency(void);
+
+/**
+ * @brief   Resets the statistics of all threads
+ */
+void schedlatency_reset(void);
+
+/**
+ * @brief   Records that a thread was put on the run queue
+ *
+ * @internal    Called by the scheduler with interrupts disabled
+ *
+ * @param[in]   pid     the thread
+ */
+void schedlatency_woken(kernel_pid_t pid);
+
+/**
+ * @brief   Records that a thread was chosen to run next
+ *
+ * @internal    Called by the scheduler with interrupts disabled
+ *
+ * @param[in]   pid     the thread
+ */
+void schedlatency_scheduled(kernel_pid_t pid);
+
+/**
+ * @brief   Get the mean of a histogram
+ *
+ * @param[in]   hist    the histogram
+ *
+ * @return  mean latency, 0 if no latency was recorded
+ */
+static inline uint32_t schedlatency_mean(const schedlatency_hist_t *hist)
+{
+    return (hist->count) ? (uint32_t)(hist->sum / hist->count) : 0;
+}
+
+/**
+ * @brief   Prints the histograms of all threads
+ */
+void schedlatency_print(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SCHEDLATENCY_H */
+/** @} */
@@ -122,6 +122,34 @@
  * (now() - B) + T[1]). Thus even though the list is keeping relative offsets,
  * the time keeping is done by keeping track of the absolute times.
  *
+ * Inserting into and removing from the list is O(n) in the number of timers
+ * set on a clock, and is done with interrupts disabled. Applications that
+ * keep many timers set at the same time can use the module `ztimer_wheel`
+ * instead, see below.
+ *
+ *
+ * ## Timer wheel
+ *
+ * With `USEMODULE += ztimer_wheel`, every clock stores its timers in a
+ * hierarchical timer wheel instead of the sorted list. The wheel consists of
+ * @ref ZTIMER_WHEEL_LEVELS levels of @ref ZTIMER_WHEEL_SLOTS slots each, level
+ * `l` covering @ref CONFIG_ZTIMER_WHEEL_BITS more bits of the target time than
+ * level `l - 1`. A timer is put into the lowest level in which its target
+ * differs from the clock's base time B, so ztimer_set() and ztimer_remove()
+ * are O(1) regardless of the number of timers set.
+ *
+ * The wheel is work-conserving: the underlying clock is not set to tick
+ * through empty slots, but to the next occupied slot only. A bitmap of the
+ * occupied slots per level makes finding that slot O(#levels). When a slot of
+ * a higher level is reached, its timers are moved to lower levels, so every
+ * timer is moved at most @ref ZTIMER_WHEEL_LEVELS - 1 times.
+ *
+ * The API and the timing behaviour is the same as with the list. Timers
+ * expiring at the same tick may however trigger in a different order than
+ * they were set in. Every clock needs
+ * (@ref ZTIMER_WHEEL_LEVELS * @ref ZTIMER_WHEEL_SLOTS) additional pointers of
+ * RAM and every timer one additional pointer.
+ *
  *
  * ## Clock extension
  *
@@ -228,6 +256,29 @@ extern "C" {
  */
 #define ZTIMER_CLOCK_NO_REQUIRED_PM_MODE (UINT8_MAX)
 
+/**
+ * @brief   Number of bits of the target time each level of the timer wheel
+ *          covers
+ *
+ * Each level of a clock's timer wheel has 2^CONFIG_ZTIMER_WHEEL_BITS slots.
+ * Only used with the `ztimer_wheel` module, valid values are 1 to 4.
+ */
+#ifndef CONFIG_ZTIMER_WHEEL_BITS
+#define CONFIG_ZTIMER_WHEEL_BITS    (4U)
+#endif
+
+/**
+ * @brief   Number of slots per level of the timer wheel
+ */
+#define ZTIMER_WHEEL_SLOTS          (1U << CONFIG_ZTIMER_WHEEL_BITS)
+
+/**
+ * @brief   Number of levels of the timer wheel, so all 32 bits of the target
+ *          time are covered
+ */
+#define ZTIMER_WHEEL_LEVELS         ((32U + CONFIG_ZTIMER_WHEEL_BITS - 1) / \
+                                     CONFIG_ZTIMER_WHEEL_BITS)
+
 /**
  * @brief ztimer_base_t forward declaration
  */
@@ -243,9 +294,27 @@ typedef struct ztimer_clock ztimer_clock_t;
  */
 struct ztimer_base {
     ztimer_base_t *next;        /**< next timer in list */
-    uint32_t offset;            /**< offset from last timer in list */
+    uint32_t offset;            /**< offset from last timer in list, or the
+                                     absolute target with `ztimer_wheel` */
+#if MODULE_ZTIMER_WHEEL || DOXYGEN
+    ztimer_base_t **pprev;      /**< pointer to the pointer to this timer,
+                                     NULL if the timer is not set */
+#endif
 };
 
+#if MODULE_ZTIMER_WHEEL || DOXYGEN
+/**
+ * @brief   Timer wheel of a clock
+ */
+typedef struct {
+    /**
+     * @brief   Timer lists of all slots
+     */
+    ztimer_base_t *slots[ZTIMER_WHEEL_LEVELS][ZTIMER_WHEEL_SLOTS];
+    unsigned occupied[ZTIMER_WHEEL_LEVELS]; /**< bitmaps of non-empty slots */
+} ztimer_wheel_t;
+#endif
+
 #if MODULE_ZTIMER_NOW64
 typedef uint64_t ztimer_now_t;  /**< type for ztimer_now() result */
 #else
@@ -296,6 +365,10 @@ struct ztimer_clock {
     const ztimer_ops_t *ops;        /**< pointer to methods structure       */
     ztimer_base_t *last;            /**< last timer in queue, for _is_set() */
     uint32_t adjust;                /**< will be subtracted on every set()  */
+#if MODULE_ZTIMER_WHEEL || DOXYGEN
+    /* with ztimer_wheel, list only holds the expired timers */
+    ztimer_wheel_t wheel;           /**< timers not expired yet             */
+#endif
 #if MODULE_ZTIMER_EXTEND || MODULE_ZTIMER_NOW64 || DOXYGEN
     /* values used for checkpointed intervals and 32bit extension */
     uint32_t max_value;             /**< maximum relative timer value       */
@@ -0,0 +1,135 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser General
+ * Public License v2.1. See the file LICENSE in the top level directory for more
+ * details.
+ */
+
+/**
+ * @defgroup    sys_ztimer_wheel  ztimer timer wheel
+ * @ingroup     sys_ztimer
+ * @brief       Hierarchical timer wheel storing the timers of a clock
+ *
+ * This module replaces the sorted list of timers of every ztimer clock by a
+ * hierarchical timer wheel, see the "Timer wheel" section of @ref sys_ztimer.
+ * The functions below are used by ztimer core only.
+ *
+ * All functions must be called with interrupts disabled.
+ *
+ * @{
+ *
+ * @file
+ * @brief       ztimer_wheel internal API
+ */
+
+#ifndef ZTIMER_WHEEL_H
+#define ZTIMER_WHEEL_H
+
+#include <stdint.h>
+
+#include "ztimer.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Add a timer to the wheel of a clock
+ *
+ * @internal
+ *
+ * @param[in]   clock   ztimer clock to work on
+ * @param[in]   entry   timer to add, must not be set
+ * @param[in]   val     timer target, relative to the clock's base time
+ *                      (`clock->list.offset`)
+ */
+void ztimer_wheel_add(ztimer_clock_t *clock, ztimer_base_t *entry,
+                      uint32_t val);
+
+/**
+ * @brief   Remove a timer from the wheel or the expired timers of a clock
+ *
+ * @internal
+ *
+ * @param[in]   clock   ztimer clock to work on
+ * @param[in]   entry   timer to remove, must be set
+ */
+void ztimer_wheel_del(ztimer_clock_t *clock, ztimer_base_t *entry);
+
+/**
+ * @brief   Get the offset of the next point in time the clock must be
+ *          handled at
+ *
+ * @internal
+ *
+ * This is either the target of the next timer or the time timers have to be
+ * moved to a lower level of the wheel.
+ *
+ * @param[in]   clock   ztimer clock to work on
+ * @param[out]  offset  offset relative to the clock's base time, 0 if there
+ *                      are expired timers
+ *
+ * @return  1, if @p offset was set
+ * @return  0, if no timers are set on @p clock
+ */
+int ztimer_wheel_next(const ztimer_clock_t *clock, uint32_t *offset);
+
+/**
+ * @brief   Move the base time of a clock forward
+ *
+ * @internal
+ *
+ * Timers whose target is reached are moved to the expired timers in
+ * `clock->list`.
+ *
+ * @param[in]   clock   ztimer clock to work on
+ * @param[in]   diff    ticks to move the base time by
+ */
+void ztimer_wheel_advance(ztimer_clock_t *clock, uint32_t diff);
+
+/**
+ * @brief   Take the next expired timer from a clock
+ *
+ * @internal
+ *
+ * @param[in]   clock   ztimer clock to work on
+ *
+ * @return  the timer, which is not set anymore
+ * @return  NULL, if no timer has expired
+ */
+ztimer_base_t *ztimer_wheel_pop(ztimer_clock_t *clock);
+
+/**
+ * @brief   Check if any timer is set on a clock
+ *
+ * @internal
+ *
+ * @param[in]   clock   ztimer clock to check
+ *
+ * @return  1, if no timer is set on @p clock
+ * @return  0, otherwise
+ */
+int ztimer_wheel_is_empty(const ztimer_clock_t *clock);
+
+/**
+ * @brief   Check if a timer is set
+ *
+ * @internal
+ *
+ * @param[in]   entry   timer to check
+ *
+ * @return  1, if @p entry is set
+ * @return  0, otherwise
+ */
+static inline int ztimer_wheel_is_set(const ztimer_base_t *entry)
+{
+    return (entry->pprev != NULL);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZTIMER_WHEEL_H */
+/** @} */
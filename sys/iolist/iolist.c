@@ -18,6 +18,8 @@
  * @}
  */
 
+#include <stdint.h>
+#include <string.h>
 #include <sys/uio.h>
 
 #include "iolist.h"
@@ -60,3 +62,21 @@ size_t iolist_to_iovec(const iolist_t *iolist, struct iovec *iov, unsigned *coun
 
     return bytes;
 }
+
+size_t iolist_copy(const iolist_t *iolist, void *buf, size_t len)
+{
+    uint8_t *ptr = buf;
+
+    while (iolist && (len > 0)) {
+        size_t chunk = (iolist->iol_len < len) ? iolist->iol_len : len;
+
+        /* empty entries may not even have a buffer */
+        if (chunk > 0) {
+            memcpy(ptr, iolist->iol_base, chunk);
+            ptr += chunk;
+            len -= chunk;
+        }
+        iolist = iolist->iol_next;
+    }
+    return ptr - (uint8_t *)buf;
+}
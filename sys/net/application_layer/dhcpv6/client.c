@@ -13,6 +13,7 @@
  * @author  Martine Lenders <m.lenders@fu-berlin.de>
  */
 
+#include <errno.h>
 #include <stdbool.h>
 
 #include "event.h"
@@ -65,7 +66,6 @@ typedef struct {
 } server_t;
 
 static uint8_t send_buf[DHCPV6_CLIENT_BUFLEN];
-static uint8_t recv_buf[DHCPV6_CLIENT_BUFLEN];
 static uint8_t best_adv[DHCPV6_CLIENT_BUFLEN];
 static uint8_t duid[DHCPV6_CLIENT_DUID_LEN];
 static pfx_lease_t pfx_leases[DHCPV6_CLIENT_PFX_LEASE_MAX];
@@ -422,7 +422,9 @@ static int _preparse_advertise(uint8_t *adv, size_t len, uint8_t **buf)
         pref_val = pref->value;
     }
     if ((server.duid_len == 0) || (pref_val > server.pref)) {
-        memcpy(best_adv, recv_buf, orig_len);
+        if (adv != best_adv) {
+            memcpy(best_adv, adv, orig_len);
+        }
         if (buf != NULL) {
             *buf = best_adv;
         }
@@ -673,11 +675,47 @@ static bool _parse_reply(uint8_t *rep, size_t len)
     return true;
 }
 
+/* releases a message received with _recv() */
+static void _release_recv(void **ctx)
+{
+    void *data;
+
+    while ((*ctx != NULL) &&
+           (sock_udp_recv_buf(&sock, &data, ctx, 0, NULL) > 0)) {}
+}
+
+/* receives a message within the buffer space of the network stack, the
+ * previously received message in ctx is released */
+static int _recv(uint8_t **msg, void **ctx, uint32_t timeout)
+{
+    void *data;
+    int res;
+
+    _release_recv(ctx);
+    res = sock_udp_recv_buf(&sock, &data, ctx, timeout, NULL);
+    if (res > (int)DHCPV6_CLIENT_BUFLEN) {
+        /* would not fit best_adv */
+        _release_recv(ctx);
+        return -ENOBUFS;
+    }
+    if (res > 0) {
+        /* resizing to the current size fails for a message spread over
+         * several chunks, which can't be parsed in place */
+        if (sock_udp_buf_resize(&data, ctx, res) < 0) {
+            _release_recv(ctx);
+            return -ENOTSUP;
+        }
+        *msg = data;
+    }
+    return res;
+}
+
 static void _solicit_servers(event_t *event)
 {
     dhcpv6_msg_t *msg = (dhcpv6_msg_t *)&send_buf[0];
     dhcpv6_opt_elapsed_time_t *time;
-    uint8_t *buf = NULL;
+    uint8_t *buf = NULL, *recv_buf = NULL;
+    void *recv_ctx = NULL;
     uint32_t retrans_timeout = _irt_us(DHCPV6_SOL_TIMEOUT, true);
     size_t msg_len = sizeof(dhcpv6_msg_t);
     int res, best_res = 0;
@@ -698,8 +736,7 @@ static void _solicit_servers(event_t *event)
     DEBUG("DHCPv6 client: send SOLICIT\n");
     res = sock_udp_send(&sock, send_buf, msg_len, &remote);
     assert(res > 0);    /* something went terribly wrong */
-    while (((res = sock_udp_recv(&sock, recv_buf, sizeof(recv_buf),
-                                 retrans_timeout, NULL)) <= 0) ||
+    while (((res = _recv(&recv_buf, &recv_ctx, retrans_timeout)) <= 0) ||
            (first_rt && (res > 0)) ||
            ((res > 0) && (recv_buf[0] != DHCPV6_ADVERTISE))) {
         if (first_rt && (res > 0) && (recv_buf[0] == DHCPV6_ADVERTISE)) {
@@ -736,6 +773,7 @@ static void _solicit_servers(event_t *event)
     if (best_res > 0) {
         _parse_advertise(buf, best_res);
     }
+    _release_recv(&recv_ctx);
 }
 
 static void _request_renew_rebind(uint8_t type)
@@ -744,6 +782,8 @@ static void _request_renew_rebind(uint8_t type)
     dhcpv6_opt_elapsed_time_t *time;
     uint32_t retrans_timeout;
     size_t msg_len = sizeof(dhcpv6_msg_t);
+    uint8_t *recv_buf = NULL;
+    void *recv_ctx = NULL;
     int res;
     uint16_t oro_opts[] = { DHCPV6_OPT_SMR };
     uint8_t retrans = 0;
@@ -803,8 +843,7 @@ static void _request_renew_rebind(uint8_t type)
                                 ARRAY_SIZE(oro_opts));
     msg_len += _add_ia_pd_from_config(&send_buf[msg_len]);
     while (sock_udp_send(&sock, send_buf, msg_len, &remote) <= 0) {}
-    while (((res = sock_udp_recv(&sock, recv_buf, sizeof(recv_buf),
-                                 retrans_timeout, NULL)) <= 0) ||
+    while (((res = _recv(&recv_buf, &recv_ctx, retrans_timeout)) <= 0) ||
            ((res > 0) && (recv_buf[0] != DHCPV6_REPLY))) {
         if ((mrd > 0) && (_get_elapsed_time() > (mrd * CS_PER_SEC))) {
             break;
@@ -828,6 +867,7 @@ static void _request_renew_rebind(uint8_t type)
     else if (type == DHCPV6_REBIND) {
         _post_solicit_servers(NULL);
     }
+    _release_recv(&recv_ctx);
 }
 
 static void _request(event_t *event)
@@ -222,17 +222,24 @@ int sock_dns_query(const char *domain_name, void *addr_out, int family)
         if (res <= 0) {
             continue;
         }
-        res = sock_udp_recv(&sock_dns, dns_buf, sizeof(dns_buf), 1000000LU, NULL);
+        /* parse the reply within the buffer space of the network stack */
+        void *reply, *ctx = NULL;
+        res = sock_udp_recv_buf(&sock_dns, &reply, &ctx, 1000000LU, NULL);
         if (res > 0) {
-            if (res > (int)DNS_MIN_REPLY_LEN) {
-                if ((res = _parse_dns_reply(dns_buf, res, addr_out,
-                                            family)) > 0) {
-                    goto out;
-                }
+            /* resizing to the current size fails for a reply spread over
+             * several chunks, which can't be parsed in place */
+            if ((res > (int)DNS_MIN_REPLY_LEN) &&
+                (sock_udp_buf_resize(&reply, &ctx, res) == 0)) {
+                res = _parse_dns_reply(reply, res, addr_out, family);
             }
             else {
                 res = -EBADMSG;
             }
+            /* release the reply */
+            while (sock_udp_recv_buf(&sock_dns, &reply, &ctx, 0, NULL) > 0) {}
+            if (res > 0) {
+                goto out;
+            }
         }
     }
 
@@ -20,6 +20,7 @@
 
 #include <string.h>
 
+#include "iolist.h"
 #include "log.h"
 #include "mutex.h"
 #include "sched.h"
@@ -93,7 +94,7 @@ static void time_evt(void *arg)
     thread_flags_set((thread_t *)arg, TFLAGS_TIMEOUT);
 }
 
-static int syncsend(uint8_t resp, size_t len, bool unlock)
+static int syncsendv(uint8_t resp, const iolist_t *msg, bool unlock)
 {
     int res = EMCUTE_TIMEOUT;
     waiton = resp;
@@ -104,7 +105,7 @@ static int syncsend(uint8_t resp, size_t len, bool unlock)
 
     for (unsigned retries = 0; retries <= EMCUTE_N_RETRY; retries++) {
         DEBUG("[emcute] syncsend: sending round %i\n", retries);
-        sock_udp_send(&sock, tbuf, len, &gateway);
+        sock_udp_sendv(&sock, msg, &gateway);
 
         xtimer_set(&timer, (EMCUTE_T_RETRY * US_PER_SEC));
         thread_flags_t flags = thread_flags_wait_any(TFLAGS_ANY);
@@ -124,6 +125,13 @@ static int syncsend(uint8_t resp, size_t len, bool unlock)
     return res;
 }
 
+static int syncsend(uint8_t resp, size_t len, bool unlock)
+{
+    const iolist_t msg = { NULL, tbuf, len };
+
+    return syncsendv(resp, &msg, unlock);
+}
+
 static void on_disconnect(void)
 {
     if (waiton == DISCONNECT) {
@@ -354,13 +362,16 @@ int emcute_pub(emcute_topic_t *topic, const void *data, size_t len,
     byteorder_htobebufs(&tbuf[pos], id_next);
     waitonid = id_next++;
     pos += 2;
-    memcpy(&tbuf[pos], data, len);
+
+    /* send the payload straight from the user's buffer behind the header */
+    iolist_t payload = { NULL, (void *)data, len };
+    iolist_t msg = { &payload, tbuf, pos };
 
     if (flags & EMCUTE_QOS_1) {
-        res = syncsend(PUBACK, len + pos, true);
+        res = syncsendv(PUBACK, &msg, true);
     }
     else {
-        sock_udp_send(&sock, tbuf, len + pos, &gateway);
+        sock_udp_sendv(&sock, &msg, &gateway);
         mutex_unlock(&txlock);
     }
 
@@ -483,11 +494,12 @@ int emcute_willupd_msg(const void *data, size_t len)
     mutex_lock(&txlock);
 
     size_t pos = set_len(tbuf, (len + 1));
-    len += (pos + 1);
     tbuf[pos++] = WILLMSGUPD;
-    memcpy(&tbuf[pos], data, len);
 
-    return syncsend(WILLMSGRESP, len, true);
+    iolist_t payload = { NULL, (void *)data, len };
+    iolist_t msg = { &payload, tbuf, pos };
+
+    return syncsendv(WILLMSGRESP, &msg, true);
 }
 
 void emcute_run(uint16_t port, const char *id)
@@ -100,7 +100,6 @@ static gcoap_state_t _coap_state = {
 static kernel_pid_t _pid = KERNEL_PID_UNDEF;
 static char _msg_stack[GCOAP_STACK_SIZE];
 static event_queue_t _queue;
-static uint8_t _listen_buf[CONFIG_GCOAP_PDU_BUF_SIZE];
 static sock_udp_t _sock;
 
 /* Event loop for gcoap _pid thread. */
@@ -127,27 +126,50 @@ static void *_event_loop(void *arg)
     return 0;
 }
 
+/* Releases the buffer space of a received message */
+static void _release_buf(sock_udp_t *sock, void *buf_ctx)
+{
+    void *buf;
+
+    while ((buf_ctx != NULL) &&
+           (sock_udp_recv_buf(sock, &buf, &buf_ctx, 0, NULL) > 0)) {}
+}
+
 /* Handles sock events from the event queue. */
 static void _on_sock_evt(sock_udp_t *sock, sock_async_flags_t type, void *arg)
 {
     coap_pkt_t pdu;
     sock_udp_ep_t remote;
     gcoap_request_memo_t *memo = NULL;
+    void *buf, *buf_ctx = NULL;
+    size_t msg_len;
 
     (void)arg;
     if (type & SOCK_ASYNC_MSG_RECV) {
-        ssize_t res = sock_udp_recv(sock, _listen_buf, sizeof(_listen_buf),
-                                    0, &remote);
+        /* the message is parsed and, if possible, answered within the buffer
+         * space of the network stack */
+        ssize_t res = sock_udp_recv_buf(sock, &buf, &buf_ctx, 0, &remote);
         if (res <= 0) {
             DEBUG("gcoap: udp recv failure: %d\n", (int)res);
             return;
         }
+        if (res > CONFIG_GCOAP_PDU_BUF_SIZE) {
+            DEBUG("gcoap: message too large: %d\n", (int)res);
+            goto out;
+        }
+        /* only messages within a single chunk can be parsed in place;
+         * resizing to the current size fails for all others */
+        if (sock_udp_buf_resize(&buf, &buf_ctx, res) < 0) {
+            DEBUG("gcoap: message not contiguous\n");
+            goto out;
+        }
 
-        res = coap_parse(&pdu, _listen_buf, res);
+        msg_len = res;
+        res = coap_parse(&pdu, buf, msg_len);
         if (res < 0) {
             DEBUG("gcoap: parse failure: %d\n", (int)res);
             /* If a response, can't clear memo, but it will timeout later. */
-            return;
+            goto out;
         }
 
         /* validate class and type for incoming */
@@ -157,10 +179,17 @@ static void _on_sock_evt(sock_udp_t *sock, sock_async_flags_t type, void *arg)
             if (coap_get_code_raw(&pdu) == COAP_CODE_EMPTY) {
                 /* ping request */
                 if (coap_get_type(&pdu) == COAP_TYPE_CON) {
-                    coap_hdr_set_type(pdu.hdr, COAP_TYPE_RST);
+                    if (sock_udp_buf_resize(&buf, &buf_ctx,
+                                            sizeof(coap_hdr_t)) < 0) {
+                        DEBUG("gcoap: no buffer for ping response\n");
+                        break;
+                    }
+                    coap_hdr_set_type(buf, COAP_TYPE_RST);
 
-                    ssize_t bytes = sock_udp_send(sock, _listen_buf,
-                                                  sizeof(coap_hdr_t), &remote);
+                    ssize_t bytes = sock_udp_send_buf(sock, buf_ctx,
+                                                      sizeof(coap_hdr_t),
+                                                      &remote);
+                    buf_ctx = NULL;
                     if (bytes <= 0) {
                         DEBUG("gcoap: ping response failed: %d\n", (int)bytes);
                     }
@@ -174,11 +203,24 @@ static void _on_sock_evt(sock_udp_t *sock, sock_async_flags_t type, void *arg)
             /* normal request */
             else if (coap_get_type(&pdu) == COAP_TYPE_NON
                     || coap_get_type(&pdu) == COAP_TYPE_CON) {
-                size_t pdu_len = _handle_req(&pdu, _listen_buf, sizeof(_listen_buf),
+                void *req = buf;
+
+                /* the response is written over the request */
+                if (sock_udp_buf_resize(&buf, &buf_ctx,
+                                        CONFIG_GCOAP_PDU_BUF_SIZE) < 0) {
+                    DEBUG("gcoap: no buffer for response\n");
+                    break;
+                }
+                if ((buf != req) && (coap_parse(&pdu, buf, msg_len) < 0)) {
+                    break;
+                }
+                size_t pdu_len = _handle_req(&pdu, buf,
+                                             CONFIG_GCOAP_PDU_BUF_SIZE,
                                              &remote);
                 if (pdu_len > 0) {
-                    ssize_t bytes = sock_udp_send(sock, _listen_buf, pdu_len,
-                                                  &remote);
+                    ssize_t bytes = sock_udp_send_buf(sock, buf_ctx, pdu_len,
+                                                      &remote);
+                    buf_ctx = NULL;
                     if (bytes <= 0) {
                         DEBUG("gcoap: send response failed: %d\n", (int)bytes);
                     }
@@ -191,7 +233,7 @@ static void _on_sock_evt(sock_udp_t *sock, sock_async_flags_t type, void *arg)
 
 empty_as_response:
             DEBUG("gcoap: empty ack/reset not handled yet\n");
-            return;
+            break;
 
         /* incoming response */
         case COAP_CLASS_SUCCESS:
@@ -230,6 +272,8 @@ empty_as_response:
         default:
             DEBUG("gcoap: illegal code class: %u\n", coap_get_code_class(&pdu));
         }
+out:
+        _release_buf(sock, buf_ctx);
     }
 }
 
@@ -402,30 +446,16 @@ static int _find_resource(coap_pkt_t *pdu, const coap_resource_t **resource_ptr,
     }
 
     while (listener) {
-        const coap_resource_t *resource = listener->resources;
-        for (size_t i = 0; i < listener->resources_len; i++) {
-            if (i) {
-                resource++;
-            }
-
-            int res = coap_match_path(resource, uri);
-            if (res > 0) {
-                continue;
-            }
-            else if (res < 0) {
-                /* resources expected in alphabetical order */
-                break;
-            }
-            else {
-                if (! (resource->methods & method_flag)) {
-                    ret = GCOAP_RESOURCE_WRONG_METHOD;
-                    continue;
-                }
-
-                *resource_ptr = resource;
-                *listener_ptr = listener;
-                return GCOAP_RESOURCE_FOUND;
-            }
+        /* resources expected in alphabetical order */
+        int res = coap_find_resource(listener->resources,
+                                     listener->resources_len, uri,
+                                     method_flag, resource_ptr);
+        if (res == 0) {
+            *listener_ptr = listener;
+            return GCOAP_RESOURCE_FOUND;
+        }
+        else if (res == -ENOTSUP) {
+            ret = GCOAP_RESOURCE_WRONG_METHOD;
         }
         listener = listener->next;
     }
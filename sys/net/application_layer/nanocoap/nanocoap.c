@@ -178,14 +178,23 @@ int coap_match_path(const coap_resource_t *resource, uint8_t *uri)
 
 uint8_t *coap_find_option(const coap_pkt_t *pkt, unsigned opt_num)
 {
-    const coap_optpos_t *optpos = pkt->options;
-    unsigned opt_count = pkt->options_len;
-
-    while (opt_count--) {
-        if (optpos->opt_num == opt_num) {
-            return (uint8_t*)pkt->hdr + optpos->offset;
+    /* the option index is sorted by option number, both when filled by
+     * coap_parse() and by the packet API, so search for the first entry not
+     * below opt_num */
+    unsigned lo = 0;
+    unsigned hi = pkt->options_len;
+
+    while (lo < hi) {
+        unsigned mid = (lo + hi) / 2;
+        if (pkt->options[mid].opt_num < opt_num) {
+            lo = mid + 1;
+        }
+        else {
+            hi = mid;
         }
-        optpos++;
+    }
+    if ((lo < pkt->options_len) && (pkt->options[lo].opt_num == opt_num)) {
+        return (uint8_t *)pkt->hdr + pkt->options[lo].offset;
     }
     return NULL;
 }
@@ -219,6 +228,24 @@ static uint8_t *_parse_option(const coap_pkt_t *pkt,
     return pkt_pos;
 }
 
+/*
+ * Look up an option in the option index and decode its header
+ *
+ * return         start of the option value, opt_len set to its length
+ * return         NULL if the option is not present
+ */
+static uint8_t *_get_option(const coap_pkt_t *pkt, unsigned opt_num,
+                            int *opt_len)
+{
+    uint8_t *opt_pos = coap_find_option(pkt, opt_num);
+    uint16_t delta;
+
+    if (!opt_pos) {
+        return NULL;
+    }
+    return _parse_option(pkt, opt_pos, &delta, opt_len);
+}
+
 ssize_t coap_opt_get_opaque(const coap_pkt_t *pkt, unsigned opt_num, uint8_t **value)
 {
     uint8_t *start = coap_find_option(pkt, opt_num);
@@ -241,11 +268,9 @@ int coap_opt_get_uint(const coap_pkt_t *pkt, uint16_t opt_num, uint32_t *target)
 {
     assert(target);
 
-    uint8_t *opt_pos = coap_find_option(pkt, opt_num);
-    if (opt_pos) {
-        uint16_t delta;
-        int option_len = 0;
-        uint8_t *pkt_pos = _parse_option(pkt, opt_pos, &delta, &option_len);
+    int option_len = 0;
+    uint8_t *pkt_pos = _get_option(pkt, opt_num, &option_len);
+    if (pkt_pos) {
         if (option_len >= 0) {
             if (option_len > 4) {
                 DEBUG("nanocoap: uint option with len > 4 (unsupported).\n");
@@ -281,13 +306,10 @@ uint8_t *coap_iterate_option(const coap_pkt_t *pkt, uint8_t **optpos,
 
 unsigned coap_get_content_type(coap_pkt_t *pkt)
 {
-    uint8_t *opt_pos = coap_find_option(pkt, COAP_OPT_CONTENT_FORMAT);
+    int option_len = 0;
+    uint8_t *pkt_pos = _get_option(pkt, COAP_OPT_CONTENT_FORMAT, &option_len);
     unsigned content_type = COAP_FORMAT_NONE;
-    if (opt_pos) {
-        uint16_t delta;
-        int option_len = 0;
-        uint8_t *pkt_pos = _parse_option(pkt, opt_pos, &delta, &option_len);
-
+    if (pkt_pos) {
         if (option_len == 0) {
             content_type = 0;
         } else if (option_len == 1) {
@@ -361,19 +383,11 @@ ssize_t coap_opt_get_string(const coap_pkt_t *pkt, uint16_t optnum,
 
 int coap_get_blockopt(coap_pkt_t *pkt, uint16_t option, uint32_t *blknum, unsigned *szx)
 {
-    uint8_t *optpos = coap_find_option(pkt, option);
-    if (!optpos) {
-        *blknum = 0;
-        *szx = 0;
-        return -1;
-    }
-
     int option_len;
-    uint16_t delta;
-
-    uint8_t *data_start = _parse_option(pkt, optpos, &delta, &option_len);
+    uint8_t *data_start = _get_option(pkt, option, &option_len);
     if (!data_start) {
-        DEBUG("nanocoap: invalid start data\n");
+        *blknum = 0;
+        *szx = 0;
         return -1;
     }
 
@@ -401,12 +415,71 @@ ssize_t coap_handle_req(coap_pkt_t *pkt, uint8_t *resp_buf, unsigned resp_buf_le
                              coap_resources_numof);
 }
 
+/*
+ * Returns the first resource in [lo, hi) whose path has a character greater
+ * than or equal to (upper == false) or greater than (upper == true) c at
+ * position pos. The paths in [lo, hi) must share the first pos characters.
+ */
+static size_t _find_bound(const coap_resource_t *resources, size_t lo,
+                          size_t hi, size_t pos, uint8_t c, bool upper)
+{
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        uint8_t mid_c = resources[mid].path[pos];
+
+        if ((mid_c < c) || (upper && (mid_c == c))) {
+            lo = mid + 1;
+        }
+        else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+int coap_find_resource(const coap_resource_t *resources,
+                       size_t resources_numof, const uint8_t *uri,
+                       coap_method_flags_t method_flag,
+                       const coap_resource_t **resource)
+{
+    size_t lo = 0, hi = resources_numof;
+    int res = -ENOENT;
+
+    assert((resources || !resources_numof) && uri && resource);
+
+    /* The sorted array is an implicit radix tree: the resources whose paths
+     * start with the first pos characters of the URI form the range
+     * [lo, hi), the paths ending at pos sort first within it. */
+    for (size_t pos = 0; lo < hi; pos++) {
+        size_t end = _find_bound(resources, lo, hi, pos, '\0', true);
+
+        for (; lo < end; lo++) {
+            if ((uri[pos] != '\0') &&
+                !(resources[lo].methods & COAP_MATCH_SUBTREE)) {
+                continue;
+            }
+            if (resources[lo].methods & method_flag) {
+                *resource = &resources[lo];
+                return 0;
+            }
+            res = -ENOTSUP;
+        }
+        if (uri[pos] == '\0') {
+            break;
+        }
+        lo = _find_bound(resources, lo, hi, pos, uri[pos], false);
+        hi = _find_bound(resources, lo, hi, pos, uri[pos], true);
+    }
+    return res;
+}
+
 ssize_t coap_tree_handler(coap_pkt_t *pkt, uint8_t *resp_buf,
                           unsigned resp_buf_len,
                           const coap_resource_t *resources,
                           size_t resources_numof)
 {
     coap_method_flags_t method_flag = coap_method2flag(coap_get_code_detail(pkt));
+    const coap_resource_t *resource;
 
     uint8_t uri[CONFIG_NANOCOAP_URI_MAX];
     if (coap_get_uri_path(pkt, uri) <= 0) {
@@ -414,22 +487,9 @@ ssize_t coap_tree_handler(coap_pkt_t *pkt, uint8_t *resp_buf,
     }
     DEBUG("nanocoap: URI path: \"%s\"\n", uri);
 
-    for (unsigned i = 0; i < resources_numof; i++) {
-        const coap_resource_t *resource = &resources[i];
-        if (!(resource->methods & method_flag)) {
-            continue;
-        }
-
-        int res = coap_match_path(resource, uri);
-        if (res > 0) {
-            continue;
-        }
-        else if (res < 0) {
-            break;
-        }
-        else {
-            return resource->handler(pkt, resp_buf, resp_buf_len, resource->context);
-        }
+    if (coap_find_resource(resources, resources_numof, uri, method_flag,
+                           &resource) == 0) {
+        return resource->handler(pkt, resp_buf, resp_buf_len, resource->context);
     }
 
     return coap_build_reply(pkt, COAP_CODE_404, resp_buf, resp_buf_len, 0);
@@ -13,13 +13,146 @@
  */
 
 #include <inttypes.h>
+#include <stdbool.h>
 #include <stdio.h>
+#include "byteorder.h"
 #include "od.h"
 #include "net/inet_csum.h"
 
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
 
+/**
+ * @brief   Use the ADCS based assembly loop on ARMv7-M
+ *
+ * Set to 0 to use the portable C implementation instead.
+ */
+#ifndef INET_CSUM_ARMV7M_ASM
+#if defined(CPU_CORE_CORTEX_M3) || defined(CPU_CORE_CORTEX_M4) || \
+    defined(CPU_CORE_CORTEX_M4F) || defined(CPU_CORE_CORTEX_M7)
+#define INET_CSUM_ARMV7M_ASM    (1)
+#else
+#define INET_CSUM_ARMV7M_ASM    (0)
+#endif
+#endif
+
+/**
+ * @brief   Machine word the bulk of the buffer is summed up in
+ */
+typedef uintptr_t _word_t;
+
+static inline uint16_t _fold(uint64_t sum)
+{
+    while (sum >> 16) {
+        sum = (sum & 0xffff) + (sum >> 16);
+    }
+    return sum;
+}
+
+#if INET_CSUM_ARMV7M_ASM
+/* sums up blocks of 16 byte with end-around carry, so the result is the
+ * 1's complement sum of the 32-bit words */
+static inline uint32_t _sum_blocks(const uint8_t **buf, size_t blocks)
+{
+    const uint8_t *ptr = *buf;
+    uint32_t sum = 0, a, b, c, d;
+
+    __asm__ volatile (
+        "adds   %[sum], %[sum], #0          \n" /* clear carry */
+        "1:                                 \n"
+        "ldrd   %[a], %[b], [%[ptr]], #8    \n"
+        "ldrd   %[c], %[d], [%[ptr]], #8    \n"
+        "adcs   %[sum], %[sum], %[a]        \n"
+        "adcs   %[sum], %[sum], %[b]        \n"
+        "adcs   %[sum], %[sum], %[c]        \n"
+        "adcs   %[sum], %[sum], %[d]        \n"
+        "sub    %[blocks], %[blocks], #1    \n" /* keeps carry */
+        "teq    %[blocks], #0               \n" /* keeps carry */
+        "bne    1b                          \n"
+        "adc    %[sum], %[sum], #0          \n"
+        : [sum] "+r" (sum), [ptr] "+r" (ptr), [blocks] "+r" (blocks),
+          [a] "=&r" (a), [b] "=&r" (b), [c] "=&r" (c), [d] "=&r" (d)
+        :
+        : "cc", "memory"
+    );
+    *buf = ptr;
+    return sum;
+}
+#else   /* INET_CSUM_ARMV7M_ASM */
+static inline uint64_t _sum_blocks(const uint8_t **buf, size_t blocks)
+{
+    const _word_t *words = (const _word_t *)(uintptr_t)*buf;
+    _word_t sum = 0;
+    unsigned carry = 0;
+
+    /* every overflow of sum is a 1 carried out of the word, which is 1 in
+     * 1's complement arithmetic on 16-bit words again */
+    while (blocks--) {
+        for (unsigned i = 0; i < (16 / sizeof(_word_t)); i++) {
+            _word_t w = *(words++);
+
+            sum += w;
+            carry += (sum < w);
+        }
+    }
+    *buf = (const uint8_t *)words;
+    return _fold(sum) + carry;
+}
+#endif  /* INET_CSUM_ARMV7M_ASM */
+
+/*
+ * Sums up buf in the byte order of the host and adapts the result afterwards.
+ * Starting at an odd address just shifts all bytes to the other half of a
+ * 16-bit word, which is undone by swapping the bytes of the result.
+ *
+ * See RFC 1071, section 2 (B) and (C).
+ */
+static uint16_t _sum(const uint8_t *buf, size_t len)
+{
+    uint64_t sum = 0;
+    bool swap = ((uintptr_t)buf & 0x1);
+
+    if (len == 0) {
+        return 0;
+    }
+    if (swap) {
+        /* second byte of the 16-bit word at buf - 1 */
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+        sum += (uint16_t)(*buf << 8);
+#else
+        sum += *buf;
+#endif
+        buf++;
+        len--;
+    }
+    while ((len >= 2) && ((uintptr_t)buf & (sizeof(_word_t) - 1))) {
+        sum += *((const uint16_t *)(uintptr_t)buf);
+        buf += 2;
+        len -= 2;
+    }
+    if (len >= 16) {
+        sum += _sum_blocks(&buf, len / 16);
+        len &= 0xf;
+    }
+    while (len >= 2) {
+        sum += *((const uint16_t *)(uintptr_t)buf);
+        buf += 2;
+        len -= 2;
+    }
+    if (len) {
+        /* first byte of the last 16-bit word, padded with zero */
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+        sum += *buf;
+#else
+        sum += (uint16_t)(*buf << 8);
+#endif
+    }
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    swap = !swap;
+#endif
+    return (swap) ? byteorder_swaps(_fold(sum)) : _fold(sum);
+}
+
 uint16_t inet_csum_slice(uint16_t sum, const uint8_t *buf, uint16_t len, size_t accum_len)
 {
     uint32_t csum = sum;
@@ -41,25 +174,23 @@ uint16_t inet_csum_slice(uint16_t sum, const uint8_t *buf, uint16_t len, size_t
         csum += *buf;         /* add first byte as bottom half of 16-byte word */
         buf++;
         len--;
-        accum_len++;
-    }
-
-    for (unsigned i = 0; i < (len >> 1); buf += 2, i++) {
-        csum += (uint16_t)(*buf << 8) + *(buf + 1); /* group bytes by 16-byte words */
-                                                    /* and add them */
     }
 
-    if ((accum_len + len) & 1)          /* if accumulated length is odd */
-        csum += (uint16_t)(*buf << 8);  /* add last byte as top half of 16-byte word */
-
-    while (csum >> 16) {
-        uint16_t carry = csum >> 16;
-        csum = (csum & 0xffff) + carry;
-    }
+    /* remaining bytes start at an even offset of the checksum domain, a
+     * trailing odd byte is padded as top half of a 16-bit word */
+    csum = _fold(csum + _sum(buf, len));
 
     DEBUG("inet_sum: new sum = 0x%04" PRIx32 "\n", csum);
 
     return csum;
 }
 
+uint16_t inet_csum_update(uint16_t csum, const uint8_t *old_val,
+                          const uint8_t *new_val, uint16_t len)
+{
+    /* RFC 1624, eqn. 3 with m and m' being the sums of the respective field */
+    return inet_csum_update16(csum, inet_csum(0, old_val, len),
+                              inet_csum(0, new_val, len));
+}
+
 /** @} */
@@ -120,6 +120,7 @@ static const char *_netopt_strmap[] = {
     [NETOPT_DEMOD_MARGIN]          = "NETOPT_DEMOD_MARGIN",
     [NETOPT_NUM_GATEWAYS]          = "NETOPT_NUM_GATEWAYS",
     [NETOPT_LINK_CHECK]            = "NETOPT_LINK_CHECK",
+    [NETOPT_RX_DRAIN]              = "NETOPT_RX_DRAIN",
     [NETOPT_NUMOF]                 = "NETOPT_NUMOF",
 };
 
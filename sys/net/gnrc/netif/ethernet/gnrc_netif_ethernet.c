@@ -172,48 +172,95 @@ static gnrc_pktsnip_t *_recv(gnrc_netif_t *netif)
     gnrc_pktsnip_t *pkt = NULL;
 
     if (bytes_expected > 0) {
-        pkt = gnrc_pktbuf_add(NULL, NULL,
-                              bytes_expected,
-                              GNRC_NETTYPE_UNDEF);
+        gnrc_pktsnip_t *eth_hdr;
+        int nread;
+
+        if ((dev->driver->recv_iolist != NULL) &&
+            (bytes_expected > (int)sizeof(ethernet_hdr_t))) {
+            /* receive header and payload into separate snips right away,
+             * marking the header later would copy the whole frame */
+            pkt = gnrc_pktbuf_add(NULL, NULL,
+                                  bytes_expected - sizeof(ethernet_hdr_t),
+                                  GNRC_NETTYPE_UNDEF);
+            eth_hdr = (pkt) ? gnrc_pktbuf_add(pkt, NULL, sizeof(ethernet_hdr_t),
+                                              GNRC_NETTYPE_UNDEF)
+                            : NULL;
+            if (!eth_hdr) {
+                DEBUG("gnrc_netif_ethernet: cannot allocate pktsnip.\n");
+                gnrc_pktbuf_release(pkt);
+                pkt = NULL;
+
+                /* drop the packet */
+                dev->driver->recv(dev, NULL, bytes_expected, NULL);
+
+                goto out;
+            }
+            /* a gnrc_pktsnip_t can be used as an iolist_t */
+            nread = dev->driver->recv_iolist(dev, (iolist_t *)eth_hdr, NULL);
+            /* from now on pkt is the payload with the header behind it, as
+             * after gnrc_pktbuf_mark() */
+            eth_hdr->next = NULL;
+            pkt->next = eth_hdr;
+            if (nread <= (int)sizeof(ethernet_hdr_t)) {
+                DEBUG("gnrc_netif_ethernet: read error.\n");
+                goto safe_out;
+            }
+#ifdef MODULE_NETSTATS_L2
+            netif->stats.rx_count++;
+            netif->stats.rx_bytes += nread;
+#endif
+            if (nread < bytes_expected) {
+                DEBUG("gnrc_netif_ethernet: reallocating.\n");
+                gnrc_pktbuf_realloc_data(pkt, nread - sizeof(ethernet_hdr_t));
+            }
+            DEBUG("gnrc_netif_ethernet: received packet of length %d\n",
+                  nread);
+        }
+        else {
+            pkt = gnrc_pktbuf_add(NULL, NULL,
+                                  bytes_expected,
+                                  GNRC_NETTYPE_UNDEF);
 
-        if (!pkt) {
-            DEBUG("gnrc_netif_ethernet: cannot allocate pktsnip.\n");
+            if (!pkt) {
+                DEBUG("gnrc_netif_ethernet: cannot allocate pktsnip.\n");
 
-            /* drop the packet */
-            dev->driver->recv(dev, NULL, bytes_expected, NULL);
+                /* drop the packet */
+                dev->driver->recv(dev, NULL, bytes_expected, NULL);
 
-            goto out;
-        }
+                goto out;
+            }
 
-        int nread = dev->driver->recv(dev, pkt->data, bytes_expected, NULL);
-        if (nread <= 0) {
-            DEBUG("gnrc_netif_ethernet: read error.\n");
-            goto safe_out;
-        }
+            nread = dev->driver->recv(dev, pkt->data, bytes_expected, NULL);
+            if (nread <= 0) {
+                DEBUG("gnrc_netif_ethernet: read error.\n");
+                goto safe_out;
+            }
 #ifdef MODULE_NETSTATS_L2
-        netif->stats.rx_count++;
-        netif->stats.rx_bytes += nread;
+            netif->stats.rx_count++;
+            netif->stats.rx_bytes += nread;
 #endif
 
-        if (nread < bytes_expected) {
-            /* we've got less than the expected packet size,
-             * so free the unused space.*/
+            if (nread < bytes_expected) {
+                /* we've got less than the expected packet size,
+                 * so free the unused space.*/
 
-            DEBUG("gnrc_netif_ethernet: reallocating.\n");
-            gnrc_pktbuf_realloc_data(pkt, nread);
-        }
+                DEBUG("gnrc_netif_ethernet: reallocating.\n");
+                gnrc_pktbuf_realloc_data(pkt, nread);
+            }
 
-        DEBUG("gnrc_netif_ethernet: received packet from %s of length %d\n",
-              gnrc_netif_addr_to_str(pkt->data, ETHERNET_ADDR_LEN, addr_str),
-              nread);
+            DEBUG("gnrc_netif_ethernet: received packet from %s of length %d\n",
+                  gnrc_netif_addr_to_str(pkt->data, ETHERNET_ADDR_LEN, addr_str),
+                  nread);
 #if defined(MODULE_OD) && ENABLE_DEBUG
-        od_hex_dump(pkt->data, nread, OD_WIDTH_DEFAULT);
+            od_hex_dump(pkt->data, nread, OD_WIDTH_DEFAULT);
 #endif
-        /* mark ethernet header */
-        gnrc_pktsnip_t *eth_hdr = gnrc_pktbuf_mark(pkt, sizeof(ethernet_hdr_t), GNRC_NETTYPE_UNDEF);
-        if (!eth_hdr) {
-            DEBUG("gnrc_netif_ethernet: no space left in packet buffer\n");
-            goto safe_out;
+            /* mark ethernet header */
+            eth_hdr = gnrc_pktbuf_mark(pkt, sizeof(ethernet_hdr_t),
+                                       GNRC_NETTYPE_UNDEF);
+            if (!eth_hdr) {
+                DEBUG("gnrc_netif_ethernet: no space left in packet buffer\n");
+                goto safe_out;
+            }
         }
 
         ethernet_hdr_t *hdr = (ethernet_hdr_t *)eth_hdr->data;
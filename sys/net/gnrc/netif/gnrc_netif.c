@@ -31,6 +31,7 @@
 #include "net/netstats.h"
 #endif
 #include "fmt.h"
+#include "irq.h"
 #include "log.h"
 #include "sched.h"
 #include "xtimer.h"
@@ -55,6 +56,10 @@ static void _update_l2addr_from_dev(gnrc_netif_t *netif);
 static void _configure_netdev(netdev_t *dev);
 static void *_gnrc_netif_thread(void *args);
 static void _event_cb(netdev_t *dev, netdev_event_t event);
+static int _send(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt);
+#if IS_USED(MODULE_GNRC_NETIF_RX_BATCH)
+static void _recv_batch(gnrc_netif_t *netif);
+#endif
 
 int gnrc_netif_create(gnrc_netif_t *netif, char *stack, int stacksize,
                       char priority, const char *name, netdev_t *netdev,
@@ -73,6 +78,9 @@ int gnrc_netif_create(gnrc_netif_t *netif, char *stack, int stacksize,
     }
 #endif
     rmutex_init(&netif->mutex);
+#if IS_USED(MODULE_GNRC_NETIF_TXQ)
+    cib_init(&netif->txq.cib, GNRC_NETIF_TXQ_SIZE);
+#endif
     netif->ops = ops;
     netif_register((netif_t*) netif);
     assert(netif->dev == NULL);
@@ -1241,7 +1249,7 @@ static void _configure_netdev(netdev_t *dev)
     if (res < 0) {
         DEBUG("gnrc_netif: enable NETOPT_RX_END_IRQ failed: %d\n", res);
     }
-#ifdef MODULE_NETSTATS_L2
+#if IS_USED(MODULE_NETSTATS_L2) || IS_USED(MODULE_GNRC_NETIF_ETX)
     res = dev->driver->set(dev, NETOPT_TX_END_IRQ, &enable, sizeof(enable));
     if (res < 0) {
         DEBUG("gnrc_netif: enable NETOPT_TX_END_IRQ failed: %d\n", res);
@@ -1249,6 +1257,20 @@ static void _configure_netdev(netdev_t *dev)
 #endif
 }
 
+#if IS_USED(MODULE_GNRC_NETIF_RX_BATCH)
+static void _init_rx_batch(gnrc_netif_t *netif)
+{
+    netopt_enable_t drain = NETOPT_ENABLE;
+    netdev_t *dev = netif->dev;
+
+    if (dev->driver->set(dev, NETOPT_RX_DRAIN, &drain, sizeof(drain)) > 0) {
+        DEBUG("gnrc_netif: receiving frames of %" PRIkernel_pid " in batches\n",
+              netif->pid);
+        netif->flags |= GNRC_NETIF_FLAGS_RX_BATCH;
+    }
+}
+#endif /* IS_USED(MODULE_GNRC_NETIF_RX_BATCH) */
+
 #ifdef DEVELHELP
 static bool options_tested = false;
 
@@ -1459,6 +1481,266 @@ static void _process_events_await_msg(gnrc_netif_t *netif, msg_t *msg)
     }
 }
 
+#if IS_USED(MODULE_GNRC_NETIF_TXQ)
+int gnrc_netif_txq_put(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt)
+{
+    unsigned state = irq_disable();
+    bool was_empty = (cib_avail(&netif->txq.cib) == 0);
+    int idx = cib_put(&netif->txq.cib);
+
+    if (idx < 0) {
+#ifdef MODULE_NETSTATS_L2
+        netif->stats.tx_dropped++;
+#endif
+        irq_restore(state);
+        DEBUG("gnrc_netif: send queue of %" PRIkernel_pid " is full\n",
+              netif->pid);
+        return 0;
+    }
+    netif->txq.pkts[idx] = pkt;
+    irq_restore(state);
+    if (was_empty) {
+        msg_t msg = { .type = GNRC_NETIF_TXQ_MSG_TYPE };
+
+        /* if the message queue is full the thread will empty the send queue
+         * after handling the next message anyway */
+        msg_try_send(&msg, netif->pid);
+    }
+    return 1;
+}
+
+static gnrc_pktsnip_t *_txq_get(gnrc_netif_t *netif)
+{
+    gnrc_pktsnip_t *pkt = NULL;
+    unsigned state = irq_disable();
+    int idx = cib_get(&netif->txq.cib);
+
+    if (idx >= 0) {
+        pkt = netif->txq.pkts[idx];
+    }
+    irq_restore(state);
+    return pkt;
+}
+
+static void _init_txq(gnrc_netif_t *netif)
+{
+    static const netopt_enable_t enable = NETOPT_ENABLE;
+    netdev_t *dev = netif->dev;
+
+    netif->txq.tx_end_irq = (dev->driver->set(dev, NETOPT_TX_END_IRQ, &enable,
+                                              sizeof(enable)) > 0);
+    netif->txq.timeout_msg.type = GNRC_NETIF_TXQ_TIMEOUT_MSG_TYPE;
+}
+
+/* wakes the thread up for the next queued packet, after the events and
+ * messages already pending */
+static void _txq_continue(gnrc_netif_t *netif)
+{
+    if (!netif->txq.busy && (cib_avail(&netif->txq.cib) > 0)) {
+        msg_t msg = { .type = GNRC_NETIF_TXQ_MSG_TYPE };
+
+        /* if the message queue is full the thread will send the next packet
+         * after handling the next message anyway */
+        msg_send_to_self(&msg);
+    }
+}
+
+static void _txq_tx_done(gnrc_netif_t *netif)
+{
+    if (netif->txq.busy) {
+        xtimer_remove(&netif->txq.timer);
+        netif->txq.busy = false;
+        _txq_continue(netif);
+    }
+}
+
+static void _txq_timeout(gnrc_netif_t *netif, const msg_t *msg)
+{
+    /* the message might have been queued before the end of the transmission
+     * it was set for was reported */
+    if (netif->txq.busy &&
+        (msg->content.value == netif->txq.timeout_msg.content.value)) {
+        DEBUG("gnrc_netif: end of transmission not reported, "
+              "sending next packet\n");
+        /* next queued packet is sent by the thread's loop */
+        netif->txq.busy = false;
+    }
+}
+
+static bool _txq_send_next(gnrc_netif_t *netif)
+{
+    gnrc_pktsnip_t *pkt;
+
+    if (netif->txq.busy || ((pkt = _txq_get(netif)) == NULL)) {
+        return false;
+    }
+    /* set before sending, the device might report the end of the
+     * transmission from within send() */
+    netif->txq.busy = netif->txq.tx_end_irq;
+    if (_send(netif, pkt) < 0) {
+        netif->txq.busy = false;
+    }
+    else if (netif->txq.busy) {
+        /* do not wait forever for a device that fails to report the end */
+        netif->txq.timeout_msg.content.value++;
+        xtimer_set_msg(&netif->txq.timer,
+                       CONFIG_GNRC_NETIF_TXQ_TX_END_TIMEOUT_US,
+                       &netif->txq.timeout_msg, netif->pid);
+    }
+    _txq_continue(netif);
+    return true;
+}
+#endif /* IS_USED(MODULE_GNRC_NETIF_TXQ) */
+
+#if IS_USED(MODULE_GNRC_NETIF_ETX) && (GNRC_NETIF_L2ADDR_MAXLEN > 0)
+static gnrc_netif_etx_entry_t *_etx_lookup(gnrc_netif_t *netif,
+                                           const uint8_t *l2addr,
+                                           size_t l2addr_len)
+{
+    for (unsigned i = 0; i < CONFIG_GNRC_NETIF_ETX_NUMOF; i++) {
+        gnrc_netif_etx_entry_t *entry = &netif->etx.entries[i];
+
+        if ((entry->l2addr_len == l2addr_len) &&
+            (memcmp(entry->l2addr, l2addr, l2addr_len) == 0)) {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+uint16_t gnrc_netif_etx_get(gnrc_netif_t *netif, const uint8_t *l2addr,
+                            size_t l2addr_len)
+{
+    gnrc_netif_etx_entry_t *entry = _etx_lookup(netif, l2addr, l2addr_len);
+
+    return (entry != NULL) ? entry->etx : GNRC_NETIF_ETX_UNKNOWN;
+}
+
+static void _etx_tx_start(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt)
+{
+    gnrc_netif_hdr_t *hdr;
+    gnrc_netif_etx_entry_t *entry;
+
+    netif->etx.pending = NULL;
+    if ((pkt == NULL) || (pkt->type != GNRC_NETTYPE_NETIF)) {
+        return;
+    }
+    hdr = pkt->data;
+    if ((hdr->flags & (GNRC_NETIF_HDR_FLAGS_BROADCAST |
+                       GNRC_NETIF_HDR_FLAGS_MULTICAST)) ||
+        (hdr->dst_l2addr_len == 0) ||
+        (hdr->dst_l2addr_len > GNRC_NETIF_L2ADDR_MAXLEN)) {
+        return;
+    }
+    netif->etx.clock++;
+    entry = _etx_lookup(netif, gnrc_netif_hdr_get_dst_addr(hdr),
+                        hdr->dst_l2addr_len);
+    if (entry == NULL) {
+        /* replace the unused or least recently used entry */
+        entry = &netif->etx.entries[0];
+        for (unsigned i = 0; i < CONFIG_GNRC_NETIF_ETX_NUMOF; i++) {
+            gnrc_netif_etx_entry_t *tmp = &netif->etx.entries[i];
+
+            if (tmp->l2addr_len == 0) {
+                entry = tmp;
+                break;
+            }
+            if ((uint16_t)(netif->etx.clock - tmp->last_used) >
+                (uint16_t)(netif->etx.clock - entry->last_used)) {
+                entry = tmp;
+            }
+        }
+        memcpy(entry->l2addr, gnrc_netif_hdr_get_dst_addr(hdr),
+               hdr->dst_l2addr_len);
+        entry->l2addr_len = hdr->dst_l2addr_len;
+        entry->etx = GNRC_NETIF_ETX_UNKNOWN;
+    }
+    entry->last_used = netif->etx.clock;
+    netif->etx.pending = entry;
+}
+
+static void _etx_tx_done(gnrc_netif_t *netif, netdev_event_t event)
+{
+    gnrc_netif_etx_entry_t *entry = netif->etx.pending;
+    uint16_t sample;
+
+    if (entry == NULL) {
+        return;
+    }
+    netif->etx.pending = NULL;
+    if (event == NETDEV_EVENT_TX_COMPLETE) {
+        uint8_t retries = 0;
+
+        if (netif->dev->driver->get(netif->dev, NETOPT_TX_RETRIES_NEEDED,
+                                    &retries, sizeof(retries)) < 0) {
+            retries = 0;
+        }
+        sample = (retries + 1U) * GNRC_NETIF_ETX_DIVISOR;
+    }
+    else if (event == NETDEV_EVENT_TX_NOACK) {
+        sample = GNRC_NETIF_ETX_NOACK_PENALTY * GNRC_NETIF_ETX_DIVISOR;
+    }
+    else {
+        /* a busy medium says nothing about the link */
+        return;
+    }
+    entry->etx = gnrc_netif_etx_update(entry->etx, sample);
+    DEBUG("gnrc_netif: ETX sample %u, estimate %u (/%u)\n", sample,
+          entry->etx, GNRC_NETIF_ETX_DIVISOR);
+}
+#else
+static inline void _etx_tx_start(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt)
+{
+    (void)netif;
+    (void)pkt;
+}
+
+static inline void _etx_tx_done(gnrc_netif_t *netif, netdev_event_t event)
+{
+    (void)netif;
+    (void)event;
+}
+#endif /* IS_USED(MODULE_GNRC_NETIF_ETX) */
+
+/* handles the end of a transmission reported by the device */
+static inline void _tx_done(gnrc_netif_t *netif, netdev_event_t event)
+{
+    _etx_tx_done(netif, event);
+#if IS_USED(MODULE_GNRC_NETIF_TXQ)
+    _txq_tx_done(netif);
+#endif
+}
+
+static int _send(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt)
+{
+    int res;
+
+    _etx_tx_start(netif, pkt);
+    res = netif->ops->send(netif, pkt);
+
+    if (res < 0) {
+        DEBUG("gnrc_netif: error sending packet %p (code: %i)\n",
+              (void *)pkt, res);
+    }
+#ifdef MODULE_NETSTATS_L2
+    else {
+        netif->stats.tx_bytes += res;
+    }
+#endif
+    return res;
+}
+
+#if (CONFIG_GNRC_NETIF_MIN_WAIT_AFTER_SEND_US > 0U)
+static void _wait_after_send(xtimer_ticks32_t *last_wakeup)
+{
+    xtimer_periodic_wakeup(last_wakeup,
+                           CONFIG_GNRC_NETIF_MIN_WAIT_AFTER_SEND_US);
+    /* override last_wakeup in case last_wakeup +
+     * CONFIG_GNRC_NETIF_MIN_WAIT_AFTER_SEND_US was in the past */
+    *last_wakeup = xtimer_now();
+}
+#endif
+
 static void *_gnrc_netif_thread(void *args)
 {
     gnrc_netapi_opt_t *opt;
@@ -1499,6 +1781,12 @@ static void *_gnrc_netif_thread(void *args)
     }
     _configure_netdev(dev);
     netif->ops->init(netif);
+#if IS_USED(MODULE_GNRC_NETIF_RX_BATCH)
+    _init_rx_batch(netif);
+#endif
+#if IS_USED(MODULE_GNRC_NETIF_TXQ)
+    _init_txq(netif);
+#endif
 #if DEVELHELP
     assert(options_tested);
 #endif
@@ -1526,26 +1814,27 @@ static void *_gnrc_netif_thread(void *args)
                 break;
             case GNRC_NETAPI_MSG_TYPE_SND:
                 DEBUG("gnrc_netif: GNRC_NETDEV_MSG_TYPE_SND received\n");
-                res = netif->ops->send(netif, msg.content.ptr);
-                if (res < 0) {
-                    DEBUG("gnrc_netif: error sending packet %p (code: %i)\n",
-                          msg.content.ptr, res);
-                }
-#ifdef MODULE_NETSTATS_L2
-                else {
-                    netif->stats.tx_bytes += res;
-                }
-#endif
+                _send(netif, msg.content.ptr);
 #if (CONFIG_GNRC_NETIF_MIN_WAIT_AFTER_SEND_US > 0U)
-                xtimer_periodic_wakeup(
-                        &last_wakeup,
-                        CONFIG_GNRC_NETIF_MIN_WAIT_AFTER_SEND_US
-                    );
-                /* override last_wakeup in case last_wakeup +
-                 * CONFIG_GNRC_NETIF_MIN_WAIT_AFTER_SEND_US was in the past */
-                last_wakeup = xtimer_now();
+                _wait_after_send(&last_wakeup);
+#endif
+                break;
+#if IS_USED(MODULE_GNRC_NETIF_RX_BATCH)
+            case GNRC_NETIF_RX_BATCH_MSG_TYPE:
+                DEBUG("gnrc_netif: GNRC_NETIF_RX_BATCH_MSG_TYPE received\n");
+                _recv_batch(netif);
+                break;
 #endif
+#if IS_USED(MODULE_GNRC_NETIF_TXQ)
+            case GNRC_NETIF_TXQ_MSG_TYPE:
+                DEBUG("gnrc_netif: GNRC_NETIF_TXQ_MSG_TYPE received\n");
+                /* next queued packet is sent below */
+                break;
+            case GNRC_NETIF_TXQ_TIMEOUT_MSG_TYPE:
+                DEBUG("gnrc_netif: GNRC_NETIF_TXQ_TIMEOUT_MSG_TYPE received\n");
+                _txq_timeout(netif, &msg);
                 break;
+#endif
             case GNRC_NETAPI_MSG_TYPE_SET:
                 opt = msg.content.ptr;
 #ifdef MODULE_NETOPT
@@ -1588,6 +1877,16 @@ static void *_gnrc_netif_thread(void *args)
                 }
                 break;
         }
+#if IS_USED(MODULE_GNRC_NETIF_TXQ)
+        /* send one queued packet at a time, so the device's events (and with
+         * them the result of the previous transmission) are handled in
+         * between */
+        if (_txq_send_next(netif)) {
+#if (CONFIG_GNRC_NETIF_MIN_WAIT_AFTER_SEND_US > 0U)
+            _wait_after_send(&last_wakeup);
+#endif
+        }
+#endif
     }
     /* never reached */
     return NULL;
@@ -1604,6 +1903,49 @@ static void _pass_on_packet(gnrc_pktsnip_t *pkt)
     }
 }
 
+#if IS_USED(MODULE_GNRC_NETIF_RX_BATCH)
+/**
+ * @brief   Receives all frames pending at the device
+ *
+ * The frames are passed on once the device is drained (or
+ * @ref CONFIG_GNRC_NETIF_RX_BATCH_SIZE frames were received), so the upper
+ * layers get them back to back instead of interleaved with the device's
+ * events.
+ *
+ * @param[in] netif The network interface.
+ */
+static void _recv_batch(gnrc_netif_t *netif)
+{
+    gnrc_pktsnip_t *batch[CONFIG_GNRC_NETIF_RX_BATCH_SIZE];
+    unsigned num = 0;
+
+    /* a dropped frame also stops the draining, but the device signals
+     * frames still pending with another event anyway */
+    while (num < CONFIG_GNRC_NETIF_RX_BATCH_SIZE) {
+        gnrc_pktsnip_t *pkt = netif->ops->recv(netif);
+
+        if (pkt == NULL) {
+            break;
+        }
+        batch[num++] = pkt;
+    }
+    DEBUG("gnrc_netif: received batch of %u frames\n", num);
+    for (unsigned i = 0; i < num; i++) {
+        _pass_on_packet(batch[i]);
+    }
+    if (num == CONFIG_GNRC_NETIF_RX_BATCH_SIZE) {
+        /* the device does not signal the frames still pending while it is
+         * drained, so come back for them after the messages queued
+         * meanwhile */
+        msg_t msg = { .type = GNRC_NETIF_RX_BATCH_MSG_TYPE };
+
+        if (msg_send_to_self(&msg) <= 0) {
+            puts("gnrc_netif: possibly lost interrupt.");
+        }
+    }
+}
+#endif /* IS_USED(MODULE_GNRC_NETIF_RX_BATCH) */
+
 static void _event_cb(netdev_t *dev, netdev_event_t event)
 {
     gnrc_netif_t *netif = (gnrc_netif_t *) dev->context;
@@ -1626,21 +1968,41 @@ static void _event_cb(netdev_t *dev, netdev_event_t event)
         gnrc_pktsnip_t *pkt = NULL;
         switch (event) {
             case NETDEV_EVENT_RX_COMPLETE:
+#if IS_USED(MODULE_GNRC_NETIF_RX_BATCH)
+                if (netif->flags & GNRC_NETIF_FLAGS_RX_BATCH) {
+                    _recv_batch(netif);
+                    break;
+                }
+#endif
                 pkt = netif->ops->recv(netif);
                 if (pkt) {
                     _pass_on_packet(pkt);
                 }
                 break;
-#ifdef MODULE_NETSTATS_L2
+#if IS_USED(MODULE_NETSTATS_L2) || IS_USED(MODULE_GNRC_NETIF_ETX) || \
+    IS_USED(MODULE_GNRC_NETIF_TXQ)
             case NETDEV_EVENT_TX_MEDIUM_BUSY:
+#ifdef MODULE_NETSTATS_L2
                 /* we are the only ones supposed to touch this variable,
                  * so no acquire necessary */
                 netif->stats.tx_failed++;
+#endif
+                _tx_done(netif, event);
                 break;
             case NETDEV_EVENT_TX_COMPLETE:
+#ifdef MODULE_NETSTATS_L2
                 /* we are the only ones supposed to touch this variable,
                  * so no acquire necessary */
                 netif->stats.tx_success++;
+#endif
+                _tx_done(netif, event);
+                break;
+#endif
+#if IS_USED(MODULE_GNRC_NETIF_ETX) || IS_USED(MODULE_GNRC_NETIF_TXQ)
+            case NETDEV_EVENT_TX_NOACK:
+            case NETDEV_EVENT_TX_COMPLETE_DATA_PENDING:
+            case NETDEV_EVENT_TX_TIMEOUT:
+                _tx_done(netif, event);
                 break;
 #endif
             default:
@@ -16,15 +16,19 @@
 #include <inttypes.h>
 #include <kernel_defines.h>
 #include <stdbool.h>
+#include <string.h>
 
 #include "byteorder.h"
 #include "cpu_conf.h"
+#include "irq.h"
 #include "kernel_types.h"
 #include "net/gnrc.h"
 #include "net/gnrc/icmpv6.h"
 #include "net/gnrc/sixlowpan/ctx.h"
 #include "net/gnrc/sixlowpan/nd.h"
+#include "net/inet_csum.h"
 #include "net/protnum.h"
+#include "net/udp.h"
 #include "thread.h"
 #include "utlist.h"
 
@@ -37,6 +41,10 @@
 #include "net/gnrc/ipv6/ext/frag.h"
 #endif
 
+#ifdef MODULE_GNRC_RPL_SR_TABLE
+#include "net/gnrc/rpl/sr_table.h"
+#endif
+
 #include "net/gnrc/ipv6.h"
 
 #define ENABLE_DEBUG    (0)
@@ -64,6 +72,26 @@ static fib_entry_t _fib_entries[GNRC_IPV6_FIB_TABLE_SIZE];
 fib_table_t gnrc_ipv6_fib_table;
 #endif
 
+#if CONFIG_GNRC_IPV6_ROUTE_CACHE_SIZE > 0
+/**
+ * @brief   Route cache entry
+ */
+typedef struct {
+    ipv6_addr_t dst;            /**< destination address */
+    gnrc_ipv6_nib_nc_t nce;     /**< next hop to _route_cache_entry_t::dst */
+    uint32_t gen;               /**< NIB generation the entry is valid for */
+    kernel_pid_t netif;         /**< interface the lookup was restricted to */
+} _route_cache_entry_t;
+
+/**
+ * @brief   Route cache
+ *
+ * Only accessed from the IPv6 thread, so it needs no locking.
+ */
+static _route_cache_entry_t _route_cache[CONFIG_GNRC_IPV6_ROUTE_CACHE_SIZE];
+static gnrc_ipv6_route_cache_stats_t _route_cache_stats;
+#endif  /* CONFIG_GNRC_IPV6_ROUTE_CACHE_SIZE > 0 */
+
 static char addr_str[IPV6_ADDR_MAX_STR_LEN];
 
 kernel_pid_t gnrc_ipv6_pid = KERNEL_PID_UNDEF;
@@ -326,7 +354,71 @@ static bool _is_ipv6_hdr(gnrc_pktsnip_t *hdr)
 #endif
 }
 
-static int _fill_ipv6_hdr(gnrc_netif_t *netif, gnrc_pktsnip_t *ipv6)
+/**
+ * @brief   Upper-layer checksum of a packet sent over multiple interfaces
+ */
+typedef struct {
+    ipv6_addr_t src;    /**< source address the checksum was calculated with */
+    uint16_t csum;      /**< checksum field in host byte order */
+    bool valid;         /**< _csum_state_t::csum was calculated */
+} _csum_state_t;
+
+static network_uint16_t *_csum_field(gnrc_pktsnip_t *payload)
+{
+    switch (payload->type) {
+#if IS_USED(MODULE_GNRC_NETTYPE_ICMPV6)
+        case GNRC_NETTYPE_ICMPV6:
+            if (payload->size >= sizeof(icmpv6_hdr_t)) {
+                return &((icmpv6_hdr_t *)payload->data)->csum;
+            }
+            break;
+#endif
+#if IS_USED(MODULE_GNRC_NETTYPE_UDP)
+        case GNRC_NETTYPE_UDP:
+            if (payload->size >= sizeof(udp_hdr_t)) {
+                return &((udp_hdr_t *)payload->data)->checksum;
+            }
+            break;
+#endif
+        default:
+            break;
+    }
+    return NULL;
+}
+
+/*
+ * The copies of a packet sent over multiple interfaces only differ in the
+ * source address (and the hop limit, which is not part of the pseudo header),
+ * so only the checksum of the first copy is calculated over the whole payload.
+ * The checksum of the other copies is updated incrementally (RFC 1624).
+ */
+static int _calc_upper_csum(gnrc_pktsnip_t *payload, gnrc_pktsnip_t *ipv6,
+                            _csum_state_t *state)
+{
+    ipv6_hdr_t *hdr = ipv6->data;
+    network_uint16_t *field = (state != NULL) ? _csum_field(payload) : NULL;
+    int res;
+
+    if ((field != NULL) && state->valid) {
+        uint16_t csum = inet_csum_update(state->csum, state->src.u8,
+                                         hdr->src.u8, sizeof(ipv6_addr_t));
+
+        /* 0xffff is the same in 1's complement, but 0 would mean no checksum
+         * for UDP */
+        *field = byteorder_htons((csum == 0) ? 0xffff : csum);
+        return 0;
+    }
+    res = gnrc_netreg_calc_csum(payload, ipv6);
+    if ((res == 0) && (field != NULL)) {
+        state->src = hdr->src;
+        state->csum = byteorder_ntohs(*field);
+        state->valid = true;
+    }
+    return res;
+}
+
+static int _fill_ipv6_hdr(gnrc_netif_t *netif, gnrc_pktsnip_t *ipv6,
+                          _csum_state_t *csum_state)
 {
     int res;
     ipv6_hdr_t *hdr = ipv6->data;
@@ -427,7 +519,7 @@ static int _fill_ipv6_hdr(gnrc_netif_t *netif, gnrc_pktsnip_t *ipv6)
         prev = payload;
     }
     DEBUG("ipv6: calculate checksum for upper header.\n");
-    if ((res = gnrc_netreg_calc_csum(payload, ipv6)) < 0) {
+    if ((res = _calc_upper_csum(payload, ipv6, csum_state)) < 0) {
         if (res != -ENOENT) {   /* if there is no checksum we are okay */
             DEBUG("ipv6: checksum calculation failed.\n");
             /* packet will be released by caller */
@@ -441,7 +533,7 @@ static int _fill_ipv6_hdr(gnrc_netif_t *netif, gnrc_pktsnip_t *ipv6)
 static bool _safe_fill_ipv6_hdr(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt,
                                 bool prep_hdr)
 {
-    if (prep_hdr && (_fill_ipv6_hdr(netif, pkt) < 0)) {
+    if (prep_hdr && (_fill_ipv6_hdr(netif, pkt, NULL) < 0)) {
         /* error on filling up header */
         gnrc_pktbuf_release(pkt);
         return false;
@@ -482,23 +574,115 @@ static void _send_by_netif_hdr(gnrc_pktsnip_t *pkt)
 }
 #endif  /* MODULE_GNRC_IPV6_EXT_FRAG */
 
+#if CONFIG_GNRC_IPV6_ROUTE_CACHE_SIZE > 0
+void gnrc_ipv6_route_cache_get_stats(gnrc_ipv6_route_cache_stats_t *stats)
+{
+    unsigned state = irq_disable();
+
+    *stats = _route_cache_stats;
+    irq_restore(state);
+}
+
+static inline unsigned _route_cache_idx(const ipv6_addr_t *dst)
+{
+    uint32_t h = dst->u32[0].u32 ^ dst->u32[1].u32 ^
+                 dst->u32[2].u32 ^ dst->u32[3].u32;
+
+    h ^= (h >> 16);
+    h ^= (h >> 8);
+    return h % CONFIG_GNRC_IPV6_ROUTE_CACHE_SIZE;
+}
+
+static bool _route_cacheable(const gnrc_ipv6_nib_nc_t *nce)
+{
+    /* a stale neighbor needs the NIB to start neighbor unreachability
+     * detection on its next use */
+    if (gnrc_ipv6_nib_nc_get_nud_state(nce) ==
+        GNRC_IPV6_NIB_NC_INFO_NUD_STATE_STALE) {
+        return false;
+    }
+#if IS_ACTIVE(CONFIG_GNRC_IPV6_NIB_ROUTER)
+    /* the routing protocol wants to be notified about every route usage */
+    gnrc_netif_t *netif = gnrc_netif_get_by_pid(gnrc_ipv6_nib_nc_get_iface(nce));
+
+    if ((netif == NULL) || (netif->ipv6.route_info_cb != NULL)) {
+        return false;
+    }
+#endif  /* CONFIG_GNRC_IPV6_NIB_ROUTER */
+    return true;
+}
+#endif  /* CONFIG_GNRC_IPV6_ROUTE_CACHE_SIZE > 0 */
+
+static int _get_next_hop_l2addr(const ipv6_addr_t *dst, gnrc_netif_t *netif,
+                                gnrc_pktsnip_t *pkt, gnrc_ipv6_nib_nc_t *nce)
+{
+#if CONFIG_GNRC_IPV6_ROUTE_CACHE_SIZE > 0
+    _route_cache_entry_t *entry = &_route_cache[_route_cache_idx(dst)];
+    kernel_pid_t pid = (netif != NULL) ? netif->pid : KERNEL_PID_UNDEF;
+    /* needs to be read before asking the NIB, see gnrc_ipv6_nib_gen() */
+    uint32_t gen = gnrc_ipv6_nib_gen();
+    int res;
+
+    if ((entry->gen == gen) && (entry->netif == pid) &&
+        (gnrc_ipv6_nib_nc_get_iface(&entry->nce) != KERNEL_PID_UNDEF) &&
+        ipv6_addr_equal(&entry->dst, dst)) {
+        DEBUG("ipv6: route cache hit for %s\n",
+              ipv6_addr_to_str(addr_str, dst, sizeof(addr_str)));
+        _route_cache_stats.hits++;
+        memcpy(nce, &entry->nce, sizeof(*nce));
+        return 0;
+    }
+    _route_cache_stats.misses++;
+    res = gnrc_ipv6_nib_get_next_hop_l2addr(dst, netif, pkt, nce);
+    if ((res == 0) && _route_cacheable(nce)) {
+        memcpy(&entry->dst, dst, sizeof(entry->dst));
+        memcpy(&entry->nce, nce, sizeof(entry->nce));
+        entry->gen = gen;
+        entry->netif = pid;
+    }
+    return res;
+#else   /* CONFIG_GNRC_IPV6_ROUTE_CACHE_SIZE > 0 */
+    return gnrc_ipv6_nib_get_next_hop_l2addr(dst, netif, pkt, nce);
+#endif  /* CONFIG_GNRC_IPV6_ROUTE_CACHE_SIZE > 0 */
+}
+
 static void _send_unicast(gnrc_pktsnip_t *pkt, bool prep_hdr,
                           gnrc_netif_t *netif, ipv6_hdr_t *ipv6_hdr,
                           uint8_t netif_hdr_flags)
 {
     gnrc_ipv6_nib_nc_t nce;
+    const ipv6_addr_t *dst = &ipv6_hdr->dst;
 
     DEBUG("ipv6: send unicast\n");
-    if (gnrc_ipv6_nib_get_next_hop_l2addr(&ipv6_hdr->dst, netif, pkt,
-                                          &nce) < 0) {
+#ifdef MODULE_GNRC_RPL_SR_TABLE
+    ipv6_addr_t first_hop;
+    int srh_res = 0;
+
+    /* the source routing header of a RPL root in non-storing mode;
+     * the destination stays until the checksum was calculated over it */
+    if (prep_hdr &&
+        ((srh_res = gnrc_rpl_sr_table_insert_srh(pkt, &first_hop)) > 0)) {
+        dst = &first_hop;
+    }
+    else if (srh_res < 0) {
+        gnrc_pktbuf_release_error(pkt, -srh_res);
+        return;
+    }
+#endif  /* MODULE_GNRC_RPL_SR_TABLE */
+    if (_get_next_hop_l2addr(dst, netif, pkt, &nce) < 0) {
         /* packet is released by NIB */
         DEBUG("ipv6: no link-layer address or interface for next hop to %s\n",
-              ipv6_addr_to_str(addr_str, &ipv6_hdr->dst, sizeof(addr_str)));
+              ipv6_addr_to_str(addr_str, dst, sizeof(addr_str)));
         return;
     }
     netif = gnrc_netif_get_by_pid(gnrc_ipv6_nib_nc_get_iface(&nce));
     assert(netif != NULL);
     if (_safe_fill_ipv6_hdr(netif, pkt, prep_hdr)) {
+#ifdef MODULE_GNRC_RPL_SR_TABLE
+        if (srh_res > 0) {
+            ipv6_hdr->dst = first_hop;
+        }
+#endif  /* MODULE_GNRC_RPL_SR_TABLE */
         DEBUG("ipv6: add interface header to packet\n");
         if ((pkt = _create_netif_hdr(nce.l2addr, nce.l2addr_len, pkt,
                                      netif_hdr_flags)) == NULL) {
@@ -560,6 +744,8 @@ static void _send_multicast(gnrc_pktsnip_t *pkt, bool prep_hdr,
     if (!gnrc_netif_highlander()) {
         /* interface not given: send over all interfaces */
         if (netif == NULL) {
+            _csum_state_t csum_state = { .valid = false };
+
             /* send packet to link layer */
             gnrc_pktbuf_hold(pkt, ifnum - 1);
 
@@ -580,7 +766,7 @@ static void _send_multicast(gnrc_pktsnip_t *pkt, bool prep_hdr,
                         gnrc_pktbuf_release(pkt);
                         return;
                     }
-                    if (_fill_ipv6_hdr(netif, send_pkt) < 0) {
+                    if (_fill_ipv6_hdr(netif, send_pkt, &csum_state) < 0) {
                         /* error on filling up header */
                         if (send_pkt != pkt) {
                             gnrc_pktbuf_release(send_pkt);
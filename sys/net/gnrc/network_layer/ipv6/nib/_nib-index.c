@@ -0,0 +1,357 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ * @brief   Hash table for on-link entries and prefix trie for off-link
+ *          entries of the NIB
+ */
+
+#include <string.h>
+#include <kernel_defines.h>
+
+#include "net/gnrc/ipv6/nib/conf.h"
+
+#include "_nib-internal.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+#if IS_ACTIVE(CONFIG_GNRC_IPV6_NIB_INDEX)
+
+/**
+ * @brief   Number of trie nodes
+ *
+ * A path-compressed binary trie holding n distinct prefixes has at most
+ * n - 1 branching nodes that do not carry a prefix.
+ */
+#define _TRIE_NUMOF         (2 * CONFIG_GNRC_IPV6_NIB_OFFL_NUMOF)
+
+/**
+ * @brief   Trie node
+ */
+typedef struct {
+    ipv6_addr_t pfx;                /**< prefix of the node */
+    _nib_offl_entry_t *entries;     /**< entries with exactly this prefix */
+    uint16_t child[2];              /**< children (index + 1, 0 for none) */
+    uint8_t pfx_len;                /**< length of _trie_node_t::pfx in bits */
+} _trie_node_t;
+
+static _nib_onl_entry_t *_buckets[CONFIG_GNRC_IPV6_NIB_ONL_HASH_SIZE];
+static _trie_node_t _trie[_TRIE_NUMOF];
+static uint16_t _trie_root;
+/* released nodes are chained via child[0] */
+static uint16_t _trie_free;
+/* number of nodes taken from _trie so far */
+static uint16_t _trie_used;
+
+static inline unsigned _hash(const ipv6_addr_t *addr)
+{
+    uint32_t h = addr->u32[0].u32 ^ addr->u32[1].u32 ^
+                 addr->u32[2].u32 ^ addr->u32[3].u32;
+
+    h ^= h >> 16;
+    h *= 0x45d9f3bU;
+    h ^= h >> 16;
+    return h % CONFIG_GNRC_IPV6_NIB_ONL_HASH_SIZE;
+}
+
+static inline unsigned _bit(const ipv6_addr_t *addr, unsigned pos)
+{
+    return (addr->u8[pos >> 3] >> (7 - (pos & 0x7))) & 0x1;
+}
+
+static inline _trie_node_t *_node(uint16_t idx)
+{
+    return &_trie[idx - 1];
+}
+
+void _nib_idx_init(void)
+{
+    memset(_buckets, 0, sizeof(_buckets));
+    _trie_root = 0;
+    _trie_free = 0;
+    _trie_used = 0;
+}
+
+void _nib_idx_onl_add(_nib_onl_entry_t *node)
+{
+    _nib_onl_entry_t **ptr;
+
+    if (ipv6_addr_is_unspecified(&node->ipv6)) {
+        return;
+    }
+    /* keep bucket sorted by position in the NIB's on-link entry array */
+    for (ptr = &_buckets[_hash(&node->ipv6)]; (*ptr != NULL) && (*ptr < node);
+         ptr = &(*ptr)->idx_next) {}
+    if (*ptr != node) {
+        node->idx_next = *ptr;
+        *ptr = node;
+    }
+}
+
+void _nib_idx_onl_remove(_nib_onl_entry_t *node)
+{
+    _nib_onl_entry_t **ptr;
+
+    if (ipv6_addr_is_unspecified(&node->ipv6)) {
+        return;
+    }
+    for (ptr = &_buckets[_hash(&node->ipv6)]; *ptr != NULL;
+         ptr = &(*ptr)->idx_next) {
+        if (*ptr == node) {
+            *ptr = node->idx_next;
+            node->idx_next = NULL;
+            return;
+        }
+    }
+}
+
+_nib_onl_entry_t *_nib_idx_onl_get(const ipv6_addr_t *addr, unsigned iface)
+{
+    for (_nib_onl_entry_t *node = _buckets[_hash(addr)]; node != NULL;
+         node = node->idx_next) {
+        if ((node->mode != _EMPTY) &&
+            /* either requested or current interface undefined or
+             * interfaces equal */
+            ((_nib_onl_get_if(node) == 0) || (iface == 0) ||
+             (_nib_onl_get_if(node) == iface)) &&
+            ipv6_addr_equal(&node->ipv6, addr)) {
+            DEBUG("nib: Found %p in index\n", (void *)node);
+            return node;
+        }
+    }
+    return NULL;
+}
+
+static uint16_t _trie_alloc(const ipv6_addr_t *pfx, unsigned pfx_len)
+{
+    uint16_t idx = _trie_free;
+
+    if (idx != 0) {
+        _trie_free = _node(idx)->child[0];
+    }
+    else {
+        /* sized so it can't run out, see _TRIE_NUMOF */
+        assert(_trie_used < _TRIE_NUMOF);
+        idx = ++_trie_used;
+    }
+    memset(_node(idx), 0, sizeof(_trie_node_t));
+    ipv6_addr_init_prefix(&_node(idx)->pfx, pfx, pfx_len);
+    _node(idx)->pfx_len = pfx_len;
+    return idx;
+}
+
+static void _trie_free_node(uint16_t idx)
+{
+    _node(idx)->child[0] = _trie_free;
+    _trie_free = idx;
+}
+
+static inline unsigned _min(unsigned a, unsigned b)
+{
+    return (a < b) ? a : b;
+}
+
+void _nib_idx_offl_add(_nib_offl_entry_t *dst)
+{
+    const ipv6_addr_t *pfx = &dst->pfx;
+    unsigned pfx_len = dst->pfx_len;
+    uint16_t *link = &_trie_root;
+    _trie_node_t *target;
+    _nib_offl_entry_t **ptr;
+
+    while (1) {
+        _trie_node_t *node;
+        unsigned common;
+
+        if (*link == 0) {
+            *link = _trie_alloc(pfx, pfx_len);
+            target = _node(*link);
+            break;
+        }
+        node = _node(*link);
+        common = _min(ipv6_addr_match_prefix(&node->pfx, pfx),
+                      _min(pfx_len, node->pfx_len));
+        if (common < node->pfx_len) {
+            /* prefixes diverge within node => split */
+            uint16_t split = _trie_alloc(pfx, common);
+
+            _node(split)->child[_bit(&node->pfx, common)] = *link;
+            *link = split;
+            if (common == pfx_len) {
+                target = _node(split);
+            }
+            else {
+                uint16_t leaf = _trie_alloc(pfx, pfx_len);
+
+                _node(split)->child[_bit(pfx, common)] = leaf;
+                target = _node(leaf);
+            }
+            break;
+        }
+        if (node->pfx_len == pfx_len) {
+            target = node;
+            break;
+        }
+        link = &node->child[_bit(pfx, node->pfx_len)];
+    }
+    /* keep entries sorted by position in the NIB's off-link entry array */
+    for (ptr = &target->entries; (*ptr != NULL) && (*ptr < dst);
+         ptr = &(*ptr)->idx_next) {}
+    if (*ptr != dst) {
+        dst->idx_next = *ptr;
+        *ptr = dst;
+    }
+}
+
+void _nib_idx_offl_remove(_nib_offl_entry_t *dst)
+{
+    uint16_t *parent_link = NULL, *link = &_trie_root;
+    _trie_node_t *node = NULL;
+    _nib_offl_entry_t **ptr;
+
+    if (dst->pfx_len == 0) {
+        /* was never indexed */
+        return;
+    }
+    while (*link != 0) {
+        node = _node(*link);
+        if ((node->pfx_len > dst->pfx_len) ||
+            (ipv6_addr_match_prefix(&node->pfx, &dst->pfx) < node->pfx_len)) {
+            return;
+        }
+        if (node->pfx_len == dst->pfx_len) {
+            break;
+        }
+        parent_link = link;
+        link = &node->child[_bit(&dst->pfx, node->pfx_len)];
+    }
+    if (*link == 0) {
+        return;
+    }
+    for (ptr = &node->entries; (*ptr != NULL) && (*ptr != dst);
+         ptr = &(*ptr)->idx_next) {}
+    if (*ptr == NULL) {
+        return;
+    }
+    *ptr = dst->idx_next;
+    dst->idx_next = NULL;
+    if (node->entries != NULL) {
+        return;
+    }
+    /* prune node if it is no longer needed for branching */
+    if ((node->child[0] != 0) && (node->child[1] != 0)) {
+        return;
+    }
+    uint16_t idx = *link;
+
+    *link = node->child[0] | node->child[1];
+    _trie_free_node(idx);
+    if ((*link == 0) && (parent_link != NULL)) {
+        /* parent lost a child and might now be a useless branching node */
+        _trie_node_t *parent = _node(*parent_link);
+
+        if (parent->entries == NULL) {
+            idx = *parent_link;
+            *parent_link = parent->child[0] | parent->child[1];
+            _trie_free_node(idx);
+        }
+    }
+}
+
+_nib_offl_entry_t *_nib_idx_offl_get(const ipv6_addr_t *pfx, unsigned pfx_len)
+{
+    uint16_t idx = _trie_root;
+
+    while (idx != 0) {
+        _trie_node_t *node = _node(idx);
+
+        if ((node->pfx_len > pfx_len) ||
+            (ipv6_addr_match_prefix(&node->pfx, pfx) < node->pfx_len)) {
+            return NULL;
+        }
+        if (node->pfx_len == pfx_len) {
+            return node->entries;
+        }
+        idx = node->child[_bit(pfx, node->pfx_len)];
+    }
+    return NULL;
+}
+
+_nib_offl_entry_t *_nib_idx_offl_get_match(const ipv6_addr_t *dst)
+{
+    _nib_offl_entry_t *res = NULL;
+    uint8_t best_match = 0;
+    uint16_t idx = _trie_root;
+
+    /* The linear search in _nib_offl_get_match() ranks by the number of bits
+     * the (zero-padded) prefix shares with dst, so do the same. This is the
+     * longest matching prefix, except for prefixes only differing in trailing
+     * zero bits, which are ranked by array position instead. */
+    while (idx != 0) {
+        _trie_node_t *node = _node(idx);
+        uint8_t match = ipv6_addr_match_prefix(&node->pfx, dst);
+
+        if (match < node->pfx_len) {
+            break;
+        }
+        for (_nib_offl_entry_t *entry = node->entries; entry != NULL;
+             entry = entry->idx_next) {
+            if (entry->mode != _EMPTY) {
+                if ((match > best_match) ||
+                    ((match == best_match) && (entry < res))) {
+                    res = entry;
+                    best_match = match;
+                }
+                break;
+            }
+        }
+        if (node->pfx_len == IPV6_ADDR_BIT_LEN) {
+            break;
+        }
+        idx = node->child[_bit(dst, node->pfx_len)];
+    }
+    return res;
+}
+
+_nib_offl_entry_t *_nib_idx_offl_get_first(const ipv6_addr_t *dst,
+                                           uint8_t mode, uint16_t flags)
+{
+    _nib_offl_entry_t *res = NULL;
+    uint16_t idx = _trie_root;
+
+    while (idx != 0) {
+        _trie_node_t *node = _node(idx);
+
+        if (ipv6_addr_match_prefix(&node->pfx, dst) < node->pfx_len) {
+            break;
+        }
+        for (_nib_offl_entry_t *entry = node->entries; entry != NULL;
+             entry = entry->idx_next) {
+            if (((entry->mode & mode) == mode) &&
+                ((entry->flags & flags) == flags) &&
+                ((res == NULL) || (entry < res))) {
+                res = entry;
+                break;
+            }
+        }
+        if (node->pfx_len == IPV6_ADDR_BIT_LEN) {
+            break;
+        }
+        idx = node->child[_bit(dst, node->pfx_len)];
+    }
+    return res;
+}
+#else  /* CONFIG_GNRC_IPV6_NIB_INDEX */
+typedef int dont_be_pedantic;
+#endif /* CONFIG_GNRC_IPV6_NIB_INDEX */
+
+/** @} */
@@ -48,6 +48,7 @@ static rmutex_t _nib_mutex = RMUTEX_INIT;
 static char addr_str[IPV6_ADDR_MAX_STR_LEN];
 
 evtimer_msg_t _nib_evtimer;
+uint32_t _nib_gen;
 
 static void _override_node(const ipv6_addr_t *addr, unsigned iface,
                            _nib_onl_entry_t *node);
@@ -64,6 +65,7 @@ void _nib_init(void)
 #if IS_ACTIVE(CONFIG_GNRC_IPV6_NIB_MULTIHOP_P6C)
     memset(_abrs, 0, sizeof(_abrs));
 #endif  /* CONFIG_GNRC_IPV6_NIB_MULTIHOP_P6C */
+    _nib_idx_init();
 #endif  /* TEST_SUITES */
     evtimer_init_msg(&_nib_evtimer);
     /* TODO: load ABR information from persistent memory */
@@ -186,6 +188,7 @@ _nib_onl_entry_t *_nib_nc_add(const ipv6_addr_t *addr, unsigned iface,
     }
     DEBUG("nib: Adding to neighbor cache (addr = %s, iface = %u)\n",
           ipv6_addr_to_str(addr_str, addr, sizeof(addr_str)), iface);
+    _nib_gen_bump();
     if (!(node->mode & _NC)) {
         node->info &= ~GNRC_IPV6_NIB_NC_INFO_NUD_STATE_MASK;
         /* masked above already */
@@ -220,6 +223,9 @@ _nib_onl_entry_t *_nib_onl_get(const ipv6_addr_t *addr, unsigned iface)
     assert(addr != NULL);
     DEBUG("nib: Getting on-link node entry (addr = %s, iface = %u)\n",
           ipv6_addr_to_str(addr_str, addr, sizeof(addr_str)), iface);
+#if IS_ACTIVE(CONFIG_GNRC_IPV6_NIB_INDEX)
+    return _nib_idx_onl_get(addr, iface);
+#else   /* CONFIG_GNRC_IPV6_NIB_INDEX */
     for (unsigned i = 0; i < CONFIG_GNRC_IPV6_NIB_NUMOF; i++) {
         _nib_onl_entry_t *node = &_nodes[i];
 
@@ -235,6 +241,7 @@ _nib_onl_entry_t *_nib_onl_get(const ipv6_addr_t *addr, unsigned iface)
     }
     DEBUG("  No suitable entry found\n");
     return NULL;
+#endif  /* CONFIG_GNRC_IPV6_NIB_INDEX */
 }
 
 void _nib_nc_set_reachable(_nib_onl_entry_t *node)
@@ -242,6 +249,10 @@ void _nib_nc_set_reachable(_nib_onl_entry_t *node)
 #if IS_ACTIVE(CONFIG_GNRC_IPV6_NIB_ARSM)
     gnrc_netif_t *netif = gnrc_netif_get_by_pid(_nib_onl_get_if(node));
 
+    if ((node->info & GNRC_IPV6_NIB_NC_INFO_NUD_STATE_MASK) !=
+        GNRC_IPV6_NIB_NC_INFO_NUD_STATE_REACHABLE) {
+        _nib_gen_bump();
+    }
     node->info &= ~GNRC_IPV6_NIB_NC_INFO_NUD_STATE_MASK;
     node->info |= GNRC_IPV6_NIB_NC_INFO_NUD_STATE_REACHABLE;
 #ifdef TEST_SUITES
@@ -291,6 +302,7 @@ void _nib_nc_remove(_nib_onl_entry_t *node)
     /* remove from cache-out procedure */
     clist_remove(&_next_removable, (clist_node_t *)node);
     _nib_onl_clear(node);
+    _nib_gen_bump();
 }
 
 #if IS_ACTIVE(CONFIG_GNRC_IPV6_NIB_6LN) || !IS_ACTIVE(CONFIG_GNRC_IPV6_NIB_ARSM)
@@ -370,6 +382,7 @@ _nib_dr_entry_t *_nib_drl_add(const ipv6_addr_t *router_addr, unsigned iface)
         }
         _override_node(router_addr, iface, def_router->next_hop);
         def_router->next_hop->mode |= _DRL;
+        _nib_gen_bump();
     }
     return def_router;
 }
@@ -384,6 +397,7 @@ void _nib_drl_remove(_nib_dr_entry_t *nib_dr)
     if (nib_dr == _prime_def_router) {
         _prime_def_router = NULL;
     }
+    _nib_gen_bump();
 }
 
 _nib_dr_entry_t *_nib_drl_iter(const _nib_dr_entry_t *last)
@@ -468,6 +482,34 @@ void _nib_drl_ft_get(const _nib_dr_entry_t *drl, gnrc_ipv6_nib_ft_t *fte)
     fte->iface = _nib_onl_get_if(drl->next_hop);
 }
 
+static inline bool _offl_exact_match(const _nib_offl_entry_t *tmp,
+                                     const ipv6_addr_t *next_hop,
+                                     unsigned iface, const ipv6_addr_t *pfx,
+                                     unsigned pfx_len)
+{
+    _nib_onl_entry_t *tmp_node = tmp->next_hop;
+
+    return (tmp->pfx_len == pfx_len) &&                 /* prefix length matches and */
+           (tmp_node != NULL) &&                        /* there is a next hop that */
+           (_nib_onl_get_if(tmp_node) == iface) &&      /* has a matching interface and */
+           _addr_equals(next_hop, tmp_node) &&          /* equal address to next_hop, also */
+           (ipv6_addr_match_prefix(&tmp->pfx, pfx) >= pfx_len); /* the prefix matches */
+}
+
+static _nib_offl_entry_t *_offl_use_match(_nib_offl_entry_t *tmp,
+                                          const ipv6_addr_t *next_hop)
+{
+    /* exact match (or next hop address was previously unset) */
+    DEBUG("  %p is an exact match\n", (void *)tmp);
+    if (next_hop != NULL) {
+        _nib_idx_onl_remove(tmp->next_hop);
+        memcpy(&tmp->next_hop->ipv6, next_hop, sizeof(tmp->next_hop->ipv6));
+        _nib_idx_onl_add(tmp->next_hop);
+    }
+    tmp->next_hop->mode |= _DST;
+    return tmp;
+}
+
 _nib_offl_entry_t *_nib_offl_alloc(const ipv6_addr_t *next_hop, unsigned iface,
                                    const ipv6_addr_t *pfx, unsigned pfx_len)
 {
@@ -482,27 +524,31 @@ _nib_offl_entry_t *_nib_offl_alloc(const ipv6_addr_t *next_hop, unsigned iface,
           iface);
     DEBUG("pfx = %s/%u)\n", ipv6_addr_to_str(addr_str, pfx,
                                              sizeof(addr_str)), pfx_len);
+#if IS_ACTIVE(CONFIG_GNRC_IPV6_NIB_INDEX)
+    for (_nib_offl_entry_t *tmp = _nib_idx_offl_get(pfx, pfx_len); tmp != NULL;
+         tmp = tmp->idx_next) {
+        if (_offl_exact_match(tmp, next_hop, iface, pfx, pfx_len)) {
+            return _offl_use_match(tmp, next_hop);
+        }
+    }
+    for (unsigned i = 0; i < CONFIG_GNRC_IPV6_NIB_OFFL_NUMOF; i++) {
+        if (_dsts[i].next_hop == NULL) {
+            dst = &_dsts[i];
+            break;
+        }
+    }
+#else   /* CONFIG_GNRC_IPV6_NIB_INDEX */
     for (unsigned i = 0; i < CONFIG_GNRC_IPV6_NIB_OFFL_NUMOF; i++) {
         _nib_offl_entry_t *tmp = &_dsts[i];
-        _nib_onl_entry_t *tmp_node = tmp->next_hop;
 
-        if ((tmp->pfx_len == pfx_len) &&                /* prefix length matches and */
-            (tmp_node != NULL) &&                       /* there is a next hop that */
-            (_nib_onl_get_if(tmp_node) == iface) &&     /* has a matching interface and */
-            _addr_equals(next_hop, tmp_node) &&         /* equal address to next_hop, also */
-            (ipv6_addr_match_prefix(&tmp->pfx, pfx) >= pfx_len)) {  /* the prefix matches */
-            /* exact match (or next hop address was previously unset) */
-            DEBUG("  %p is an exact match\n", (void *)tmp);
-            if (next_hop != NULL) {
-                memcpy(&tmp_node->ipv6, next_hop, sizeof(tmp_node->ipv6));
-            }
-            tmp->next_hop->mode |= _DST;
-            return tmp;
+        if (_offl_exact_match(tmp, next_hop, iface, pfx, pfx_len)) {
+            return _offl_use_match(tmp, next_hop);
         }
-        if ((dst == NULL) && (tmp_node == NULL)) {
+        if ((dst == NULL) && (tmp->next_hop == NULL)) {
             dst = tmp;
         }
     }
+#endif  /* CONFIG_GNRC_IPV6_NIB_INDEX */
     if (dst != NULL) {
         DEBUG("  using %p\n", (void *)dst);
         dst->next_hop = _nib_onl_alloc(next_hop, iface);
@@ -515,6 +561,7 @@ _nib_offl_entry_t *_nib_offl_alloc(const ipv6_addr_t *next_hop, unsigned iface,
         dst->next_hop->mode |= _DST;
         ipv6_addr_init_prefix(&dst->pfx, pfx, pfx_len);
         dst->pfx_len = pfx_len;
+        _nib_idx_offl_add(dst);
     }
     return dst;
 }
@@ -551,6 +598,7 @@ void _nib_offl_clear(_nib_offl_entry_t *dst)
             dst->next_hop->mode &= ~(_DST);
             _nib_onl_clear(dst->next_hop);
         }
+        _nib_idx_offl_remove(dst);
         memset(dst, 0, sizeof(_nib_offl_entry_t));
     }
 }
@@ -576,11 +624,14 @@ bool _nib_offl_is_entry(const _nib_offl_entry_t *entry)
 
 static _nib_offl_entry_t *_nib_offl_get_match(const ipv6_addr_t *dst)
 {
+    DEBUG("nib: get match for destination %s from NIB\n",
+          ipv6_addr_to_str(addr_str, dst, sizeof(addr_str)));
+#if IS_ACTIVE(CONFIG_GNRC_IPV6_NIB_INDEX)
+    return _nib_idx_offl_get_match(dst);
+#else   /* CONFIG_GNRC_IPV6_NIB_INDEX */
     _nib_offl_entry_t *res = NULL;
     uint8_t best_match = 0;
 
-    DEBUG("nib: get match for destination %s from NIB\n",
-          ipv6_addr_to_str(addr_str, dst, sizeof(addr_str)));
     for (_nib_offl_entry_t *entry = _dsts; _in_dsts(entry); entry++) {
         if (entry->mode != _EMPTY) {
             uint8_t match = ipv6_addr_match_prefix(&entry->pfx, dst);
@@ -601,6 +652,7 @@ static _nib_offl_entry_t *_nib_offl_get_match(const ipv6_addr_t *dst)
         }
     }
     return res;
+#endif  /* CONFIG_GNRC_IPV6_NIB_INDEX */
 }
 
 void _nib_ft_get(const _nib_offl_entry_t *dst, gnrc_ipv6_nib_ft_t *fte)
@@ -829,7 +881,9 @@ static void _override_node(const ipv6_addr_t *addr, unsigned iface,
 {
     _nib_onl_clear(node);
     if (addr != NULL) {
+        _nib_idx_onl_remove(node);
         memcpy(&node->ipv6, addr, sizeof(node->ipv6));
+        _nib_idx_onl_add(node);
     }
     _nib_onl_set_if(node, iface);
 }
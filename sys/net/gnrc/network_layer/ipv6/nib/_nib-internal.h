@@ -27,6 +27,7 @@
 
 #include "bitfield.h"
 #include "evtimer_msg.h"
+#include "irq.h"
 #include "kernel_types.h"
 #include "mutex.h"
 #include "net/eui64.h"
@@ -92,6 +93,14 @@ extern "C" {
  */
 typedef struct _nib_onl_entry {
     struct _nib_onl_entry *next;        /**< next removable entry */
+#if IS_ACTIVE(CONFIG_GNRC_IPV6_NIB_INDEX) || defined(DOXYGEN)
+    /**
+     * @brief   next entry in the same bucket of the on-link entry index
+     *
+     * @note    Only available if @ref CONFIG_GNRC_IPV6_NIB_INDEX != 0.
+     */
+    struct _nib_onl_entry *idx_next;
+#endif
 #if IS_ACTIVE(CONFIG_GNRC_IPV6_NIB_QUEUE_PKT) || defined(DOXYGEN)
     /**
      * @brief   queue for packets currently in address resolution
@@ -195,8 +204,16 @@ typedef struct {
 /**
  * @brief   Off-link NIB entry
  */
-typedef struct {
+typedef struct _nib_offl_entry {
     _nib_onl_entry_t *next_hop; /**< next hop to destination */
+#if IS_ACTIVE(CONFIG_GNRC_IPV6_NIB_INDEX) || defined(DOXYGEN)
+    /**
+     * @brief   next entry with the same prefix in the prefix index
+     *
+     * @note    Only available if @ref CONFIG_GNRC_IPV6_NIB_INDEX != 0.
+     */
+    struct _nib_offl_entry *idx_next;
+#endif
     ipv6_addr_t pfx;            /**< prefix to the destination */
     /**
      * @brief   Event for @ref GNRC_IPV6_NIB_PFX_TIMEOUT
@@ -242,6 +259,115 @@ typedef struct {
     BITFIELD(ctxs, GNRC_SIXLOWPAN_CTX_SIZE);
 } _nib_abr_entry_t;
 
+#if IS_ACTIVE(CONFIG_GNRC_IPV6_NIB_INDEX) || defined(DOXYGEN)
+/**
+ * @name    Lookup index
+ *
+ * The index consists of a hash table over the addresses of the on-link entries
+ * and a path-compressed binary prefix trie over the off-link entries.
+ * Entries with the same key are chained in order of their position in the
+ * NIB arrays, so lookups return the same entry as a linear search of these
+ * arrays would.
+ *
+ * @note    Only available if @ref CONFIG_GNRC_IPV6_NIB_INDEX != 0.
+ * @{
+ */
+/**
+ * @brief   Resets the index
+ *
+ * An all-zero index is empty, so this only needs to be called when the NIB
+ * arrays are cleared.
+ */
+void _nib_idx_init(void);
+
+/**
+ * @brief   Adds an on-link entry to the index
+ *
+ * Entries with an unspecified address are not indexed.
+ *
+ * @param[in] node  An on-link entry.
+ */
+void _nib_idx_onl_add(_nib_onl_entry_t *node);
+
+/**
+ * @brief   Removes an on-link entry from the index
+ *
+ * @param[in] node  An on-link entry.
+ */
+void _nib_idx_onl_remove(_nib_onl_entry_t *node);
+
+/**
+ * @brief   Gets a non-empty on-link entry by address and interface
+ *
+ * @param[in] addr  An IPv6 address. Must not be NULL.
+ * @param[in] iface The interface to the node. May be 0 for any interface.
+ *
+ * @return  The first matching entry, NULL if there is none.
+ */
+_nib_onl_entry_t *_nib_idx_onl_get(const ipv6_addr_t *addr, unsigned iface);
+
+/**
+ * @brief   Adds an off-link entry to the index
+ *
+ * @param[in] dst   An off-link entry with _nib_offl_entry_t::pfx and
+ *                  _nib_offl_entry_t::pfx_len set.
+ */
+void _nib_idx_offl_add(_nib_offl_entry_t *dst);
+
+/**
+ * @brief   Removes an off-link entry from the index
+ *
+ * @param[in] dst   An off-link entry.
+ */
+void _nib_idx_offl_remove(_nib_offl_entry_t *dst);
+
+/**
+ * @brief   Gets the off-link entries with exactly the given prefix
+ *
+ * @param[in] pfx       An IPv6 prefix.
+ * @param[in] pfx_len   The length of @p pfx in bits.
+ *
+ * @return  First entry with @p pfx / @p pfx_len. Further entries are
+ *          available via _nib_offl_entry_t::idx_next.
+ * @return  NULL, if there is no such entry.
+ */
+_nib_offl_entry_t *_nib_idx_offl_get(const ipv6_addr_t *pfx, unsigned pfx_len);
+
+/**
+ * @brief   Gets the best matching non-empty off-link entry for a destination
+ *
+ * @param[in] dst   A destination address.
+ *
+ * @return  The off-link entry with the longest prefix matching @p dst.
+ * @return  NULL, if there is no such entry.
+ */
+_nib_offl_entry_t *_nib_idx_offl_get_match(const ipv6_addr_t *dst);
+
+/**
+ * @brief   Gets the first off-link entry covering a destination that has
+ *          the given mode and flags
+ *
+ * @param[in] dst   A destination address.
+ * @param[in] mode  [Mode flags](@ref net_gnrc_ipv6_nib_mode) the entry must
+ *                  have.
+ * @param[in] flags [Off-link entry flags](@ref net_gnrc_ipv6_nib_offl_flags)
+ *                  the entry must have.
+ *
+ * @return  The first (in order of the off-link entry array) entry whose
+ *          prefix covers @p dst and that has @p mode and @p flags set.
+ * @return  NULL, if there is no such entry.
+ */
+_nib_offl_entry_t *_nib_idx_offl_get_first(const ipv6_addr_t *dst,
+                                           uint8_t mode, uint16_t flags);
+/** @} */
+#else   /* CONFIG_GNRC_IPV6_NIB_INDEX */
+#define _nib_idx_init()                 (void)0
+#define _nib_idx_onl_add(node)          (void)node
+#define _nib_idx_onl_remove(node)       (void)node
+#define _nib_idx_offl_add(dst)          (void)dst
+#define _nib_idx_offl_remove(dst)       (void)dst
+#endif  /* CONFIG_GNRC_IPV6_NIB_INDEX */
+
 /**
  * @brief   Event timer for the NIB.
  */
@@ -257,6 +383,27 @@ extern evtimer_msg_t _nib_evtimer;
  */
 extern _nib_dr_entry_t *_prime_def_router;
 
+/**
+ * @brief   Generation of the NIB
+ *
+ * @see gnrc_ipv6_nib_gen()
+ */
+extern uint32_t _nib_gen;
+
+/**
+ * @brief   Marks a change to the NIB that may change the result of
+ *          @ref gnrc_ipv6_nib_get_next_hop_l2addr()
+ *
+ * @pre NIB is acquired
+ */
+static inline void _nib_gen_bump(void)
+{
+    unsigned state = irq_disable();
+
+    _nib_gen++;
+    irq_restore(state);
+}
+
 /**
  * @brief   Initializes NIB internally
  */
@@ -321,6 +468,7 @@ _nib_onl_entry_t *_nib_onl_alloc(const ipv6_addr_t *addr, unsigned iface);
 static inline bool _nib_onl_clear(_nib_onl_entry_t *node)
 {
     if (node->mode == _EMPTY) {
+        _nib_idx_onl_remove(node);
         memset(node, 0, sizeof(_nib_onl_entry_t));
         return true;
     }
@@ -572,6 +720,10 @@ static inline _nib_offl_entry_t *_nib_offl_add(const ipv6_addr_t *next_hop,
     if (nib_offl != NULL) {
         nib_offl->mode |= mode;
     }
+    /* destination cache entries only mirror the route they were taken from */
+    if (mode != _DC) {
+        _nib_gen_bump();
+    }
     return nib_offl;
 }
 
@@ -584,6 +736,9 @@ static inline void _nib_offl_remove(_nib_offl_entry_t *nib_offl, uint8_t mode)
 {
     nib_offl->mode &= ~mode;
     _nib_offl_clear(nib_offl);
+    if (mode != _DC) {
+        _nib_gen_bump();
+    }
 }
 
 #if IS_ACTIVE(CONFIG_GNRC_IPV6_NIB_DC) || DOXYGEN
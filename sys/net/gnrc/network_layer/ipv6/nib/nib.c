@@ -174,6 +174,12 @@ static bool _on_link(const ipv6_addr_t *dst, unsigned *iface)
         }
     }
 #endif  /* CONFIG_GNRC_IPV6_NIB_6LN */
+#if IS_ACTIVE(CONFIG_GNRC_IPV6_NIB_INDEX)
+    if ((entry = _nib_idx_offl_get_first(dst, _PL, _PFX_ON_LINK))) {
+        *iface = _nib_onl_get_if(entry->next_hop);
+        return true;
+    }
+#else   /* CONFIG_GNRC_IPV6_NIB_INDEX */
     while ((entry = _nib_offl_iter(entry))) {
         if ((entry->mode & _PL) && (entry->flags & _PFX_ON_LINK) &&
             (ipv6_addr_match_prefix(dst, &entry->pfx) >= entry->pfx_len)) {
@@ -181,6 +187,7 @@ static bool _on_link(const ipv6_addr_t *dst, unsigned *iface)
             return true;
         }
     }
+#endif  /* CONFIG_GNRC_IPV6_NIB_INDEX */
     return ipv6_addr_is_link_local(dst);
 }
 
@@ -285,6 +292,15 @@ int gnrc_ipv6_nib_get_next_hop_l2addr(const ipv6_addr_t *dst,
     return res;
 }
 
+uint32_t gnrc_ipv6_nib_gen(void)
+{
+    unsigned state = irq_disable();
+    uint32_t gen = _nib_gen;
+
+    irq_restore(state);
+    return gen;
+}
+
 void gnrc_ipv6_nib_handle_pkt(gnrc_netif_t *netif, const ipv6_hdr_t *ipv6,
                               const icmpv6_hdr_t *icmpv6, size_t icmpv6_len)
 {
@@ -292,6 +308,9 @@ void gnrc_ipv6_nib_handle_pkt(gnrc_netif_t *netif, const ipv6_hdr_t *ipv6,
     assert(netif != NULL);
     gnrc_netif_acquire(netif);
     _nib_acquire();
+    /* neighbor discovery may change neighbor states or link-layer addresses
+     * in many places, so just assume it does */
+    _nib_gen_bump();
     switch (icmpv6->type) {
 #if IS_ACTIVE(CONFIG_GNRC_IPV6_NIB_ROUTER)
         case ICMPV6_RTR_SOL:
@@ -334,10 +353,13 @@ void gnrc_ipv6_nib_handle_timer_event(void *ctx, uint16_t type)
 #if IS_ACTIVE(CONFIG_GNRC_IPV6_NIB_ARSM)
         case GNRC_IPV6_NIB_SND_UC_NS:
         case GNRC_IPV6_NIB_SND_MC_NS:
+            /* might give up on the neighbor */
+            _nib_gen_bump();
             _handle_snd_ns(ctx);
             break;
         case GNRC_IPV6_NIB_REACH_TIMEOUT:
         case GNRC_IPV6_NIB_DELAY_TIMEOUT:
+            _nib_gen_bump();
             _handle_state_timeout(ctx);
             break;
         case GNRC_IPV6_NIB_RECALC_REACH_TIME:
@@ -1276,6 +1298,7 @@ static void _handle_pfx_timeout(_nib_offl_entry_t *pfx)
         }
         pfx->mode &= ~_PL;
         _nib_offl_clear(pfx);
+        _nib_gen_bump();
     }
     else if (now >= pfx->pref_until) {
         for (int i = 0; i < CONFIG_GNRC_NETIF_IPV6_ADDRS_NUMOF; i++) {
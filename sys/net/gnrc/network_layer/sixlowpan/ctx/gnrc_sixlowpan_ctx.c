@@ -14,6 +14,7 @@
 
 #include <stdbool.h>
 #include <inttypes.h>
+#include <string.h>
 
 #include "mutex.h"
 #include "net/gnrc/sixlowpan/ctx.h"
@@ -22,36 +23,87 @@
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
 
+#define IDX_NONE        (UINT8_MAX)
+#define LTIME_TICK_US   (US_PER_SEC * 60)
+
 static gnrc_sixlowpan_ctx_t _ctxs[GNRC_SIXLOWPAN_CTX_SIZE];
 static uint32_t _ctx_inval_times[GNRC_SIXLOWPAN_CTX_SIZE];
 static mutex_t _ctx_mutex = MUTEX_INIT;
+/* IDs of all contexts with a prefix, sorted by prefix and then by ascending
+ * prefix length, so a best-match look-up is a binary search */
+static uint8_t _ctx_idx[GNRC_SIXLOWPAN_CTX_SIZE];
+/* position of the longest prefix in _ctx_idx containing the prefix at the
+ * same position, IDX_NONE if there is none */
+static uint8_t _ctx_parent[GNRC_SIXLOWPAN_CTX_SIZE];
+static uint8_t _ctx_num;
+/* lifetimes are refreshed once a minute by the next function accessing the
+ * buffer, not on every look-up */
+static void _ltime_tick(void *arg);
+static xtimer_t _ltime_timer = { .callback = _ltime_tick };
+static volatile bool _ltime_armed, _ltime_due;
+#if CONFIG_GNRC_SIXLOWPAN_CTX_CACHE_SIZE > 0
+/* generation of the context buffer, changes whenever a look-up by address
+ * might change its result. 0 is reserved for unused cache entries */
+static uint16_t _ctx_gen = 1;
+#endif
 
 static uint32_t _current_minute(void);
-static void _update_lifetime(uint8_t id);
+static void _update_lifetimes(void);
+static void _arm_ltime_timer(void);
+static void _rebuild_idx(void);
 
 static char ipv6str[IPV6_ADDR_MAX_STR_LEN];
 
-static inline bool _valid(uint8_t id)
+static inline void _invalidate_caches(void)
 {
-    _update_lifetime(id);
-    return (_ctxs[id].prefix_len > 0);
+#if CONFIG_GNRC_SIXLOWPAN_CTX_CACHE_SIZE > 0
+    if (++_ctx_gen == 0) {
+        _ctx_gen = 1;
+    }
+#endif
+}
+
+static inline void _lock(void)
+{
+    mutex_lock(&_ctx_mutex);
+    if (_ltime_due) {
+        _update_lifetimes();
+    }
+}
+
+static inline bool _contains(const gnrc_sixlowpan_ctx_t *ctx,
+                             const ipv6_addr_t *addr)
+{
+    return ipv6_addr_match_prefix(&ctx->prefix, addr) >= ctx->prefix_len;
 }
 
 gnrc_sixlowpan_ctx_t *gnrc_sixlowpan_ctx_lookup_addr(const ipv6_addr_t *addr)
 {
-    uint8_t best = 0;
     gnrc_sixlowpan_ctx_t *res = NULL;
+    unsigned lo = 0, hi;
+    uint8_t pos;
 
-    mutex_lock(&_ctx_mutex);
+    _lock();
 
-    for (unsigned int id = 0; id < GNRC_SIXLOWPAN_CTX_SIZE; id++) {
-        if (_valid(id)) {
-            uint8_t match = ipv6_addr_match_prefix(&_ctxs[id].prefix, addr);
+    /* find the last prefix that is less or equal to addr ... */
+    hi = _ctx_num;
+    while (lo < hi) {
+        unsigned mid = (lo + hi) / 2;
 
-            if ((_ctxs[id].prefix_len <= match) && (match > best)) {
-                best = match;
-                res = &(_ctxs[id]);
-            }
+        if (memcmp(&_ctxs[_ctx_idx[mid]].prefix, addr, sizeof(*addr)) <= 0) {
+            lo = mid + 1;
+        }
+        else {
+            hi = mid;
+        }
+    }
+    /* ... every prefix containing addr contains this one as well, so the
+     * longest of them is the first on its chain of enclosing prefixes */
+    for (pos = (lo > 0) ? (lo - 1) : IDX_NONE; pos != IDX_NONE;
+         pos = _ctx_parent[pos]) {
+        if (_contains(&_ctxs[_ctx_idx[pos]], addr)) {
+            res = &_ctxs[_ctx_idx[pos]];
+            break;
         }
     }
 
@@ -70,15 +122,47 @@ gnrc_sixlowpan_ctx_t *gnrc_sixlowpan_ctx_lookup_addr(const ipv6_addr_t *addr)
     return res;
 }
 
+#if CONFIG_GNRC_SIXLOWPAN_CTX_CACHE_SIZE > 0
+gnrc_sixlowpan_ctx_t *gnrc_sixlowpan_ctx_lookup_addr_cached(gnrc_sixlowpan_ctx_cache_t *cache,
+                                                            const ipv6_addr_t *addr)
+{
+    gnrc_sixlowpan_ctx_cache_entry_t *entry;
+    gnrc_sixlowpan_ctx_t *res;
+    /* read generation before the look-up, so an update during the look-up
+     * invalidates its result */
+    uint16_t gen = _ctx_gen;
+
+    for (unsigned i = 0; i < CONFIG_GNRC_SIXLOWPAN_CTX_CACHE_SIZE; i++) {
+        entry = &cache->entries[i];
+        if ((entry->gen == gen) && ipv6_addr_equal(&entry->addr, addr)) {
+            if (entry->id == GNRC_SIXLOWPAN_CTX_CACHE_NONE) {
+                return NULL;
+            }
+            /* flags and lifetime of the context might have changed */
+            return gnrc_sixlowpan_ctx_lookup_id(entry->id);
+        }
+    }
+    res = gnrc_sixlowpan_ctx_lookup_addr(addr);
+    entry = &cache->entries[cache->next];
+    cache->next = (cache->next + 1) % CONFIG_GNRC_SIXLOWPAN_CTX_CACHE_SIZE;
+    memcpy(&entry->addr, addr, sizeof(entry->addr));
+    entry->id = (res != NULL)
+              ? (res->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_CID_MASK)
+              : GNRC_SIXLOWPAN_CTX_CACHE_NONE;
+    entry->gen = gen;
+    return res;
+}
+#endif
+
 gnrc_sixlowpan_ctx_t *gnrc_sixlowpan_ctx_lookup_id(uint8_t id)
 {
     if (id >= GNRC_SIXLOWPAN_CTX_SIZE) {
         return NULL;
     }
 
-    mutex_lock(&_ctx_mutex);
+    _lock();
 
-    if (_valid(id)) {
+    if (_ctxs[id].prefix_len > 0) {
         DEBUG("6lo ctx: found context (%u, %s/%" PRIu8 ")\n", id,
               ipv6_addr_to_str(ipv6str, &_ctxs[id].prefix, sizeof(ipv6str)),
               _ctxs[id].prefix_len);
@@ -99,7 +183,7 @@ gnrc_sixlowpan_ctx_t *gnrc_sixlowpan_ctx_update(uint8_t id, const ipv6_addr_t *p
         return NULL;
     }
 
-    mutex_lock(&_ctx_mutex);
+    _lock();
 
     _ctxs[id].ltime = ltime;
 
@@ -116,51 +200,146 @@ gnrc_sixlowpan_ctx_t *gnrc_sixlowpan_ctx_update(uint8_t id, const ipv6_addr_t *p
 
     _ctxs[id].flags_id = (comp) ? (GNRC_SIXLOWPAN_CTX_FLAGS_COMP | id) : id;
 
-    if (!ipv6_addr_equal(&(_ctxs[id].prefix), prefix)) {
-        ipv6_addr_set_unspecified(&(_ctxs[id].prefix));
-        ipv6_addr_init_prefix(&(_ctxs[id].prefix), prefix, _ctxs[id].prefix_len);
-    }
+    /* always re-initialize, the look-up relies on the bits beyond the prefix
+     * length being 0 even if only the prefix length changed */
+    ipv6_addr_set_unspecified(&(_ctxs[id].prefix));
+    ipv6_addr_init_prefix(&(_ctxs[id].prefix), prefix, _ctxs[id].prefix_len);
     DEBUG("6lo ctx: update context (%u, %s/%" PRIu8 "), lifetime: %" PRIu16 " min\n",
           id, ipv6_addr_to_str(ipv6str, &_ctxs[id].prefix, sizeof(ipv6str)),
           _ctxs[id].prefix_len, _ctxs[id].ltime);
     _ctx_inval_times[id] = ltime + _current_minute();
+    _rebuild_idx();
+    if (ltime > 0) {
+        _arm_ltime_timer();
+    }
 
     mutex_unlock(&_ctx_mutex);
     return &(_ctxs[id]);
 }
 
+void gnrc_sixlowpan_ctx_remove(uint8_t id)
+{
+    if (id >= GNRC_SIXLOWPAN_CTX_SIZE) {
+        return;
+    }
+
+    _lock();
+    DEBUG("6lo ctx: remove context %u\n", id);
+    _ctxs[id].prefix_len = 0;
+    _rebuild_idx();
+    mutex_unlock(&_ctx_mutex);
+}
+
 static uint32_t _current_minute(void)
 {
     return xtimer_now_usec() / (US_PER_SEC * 60);
 }
 
-static void _update_lifetime(uint8_t id)
+static void _ltime_tick(void *arg)
 {
-    uint32_t now;
+    (void)arg;
+    /* runs in interrupt context, so leave the work to the next user of the
+     * context buffer */
+    _ltime_armed = false;
+    _ltime_due = true;
+}
 
-    if (_ctxs[id].ltime == 0) {
-        _ctxs[id].flags_id &= ~GNRC_SIXLOWPAN_CTX_FLAGS_COMP;
-        return;
+static void _arm_ltime_timer(void)
+{
+    if (!_ltime_armed) {
+        _ltime_armed = true;
+        xtimer_set(&_ltime_timer, LTIME_TICK_US);
     }
+}
 
-    now = _current_minute();
+static void _update_lifetimes(void)
+{
+    uint32_t now = _current_minute();
+    bool running = false;
 
-    if (now >= _ctx_inval_times[id]) {
-        DEBUG("6lo ctx: context %u was invalidated for compression\n", id);
-        _ctxs[id].ltime = 0;
-        _ctxs[id].flags_id &= ~GNRC_SIXLOWPAN_CTX_FLAGS_COMP;
+    _ltime_due = false;
+    for (unsigned id = 0; id < GNRC_SIXLOWPAN_CTX_SIZE; id++) {
+        if ((_ctxs[id].prefix_len == 0) || (_ctxs[id].ltime == 0)) {
+            continue;
+        }
+        if (now >= _ctx_inval_times[id]) {
+            DEBUG("6lo ctx: context %u was invalidated for compression\n", id);
+            _ctxs[id].ltime = 0;
+            _ctxs[id].flags_id &= ~GNRC_SIXLOWPAN_CTX_FLAGS_COMP;
+        }
+        else {
+            _ctxs[id].ltime = (uint16_t)(_ctx_inval_times[id] - now);
+            running = true;
+        }
     }
-    else {
-        _ctxs[id].ltime = (uint16_t)(_ctx_inval_times[id] - now);
+    if (running) {
+        _arm_ltime_timer();
     }
 }
 
-#ifdef TEST_SUITES
-#include <string.h>
+static int _cmp(const gnrc_sixlowpan_ctx_t *a, const gnrc_sixlowpan_ctx_t *b)
+{
+    int res = memcmp(&a->prefix, &b->prefix, sizeof(a->prefix));
+
+    if (res == 0) {
+        res = (int)a->prefix_len - (int)b->prefix_len;
+    }
+    if (res == 0) {
+        /* of two equal contexts the one with the lower ID matches */
+        res = (int)(b->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_CID_MASK) -
+              (int)(a->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_CID_MASK);
+    }
+    return res;
+}
 
+static void _rebuild_idx(void)
+{
+    /* the buffer is tiny and changes rarely, so insertion sort it is */
+    _ctx_num = 0;
+    for (unsigned id = 0; id < GNRC_SIXLOWPAN_CTX_SIZE; id++) {
+        unsigned pos;
+
+        if (_ctxs[id].prefix_len == 0) {
+            continue;
+        }
+        for (pos = _ctx_num;
+             (pos > 0) && (_cmp(&_ctxs[_ctx_idx[pos - 1]], &_ctxs[id]) > 0);
+             pos--) {
+            _ctx_idx[pos] = _ctx_idx[pos - 1];
+        }
+        _ctx_idx[pos] = id;
+        _ctx_num++;
+    }
+    for (unsigned pos = 0; pos < _ctx_num; pos++) {
+        const gnrc_sixlowpan_ctx_t *ctx = &_ctxs[_ctx_idx[pos]];
+        uint8_t parent = IDX_NONE;
+
+        /* prefixes are nested or disjoint, so the closest preceding prefix
+         * containing this one is the longest */
+        for (unsigned i = pos; i > 0; i--) {
+            const gnrc_sixlowpan_ctx_t *tmp = &_ctxs[_ctx_idx[i - 1]];
+
+            if ((tmp->prefix_len <= ctx->prefix_len) &&
+                _contains(tmp, &ctx->prefix)) {
+                parent = i - 1;
+                break;
+            }
+        }
+        _ctx_parent[pos] = parent;
+    }
+    _invalidate_caches();
+}
+
+#ifdef TEST_SUITES
 void gnrc_sixlowpan_ctx_reset(void)
 {
+    mutex_lock(&_ctx_mutex);
+    xtimer_remove(&_ltime_timer);
+    _ltime_armed = false;
+    _ltime_due = false;
     memset(_ctxs, 0, sizeof(_ctxs));
+    _rebuild_idx();
+    mutex_unlock(&_ctx_mutex);
 }
 #endif
 
@@ -16,6 +16,7 @@
 #include <inttypes.h>
 #include <stdbool.h>
 
+#include "bitfield.h"
 #include "net/ieee802154.h"
 #include "net/ipv6.h"
 #include "net/ipv6/hdr.h"
@@ -29,6 +30,9 @@
 #include "net/gnrc/sixlowpan/frag/vrb.h"
 #endif  /* MODULE_GNRC_SIXLOWPAN_FRAG_VRB */
 #include "net/sixlowpan.h"
+#ifdef  MODULE_GNRC_SIXLOWPAN_FRAG_SFR
+#include "net/sixlowpan/sfr.h"
+#endif  /* MODULE_GNRC_SIXLOWPAN_FRAG_SFR */
 #include "thread.h"
 #include "xtimer.h"
 #include "utlist.h"
@@ -38,24 +42,20 @@
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
 
-/* estimated fragment payload size to determinate RBUF_INT_SIZE, default to
- * MAC payload size - fragment header. */
-#ifndef GNRC_SIXLOWPAN_FRAG_SIZE
-/* assuming 64-bit source/destination address, source PAN ID omitted */
-#define GNRC_SIXLOWPAN_FRAG_SIZE (104 - 5)
+#if CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE > UINT8_MAX
+#error "CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE must not exceed 255"
 #endif
 
-#ifndef RBUF_INT_SIZE
-/* same as ((int) ceil((double) N / D)) */
-#define DIV_CEIL(N, D) (((N) + (D) - 1) / (D))
-#define RBUF_INT_SIZE (DIV_CEIL(IPV6_MIN_MTU, GNRC_SIXLOWPAN_FRAG_SIZE) * \
-                       CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE)
-#endif
-
-static gnrc_sixlowpan_frag_rb_int_t rbuf_int[RBUF_INT_SIZE];
-
 static gnrc_sixlowpan_frag_rb_t rbuf[CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE];
 
+/* Entries in use are chained into buckets hashed by (src, dst, tag) so a
+ * fragment finds its datagram without scanning the whole buffer. Links are
+ * indices into `rbuf` plus one, so 0 terminates a chain. The datagram size
+ * is not part of the hash, since gnrc_sixlowpan_frag_rb_exists() and
+ * gnrc_sixlowpan_frag_rb_rm_by_datagram() do not know it */
+static uint8_t _rbuf_bucket[CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE];
+static uint8_t _rbuf_next[CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE];
+
 static char l2addr_str[3 * IEEE802154_LONG_ADDRESS_LEN];
 
 static xtimer_t _gc_timer;
@@ -64,14 +64,9 @@ static msg_t _gc_timer_msg = { .type = GNRC_SIXLOWPAN_FRAG_RB_GC_MSG };
 /* ------------------------------------
  * internal function definitions
  * ------------------------------------*/
-/* checks whether start and end overlaps, but not identical to, given interval i */
-static inline bool _rbuf_int_overlap_partially(gnrc_sixlowpan_frag_rb_int_t *i,
-                                               uint16_t start, uint16_t end);
-/* gets a free entry from interval buffer */
-static gnrc_sixlowpan_frag_rb_int_t *_rbuf_int_get_free(void);
-/* update interval buffer of entry */
-static bool _rbuf_update_ints(gnrc_sixlowpan_frag_rb_base_t *entry,
-                              uint16_t offset, size_t frag_size);
+/* marks the blocks covered by a fragment as received */
+static void _rbuf_mark_received(gnrc_sixlowpan_frag_rb_t *entry,
+                                uint16_t offset, size_t frag_size);
 /* gets an entry identified by its tuple */
 static int _rbuf_get(const void *src, size_t src_len,
                      const void *dst, size_t dst_len,
@@ -92,30 +87,117 @@ enum {
     RBUF_ADD_DUPLICATE = -3,
 };
 
-static int _check_fragments(gnrc_sixlowpan_frag_rb_base_t *entry,
+static inline unsigned _first_block(size_t offset)
+{
+    return offset / 8U;
+}
+
+static inline unsigned _last_block(size_t offset, size_t frag_size)
+{
+    return (offset + frag_size - 1) / 8U;
+}
+
+static int _check_fragments(gnrc_sixlowpan_frag_rb_t *entry,
                             size_t frag_size, size_t offset)
 {
-    gnrc_sixlowpan_frag_rb_int_t *ptr = entry->ints;
+    const unsigned first = _first_block(offset);
+    const unsigned last = _last_block(offset, frag_size);
+    unsigned received = 0;
 
+    if (frag_size == 0) {
+        /* covers nothing, so there is nothing to add */
+        return RBUF_ADD_DUPLICATE;
+    }
+    for (unsigned i = first; i <= last; i++) {
+        if (bf_isset(entry->received, i)) {
+            received++;
+        }
+    }
+    if (received == 0) {
+        return RBUF_ADD_SUCCESS;
+    }
+    if (received == (last - first + 1)) {
+        DEBUG("6lo rbuf: fragment already in reassembly buffer\n");
+        return RBUF_ADD_DUPLICATE;
+    }
     /* If the fragment overlaps another fragment and differs in either the size
      * or the offset of the overlapped fragment, discards the datagram
+     * https://tools.ietf.org/html/rfc4944#section-5.3
+     *
+     * "A fresh reassembly may be commenced with the most recently
+     * received link fragment"
      * https://tools.ietf.org/html/rfc4944#section-5.3 */
-    while (ptr != NULL) {
-        if (_rbuf_int_overlap_partially(ptr, offset, offset + frag_size - 1)) {
+    return RBUF_ADD_REPEAT;
+}
 
-            /* "A fresh reassembly may be commenced with the most recently
-             * received link fragment"
-             * https://tools.ietf.org/html/rfc4944#section-5.3 */
-            return RBUF_ADD_REPEAT;
+static unsigned _rbuf_hash(const uint8_t *src, size_t src_len,
+                           const uint8_t *dst, size_t dst_len, uint16_t tag)
+{
+    /* FNV-1a */
+    uint32_t hash = 2166136261U;
+
+    for (unsigned i = 0; i < src_len; i++) {
+        hash = (hash ^ src[i]) * 16777619U;
+    }
+    for (unsigned i = 0; i < dst_len; i++) {
+        hash = (hash ^ dst[i]) * 16777619U;
+    }
+    hash = (hash ^ (tag & 0xff)) * 16777619U;
+    hash = (hash ^ (tag >> 8)) * 16777619U;
+    return hash % CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE;
+}
+
+static inline unsigned _rbuf_entry_hash(const gnrc_sixlowpan_frag_rb_t *e)
+{
+    return _rbuf_hash(e->super.src, e->super.src_len,
+                      e->super.dst, e->super.dst_len, e->super.tag);
+}
+
+static void _rbuf_link(gnrc_sixlowpan_frag_rb_t *e)
+{
+    const unsigned idx = e - rbuf;
+    uint8_t *bucket = &_rbuf_bucket[_rbuf_entry_hash(e)];
+
+    _rbuf_next[idx] = *bucket;
+    *bucket = idx + 1;
+}
+
+static void _rbuf_unlink(gnrc_sixlowpan_frag_rb_t *e)
+{
+    const uint8_t link = (e - rbuf) + 1;
+    uint8_t *ptr = &_rbuf_bucket[_rbuf_entry_hash(e)];
+
+    while (*ptr != 0) {
+        if (*ptr == link) {
+            *ptr = _rbuf_next[link - 1];
+            _rbuf_next[link - 1] = 0;
+            return;
         }
-        /* End was already checked in overlap check */
-        if (ptr->start == offset) {
-            DEBUG("6lo rbuf: fragment already in reassembly buffer\n");
-            return RBUF_ADD_DUPLICATE;
+        ptr = &_rbuf_next[*ptr - 1];
+    }
+}
+
+/* finds an entry by link-layer information and tag, and, if size is not 0,
+ * also by datagram size */
+static gnrc_sixlowpan_frag_rb_t *_rbuf_find(const uint8_t *src, size_t src_len,
+                                            const uint8_t *dst, size_t dst_len,
+                                            size_t size, uint16_t tag)
+{
+    const unsigned bucket = _rbuf_hash(src, src_len, dst, dst_len, tag);
+
+    for (uint8_t i = _rbuf_bucket[bucket]; i != 0; i = _rbuf_next[i - 1]) {
+        gnrc_sixlowpan_frag_rb_t *e = &rbuf[i - 1];
+
+        if (((size == 0) || (e->super.datagram_size == size)) &&
+            (e->super.tag == tag) &&
+            (e->super.src_len == src_len) &&
+            (e->super.dst_len == dst_len) &&
+            (memcmp(e->super.src, src, src_len) == 0) &&
+            (memcmp(e->super.dst, dst, dst_len) == 0)) {
+            return e;
         }
-        ptr = ptr->next;
     }
-    return RBUF_ADD_SUCCESS;
+    return NULL;
 }
 
 gnrc_sixlowpan_frag_rb_t *gnrc_sixlowpan_frag_rb_add(gnrc_netif_hdr_t *netif_hdr,
@@ -138,6 +220,12 @@ gnrc_sixlowpan_frag_rb_t *gnrc_sixlowpan_frag_rb_add(gnrc_netif_hdr_t *netif_hdr
 
 
 
+gnrc_sixlowpan_frag_rb_t *gnrc_sixlowpan_frag_rb_get_by_datagram(
+        const gnrc_netif_hdr_t *netif_hdr, uint16_t tag)
+{
+    return _rbuf_get_by_tag(netif_hdr, tag);
+}
+
 bool gnrc_sixlowpan_frag_rb_exists(const gnrc_netif_hdr_t *netif_hdr,
                                    uint16_t tag)
 {
@@ -159,23 +247,10 @@ static gnrc_sixlowpan_frag_rb_t *_rbuf_get_by_tag(const gnrc_netif_hdr_t *netif_
                                                   uint16_t tag)
 {
     assert(netif_hdr != NULL);
-    const uint8_t *src = gnrc_netif_hdr_get_src_addr(netif_hdr);
-    const uint8_t *dst = gnrc_netif_hdr_get_dst_addr(netif_hdr);
-    const uint8_t src_len = netif_hdr->src_l2addr_len;
-    const uint8_t dst_len = netif_hdr->dst_l2addr_len;
-
-    for (unsigned i = 0; i < CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE; i++) {
-        gnrc_sixlowpan_frag_rb_t *e = &rbuf[i];
-
-        if ((e->pkt != NULL) && (e->super.tag == tag) &&
-            (e->super.src_len == src_len) &&
-            (e->super.dst_len == dst_len) &&
-            (memcmp(e->super.src, src, src_len) == 0) &&
-            (memcmp(e->super.dst, dst, dst_len) == 0)) {
-            return e;
-        }
-    }
-    return NULL;
+    return _rbuf_find(gnrc_netif_hdr_get_src_addr(netif_hdr),
+                      netif_hdr->src_l2addr_len,
+                      gnrc_netif_hdr_get_dst_addr(netif_hdr),
+                      netif_hdr->dst_l2addr_len, 0, tag);
 }
 
 #ifndef NDEBUG
@@ -215,6 +290,154 @@ static size_t _6lo_frag_size(gnrc_pktsnip_t *pkt, size_t offset, uint8_t *data)
     return frag_size;
 }
 
+#ifdef MODULE_GNRC_SIXLOWPAN_IPHC
+/* hands a first fragment with an IPHC header over to IPHC reception, which
+ * takes care of `pkt` */
+static int _rbuf_add_iphc(gnrc_sixlowpan_frag_rb_t *entry, gnrc_pktsnip_t *pkt,
+                          size_t hdr_size, int res)
+{
+    gnrc_pktsnip_t *frag_hdr = gnrc_pktbuf_mark(pkt, hdr_size,
+                                                GNRC_NETTYPE_SIXLOWPAN);
+
+    DEBUG("6lo rbuf: detected IPHC header.\n");
+    if (frag_hdr == NULL) {
+        DEBUG("6lo rbuf: unable to mark fragment header. "
+              "aborting reassembly.\n");
+        gnrc_pktbuf_release(entry->pkt);
+        gnrc_pktbuf_release(pkt);
+        gnrc_sixlowpan_frag_rb_remove(entry);
+        return RBUF_ADD_ERROR;
+    }
+    DEBUG("6lo rbuf: handing over to IPHC reception.\n");
+    /* `pkt` released in IPHC */
+    gnrc_sixlowpan_iphc_recv(pkt, entry, 0);
+    /* check if entry was deleted in IPHC (error case) */
+    if (gnrc_sixlowpan_frag_rb_entry_empty(entry)) {
+        res = RBUF_ADD_ERROR;
+    }
+    return res;
+}
+#endif
+
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_SFR
+static int _rbuf_add_rfrag(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
+                           size_t offset, unsigned page)
+{
+    const sixlowpan_sfr_rfrag_t *hdr = pkt->data;
+    const uint8_t *src = gnrc_netif_hdr_get_src_addr(netif_hdr);
+    const uint8_t *dst = gnrc_netif_hdr_get_dst_addr(netif_hdr);
+    gnrc_sixlowpan_frag_rb_t *entry;
+    uint8_t *data = ((uint8_t *)pkt->data) + sizeof(sixlowpan_sfr_rfrag_t);
+    size_t frag_size = sixlowpan_sfr_rfrag_get_frag_size(hdr);
+    const uint8_t seq = sixlowpan_sfr_rfrag_get_seq(hdr);
+    size_t datagram_size;
+    int res;
+
+    assert(offset == ((seq == 0) ? 0 : sixlowpan_sfr_rfrag_get_offset(hdr)));
+    if ((frag_size == 0) ||
+        (frag_size != (pkt->size - sizeof(sixlowpan_sfr_rfrag_t)))) {
+        DEBUG("6lo rbuf: invalid fragment size %u for recoverable fragment\n",
+              (unsigned)frag_size);
+        gnrc_pktbuf_release(pkt);
+        return RBUF_ADD_ERROR;
+    }
+    /* the datagram size is only carried in the first fragment and is later
+     * adapted to the uncompressed headers, so recoverable fragments are
+     * identified by their tag only */
+    entry = _rbuf_find(src, netif_hdr->src_l2addr_len,
+                       dst, netif_hdr->dst_l2addr_len, 0, hdr->base.tag);
+    if (entry != NULL) {
+        datagram_size = entry->super.datagram_size;
+    }
+    else if (seq == 0) {
+        /* the offset field of the first fragment carries the size of the
+         * compressed datagram */
+        datagram_size = sixlowpan_sfr_rfrag_get_offset(hdr);
+    }
+    else {
+        /* without the first fragment the offset in the uncompressed datagram
+         * can not be determined, the fragment will be recovered later */
+        DEBUG("6lo rbuf: first fragment not received yet, discarding "
+              "fragment %u\n", seq);
+        gnrc_pktbuf_release(pkt);
+        return RBUF_ADD_ERROR;
+    }
+    res = _rbuf_get(src, netif_hdr->src_l2addr_len,
+                    dst, netif_hdr->dst_l2addr_len,
+                    datagram_size, hdr->base.tag, page);
+    if (res < 0) {
+        DEBUG("6lo rbuf: reassembly buffer full.\n");
+        gnrc_pktbuf_release(pkt);
+        return RBUF_ADD_ERROR;
+    }
+    entry = &rbuf[res];
+    if (entry->super.current_size == 0) {
+        /* entry was just (re-)created, e.g. after the old one timed out */
+        if (seq > 0) {
+            DEBUG("6lo rbuf: entry timed out, discarding fragment %u\n", seq);
+            gnrc_pktbuf_release(entry->pkt);
+            gnrc_pktbuf_release(pkt);
+            gnrc_sixlowpan_frag_rb_remove(entry);
+            return RBUF_ADD_ERROR;
+        }
+        entry->super.datagram_size = sixlowpan_sfr_rfrag_get_offset(hdr);
+    }
+    if (bf_isset(entry->received, seq)) {
+        DEBUG("6lo rbuf: fragment %u already in reassembly buffer\n", seq);
+        gnrc_pktbuf_release(pkt);
+        return res;
+    }
+    if (seq > 0) {
+        offset += entry->super.offset_diff;
+    }
+    if ((offset + frag_size) > entry->super.datagram_size) {
+        DEBUG("6lo rfrag: fragment too big for resulting datagram, discarding datagram\n");
+        gnrc_pktbuf_release(entry->pkt);
+        gnrc_pktbuf_release(pkt);
+        gnrc_sixlowpan_frag_rb_remove(entry);
+        return RBUF_ADD_ERROR;
+    }
+    bf_set(entry->received, seq);
+#if IS_USED(MODULE_GNRC_SIXLOWPAN_FRAG_STATS)
+    entry->frags++;
+#endif
+    DEBUG("6lo rbuf: add recoverable fragment %u data\n", seq);
+    entry->super.current_size += (uint16_t)frag_size;
+    if (seq == 0) {
+#ifdef MODULE_GNRC_SIXLOWPAN_IPHC
+        if (sixlowpan_iphc_is(data)) {
+            /* IPHC adapts datagram size and offset difference to the
+             * uncompressed headers */
+            return _rbuf_add_iphc(entry, pkt, sizeof(sixlowpan_sfr_rfrag_t),
+                                  res);
+        }
+        else
+#endif
+        if (data[0] == SIXLOWPAN_UNCOMP) {
+            DEBUG("6lo rbuf: detected uncompressed datagram\n");
+            /* the dispatch is part of the compressed datagram */
+            data++;
+            frag_size--;
+            entry->super.current_size--;
+            entry->super.datagram_size--;
+            entry->super.offset_diff = -1;
+            if (gnrc_pktbuf_realloc_data(entry->pkt,
+                                         entry->super.datagram_size) != 0) {
+                DEBUG("6lo rbuf: could not resize reassembly buffer\n");
+                gnrc_pktbuf_release(entry->pkt);
+                gnrc_pktbuf_release(pkt);
+                gnrc_sixlowpan_frag_rb_remove(entry);
+                return RBUF_ADD_ERROR;
+            }
+        }
+    }
+    memcpy(((uint8_t *)entry->pkt->data) + offset, data, frag_size);
+    /* no errors and not consumed => release packet */
+    gnrc_pktbuf_release(pkt);
+    return res;
+}
+#endif  /* MODULE_GNRC_SIXLOWPAN_FRAG_SFR */
+
 static int _rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
                      size_t offset, unsigned page)
 {
@@ -225,6 +448,11 @@ static int _rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
     uint16_t datagram_size;
     uint16_t datagram_tag;
 
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_SFR
+    if (sixlowpan_sfr_rfrag_is(pkt->data)) {
+        return _rbuf_add_rfrag(netif_hdr, pkt, offset, page);
+    }
+#endif
     /* check if provided offset is the same as in fragment */
     assert(_valid_offset(pkt, offset));
     data = _6lo_frag_payload(pkt);
@@ -232,7 +460,6 @@ static int _rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
     datagram_size = sixlowpan_frag_datagram_size(pkt->data);
     datagram_tag = sixlowpan_frag_datagram_tag(pkt->data);
 
-    gnrc_sixlowpan_frag_rb_gc();
     res = _rbuf_get(gnrc_netif_hdr_get_src_addr(netif_hdr), netif_hdr->src_l2addr_len,
                     gnrc_netif_hdr_get_dst_addr(netif_hdr), netif_hdr->dst_l2addr_len,
                     datagram_size, datagram_tag, page);
@@ -251,9 +478,9 @@ static int _rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
         return RBUF_ADD_ERROR;
     }
 
-    switch (_check_fragments(&entry->super, frag_size, offset)) {
+    switch (_check_fragments(entry, frag_size, offset)) {
         case RBUF_ADD_REPEAT:
-            DEBUG("6lo rfrag: overlapping intervals, discarding datagram\n");
+            DEBUG("6lo rfrag: overlapping fragments, discarding datagram\n");
             gnrc_pktbuf_release(entry->pkt);
             gnrc_sixlowpan_frag_rb_remove(entry);
             return RBUF_ADD_REPEAT;
@@ -264,102 +491,46 @@ static int _rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
             break;
     }
 
-    if (_rbuf_update_ints(&entry->super, offset, frag_size)) {
-        DEBUG("6lo rbuf: add fragment data\n");
-        entry->super.current_size += (uint16_t)frag_size;
-        if (offset == 0) {
+    _rbuf_mark_received(entry, offset, frag_size);
+    DEBUG("6lo rbuf: add fragment data\n");
+    entry->super.current_size += (uint16_t)frag_size;
+    if (offset == 0) {
 #ifdef MODULE_GNRC_SIXLOWPAN_IPHC
-            if (sixlowpan_iphc_is(data)) {
-                DEBUG("6lo rbuf: detected IPHC header.\n");
-                gnrc_pktsnip_t *frag_hdr = gnrc_pktbuf_mark(pkt,
-                        sizeof(sixlowpan_frag_t), GNRC_NETTYPE_SIXLOWPAN);
-                if (frag_hdr == NULL) {
-                    DEBUG("6lo rbuf: unable to mark fragment header. "
-                          "aborting reassembly.\n");
-                    gnrc_pktbuf_release(entry->pkt);
-                    gnrc_pktbuf_release(pkt);
-                    gnrc_sixlowpan_frag_rb_remove(entry);
-                    return RBUF_ADD_ERROR;
-                }
-                else {
-                    DEBUG("6lo rbuf: handing over to IPHC reception.\n");
-                    /* `pkt` released in IPHC */
-                    gnrc_sixlowpan_iphc_recv(pkt, entry, 0);
-                    /* check if entry was deleted in IPHC (error case) */
-                    if (gnrc_sixlowpan_frag_rb_entry_empty(entry)) {
-                        res = RBUF_ADD_ERROR;
-                    }
-                    return res;
-                }
-            }
-            else
+        if (sixlowpan_iphc_is(data)) {
+            return _rbuf_add_iphc(entry, pkt, sizeof(sixlowpan_frag_t), res);
+        }
+        else
 #endif
-            if (data[0] == SIXLOWPAN_UNCOMP) {
-                DEBUG("6lo rbuf: detected uncompressed datagram\n");
-                data++;
-            }
+        if (data[0] == SIXLOWPAN_UNCOMP) {
+            DEBUG("6lo rbuf: detected uncompressed datagram\n");
+            data++;
         }
-        memcpy(((uint8_t *)entry->pkt->data) + offset, data,
-               frag_size);
-    }
-    else {
-        /* no space left in rbuf interval buffer*/
-        gnrc_pktbuf_release(entry->pkt);
-        gnrc_sixlowpan_frag_rb_remove(entry);
-        res = RBUF_ADD_ERROR;
     }
+    memcpy(((uint8_t *)entry->pkt->data) + offset, data, frag_size);
     /* no errors and not consumed => release packet */
     gnrc_pktbuf_release(pkt);
     return res;
 }
 
-static inline bool _rbuf_int_overlap_partially(gnrc_sixlowpan_frag_rb_int_t *i,
-                                               uint16_t start, uint16_t end)
+static void _rbuf_mark_received(gnrc_sixlowpan_frag_rb_t *entry,
+                                uint16_t offset, size_t frag_size)
 {
-    /* start and ends are both inclusive, so using <= for both */
-    return ((i->start <= end) && (start <= i->end)) && /* overlaps */
-        ((start != i->start) || (end != i->end)); /* not identical */
-}
-
-static gnrc_sixlowpan_frag_rb_int_t *_rbuf_int_get_free(void)
-{
-    for (unsigned int i = 0; i < RBUF_INT_SIZE; i++) {
-        if (rbuf_int[i].end == 0) { /* start must be smaller than end anyways*/
-            return rbuf_int + i;
-        }
-    }
+    const unsigned last = _last_block(offset, frag_size);
 
-    return NULL;
-}
-
-static bool _rbuf_update_ints(gnrc_sixlowpan_frag_rb_base_t *entry,
-                              uint16_t offset, size_t frag_size)
-{
-    gnrc_sixlowpan_frag_rb_int_t *new;
-    uint16_t end = (uint16_t)(offset + frag_size - 1);
-
-    new = _rbuf_int_get_free();
-
-    if (new == NULL) {
-        DEBUG("6lo rfrag: no space left in rbuf interval buffer.\n");
-        return false;
-    }
-
-    new->start = offset;
-    new->end = end;
-
-    DEBUG("6lo rfrag: add interval (%" PRIu16 ", %" PRIu16 ") to entry (%s, ",
-          new->start, new->end, gnrc_netif_addr_to_str(entry->src,
-                                                       entry->src_len,
-                                                       l2addr_str));
-    DEBUG("%s, %u, %u)\n", gnrc_netif_addr_to_str(entry->dst,
-                                                  entry->dst_len,
+    DEBUG("6lo rfrag: add interval (%" PRIu16 ", %u) to entry (%s, ",
+          offset, (unsigned)(offset + frag_size - 1),
+          gnrc_netif_addr_to_str(entry->super.src, entry->super.src_len,
+                                 l2addr_str));
+    DEBUG("%s, %u, %u)\n", gnrc_netif_addr_to_str(entry->super.dst,
+                                                  entry->super.dst_len,
                                                   l2addr_str),
-          entry->datagram_size, entry->tag);
-
-    LL_PREPEND(entry->ints, new);
-
-    return true;
+          entry->super.datagram_size, entry->super.tag);
+    for (unsigned i = _first_block(offset); i <= last; i++) {
+        bf_set(entry->received, i);
+    }
+#if IS_USED(MODULE_GNRC_SIXLOWPAN_FRAG_STATS)
+    entry->frags++;
+#endif
 }
 
 static void _gc_pkt(gnrc_sixlowpan_frag_rb_t *rbuf)
@@ -414,38 +585,43 @@ static int _rbuf_get(const void *src, size_t src_len,
                      size_t size, uint16_t tag,
                      unsigned page)
 {
-    gnrc_sixlowpan_frag_rb_t *res = NULL, *oldest = NULL;
+    gnrc_sixlowpan_frag_rb_t *res, *oldest = NULL;
     uint32_t now_usec = xtimer_now_usec();
 
-    for (unsigned int i = 0; i < CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE; i++) {
-        /* check first if entry already available */
-        if ((rbuf[i].pkt != NULL) && (rbuf[i].super.datagram_size == size) &&
-            (rbuf[i].super.tag == tag) && (rbuf[i].super.src_len == src_len) &&
-            (rbuf[i].super.dst_len == dst_len) &&
-            (memcmp(rbuf[i].super.src, src, src_len) == 0) &&
-            (memcmp(rbuf[i].super.dst, dst, dst_len) == 0)) {
-            DEBUG("6lo rfrag: entry %p (%s, ", (void *)(&rbuf[i]),
-                  gnrc_netif_addr_to_str(rbuf[i].super.src,
-                                         rbuf[i].super.src_len,
-                                         l2addr_str));
-            DEBUG("%s, %u, %u) found\n",
-                  gnrc_netif_addr_to_str(rbuf[i].super.dst,
-                                         rbuf[i].super.dst_len,
-                                         l2addr_str),
-                  (unsigned)rbuf[i].super.datagram_size, rbuf[i].super.tag);
+    /* check first if entry already available */
+    res = _rbuf_find(src, src_len, dst, dst_len, size, tag);
+    if ((res != NULL) &&
+        ((now_usec - res->super.arrival) >
+         CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_TIMEOUT_US)) {
+        DEBUG("6lo rfrag: entry %p timed out, collecting it\n", (void *)res);
+        _gc_pkt(res);
+        gnrc_sixlowpan_frag_rb_remove(res);
+        res = NULL;
+    }
+    if (res != NULL) {
+        DEBUG("6lo rfrag: entry %p (%s, ", (void *)res,
+              gnrc_netif_addr_to_str(res->super.src, res->super.src_len,
+                                     l2addr_str));
+        DEBUG("%s, %u, %u) found\n",
+              gnrc_netif_addr_to_str(res->super.dst, res->super.dst_len,
+                                     l2addr_str),
+              (unsigned)res->super.datagram_size, res->super.tag);
 #if CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_DEL_TIMER > 0
-            if (rbuf[i].super.current_size == 0) {
-                /* ensure that only empty reassembly buffer entries and entries
-                 * scheduled for deletion have `current_size == 0` */
-                DEBUG("6lo rfrag: scheduled for deletion, don't add fragment\n");
-                return -1;
-            }
-#endif
-            rbuf[i].super.arrival = now_usec;
-            _set_rbuf_timeout();
-            return i;
+        if (res->super.current_size == 0) {
+            /* ensure that only empty reassembly buffer entries and entries
+             * scheduled for deletion have `current_size == 0` */
+            DEBUG("6lo rfrag: scheduled for deletion, don't add fragment\n");
+            return -1;
         }
+#endif
+        res->super.arrival = now_usec;
+        _set_rbuf_timeout();
+        return res - &(rbuf[0]);
+    }
 
+    /* a new datagram needs an entry, so make room for it first */
+    gnrc_sixlowpan_frag_rb_gc();
+    for (unsigned int i = 0; i < CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE; i++) {
         /* if there is a free spot: remember it */
         if ((res == NULL) && gnrc_sixlowpan_frag_rb_entry_empty(&rbuf[i])) {
             res = &(rbuf[i]);
@@ -514,6 +690,14 @@ static int _rbuf_get(const void *src, size_t src_len,
     res->super.dst_len = dst_len;
     res->super.tag = tag;
     res->super.current_size = 0;
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_SFR
+    res->super.offset_diff = 0;
+#endif
+    memset(res->received, 0, sizeof(res->received));
+#if IS_USED(MODULE_GNRC_SIXLOWPAN_FRAG_STATS)
+    res->frags = 0;
+#endif
+    _rbuf_link(res);
 
     DEBUG("6lo rfrag: entry %p (%s, ", (void *)res,
           gnrc_netif_addr_to_str(res->super.src, res->super.src_len,
@@ -532,7 +716,6 @@ static int _rbuf_get(const void *src, size_t src_len,
 void gnrc_sixlowpan_frag_rb_reset(void)
 {
     xtimer_remove(&_gc_timer);
-    memset(rbuf_int, 0, sizeof(rbuf_int));
     for (unsigned int i = 0; i < CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE; i++) {
         if ((rbuf[i].pkt != NULL) &&
             (rbuf[i].pkt->users > 0)) {
@@ -540,6 +723,8 @@ void gnrc_sixlowpan_frag_rb_reset(void)
         }
     }
     memset(rbuf, 0, sizeof(rbuf));
+    memset(_rbuf_bucket, 0, sizeof(_rbuf_bucket));
+    memset(_rbuf_next, 0, sizeof(_rbuf_next));
 }
 
 const gnrc_sixlowpan_frag_rb_t *gnrc_sixlowpan_frag_rb_array(void)
@@ -550,17 +735,18 @@ const gnrc_sixlowpan_frag_rb_t *gnrc_sixlowpan_frag_rb_array(void)
 
 void gnrc_sixlowpan_frag_rb_base_rm(gnrc_sixlowpan_frag_rb_base_t *entry)
 {
-    while (entry->ints != NULL) {
-        gnrc_sixlowpan_frag_rb_int_t *next = entry->ints->next;
-
-        entry->ints->start = 0;
-        entry->ints->end = 0;
-        entry->ints->next = NULL;
-        entry->ints = next;
-    }
     entry->datagram_size = 0;
 }
 
+void gnrc_sixlowpan_frag_rb_remove(gnrc_sixlowpan_frag_rb_t *rbuf)
+{
+    assert(rbuf != NULL);
+    _rbuf_unlink(rbuf);
+    gnrc_sixlowpan_frag_rb_base_rm(&rbuf->super);
+    memset(rbuf->received, 0, sizeof(rbuf->received));
+    rbuf->pkt = NULL;
+}
+
 static void _tmp_rm(gnrc_sixlowpan_frag_rb_t *rbuf)
 {
 #if CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_DEL_TIMER > 0U
@@ -580,20 +766,6 @@ static void _tmp_rm(gnrc_sixlowpan_frag_rb_t *rbuf)
 #endif  /* CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_DEL_TIMER */
 }
 
-#if IS_USED(MODULE_GNRC_SIXLOWPAN_FRAG_STATS)
-static inline unsigned _count_frags(gnrc_sixlowpan_frag_rb_t *rbuf)
-{
-    unsigned frags = 0;
-    gnrc_sixlowpan_frag_rb_int_t *frag = rbuf->super.ints;
-
-    while (frag) {
-        frag = frag->next;
-        frags++;
-    }
-    return frags;
-}
-#endif
-
 int gnrc_sixlowpan_frag_rb_dispatch_when_complete(gnrc_sixlowpan_frag_rb_t *rbuf,
                                                    gnrc_netif_hdr_t *netif_hdr)
 {
@@ -625,7 +797,7 @@ int gnrc_sixlowpan_frag_rb_dispatch_when_complete(gnrc_sixlowpan_frag_rb_t *rbuf
         new_netif_hdr->rssi = netif_hdr->rssi;
         LL_APPEND(rbuf->pkt, netif);
 #if IS_USED(MODULE_GNRC_SIXLOWPAN_FRAG_STATS)
-        gnrc_sixlowpan_frag_stats_get()->fragments += _count_frags(rbuf);
+        gnrc_sixlowpan_frag_stats_get()->fragments += rbuf->frags;
         gnrc_sixlowpan_frag_stats_get()->datagrams++;
 #endif
         gnrc_sixlowpan_dispatch_recv(rbuf->pkt, NULL, 0);
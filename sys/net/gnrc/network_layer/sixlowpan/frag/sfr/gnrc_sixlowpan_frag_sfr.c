@@ -0,0 +1,712 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+
+#include <assert.h>
+#include <errno.h>
+#include <string.h>
+
+#include "bitfield.h"
+#include "msg.h"
+#include "net/gnrc/netif.h"
+#include "net/gnrc/netif/hdr.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/sixlowpan.h"
+#include "net/gnrc/sixlowpan/config.h"
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG
+#include "net/gnrc/sixlowpan/frag.h"
+#endif  /* MODULE_GNRC_SIXLOWPAN_FRAG */
+#include "net/gnrc/sixlowpan/frag/rb.h"
+#include "net/gnrc/sixlowpan/internal.h"
+#include "net/sixlowpan.h"
+#include "utlist.h"
+#include "xtimer.h"
+
+#include "net/gnrc/sixlowpan/frag/sfr.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+#if GNRC_SIXLOWPAN_SFR_MAX_WIN_SIZE >= SIXLOWPAN_SFR_ACK_BITMAP_SIZE
+#error "GNRC_SIXLOWPAN_SFR_MAX_WIN_SIZE must be lesser than 32"
+#endif
+
+#if GNRC_SIXLOWPAN_SFR_MIN_WIN_SIZE > GNRC_SIXLOWPAN_SFR_MAX_WIN_SIZE
+#error "GNRC_SIXLOWPAN_SFR_MIN_WIN_SIZE must not exceed GNRC_SIXLOWPAN_SFR_MAX_WIN_SIZE"
+#endif
+
+/* NULL bitmap: aborts the datagram, FULL bitmap: datagram fully received */
+#define BITMAP_NULL     (0x00U)
+#define BITMAP_FULL     (0xffU)
+
+static inline unsigned _min(unsigned a, unsigned b)
+{
+    return (a < b) ? a : b;
+}
+
+static inline unsigned _max(unsigned a, unsigned b)
+{
+    return (a > b) ? a : b;
+}
+
+static bool _bitmap_is(const sixlowpan_sfr_ack_t *ack, uint8_t value)
+{
+    for (unsigned i = 0; i < sizeof(ack->bitmap); i++) {
+        if (ack->bitmap[i] != value) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static gnrc_pktsnip_t *_build_netif_hdr(const uint8_t *dst, size_t dst_len,
+                                        kernel_pid_t if_pid)
+{
+    gnrc_pktsnip_t *netif = gnrc_netif_hdr_build(NULL, 0, dst, dst_len);
+
+    if (netif == NULL) {
+        DEBUG("6lo sfr: error allocating link-layer header\n");
+        return NULL;
+    }
+    ((gnrc_netif_hdr_t *)netif->data)->if_pid = if_pid;
+    return netif;
+}
+
+/* builds a recoverable fragment with room for `frag_size` bytes of payload
+ * behind the header */
+static gnrc_pktsnip_t *_build_rfrag(const gnrc_netif_hdr_t *netif_hdr,
+                                   uint8_t tag, uint8_t seq, uint16_t offset,
+                                   uint16_t frag_size)
+{
+    gnrc_pktsnip_t *netif, *frag;
+    sixlowpan_sfr_rfrag_t *hdr;
+
+    netif = gnrc_netif_hdr_build(gnrc_netif_hdr_get_src_addr(netif_hdr),
+                                 netif_hdr->src_l2addr_len,
+                                 gnrc_netif_hdr_get_dst_addr(netif_hdr),
+                                 netif_hdr->dst_l2addr_len);
+    if (netif == NULL) {
+        DEBUG("6lo sfr: error allocating link-layer header\n");
+        return NULL;
+    }
+    /* src_l2addr_len and dst_l2addr_len are already the same, now copy the
+     * rest */
+    *((gnrc_netif_hdr_t *)netif->data) = *netif_hdr;
+    frag = gnrc_pktbuf_add(NULL, NULL, sizeof(sixlowpan_sfr_rfrag_t) + frag_size,
+                           GNRC_NETTYPE_SIXLOWPAN);
+    if (frag == NULL) {
+        DEBUG("6lo sfr: error allocating fragment\n");
+        gnrc_pktbuf_release(netif);
+        return NULL;
+    }
+    hdr = frag->data;
+    hdr->base.disp_ecn = 0;
+    sixlowpan_sfr_rfrag_set_disp(&hdr->base);
+    hdr->base.tag = tag;
+    hdr->ar_seq_fs.u16 = 0;
+    sixlowpan_sfr_rfrag_set_seq(hdr, seq);
+    sixlowpan_sfr_rfrag_set_frag_size(hdr, frag_size);
+    sixlowpan_sfr_rfrag_set_offset(hdr, offset);
+    LL_PREPEND(frag, netif);
+    return frag;
+}
+
+static void _copy_pkt_to_frag(uint8_t *data, const gnrc_pktsnip_t *pkt,
+                              size_t offset, size_t len)
+{
+    while ((pkt != NULL) && (len > 0)) {
+        if (offset >= pkt->size) {
+            offset -= pkt->size;
+        }
+        else {
+            size_t clen = _min(pkt->size - offset, len);
+
+            memcpy(data, ((uint8_t *)pkt->data) + offset, clen);
+            data += clen;
+            len -= clen;
+            offset = 0;
+        }
+        pkt = pkt->next;
+    }
+}
+
+/* ------------------------------------
+ * sending
+ * ------------------------------------*/
+static void _release(gnrc_sixlowpan_frag_fb_t *fbuf, uint32_t err)
+{
+    xtimer_remove(&fbuf->sfr.timer);
+    fbuf->sfr.timer_msg.type = 0;
+    gnrc_pktbuf_release_error(fbuf->pkt, err);
+    fbuf->pkt = NULL;
+}
+
+static void _set_timer(gnrc_sixlowpan_frag_fb_t *fbuf, uint16_t type,
+                       uint32_t offset)
+{
+    fbuf->sfr.timer_msg.type = type;
+    fbuf->sfr.timer_msg.content.ptr = fbuf;
+    xtimer_set_msg(&fbuf->sfr.timer, offset, &fbuf->sfr.timer_msg,
+                   gnrc_sixlowpan_get_pid());
+}
+
+static bool _all_acked(gnrc_sixlowpan_frag_sfr_fb_t *sfr)
+{
+    for (unsigned i = 0; i < sfr->frags; i++) {
+        if (!bf_isset(sfr->acked, i)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void _shrink_window(gnrc_sixlowpan_frag_sfr_fb_t *sfr)
+{
+    sfr->window = _max(sfr->window / 2, GNRC_SIXLOWPAN_SFR_MIN_WIN_SIZE);
+}
+
+static void _init_datagram(gnrc_sixlowpan_frag_fb_t *fbuf)
+{
+    gnrc_sixlowpan_frag_sfr_fb_t *sfr = &fbuf->sfr;
+
+    memset(sfr->acked, 0, sizeof(sfr->acked));
+    sfr->retrans = 0;
+    sfr->window = _min(_max(GNRC_SIXLOWPAN_SFR_OPT_WIN_SIZE,
+                            GNRC_SIXLOWPAN_SFR_MIN_WIN_SIZE),
+                       GNRC_SIXLOWPAN_SFR_MAX_WIN_SIZE);
+    sfr->arq_timeout = GNRC_SIXLOWPAN_SFR_OPT_ARQ_TIMEOUT_MS;
+}
+
+static void _send_next(gnrc_sixlowpan_frag_fb_t *fbuf, unsigned page)
+{
+    gnrc_sixlowpan_frag_sfr_fb_t *sfr = &fbuf->sfr;
+    gnrc_pktsnip_t *frag;
+    sixlowpan_sfr_rfrag_t *hdr;
+    size_t payload_len = gnrc_pkt_len(fbuf->pkt->next);
+    unsigned seq = sfr->next;
+    uint16_t offset, frag_size;
+
+    /* skip fragments that were acknowledged in the meantime */
+    while ((seq < sfr->frags) && bf_isset(sfr->acked, seq)) {
+        seq++;
+    }
+    if ((seq >= sfr->frags) || (sfr->round_left == 0)) {
+        /* nothing left to send in this round, wait for acknowledgment */
+        _set_timer(fbuf, GNRC_SIXLOWPAN_FRAG_SFR_ARQ_TIMEOUT_MSG,
+                   sfr->arq_timeout * US_PER_MS);
+        return;
+    }
+    offset = seq * sfr->frag_size;
+    frag_size = _min(sfr->frag_size, payload_len - offset);
+    /* the first fragment carries the size of the compressed datagram
+     * instead of its offset */
+    frag = _build_rfrag(fbuf->pkt->data, fbuf->tag, seq,
+                        (seq == 0) ? payload_len : offset, frag_size);
+    if (frag == NULL) {
+        _release(fbuf, ENOMEM);
+        return;
+    }
+    hdr = frag->next->data;
+    _copy_pkt_to_frag((uint8_t *)(hdr + 1), fbuf->pkt->next, offset,
+                      frag_size);
+    bf_set(sfr->round, seq);
+    sfr->next = seq + 1;
+    sfr->round_left--;
+    DEBUG("6lo sfr: send fragment %u of datagram %u (offset: %u, "
+          "fragment size: %u)\n", seq, fbuf->tag, offset, frag_size);
+    if (sfr->round_left == 0) {
+        /* last fragment of the round requests an acknowledgment */
+        sixlowpan_sfr_rfrag_set_ack_req(hdr);
+        sfr->ack_req_sent = xtimer_now_usec();
+        _set_timer(fbuf, GNRC_SIXLOWPAN_FRAG_SFR_ARQ_TIMEOUT_MSG,
+                   sfr->arq_timeout * US_PER_MS);
+    }
+    else {
+        /* Tell the link layer that we will send more fragments */
+        gnrc_netif_hdr_t *netif_hdr = frag->data;
+
+        netif_hdr->flags |= GNRC_NETIF_HDR_FLAGS_MORE_DATA;
+        _set_timer(fbuf, GNRC_SIXLOWPAN_FRAG_SFR_INTER_FRAG_GAP_MSG,
+                   GNRC_SIXLOWPAN_SFR_INTER_FRAME_GAP_US);
+    }
+    gnrc_sixlowpan_dispatch_send(frag, NULL, page);
+}
+
+static void _start_round(gnrc_sixlowpan_frag_fb_t *fbuf, unsigned page)
+{
+    gnrc_sixlowpan_frag_sfr_fb_t *sfr = &fbuf->sfr;
+    unsigned unacked = 0;
+
+    for (unsigned i = 0; i < sfr->frags; i++) {
+        if (!bf_isset(sfr->acked, i)) {
+            unacked++;
+        }
+    }
+    assert(unacked > 0);
+    memset(sfr->round, 0, sizeof(sfr->round));
+    sfr->next = 0;
+    /* the lowest unacknowledged fragments, so losses are retransmitted
+     * first */
+    sfr->round_left = _min(sfr->window, unacked);
+    DEBUG("6lo sfr: start round of %u fragments for datagram %u\n",
+          sfr->round_left, fbuf->tag);
+    _send_next(fbuf, page);
+}
+
+static void _abort(gnrc_sixlowpan_frag_fb_t *fbuf, unsigned page)
+{
+    gnrc_sixlowpan_frag_sfr_fb_t *sfr = &fbuf->sfr;
+    /* a fragment with sequence number, offset, and size 0 aborts the
+     * datagram */
+    gnrc_pktsnip_t *frag = _build_rfrag(fbuf->pkt->data, fbuf->tag, 0, 0, 0);
+
+    DEBUG("6lo sfr: aborting datagram %u\n", fbuf->tag);
+    xtimer_remove(&sfr->timer);
+    if (frag != NULL) {
+        gnrc_sixlowpan_dispatch_send(frag, NULL, page);
+    }
+    if ((sfr->dg_retries + 1U) <= GNRC_SIXLOWPAN_SFR_DG_RETRIES) {
+        sfr->dg_retries++;
+        DEBUG("6lo sfr: retrying datagram (%u/%u)\n", sfr->dg_retries,
+              GNRC_SIXLOWPAN_SFR_DG_RETRIES);
+        fbuf->tag = (uint8_t)gnrc_sixlowpan_frag_fb_next_tag();
+        _init_datagram(fbuf);
+        _start_round(fbuf, page);
+    }
+    else {
+        _release(fbuf, ETIMEDOUT);
+    }
+}
+
+static void _start(gnrc_sixlowpan_frag_fb_t *fbuf, unsigned page)
+{
+    gnrc_sixlowpan_frag_sfr_fb_t *sfr = &fbuf->sfr;
+    gnrc_netif_t *netif = gnrc_netif_hdr_get_netif(fbuf->pkt->data);
+    /* recoverable fragments refer to the compressed datagram */
+    size_t payload_len = gnrc_pkt_len(fbuf->pkt->next);
+    unsigned frag_size, frags;
+
+    assert(netif != NULL);
+    assert(netif->sixlo.max_frag_size > sizeof(sixlowpan_sfr_rfrag_t));
+    frag_size = _min(netif->sixlo.max_frag_size - sizeof(sixlowpan_sfr_rfrag_t),
+                     GNRC_SIXLOWPAN_SFR_OPT_FRAG_SIZE);
+    frags = (payload_len + frag_size - 1) / frag_size;
+    sfr->frags = 0;
+    if ((frags > SIXLOWPAN_SFR_ACK_BITMAP_SIZE) ||
+        (payload_len > UINT16_MAX)) {
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG
+        if (fbuf->datagram_size <= SIXLOWPAN_FRAG_MAX_LEN) {
+            DEBUG("6lo sfr: %u fragments exceed sequence numbers, "
+                  "falling back to classic fragmentation\n", frags);
+            gnrc_sixlowpan_frag_send(fbuf->pkt, fbuf, page);
+            return;
+        }
+#endif  /* MODULE_GNRC_SIXLOWPAN_FRAG */
+        DEBUG("6lo sfr: datagram too big (%u fragments)\n", frags);
+        gnrc_pktbuf_release_error(fbuf->pkt, EMSGSIZE);
+        fbuf->pkt = NULL;
+        return;
+    }
+    /* SFR only provides 8 bits for the datagram tag */
+    fbuf->tag = (uint8_t)fbuf->tag;
+    sfr->frag_size = frag_size;
+    sfr->frags = frags;
+    sfr->dg_retries = 0;
+    sfr->page = page;
+    _init_datagram(fbuf);
+    DEBUG("6lo sfr: send datagram %u in %u fragments of %u bytes\n",
+          fbuf->tag, frags, frag_size);
+    _start_round(fbuf, page);
+}
+
+void gnrc_sixlowpan_frag_sfr_send(gnrc_pktsnip_t *pkt, void *ctx,
+                                  unsigned page)
+{
+    assert(ctx != NULL);
+    gnrc_sixlowpan_frag_fb_t *fbuf = ctx;
+
+    assert((fbuf->pkt == pkt) || (pkt == NULL));
+    if (pkt != NULL) {
+        _start(fbuf, page);
+    }
+    /* datagram may have been released while the inter-frame gap message was
+     * already queued */
+    else if ((fbuf->pkt != NULL) &&
+             (fbuf->sfr.timer_msg.type ==
+              GNRC_SIXLOWPAN_FRAG_SFR_INTER_FRAG_GAP_MSG)) {
+        _send_next(fbuf, page);
+    }
+}
+
+void gnrc_sixlowpan_frag_sfr_arq_timeout(gnrc_sixlowpan_frag_fb_t *fbuf)
+{
+    assert(fbuf != NULL);
+
+    gnrc_sixlowpan_frag_sfr_fb_t *sfr = &fbuf->sfr;
+
+    if ((fbuf->pkt == NULL) ||
+        (sfr->timer_msg.type != GNRC_SIXLOWPAN_FRAG_SFR_ARQ_TIMEOUT_MSG)) {
+        /* datagram was completed in the meantime */
+        return;
+    }
+    DEBUG("6lo sfr: ARQ timeout for datagram %u\n", fbuf->tag);
+    _shrink_window(sfr);
+    sfr->arq_timeout = _min(sfr->arq_timeout * 2,
+                            GNRC_SIXLOWPAN_SFR_MAX_ARQ_TIMEOUT_MS);
+    if (++sfr->retrans > GNRC_SIXLOWPAN_SFR_FRAG_RETRIES) {
+        _abort(fbuf, sfr->page);
+        return;
+    }
+    _start_round(fbuf, sfr->page);
+}
+
+static void _handle_ack(gnrc_sixlowpan_frag_fb_t *fbuf,
+                        const sixlowpan_sfr_ack_t *ack, unsigned page)
+{
+    gnrc_sixlowpan_frag_sfr_fb_t *sfr = &fbuf->sfr;
+    unsigned round_size = 0, round_acked = 0, new_acks = 0;
+    uint32_t rtt_ms;
+
+    if (_bitmap_is(ack, BITMAP_NULL)) {
+        DEBUG("6lo sfr: datagram %u aborted by next hop\n", fbuf->tag);
+        _release(fbuf, ECANCELED);
+        return;
+    }
+    if (_bitmap_is(ack, BITMAP_FULL)) {
+        DEBUG("6lo sfr: datagram %u completely received\n", fbuf->tag);
+        _release(fbuf, GNRC_NETERR_SUCCESS);
+        return;
+    }
+    for (unsigned i = 0; i < sfr->frags; i++) {
+        bool acked = bf_isset((uint8_t *)ack->bitmap, i);
+
+        if (acked && !bf_isset(sfr->acked, i)) {
+            bf_set(sfr->acked, i);
+            new_acks++;
+        }
+        if (bf_isset(sfr->round, i)) {
+            round_size++;
+            round_acked += acked;
+        }
+    }
+    if (_all_acked(sfr)) {
+        DEBUG("6lo sfr: all fragments of datagram %u acknowledged\n",
+              fbuf->tag);
+        _release(fbuf, GNRC_NETERR_SUCCESS);
+        return;
+    }
+    if (sfr->timer_msg.type != GNRC_SIXLOWPAN_FRAG_SFR_ARQ_TIMEOUT_MSG) {
+        /* round is still running, the next acknowledgment request will
+         * tell what is missing */
+        return;
+    }
+    xtimer_remove(&sfr->timer);
+    /* wait for twice the round-trip time of an acknowledgment request */
+    rtt_ms = (xtimer_now_usec() - sfr->ack_req_sent) / US_PER_MS;
+    sfr->arq_timeout = _min(_max(2 * rtt_ms,
+                                 GNRC_SIXLOWPAN_SFR_MIN_ARQ_TIMEOUT_MS),
+                            GNRC_SIXLOWPAN_SFR_MAX_ARQ_TIMEOUT_MS);
+    /* additive increase, multiplicative decrease of the window */
+    if ((round_acked < round_size) ||
+        (GNRC_SIXLOWPAN_SFR_USE_ECN && sixlowpan_sfr_ecn(&ack->base))) {
+        _shrink_window(sfr);
+    }
+    else if (sfr->window < GNRC_SIXLOWPAN_SFR_MAX_WIN_SIZE) {
+        sfr->window++;
+    }
+    DEBUG("6lo sfr: %u/%u fragments of round acknowledged, window: %u\n",
+          round_acked, round_size, sfr->window);
+    sfr->retrans = (new_acks > 0) ? 0 : (sfr->retrans + 1);
+    if (sfr->retrans > GNRC_SIXLOWPAN_SFR_FRAG_RETRIES) {
+        _abort(fbuf, page);
+        return;
+    }
+    _start_round(fbuf, page);
+}
+
+/* ------------------------------------
+ * receiving
+ * ------------------------------------*/
+static void _send_ack(const gnrc_netif_hdr_t *netif_hdr, uint8_t tag,
+                      const uint8_t *bitmap, bool ecn, unsigned page)
+{
+    gnrc_pktsnip_t *netif, *snip;
+    sixlowpan_sfr_ack_t *ack;
+
+    netif = _build_netif_hdr(gnrc_netif_hdr_get_src_addr(netif_hdr),
+                             netif_hdr->src_l2addr_len, netif_hdr->if_pid);
+    if (netif == NULL) {
+        return;
+    }
+    snip = gnrc_pktbuf_add(NULL, NULL, sizeof(sixlowpan_sfr_ack_t),
+                           GNRC_NETTYPE_SIXLOWPAN);
+    if (snip == NULL) {
+        DEBUG("6lo sfr: error allocating acknowledgment\n");
+        gnrc_pktbuf_release(netif);
+        return;
+    }
+    ack = snip->data;
+    ack->base.disp_ecn = 0;
+    sixlowpan_sfr_ack_set_disp(&ack->base);
+    if (ecn) {
+        sixlowpan_sfr_set_ecn(&ack->base);
+    }
+    ack->base.tag = tag;
+    if (bitmap == NULL) {
+        memset(ack->bitmap, BITMAP_FULL, sizeof(ack->bitmap));
+    }
+    else {
+        memcpy(ack->bitmap, bitmap, sizeof(ack->bitmap));
+    }
+    DEBUG("6lo sfr: send acknowledgment for datagram %u "
+          "(bitmap: %02x%02x%02x%02x)\n", tag, ack->bitmap[0],
+          ack->bitmap[1], ack->bitmap[2], ack->bitmap[3]);
+    LL_PREPEND(snip, netif);
+    gnrc_sixlowpan_dispatch_send(snip, NULL, page);
+}
+
+static inline bool _rbuf_complete(const gnrc_sixlowpan_frag_rb_t *rbe)
+{
+    return (rbe->super.current_size == rbe->super.datagram_size);
+}
+
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_VRB
+int gnrc_sixlowpan_frag_sfr_forward(gnrc_pktsnip_t *pkt,
+                                    const sixlowpan_sfr_rfrag_t *rfrag,
+                                    gnrc_sixlowpan_frag_vrb_t *vrbe,
+                                    unsigned page)
+{
+    gnrc_pktsnip_t *netif, *frag;
+    sixlowpan_sfr_rfrag_t *hdr;
+    size_t frag_size = gnrc_pkt_len(pkt);
+    const bool abort = (sixlowpan_sfr_rfrag_get_frag_size(rfrag) == 0);
+
+    assert(rfrag != NULL);
+    assert(vrbe != NULL);
+    netif = _build_netif_hdr(vrbe->super.dst, vrbe->super.dst_len,
+                             vrbe->out_netif->pid);
+    frag = gnrc_pktbuf_add(pkt, rfrag, sizeof(sixlowpan_sfr_rfrag_t),
+                           GNRC_NETTYPE_SIXLOWPAN);
+    if ((netif == NULL) || (frag == NULL)) {
+        DEBUG("6lo sfr: unable to allocate forwarded fragment\n");
+        gnrc_pktbuf_release(netif);
+        /* releases pkt as well, if allocated */
+        gnrc_pktbuf_release((frag == NULL) ? pkt : frag);
+        return -ENOMEM;
+    }
+    hdr = frag->data;
+    if (!abort && (sixlowpan_sfr_rfrag_get_seq(rfrag) == 0)) {
+        /* recompression of the first fragment may have changed its size and
+         * with that all subsequent offsets of the compressed datagram */
+        vrbe->super.offset_diff = frag_size -
+                                  sixlowpan_sfr_rfrag_get_frag_size(rfrag);
+        /* SFR only provides 8 bits for the datagram tag */
+        vrbe->out_tag = (uint8_t)vrbe->out_tag;
+    }
+    if (!abort) {
+        sixlowpan_sfr_rfrag_set_offset(
+                hdr, sixlowpan_sfr_rfrag_get_offset(rfrag) +
+                     vrbe->super.offset_diff
+            );
+    }
+    sixlowpan_sfr_rfrag_set_frag_size(hdr, frag_size);
+    hdr->base.tag = vrbe->out_tag;
+    /* signal congestion if our queue is more than half full */
+    if (msg_avail() > (GNRC_SIXLOWPAN_MSG_QUEUE_SIZE / 2)) {
+        sixlowpan_sfr_set_ecn(&hdr->base);
+    }
+    vrbe->super.arrival = xtimer_now_usec();
+    DEBUG("6lo sfr: forward fragment %u of datagram (%u => %u)\n",
+          sixlowpan_sfr_rfrag_get_seq(hdr), vrbe->super.tag, vrbe->out_tag);
+    LL_PREPEND(frag, netif);
+    gnrc_sixlowpan_dispatch_send(frag, NULL, page);
+    if (abort) {
+        gnrc_sixlowpan_frag_vrb_rm(vrbe);
+    }
+    return 0;
+}
+
+static void _forward_rfrag(gnrc_pktsnip_t *pkt, gnrc_sixlowpan_frag_vrb_t *vrbe,
+                           unsigned page)
+{
+    gnrc_pktsnip_t *netif = pkt->next, *hdr;
+    /* copy header since it is removed from `pkt` */
+    sixlowpan_sfr_rfrag_t rfrag = *((sixlowpan_sfr_rfrag_t *)pkt->data);
+
+    LL_DELETE(pkt, netif);
+    gnrc_pktbuf_release(netif);
+    if (pkt->size == sizeof(rfrag)) {
+        /* no payload */
+        gnrc_pktbuf_release(pkt);
+        pkt = NULL;
+    }
+    else if ((hdr = gnrc_pktbuf_mark(pkt, sizeof(rfrag),
+                                     GNRC_NETTYPE_UNDEF)) != NULL) {
+        pkt = gnrc_pktbuf_remove_snip(pkt, hdr);
+    }
+    else {
+        DEBUG("6lo sfr: unable to mark fragment header\n");
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+    gnrc_sixlowpan_frag_sfr_forward(pkt, &rfrag, vrbe, page);
+}
+
+static void _relay_ack(const sixlowpan_sfr_ack_t *ack,
+                       gnrc_sixlowpan_frag_vrb_t *vrbe,
+                       const gnrc_netif_hdr_t *netif_hdr, unsigned page)
+{
+    gnrc_pktsnip_t *netif, *snip;
+    /* the VRB does not remember the incoming interface, so relay the
+     * acknowledgment via the interface it arrived on */
+    netif = _build_netif_hdr(vrbe->super.src, vrbe->super.src_len,
+                             netif_hdr->if_pid);
+
+    snip = gnrc_pktbuf_add(NULL, ack, sizeof(sixlowpan_sfr_ack_t),
+                           GNRC_NETTYPE_SIXLOWPAN);
+    if ((netif == NULL) || (snip == NULL)) {
+        DEBUG("6lo sfr: unable to allocate relayed acknowledgment\n");
+        gnrc_pktbuf_release(netif);
+        gnrc_pktbuf_release(snip);
+        return;
+    }
+    ((sixlowpan_sfr_ack_t *)snip->data)->base.tag = vrbe->super.tag;
+    DEBUG("6lo sfr: relay acknowledgment of datagram (%u => %u)\n",
+          vrbe->out_tag, vrbe->super.tag);
+    vrbe->super.arrival = xtimer_now_usec();
+    LL_PREPEND(snip, netif);
+    gnrc_sixlowpan_dispatch_send(snip, NULL, page);
+}
+#endif  /* MODULE_GNRC_SIXLOWPAN_FRAG_VRB */
+
+static void _recv_rfrag(gnrc_pktsnip_t *pkt, unsigned page)
+{
+    gnrc_pktsnip_t *netif = pkt->next;
+    gnrc_netif_hdr_t *netif_hdr = netif->data;
+    sixlowpan_sfr_rfrag_t *rfrag = pkt->data;
+    gnrc_sixlowpan_frag_rb_t *rbe;
+    const uint8_t tag = rfrag->base.tag;
+    const uint8_t seq = sixlowpan_sfr_rfrag_get_seq(rfrag);
+    const bool ack_req = sixlowpan_sfr_rfrag_ack_req(rfrag);
+    const bool ecn = sixlowpan_sfr_ecn(&rfrag->base);
+
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_VRB
+    gnrc_sixlowpan_frag_vrb_t *vrbe = gnrc_sixlowpan_frag_vrb_get(
+            gnrc_netif_hdr_get_src_addr(netif_hdr), netif_hdr->src_l2addr_len,
+            tag
+        );
+
+    /* first fragments take the route via IPHC to recompress the headers for
+     * the next hop */
+    if ((vrbe != NULL) &&
+        ((seq > 0) || (sixlowpan_sfr_rfrag_get_frag_size(rfrag) == 0))) {
+        _forward_rfrag(pkt, vrbe, page);
+        return;
+    }
+#endif  /* MODULE_GNRC_SIXLOWPAN_FRAG_VRB */
+    if (sixlowpan_sfr_rfrag_get_frag_size(rfrag) == 0) {
+        DEBUG("6lo sfr: datagram %u aborted by sender\n", tag);
+        gnrc_sixlowpan_frag_rb_rm_by_datagram(netif_hdr, tag);
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+    gnrc_pktbuf_hold(netif, 1); /* hold netif header to use it with
+                                 * dispatch_when_complete()
+                                 * (rb_add() releases `pkt`) */
+    rbe = gnrc_sixlowpan_frag_rb_add(
+            netif_hdr, pkt,
+            (seq == 0) ? 0 : sixlowpan_sfr_rfrag_get_offset(rfrag), page
+        );
+    if (rbe != NULL) {
+        if (_rbuf_complete(rbe)) {
+            _send_ack(netif_hdr, tag, NULL, ecn, page);
+            gnrc_sixlowpan_frag_rb_dispatch_when_complete(rbe, netif_hdr);
+        }
+        else if (ack_req) {
+            _send_ack(netif_hdr, tag, rbe->received, ecn, page);
+        }
+    }
+    else if (ack_req && (CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_DEL_TIMER > 0) &&
+             ((rbe = gnrc_sixlowpan_frag_rb_get_by_datagram(netif_hdr,
+                                                            tag)) != NULL) &&
+             (rbe->super.current_size == 0)) {
+        /* datagram was already completed, but the acknowledgment got lost */
+        _send_ack(netif_hdr, tag, NULL, ecn, page);
+    }
+    gnrc_pktbuf_release(netif);
+}
+
+static void _recv_ack(gnrc_pktsnip_t *pkt, unsigned page)
+{
+    gnrc_netif_hdr_t *netif_hdr = pkt->next->data;
+    const sixlowpan_sfr_ack_t *ack = pkt->data;
+    gnrc_sixlowpan_frag_fb_t *fbuf;
+
+    fbuf = gnrc_sixlowpan_frag_fb_get_by_tag(ack->base.tag);
+    if ((fbuf != NULL) && (fbuf->sfr.frags > 0)) {
+        const gnrc_netif_hdr_t *fb_hdr = fbuf->pkt->data;
+
+        /* only the next hop may acknowledge our fragments */
+        if ((fb_hdr->dst_l2addr_len == netif_hdr->src_l2addr_len) &&
+            (memcmp(gnrc_netif_hdr_get_dst_addr(fb_hdr),
+                    gnrc_netif_hdr_get_src_addr(netif_hdr),
+                    netif_hdr->src_l2addr_len) == 0)) {
+            _handle_ack(fbuf, ack, page);
+            gnrc_pktbuf_release(pkt);
+            return;
+        }
+    }
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_VRB
+    gnrc_sixlowpan_frag_vrb_t *vrbe = gnrc_sixlowpan_frag_vrb_reverse(
+            gnrc_netif_hdr_get_netif(netif_hdr),
+            gnrc_netif_hdr_get_src_addr(netif_hdr), netif_hdr->src_l2addr_len,
+            ack->base.tag
+        );
+
+    if (vrbe != NULL) {
+        _relay_ack(ack, vrbe, netif_hdr, page);
+        if (_bitmap_is(ack, BITMAP_NULL) || _bitmap_is(ack, BITMAP_FULL)) {
+            /* datagram is done for the next hop */
+            gnrc_sixlowpan_frag_vrb_rm(vrbe);
+        }
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+#endif  /* MODULE_GNRC_SIXLOWPAN_FRAG_VRB */
+    DEBUG("6lo sfr: no datagram found for acknowledgment %u\n",
+          ack->base.tag);
+    gnrc_pktbuf_release(pkt);
+}
+
+void gnrc_sixlowpan_frag_sfr_recv(gnrc_pktsnip_t *pkt, void *ctx,
+                                  unsigned page)
+{
+    sixlowpan_sfr_t *hdr = pkt->data;
+
+    (void)ctx;
+    assert((pkt->next != NULL) && (pkt->next->type == GNRC_NETTYPE_NETIF));
+    if (sixlowpan_sfr_rfrag_is(hdr) &&
+        (pkt->size >= sizeof(sixlowpan_sfr_rfrag_t))) {
+        _recv_rfrag(pkt, page);
+    }
+    else if (sixlowpan_sfr_ack_is(hdr) &&
+             (pkt->size >= sizeof(sixlowpan_sfr_ack_t))) {
+        _recv_ack(pkt, page);
+    }
+    else {
+        DEBUG("6lo sfr: invalid selective fragment recovery header\n");
+        gnrc_pktbuf_release(pkt);
+    }
+}
+
+/** @} */
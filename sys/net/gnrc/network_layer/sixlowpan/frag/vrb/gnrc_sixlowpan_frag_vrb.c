@@ -30,7 +30,27 @@
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
 
+#if CONFIG_GNRC_SIXLOWPAN_FRAG_VRB_SIZE > UINT8_MAX
+#error "CONFIG_GNRC_SIXLOWPAN_FRAG_VRB_SIZE must not exceed 255"
+#endif
+
 static gnrc_sixlowpan_frag_vrb_t _vrb[CONFIG_GNRC_SIXLOWPAN_FRAG_VRB_SIZE];
+
+/* Entries in use are chained into two sets of buckets: hashed by (src, tag)
+ * for forwarding and by (out_dst, out_tag) for reverse look-ups. Links are
+ * indices into `_vrb` plus one, so 0 terminates a chain. */
+static uint8_t _in_bucket[CONFIG_GNRC_SIXLOWPAN_FRAG_VRB_SIZE];
+static uint8_t _in_next[CONFIG_GNRC_SIXLOWPAN_FRAG_VRB_SIZE];
+static uint8_t _out_bucket[CONFIG_GNRC_SIXLOWPAN_FRAG_VRB_SIZE];
+static uint8_t _out_next[CONFIG_GNRC_SIXLOWPAN_FRAG_VRB_SIZE];
+/* doubly-linked LRU list of entries in use, most recently used first */
+static uint8_t _lru_prev[CONFIG_GNRC_SIXLOWPAN_FRAG_VRB_SIZE];
+static uint8_t _lru_next[CONFIG_GNRC_SIXLOWPAN_FRAG_VRB_SIZE];
+static uint8_t _lru_head, _lru_tail;
+/* time in microseconds an entry was last looked up, eviction is based on it
+ * since gnrc_sixlowpan_frag_rb_base_t::arrival is not refreshed on every
+ * forwarding path */
+static uint32_t _last_used[CONFIG_GNRC_SIXLOWPAN_FRAG_VRB_SIZE];
 #ifdef MODULE_GNRC_IPV6_NIB
 static char addr_str[IPV6_ADDR_MAX_STR_LEN];
 #else   /* MODULE_GNRC_IPV6_NIB */
@@ -46,79 +66,189 @@ static inline bool _equal_index(const gnrc_sixlowpan_frag_vrb_t *vrbe,
             (memcmp(vrbe->super.src, src, src_len) == 0));
 }
 
+static unsigned _hash(const uint8_t *addr, size_t addr_len, unsigned tag)
+{
+    /* FNV-1a */
+    uint32_t hash = 2166136261U;
+
+    for (unsigned i = 0; i < addr_len; i++) {
+        hash = (hash ^ addr[i]) * 16777619U;
+    }
+    hash = (hash ^ (tag & 0xff)) * 16777619U;
+    return hash % CONFIG_GNRC_SIXLOWPAN_FRAG_VRB_SIZE;
+}
+
+static inline unsigned _in_hash(const gnrc_sixlowpan_frag_vrb_t *vrbe)
+{
+    return _hash(vrbe->super.src, vrbe->super.src_len, vrbe->super.tag);
+}
+
+/* Only the lower 8 bits of the tag are hashed: selective fragment recovery
+ * truncates gnrc_sixlowpan_frag_vrb_t::out_tag of an existing entry */
+static inline unsigned _out_hash(const gnrc_sixlowpan_frag_vrb_t *vrbe)
+{
+    return _hash(vrbe->super.dst, vrbe->super.dst_len, vrbe->out_tag);
+}
+
+static void _chain_rm(uint8_t *ptr, uint8_t *next, uint8_t link)
+{
+    while (*ptr != 0) {
+        if (*ptr == link) {
+            *ptr = next[link - 1];
+            next[link - 1] = 0;
+            return;
+        }
+        ptr = &next[*ptr - 1];
+    }
+}
+
+static void _lru_rm(uint8_t link)
+{
+    const uint8_t prev = _lru_prev[link - 1];
+    const uint8_t next = _lru_next[link - 1];
+
+    if (prev != 0) {
+        _lru_next[prev - 1] = next;
+    }
+    else {
+        _lru_head = next;
+    }
+    if (next != 0) {
+        _lru_prev[next - 1] = prev;
+    }
+    else {
+        _lru_tail = prev;
+    }
+    _lru_prev[link - 1] = 0;
+    _lru_next[link - 1] = 0;
+}
+
+static void _lru_push(uint8_t link)
+{
+    _lru_prev[link - 1] = 0;
+    _lru_next[link - 1] = _lru_head;
+    if (_lru_head != 0) {
+        _lru_prev[_lru_head - 1] = link;
+    }
+    else {
+        _lru_tail = link;
+    }
+    _lru_head = link;
+}
+
+static void _touch(const gnrc_sixlowpan_frag_vrb_t *vrbe)
+{
+    const uint8_t link = (vrbe - _vrb) + 1;
+
+    _last_used[link - 1] = xtimer_now_usec();
+    if (_lru_head != link) {
+        _lru_rm(link);
+        _lru_push(link);
+    }
+}
+
+static void _link(gnrc_sixlowpan_frag_vrb_t *vrbe)
+{
+    const uint8_t link = (vrbe - _vrb) + 1;
+    uint8_t *bucket;
+
+    bucket = &_in_bucket[_in_hash(vrbe)];
+    _in_next[link - 1] = *bucket;
+    *bucket = link;
+    bucket = &_out_bucket[_out_hash(vrbe)];
+    _out_next[link - 1] = *bucket;
+    *bucket = link;
+    _last_used[link - 1] = vrbe->super.arrival;
+    _lru_push(link);
+}
+
+static void _unlink(gnrc_sixlowpan_frag_vrb_t *vrbe)
+{
+    const uint8_t link = (vrbe - _vrb) + 1;
+
+    _chain_rm(&_in_bucket[_in_hash(vrbe)], _in_next, link);
+    _chain_rm(&_out_bucket[_out_hash(vrbe)], _out_next, link);
+    _lru_rm(link);
+}
+
+static gnrc_sixlowpan_frag_vrb_t *_find(const uint8_t *src, size_t src_len,
+                                        unsigned tag)
+{
+    for (uint8_t i = _in_bucket[_hash(src, src_len, tag)]; i != 0;
+         i = _in_next[i - 1]) {
+        if (_equal_index(&_vrb[i - 1], src, src_len, tag)) {
+            return &_vrb[i - 1];
+        }
+    }
+    return NULL;
+}
+
+static gnrc_sixlowpan_frag_vrb_t *_get_free(void)
+{
+    for (unsigned i = 0; i < CONFIG_GNRC_SIXLOWPAN_FRAG_VRB_SIZE; i++) {
+        if (gnrc_sixlowpan_frag_vrb_entry_empty(&_vrb[i])) {
+            return &_vrb[i];
+        }
+    }
+    if (_lru_tail != 0) {
+        gnrc_sixlowpan_frag_vrb_t *lru = &_vrb[_lru_tail - 1];
+
+        if ((xtimer_now_usec() - _last_used[_lru_tail - 1]) >=
+            CONFIG_GNRC_SIXLOWPAN_FRAG_VRB_EVICT_IDLE_US) {
+            DEBUG("6lo vrb: evicting least recently used entry (%s, %u)\n",
+                  gnrc_netif_addr_to_str(lru->super.src,
+                                         lru->super.src_len,
+                                         addr_str), lru->super.tag);
+            gnrc_sixlowpan_frag_vrb_rm(lru);
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_STATS
+            gnrc_sixlowpan_frag_stats_get()->vrb_evictions++;
+#endif
+            return lru;
+        }
+    }
+    return NULL;
+}
+
 
 gnrc_sixlowpan_frag_vrb_t *gnrc_sixlowpan_frag_vrb_add(
         const gnrc_sixlowpan_frag_rb_base_t *base,
         gnrc_netif_t *out_netif, const uint8_t *out_dst, size_t out_dst_len)
 {
-    gnrc_sixlowpan_frag_vrb_t *vrbe = NULL;
+    gnrc_sixlowpan_frag_vrb_t *vrbe;
 
     assert(base != NULL);
     assert(out_netif != NULL);
     assert(out_dst != NULL);
     assert(out_dst_len > 0);
-    for (unsigned i = 0; i < CONFIG_GNRC_SIXLOWPAN_FRAG_VRB_SIZE; i++) {
-        gnrc_sixlowpan_frag_vrb_t *ptr = &_vrb[i];
-
-        if (gnrc_sixlowpan_frag_vrb_entry_empty(ptr) ||
-            _equal_index(ptr, base->src, base->src_len, base->tag)) {
-            vrbe = ptr;
-            if (gnrc_sixlowpan_frag_vrb_entry_empty(vrbe)) {
-                vrbe->super = *base;
-                vrbe->out_netif = out_netif;
-                memcpy(vrbe->super.dst, out_dst, out_dst_len);
-                vrbe->out_tag = gnrc_sixlowpan_frag_fb_next_tag();
-                vrbe->super.dst_len = out_dst_len;
-                DEBUG("6lo vrb: creating entry (%s, ",
-                      gnrc_netif_addr_to_str(vrbe->super.src,
-                                             vrbe->super.src_len,
-                                             addr_str));
-                DEBUG("%s, %u, %u) => ",
-                      gnrc_netif_addr_to_str(vrbe->super.dst,
-                                             vrbe->super.dst_len,
-                                             addr_str),
-                      (unsigned)vrbe->super.datagram_size, vrbe->super.tag);
-                DEBUG("(%s, %u)\n",
-                      gnrc_netif_addr_to_str(vrbe->super.dst,
-                                             vrbe->super.dst_len,
-                                             addr_str), vrbe->out_tag);
-            }
-            /* _equal_index() => append intervals of `base`, so they don't get
-             * lost. We use append, so we don't need to change base! */
-            else if (base->ints != NULL) {
-                gnrc_sixlowpan_frag_rb_int_t *tmp = vrbe->super.ints;
-
-                if (tmp != base->ints) {
-                    /* base->ints is not already vrbe->super.ints */
-                    if (tmp != NULL) {
-                        /* iterate before appending and check if `base->ints` is
-                         * not already part of list */
-                        while (tmp->next != NULL) {
-                            if (tmp == base->ints) {
-                                tmp = NULL;
-                            }
-                            /* cppcheck-suppress nullPointer
-                             * (reason: possible bug in cppcheck, tmp can't
-                             * clearly be a NULL pointer here) */
-                            tmp = tmp->next;
-                        }
-                        if (tmp != NULL) {
-                            tmp->next = base->ints;
-                        }
-                    }
-                    else {
-                        vrbe->super.ints = base->ints;
-                    }
-                }
-            }
-            break;
-        }
+    if ((vrbe = _find(base->src, base->src_len, base->tag)) != NULL) {
+        _touch(vrbe);
+        return vrbe;
     }
+    if ((vrbe = _get_free()) == NULL) {
 #ifdef MODULE_GNRC_SIXLOWPAN_FRAG_STATS
-    if (vrbe == NULL) {
         gnrc_sixlowpan_frag_stats_get()->vrb_full++;
-    }
 #endif
+        return NULL;
+    }
+    vrbe->super = *base;
+    vrbe->out_netif = out_netif;
+    memcpy(vrbe->super.dst, out_dst, out_dst_len);
+    vrbe->out_tag = gnrc_sixlowpan_frag_fb_next_tag();
+    vrbe->super.dst_len = out_dst_len;
+    _link(vrbe);
+    DEBUG("6lo vrb: creating entry (%s, ",
+          gnrc_netif_addr_to_str(vrbe->super.src,
+                                 vrbe->super.src_len,
+                                 addr_str));
+    DEBUG("%s, %u, %u) => ",
+          gnrc_netif_addr_to_str(vrbe->super.dst,
+                                 vrbe->super.dst_len,
+                                 addr_str),
+          (unsigned)vrbe->super.datagram_size, vrbe->super.tag);
+    DEBUG("(%s, %u)\n",
+          gnrc_netif_addr_to_str(vrbe->super.dst,
+                                 vrbe->super.dst_len,
+                                 addr_str), vrbe->out_tag);
     return vrbe;
 }
 
@@ -169,16 +299,46 @@ gnrc_sixlowpan_frag_vrb_t *gnrc_sixlowpan_frag_vrb_from_route(
 gnrc_sixlowpan_frag_vrb_t *gnrc_sixlowpan_frag_vrb_get(
         const uint8_t *src, size_t src_len, unsigned src_tag)
 {
+    gnrc_sixlowpan_frag_vrb_t *vrbe;
+
     DEBUG("6lo vrb: trying to get entry for (%s, %u)\n",
           gnrc_netif_addr_to_str(src, src_len, addr_str), src_tag);
-    for (unsigned i = 0; i < CONFIG_GNRC_SIXLOWPAN_FRAG_VRB_SIZE; i++) {
-        gnrc_sixlowpan_frag_vrb_t *vrbe = &_vrb[i];
+    if ((vrbe = _find(src, src_len, src_tag)) != NULL) {
+        DEBUG("6lo vrb: got VRB to (%s, %u)\n",
+              gnrc_netif_addr_to_str(vrbe->super.dst,
+                                     vrbe->super.dst_len,
+                                     addr_str), vrbe->out_tag);
+        _touch(vrbe);
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_STATS
+        gnrc_sixlowpan_frag_stats_get()->vrb_hits++;
+#endif
+        return vrbe;
+    }
+    DEBUG("6lo vrb: no entry found\n");
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_STATS
+    gnrc_sixlowpan_frag_stats_get()->vrb_misses++;
+#endif
+    return NULL;
+}
+
+gnrc_sixlowpan_frag_vrb_t *gnrc_sixlowpan_frag_vrb_reverse(
+        const gnrc_netif_t *netif, const uint8_t *src, size_t src_len,
+        unsigned tag)
+{
+    DEBUG("6lo vrb: trying to get entry for reverse label (%s, %u)\n",
+          gnrc_netif_addr_to_str(src, src_len, addr_str), tag);
+    for (uint8_t i = _out_bucket[_hash(src, src_len, tag)]; i != 0;
+         i = _out_next[i - 1]) {
+        gnrc_sixlowpan_frag_vrb_t *vrbe = &_vrb[i - 1];
 
-        if (_equal_index(vrbe, src, src_len, src_tag)) {
-            DEBUG("6lo vrb: got VRB to (%s, %u)\n",
-                  gnrc_netif_addr_to_str(vrbe->super.dst,
-                                         vrbe->super.dst_len,
-                                         addr_str), vrbe->out_tag);
+        if ((vrbe->out_tag == tag) && (vrbe->out_netif == netif) &&
+            (vrbe->super.dst_len == src_len) &&
+            (memcmp(vrbe->super.dst, src, src_len) == 0)) {
+            DEBUG("6lo vrb: got VRB entry from (%s, %u)\n",
+                  gnrc_netif_addr_to_str(vrbe->super.src,
+                                         vrbe->super.src_len,
+                                         addr_str), vrbe->super.tag);
+            _touch(vrbe);
             return vrbe;
         }
     }
@@ -186,6 +346,18 @@ gnrc_sixlowpan_frag_vrb_t *gnrc_sixlowpan_frag_vrb_get(
     return NULL;
 }
 
+void gnrc_sixlowpan_frag_vrb_rm(gnrc_sixlowpan_frag_vrb_t *vrb)
+{
+    if (gnrc_sixlowpan_frag_vrb_entry_empty(vrb)) {
+        return;
+    }
+    _unlink(vrb);
+    if (IS_USED(MODULE_GNRC_SIXLOWPAN_FRAG_RB)) {
+        gnrc_sixlowpan_frag_rb_base_rm(&vrb->super);
+    }
+    vrb->super.src_len = 0;
+}
+
 void gnrc_sixlowpan_frag_vrb_gc(void)
 {
     uint32_t now_usec = xtimer_now_usec();
@@ -211,6 +383,15 @@ void gnrc_sixlowpan_frag_vrb_gc(void)
 void gnrc_sixlowpan_frag_vrb_reset(void)
 {
     memset(_vrb, 0, sizeof(_vrb));
+    memset(_in_bucket, 0, sizeof(_in_bucket));
+    memset(_in_next, 0, sizeof(_in_next));
+    memset(_out_bucket, 0, sizeof(_out_bucket));
+    memset(_out_next, 0, sizeof(_out_next));
+    memset(_lru_prev, 0, sizeof(_lru_prev));
+    memset(_lru_next, 0, sizeof(_lru_next));
+    memset(_last_used, 0, sizeof(_last_used));
+    _lru_head = 0;
+    _lru_tail = 0;
 }
 #endif
 
@@ -12,6 +12,7 @@
  * @file
  */
 
+#include "kernel_defines.h"
 #include "kernel_types.h"
 #include "net/gnrc.h"
 #include "thread.h"
@@ -21,6 +22,9 @@
 #include "net/gnrc/sixlowpan.h"
 #include "net/gnrc/sixlowpan/frag.h"
 #include "net/gnrc/sixlowpan/frag/rb.h"
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_SFR
+#include "net/gnrc/sixlowpan/frag/sfr.h"
+#endif  /* MODULE_GNRC_SIXLOWPAN_FRAG_SFR */
 #include "net/gnrc/sixlowpan/iphc.h"
 #include "net/gnrc/netif.h"
 #include "net/sixlowpan.h"
@@ -117,8 +121,10 @@ void gnrc_sixlowpan_multiplex_by_size(gnrc_pktsnip_t *pkt,
         DEBUG("6lo: Dispatch for sending\n");
         gnrc_sixlowpan_dispatch_send(pkt, NULL, page);
     }
-#ifdef MODULE_GNRC_SIXLOWPAN_FRAG
-    else if (orig_datagram_size <= SIXLOWPAN_FRAG_MAX_LEN) {
+#if defined(MODULE_GNRC_SIXLOWPAN_FRAG) || defined(MODULE_GNRC_SIXLOWPAN_FRAG_SFR)
+    /* selective fragment recovery does not limit the datagram size to 11 bits */
+    else if (IS_USED(MODULE_GNRC_SIXLOWPAN_FRAG_SFR) ||
+             (orig_datagram_size <= SIXLOWPAN_FRAG_MAX_LEN)) {
         DEBUG("6lo: Send fragmented (%u > %u)\n",
               (unsigned int)datagram_size, netif->sixlo.max_frag_size);
         gnrc_sixlowpan_frag_fb_t *fbuf;
@@ -139,7 +145,11 @@ void gnrc_sixlowpan_multiplex_by_size(gnrc_pktsnip_t *pkt,
         fbuf->hint.fragsz = 0;
 #endif
 
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_SFR
+        gnrc_sixlowpan_frag_sfr_send(pkt, fbuf, page);
+#else   /* MODULE_GNRC_SIXLOWPAN_FRAG_SFR */
         gnrc_sixlowpan_frag_send(pkt, fbuf, page);
+#endif  /* MODULE_GNRC_SIXLOWPAN_FRAG_SFR */
     }
 #endif
     else {
@@ -219,6 +229,13 @@ static void _receive(gnrc_pktsnip_t *pkt)
         return;
     }
 #endif
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_SFR
+    else if (sixlowpan_sfr_is((sixlowpan_sfr_t *)dispatch)) {
+        DEBUG("6lo: received 6LoWPAN recoverable fragment\n");
+        gnrc_sixlowpan_frag_sfr_recv(pkt, NULL, 0);
+        return;
+    }
+#endif
 #ifdef MODULE_GNRC_SIXLOWPAN_IPHC
     else if (sixlowpan_iphc_is(dispatch)) {
         DEBUG("6lo: received 6LoWPAN IPHC compressed datagram\n");
@@ -360,6 +377,19 @@ static void *_event_loop(void *args)
                 gnrc_sixlowpan_frag_rb_gc();
                 break;
 #endif
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_SFR
+            case GNRC_SIXLOWPAN_FRAG_SFR_ARQ_TIMEOUT_MSG:
+                DEBUG("6lo: ARQ timeout event received\n");
+                gnrc_sixlowpan_frag_sfr_arq_timeout(msg.content.ptr);
+                break;
+            case GNRC_SIXLOWPAN_FRAG_SFR_INTER_FRAG_GAP_MSG: {
+                gnrc_sixlowpan_frag_fb_t *fbuf = msg.content.ptr;
+
+                DEBUG("6lo: inter-frame gap event received\n");
+                gnrc_sixlowpan_frag_sfr_send(NULL, fbuf, fbuf->sfr.page);
+                break;
+            }
+#endif
 
             default:
                 DEBUG("6lo: operation not supported\n");
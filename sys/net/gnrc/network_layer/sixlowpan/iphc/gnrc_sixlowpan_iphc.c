@@ -19,6 +19,7 @@
 #include <stdbool.h>
 
 #include "byteorder.h"
+#include "kernel_defines.h"
 #include "net/ipv6/hdr.h"
 #include "net/ipv6/ext.h"
 #include "net/gnrc.h"
@@ -26,6 +27,10 @@
 #include "net/gnrc/sixlowpan.h"
 #include "net/gnrc/sixlowpan/ctx.h"
 #include "net/gnrc/sixlowpan/frag/rb.h"
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_SFR
+#include "net/gnrc/sixlowpan/frag/sfr.h"
+#include "net/sixlowpan/sfr.h"
+#endif  /* MODULE_GNRC_SIXLOWPAN_FRAG_SFR */
 #ifdef MODULE_GNRC_SIXLOWPAN_FRAG_VRB
 #include "net/gnrc/sixlowpan/frag/vrb.h"
 #endif  /* MODULE_GNRC_SIXLOWPAN_FRAG_VRB */
@@ -147,9 +152,140 @@ static int _forward_frag(gnrc_pktsnip_t *pkt, gnrc_pktsnip_t *frag_hdr,
                          gnrc_sixlowpan_frag_vrb_t *vrbe, unsigned page);
 #endif  /* MODULE_GNRC_SIXLOWPAN_FRAG_VRB */
 
-static size_t _iphc_ipv6_decode(const uint8_t *iphc_hdr,
-                                const gnrc_netif_hdr_t *netif_hdr,
-                                gnrc_netif_t *iface, ipv6_hdr_t *ipv6_hdr)
+#if IS_USED(MODULE_GNRC_SIXLOWPAN_IPHC_REF)
+/* selects the reference implementation, set by gnrc_sixlowpan_iphc_ref_recv()
+ * and gnrc_sixlowpan_iphc_ref_send() */
+static bool _ref;
+#else
+#define _ref    (false)
+#endif  /* IS_USED(MODULE_GNRC_SIXLOWPAN_IPHC_REF) */
+
+/* flags for _iphc_addr_mode_t::flags */
+#define IPHC_ADDR_LL                (0x01)  /**< link-local prefix */
+#define IPHC_ADDR_CTX               (0x02)  /**< prefix from context */
+#define IPHC_ADDR_IID_16            (0x04)  /**< IID 0000:00ff:fe00:XXXX */
+#define IPHC_ADDR_IID_L2            (0x08)  /**< IID from link-layer address */
+#define IPHC_ADDR_MCAST             (0x10)  /**< ffXX:: with XX inline */
+#define IPHC_ADDR_MCAST_LL          (0x20)  /**< ff02:: */
+#define IPHC_ADDR_RESERVED          (0x80)  /**< reserved combination */
+
+/**
+ * @brief   Decompression rule for one SAC/SAM or M/DAC/DAM combination
+ *
+ * The @ref _iphc_addr_mode_t::inline_len bytes following the inline flags /
+ * scope byte (with @ref IPHC_ADDR_MCAST) are copied to the address at
+ * @ref _iphc_addr_mode_t::inline_pos. Everything else is derived from the
+ * flags.
+ */
+typedef struct {
+    uint8_t inline_len;     /**< number of address bytes carried inline */
+    uint8_t inline_pos;     /**< position of the inline bytes in the address */
+    uint8_t flags;          /**< IPHC_ADDR_* flags */
+} _iphc_addr_mode_t;
+
+/* indexed by SAC | SAM >> 4 */
+static const _iphc_addr_mode_t _sam_modes[] = {
+    [IPHC_SAC_SAM_FULL >> 4]    = { 16, 0, 0 },
+    [IPHC_SAC_SAM_64 >> 4]      = { 8, 8, IPHC_ADDR_LL },
+    [IPHC_SAC_SAM_16 >> 4]      = { 2, 14, IPHC_ADDR_LL | IPHC_ADDR_IID_16 },
+    [IPHC_SAC_SAM_L2 >> 4]      = { 0, 0, IPHC_ADDR_LL | IPHC_ADDR_IID_L2 },
+    [IPHC_SAC_SAM_UNSPEC >> 4]  = { 0, 0, 0 },
+    [IPHC_SAC_SAM_CTX_64 >> 4]  = { 8, 8, IPHC_ADDR_CTX },
+    [IPHC_SAC_SAM_CTX_16 >> 4]  = { 2, 14, IPHC_ADDR_CTX | IPHC_ADDR_IID_16 },
+    [IPHC_SAC_SAM_CTX_L2 >> 4]  = { 0, 0, IPHC_ADDR_CTX | IPHC_ADDR_IID_L2 },
+};
+
+/* indexed by M | DAC | DAM, M_UC_PREFIX is decoded separately */
+static const _iphc_addr_mode_t _dam_modes[] = {
+    [IPHC_M_DAC_DAM_U_FULL]     = { 16, 0, 0 },
+    [IPHC_M_DAC_DAM_U_64]       = { 8, 8, IPHC_ADDR_LL },
+    [IPHC_M_DAC_DAM_U_16]       = { 2, 14, IPHC_ADDR_LL | IPHC_ADDR_IID_16 },
+    [IPHC_M_DAC_DAM_U_L2]       = { 0, 0, IPHC_ADDR_LL | IPHC_ADDR_IID_L2 },
+    [IPHC_M_DAC_DAM_U_UNSPEC]   = { 0, 0, IPHC_ADDR_RESERVED },
+    [IPHC_M_DAC_DAM_U_CTX_64]   = { 8, 8, IPHC_ADDR_CTX },
+    [IPHC_M_DAC_DAM_U_CTX_16]   = { 2, 14, IPHC_ADDR_CTX | IPHC_ADDR_IID_16 },
+    [IPHC_M_DAC_DAM_U_CTX_L2]   = { 0, 0, IPHC_ADDR_CTX | IPHC_ADDR_IID_L2 },
+    [IPHC_M_DAC_DAM_M_FULL]     = { 16, 0, 0 },
+    [IPHC_M_DAC_DAM_M_48]       = { 5, 11, IPHC_ADDR_MCAST },
+    [IPHC_M_DAC_DAM_M_32]       = { 3, 13, IPHC_ADDR_MCAST },
+    [IPHC_M_DAC_DAM_M_8]        = { 1, 15, IPHC_ADDR_MCAST_LL },
+    [IPHC_M_DAC_DAM_M_UC_PREFIX] = { 0, 0, IPHC_ADDR_CTX },
+    /* M = 1, DAC = 1, DAM != 00 */
+    [0x0d]                      = { 0, 0, IPHC_ADDR_CTX | IPHC_ADDR_RESERVED },
+    [0x0e]                      = { 0, 0, IPHC_ADDR_CTX | IPHC_ADDR_RESERVED },
+    [0x0f]                      = { 0, 0, IPHC_ADDR_CTX | IPHC_ADDR_RESERVED },
+};
+
+/* hop limits for the compressed values of HL, IPHC_HL_INLINE is inline */
+static const uint8_t _hl_values[] = { 0, 1, 64, 255 };
+
+/**
+ * @brief   Decompresses an address according to a compression mode
+ *
+ * @pre `addr` is all zero
+ *
+ * @param[out] addr         The address to decompress to.
+ * @param[in] mode          The compression mode of the address.
+ * @param[in] inline_data   The inline data of the address.
+ * @param[in] ctx           Context of the address, required with
+ *                          @ref IPHC_ADDR_CTX.
+ * @param[in] iface         Interface the address was received on.
+ * @param[in] netif_hdr     Network interface header of the packet.
+ * @param[in] src           true, when @p addr is the source address.
+ *
+ * @return  Number of bytes consumed from @p inline_data.
+ * @return  -1, if the IID could not be derived from the link-layer address.
+ */
+static int _iphc_addr_decode(ipv6_addr_t *addr, const _iphc_addr_mode_t *mode,
+                             const uint8_t *inline_data,
+                             const gnrc_sixlowpan_ctx_t *ctx,
+                             gnrc_netif_t *iface,
+                             const gnrc_netif_hdr_t *netif_hdr, bool src)
+{
+    unsigned consumed = mode->inline_len;
+
+    if (mode->flags & IPHC_ADDR_MCAST) {
+        addr->u8[0] = 0xff;
+        addr->u8[1] = *(inline_data++);
+        consumed++;
+    }
+    else if (mode->flags & IPHC_ADDR_MCAST_LL) {
+        addr->u8[0] = 0xff;
+        addr->u8[1] = 0x02;
+    }
+    else if (mode->flags & IPHC_ADDR_IID_16) {
+        addr->u32[2] = byteorder_htonl(0x000000ff);
+        addr->u16[6] = byteorder_htons(0xfe00);
+    }
+    else if (mode->flags & IPHC_ADDR_IID_L2) {
+        eui64_t *iid = (eui64_t *)(&addr->u64[1]);
+        int res = (src) ? gnrc_netif_hdr_ipv6_iid_from_src(iface, netif_hdr,
+                                                           iid)
+                        : gnrc_netif_hdr_ipv6_iid_from_dst(iface, netif_hdr,
+                                                           iid);
+        if (res < 0) {
+            return -1;
+        }
+    }
+    memcpy(addr->u8 + mode->inline_pos, inline_data, mode->inline_len);
+    /* prefix last, as a context prefix may overlap with the IID */
+    if (mode->flags & IPHC_ADDR_LL) {
+        ipv6_addr_set_link_local_prefix(addr);
+    }
+    else if (mode->flags & IPHC_ADDR_CTX) {
+        assert(ctx != NULL);
+        ipv6_addr_init_prefix(addr, &ctx->prefix, ctx->prefix_len);
+    }
+    return consumed;
+}
+
+#if IS_USED(MODULE_GNRC_SIXLOWPAN_IPHC_REF)
+/* the switch-based decoder _iphc_ipv6_decode() replaced, kept as reference
+ * for gnrc_sixlowpan_iphc_ref_recv() */
+static size_t _iphc_ipv6_decode_ref(const uint8_t *iphc_hdr,
+                                    const gnrc_netif_hdr_t *netif_hdr,
+                                    gnrc_netif_t *iface,
+                                    ipv6_hdr_t *ipv6_hdr)
 {
     gnrc_sixlowpan_ctx_t *ctx = NULL;
     size_t payload_offset = SIXLOWPAN_IPHC_HDR_LEN;
@@ -404,26 +540,22 @@ static size_t _iphc_ipv6_decode(const uint8_t *iphc_hdr,
 
         case IPHC_M_DAC_DAM_M_UC_PREFIX:
             do {
-                assert(ctx != NULL);
-                uint8_t orig_ctx_len = ctx->prefix_len;
+                /* ffXX:XXLL:PPPP:PPPP:PPPP:PPPP:XXXX:XXXX */
+                ipv6_addr_t prefix = IPV6_ADDR_UNSPECIFIED;
+                uint8_t prefix_len;
 
+                assert(ctx != NULL);
+                prefix_len = (ctx->prefix_len > 64) ? 64 : ctx->prefix_len;
+                ipv6_addr_init_prefix(&prefix, &ctx->prefix, prefix_len);
                 ipv6_addr_set_unspecified(&ipv6_hdr->dst);
-
-                if (ctx->prefix_len > 64) {
-                    ctx->prefix_len = 64;
-                }
-
                 ipv6_hdr->dst.u8[0] = 0xff;
                 ipv6_hdr->dst.u8[1] = iphc_hdr[payload_offset++];
                 ipv6_hdr->dst.u8[2] = iphc_hdr[payload_offset++];
-                ipv6_hdr->dst.u8[3] = ctx->prefix_len;
-                ipv6_addr_init_prefix((ipv6_addr_t *)ipv6_hdr->dst.u8 + 4,
-                                      &ctx->prefix, ctx->prefix_len);
-                memcpy(ipv6_hdr->dst.u8 + 12, iphc_hdr + payload_offset + 2, 4);
-
+                ipv6_hdr->dst.u8[3] = prefix_len;
+                memcpy(ipv6_hdr->dst.u8 + 4, prefix.u8, 8);
+                memcpy(ipv6_hdr->dst.u8 + 12, iphc_hdr + payload_offset, 4);
                 payload_offset += 4;
-                ctx->prefix_len = orig_ctx_len;
-            } while (0);    /* ANSI-C compatible block creation for orig_ctx_len allocation */
+            } while (0);    /* ANSI-C compatible block creation for prefix allocation */
             break;
 
         default:
@@ -432,6 +564,143 @@ static size_t _iphc_ipv6_decode(const uint8_t *iphc_hdr,
     }
     return payload_offset;
 }
+#endif  /* IS_USED(MODULE_GNRC_SIXLOWPAN_IPHC_REF) */
+
+static size_t _iphc_ipv6_decode(const uint8_t *iphc_hdr,
+                                const gnrc_netif_hdr_t *netif_hdr,
+                                gnrc_netif_t *iface, ipv6_hdr_t *ipv6_hdr)
+{
+    gnrc_sixlowpan_ctx_t *ctx = NULL;
+    const _iphc_addr_mode_t *mode;
+    size_t payload_offset = SIXLOWPAN_IPHC_HDR_LEN;
+    int res;
+    uint8_t dam;
+
+#if IS_USED(MODULE_GNRC_SIXLOWPAN_IPHC_REF)
+    if (_ref) {
+        return _iphc_ipv6_decode_ref(iphc_hdr, netif_hdr, iface, ipv6_hdr);
+    }
+#endif  /* IS_USED(MODULE_GNRC_SIXLOWPAN_IPHC_REF) */
+
+    if (iphc_hdr[IPHC2_IDX] & SIXLOWPAN_IPHC2_CID_EXT) {
+        payload_offset++;
+    }
+
+    /* bits of the uncompressed address might not be written in decompression,
+     * so zero the whole header first */
+    memset(ipv6_hdr, 0, sizeof(*ipv6_hdr));
+    ipv6_hdr_set_version(ipv6_hdr);
+
+    switch (iphc_hdr[IPHC1_IDX] & SIXLOWPAN_IPHC1_TF) {
+        case IPHC_TF_ECN_DSCP_FL:
+            ipv6_hdr_set_tc(ipv6_hdr, iphc_hdr[payload_offset++]);
+            ipv6_hdr->v_tc_fl.u8[1] |= iphc_hdr[payload_offset++] & 0x0f;
+            ipv6_hdr->v_tc_fl.u8[2] |= iphc_hdr[payload_offset++];
+            ipv6_hdr->v_tc_fl.u8[3] |= iphc_hdr[payload_offset++];
+            break;
+
+        case IPHC_TF_ECN_FL:
+            ipv6_hdr_set_tc_ecn(ipv6_hdr, iphc_hdr[payload_offset] >> 6);
+            ipv6_hdr_set_tc_dscp(ipv6_hdr, 0);
+            ipv6_hdr->v_tc_fl.u8[1] |= iphc_hdr[payload_offset++] & 0x0f;
+            ipv6_hdr->v_tc_fl.u8[2] |= iphc_hdr[payload_offset++];
+            ipv6_hdr->v_tc_fl.u8[3] |= iphc_hdr[payload_offset++];
+            break;
+
+        case IPHC_TF_ECN_DSCP:
+            ipv6_hdr_set_tc(ipv6_hdr, iphc_hdr[payload_offset++]);
+            ipv6_hdr_set_fl(ipv6_hdr, 0);
+            break;
+
+        case IPHC_TF_ECN_ELIDE:
+            ipv6_hdr_set_tc(ipv6_hdr, 0);
+            ipv6_hdr_set_fl(ipv6_hdr, 0);
+            break;
+    }
+
+    if (!(iphc_hdr[IPHC1_IDX] & SIXLOWPAN_IPHC1_NH)) {
+        ipv6_hdr->nh = iphc_hdr[payload_offset++];
+    }
+
+    if ((iphc_hdr[IPHC1_IDX] & SIXLOWPAN_IPHC1_HL) == IPHC_HL_INLINE) {
+        ipv6_hdr->hl = iphc_hdr[payload_offset++];
+    }
+    else {
+        ipv6_hdr->hl = _hl_values[iphc_hdr[IPHC1_IDX] & SIXLOWPAN_IPHC1_HL];
+    }
+
+    iface = gnrc_netif_hdr_get_netif(netif_hdr);
+    mode = &_sam_modes[(iphc_hdr[IPHC2_IDX] &
+                        (SIXLOWPAN_IPHC2_SAC | SIXLOWPAN_IPHC2_SAM)) >> 4];
+    if (mode->flags & IPHC_ADDR_CTX) {
+        uint8_t sci = 0;
+
+        if (iphc_hdr[IPHC2_IDX] & SIXLOWPAN_IPHC2_CID_EXT) {
+            sci = iphc_hdr[CID_EXT_IDX] >> 4;
+        }
+        ctx = gnrc_sixlowpan_ctx_lookup_id(sci);
+
+        if (ctx == NULL) {
+            DEBUG("6lo iphc: could not find source context\n");
+            return 0;
+        }
+    }
+    res = _iphc_addr_decode(&ipv6_hdr->src, mode, iphc_hdr + payload_offset,
+                            ctx, iface, netif_hdr, true);
+    if (res < 0) {
+        DEBUG("6lo iphc: could not get source's IID\n");
+        return 0;
+    }
+    payload_offset += res;
+
+    dam = iphc_hdr[IPHC2_IDX] & (SIXLOWPAN_IPHC2_M | SIXLOWPAN_IPHC2_DAC |
+                                 SIXLOWPAN_IPHC2_DAM);
+    mode = &_dam_modes[dam];
+    if (mode->flags & IPHC_ADDR_CTX) {
+        uint8_t dci = 0;
+
+        if (iphc_hdr[IPHC2_IDX] & SIXLOWPAN_IPHC2_CID_EXT) {
+            dci = iphc_hdr[CID_EXT_IDX] & 0x0f;
+        }
+        ctx = gnrc_sixlowpan_ctx_lookup_id(dci);
+
+        if (ctx == NULL) {
+            DEBUG("6lo iphc: could not find destination context\n");
+            return 0;
+        }
+    }
+
+    if (mode->flags & IPHC_ADDR_RESERVED) {
+        DEBUG("6lo iphc: unspecified or reserved M, DAC, DAM combination\n");
+    }
+    else if (dam == IPHC_M_DAC_DAM_M_UC_PREFIX) {
+        /* ffXX:XXLL:PPPP:PPPP:PPPP:PPPP:XXXX:XXXX */
+        ipv6_addr_t prefix = IPV6_ADDR_UNSPECIFIED;
+        uint8_t prefix_len;
+
+        assert(ctx != NULL);
+        prefix_len = (ctx->prefix_len > 64) ? 64 : ctx->prefix_len;
+        ipv6_addr_init_prefix(&prefix, &ctx->prefix, prefix_len);
+        ipv6_hdr->dst.u8[0] = 0xff;
+        ipv6_hdr->dst.u8[1] = iphc_hdr[payload_offset++];
+        ipv6_hdr->dst.u8[2] = iphc_hdr[payload_offset++];
+        ipv6_hdr->dst.u8[3] = prefix_len;
+        memcpy(ipv6_hdr->dst.u8 + 4, prefix.u8, 8);
+        memcpy(ipv6_hdr->dst.u8 + 12, iphc_hdr + payload_offset, 4);
+        payload_offset += 4;
+    }
+    else {
+        res = _iphc_addr_decode(&ipv6_hdr->dst, mode,
+                                iphc_hdr + payload_offset, ctx, iface,
+                                netif_hdr, false);
+        if (res < 0) {
+            DEBUG("6lo iphc: could not get destination's IID\n");
+            return 0;
+        }
+        payload_offset += res;
+    }
+    return payload_offset;
+}
 
 #ifdef MODULE_GNRC_SIXLOWPAN_IPHC_NHC
 static size_t _iphc_nhc_ipv6_ext_decode(gnrc_pktsnip_t *sixlo, size_t offset,
@@ -779,6 +1048,22 @@ void gnrc_sixlowpan_iphc_recv(gnrc_pktsnip_t *sixlo, void *rbuf_ptr,
 #endif
     uint16_t payload_len;
     if (rbuf != NULL) {
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_SFR
+        if (sixlowpan_sfr_rfrag_is(sixlo->next->data)) {
+            /* recoverable fragments carry the size of the compressed
+             * datagram, so account for the uncompressed headers */
+            rbuf->super.offset_diff = uncomp_hdr_len - payload_offset;
+            rbuf->super.datagram_size += rbuf->super.offset_diff;
+#ifndef MODULE_GNRC_SIXLOWPAN_FRAG_VRB
+            if (gnrc_pktbuf_realloc_data(ipv6,
+                                         rbuf->super.datagram_size) != 0) {
+                DEBUG("6lo iphc: no space left to reassemble payload\n");
+                _recv_error_release(sixlo, ipv6, rbuf);
+                return;
+            }
+#endif  /* MODULE_GNRC_SIXLOWPAN_FRAG_VRB */
+        }
+#endif  /* MODULE_GNRC_SIXLOWPAN_FRAG_SFR */
         /* for a fragmented datagram we know the overall length already */
         payload_len = (uint16_t)(rbuf->super.datagram_size - sizeof(ipv6_hdr_t));
 #ifdef MODULE_GNRC_SIXLOWPAN_FRAG_VRB
@@ -846,8 +1131,6 @@ void gnrc_sixlowpan_iphc_recv(gnrc_pktsnip_t *sixlo, void *rbuf_ptr,
                 if ((res = _forward_frag(ipv6, sixlo->next, vrbe, page)) == 0) {
                     DEBUG("6lo iphc: successfully recompressed and forwarded "
                           "1st fragment\n");
-                    /* empty list, as it should be in VRB now */
-                    rbuf->super.ints = NULL;
                 }
             }
             if ((ipv6 == NULL) || (res < 0)) {
@@ -915,6 +1198,12 @@ static int _forward_frag(gnrc_pktsnip_t *pkt, gnrc_pktsnip_t *frag_hdr,
     /* remove rewritten netif header (forwarding implementation must do this
      * anyway) */
     pkt = gnrc_pktbuf_remove_snip(pkt, pkt);
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_SFR
+    if (sixlowpan_sfr_rfrag_is(frag_hdr->data)) {
+        return gnrc_sixlowpan_frag_sfr_forward(pkt, frag_hdr->data, vrbe,
+                                               page);
+    }
+#endif  /* MODULE_GNRC_SIXLOWPAN_FRAG_SFR */
     /* the following is just debug output for testing without any forwarding
      * scheme */
     DEBUG("6lo iphc: Do not know how to forward fragment from (%s, %u) ",
@@ -958,6 +1247,60 @@ static inline bool _compressible_nh(uint8_t nh)
     }
 }
 
+static inline gnrc_sixlowpan_ctx_t *_ctx_lookup_addr(gnrc_netif_t *iface,
+                                                     const ipv6_addr_t *addr)
+{
+#if IS_USED(MODULE_GNRC_NETIF_6LO) && (CONFIG_GNRC_SIXLOWPAN_CTX_CACHE_SIZE > 0)
+    /* the reference implementation looks every address up in the context
+     * buffer */
+    if (!_ref) {
+        return gnrc_sixlowpan_ctx_lookup_addr_cached(&iface->sixlo.ctx_cache,
+                                                     addr);
+    }
+#endif
+    (void)iface;
+    return gnrc_sixlowpan_ctx_lookup_addr(addr);
+}
+
+/**
+ * @brief   Compresses the IID of a link-local or context-based unicast
+ *          address
+ *
+ * @param[out] inline_data  Inline data of the IPHC header to write to.
+ * @param[in,out] inline_pos    Position in @p inline_data. Is advanced by the
+ *                              number of bytes carried inline.
+ * @param[in] addr          The address to compress.
+ * @param[in] iid           IID derived from the link-layer address.
+ * @param[in] ctx           Context of @p addr. May be NULL.
+ *
+ * @return  The DAM value of the compression mode. Shifted left by 4 it is the
+ *          corresponding SAM value.
+ */
+static inline uint8_t _iphc_iid_encode(uint8_t *inline_data,
+                                       uint16_t *inline_pos,
+                                       ipv6_addr_t *addr, eui64_t *iid,
+                                       gnrc_sixlowpan_ctx_t *ctx)
+{
+    if ((addr->u64[1].u64 == iid->uint64.u64) ||
+        _context_overlaps_iid(ctx, addr, iid)) {
+        /* 0 bits. The address is derived from link-layer address */
+        return IPHC_M_DAC_DAM_U_L2;
+    }
+    else if ((byteorder_ntohl(addr->u32[2]) == 0x000000ff) &&
+             (byteorder_ntohs(addr->u16[6]) == 0xfe00)) {
+        /* 16 bits. The address is derived using 16 bits carried inline */
+        memcpy(inline_data + *inline_pos, addr->u8 + 14, 2);
+        *inline_pos += 2;
+        return IPHC_M_DAC_DAM_U_16;
+    }
+    else {
+        /* 64 bits. The address is derived using 64 bits carried inline */
+        memcpy(inline_data + *inline_pos, addr->u8 + 8, 8);
+        *inline_pos += 8;
+        return IPHC_M_DAC_DAM_U_64;
+    }
+}
+
 static size_t _iphc_ipv6_encode(gnrc_pktsnip_t *pkt,
                                 const gnrc_netif_hdr_t *netif_hdr,
                                 gnrc_netif_t *iface,
@@ -976,7 +1319,7 @@ static size_t _iphc_ipv6_encode(gnrc_pktsnip_t *pkt,
 
     /* check for available contexts */
     if (!ipv6_addr_is_unspecified(&(ipv6_hdr->src))) {
-        src_ctx = gnrc_sixlowpan_ctx_lookup_addr(&(ipv6_hdr->src));
+        src_ctx = _ctx_lookup_addr(iface, &(ipv6_hdr->src));
         /* do not use source context for compression if */
         /* GNRC_SIXLOWPAN_CTX_FLAGS_COMP is not set */
         if (src_ctx && !(src_ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_COMP)) {
@@ -985,7 +1328,7 @@ static size_t _iphc_ipv6_encode(gnrc_pktsnip_t *pkt,
     }
 
     if (!ipv6_addr_is_multicast(&ipv6_hdr->dst)) {
-        dst_ctx = gnrc_sixlowpan_ctx_lookup_addr(&(ipv6_hdr->dst));
+        dst_ctx = _ctx_lookup_addr(iface, &(ipv6_hdr->dst));
         /* do not use destination context for compression if */
         /* GNRC_SIXLOWPAN_CTX_FLAGS_COMP is not set */
         if (dst_ctx && !(dst_ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_COMP)) {
@@ -1091,27 +1434,10 @@ static size_t _iphc_ipv6_encode(gnrc_pktsnip_t *pkt,
             }
             gnrc_netif_release(iface);
 
-            if ((ipv6_hdr->src.u64[1].u64 == iid.uint64.u64) ||
-                _context_overlaps_iid(src_ctx, &ipv6_hdr->src, &iid)) {
-                /* 0 bits. The address is derived from link-layer address */
-                iphc_hdr[IPHC2_IDX] |= IPHC_SAC_SAM_L2;
-                addr_comp = true;
-            }
-            else if ((byteorder_ntohl(ipv6_hdr->src.u32[2]) == 0x000000ff) &&
-                     (byteorder_ntohs(ipv6_hdr->src.u16[6]) == 0xfe00)) {
-                /* 16 bits. The address is derived using 16 bits carried inline */
-                iphc_hdr[IPHC2_IDX] |= IPHC_SAC_SAM_16;
-                memcpy(iphc_hdr + inline_pos, ipv6_hdr->src.u16 + 7, 2);
-                inline_pos += 2;
-                addr_comp = true;
-            }
-            else {
-                /* 64 bits. The address is derived using 64 bits carried inline */
-                iphc_hdr[IPHC2_IDX] |= IPHC_SAC_SAM_64;
-                memcpy(iphc_hdr + inline_pos, ipv6_hdr->src.u64 + 1, 8);
-                inline_pos += 8;
-                addr_comp = true;
-            }
+            iphc_hdr[IPHC2_IDX] |= _iphc_iid_encode(iphc_hdr, &inline_pos,
+                                                    &ipv6_hdr->src, &iid,
+                                                    src_ctx) << 4;
+            addr_comp = true;
         }
 
         if (!addr_comp) {
@@ -1165,13 +1491,13 @@ static size_t _iphc_ipv6_encode(gnrc_pktsnip_t *pkt,
         /* try unicast prefix based compression */
         else {
             gnrc_sixlowpan_ctx_t *ctx;
-            ipv6_addr_t unicast_prefix;
+            ipv6_addr_t unicast_prefix = IPV6_ADDR_UNSPECIFIED;
             unicast_prefix.u16[0] = ipv6_hdr->dst.u16[2];
             unicast_prefix.u16[1] = ipv6_hdr->dst.u16[3];
             unicast_prefix.u16[2] = ipv6_hdr->dst.u16[4];
             unicast_prefix.u16[3] = ipv6_hdr->dst.u16[5];
 
-            ctx = gnrc_sixlowpan_ctx_lookup_addr(&unicast_prefix);
+            ctx = _ctx_lookup_addr(iface, &unicast_prefix);
 
             if ((ctx != NULL) && (ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_COMP) &&
                 (ctx->prefix_len == ipv6_hdr->dst.u8[3])) {
@@ -1208,27 +1534,9 @@ static size_t _iphc_ipv6_encode(gnrc_pktsnip_t *pkt,
             return 0;
         }
 
-        if ((ipv6_hdr->dst.u64[1].u64 == iid.uint64.u64) ||
-            _context_overlaps_iid(dst_ctx, &(ipv6_hdr->dst), &iid)) {
-            /* 0 bits. The address is derived using the link-layer address */
-            iphc_hdr[IPHC2_IDX] |= IPHC_M_DAC_DAM_U_L2;
-            addr_comp = true;
-        }
-        else if ((byteorder_ntohl(ipv6_hdr->dst.u32[2]) == 0x000000ff) &&
-                 (byteorder_ntohs(ipv6_hdr->dst.u16[6]) == 0xfe00)) {
-            /* 16 bits. The address is derived using 16 bits carried inline */
-            iphc_hdr[IPHC2_IDX] |= IPHC_M_DAC_DAM_U_16;
-            memcpy(&(iphc_hdr[inline_pos]), &(ipv6_hdr->dst.u16[7]), 2);
-            inline_pos += 2;
-            addr_comp = true;
-        }
-        else {
-            /* 64 bits. The address is derived using 64 bits carried inline */
-            iphc_hdr[IPHC2_IDX] |= IPHC_M_DAC_DAM_U_64;
-            memcpy(&(iphc_hdr[inline_pos]), &(ipv6_hdr->dst.u8[8]), 8);
-            inline_pos += 8;
-            addr_comp = true;
-        }
+        iphc_hdr[IPHC2_IDX] |= _iphc_iid_encode(iphc_hdr, &inline_pos,
+                                                &ipv6_hdr->dst, &iid, dst_ctx);
+        addr_comp = true;
     }
 
     if (!addr_comp) {
@@ -1619,4 +1927,22 @@ void gnrc_sixlowpan_iphc_send(gnrc_pktsnip_t *pkt, void *ctx, unsigned page)
     }
 }
 
+#if IS_USED(MODULE_GNRC_SIXLOWPAN_IPHC_REF)
+void gnrc_sixlowpan_iphc_ref_recv(gnrc_pktsnip_t *sixlo, void *rbuf_ptr,
+                                  unsigned page)
+{
+    _ref = true;
+    gnrc_sixlowpan_iphc_recv(sixlo, rbuf_ptr, page);
+    _ref = false;
+}
+
+void gnrc_sixlowpan_iphc_ref_send(gnrc_pktsnip_t *pkt, void *ctx,
+                                  unsigned page)
+{
+    _ref = true;
+    gnrc_sixlowpan_iphc_send(pkt, ctx, page);
+    _ref = false;
+}
+#endif  /* IS_USED(MODULE_GNRC_SIXLOWPAN_IPHC_REF) */
+
 /** @} */
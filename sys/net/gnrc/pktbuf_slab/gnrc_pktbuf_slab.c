@@ -0,0 +1,472 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup net_gnrc_pktbuf
+ * @{
+ *
+ * @file
+ * @brief   Packet buffer implementation using fixed-size blocks
+ *
+ * The packet buffer is split into a number of size classes (slabs). Each
+ * size class consists of an array of equally sized blocks and a free list
+ * threaded through the unused blocks, so allocation and release of a block is
+ * O(1). The first size class is reserved for the @ref gnrc_pktsnip_t
+ * descriptors, the remaining classes hold packet data. A block can be shared by
+ * several snips after gnrc_pktbuf_mark(), so every block carries a reference
+ * counter.
+ */
+
+#include <assert.h>
+#include <errno.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <string.h>
+#include <stdio.h>
+#include <sys/types.h>
+
+#include "mutex.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/nettype.h"
+#include "net/gnrc/pkt.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+#define _ALIGNMENT_MASK     (sizeof(_free_t) - 1)
+#define _ALIGN(size)        (((size) + _ALIGNMENT_MASK) & ~(_ALIGNMENT_MASK))
+
+#define _SNIP_SIZE          _ALIGN(sizeof(gnrc_pktsnip_t))
+#define _HDR_SIZE           _ALIGN(CONFIG_GNRC_PKTBUF_SLAB_HDR_SIZE)
+#define _SMALL_SIZE         _ALIGN(CONFIG_GNRC_PKTBUF_SLAB_SMALL_SIZE)
+#define _LARGE_SIZE         _ALIGN(CONFIG_GNRC_PKTBUF_SLAB_LARGE_SIZE)
+
+/**
+ * @brief   Size classes
+ *
+ * @note    Data classes need to be ordered ascending by block size.
+ */
+enum {
+    _SLAB_SNIP = 0,     /**< packet snip descriptors */
+    _SLAB_HDR,          /**< protocol headers (netif header, IPv6 header, ...) */
+    _SLAB_SMALL,        /**< small payloads */
+    _SLAB_LARGE,        /**< large payloads, up to a full link-layer frame */
+    _SLAB_NUMOF,
+};
+
+typedef struct _free {
+    struct _free *next;
+} _free_t;
+
+typedef struct {
+    uint8_t *blocks;            /**< start of the block array */
+    uint8_t *refs;              /**< reference counter for every block */
+    _free_t *free;              /**< free list */
+    uint16_t block_size;        /**< size of a block in bytes */
+    uint16_t numof;             /**< number of blocks */
+    uint16_t used;              /**< number of blocks currently in use */
+    uint16_t max_used;          /**< high-water mark of used blocks */
+} _slab_t;
+
+static mutex_t _mutex = MUTEX_INIT;
+
+static uint8_t _snip_blocks[CONFIG_GNRC_PKTBUF_SLAB_SNIP_NUMOF * _SNIP_SIZE]
+    __attribute__((aligned(sizeof(_free_t))));
+static uint8_t _hdr_blocks[CONFIG_GNRC_PKTBUF_SLAB_HDR_NUMOF * _HDR_SIZE]
+    __attribute__((aligned(sizeof(_free_t))));
+static uint8_t _small_blocks[CONFIG_GNRC_PKTBUF_SLAB_SMALL_NUMOF * _SMALL_SIZE]
+    __attribute__((aligned(sizeof(_free_t))));
+static uint8_t _large_blocks[CONFIG_GNRC_PKTBUF_SLAB_LARGE_NUMOF * _LARGE_SIZE]
+    __attribute__((aligned(sizeof(_free_t))));
+static uint8_t _snip_refs[CONFIG_GNRC_PKTBUF_SLAB_SNIP_NUMOF];
+static uint8_t _hdr_refs[CONFIG_GNRC_PKTBUF_SLAB_HDR_NUMOF];
+static uint8_t _small_refs[CONFIG_GNRC_PKTBUF_SLAB_SMALL_NUMOF];
+static uint8_t _large_refs[CONFIG_GNRC_PKTBUF_SLAB_LARGE_NUMOF];
+
+static _slab_t _slabs[_SLAB_NUMOF] = {
+    { .blocks = _snip_blocks, .refs = _snip_refs, .block_size = _SNIP_SIZE,
+      .numof = CONFIG_GNRC_PKTBUF_SLAB_SNIP_NUMOF },
+    { .blocks = _hdr_blocks, .refs = _hdr_refs, .block_size = _HDR_SIZE,
+      .numof = CONFIG_GNRC_PKTBUF_SLAB_HDR_NUMOF },
+    { .blocks = _small_blocks, .refs = _small_refs, .block_size = _SMALL_SIZE,
+      .numof = CONFIG_GNRC_PKTBUF_SLAB_SMALL_NUMOF },
+    { .blocks = _large_blocks, .refs = _large_refs, .block_size = _LARGE_SIZE,
+      .numof = CONFIG_GNRC_PKTBUF_SLAB_LARGE_NUMOF },
+};
+
+/* internal gnrc_pktbuf functions */
+static gnrc_pktsnip_t *_create_snip(gnrc_pktsnip_t *next, const void *data, size_t size,
+                                    gnrc_nettype_t type);
+static void *_slab_alloc(unsigned cls);
+static void *_pktbuf_alloc(size_t size);
+static void _pktbuf_free(void *data);
+
+static inline bool _slab_contains(const _slab_t *slab, const void *ptr)
+{
+    return (unsigned)((const uint8_t *)ptr - slab->blocks) <
+           (unsigned)(slab->numof * slab->block_size);
+}
+
+static inline unsigned _slab_idx(const _slab_t *slab, const void *ptr)
+{
+    return (unsigned)((const uint8_t *)ptr - slab->blocks) / slab->block_size;
+}
+
+static _slab_t *_slab_get(const void *ptr)
+{
+    for (unsigned i = 0; i < _SLAB_NUMOF; i++) {
+        if (_slab_contains(&_slabs[i], ptr)) {
+            return &_slabs[i];
+        }
+    }
+    return NULL;
+}
+
+static inline void _set_pktsnip(gnrc_pktsnip_t *pkt, gnrc_pktsnip_t *next,
+                                void *data, size_t size, gnrc_nettype_t type)
+{
+    pkt->next = next;
+    pkt->data = data;
+    pkt->size = size;
+    pkt->type = type;
+    pkt->users = 1;
+#ifdef MODULE_GNRC_NETERR
+    pkt->err_sub = KERNEL_PID_UNDEF;
+#endif
+}
+
+void gnrc_pktbuf_init(void)
+{
+    mutex_lock(&_mutex);
+    for (unsigned i = 0; i < _SLAB_NUMOF; i++) {
+        _slab_t *slab = &_slabs[i];
+
+        slab->free = NULL;
+        /* push blocks in reverse so they are handed out in ascending order */
+        for (unsigned j = slab->numof; j > 0; j--) {
+            _free_t *block = (_free_t *)&slab->blocks[(j - 1) * slab->block_size];
+
+            block->next = slab->free;
+            slab->free = block;
+            slab->refs[j - 1] = 0;
+        }
+        slab->used = 0;
+        slab->max_used = 0;
+    }
+    mutex_unlock(&_mutex);
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_add(gnrc_pktsnip_t *next, const void *data, size_t size,
+                                gnrc_nettype_t type)
+{
+    gnrc_pktsnip_t *pkt;
+
+    if (size > _LARGE_SIZE) {
+        DEBUG("pktbuf: size (%u) > CONFIG_GNRC_PKTBUF_SLAB_LARGE_SIZE (%u)\n",
+              (unsigned)size, (unsigned)_LARGE_SIZE);
+        return NULL;
+    }
+    mutex_lock(&_mutex);
+    pkt = _create_snip(next, data, size, type);
+    mutex_unlock(&_mutex);
+    return pkt;
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_mark(gnrc_pktsnip_t *pkt, size_t size, gnrc_nettype_t type)
+{
+    gnrc_pktsnip_t *marked_snip;
+
+    mutex_lock(&_mutex);
+    if ((size == 0) || (pkt == NULL) || (size > pkt->size) || (pkt->data == NULL)) {
+        DEBUG("pktbuf: size == 0 (was %u) or pkt == NULL (was %p) or "
+              "size > pkt->size (was %u) or pkt->data == NULL (was %p)\n",
+              (unsigned)size, (void *)pkt, (pkt ? (unsigned)pkt->size : 0),
+              (pkt ? pkt->data : NULL));
+        mutex_unlock(&_mutex);
+        return NULL;
+    }
+    /* create new snip descriptor for marked data */
+    marked_snip = _slab_alloc(_SLAB_SNIP);
+    if (marked_snip == NULL) {
+        DEBUG("pktbuf: could not reallocate marked section.\n");
+        mutex_unlock(&_mutex);
+        return NULL;
+    }
+    _set_pktsnip(marked_snip, pkt->next, pkt->data, size, type);
+    if (pkt->size != size) {
+        /* both snips now share the block of pkt->data */
+        _slab_t *slab = _slab_get(pkt->data);
+        unsigned idx = _slab_idx(slab, pkt->data);
+
+        assert(slab->refs[idx] < UINT8_MAX);
+        slab->refs[idx]++;
+        pkt->data = ((uint8_t *)pkt->data) + size;
+    }
+    else {
+        /* block is handed over to the marked snip */
+        pkt->data = NULL;
+    }
+    pkt->size -= size;
+    pkt->next = marked_snip;
+    mutex_unlock(&_mutex);
+    return marked_snip;
+}
+
+int gnrc_pktbuf_realloc_data(gnrc_pktsnip_t *pkt, size_t size)
+{
+    mutex_lock(&_mutex);
+    assert(pkt != NULL);
+    assert(((pkt->size == 0) && (pkt->data == NULL)) ||
+           ((pkt->size > 0) && (pkt->data != NULL) && _slab_get(pkt->data)));
+    /* new size and old size are equal */
+    if (size == pkt->size) {
+        /* nothing to do */
+        mutex_unlock(&_mutex);
+        return 0;
+    }
+    /* new size is 0 and data pointer isn't already NULL */
+    if ((size == 0) && (pkt->data != NULL)) {
+        /* set data pointer to NULL */
+        _pktbuf_free(pkt->data);
+        pkt->data = NULL;
+    }
+    else if (size > pkt->size) {
+        if (pkt->data != NULL) {
+            _slab_t *slab = _slab_get(pkt->data);
+            unsigned idx = _slab_idx(slab, pkt->data);
+            uint8_t *end = &slab->blocks[(idx + 1) * slab->block_size];
+
+            /* grow in place if the block is not shared and still fits */
+            if ((slab->refs[idx] == 1) &&
+                ((size_t)(end - (uint8_t *)pkt->data) >= size)) {
+                pkt->size = size;
+                mutex_unlock(&_mutex);
+                return 0;
+            }
+        }
+        void *new_data = _pktbuf_alloc(size);
+        if (new_data == NULL) {
+            DEBUG("pktbuf: error allocating new data section\n");
+            mutex_unlock(&_mutex);
+            return ENOMEM;
+        }
+        if (pkt->data != NULL) {            /* if old data exist */
+            memcpy(new_data, pkt->data, pkt->size);
+            _pktbuf_free(pkt->data);
+        }
+        pkt->data = new_data;
+    }
+    /* else: shrinking keeps the block, the tail is released with it */
+    pkt->size = size;
+    mutex_unlock(&_mutex);
+    return 0;
+}
+
+void gnrc_pktbuf_hold(gnrc_pktsnip_t *pkt, unsigned int num)
+{
+    mutex_lock(&_mutex);
+    while (pkt) {
+        pkt->users += num;
+        pkt = pkt->next;
+    }
+    mutex_unlock(&_mutex);
+}
+
+static void _release_error_locked(gnrc_pktsnip_t *pkt, uint32_t err)
+{
+    while (pkt) {
+        gnrc_pktsnip_t *tmp;
+        assert(_slab_contains(&_slabs[_SLAB_SNIP], pkt));
+        assert(pkt->users > 0);
+        tmp = pkt->next;
+        if (pkt->users == 1) {
+            pkt->users = 0; /* not necessary but to be on the safe side */
+            _pktbuf_free(pkt->data);
+            _pktbuf_free(pkt);
+        }
+        else {
+            pkt->users--;
+        }
+        DEBUG("pktbuf: report status code %" PRIu32 "\n", err);
+        gnrc_neterr_report(pkt, err);
+        pkt = tmp;
+    }
+}
+
+void gnrc_pktbuf_release_error(gnrc_pktsnip_t *pkt, uint32_t err)
+{
+    mutex_lock(&_mutex);
+    _release_error_locked(pkt, err);
+    mutex_unlock(&_mutex);
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_start_write(gnrc_pktsnip_t *pkt)
+{
+    mutex_lock(&_mutex);
+    if (pkt == NULL) {
+        mutex_unlock(&_mutex);
+        return NULL;
+    }
+    if (pkt->users > 1) {
+        gnrc_pktsnip_t *new;
+        new = _create_snip(pkt->next, pkt->data, pkt->size, pkt->type);
+        if (new != NULL) {
+            pkt->users--;
+        }
+        mutex_unlock(&_mutex);
+        return new;
+    }
+    mutex_unlock(&_mutex);
+    return pkt;
+}
+
+#ifdef DEVELHELP
+void gnrc_pktbuf_stats(void)
+{
+    static const char *names[] = { "snip", "hdr", "small", "large" };
+    unsigned total = 0;
+
+    mutex_lock(&_mutex);
+    puts("packet buffer (slab):");
+    puts("  class  block size  blocks    used  max used");
+    for (unsigned i = 0; i < _SLAB_NUMOF; i++) {
+        _slab_t *slab = &_slabs[i];
+
+        printf("  %-5s  %10u  %6u  %6u  %8u\n", names[i],
+               (unsigned)slab->block_size, (unsigned)slab->numof,
+               (unsigned)slab->used, (unsigned)slab->max_used);
+        total += slab->numof * slab->block_size;
+    }
+    mutex_unlock(&_mutex);
+    printf("  total size: %u\n", total);
+}
+#endif
+
+#ifdef TEST_SUITES
+bool gnrc_pktbuf_is_empty(void)
+{
+    for (unsigned i = 0; i < _SLAB_NUMOF; i++) {
+        if (_slabs[i].used > 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool gnrc_pktbuf_is_sane(void)
+{
+    /* Invariants of this implementation:
+     *  - forall ptr in free list of slab: ptr is at a block boundary in slab
+     *    and the reference counter of its block is 0
+     *  - length of free list of slab == slab->numof - slab->used
+     *  - number of blocks in slab with reference counter > 0 == slab->used
+     */
+    for (unsigned i = 0; i < _SLAB_NUMOF; i++) {
+        _slab_t *slab = &_slabs[i];
+        unsigned free_count = 0, used_count = 0;
+
+        for (_free_t *ptr = slab->free; ptr != NULL; ptr = ptr->next) {
+            if (!_slab_contains(slab, ptr) ||
+                ((((uint8_t *)ptr) - slab->blocks) % slab->block_size) ||
+                (slab->refs[_slab_idx(slab, ptr)] != 0) ||
+                (++free_count > slab->numof)) {
+                return false;
+            }
+        }
+        for (unsigned j = 0; j < slab->numof; j++) {
+            if (slab->refs[j] > 0) {
+                used_count++;
+            }
+        }
+        if ((free_count != (unsigned)(slab->numof - slab->used)) ||
+            (used_count != slab->used)) {
+            return false;
+        }
+    }
+    return true;
+}
+#endif
+
+static gnrc_pktsnip_t *_create_snip(gnrc_pktsnip_t *next, const void *data, size_t size,
+                                    gnrc_nettype_t type)
+{
+    gnrc_pktsnip_t *pkt = _slab_alloc(_SLAB_SNIP);
+    void *_data = NULL;
+
+    if (pkt == NULL) {
+        DEBUG("pktbuf: error allocating new packet snip\n");
+        return NULL;
+    }
+    if (size > 0) {
+        _data = _pktbuf_alloc(size);
+        if (_data == NULL) {
+            DEBUG("pktbuf: error allocating data for new packet snip\n");
+            _pktbuf_free(pkt);
+            return NULL;
+        }
+        if (data != NULL) {
+            memcpy(_data, data, size);
+        }
+    }
+    _set_pktsnip(pkt, next, _data, size, type);
+    return pkt;
+}
+
+static void *_slab_alloc(unsigned cls)
+{
+    _slab_t *slab = &_slabs[cls];
+    _free_t *block = slab->free;
+
+    if (block == NULL) {
+        return NULL;
+    }
+    slab->free = block->next;
+    slab->refs[_slab_idx(slab, block)] = 1;
+    if (++slab->used > slab->max_used) {
+        slab->max_used = slab->used;
+    }
+    return block;
+}
+
+static void *_pktbuf_alloc(size_t size)
+{
+    /* take the smallest data class that fits, fall back to larger ones if it
+     * is exhausted */
+    for (unsigned i = _SLAB_HDR; i < _SLAB_NUMOF; i++) {
+        if (size <= _slabs[i].block_size) {
+            void *block = _slab_alloc(i);
+
+            if (block != NULL) {
+                return block;
+            }
+        }
+    }
+    DEBUG("pktbuf: no space left in packet buffer\n");
+    return NULL;
+}
+
+static void _pktbuf_free(void *data)
+{
+    _slab_t *slab;
+    unsigned idx;
+
+    if ((data == NULL) || ((slab = _slab_get(data)) == NULL)) {
+        return;
+    }
+    idx = _slab_idx(slab, data);
+    assert(slab->refs[idx] > 0);
+    if (--slab->refs[idx] == 0) {
+        _free_t *block = (_free_t *)&slab->blocks[idx * slab->block_size];
+
+        block->next = slab->free;
+        slab->free = block;
+        slab->used--;
+    }
+}
+
+/** @} */
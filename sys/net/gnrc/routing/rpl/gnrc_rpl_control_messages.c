@@ -36,6 +36,10 @@
 #include "net/gnrc/rpl.h"
 #include "gnrc_rpl_internal/validation.h"
 
+#ifdef MODULE_GNRC_RPL_SR_TABLE
+#include "net/gnrc/rpl/sr_table.h"
+#endif
+
 #ifdef MODULE_GNRC_RPL_P2P
 #include "net/gnrc/rpl/p2p_structs.h"
 #include "net/gnrc/rpl/p2p_dodag.h"
@@ -492,6 +496,97 @@ static inline uint32_t _sec_to_ms(uint32_t sec)
     }
 }
 
+/* checks if DAOs are sent to the root with the parent in the transit option
+ * instead of hop by hop */
+static inline bool _ns_source_routing(gnrc_rpl_instance_t *inst)
+{
+    return IS_USED(MODULE_GNRC_RPL_SOURCE_ROUTING) &&
+           (inst->mop == GNRC_RPL_MOP_NON_STORING_MODE);
+}
+
+#ifdef MODULE_GNRC_RPL_SR_TABLE
+static inline bool _is_sr_root(gnrc_rpl_instance_t *inst)
+{
+    return (inst->mop == GNRC_RPL_MOP_NON_STORING_MODE) &&
+           (inst->dodag.node_status == GNRC_RPL_ROOT_NODE);
+}
+
+/* checks if a parent address from a transit option is one of my addresses */
+static bool _is_sr_root_addr(gnrc_rpl_dodag_t *dodag, const ipv6_addr_t *addr)
+{
+    gnrc_netif_t *netif = gnrc_netif_get_by_pid(dodag->iface);
+    ipv6_addr_t ll_addr = *addr;
+
+    if (ipv6_addr_equal(addr, &dodag->dodag_id) ||
+        (gnrc_netif_get_by_ipv6_addr(addr) != NULL)) {
+        return true;
+    }
+    /* children derive the address from the interface identifier of my
+     * link-local address, which might not be part of a global address */
+    ipv6_addr_set_link_local_prefix(&ll_addr);
+    return (netif != NULL) && (gnrc_netif_ipv6_addr_idx(netif, &ll_addr) >= 0);
+}
+
+/* adds the targets preceding a transit option to the source routing table */
+static void _sr_table_update(gnrc_rpl_dodag_t *dodag, gnrc_rpl_opt_target_t *target,
+                             gnrc_rpl_opt_transit_t *transit)
+{
+    const ipv6_addr_t *parent = (ipv6_addr_t *)(transit + 1);
+    uint32_t lifetime = transit->path_lifetime * dodag->lifetime_unit;
+
+    if (transit->length < (GNRC_RPL_OPT_TRANSIT_INFO_LEN + sizeof(ipv6_addr_t))) {
+        DEBUG("RPL: RPL TRANSIT INFO DAO option without parent address\n");
+        return;
+    }
+    if (_is_sr_root_addr(dodag, parent)) {
+        /* targets are my children */
+        parent = NULL;
+    }
+    do {
+        /* source routes lead to nodes, not to prefixes */
+        if (target->prefix_length == IPV6_ADDR_BIT_LEN) {
+            DEBUG("RPL: updating source route to %s\n",
+                  ipv6_addr_to_str(addr_str, &target->target, sizeof(addr_str)));
+            if (lifetime == 0) {
+                gnrc_rpl_sr_table_del(&target->target);
+            }
+            else {
+                gnrc_rpl_sr_table_add(&target->target, parent, lifetime);
+            }
+            if (parent == NULL) {
+                /* my children are the first hop of all source routes, reach
+                 * them by their link-local address like in storing mode */
+                ipv6_addr_t next_hop = target->target;
+
+                ipv6_addr_set_link_local_prefix(&next_hop);
+                gnrc_ipv6_nib_ft_del(&target->target, IPV6_ADDR_BIT_LEN);
+                if (lifetime != 0) {
+                    gnrc_ipv6_nib_ft_add(&target->target, IPV6_ADDR_BIT_LEN, &next_hop,
+                                         dodag->iface, lifetime);
+                }
+            }
+        }
+        target = (gnrc_rpl_opt_target_t *) (((uint8_t *) (target)) +
+                 sizeof(gnrc_rpl_opt_t) + target->length);
+    }
+    while (target->type == GNRC_RPL_OPT_TARGET);
+}
+#else   /* MODULE_GNRC_RPL_SR_TABLE */
+static inline bool _is_sr_root(gnrc_rpl_instance_t *inst)
+{
+    (void)inst;
+    return false;
+}
+
+static inline void _sr_table_update(gnrc_rpl_dodag_t *dodag, gnrc_rpl_opt_target_t *target,
+                                    gnrc_rpl_opt_transit_t *transit)
+{
+    (void)dodag;
+    (void)target;
+    (void)transit;
+}
+#endif  /* MODULE_GNRC_RPL_SR_TABLE */
+
 /** @todo allow target prefixes in target options to be of variable length */
 bool _parse_options(int msg_type, gnrc_rpl_instance_t *inst, gnrc_rpl_opt_t *opt, uint16_t len,
                     ipv6_addr_t *src, uint32_t *included_opts)
@@ -615,6 +710,11 @@ bool _parse_options(int msg_type, gnrc_rpl_instance_t *inst, gnrc_rpl_opt_t *opt
                 if (first_target == NULL) {
                     first_target = target;
                 }
+                if (_is_sr_root(inst)) {
+                    /* the route is added with the parent from the transit
+                     * option */
+                    break;
+                }
 
                 DEBUG("RPL: adding FT entry %s/%d\n",
                       ipv6_addr_to_str(addr_str, &(target->target), (unsigned)sizeof(addr_str)),
@@ -635,6 +735,11 @@ bool _parse_options(int msg_type, gnrc_rpl_instance_t *inst, gnrc_rpl_opt_t *opt
                           "a preceding RPL TARGET DAO option\n");
                     break;
                 }
+                if (_is_sr_root(inst)) {
+                    _sr_table_update(dodag, first_target, transit);
+                    first_target = NULL;
+                    break;
+                }
 
                 do {
                     DEBUG("RPL: updating FT entry %s/%d\n",
@@ -933,11 +1038,14 @@ gnrc_pktsnip_t *_dao_target_build(gnrc_pktsnip_t *pkt, ipv6_addr_t *addr, uint8_
     return opt_snip;
 }
 
-gnrc_pktsnip_t *_dao_transit_build(gnrc_pktsnip_t *pkt, uint8_t lifetime, bool external)
+gnrc_pktsnip_t *_dao_transit_build(gnrc_pktsnip_t *pkt, uint8_t lifetime, bool external,
+                                   const ipv6_addr_t *parent)
 {
     gnrc_rpl_opt_transit_t *transit;
     gnrc_pktsnip_t *opt_snip;
-    if ((opt_snip = gnrc_pktbuf_add(pkt, NULL, sizeof(gnrc_rpl_opt_transit_t),
+    size_t parent_len = (parent != NULL) ? sizeof(ipv6_addr_t) : 0;
+
+    if ((opt_snip = gnrc_pktbuf_add(pkt, NULL, sizeof(gnrc_rpl_opt_transit_t) + parent_len,
                                GNRC_NETTYPE_UNDEF)) == NULL) {
         DEBUG("RPL: Send DAO - no space left in packet buffer\n");
         gnrc_pktbuf_release(pkt);
@@ -951,6 +1059,11 @@ gnrc_pktsnip_t *_dao_transit_build(gnrc_pktsnip_t *pkt, uint8_t lifetime, bool e
     transit->path_control = 0;
     transit->path_sequence = 0;
     transit->path_lifetime = lifetime;
+    if (parent != NULL) {
+        /* the parent address is only present in non-storing mode */
+        transit->length += parent_len;
+        memcpy(transit + 1, parent, parent_len);
+    }
     return opt_snip;
 }
 
@@ -981,7 +1094,10 @@ void gnrc_rpl_send_DAO(gnrc_rpl_instance_t *inst, ipv6_addr_t *destination, uint
             return;
         }
 
-        destination = &(dodag->parents->addr);
+        /* with source routing only the root keeps downward routes */
+        destination = _ns_source_routing(inst)
+                    ? &dodag->dodag_id
+                    : &(dodag->parents->addr);
     }
 
     gnrc_pktsnip_t *pkt = NULL, *tmp = NULL;
@@ -999,14 +1115,41 @@ void gnrc_rpl_send_DAO(gnrc_rpl_instance_t *inst, ipv6_addr_t *destination, uint
     idx = gnrc_netif_ipv6_addr_match(netif, &dodag->dodag_id);
     me = &netif->ipv6.addrs[idx];
 
+    if (_ns_source_routing(inst)) {
+        /* the root learns the route from the parent address, the parent
+         * shares the prefix of my address, see RFC 6550, section 9.7 */
+        ipv6_addr_t parent;
+
+        if (dodag->parents == NULL) {
+            DEBUG("RPL: dodag has no preferred parent\n");
+            return;
+        }
+        if (dodag->parents->rank == GNRC_RPL_ROOT_RANK) {
+            /* the root is known by its DODAG ID, its interface identifier
+             * may differ from the one of its link-local address */
+            parent = dodag->dodag_id;
+        }
+        else {
+            parent = dodag->parents->addr;
+            ipv6_addr_init_prefix(&parent, me, IPV6_ADDR_BIT_LEN / 2);
+        }
+        DEBUG("RPL: Send DAO - building transit option with parent %s\n",
+              ipv6_addr_to_str(addr_str, &parent, sizeof(addr_str)));
+        if ((pkt = _dao_transit_build(pkt, lifetime, false, &parent)) == NULL) {
+            DEBUG("RPL: Send DAO - no space left in packet buffer\n");
+            return;
+        }
+    }
+
     /* add external and RPL FT entries */
     /* TODO: nib: dropped support for external transit options for now */
     void *ft_state = NULL;
     gnrc_ipv6_nib_ft_t fte;
-    while(gnrc_ipv6_nib_ft_iter(NULL, dodag->iface, &ft_state, &fte)) {
+    while(!_ns_source_routing(inst) &&
+          gnrc_ipv6_nib_ft_iter(NULL, dodag->iface, &ft_state, &fte)) {
         DEBUG("RPL: Send DAO - building transit option\n");
 
-        if ((pkt = _dao_transit_build(pkt, lifetime, false)) == NULL) {
+        if ((pkt = _dao_transit_build(pkt, lifetime, false, NULL)) == NULL) {
             DEBUG("RPL: Send DAO - no space left in packet buffer\n");
             return;
         }
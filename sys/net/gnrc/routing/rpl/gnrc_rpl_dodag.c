@@ -182,6 +182,11 @@ void gnrc_rpl_dodag_remove_all_parents(gnrc_rpl_dodag_t *dodag)
         gnrc_rpl_parent_remove(elt);
     }
     dodag->my_rank = GNRC_RPL_INFINITE_RANK;
+    /* the objective function may keep state about the parents */
+    if ((dodag->instance != NULL) && (dodag->instance->of != NULL) &&
+        (dodag->instance->of->reset != NULL)) {
+        dodag->instance->of->reset(dodag);
+    }
 }
 
 bool gnrc_rpl_parent_add_by_addr(gnrc_rpl_dodag_t *dodag, ipv6_addr_t *addr,
@@ -0,0 +1,190 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gnrc_rpl
+ * @{
+ * @file
+ * @brief       Minimum Rank with Hysteresis Objective Function.
+ *
+ * Implementation of MRHOF with the ETX metric and no metric container, i.e.
+ * the path cost through a parent is its advertised rank plus the ETX of the
+ * link to it as estimated by @ref net_gnrc_netif_etx.
+ *
+ * @see <a href="https://tools.ietf.org/html/rfc6719">RFC 6719</a>
+ * @}
+ */
+
+#include <string.h>
+
+#include "net/gnrc/netif.h"
+#include "net/gnrc/netif/internal.h"
+#include "net/gnrc/rpl.h"
+#include "net/gnrc/rpl/structs.h"
+#include "of_mrhof.h"
+
+static uint16_t calc_rank(gnrc_rpl_dodag_t *, uint16_t);
+static int parent_cmp(gnrc_rpl_parent_t *, gnrc_rpl_parent_t *);
+static gnrc_rpl_dodag_t *which_dodag(gnrc_rpl_dodag_t *, gnrc_rpl_dodag_t *);
+static void reset(gnrc_rpl_dodag_t *);
+
+static gnrc_rpl_of_t gnrc_rpl_mrhof = {
+    .ocp          = GNRC_RPL_OCP_MRHOF,
+    .calc_rank    = calc_rank,
+    .parent_cmp   = parent_cmp,
+    .which_dodag  = which_dodag,
+    .reset        = reset,
+    .parent_state_callback = NULL,
+    .init         = NULL,
+    .process_dio  = NULL
+};
+
+/* preferred parent per instance. The head of the parent list can't be used
+ * for this in parent_cmp(), as it changes while the list is sorted */
+static ipv6_addr_t _preferred[GNRC_RPL_INSTANCES_NUMOF];
+
+gnrc_rpl_of_t *gnrc_rpl_get_of_mrhof(void)
+{
+    return &gnrc_rpl_mrhof;
+}
+
+static ipv6_addr_t *_preferred_addr(gnrc_rpl_dodag_t *dodag)
+{
+    return &_preferred[dodag->instance - gnrc_rpl_instances];
+}
+
+static uint16_t _link_metric(gnrc_rpl_parent_t *parent)
+{
+#if GNRC_NETIF_L2ADDR_MAXLEN > 0
+    gnrc_netif_t *netif = gnrc_netif_get_by_pid(parent->dodag->iface);
+    uint8_t l2addr[GNRC_NETIF_L2ADDR_MAXLEN];
+    int res;
+
+    /* parents are addressed by their link-local address, so their
+     * link-layer address follows from the IID */
+    if ((netif != NULL) && (netif->flags & GNRC_NETIF_FLAGS_HAS_L2ADDR) &&
+        ((res = gnrc_netif_ipv6_iid_to_addr(netif,
+                                            (eui64_t *)&parent->addr.u64[1],
+                                            l2addr)) > 0)) {
+        uint16_t etx = gnrc_netif_etx_get(netif, l2addr, res);
+
+        if (etx != GNRC_NETIF_ETX_UNKNOWN) {
+            return etx;
+        }
+    }
+#else
+    (void)parent;
+#endif
+    return CONFIG_GNRC_RPL_MRHOF_INIT_ETX;
+}
+
+static uint16_t _path_cost(gnrc_rpl_parent_t *parent)
+{
+    uint32_t cost = (uint32_t)parent->rank + _link_metric(parent);
+
+    if ((parent->rank == GNRC_RPL_INFINITE_RANK) ||
+        (cost > GNRC_RPL_INFINITE_RANK)) {
+        return GNRC_RPL_INFINITE_RANK;
+    }
+    return (uint16_t)cost;
+}
+
+void reset(gnrc_rpl_dodag_t *dodag)
+{
+    ipv6_addr_set_unspecified(_preferred_addr(dodag));
+}
+
+uint16_t calc_rank(gnrc_rpl_dodag_t *dodag, uint16_t base_rank)
+{
+    gnrc_rpl_parent_t *parent = dodag->parents;
+    uint16_t add, min_hop_rank_inc;
+    uint32_t rank;
+
+    if (base_rank == 0) {
+        if (parent == NULL) {
+            return GNRC_RPL_INFINITE_RANK;
+        }
+        base_rank = parent->rank;
+    }
+    if (base_rank == GNRC_RPL_INFINITE_RANK) {
+        return GNRC_RPL_INFINITE_RANK;
+    }
+
+    if (parent != NULL) {
+        add = _link_metric(parent);
+        min_hop_rank_inc = dodag->instance->min_hop_rank_inc;
+    }
+    else {
+        add = CONFIG_GNRC_RPL_MRHOF_INIT_ETX;
+        min_hop_rank_inc = CONFIG_GNRC_RPL_DEFAULT_MIN_HOP_RANK_INCREASE;
+    }
+
+    /* the rank is the path cost, but at least MinHopRankIncrease more than
+     * that of the parent (see RFC 6719, section 3.3) */
+    rank = (uint32_t)base_rank + add;
+    if (rank < ((uint32_t)base_rank + min_hop_rank_inc)) {
+        rank = (uint32_t)base_rank + min_hop_rank_inc;
+    }
+    if (rank >= GNRC_RPL_INFINITE_RANK) {
+        return GNRC_RPL_INFINITE_RANK;
+    }
+
+    if (parent == NULL) {
+        return (uint16_t)rank;
+    }
+    /* keep the rank if only the link to the same parent changed slightly */
+    if (ipv6_addr_equal(&parent->addr, _preferred_addr(dodag)) &&
+        (dodag->my_rank != GNRC_RPL_INFINITE_RANK) &&
+        (dodag->my_rank >= ((uint32_t)base_rank + min_hop_rank_inc))) {
+        uint32_t diff = (rank > dodag->my_rank) ? (rank - dodag->my_rank)
+                                                : (dodag->my_rank - rank);
+
+        if (diff < CONFIG_GNRC_RPL_MRHOF_PARENT_SWITCH_THRESHOLD) {
+            rank = dodag->my_rank;
+        }
+    }
+    /* called after the parent list was sorted, so this is the new
+     * preferred parent */
+    memcpy(_preferred_addr(dodag), &parent->addr, sizeof(parent->addr));
+    return (uint16_t)rank;
+}
+
+/* path cost with the bonus of the preferred parent */
+static uint16_t _cmp_cost(gnrc_rpl_parent_t *parent)
+{
+    uint16_t cost = _path_cost(parent);
+
+    if ((cost != GNRC_RPL_INFINITE_RANK) &&
+        ipv6_addr_equal(&parent->addr, _preferred_addr(parent->dodag))) {
+        cost = (cost > CONFIG_GNRC_RPL_MRHOF_PARENT_SWITCH_THRESHOLD)
+             ? (cost - CONFIG_GNRC_RPL_MRHOF_PARENT_SWITCH_THRESHOLD)
+             : 0;
+    }
+    return cost;
+}
+
+int parent_cmp(gnrc_rpl_parent_t *parent1, gnrc_rpl_parent_t *parent2)
+{
+    uint16_t cost1 = _cmp_cost(parent1);
+    uint16_t cost2 = _cmp_cost(parent2);
+
+    if (cost1 < cost2) {
+        return -1;
+    }
+    else if (cost1 > cost2) {
+        return 1;
+    }
+    return 0;
+}
+
+/* Not used yet */
+gnrc_rpl_dodag_t *which_dodag(gnrc_rpl_dodag_t *d1, gnrc_rpl_dodag_t *d2)
+{
+    (void) d2;
+    return d1;
+}
@@ -0,0 +1,429 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+
+#include <assert.h>
+#include <errno.h>
+#include <string.h>
+
+#include "bitfield.h"
+#include "kernel_defines.h"
+#include "mutex.h"
+#include "net/gnrc/nettype.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/ipv6/ext/rh.h"
+#include "net/ipv6/hdr.h"
+#include "net/protnum.h"
+#include "xtimer.h"
+
+#include "net/gnrc/rpl/sr_table.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+/* parent of the children of the root */
+#define _ROOT               (UINT16_MAX)
+/* parent of nodes only known as parent so far */
+#define _UNKNOWN            (UINT16_MAX - 1)
+/* parent of free entries */
+#define _FREE               (UINT16_MAX - 2)
+
+/* an address can only be elided partially, see RFC 6554, section 3 */
+#define _COMPR_MAX          (15U)
+#define _HASH_SIZE          (2 * CONFIG_GNRC_RPL_SR_TABLE_SIZE)
+
+typedef struct {
+    ipv6_addr_t addr;
+    /**
+     * @brief   Time in seconds when the route expires or, for free entries,
+     *          the index of the next free entry plus one
+     */
+    uint32_t expires;
+    uint16_t parent;    /**< index of the entry of the parent */
+} _entry_t;
+
+static_assert(CONFIG_GNRC_RPL_SR_TABLE_SIZE < _FREE,
+              "CONFIG_GNRC_RPL_SR_TABLE_SIZE too large");
+
+static mutex_t _mutex = MUTEX_INIT;
+static _entry_t _entries[CONFIG_GNRC_RPL_SR_TABLE_SIZE];
+/* open addressing with linear probing, holds the index of an entry plus one
+ * so zero-initialization makes it empty */
+static uint16_t _hash[_HASH_SIZE];
+static BITFIELD(_referenced, CONFIG_GNRC_RPL_SR_TABLE_SIZE);
+/* entries [0, _entries_numof) were used at some point */
+static uint16_t _entries_numof;
+/* index plus one of the first free entry below _entries_numof */
+static uint16_t _free;
+/* index plus one of the parent resolved last, consecutive targets of a
+ * transit option share the parent */
+static uint16_t _last_parent;
+
+static inline uint32_t _now(void)
+{
+    return (uint32_t)(xtimer_now_usec64() / US_PER_SEC);
+}
+
+static inline bool _expired(const _entry_t *entry, uint32_t now)
+{
+    return ((int32_t)(entry->expires - now)) <= 0;
+}
+
+static unsigned _bucket(const ipv6_addr_t *addr)
+{
+    uint32_t h = addr->u32[0].u32 ^ addr->u32[1].u32 ^ addr->u32[2].u32 ^
+                 addr->u32[3].u32;
+
+    h = (h ^ (h >> 16)) * 0x45d9f3bU;
+    h ^= h >> 16;
+    return h % _HASH_SIZE;
+}
+
+/* returns the slot in _hash of addr or of the empty slot it belongs in */
+static unsigned _slot(const ipv6_addr_t *addr)
+{
+    unsigned slot = _bucket(addr);
+
+    /* the table never fills _hash more than halfway */
+    while ((_hash[slot] != 0) &&
+           !ipv6_addr_equal(&_entries[_hash[slot] - 1].addr, addr)) {
+        slot = (slot + 1) % _HASH_SIZE;
+    }
+    return slot;
+}
+
+static uint16_t _find(const ipv6_addr_t *addr)
+{
+    unsigned slot = _slot(addr);
+
+    return (_hash[slot] == 0) ? _FREE : (_hash[slot] - 1);
+}
+
+static void _hash_del(unsigned slot)
+{
+    unsigned i = slot;
+
+    /* move entries forward that would not be found past the emptied slot */
+    for (unsigned j = (slot + 1) % _HASH_SIZE; _hash[j] != 0;
+         j = (j + 1) % _HASH_SIZE) {
+        unsigned k = _bucket(&_entries[_hash[j] - 1].addr);
+
+        if ((i <= j) ? ((i < k) && (k <= j)) : ((i < k) || (k <= j))) {
+            continue;
+        }
+        _hash[i] = _hash[j];
+        i = j;
+    }
+    _hash[i] = 0;
+}
+
+/* frees expired entries no other entry points to */
+static void _purge(uint32_t now)
+{
+    memset(_referenced, 0, sizeof(_referenced));
+    for (unsigned i = 0; i < _entries_numof; i++) {
+        if (_entries[i].parent < _FREE) {
+            bf_set(_referenced, _entries[i].parent);
+        }
+    }
+    for (unsigned i = 0; i < _entries_numof; i++) {
+        _entry_t *entry = &_entries[i];
+
+        if ((entry->parent != _FREE) && !bf_isset(_referenced, i) &&
+            _expired(entry, now)) {
+            _hash_del(_slot(&entry->addr));
+            entry->parent = _FREE;
+            entry->expires = _free;
+            _free = i + 1;
+        }
+    }
+    _last_parent = 0;
+}
+
+static uint16_t _alloc(const ipv6_addr_t *addr, uint32_t now)
+{
+    uint16_t idx;
+
+    if ((_free == 0) && (_entries_numof == CONFIG_GNRC_RPL_SR_TABLE_SIZE)) {
+        _purge(now);
+    }
+    if (_free != 0) {
+        idx = _free - 1;
+        _free = _entries[idx].expires;
+    }
+    else if (_entries_numof < CONFIG_GNRC_RPL_SR_TABLE_SIZE) {
+        idx = _entries_numof++;
+    }
+    else {
+        return _FREE;
+    }
+    _entries[idx].addr = *addr;
+    _entries[idx].parent = _UNKNOWN;
+    _entries[idx].expires = now;
+    _hash[_slot(addr)] = idx + 1;
+    return idx;
+}
+
+/* returns the path from dst up to the child of the root */
+static int _path(const ipv6_addr_t *dst, uint16_t *path, unsigned max_hops)
+{
+    uint32_t now = _now();
+    uint16_t idx = _find(dst);
+    unsigned hops = 0;
+
+    if (idx == _FREE) {
+        return -ENOENT;
+    }
+    while (idx != _ROOT) {
+        if ((idx == _UNKNOWN) || _expired(&_entries[idx], now)) {
+            return -ENOENT;
+        }
+        if (hops == max_hops) {
+            return -ENOBUFS;
+        }
+        path[hops++] = idx;
+        idx = _entries[idx].parent;
+    }
+    return hops;
+}
+
+static unsigned _common_prefix(const ipv6_addr_t *a, const ipv6_addr_t *b)
+{
+    unsigned len = 0;
+
+    while ((len < _COMPR_MAX) && (a->u8[len] == b->u8[len])) {
+        len++;
+    }
+    return len;
+}
+
+/* the addresses after the first hop are elided against the destination
+ * field of the IPv6 header, i.e. against the previous hop, see RFC 6554,
+ * section 4.2; eliding against the first hop covers all of them */
+static size_t _srh_size(const uint16_t *path, unsigned hops, uint8_t *compr)
+{
+    const ipv6_addr_t *first = &_entries[path[hops - 1]].addr;
+    const ipv6_addr_t *dst = &_entries[path[0]].addr;
+    unsigned compri = (hops > 2) ? _COMPR_MAX : 0;
+    unsigned compre = _common_prefix(dst, first);
+    size_t size;
+
+    for (unsigned i = 1; i < (hops - 1); i++) {
+        unsigned len = _common_prefix(&_entries[path[i]].addr, first);
+
+        if (len < compri) {
+            compri = len;
+        }
+    }
+    if (hops > 2) {
+        unsigned len = _common_prefix(dst, &_entries[path[1]].addr);
+
+        if (len < compre) {
+            compre = len;
+        }
+    }
+    *compr = (compri << 4) | compre;
+    size = sizeof(gnrc_rpl_srh_t) + ((hops - 2) * (sizeof(ipv6_addr_t) - compri)) +
+           (sizeof(ipv6_addr_t) - compre);
+    return (size + 7) & ~7U;
+}
+
+static void _srh_write(const uint16_t *path, unsigned hops, uint8_t compr,
+                       size_t size, gnrc_rpl_srh_t *srh)
+{
+    unsigned compri = compr >> 4, compre = compr & 0x0f;
+    uint8_t *addr_vec = (uint8_t *)(srh + 1);
+    size_t addrs_len = ((hops - 2) * (sizeof(ipv6_addr_t) - compri)) +
+                       (sizeof(ipv6_addr_t) - compre);
+    unsigned pad = size - sizeof(gnrc_rpl_srh_t) - addrs_len;
+
+    srh->len = (size - 8) / 8;
+    srh->type = IPV6_EXT_RH_TYPE_RPL_SRH;
+    srh->seg_left = hops - 1;
+    srh->compr = compr;
+    srh->pad_resv = pad << 4;
+    srh->resv = 0;
+    for (unsigned i = hops - 2; i > 0; i--) {
+        memcpy(addr_vec, &_entries[path[i]].addr.u8[compri],
+               sizeof(ipv6_addr_t) - compri);
+        addr_vec += sizeof(ipv6_addr_t) - compri;
+    }
+    memcpy(addr_vec, &_entries[path[0]].addr.u8[compre],
+           sizeof(ipv6_addr_t) - compre);
+    memset(addr_vec + sizeof(ipv6_addr_t) - compre, 0, pad);
+}
+
+int gnrc_rpl_sr_table_add(const ipv6_addr_t *target, const ipv6_addr_t *parent,
+                          uint32_t lifetime)
+{
+    uint32_t now = _now();
+    uint16_t t_idx, p_idx = _ROOT;
+    int res = 0;
+
+    mutex_lock(&_mutex);
+    if ((t_idx = _find(target)) == _FREE) {
+        if ((t_idx = _alloc(target, now)) == _FREE) {
+            DEBUG("RPL SR table: table full\n");
+            res = -ENOMEM;
+            goto out;
+        }
+    }
+    /* refresh first, so making room for the parent can not free the entry */
+    _entries[t_idx].expires = now + lifetime;
+    if (parent != NULL) {
+        if ((_last_parent != 0) &&
+            ipv6_addr_equal(&_entries[_last_parent - 1].addr, parent)) {
+            p_idx = _last_parent - 1;
+        }
+        else if ((p_idx = _find(parent)) == _FREE) {
+            if ((p_idx = _alloc(parent, now)) == _FREE) {
+                DEBUG("RPL SR table: table full\n");
+                res = -ENOMEM;
+                goto out;
+            }
+        }
+        _last_parent = p_idx + 1;
+        /* the parent is only known as such, keep it as long as its child */
+        if ((_entries[p_idx].parent == _UNKNOWN) &&
+            ((int32_t)(_entries[p_idx].expires - (now + lifetime)) < 0)) {
+            _entries[p_idx].expires = now + lifetime;
+        }
+        for (uint16_t idx = p_idx; idx < _FREE; idx = _entries[idx].parent) {
+            if (idx == t_idx) {
+                DEBUG("RPL SR table: route would contain a loop\n");
+                res = -EINVAL;
+                goto out;
+            }
+        }
+    }
+    _entries[t_idx].parent = p_idx;
+out:
+    mutex_unlock(&_mutex);
+    return res;
+}
+
+void gnrc_rpl_sr_table_del(const ipv6_addr_t *target)
+{
+    uint16_t idx;
+
+    mutex_lock(&_mutex);
+    /* descendants may still point to the entry, it is freed with the next
+     * purge when they are gone */
+    if ((idx = _find(target)) != _FREE) {
+        _entries[idx].expires = _now();
+    }
+    mutex_unlock(&_mutex);
+}
+
+void gnrc_rpl_sr_table_reset(void)
+{
+    mutex_lock(&_mutex);
+    memset(_hash, 0, sizeof(_hash));
+    _entries_numof = 0;
+    _free = 0;
+    _last_parent = 0;
+    mutex_unlock(&_mutex);
+}
+
+int gnrc_rpl_sr_table_get_route(const ipv6_addr_t *dst, ipv6_addr_t *hops,
+                                unsigned max_hops)
+{
+    uint16_t path[CONFIG_GNRC_RPL_SR_TABLE_MAX_HOPS];
+    int res;
+
+    if (max_hops > CONFIG_GNRC_RPL_SR_TABLE_MAX_HOPS) {
+        max_hops = CONFIG_GNRC_RPL_SR_TABLE_MAX_HOPS;
+    }
+    mutex_lock(&_mutex);
+    res = _path(dst, path, max_hops);
+    for (int i = 0; i < res; i++) {
+        hops[i] = _entries[path[res - i - 1]].addr;
+    }
+    mutex_unlock(&_mutex);
+    return res;
+}
+
+int gnrc_rpl_sr_table_build_srh(const ipv6_addr_t *dst, gnrc_rpl_srh_t *srh,
+                                size_t srh_len, ipv6_addr_t *first_hop)
+{
+    uint16_t path[CONFIG_GNRC_RPL_SR_TABLE_MAX_HOPS];
+    uint8_t compr;
+    size_t size;
+    int res;
+
+    mutex_lock(&_mutex);
+    if ((res = _path(dst, path, ARRAY_SIZE(path))) <= 0) {
+        goto out;
+    }
+    *first_hop = _entries[path[res - 1]].addr;
+    if (res == 1) {
+        res = 0;
+        goto out;
+    }
+    if ((size = _srh_size(path, res, &compr)) > srh_len) {
+        res = -ENOBUFS;
+        goto out;
+    }
+    _srh_write(path, res, compr, size, srh);
+    res = size;
+out:
+    mutex_unlock(&_mutex);
+    return res;
+}
+
+int gnrc_rpl_sr_table_insert_srh(gnrc_pktsnip_t *ipv6, ipv6_addr_t *first_hop)
+{
+    ipv6_hdr_t *hdr = ipv6->data;
+    uint16_t path[CONFIG_GNRC_RPL_SR_TABLE_MAX_HOPS];
+    gnrc_pktsnip_t *srh;
+    gnrc_rpl_srh_t *rh;
+    uint8_t compr;
+    size_t size;
+    int hops, res = 0;
+
+    if (hdr->nh == PROTNUM_IPV6_EXT_RH) {
+        /* already source routed */
+        return 0;
+    }
+    mutex_lock(&_mutex);
+    /* without a route here the packet is left to the NIB */
+    if ((hops = _path(&hdr->dst, path, ARRAY_SIZE(path))) <= 1) {
+        goto out;
+    }
+    size = _srh_size(path, hops, &compr);
+    if ((srh = gnrc_pktbuf_add(ipv6->next, NULL, size,
+                               GNRC_NETTYPE_IPV6_EXT)) == NULL) {
+        DEBUG("RPL SR table: no space left in packet buffer\n");
+        res = -ENOMEM;
+        goto out;
+    }
+    rh = srh->data;
+    _srh_write(path, hops, compr, size, rh);
+    if (hdr->nh != PROTNUM_RESERVED) {
+        rh->nh = hdr->nh;
+    }
+    else if ((ipv6->next == NULL) ||
+             ((rh->nh = gnrc_nettype_to_protnum(ipv6->next->type)) ==
+              PROTNUM_RESERVED)) {
+        rh->nh = PROTNUM_IPV6_NONXT;
+    }
+    hdr->nh = PROTNUM_IPV6_EXT_RH;
+    ipv6->next = srh;
+    *first_hop = _entries[path[hops - 1]].addr;
+    res = 1;
+out:
+    mutex_unlock(&_mutex);
+    return res;
+}
+
+/** @} */
@@ -34,6 +34,10 @@
 #endif
 #include "net/sock/ip.h"
 #include "net/sock/udp.h"
+#ifdef MODULE_GNRC_SOCK_TCP
+#include "net/gnrc/tcp.h"
+#include "net/sock/tcp.h"
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -136,6 +140,48 @@ struct sock_udp {
     uint16_t flags;                        /**< option flags */
 };
 
+#ifdef MODULE_GNRC_SOCK_TCP
+/**
+ * @brief   TCP sock type
+ * @internal
+ */
+struct sock_tcp {
+    gnrc_tcp_tcb_t tcb;                    /**< TCB of the connection */
+    /**
+     * @brief   Listening queue the sock belongs to, NULL if connected with
+     *          sock_tcp_connect()
+     */
+    struct sock_tcp_queue *queue;
+    uint8_t flags;                         /**< state within the queue */
+#ifdef SOCK_HAS_ASYNC
+    sock_tcp_cb_t async_cb;                /**< asynchronous callback */
+    void *async_cb_arg;                    /**< asynchronous callback argument */
+#ifdef SOCK_HAS_ASYNC_CTX
+    sock_async_ctx_t async_ctx;            /**< asynchronous event context */
+#endif
+#endif  /* SOCK_HAS_ASYNC */
+};
+
+/**
+ * @brief   TCP queue type
+ * @internal
+ */
+struct sock_tcp_queue {
+    mbox_t mbox;                           /**< wakes sock_tcp_accept() up */
+    msg_t mbox_queue[GNRC_SOCK_MBOX_SIZE]; /**< queue for sock_tcp_queue::mbox */
+    sock_tcp_ep_t local;                   /**< local end-point */
+    struct sock_tcp *array;                /**< listening socks */
+    unsigned len;                          /**< length of sock_tcp_queue::array */
+#ifdef SOCK_HAS_ASYNC
+    sock_tcp_queue_cb_t async_cb;          /**< asynchronous callback */
+    void *async_cb_arg;                    /**< asynchronous callback argument */
+#ifdef SOCK_HAS_ASYNC_CTX
+    sock_async_ctx_t async_ctx;            /**< asynchronous event context */
+#endif
+#endif  /* SOCK_HAS_ASYNC */
+};
+#endif  /* MODULE_GNRC_SOCK_TCP */
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,375 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ * @brief       GNRC implementation of @ref net_sock_tcp
+ *
+ * The socks of a listening queue are TCBs opened by gnrc_tcp_listen(): the
+ * TCP thread establishes their connections in the background and
+ * sock_tcp_accept() hands them out one by one.
+ */
+
+#include <assert.h>
+#include <errno.h>
+#include <string.h>
+
+#include "irq.h"
+#include "net/af.h"
+#include "net/gnrc/tcp.h"
+#include "net/sock/tcp.h"
+#include "xtimer.h"
+
+#include "gnrc_sock_internal.h"
+
+#define _ACCEPT_MSG_TYPE    (0x8475)
+#define _TIMEOUT_MSG_TYPE   (0x8474)
+#define _TIMEOUT_MAGIC      (0xF38A0B63U)
+
+/**
+ * @brief   Timeout of a single gnrc_tcp_recv() call when reading without
+ *          timeout
+ *
+ * gnrc_tcp_recv() aborts the connection if nothing is received within
+ * @ref CONFIG_GNRC_TCP_CONNECTION_TIMEOUT_DURATION.
+ */
+#define _RECV_TIMEOUT       (CONFIG_GNRC_TCP_CONNECTION_TIMEOUT_DURATION / 2)
+
+/**
+ * @name    States of the socks of a listening queue
+ * @{
+ */
+#define _SOCK_PENDING       (0x01)  /**< connected, not accepted yet */
+#define _SOCK_ACCEPTED      (0x02)  /**< handed out by sock_tcp_accept() */
+#define _SOCK_RECYCLE       (0x04)  /**< closed before it was accepted */
+/** @} */
+
+static void _tcb_cb(gnrc_tcp_tcb_t *tcb, unsigned events, void *arg)
+{
+    sock_tcp_t *sock = arg;
+    sock_tcp_queue_t *queue = sock->queue;
+    unsigned state;
+
+    (void)tcb;
+    state = irq_disable();
+    if ((queue != NULL) && !(sock->flags & _SOCK_ACCEPTED)) {
+        if (events & GNRC_TCP_EVENT_CONNECTED) {
+            sock->flags |= _SOCK_PENDING;
+        }
+        if (events & GNRC_TCP_EVENT_CLOSED) {
+            /* the sock listens again once sock_tcp_accept() recycled it */
+            sock->flags = _SOCK_RECYCLE;
+        }
+        irq_restore(state);
+        if (events & GNRC_TCP_EVENT_CONNECTED) {
+            msg_t msg = { .type = _ACCEPT_MSG_TYPE };
+
+            /* if the mbox is full sock_tcp_accept() is woken up anyway */
+            mbox_try_put(&queue->mbox, &msg);
+#ifdef SOCK_HAS_ASYNC
+            if (queue->async_cb != NULL) {
+                queue->async_cb(queue, SOCK_ASYNC_CONN_RECV,
+                                queue->async_cb_arg);
+            }
+#endif  /* SOCK_HAS_ASYNC */
+        }
+        return;
+    }
+    irq_restore(state);
+#ifdef SOCK_HAS_ASYNC
+    if (sock->async_cb != NULL) {
+        sock_async_flags_t flags = 0;
+
+        if (events & GNRC_TCP_EVENT_CONNECTED) {
+            flags |= SOCK_ASYNC_CONN_RDY;
+        }
+        if (events & GNRC_TCP_EVENT_RECV) {
+            flags |= SOCK_ASYNC_MSG_RECV;
+        }
+        if (events & GNRC_TCP_EVENT_SENT) {
+            flags |= SOCK_ASYNC_MSG_SENT;
+        }
+        if (events & GNRC_TCP_EVENT_CLOSED) {
+            flags |= SOCK_ASYNC_CONN_FIN;
+        }
+        if (flags) {
+            sock->async_cb(sock, flags, sock->async_cb_arg);
+        }
+    }
+#endif  /* SOCK_HAS_ASYNC */
+}
+
+#ifdef MODULE_XTIMER
+static void _callback_put(void *arg)
+{
+    msg_t timeout_msg = { .sender_pid = KERNEL_PID_UNDEF,
+                          .type = _TIMEOUT_MSG_TYPE,
+                          .content = { .value = _TIMEOUT_MAGIC } };
+    sock_tcp_queue_t *queue = arg;
+
+    mbox_try_put(&queue->mbox, &timeout_msg);
+}
+#endif
+
+static void _sock_init(sock_tcp_t *sock, sock_tcp_queue_t *queue)
+{
+    gnrc_tcp_tcb_init(&sock->tcb);
+    sock->queue = queue;
+    sock->flags = 0;
+#ifdef SOCK_HAS_ASYNC
+    sock->async_cb = NULL;
+#endif
+    gnrc_tcp_set_cb(&sock->tcb, _tcb_cb, sock);
+}
+
+static int _ep_init(gnrc_tcp_ep_t *ep, const sock_tcp_ep_t *sock_ep)
+{
+    return gnrc_tcp_ep_init(ep, sock_ep->family, sock_ep->addr.ipv6,
+                            sizeof(sock_ep->addr.ipv6), sock_ep->port,
+                            sock_ep->netif);
+}
+
+static void _get_ep(const gnrc_tcp_tcb_t *tcb, sock_tcp_ep_t *ep, bool local)
+{
+    memset(ep, 0, sizeof(*ep));
+    ep->family = AF_INET6;
+    memcpy(&ep->addr.ipv6, (local) ? tcb->local_addr : tcb->peer_addr,
+           sizeof(ep->addr.ipv6));
+    ep->netif = (tcb->ll_iface > 0) ? (uint16_t)tcb->ll_iface
+                                    : SOCK_ADDR_ANY_NETIF;
+    ep->port = (local) ? tcb->local_port : tcb->peer_port;
+}
+
+/**
+ * @brief   Takes a connected sock from the queue and recycles those closed
+ *          before they were accepted
+ */
+static sock_tcp_t *_get_pending(sock_tcp_queue_t *queue)
+{
+    for (unsigned i = 0; i < queue->len; i++) {
+        sock_tcp_t *sock = &queue->array[i];
+        unsigned state = irq_disable();
+        uint8_t flags = sock->flags;
+
+        if (flags & _SOCK_PENDING) {
+            sock->flags = _SOCK_ACCEPTED;
+        }
+        else if (flags & _SOCK_RECYCLE) {
+            sock->flags = 0;
+        }
+        irq_restore(state);
+        if (flags & _SOCK_PENDING) {
+            return sock;
+        }
+        if (flags & _SOCK_RECYCLE) {
+            gnrc_tcp_close(&sock->tcb);
+        }
+    }
+    return NULL;
+}
+
+int sock_tcp_connect(sock_tcp_t *sock, const sock_tcp_ep_t *remote,
+                     uint16_t local_port, uint16_t flags)
+{
+    gnrc_tcp_ep_t ep;
+    int res;
+
+    assert((sock != NULL) && (remote != NULL) && (remote->port != 0));
+    (void)flags;
+    if (gnrc_af_not_supported(remote->family)) {
+        return -EAFNOSUPPORT;
+    }
+    if ((res = _ep_init(&ep, remote)) < 0) {
+        return res;
+    }
+    _sock_init(sock, NULL);
+    return gnrc_tcp_open_active(&sock->tcb, &ep, local_port);
+}
+
+int sock_tcp_listen(sock_tcp_queue_t *queue, const sock_tcp_ep_t *local,
+                    sock_tcp_t *queue_array, unsigned queue_len,
+                    uint16_t flags)
+{
+    gnrc_tcp_ep_t ep;
+    int res;
+
+    assert((queue != NULL) && (local != NULL) && (local->port != 0));
+    assert((queue_array != NULL) && (queue_len != 0));
+    (void)flags;
+    if (gnrc_af_not_supported(local->family)) {
+        return -EAFNOSUPPORT;
+    }
+    if ((res = _ep_init(&ep, local)) < 0) {
+        return res;
+    }
+    mbox_init(&queue->mbox, queue->mbox_queue, GNRC_SOCK_MBOX_SIZE);
+    memcpy(&queue->local, local, sizeof(queue->local));
+    queue->array = queue_array;
+    queue->len = 0;
+#ifdef SOCK_HAS_ASYNC
+    queue->async_cb = NULL;
+#endif
+    for (unsigned i = 0; i < queue_len; i++) {
+        _sock_init(&queue_array[i], queue);
+        if ((res = gnrc_tcp_listen(&queue_array[i].tcb, &ep)) < 0) {
+            sock_tcp_stop_listen(queue);
+            return res;
+        }
+        queue->len++;
+    }
+    return 0;
+}
+
+void sock_tcp_disconnect(sock_tcp_t *sock)
+{
+    assert(sock != NULL);
+    if (sock->queue != NULL) {
+        unsigned state = irq_disable();
+
+        sock->flags = 0;
+        irq_restore(state);
+    }
+    /* TCBs of a listening queue listen again once closed */
+    gnrc_tcp_close(&sock->tcb);
+}
+
+void sock_tcp_stop_listen(sock_tcp_queue_t *queue)
+{
+    assert(queue != NULL);
+    for (unsigned i = 0; i < queue->len; i++) {
+        gnrc_tcp_abort(&queue->array[i].tcb);
+    }
+    queue->len = 0;
+}
+
+int sock_tcp_get_local(sock_tcp_t *sock, sock_tcp_ep_t *ep)
+{
+    assert((sock != NULL) && (ep != NULL));
+    if (sock->tcb.local_port == 0) {
+        return -EADDRNOTAVAIL;
+    }
+    _get_ep(&sock->tcb, ep, true);
+    return 0;
+}
+
+int sock_tcp_get_remote(sock_tcp_t *sock, sock_tcp_ep_t *ep)
+{
+    assert((sock != NULL) && (ep != NULL));
+    if (sock->tcb.peer_port == 0) {
+        return -ENOTCONN;
+    }
+    _get_ep(&sock->tcb, ep, false);
+    return 0;
+}
+
+int sock_tcp_queue_get_local(sock_tcp_queue_t *queue, sock_tcp_ep_t *ep)
+{
+    assert((queue != NULL) && (ep != NULL));
+    if (queue->len == 0) {
+        return -EADDRNOTAVAIL;
+    }
+    memcpy(ep, &queue->local, sizeof(*ep));
+    return 0;
+}
+
+int sock_tcp_accept(sock_tcp_queue_t *queue, sock_tcp_t **sock,
+                    uint32_t timeout)
+{
+    msg_t msg;
+    int res = 0;
+
+    assert((queue != NULL) && (sock != NULL));
+    if (queue->len == 0) {
+        return -EINVAL;
+    }
+    if ((*sock = _get_pending(queue)) != NULL) {
+        return 0;
+    }
+    if (timeout == 0) {
+        return -EAGAIN;
+    }
+#ifdef MODULE_XTIMER
+    xtimer_t timeout_timer;
+
+    if (timeout != SOCK_NO_TIMEOUT) {
+        timeout_timer.callback = _callback_put;
+        timeout_timer.arg = queue;
+        xtimer_set(&timeout_timer, timeout);
+    }
+#endif
+    /* every connection wakes the queue up, the sock might have been taken by
+     * a concurrent call already */
+    while ((*sock = _get_pending(queue)) == NULL) {
+        mbox_get(&queue->mbox, &msg);
+        if ((msg.type == _TIMEOUT_MSG_TYPE) &&
+            (msg.content.value == _TIMEOUT_MAGIC)) {
+            res = -ETIMEDOUT;
+            break;
+        }
+    }
+#ifdef MODULE_XTIMER
+    if (timeout != SOCK_NO_TIMEOUT) {
+        xtimer_remove(&timeout_timer);
+    }
+#endif
+    return res;
+}
+
+ssize_t sock_tcp_read(sock_tcp_t *sock, void *data, size_t max_len,
+                      uint32_t timeout)
+{
+    ssize_t res;
+
+    assert((sock != NULL) && (data != NULL) && (max_len > 0));
+    if (timeout != SOCK_NO_TIMEOUT) {
+        return gnrc_tcp_recv(&sock->tcb, data, max_len, timeout);
+    }
+    /* a connection without any traffic is aborted by gnrc_tcp_recv() after
+     * the connection timeout, waiting for data keeps it open */
+    while ((res = gnrc_tcp_recv(&sock->tcb, data, max_len,
+                                _RECV_TIMEOUT)) == -ETIMEDOUT) {}
+    return res;
+}
+
+ssize_t sock_tcp_write(sock_tcp_t *sock, const void *data, size_t len)
+{
+    assert(sock != NULL);
+    assert((len == 0) || (data != NULL)); /* (len != 0) => (data != NULL) */
+    return gnrc_tcp_send(&sock->tcb, data, len, 0);
+}
+
+#ifdef SOCK_HAS_ASYNC
+void sock_tcp_set_cb(sock_tcp_t *sock, sock_tcp_cb_t cb, void *arg)
+{
+    sock->async_cb_arg = arg;
+    sock->async_cb = cb;
+}
+
+void sock_tcp_queue_set_cb(sock_tcp_queue_t *queue, sock_tcp_queue_cb_t cb,
+                           void *arg)
+{
+    queue->async_cb_arg = arg;
+    queue->async_cb = cb;
+}
+
+#ifdef SOCK_HAS_ASYNC_CTX
+sock_async_ctx_t *sock_tcp_get_async_ctx(sock_tcp_t *sock)
+{
+    return &sock->async_ctx;
+}
+
+sock_async_ctx_t *sock_tcp_queue_get_async_ctx(sock_tcp_queue_t *queue)
+{
+    return &queue->async_ctx;
+}
+#endif  /* SOCK_HAS_ASYNC_CTX */
+#endif  /* SOCK_HAS_ASYNC */
+
+/** @} */
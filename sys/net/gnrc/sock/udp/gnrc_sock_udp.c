@@ -19,6 +19,7 @@
 #include <string.h>
 
 #include "byteorder.h"
+#include "iolist.h"
 #include "net/af.h"
 #include "net/protnum.h"
 #include "net/gnrc/ipv6.h"
@@ -241,19 +242,37 @@ ssize_t sock_udp_recv_buf(sock_udp_t *sock, void **data, void **buf_ctx,
     return res;
 }
 
-ssize_t sock_udp_send(sock_udp_t *sock, const void *data, size_t len,
-                      const sock_udp_ep_t *remote)
+int sock_udp_buf_resize(void **data, void **buf_ctx, size_t size)
+{
+    gnrc_pktsnip_t *pkt;
+
+    assert((data != NULL) && (buf_ctx != NULL) && (*buf_ctx != NULL));
+    /* the payload is always a single snip, copy it if it is shared with
+     * other users */
+    pkt = gnrc_pktbuf_start_write(*buf_ctx);
+    if (pkt == NULL) {
+        return -ENOMEM;
+    }
+    *buf_ctx = pkt;
+    if (gnrc_pktbuf_realloc_data(pkt, size) != 0) {
+        return -ENOMEM;
+    }
+    *data = pkt->data;
+    return 0;
+}
+
+/* sends the payload snip *payload or, if it is NULL, the data gathered from
+ * snips. *payload is set to NULL when the snip was handed over to the stack */
+static ssize_t _send(sock_udp_t *sock, gnrc_pktsnip_t **payload,
+                     const iolist_t *snips, const sock_udp_ep_t *remote)
 {
     int res;
-    gnrc_pktsnip_t *payload, *pkt;
+    gnrc_pktsnip_t *pkt;
     uint16_t src_port = 0, dst_port;
     sock_ip_ep_t local;
     sock_udp_ep_t remote_cpy;
     sock_ip_ep_t *rem;
 
-    assert((sock != NULL) || (remote != NULL));
-    assert((len == 0) || (data != NULL)); /* (len != 0) => (data != NULL) */
-
     if (remote != NULL) {
         if (remote->port == 0) {
             return -EINVAL;
@@ -325,15 +344,21 @@ ssize_t sock_udp_send(sock_udp_t *sock, const void *data, size_t len,
         return -EINVAL;
     }
     /* generate payload and header snips */
-    payload = gnrc_pktbuf_add(NULL, (void *)data, len, GNRC_NETTYPE_UNDEF);
-    if (payload == NULL) {
-        return -ENOMEM;
+    if (*payload == NULL) {
+        size_t len = iolist_size(snips);
+
+        /* gather directly into the payload snip handed to the stack */
+        *payload = gnrc_pktbuf_add(NULL, NULL, len, GNRC_NETTYPE_UNDEF);
+        if (*payload == NULL) {
+            return -ENOMEM;
+        }
+        iolist_copy(snips, (*payload)->data, len);
     }
-    pkt = gnrc_udp_hdr_build(payload, src_port, dst_port);
+    pkt = gnrc_udp_hdr_build(*payload, src_port, dst_port);
     if (pkt == NULL) {
-        gnrc_pktbuf_release(payload);
         return -ENOMEM;
     }
+    *payload = NULL;
     res = gnrc_sock_send(pkt, &local, rem, PROTNUM_UDP);
     if (res > 0) {
         res -= sizeof(udp_hdr_t);
@@ -347,6 +372,65 @@ ssize_t sock_udp_send(sock_udp_t *sock, const void *data, size_t len,
     return res;
 }
 
+ssize_t sock_udp_send(sock_udp_t *sock, const void *data, size_t len,
+                      const sock_udp_ep_t *remote)
+{
+    const iolist_t snip = { NULL, (void *)data, len };
+
+    assert((len == 0) || (data != NULL)); /* (len != 0) => (data != NULL) */
+
+    return sock_udp_sendv(sock, &snip, remote);
+}
+
+ssize_t sock_udp_sendv(sock_udp_t *sock, const iolist_t *snips,
+                       const sock_udp_ep_t *remote)
+{
+    gnrc_pktsnip_t *payload = NULL;
+    ssize_t res;
+
+    assert((sock != NULL) || (remote != NULL));
+
+    res = _send(sock, &payload, snips, remote);
+    if (payload != NULL) {
+        gnrc_pktbuf_release(payload);
+    }
+    return res;
+}
+
+ssize_t sock_udp_send_buf(sock_udp_t *sock, void *buf_ctx, size_t len,
+                          const sock_udp_ep_t *remote)
+{
+    gnrc_pktsnip_t *payload = buf_ctx;
+    ssize_t res;
+
+    assert(((sock != NULL) || (remote != NULL)) && (buf_ctx != NULL));
+    assert(len <= payload->size);
+
+    if (payload->users > 1) {
+        /* the payload is shared with other users, send a copy */
+        payload = gnrc_pktbuf_add(NULL, payload->data, len, GNRC_NETTYPE_UNDEF);
+        gnrc_pktbuf_release(buf_ctx);
+        if (payload == NULL) {
+            return -ENOMEM;
+        }
+    }
+    else {
+        /* only keep the payload of the received packet, shrinking it does
+         * not move it */
+        if (payload->next != NULL) {
+            gnrc_pktbuf_release(payload->next);
+            payload->next = NULL;
+        }
+        gnrc_pktbuf_realloc_data(payload, len);
+        payload->type = GNRC_NETTYPE_UNDEF;
+    }
+    res = _send(sock, &payload, NULL, remote);
+    if (payload != NULL) {
+        gnrc_pktbuf_release(payload);
+    }
+    return res;
+}
+
 #ifdef SOCK_HAS_ASYNC
 void sock_udp_set_cb(sock_udp_t *sock, sock_udp_cb_t cb, void *arg)
 {
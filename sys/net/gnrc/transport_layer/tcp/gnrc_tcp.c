@@ -21,6 +21,7 @@
 #include <string.h>
 #include <utlist.h>
 
+#include "kernel_defines.h"
 #include "net/af.h"
 #include "net/gnrc.h"
 #include "net/gnrc/tcp.h"
@@ -29,7 +30,6 @@
 #include "internal/pkt.h"
 #include "internal/option.h"
 #include "internal/eventloop.h"
-#include "internal/rcvbuf.h"
 
 #ifdef MODULE_GNRC_IPV6
 #include "net/gnrc/ipv6.h"
@@ -98,6 +98,34 @@ static void _setup_timeout(xtimer_t *timer, const uint32_t duration, const xtime
     xtimer_set(timer, duration);
 }
 
+/**
+ * @brief Prepares a TCB for a passive open.
+ *
+ * @param[in,out] tcb          TCB holding the connection information.
+ * @param[in]     local_addr   Local address to bind on, may be NULL.
+ * @param[in]     local_port   Local port to bind on.
+ */
+static void _setup_passive(gnrc_tcp_tcb_t *tcb, const uint8_t *local_addr, uint16_t local_port)
+{
+    /* Mark connection as passive opend */
+    tcb->status |= STATUS_PASSIVE;
+#ifdef MODULE_GNRC_IPV6
+    /* If local address is specified: Copy it into TCB */
+    if (local_addr && tcb->address_family == AF_INET6) {
+        memcpy(tcb->local_addr, local_addr, sizeof(tcb->local_addr));
+
+        if (ipv6_addr_is_unspecified((ipv6_addr_t *) tcb->local_addr)) {
+            tcb->status |= STATUS_ALLOW_ANY_ADDR;
+        }
+    }
+#else
+    /* Suppress Compiler Warnings */
+    (void) local_addr;
+#endif
+    /* Set port number to listen on */
+    tcb->local_port = local_port;
+}
+
 /**
  * @brief   Establishes a new TCP connection
  *
@@ -110,7 +138,6 @@ static void _setup_timeout(xtimer_t *timer, const uint32_t duration, const xtime
  *
  * @returns   Zero on success.
  *            -EISCONN if TCB is already connected.
- *            -ENOMEM if the receive buffer for the TCB could not be allocated.
  *            -EADDRINUSE if @p local_port is already in use.
  *            -ETIMEDOUT if the connection opening timed out.
  *            -ECONNREFUSED if the connection was reset by the peer.
@@ -141,28 +168,7 @@ static int _gnrc_tcp_open(gnrc_tcp_tcb_t *tcb, const gnrc_tcp_ep_t *remote,
 
     /* Setup passive connection */
     if (passive) {
-        /* Mark connection as passive opend */
-        tcb->status |= STATUS_PASSIVE;
-#ifdef MODULE_GNRC_IPV6
-        /* If local address is specified: Copy it into TCB */
-        if (local_addr && tcb->address_family == AF_INET6) {
-            /* Store given address in TCB */
-            if (memcpy(tcb->local_addr, local_addr, sizeof(tcb->local_addr)) == NULL) {
-                DEBUG("gnrc_tcp.c : _gnrc_tcp_open() : Invalid peer addr\n");
-                return -EINVAL;
-            }
-
-            if (ipv6_addr_is_unspecified((ipv6_addr_t *) tcb->local_addr)) {
-                tcb->status |= STATUS_ALLOW_ANY_ADDR;
-            }
-        }
-#else
-        /* Suppress Compiler Warnings */
-        (void) remote;
-        (void) local_addr;
-#endif
-        /* Set port number to listen on */
-        tcb->local_port = local_port;
+        _setup_passive(tcb, local_addr, local_port);
     }
     /* Setup active connection */
     else {
@@ -192,10 +198,7 @@ static int _gnrc_tcp_open(gnrc_tcp_tcb_t *tcb, const gnrc_tcp_ep_t *remote,
 
     /* Call FSM with event: CALL_OPEN */
     ret = _fsm(tcb, FSM_EVENT_CALL_OPEN, NULL, NULL, 0);
-    if (ret == -ENOMEM) {
-        DEBUG("gnrc_tcp.c : _gnrc_tcp_open() : Out of receive buffers.\n");
-    }
-    else if (ret == -EADDRINUSE) {
+    if (ret == -EADDRINUSE) {
         DEBUG("gnrc_tcp.c : _gnrc_tcp_open() : local_port is already in use.\n");
     }
 
@@ -387,7 +390,6 @@ int gnrc_tcp_init(void)
 
     /* Initialize TCB list */
     _list_tcb_head = NULL;
-    _rcvbuf_init();
 
     /* Start TCP processing thread */
     return thread_create(_stack, sizeof(_stack), TCP_EVENTLOOP_PRIO,
@@ -406,6 +408,9 @@ void gnrc_tcp_tcb_init(gnrc_tcp_tcb_t *tcb)
     tcb->rtt_var = RTO_UNINITIALIZED;
     tcb->srtt = RTO_UNINITIALIZED;
     tcb->rto = RTO_UNINITIALIZED;
+    tcb->rcv_buf_min = CONFIG_GNRC_TCP_DEFAULT_WINDOW;
+    tcb->rcv_buf_max = (CONFIG_GNRC_TCP_MAX_WINDOW > CONFIG_GNRC_TCP_DEFAULT_WINDOW)
+                     ? CONFIG_GNRC_TCP_MAX_WINDOW : CONFIG_GNRC_TCP_DEFAULT_WINDOW;
     mbox_init(&(tcb->mbox), tcb->mbox_raw, GNRC_TCP_TCB_MBOX_SIZE);
     mutex_init(&(tcb->fsm_lock));
     mutex_init(&(tcb->function_lock));
@@ -459,6 +464,80 @@ int gnrc_tcp_open_passive(gnrc_tcp_tcb_t *tcb, const gnrc_tcp_ep_t *local)
 #endif
 }
 
+int gnrc_tcp_listen(gnrc_tcp_tcb_t *tcb, const gnrc_tcp_ep_t *local)
+{
+    assert(tcb != NULL);
+    assert(local != NULL);
+    assert(local->port != PORT_UNSPEC);
+
+    /* Check if given AF-Family in local is supported */
+#ifdef MODULE_GNRC_IPV6
+    if (local->family != AF_INET6) {
+        return -EAFNOSUPPORT;
+    }
+
+    /* Check if AF-Family matches internally used AF-Family */
+    if (local->family != tcb->address_family) {
+        return -EINVAL;
+    }
+
+    /* Lock the TCB for this function call */
+    mutex_lock(&(tcb->function_lock));
+
+    /* TCB is already connected: Return -EISCONN */
+    if (tcb->state != FSM_STATE_CLOSED) {
+        mutex_unlock(&(tcb->function_lock));
+        return -EISCONN;
+    }
+
+    /* The TCP thread handles the connection establishment */
+    _setup_passive(tcb, local->addr.ipv6, local->port);
+    tcb->status |= STATUS_LISTEN;
+    _fsm(tcb, FSM_EVENT_CALL_OPEN, NULL, NULL, 0);
+    mutex_unlock(&(tcb->function_lock));
+    return 0;
+#else
+    return -EAFNOSUPPORT;
+#endif
+}
+
+void gnrc_tcp_set_cb(gnrc_tcp_tcb_t *tcb, gnrc_tcp_cb_t cb, void *arg)
+{
+    assert(tcb != NULL);
+
+    /* The FSM calls the callback */
+    mutex_lock(&(tcb->fsm_lock));
+    tcb->cb = cb;
+    tcb->cb_arg = arg;
+    mutex_unlock(&(tcb->fsm_lock));
+}
+
+int gnrc_tcp_set_rcvbuf(gnrc_tcp_tcb_t *tcb, uint32_t min, uint32_t max)
+{
+    assert(tcb != NULL);
+
+    /* Without window scaling, the window field limits the window size */
+    uint32_t limit = IS_ACTIVE(CONFIG_GNRC_TCP_WITHOUT_WSCALE) ? UINT16_MAX
+                                                                : ((uint32_t)UINT16_MAX << TCP_OPTION_WS_MAX);
+
+    if ((min < CONFIG_GNRC_TCP_MSS) || (max < min) || (max > limit)) {
+        return -EINVAL;
+    }
+
+    /* Lock the TCB for this function call */
+    mutex_lock(&(tcb->function_lock));
+
+    /* The buffer size is used on connection establishment */
+    if (tcb->state != FSM_STATE_CLOSED) {
+        mutex_unlock(&(tcb->function_lock));
+        return -EISCONN;
+    }
+    tcb->rcv_buf_min = min;
+    tcb->rcv_buf_max = max;
+    mutex_unlock(&(tcb->function_lock));
+    return 0;
+}
+
 ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
                       const uint32_t timeout_duration_us)
 {
@@ -501,8 +580,8 @@ ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
         _setup_timeout(&user_timeout, timeout_duration_us, _cb_mbox_put_msg, &user_timeout_arg);
     }
 
-    /* Loop until something was sent and acked */
-    while (ret == 0 || tcb->pkt_retransmit != NULL) {
+    /* Loop until something was sent. It is acknowledged in the background. */
+    while (ret == 0) {
         /* Check if the connections state is closed. If so, a reset was received */
         if (tcb->state == FSM_STATE_CLOSED) {
             ret = -ECONNRESET;
@@ -522,8 +601,11 @@ ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
         }
 
         /* Try to send data in case there nothing has been sent and we are not probing */
-        if (ret == 0 && !probing_mode) {
+        if (!probing_mode) {
             ret = _fsm(tcb, FSM_EVENT_CALL_SEND, NULL, (void *) data, len);
+            if (ret > 0) {
+                break;
+            }
         }
 
         /* Wait for responses */
@@ -537,7 +619,6 @@ ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
 
             case MSG_TYPE_USER_SPEC_TIMEOUT:
                 DEBUG("gnrc_tcp.c : gnrc_tcp_send() : USER_SPEC_TIMEOUT\n");
-                _fsm(tcb, FSM_EVENT_CLEAR_RETRANSMIT, NULL, NULL, 0);
                 ret = -ETIMEDOUT;
                 break;
 
@@ -667,7 +748,6 @@ ssize_t gnrc_tcp_recv(gnrc_tcp_tcb_t *tcb, void *data, const size_t max_len,
 
                 case MSG_TYPE_USER_SPEC_TIMEOUT:
                     DEBUG("gnrc_tcp.c : gnrc_tcp_recv() : USER_SPEC_TIMEOUT\n");
-                    _fsm(tcb, FSM_EVENT_CLEAR_RETRANSMIT, NULL, NULL, 0);
                     ret = -ETIMEDOUT;
                     break;
 
@@ -700,6 +780,13 @@ void gnrc_tcp_close(gnrc_tcp_tcb_t *tcb)
     /* Lock the TCB for this function call */
     mutex_lock(&(tcb->function_lock));
 
+    /* TCBs opened by gnrc_tcp_listen() are closed in the background */
+    if (tcb->status & STATUS_LISTEN) {
+        _fsm(tcb, FSM_EVENT_CALL_CLOSE, NULL, NULL, 0);
+        mutex_unlock(&(tcb->function_lock));
+        return;
+    }
+
     /* Return if connection is closed */
     if (tcb->state == FSM_STATE_CLOSED) {
         mutex_unlock(&(tcb->function_lock));
@@ -754,6 +841,10 @@ void gnrc_tcp_abort(gnrc_tcp_tcb_t *tcb)
         /* Call FSM ABORT event */
         _fsm(tcb, FSM_EVENT_CALL_ABORT, NULL, NULL, 0);
     }
+    else {
+        /* TCBs opened by gnrc_tcp_listen() stop listening */
+        tcb->status &= ~(STATUS_LISTEN | STATUS_RELISTEN);
+    }
     mutex_unlock(&(tcb->function_lock));
 }
 
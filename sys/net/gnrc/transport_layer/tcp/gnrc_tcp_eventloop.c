@@ -242,6 +242,7 @@ void *_event_loop(__attribute__((unused)) void *arg)
 {
     msg_t msg;
     msg_t reply;
+    gnrc_tcp_tcb_t *tcb;
 
     /* Store pid */
     gnrc_tcp_pid = thread_getpid();
@@ -294,6 +295,19 @@ void *_event_loop(__attribute__((unused)) void *arg)
                      NULL, NULL, 0);
                 break;
 
+            /* Connection timer of a TCB opened by gnrc_tcp_listen() expired: Call FSM
+             * with connection timeout event, unless the TCB was connected or closed
+             * in the meantime */
+            case MSG_TYPE_CONNECTION_TIMEOUT:
+                DEBUG("gnrc_tcp_eventloop.c : _event_loop() : MSG_TYPE_CONNECTION_TIMEOUT\n");
+                tcb = (gnrc_tcp_tcb_t *)msg.content.ptr;
+                if (tcb->state != FSM_STATE_ESTABLISHED && tcb->state != FSM_STATE_CLOSE_WAIT &&
+                    tcb->state != FSM_STATE_TIME_WAIT && tcb->state != FSM_STATE_LISTEN &&
+                    tcb->state != FSM_STATE_CLOSED) {
+                    _fsm(tcb, FSM_EVENT_TIMEOUT_CONNECTION, NULL, NULL, 0);
+                }
+                break;
+
             default:
                 DEBUG("gnrc_tcp_eventloop.c : _event_loop() : received expected message\n");
         }
@@ -22,6 +22,7 @@
 #include "random.h"
 #include "net/af.h"
 #include "net/gnrc.h"
+#include "net/gnrc/tcp.h"
 #include "internal/common.h"
 #include "internal/pkt.h"
 #include "internal/option.h"
@@ -83,14 +84,230 @@ static uint16_t _get_random_local_port(void)
  */
 static int _clear_retransmit(gnrc_tcp_tcb_t *tcb)
 {
-    if (tcb->pkt_retransmit != NULL) {
-        gnrc_pktbuf_release(tcb->pkt_retransmit);
+    if (tcb->rtx_len > 0) {
+        for (unsigned i = 0; i < tcb->rtx_len; i++) {
+            gnrc_pktbuf_release(tcb->rtx[i].pkt);
+        }
         xtimer_remove(&(tcb->tim_tout));
-        tcb->pkt_retransmit = NULL;
+        tcb->rtx_len = 0;
     }
     return 0;
 }
 
+/**
+ * @brief Searches the retransmission queue for the first segment that was
+ *        neither selectively acknowledged nor retransmitted in fast recovery.
+ *
+ * @param[in] tcb   TCB holding the retransmit queue.
+ *
+ * @return   The segment, NULL if there is none.
+ */
+static gnrc_tcp_rtx_t *_get_hole(gnrc_tcp_tcb_t *tcb)
+{
+    for (unsigned i = 0; i < tcb->rtx_len; i++) {
+        if (!(tcb->rtx[i].flags & (RTX_FLAG_SACKED | RTX_FLAG_RESENT))) {
+            return &tcb->rtx[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Calculates the slow start threshold after a segment was lost.
+ *
+ * @param[in,out] tcb   TCB holding the congestion control state.
+ */
+static void _cc_set_ssthresh(gnrc_tcp_tcb_t *tcb)
+{
+    uint32_t flight = (tcb->snd_nxt - tcb->snd_una) / 2;
+    uint32_t min = 2 * _pkt_get_smss(tcb);
+
+    /* Half of the data in flight, but at least two segments (see RFC 5681, section 3.1) */
+    tcb->ssthresh = (flight > min) ? flight : min;
+}
+
+/**
+ * @brief Initializes congestion control after the connection was synchronized.
+ *
+ * @param[in,out] tcb   TCB holding the congestion control state.
+ */
+static void _cc_init(gnrc_tcp_tcb_t *tcb)
+{
+    uint32_t smss = _pkt_get_smss(tcb);
+
+    /* Initial window (see RFC 5681, section 3.1) */
+    if (smss > 2190) {
+        tcb->cwnd = 2 * smss;
+    }
+    else if (smss > 1095) {
+        tcb->cwnd = 3 * smss;
+    }
+    else {
+        tcb->cwnd = 4 * smss;
+    }
+    tcb->ssthresh = UINT32_MAX;
+    tcb->recover = tcb->iss;
+    tcb->dup_acks = 0;
+    tcb->status &= ~STATUS_FAST_RECOVERY;
+}
+
+/**
+ * @brief Retransmits segments marked after a retransmission timeout, as far
+ *        as the congestion window allows.
+ *
+ * @param[in,out] tcb   TCB holding the retransmit queue.
+ */
+static void _cc_send_pending(gnrc_tcp_tcb_t *tcb)
+{
+    uint32_t pipe = 0;
+
+    /* Data in flight: everything that is neither received nor to be retransmitted */
+    for (unsigned i = 0; i < tcb->rtx_len; i++) {
+        if (!(tcb->rtx[i].flags & (RTX_FLAG_SACKED | RTX_FLAG_PENDING))) {
+            pipe += tcb->rtx[i].len;
+        }
+    }
+    for (unsigned i = 0; i < tcb->rtx_len; i++) {
+        gnrc_tcp_rtx_t *rtx = &tcb->rtx[i];
+
+        if (rtx->flags & RTX_FLAG_PENDING) {
+            if (pipe + rtx->len > tcb->cwnd) {
+                break;
+            }
+            _pkt_resend(tcb, rtx);
+            pipe += rtx->len;
+        }
+    }
+}
+
+/**
+ * @brief Updates congestion control state for an ACK of new data
+ *        (see RFC 5681 and RFC 6582).
+ *
+ * @param[in,out] tcb     TCB holding the congestion control state.
+ * @param[in]     acked   Number of newly acknowledged bytes.
+ */
+static void _cc_new_ack(gnrc_tcp_tcb_t *tcb, uint32_t acked)
+{
+    uint32_t smss = _pkt_get_smss(tcb);
+    /* Growing cwnd beyond what the retransmission queue can hold is pointless */
+    uint32_t max_cwnd = CONFIG_GNRC_TCP_RTX_QUEUE_SIZE * smss;
+
+    tcb->dup_acks = 0;
+    if (tcb->status & STATUS_FAST_RECOVERY) {
+        /* Full ACK: Deflate window and leave fast recovery */
+        if (LEQ_32_BIT(tcb->recover, tcb->snd_una)) {
+            uint32_t flight = tcb->snd_nxt - tcb->snd_una;
+
+            flight = ((flight > smss) ? flight : smss) + smss;
+            tcb->cwnd = (flight < tcb->ssthresh) ? flight : tcb->ssthresh;
+            tcb->status &= ~STATUS_FAST_RECOVERY;
+        }
+        /* Partial ACK: The next segment was lost as well, retransmit it right away */
+        else {
+            gnrc_tcp_rtx_t *hole = _get_hole(tcb);
+
+            if (hole != NULL) {
+                _pkt_resend(tcb, hole);
+            }
+            tcb->cwnd = (tcb->cwnd > acked) ? tcb->cwnd - acked : 0;
+            if (acked >= smss) {
+                tcb->cwnd += smss;
+            }
+        }
+    }
+    /* Slow start */
+    else if (tcb->cwnd < tcb->ssthresh) {
+        tcb->cwnd += (acked < smss) ? acked : smss;
+    }
+    /* Congestion avoidance: Increase by about one SMSS per round trip time */
+    else {
+        uint32_t inc = (smss * smss) / tcb->cwnd;
+        tcb->cwnd += (inc > 0) ? inc : 1;
+    }
+    if (!(tcb->status & STATUS_FAST_RECOVERY)) {
+        if (tcb->cwnd > max_cwnd) {
+            tcb->cwnd = max_cwnd;
+        }
+        /* Keep recover behind snd_una, so it is not mistaken once sequence numbers wrapped */
+        if (LSS_32_BIT(tcb->recover, tcb->snd_una)) {
+            tcb->recover = tcb->snd_una - 1;
+        }
+    }
+    _cc_send_pending(tcb);
+}
+
+/**
+ * @brief Updates congestion control state for a duplicate ACK
+ *        (see RFC 5681 and RFC 6582).
+ *
+ * @param[in,out] tcb   TCB holding the congestion control state.
+ */
+static void _cc_dup_ack(gnrc_tcp_tcb_t *tcb)
+{
+    uint32_t smss = _pkt_get_smss(tcb);
+    gnrc_tcp_rtx_t *hole = NULL;
+
+    if (tcb->status & STATUS_FAST_RECOVERY) {
+        /* A segment left the network: Inflate window, maybe new data can be sent */
+        tcb->cwnd += smss;
+        tcb->status |= STATUS_NOTIFY_USER;
+
+        /* If segments after a hole were selectively acknowledged, the hole was lost as well */
+        hole = _get_hole(tcb);
+        if (hole != NULL) {
+            for (gnrc_tcp_rtx_t *rtx = hole + 1; rtx < &tcb->rtx[tcb->rtx_len]; rtx++) {
+                if (rtx->flags & RTX_FLAG_SACKED) {
+                    _pkt_resend(tcb, hole);
+                    break;
+                }
+            }
+        }
+        return;
+    }
+
+    /* Fast retransmit: Only start a new recovery after the last one was acknowledged */
+    tcb->dup_acks += 1;
+    if (tcb->dup_acks != CONFIG_GNRC_TCP_DUPACK_THRESHOLD ||
+        !LEQ_32_BIT(tcb->recover, tcb->snd_una)) {
+        return;
+    }
+    _cc_set_ssthresh(tcb);
+    tcb->recover = tcb->snd_nxt;
+    for (unsigned i = 0; i < tcb->rtx_len; i++) {
+        tcb->rtx[i].flags &= ~RTX_FLAG_RESENT;
+    }
+    hole = _get_hole(tcb);
+    if (hole != NULL) {
+        _pkt_resend(tcb, hole);
+    }
+    tcb->cwnd = tcb->ssthresh + CONFIG_GNRC_TCP_DUPACK_THRESHOLD * smss;
+    tcb->status |= STATUS_FAST_RECOVERY;
+}
+
+/**
+ * @brief Updates congestion control state after a retransmission timeout
+ *        (see RFC 5681 and RFC 6582).
+ *
+ * @param[in,out] tcb   TCB holding the congestion control state.
+ */
+static void _cc_timeout(gnrc_tcp_tcb_t *tcb)
+{
+    /* Keep ssthresh if the same segment times out repeatedly */
+    if (tcb->retries == 0) {
+        _cc_set_ssthresh(tcb);
+    }
+    tcb->cwnd = _pkt_get_smss(tcb);
+    tcb->recover = tcb->snd_nxt;
+    tcb->dup_acks = 0;
+    tcb->status &= ~STATUS_FAST_RECOVERY;
+
+    /* The peer might have discarded selectively acknowledged segments: Resend everything */
+    for (unsigned i = 0; i < tcb->rtx_len; i++) {
+        tcb->rtx[i].flags = RTX_FLAG_PENDING;
+    }
+}
+
 /**
  * @brief Restarts timewait timer.
  *
@@ -107,6 +324,37 @@ static int _restart_timewait_timer(gnrc_tcp_tcb_t *tcb)
     return 0;
 }
 
+/**
+ * @brief Updates the connection timer of a TCB opened by gnrc_tcp_listen().
+ *
+ * No user waits for the handshake and the teardown of those TCBs, so the TCP
+ * thread limits their duration.
+ *
+ * @param[in,out] tcb     TCB holding the timer struct.
+ * @param[in]     state   State the TCB transitions in.
+ */
+static void _update_connection_timer(gnrc_tcp_tcb_t *tcb, fsm_state_t state)
+{
+    switch (state) {
+        case FSM_STATE_SYN_RCVD:
+        case FSM_STATE_FIN_WAIT_1:
+        case FSM_STATE_LAST_ACK:
+            tcb->msg_conn.type = MSG_TYPE_CONNECTION_TIMEOUT;
+            tcb->msg_conn.content.ptr = (void *)tcb;
+            xtimer_set_msg(&tcb->tim_conn, CONFIG_GNRC_TCP_CONNECTION_TIMEOUT_DURATION,
+                           &tcb->msg_conn, gnrc_tcp_pid);
+            break;
+
+        /* Continuation of the teardown */
+        case FSM_STATE_FIN_WAIT_2:
+        case FSM_STATE_CLOSING:
+            break;
+
+        default:
+            xtimer_remove(&tcb->tim_conn);
+    }
+}
+
 /**
  * @brief Transition from current FSM state into another state.
  *
@@ -131,7 +379,7 @@ static int _transition_to(gnrc_tcp_tcb_t *tcb, fsm_state_t state)
             LL_DELETE(_list_tcb_head, tcb);
             mutex_unlock(&_list_tcb_lock);
 
-            /* Free potentially allocated receive buffer */
+            /* Release received data */
             _rcvbuf_release_buffer(tcb);
             tcb->status |= STATUS_NOTIFY_USER;
             break;
@@ -147,11 +395,10 @@ static int _transition_to(gnrc_tcp_tcb_t *tcb, fsm_state_t state)
             }
 #endif
             tcb->peer_port = PORT_UNSPEC;
+            tcb->status &= ~(STATUS_SACK_PERMITTED | STATUS_WSCALE);
 
-            /* Allocate receive buffer */
-            if (_rcvbuf_get_buffer(tcb) == -ENOMEM) {
-                return -ENOMEM;
-            }
+            /* Initialize receive buffer */
+            _rcvbuf_init(tcb);
 
             /* Add connection to active connections (if not already active) */
             mutex_lock(&_list_tcb_lock);
@@ -163,10 +410,8 @@ static int _transition_to(gnrc_tcp_tcb_t *tcb, fsm_state_t state)
             break;
 
         case FSM_STATE_SYN_SENT:
-            /* Allocate rceveive buffer */
-            if (_rcvbuf_get_buffer(tcb) == -ENOMEM) {
-                return -ENOMEM;
-            }
+            /* Initialize receive buffer */
+            _rcvbuf_init(tcb);
 
             /* Add connection to active connections (if not already active) */
             mutex_lock(&_list_tcb_lock);
@@ -175,10 +420,9 @@ static int _transition_to(gnrc_tcp_tcb_t *tcb, fsm_state_t state)
             if (iter == NULL) {
                 /* Check if port number was specified */
                 if (tcb->local_port != PORT_UNSPEC) {
-                    /* Check if given port number is use: return error and release buffer */
+                    /* Check if given port number is use: return error */
                     if (_is_local_port_in_use(tcb->local_port)) {
                         mutex_unlock(&_list_tcb_lock);
-                        _rcvbuf_release_buffer(tcb);
                         return -EADDRINUSE;
                     }
                 }
@@ -204,6 +448,9 @@ static int _transition_to(gnrc_tcp_tcb_t *tcb, fsm_state_t state)
         default:
             break;
     }
+    if (tcb->status & STATUS_LISTEN) {
+        _update_connection_timer(tcb, state);
+    }
     tcb->state = state;
     return 0;
 }
@@ -214,7 +461,6 @@ static int _transition_to(gnrc_tcp_tcb_t *tcb, fsm_state_t state)
  * @param[in,out] tcb   TCB holding the connection information.
  *
  * @returns   Zero on success.
- *            -ENOMEM if receive buffer could not be allocated.
  *            -EADDRINUSE if given local port number is already in use.
  */
 static int _fsm_call_open(gnrc_tcp_tcb_t *tcb)
@@ -222,14 +468,12 @@ static int _fsm_call_open(gnrc_tcp_tcb_t *tcb)
     int ret = 0;
 
     DEBUG("gnrc_tcp_fsm.c : _fsm_call_open()\n");
-    tcb->rcv_wnd = CONFIG_GNRC_TCP_DEFAULT_WINDOW;
+    tcb->status &= ~(STATUS_SACK_PERMITTED | STATUS_FAST_RECOVERY | STATUS_RTT_PENDING |
+                     STATUS_WSCALE);
 
     if (tcb->status & STATUS_PASSIVE) {
         /* Passive open, T: CLOSED -> LISTEN */
-        if (_transition_to(tcb, FSM_STATE_LISTEN) == -ENOMEM) {
-            _transition_to(tcb, FSM_STATE_CLOSED);
-            return -ENOMEM;
-        }
+        _transition_to(tcb, FSM_STATE_LISTEN);
     }
     else {
         /* Active Open, set TCB values, send SYN, T: CLOSED -> SYN_SENT */
@@ -267,24 +511,45 @@ static int _fsm_call_send(gnrc_tcp_tcb_t *tcb, void *buf, size_t len)
 {
     DEBUG("gnrc_tcp_fsm.c : _fsm_call_send()\n");
 
-    size_t payload = (tcb->snd_una + tcb->snd_wnd) - tcb->snd_nxt;
+    uint32_t smss = _pkt_get_smss(tcb);
+    uint32_t wnd = (tcb->cwnd < tcb->snd_wnd) ? tcb->cwnd : tcb->snd_wnd;
+    size_t sent = 0;
+
+    /* Segments to retransmit after a timeout go first */
+    for (unsigned i = 0; i < tcb->rtx_len; i++) {
+        if (tcb->rtx[i].flags & RTX_FLAG_PENDING) {
+            return 0;
+        }
+    }
+
+    /* Send segments as long as window and retransmission queue allow */
+    while (sent < len && tcb->rtx_len < CONFIG_GNRC_TCP_RTX_QUEUE_SIZE) {
+        uint32_t flight = tcb->snd_nxt - tcb->snd_una;
+        size_t payload = len - sent;
 
-    /* Check if window is open and all packets were transmitted */
-    if (payload > 0 && tcb->snd_wnd > 0 && tcb->pkt_retransmit == NULL) {
+        if (flight >= wnd) {
+            break;
+        }
         /* Calculate segment size */
-        payload = (payload < CONFIG_GNRC_TCP_MSS) ? payload : CONFIG_GNRC_TCP_MSS;
-        payload = (payload < tcb->mss) ? payload : tcb->mss;
-        payload = (payload < len) ? payload : len;
+        payload = (payload < wnd - flight) ? payload : wnd - flight;
+        payload = (payload < smss) ? payload : smss;
+
+        /* Avoid silly window syndrome: Wait for a full segment while data is in flight */
+        if (flight > 0 && payload < smss && payload < len - sent) {
+            break;
+        }
 
-        /* Calculate payload size for this segment */
         gnrc_pktsnip_t *out_pkt = NULL;
         uint16_t seq_con = 0;
-        _pkt_build(tcb, &out_pkt, &seq_con, MSK_ACK | MSK_PSH, tcb->snd_nxt, tcb->rcv_nxt, buf, payload);
+        if (_pkt_build(tcb, &out_pkt, &seq_con, MSK_ACK | MSK_PSH, tcb->snd_nxt, tcb->rcv_nxt,
+                       (uint8_t *) buf + sent, payload) < 0) {
+            break;
+        }
         _pkt_setup_retransmit(tcb, out_pkt, false);
         _pkt_send(tcb, out_pkt, seq_con, false);
-        return payload;
+        sent += payload;
     }
-    return 0;
+    return sent;
 }
 
 /**
@@ -300,16 +565,16 @@ static int _fsm_call_recv(gnrc_tcp_tcb_t *tcb, void *buf, size_t len)
 {
     DEBUG("gnrc_tcp_fsm.c : _fsm_call_recv()\n");
 
-    if (ringbuffer_empty(&tcb->rcv_buf)) {
+    if (tcb->rcv_buf_len == 0) {
         return 0;
     }
 
     /* Read data into 'buf' up to 'len' bytes from receive buffer */
-    size_t rcvd = ringbuffer_get(&(tcb->rcv_buf), buf, len);
+    size_t rcvd = _rcvbuf_get(tcb, buf, len);
 
     /* If receive buffer can store more than CONFIG_GNRC_TCP_MSS: open window to available buffer size */
-    if (ringbuffer_get_free(&tcb->rcv_buf) >= CONFIG_GNRC_TCP_MSS) {
-        tcb->rcv_wnd = ringbuffer_get_free(&(tcb->rcv_buf));
+    if (_rcvbuf_get_free(tcb) >= CONFIG_GNRC_TCP_MSS) {
+        tcb->rcv_wnd = _rcvbuf_get_free(tcb);
 
         /* Send ACK to anounce window update */
         gnrc_pktsnip_t *out_pkt = NULL;
@@ -331,6 +596,11 @@ static int _fsm_call_close(gnrc_tcp_tcb_t *tcb)
 {
     DEBUG("gnrc_tcp_fsm.c : _fsm_call_close()\n");
 
+    /* TCBs opened by gnrc_tcp_listen() wait for the next connection once closed */
+    if (tcb->status & STATUS_LISTEN) {
+        tcb->status |= STATUS_RELISTEN;
+    }
+
     if (tcb->state == FSM_STATE_SYN_RCVD || tcb->state == FSM_STATE_ESTABLISHED ||
         tcb->state == FSM_STATE_CLOSE_WAIT) {
 
@@ -380,6 +650,9 @@ static int _fsm_call_abort(gnrc_tcp_tcb_t *tcb)
     /* From here on any state must transition into CLOSED state */
     _transition_to(tcb, FSM_STATE_CLOSED);
 
+    /* TCBs opened by gnrc_tcp_listen() stop listening */
+    tcb->status &= ~(STATUS_LISTEN | STATUS_RELISTEN);
+
     return 0;
 }
 
@@ -387,10 +660,10 @@ static int _fsm_call_abort(gnrc_tcp_tcb_t *tcb)
  * @brief FSM handling function for processing of an incoming TCP packet.
  *
  * @param[in,out] tcb      TCB holding the connection information.
- * @param[in]     in_pkt   Incoming packet.
+ * @param[in]     in_pkt   Incoming packet. Its payload is taken over if it is
+ *                         received, the headers must not be accessed afterwards.
  *
  * @returns   Zero on success.
- *            -ENOMEM if receive buffer could not be allocated.
  */
 static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
 {
@@ -410,6 +683,11 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
     LL_SEARCH_SCALAR(in_pkt, snp, type, GNRC_NETTYPE_TCP);
     tcp_hdr_t *tcp_hdr = (tcp_hdr_t *) snp->data;
 
+    /* Options offered in earlier connection requests do not apply */
+    if (tcb->state == FSM_STATE_LISTEN) {
+        tcb->status &= ~(STATUS_SACK_PERMITTED | STATUS_WSCALE);
+    }
+
     /* Parse packet options, return if they are malformed */
     if (_option_parse(tcb, tcp_hdr) < 0) {
         return 0;
@@ -420,6 +698,10 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
     seg_seq = byteorder_ntohl(tcp_hdr->seq_num);
     seg_ack = byteorder_ntohl(tcp_hdr->ack_num);
     seg_wnd = byteorder_ntohs(tcp_hdr->window);
+    /* The window of SYN segments is never scaled (see RFC 7323, section 2.2) */
+    if (!(ctl & MSK_SYN) && (tcb->status & STATUS_WSCALE)) {
+        seg_wnd <<= tcb->snd_wscale;
+    }
 
     /* Extract network layer header */
 #ifdef MODULE_GNRC_IPV6
@@ -559,6 +841,7 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
             if (tcb->snd_una > tcb->iss) {
                 _pkt_build(tcb, &out_pkt, &seq_con, MSK_ACK, tcb->snd_nxt, tcb->rcv_nxt, NULL, 0);
                 _pkt_send(tcb, out_pkt, seq_con, false);
+                _cc_init(tcb);
                 _transition_to(tcb, FSM_STATE_ESTABLISHED);
             }
             /* Simultaneous SYN received. Send SYN+ACK, T: SYN_SENT -> SYN_RCVD */
@@ -591,10 +874,7 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
         if (ctl & MSK_RST) {
             /* .. and state is SYN_RCVD and the connection is passive: SYN_RCVD -> LISTEN */
             if (tcb->state == FSM_STATE_SYN_RCVD && (tcb->status & STATUS_PASSIVE)) {
-                if (_transition_to(tcb, FSM_STATE_LISTEN) == -ENOMEM) {
-                    _transition_to(tcb, FSM_STATE_CLOSED);
-                    return -ENOMEM;
-                }
+                _transition_to(tcb, FSM_STATE_LISTEN);
             }
             else {
                 _transition_to(tcb, FSM_STATE_CLOSED);
@@ -616,9 +896,12 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
         else {
             if (tcb->state == FSM_STATE_SYN_RCVD) {
                 if (LSS_32_BIT(tcb->snd_una, seg_ack) && LEQ_32_BIT(seg_ack, tcb->snd_nxt)) {
+                    tcb->snd_una = seg_ack;
+                    _pkt_acknowledge(tcb, seg_ack);
                     tcb->snd_wnd = seg_wnd;
                     tcb->snd_wl1 = seg_seq;
                     tcb->snd_wl2 = seg_ack;
+                    _cc_init(tcb);
                     _transition_to(tcb, FSM_STATE_ESTABLISHED);
                 }
                 else {
@@ -632,8 +915,19 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
                 tcb->state == FSM_STATE_CLOSING || tcb->state == FSM_STATE_LAST_ACK) {
                 /* Acknowledge previously sent data */
                 if (LSS_32_BIT(tcb->snd_una, seg_ack) && LEQ_32_BIT(seg_ack, tcb->snd_nxt)) {
+                    uint32_t acked = seg_ack - tcb->snd_una;
+
                     tcb->snd_una = seg_ack;
                     _pkt_acknowledge(tcb, seg_ack);
+                    _cc_new_ack(tcb, acked);
+
+                    /* Signal user: Acknowledged data frees space for new data */
+                    tcb->status |= STATUS_NOTIFY_USER;
+                }
+                /* Duplicate ACK: Indicates a lost or reordered segment */
+                else if (seg_ack == tcb->snd_una && pay_len == 0 && tcb->rtx_len > 0 &&
+                         !(ctl & (MSK_SYN | MSK_FIN)) && seg_wnd == tcb->snd_wnd) {
+                    _cc_dup_ack(tcb);
                 }
                 /* ACK received for something not yet sent: Reply with pure ACK */
                 else if (LSS_32_BIT(tcb->snd_nxt, seg_ack)) {
@@ -657,25 +951,25 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
                 /* Additional processing */
                 /* Check additionally if previously sent FIN was acknowledged */
                 if (tcb->state == FSM_STATE_FIN_WAIT_1) {
-                    if (tcb->pkt_retransmit == NULL) {
+                    if (tcb->rtx_len == 0) {
                         _transition_to(tcb, FSM_STATE_FIN_WAIT_2);
                     }
                 }
                 /* If retransmission queue is empty, acknowledge close operation */
                 if (tcb->state == FSM_STATE_FIN_WAIT_2) {
-                    if (tcb->pkt_retransmit == NULL) {
+                    if (tcb->rtx_len == 0) {
                         /* Optional: Unblock user close operation */
                     }
                 }
                 /* If our FIN has been acknowledged: Transition to TIME_WAIT */
                 if (tcb->state == FSM_STATE_CLOSING) {
-                    if (tcb->pkt_retransmit == NULL) {
+                    if (tcb->rtx_len == 0) {
                         _transition_to(tcb, FSM_STATE_TIME_WAIT);
                     }
                 }
                 /* If our FIN was acknowledged and status is LAST_ACK: close connection */
                 if (tcb->state == FSM_STATE_LAST_ACK) {
-                    if (tcb->pkt_retransmit == NULL) {
+                    if (tcb->rtx_len == 0) {
                         _transition_to(tcb, FSM_STATE_CLOSED);
                         return 0;
                     }
@@ -690,18 +984,12 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
             /* Check if state is valid for payload receiving */
             if (tcb->state == FSM_STATE_ESTABLISHED || tcb->state == FSM_STATE_FIN_WAIT_1 ||
                 tcb->state == FSM_STATE_FIN_WAIT_2) {
-                /* Search for begin of payload */
-                LL_SEARCH_SCALAR(in_pkt, snp, type, GNRC_NETTYPE_UNDEF);
-
-                /* Accept only data that is expected, to be received */
+                /* Accept only data that is expected, to be received. The payload
+                 * is the first snip of in_pkt, it is queued without copying. */
                 if (tcb->rcv_nxt == seg_seq) {
-                    /* Copy contents into receive buffer */
-                    while (snp && snp->type == GNRC_NETTYPE_UNDEF) {
-                        tcb->rcv_nxt += ringbuffer_add(&(tcb->rcv_buf), snp->data, snp->size);
-                        snp = snp->next;
-                    }
+                    tcb->rcv_nxt += _rcvbuf_add(tcb, in_pkt);
                     /* Shrink receive window */
-                    tcb->rcv_wnd = ringbuffer_get_free(&(tcb->rcv_buf));
+                    tcb->rcv_wnd = _rcvbuf_get_free(tcb);
                     /* Notify owner because new data is available */
                     tcb->status |= STATUS_NOTIFY_USER;
                 }
@@ -729,7 +1017,7 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
                 _transition_to(tcb, FSM_STATE_CLOSE_WAIT);
             }
             else if (tcb->state == FSM_STATE_FIN_WAIT_1) {
-                if (tcb->pkt_retransmit == NULL) {
+                if (tcb->rtx_len == 0) {
                     _transition_to(tcb, FSM_STATE_TIME_WAIT);
                 }
                 else {
@@ -771,9 +1059,10 @@ static int _fsm_timeout_timewait(gnrc_tcp_tcb_t *tcb)
 static int _fsm_timeout_retransmit(gnrc_tcp_tcb_t *tcb)
 {
     DEBUG("gnrc_tcp_fsm.c : _fsm_timeout_retransmit()\n");
-    if (tcb->pkt_retransmit != NULL) {
-        _pkt_setup_retransmit(tcb, tcb->pkt_retransmit, true);
-        _pkt_send(tcb, tcb->pkt_retransmit, 0, true);
+    if (tcb->rtx_len > 0) {
+        _cc_timeout(tcb);
+        _pkt_setup_retransmit(tcb, tcb->rtx[0].pkt, true);
+        _pkt_resend(tcb, &tcb->rtx[0]);
     }
     else {
         DEBUG("gnrc_tcp_fsm.c : _fsm_timeout_retransmit() : Retransmit queue is empty\n");
@@ -791,7 +1080,15 @@ static int _fsm_timeout_retransmit(gnrc_tcp_tcb_t *tcb)
 static int _fsm_timeout_connection(gnrc_tcp_tcb_t *tcb)
 {
     DEBUG("gnrc_tcp_fsm.c : _fsm_timeout_connection()\n");
-    _transition_to(tcb, FSM_STATE_CLOSED);
+
+    /* TCBs opened by gnrc_tcp_listen() wait for the next connection request */
+    if (tcb->state == FSM_STATE_SYN_RCVD && (tcb->status & STATUS_LISTEN)) {
+        _clear_retransmit(tcb);
+        _transition_to(tcb, FSM_STATE_LISTEN);
+    }
+    else {
+        _transition_to(tcb, FSM_STATE_CLOSED);
+    }
     return 0;
 }
 
@@ -839,7 +1136,6 @@ static int _fsm_clear_retransmit(gnrc_tcp_tcb_t *tcb)
  * @param[in]     len     Number of bytes to send or receive in @p buf.
  *
  * @returns   Zero on success.
- *           -ENOMEM if receive buffer could not be allocated.
  *           -EADDRINUSE if given local port number in @p tcb is already in use.
  *           -EOPNOTSUPP if event is not implemented.
  */
@@ -887,15 +1183,68 @@ static int _fsm_unprotected(gnrc_tcp_tcb_t *tcb, fsm_event_t event, gnrc_pktsnip
     return ret;
 }
 
+/**
+ * @brief Determines the events of a FSM call for the event callback.
+ *
+ * @param[in] tcb       TCB after the FSM call.
+ * @param[in] state     State before the FSM call.
+ * @param[in] rcv_len   Received data before the FSM call.
+ * @param[in] snd_una   First unacknowledged sequence number before the FSM call.
+ *
+ * @returns   Bitmask of GNRC_TCP_EVENT_* flags.
+ */
+static unsigned _get_events(const gnrc_tcp_tcb_t *tcb, fsm_state_t state, uint32_t rcv_len,
+                            uint32_t snd_una)
+{
+    unsigned events = 0;
+
+    if ((state == FSM_STATE_SYN_SENT || state == FSM_STATE_SYN_RCVD) &&
+        (tcb->state == FSM_STATE_ESTABLISHED || tcb->state == FSM_STATE_CLOSE_WAIT)) {
+        events |= GNRC_TCP_EVENT_CONNECTED;
+    }
+    /* A FIN is received as well, it ends the data to read */
+    if ((tcb->rcv_buf_len > rcv_len) ||
+        (state != FSM_STATE_CLOSE_WAIT && tcb->state == FSM_STATE_CLOSE_WAIT)) {
+        events |= GNRC_TCP_EVENT_RECV;
+    }
+    if ((state == FSM_STATE_ESTABLISHED || state == FSM_STATE_CLOSE_WAIT) &&
+        (tcb->snd_una != snd_una)) {
+        events |= GNRC_TCP_EVENT_SENT;
+    }
+    if (state != FSM_STATE_CLOSED && tcb->state == FSM_STATE_CLOSED) {
+        events |= GNRC_TCP_EVENT_CLOSED;
+    }
+    return events;
+}
+
 int _fsm(gnrc_tcp_tcb_t *tcb, fsm_event_t event, gnrc_pktsnip_t *in_pkt, void *buf, size_t len)
 {
+    fsm_state_t state;
+    uint32_t rcv_len;
+    uint32_t snd_una;
+    unsigned events = 0;
+
     /* Lock FSM */
     mutex_lock(&(tcb->fsm_lock));
+    state = tcb->state;
+    rcv_len = tcb->rcv_buf_len;
+    snd_una = tcb->snd_una;
 
     /* Call FSM */
     tcb->status &= ~STATUS_NOTIFY_USER;
     int32_t result = _fsm_unprotected(tcb, event, in_pkt, buf, len);
 
+    /* A TCB opened by gnrc_tcp_listen() was closed by the user or before the
+     * connection was established: Listen again */
+    if (tcb->state == FSM_STATE_CLOSED && ((tcb->status & STATUS_RELISTEN) ||
+        ((tcb->status & STATUS_LISTEN) && state == FSM_STATE_SYN_RCVD))) {
+        tcb->status &= ~STATUS_RELISTEN;
+        _fsm_call_open(tcb);
+    }
+    if (tcb->cb != NULL) {
+        events = _get_events(tcb, state, rcv_len, snd_una);
+    }
+
     /* Notify blocked thread if something interesting happened */
     if ((tcb->status & STATUS_NOTIFY_USER) && (tcb->status & STATUS_WAIT_FOR_MSG)) {
         msg_t msg;
@@ -904,5 +1253,10 @@ int _fsm(gnrc_tcp_tcb_t *tcb, fsm_event_t event, gnrc_pktsnip_t *in_pkt, void *b
     }
     /* Unlock FSM */
     mutex_unlock(&(tcb->fsm_lock));
+
+    /* Report events after unlocking, the callback may use the TCB */
+    if (events) {
+        tcb->cb(tcb, events, tcb->cb_arg);
+    }
     return result;
 }
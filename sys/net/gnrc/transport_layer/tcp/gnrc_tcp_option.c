@@ -16,16 +16,42 @@
  * @author      Simon Brummer <simon.brummer@posteo.de>
  * @}
  */
+#include <string.h>
+
+#include "kernel_defines.h"
 #include "internal/common.h"
 #include "internal/option.h"
+#include "internal/pkt.h"
 
 #define ENABLE_DEBUG (0)
 #include "debug.h"
 
+/**
+ * @brief Marks the segments reported by a SACK option as received.
+ *
+ * @param[in,out] tcb      TCB holding the retransmission queue.
+ * @param[in]     option   SACK option, its length was verified.
+ */
+static void _option_parse_sack(gnrc_tcp_tcb_t *tcb, tcp_hdr_opt_t *option)
+{
+    for (uint8_t i = 0; i < option->length - TCP_OPTION_LENGTH_MIN;
+         i += TCP_OPTION_LENGTH_SACK_BLOCK) {
+        network_uint32_t left;
+        network_uint32_t right;
+
+        memcpy(&left, &option->value[i], sizeof(left));
+        memcpy(&right, &option->value[i + sizeof(left)], sizeof(right));
+        DEBUG("gnrc_tcp_option.c : _option_parse() : SACK block found. LEFT=%"PRIu32
+              ", RIGHT=%"PRIu32"\n", byteorder_ntohl(left), byteorder_ntohl(right));
+        _pkt_sack(tcb, byteorder_ntohl(left), byteorder_ntohl(right));
+    }
+}
+
 int _option_parse(gnrc_tcp_tcb_t *tcb, tcp_hdr_t *hdr)
 {
-    /* Extract offset value. Return if no options are set */
-    uint8_t offset = GET_OFFSET(byteorder_ntohs(hdr->off_ctl));
+    /* Extract control bits and offset value. Return if no options are set */
+    uint16_t ctl = byteorder_ntohs(hdr->off_ctl);
+    uint8_t offset = GET_OFFSET(ctl);
     if (offset <= TCP_HDR_OFFSET_MIN) {
         return 0;
     }
@@ -62,6 +88,50 @@ int _option_parse(gnrc_tcp_tcb_t *tcb, tcp_hdr_t *hdr)
                       tcb->mss);
                 break;
 
+            case TCP_OPTION_KIND_WS:
+                if (opt_left < TCP_OPTION_LENGTH_MIN || option->length > opt_left ||
+                    option->length != TCP_OPTION_LENGTH_WS) {
+
+                    DEBUG("gnrc_tcp_option.c : _option_parse() : invalid WS Option length.\n");
+                    return -1;
+                }
+                /* Window scaling may only be offered during connection establishment */
+                if (!IS_ACTIVE(CONFIG_GNRC_TCP_WITHOUT_WSCALE) && (ctl & MSK_SYN)) {
+                    tcb->snd_wscale = (option->value[0] < TCP_OPTION_WS_MAX) ? option->value[0]
+                                                                            : TCP_OPTION_WS_MAX;
+                    tcb->status |= STATUS_WSCALE;
+                }
+                DEBUG("gnrc_tcp_option.c : _option_parse() : WS option found. WS=%"PRIu8"\n",
+                      option->value[0]);
+                break;
+
+            case TCP_OPTION_KIND_SACK_PERM:
+                if (opt_left < TCP_OPTION_LENGTH_MIN || option->length > opt_left ||
+                    option->length != TCP_OPTION_LENGTH_SACK_PERM) {
+
+                    DEBUG("gnrc_tcp_option.c : _option_parse() : invalid SACK permitted Option length.\n");
+                    return -1;
+                }
+                /* SACK may only be offered during connection establishment */
+                if (!IS_ACTIVE(CONFIG_GNRC_TCP_WITHOUT_SACK) && (ctl & MSK_SYN)) {
+                    tcb->status |= STATUS_SACK_PERMITTED;
+                }
+                DEBUG("gnrc_tcp_option.c : _option_parse() : SACK permitted option found.\n");
+                break;
+
+            case TCP_OPTION_KIND_SACK:
+                if (opt_left < TCP_OPTION_LENGTH_MIN || option->length > opt_left ||
+                    option->length < TCP_OPTION_LENGTH_MIN + TCP_OPTION_LENGTH_SACK_BLOCK ||
+                    ((option->length - TCP_OPTION_LENGTH_MIN) % TCP_OPTION_LENGTH_SACK_BLOCK)) {
+
+                    DEBUG("gnrc_tcp_option.c : _option_parse() : invalid SACK Option length.\n");
+                    return -1;
+                }
+                if ((tcb->status & STATUS_SACK_PERMITTED) && (ctl & MSK_ACK)) {
+                    _option_parse_sack(tcb, option);
+                }
+                break;
+
             default:
                 if (opt_left >= TCP_OPTION_LENGTH_MIN) {
                     DEBUG("gnrc_tcp_option.c : _option_parse() : Unsupported option found.\
@@ -20,6 +20,7 @@
 #include <utlist.h>
 #include <errno.h>
 #include "byteorder.h"
+#include "kernel_defines.h"
 #include "net/inet_csum.h"
 #include "net/gnrc.h"
 #include "internal/common.h"
@@ -164,7 +165,13 @@ int _pkt_build(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t **out_pkt, uint16_t *seq_con,
     tcp_hdr.checksum = byteorder_htons(0);
     tcp_hdr.seq_num = byteorder_htonl(seq_num);
     tcp_hdr.ack_num = byteorder_htonl(ack_num);
-    tcp_hdr.window = byteorder_htons(tcb->rcv_wnd);
+    /* The window is scaled if both sides offered it, but never in SYN segments
+     * (see RFC 7323, section 2.2) */
+    uint32_t wnd = tcb->rcv_wnd;
+    if (!(ctl & MSK_SYN) && (tcb->status & STATUS_WSCALE)) {
+        wnd >>= tcb->rcv_wscale;
+    }
+    tcp_hdr.window = byteorder_htons((wnd < UINT16_MAX) ? wnd : UINT16_MAX);
     tcp_hdr.urgent_ptr = byteorder_htons(0);
 
     /* Calculate option field size. */
@@ -172,6 +179,18 @@ int _pkt_build(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t **out_pkt, uint16_t *seq_con,
     if (ctl & MSK_SYN) {
         offset += 1;
     }
+    /* Offer SACK on active open, accept it only if the peer offered it */
+    bool sack_perm = (ctl & MSK_SYN) && !IS_ACTIVE(CONFIG_GNRC_TCP_WITHOUT_SACK) &&
+                     (!(ctl & MSK_ACK) || (tcb->status & STATUS_SACK_PERMITTED));
+    if (sack_perm) {
+        offset += 1;
+    }
+    /* Offer window scaling on active open, accept it only if the peer offered it */
+    bool wscale = (ctl & MSK_SYN) && !IS_ACTIVE(CONFIG_GNRC_TCP_WITHOUT_WSCALE) &&
+                  (!(ctl & MSK_ACK) || (tcb->status & STATUS_WSCALE));
+    if (wscale) {
+        offset += 1;
+    }
     /* Set offset and control bit accordingly */
     tcp_hdr.off_ctl = byteorder_htons(_option_build_offset_control(offset, ctl));
 
@@ -203,6 +222,19 @@ int _pkt_build(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t **out_pkt, uint16_t *seq_con,
             if (ctl & MSK_SYN) {
                 network_uint32_t mss_option = byteorder_htonl(_option_build_mss(CONFIG_GNRC_TCP_MSS));
                 memcpy(opt_ptr, &mss_option, sizeof(mss_option));
+                opt_ptr += sizeof(mss_option);
+            }
+            /* Add SACK permitted option */
+            if (sack_perm) {
+                network_uint32_t sack_option = byteorder_htonl(_option_build_sack_perm());
+                memcpy(opt_ptr, &sack_option, sizeof(sack_option));
+                opt_ptr += sizeof(sack_option);
+            }
+            /* Add window scale option */
+            if (wscale) {
+                network_uint32_t ws_option = byteorder_htonl(_option_build_wscale(tcb->rcv_wscale));
+                memcpy(opt_ptr, &ws_option, sizeof(ws_option));
+                opt_ptr += sizeof(ws_option);
             }
             /* Increase opt_ptr and decrease opt_left, if other options are added */
             /* NOTE: Add additional options here */
@@ -267,14 +299,16 @@ int _pkt_send(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *out_pkt, const uint16_t seq_c
         return -EINVAL;
     }
 
-    /* If this is no retransmission, advance sequence number and measure time */
+    /* If this is no retransmission, advance sequence number */
     if (!retransmit) {
-        tcb->retries = 0;
         tcb->snd_nxt += seq_con;
-        tcb->rtt_start = xtimer_now().ticks32;
-    }
-    else {
-        tcb->retries += 1;
+
+        /* Measure time until this segment is acknowledged, if no measurement is running */
+        if (seq_con > 0 && !(tcb->status & STATUS_RTT_PENDING)) {
+            tcb->status |= STATUS_RTT_PENDING;
+            tcb->rtt_start = xtimer_now().ticks32;
+            tcb->rtt_seq = tcb->snd_nxt;
+        }
     }
 
     /* Pass packet down the network stack */
@@ -349,9 +383,52 @@ uint32_t _pkt_get_pay_len(gnrc_pktsnip_t *pkt)
     return seg_len;
 }
 
+uint32_t _pkt_get_smss(const gnrc_tcp_tcb_t *tcb)
+{
+    return (tcb->mss < CONFIG_GNRC_TCP_MSS) ? tcb->mss : CONFIG_GNRC_TCP_MSS;
+}
+
+/**
+ * @brief Calculates the RTO from the current round trip time estimation.
+ *
+ * @param[in,out] tcb   TCB holding the round trip time estimation.
+ */
+static void _update_rto(gnrc_tcp_tcb_t *tcb)
+{
+    /* Without a measurement: rto is 1 sec (Lower Bound) */
+    if (tcb->srtt == RTO_UNINITIALIZED || tcb->rtt_var == RTO_UNINITIALIZED) {
+        tcb->rto = CONFIG_GNRC_TCP_RTO_LOWER_BOUND;
+    }
+    else {
+        tcb->rto = tcb->srtt + _max(CONFIG_GNRC_TCP_RTO_GRANULARITY, CONFIG_GNRC_TCP_RTO_K * tcb->rtt_var);
+    }
+}
+
+/**
+ * @brief Starts the retransmission timer with the current RTO.
+ *
+ * @param[in,out] tcb   TCB holding the timer.
+ */
+static void _start_retransmit_timer(gnrc_tcp_tcb_t *tcb)
+{
+    /* Perform boundary checks on current RTO before usage */
+    if (tcb->rto < (int32_t) CONFIG_GNRC_TCP_RTO_LOWER_BOUND) {
+        tcb->rto = CONFIG_GNRC_TCP_RTO_LOWER_BOUND;
+    }
+    else if (tcb->rto > (int32_t) CONFIG_GNRC_TCP_RTO_UPPER_BOUND) {
+        tcb->rto = CONFIG_GNRC_TCP_RTO_UPPER_BOUND;
+    }
+
+    /* Setup retransmission timer, msg to TCP thread with ptr to TCB */
+    tcb->msg_tout.type = MSG_TYPE_RETRANSMISSION;
+    tcb->msg_tout.content.ptr = (void *) tcb;
+    xtimer_set_msg(&tcb->tim_tout, tcb->rto, &tcb->msg_tout, gnrc_tcp_pid);
+}
+
 int _pkt_setup_retransmit(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt, const bool retransmit)
 {
     gnrc_pktsnip_t *snp = NULL;
+    tcp_hdr_t *hdr = NULL;
     uint32_t ctl = 0;
     uint32_t len = 0;
 
@@ -361,15 +438,25 @@ int _pkt_setup_retransmit(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt, const bool r
         return -EINVAL;
     }
 
-    /* Check if retransmit queue is full and pkt is not already in retransmit queue */
-    if (tcb->pkt_retransmit != NULL && tcb->pkt_retransmit != pkt) {
-        DEBUG("gnrc_tcp_pkt.c : _pkt_setup_retransmit() : Nothing to do\n");
-        return -ENOMEM;
+    /* If this is a retransmission: Double the rto (Timer Backoff) */
+    if (retransmit) {
+        tcb->rto *= 2;
+
+        /* If the transmission has been tried five times, we assume srtt and rtt_var are bogus */
+        /* New measurements must be taken the next time something is sent. */
+        if (tcb->retries >= 5) {
+            tcb->srtt = RTO_UNINITIALIZED;
+            tcb->rtt_var = RTO_UNINITIALIZED;
+        }
+        tcb->retries += 1;
+        _start_retransmit_timer(tcb);
+        return 0;
     }
 
     /* Extract control bits and segment length */
     LL_SEARCH_SCALAR(pkt, snp, type, GNRC_NETTYPE_TCP);
-    ctl = byteorder_ntohs(((tcp_hdr_t *) snp->data)->off_ctl);
+    hdr = (tcp_hdr_t *) snp->data;
+    ctl = byteorder_ntohs(hdr->off_ctl);
     len = _pkt_get_pay_len(pkt);
 
     /* Check if pkt contains reset or is a pure ACK, return */
@@ -377,76 +464,69 @@ int _pkt_setup_retransmit(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt, const bool r
         return 0;
     }
 
-    /* Assign pkt and increase users: every send attempt consumes a user */
-    tcb->pkt_retransmit = pkt;
-    gnrc_pktbuf_hold(pkt, 1);
-
-    /* RTO adjustment */
-    if (!retransmit) {
-        /* If this is the first transmission: rto is 1 sec (Lower Bound) */
-        if (tcb->srtt == RTO_UNINITIALIZED || tcb->rtt_var == RTO_UNINITIALIZED) {
-            tcb->rto = CONFIG_GNRC_TCP_RTO_LOWER_BOUND;
-        }
-        else {
-            tcb->rto = tcb->srtt + _max(CONFIG_GNRC_TCP_RTO_GRANULARITY, CONFIG_GNRC_TCP_RTO_K * tcb->rtt_var);
-        }
+    /* Check if retransmit queue is full */
+    if (tcb->rtx_len >= ARRAY_SIZE(tcb->rtx)) {
+        DEBUG("gnrc_tcp_pkt.c : _pkt_setup_retransmit() : Retransmit queue is full\n");
+        return -ENOMEM;
     }
-    else {
-        /* If this is a retransmission: Double the rto (Timer Backoff) */
-        tcb->rto *= 2;
 
-        /* If the transmission has been tried five times, we assume srtt and rtt_var are bogus */
-        /* New measurements must be taken the next time something is sent. */
-        if (tcb->retries >= 5) {
-            tcb->srtt = RTO_UNINITIALIZED;
-            tcb->rtt_var = RTO_UNINITIALIZED;
-        }
-    }
+    /* Append pkt and increase users: every send attempt consumes a user */
+    gnrc_tcp_rtx_t *rtx = &tcb->rtx[tcb->rtx_len++];
+    rtx->pkt = pkt;
+    rtx->seq = byteorder_ntohl(hdr->seq_num);
+    rtx->len = _pkt_get_seg_len(pkt);
+    rtx->flags = 0;
+    gnrc_pktbuf_hold(pkt, 1);
 
-    /* Perform boundary checks on current RTO before usage */
-    if (tcb->rto < (int32_t) CONFIG_GNRC_TCP_RTO_LOWER_BOUND) {
-        tcb->rto = CONFIG_GNRC_TCP_RTO_LOWER_BOUND;
+    /* The timer runs for the oldest segment: start it if the queue was empty */
+    if (tcb->rtx_len == 1) {
+        _update_rto(tcb);
+        _start_retransmit_timer(tcb);
     }
-    else if (tcb->rto > (int32_t) CONFIG_GNRC_TCP_RTO_UPPER_BOUND) {
-        tcb->rto = CONFIG_GNRC_TCP_RTO_UPPER_BOUND;
-    }
-
-    /* Setup retransmission timer, msg to TCP thread with ptr to TCB */
-    tcb->msg_tout.type = MSG_TYPE_RETRANSMISSION;
-    tcb->msg_tout.content.ptr = (void *) tcb;
-    xtimer_set_msg(&tcb->tim_tout, tcb->rto, &tcb->msg_tout, gnrc_tcp_pid);
     return 0;
 }
 
+int _pkt_resend(gnrc_tcp_tcb_t *tcb, gnrc_tcp_rtx_t *rtx)
+{
+    /* Round trip time of retransmitted segments is ambiguous (Karns Algorithm) */
+    tcb->status &= ~STATUS_RTT_PENDING;
+    rtx->flags = (rtx->flags & ~RTX_FLAG_PENDING) | RTX_FLAG_RESENT;
+
+    /* Every send attempt consumes a user */
+    gnrc_pktbuf_hold(rtx->pkt, 1);
+    return _pkt_send(tcb, rtx->pkt, 0, true);
+}
+
 int _pkt_acknowledge(gnrc_tcp_tcb_t *tcb, const uint32_t ack)
 {
-    uint32_t seg = 0;
-    gnrc_pktsnip_t *snp = NULL;
-    tcp_hdr_t *hdr;
+    uint8_t acked = 0;
 
     /* Retransmission queue is empty. Nothing to ACK there */
-    if (tcb->pkt_retransmit == NULL) {
+    if (tcb->rtx_len == 0) {
         DEBUG("gnrc_tcp_pkt.c : _pkt_acknowledge() : There is no packet to ack\n");
         return -ENODATA;
     }
 
-    LL_SEARCH_SCALAR(tcb->pkt_retransmit, snp, type, GNRC_NETTYPE_TCP);
-    hdr = (tcp_hdr_t *) snp->data;
-
-    /* There must be a packet, waiting to be acknowledged. */
-    seg = byteorder_ntohl(hdr->seq_num) + _pkt_get_seg_len(tcb->pkt_retransmit) - 1;
-
-    /* If segment can be acknowledged -> stop timer, release packet from pktbuf and update rto. */
-    if (LSS_32_BIT(seg, ack)) {
-        xtimer_remove(&(tcb->tim_tout));
-        gnrc_pktbuf_release(tcb->pkt_retransmit);
-        tcb->pkt_retransmit = NULL;
+    /* Release all segments that were acknowledged completely */
+    while (acked < tcb->rtx_len &&
+           LEQ_32_BIT(tcb->rtx[acked].seq + tcb->rtx[acked].len, ack)) {
+        gnrc_pktbuf_release(tcb->rtx[acked].pkt);
+        acked++;
+    }
+    if (acked == 0) {
+        return 0;
+    }
+    tcb->rtx_len -= acked;
+    memmove(tcb->rtx, &tcb->rtx[acked], tcb->rtx_len * sizeof(tcb->rtx[0]));
+    tcb->retries = 0;
 
-        /* Measure round trip time */
+    /* Measure round trip time, if the measured segment was not retransmitted */
+    if ((tcb->status & STATUS_RTT_PENDING) && LEQ_32_BIT(tcb->rtt_seq, ack)) {
         int32_t rtt = xtimer_now().ticks32 - tcb->rtt_start;
 
-        /* Use time only if there was no timer overflow and no retransmission (Karns Algorithm) */
-        if (tcb->retries == 0 && rtt > 0) {
+        tcb->status &= ~STATUS_RTT_PENDING;
+        /* Use time only if there was no timer overflow */
+        if (rtt > 0) {
             /* If this is the first sample taken */
             if (tcb->srtt == RTO_UNINITIALIZED && tcb->rtt_var == RTO_UNINITIALIZED) {
                 tcb->srtt = rtt;
@@ -459,11 +539,29 @@ int _pkt_acknowledge(gnrc_tcp_tcb_t *tcb, const uint32_t ack)
                 tcb->srtt = (tcb->srtt / CONFIG_GNRC_TCP_RTO_A_DIV) * (CONFIG_GNRC_TCP_RTO_A_DIV-1);
                 tcb->srtt += rtt / CONFIG_GNRC_TCP_RTO_A_DIV;
             }
+            _update_rto(tcb);
         }
     }
+
+    /* Restart the timer for the oldest segment left (see RFC 6298, section 5.3) */
+    xtimer_remove(&(tcb->tim_tout));
+    if (tcb->rtx_len > 0) {
+        _start_retransmit_timer(tcb);
+    }
     return 0;
 }
 
+void _pkt_sack(gnrc_tcp_tcb_t *tcb, const uint32_t left, const uint32_t right)
+{
+    for (unsigned i = 0; i < tcb->rtx_len; i++) {
+        gnrc_tcp_rtx_t *rtx = &tcb->rtx[i];
+
+        if (LEQ_32_BIT(left, rtx->seq) && LEQ_32_BIT(rtx->seq + rtx->len, right)) {
+            rtx->flags |= RTX_FLAG_SACKED;
+        }
+    }
+}
+
 uint16_t _pkt_calc_csum(const gnrc_pktsnip_t *hdr, const gnrc_pktsnip_t *pseudo_hdr,
                         const gnrc_pktsnip_t *payload)
 {
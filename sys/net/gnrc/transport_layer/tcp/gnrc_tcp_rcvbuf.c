@@ -15,87 +15,104 @@
  *
  * @author      Simon Brummer <simon.brummer@posteo.de>
  */
-#include <errno.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "kernel_defines.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/tcp.h"
+#include "utlist.h"
+#include "internal/common.h"
 #include "internal/rcvbuf.h"
 
 #define ENABLE_DEBUG (0)
 #include "debug.h"
 
-/**
- * @brief Internal struct holding receive buffers.
- */
-rcvbuf_t _static_buf;
-
-/**
- * @brief Initializes all receive buffers.
- */
-void _rcvbuf_init(void)
+void _rcvbuf_init(gnrc_tcp_tcb_t *tcb)
 {
     DEBUG("gnrc_tcp_rcvbuf.c : _rcvbuf_init() : entry\n");
-    mutex_init(&(_static_buf.lock));
-    for (size_t i = 0; i < CONFIG_GNRC_TCP_RCV_BUFFERS; ++i) {
-        _static_buf.entries[i].used = 0;
-    }
-}
+    _rcvbuf_release_buffer(tcb);
+    tcb->rcv_buf_size = tcb->rcv_buf_min;
+    tcb->rcv_wnd = tcb->rcv_buf_size;
 
-/**
- * @brief Allocate receive buffer.
- *
- * @returns   Not NULL if a receive buffer was allocated.
- *            NULL if allocation failed.
- */
-static void* _rcvbuf_alloc(void)
-{
-    void *result = NULL;
-    DEBUG("gnrc_tcp_rcvbuf.c : _rcvbuf_alloc() : Entry\n");
-    mutex_lock(&(_static_buf.lock));
-    for (size_t i = 0; i < CONFIG_GNRC_TCP_RCV_BUFFERS; ++i) {
-        if (_static_buf.entries[i].used == 0) {
-            _static_buf.entries[i].used = 1;
-            result = (void *)(_static_buf.entries[i].buffer);
-            break;
+    /* Smallest scale that allows to announce the maximum buffer size */
+    tcb->rcv_wscale = 0;
+    if (!IS_ACTIVE(CONFIG_GNRC_TCP_WITHOUT_WSCALE)) {
+        while ((tcb->rcv_wscale < TCP_OPTION_WS_MAX) &&
+               ((tcb->rcv_buf_max >> tcb->rcv_wscale) > UINT16_MAX)) {
+            tcb->rcv_wscale++;
         }
     }
-    mutex_unlock(&(_static_buf.lock));
-    return result;
 }
 
-/**
- * @brief Release allocated receive buffer.
- *
- * @param[in] buf   Pointer to buffer that should be released.
- */
-static void _rcvbuf_free(void * const buf)
+size_t _rcvbuf_add(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt)
 {
-    DEBUG("gnrc_tcp_rcvbuf.c : _rcvbuf_free() : Entry\n");
-    mutex_lock(&(_static_buf.lock));
-    for (size_t i = 0; i < CONFIG_GNRC_TCP_RCV_BUFFERS; ++i) {
-        if ((_static_buf.entries[i].used == 1) && (buf == _static_buf.entries[i].buffer)) {
-            _static_buf.entries[i].used = 0;
-        }
+    uint32_t free = _rcvbuf_get_free(tcb);
+
+    if ((pkt->type != GNRC_NETTYPE_UNDEF) || (free == 0)) {
+        return 0;
     }
-    mutex_unlock(&(_static_buf.lock));
+    /* Cut off data beyond the receive window */
+    if ((pkt->size > free) && (gnrc_pktbuf_realloc_data(pkt, free) != 0)) {
+        DEBUG("gnrc_tcp_rcvbuf.c : _rcvbuf_add() : Can't cut off payload\n");
+        return 0;
+    }
+
+    /* Detach the payload from the headers. The caller releases pkt afterwards,
+     * so the reference of pkt on the headers is released here and the
+     * receive buffer holds its own reference on the payload. */
+    gnrc_pktsnip_t *hdr = pkt->next;
+    pkt->next = NULL;
+    gnrc_pktbuf_hold(pkt, 1);
+    gnrc_pktbuf_release(hdr);
+
+    LL_APPEND(tcb->rcv_buf, pkt);
+    tcb->rcv_buf_len += pkt->size;
+    return pkt->size;
 }
 
-int _rcvbuf_get_buffer(gnrc_tcp_tcb_t *tcb)
+size_t _rcvbuf_get(gnrc_tcp_tcb_t *tcb, void *buf, size_t len)
 {
-    if (tcb->rcv_buf_raw == NULL) {
-        tcb->rcv_buf_raw = _rcvbuf_alloc();
-        if (tcb->rcv_buf_raw == NULL) {
-            DEBUG("gnrc_tcp_rcvbuf.c : _rcvbuf_get_buffer() : Can't allocate rcv_buf_raw\n");
-            return -ENOMEM;
-        }
-        else {
-            ringbuffer_init(&tcb->rcv_buf, (char *) tcb->rcv_buf_raw, GNRC_TCP_RCV_BUF_SIZE);
+    /* The user reads all data of a full buffer at once: The receive window
+     * limits the peer, not the user. Grow the buffer. */
+    bool grow = (_rcvbuf_get_free(tcb) < CONFIG_GNRC_TCP_MSS) && (len >= tcb->rcv_buf_len);
+    size_t rcvd = 0;
+
+    while ((tcb->rcv_buf != NULL) && (rcvd < len)) {
+        gnrc_pktsnip_t *snp = tcb->rcv_buf;
+        size_t num = snp->size - tcb->rcv_buf_off;
+
+        num = (num < (len - rcvd)) ? num : (len - rcvd);
+        memcpy((uint8_t *)buf + rcvd, (uint8_t *)snp->data + tcb->rcv_buf_off, num);
+        rcvd += num;
+        tcb->rcv_buf_off += num;
+
+        /* Release snips that were read completely. Unlink them first, the
+         * release would free the rest of the list along with them. */
+        if (tcb->rcv_buf_off == snp->size) {
+            LL_DELETE(tcb->rcv_buf, snp);
+            snp->next = NULL;
+            gnrc_pktbuf_release(snp);
+            tcb->rcv_buf_off = 0;
         }
     }
-    return 0;
+    tcb->rcv_buf_len -= rcvd;
+
+    if (grow && (tcb->rcv_buf_size < tcb->rcv_buf_max)) {
+        tcb->rcv_buf_size = (tcb->rcv_buf_size < (tcb->rcv_buf_max / 2))
+                          ? (tcb->rcv_buf_size * 2) : tcb->rcv_buf_max;
+        DEBUG("gnrc_tcp_rcvbuf.c : _rcvbuf_get() : Receive buffer grows to %"PRIu32"\n",
+              tcb->rcv_buf_size);
+    }
+    return rcvd;
 }
 
 void _rcvbuf_release_buffer(gnrc_tcp_tcb_t *tcb)
 {
-    if (tcb->rcv_buf_raw != NULL) {
-        _rcvbuf_free(tcb->rcv_buf_raw);
-        tcb->rcv_buf_raw = NULL;
+    if (tcb->rcv_buf != NULL) {
+        gnrc_pktbuf_release(tcb->rcv_buf);
+        tcb->rcv_buf = NULL;
     }
+    tcb->rcv_buf_len = 0;
+    tcb->rcv_buf_off = 0;
 }
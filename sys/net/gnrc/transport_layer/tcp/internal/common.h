@@ -47,6 +47,21 @@ extern "C" {
 #define STATUS_ALLOW_ANY_ADDR (1 << 1)
 #define STATUS_NOTIFY_USER    (1 << 2)
 #define STATUS_WAIT_FOR_MSG   (1 << 3)
+#define STATUS_SACK_PERMITTED (1 << 4)
+#define STATUS_FAST_RECOVERY  (1 << 5)
+#define STATUS_RTT_PENDING    (1 << 6)
+#define STATUS_WSCALE         (1 << 7)
+#define STATUS_LISTEN         (1 << 8)
+#define STATUS_RELISTEN       (1 << 9)
+/** @} */
+
+/**
+ * @brief Flags of a segment in the retransmission queue.
+ * @{
+ */
+#define RTX_FLAG_SACKED  (1 << 0)   /**< Segment was selectively acknowledged */
+#define RTX_FLAG_PENDING (1 << 1)   /**< Segment must be retransmitted */
+#define RTX_FLAG_RESENT  (1 << 2)   /**< Segment was retransmitted in fast recovery */
 /** @} */
 
 /**
@@ -102,7 +117,7 @@ extern "C" {
 #define LSS_32_BIT(x, y) (((int32_t) (x)) - ((int32_t) (y)) <  0)
 #define LEQ_32_BIT(x, y) (((int32_t) (x)) - ((int32_t) (y)) <= 0)
 #define GRT_32_BIT(x, y) (!LEQ_32_BIT(x, y))
-#define GEQ_32_BIT(x, y) (!LSS_32_BOT(x, y))
+#define GEQ_32_BIT(x, y) (!LSS_32_BIT(x, y))
 /** @} */
 
 /**
@@ -42,6 +42,31 @@ static inline uint32_t _option_build_mss(uint16_t mss)
             ((uint32_t) TCP_OPTION_LENGTH_MSS << 16) | mss);
 }
 
+/**
+ * @brief Helper function to build the SACK permitted option.
+ * @returns   SACK permitted option value, padded to four bytes.
+ */
+static inline uint32_t _option_build_sack_perm(void)
+{
+    return (((uint32_t) TCP_OPTION_KIND_NOP << 24) |
+            ((uint32_t) TCP_OPTION_KIND_NOP << 16) |
+            ((uint32_t) TCP_OPTION_KIND_SACK_PERM << 8) | TCP_OPTION_LENGTH_SACK_PERM);
+}
+
+/**
+ * @brief Helper function to build the window scale option.
+ *
+ * @param[in] shift   Shift count of the receive window.
+ *
+ * @returns   Window scale option value, padded to four bytes.
+ */
+static inline uint32_t _option_build_wscale(uint8_t shift)
+{
+    return (((uint32_t) TCP_OPTION_KIND_NOP << 24) |
+            ((uint32_t) TCP_OPTION_KIND_WS << 16) |
+            ((uint32_t) TCP_OPTION_LENGTH_WS << 8) | shift);
+}
+
 /**
  * @brief Helper function to build the combined option and control flag field.
  *
@@ -59,6 +84,9 @@ static inline uint16_t _option_build_offset_control(uint16_t nopts, uint16_t ctl
 /**
  * @brief Parses options of a given TCP header.
  *
+ * SACK options mark the reported segments in the retransmission queue of
+ * @p tcb. Window scale options are only accepted on SYN segments.
+ *
  * @param[in,out] tcb   TCB holding the connection information.
  * @param[in]     hdr   TCP header to be parsed.
  *
@@ -105,9 +105,23 @@ uint32_t _pkt_get_seg_len(gnrc_pktsnip_t *pkt);
  */
 uint32_t _pkt_get_pay_len(gnrc_pktsnip_t *pkt);
 
+/**
+ * @brief Calculates the maximum segment size used for sending.
+ *
+ * @param[in] tcb   TCB holding the connection information.
+ *
+ * @returns   The smaller one of the peers MSS and CONFIG_GNRC_TCP_MSS.
+ */
+uint32_t _pkt_get_smss(const gnrc_tcp_tcb_t *tcb);
+
 /**
  * @brief Adds a packet to the retransmission mechanism.
  *
+ * If @p retransmit is not set, @p pkt is appended to the retransmission queue
+ * and the retransmission timer is started if the queue was empty. If
+ * @p retransmit is set, the retransmission timer of @p pkt expired: the
+ * timeout is doubled and the timer restarted.
+ *
  * @param[in,out] tcb          TCB holding the connection information.
  * @param[in]     pkt          Packet to add to the retransmission mechanism.
  * @param[in]     retransmit   Flag used to indicate that @p pkt is a retransmit.
@@ -119,7 +133,20 @@ uint32_t _pkt_get_pay_len(gnrc_pktsnip_t *pkt);
 int _pkt_setup_retransmit(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt, const bool retransmit);
 
 /**
- * @brief Acknowledges and removes packet from the retransmission mechanism.
+ * @brief Sends a segment of the retransmission queue again.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ * @param[in,out] rtx   Segment to send, must be in the retransmission queue of @p tcb.
+ *
+ * @returns   Zero on success.
+ */
+int _pkt_resend(gnrc_tcp_tcb_t *tcb, gnrc_tcp_rtx_t *rtx);
+
+/**
+ * @brief Acknowledges and removes packets from the retransmission mechanism.
+ *
+ * Removes all segments acknowledged completely by @p ack. If segments are
+ * left, the retransmission timer is restarted for the oldest of them.
  *
  * @param[in,out] tcb   TCB holding the connection information.
  * @param[in]     ack   Acknowldegment number used to acknowledge packets.
@@ -129,6 +156,15 @@ int _pkt_setup_retransmit(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt, const bool r
  */
 int _pkt_acknowledge(gnrc_tcp_tcb_t *tcb, const uint32_t ack);
 
+/**
+ * @brief Marks packets in the retransmission queue as selectively acknowledged.
+ *
+ * @param[in,out] tcb     TCB holding the connection information.
+ * @param[in]     left    Left edge of the SACK block.
+ * @param[in]     right   Right edge of the SACK block.
+ */
+void _pkt_sack(gnrc_tcp_tcb_t *tcb, const uint32_t left, const uint32_t right);
+
 /**
  * @brief Calculates checksum over payload, TCP header and network layer header.
  *
@@ -12,7 +12,7 @@
  * @{
  *
  * @file
- * @brief       Functions for allocating and freeing the receive buffer.
+ * @brief       Functions for handling the receive buffer of a connection.
  *
  * @author      Simon Brummer <simon.brummer@posteo.de>
  */
@@ -20,9 +20,9 @@
 #ifndef RCVBUF_H
 #define RCVBUF_H
 
+#include <stddef.h>
 #include <stdint.h>
-#include "mutex.h"
-#include "net/gnrc/tcp/config.h"
+#include "net/gnrc/pkt.h"
 #include "net/gnrc/tcp/tcb.h"
 
 #ifdef __cplusplus
@@ -30,40 +30,62 @@ extern "C" {
 #endif
 
 /**
- * @brief Receive buffer entry.
+ * @brief Initializes the receive buffer of a TCB for a new connection.
+ *
+ * Sets the window scale offered to the peer and opens the receive window.
+ *
+ * @param[in,out] tcb   TCB holding the receive buffer.
  */
-typedef struct rcvbuf_entry {
-    uint8_t used;                          /**< Flag: Is buffer in use? */
-    uint8_t buffer[GNRC_TCP_RCV_BUF_SIZE]; /**< Receive buffer storage */
-} rcvbuf_entry_t;
+void _rcvbuf_init(gnrc_tcp_tcb_t *tcb);
 
 /**
- * @brief   Struct holding receive buffers.
+ * @brief Appends the payload of a received segment to the receive buffer.
+ *
+ * The payload is kept in the packet buffer until it is read, without copying
+ * it. It is detached from the headers of @p pkt and the headers are released,
+ * so they must not be accessed afterwards. Releasing @p pkt is still up to the
+ * caller. Data that exceeds the receive window is cut off.
+ *
+ * @pre The payload is the first snip of @p pkt and was write-protected.
+ *
+ * @param[in,out] tcb   TCB holding the receive buffer.
+ * @param[in,out] pkt   Received segment, payload first.
+ *
+ * @returns   Number of bytes added to the receive buffer.
  */
-typedef struct rcvbuf {
-    mutex_t lock;                                 /**< Lock for allocation synchronization */
-    rcvbuf_entry_t entries[CONFIG_GNRC_TCP_RCV_BUFFERS]; /**< Maintained receive buffers */
-} rcvbuf_t;
+size_t _rcvbuf_add(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt);
 
 /**
- * @brief   Initializes global receive buffer.
+ * @brief Reads data from the receive buffer.
+ *
+ * Snips that were read completely are released. If a full receive buffer is
+ * read at once, the receive window limits the peer and the buffer doubles, up
+ * to gnrc_tcp_tcb_t::rcv_buf_max.
+ *
+ * @param[in,out] tcb   TCB holding the receive buffer.
+ * @param[out]    buf   Buffer to read into.
+ * @param[in]     len   Maximum number of bytes to read.
+ *
+ * @returns   Number of bytes read into @p buf.
  */
-void _rcvbuf_init(void);
+size_t _rcvbuf_get(gnrc_tcp_tcb_t *tcb, void *buf, size_t len);
 
 /**
- * @brief Allocate receive buffer and assign it to TCB.
+ * @brief Gets the free space of the receive buffer.
  *
- * @param[in,out] tcb   TCB that acquires receive buffer.
+ * @param[in] tcb   TCB holding the receive buffer.
  *
- * @returns   Zero  on success.
- *            -ENOMEM if all receive buffers are currently used.
+ * @returns   Number of bytes that can be received.
  */
-int _rcvbuf_get_buffer(gnrc_tcp_tcb_t *tcb);
+static inline uint32_t _rcvbuf_get_free(const gnrc_tcp_tcb_t *tcb)
+{
+    return tcb->rcv_buf_size - tcb->rcv_buf_len;
+}
 
 /**
- * @brief Release allocated receive buffer.
+ * @brief Releases all data in the receive buffer.
  *
- * @param[in,out] tcb   TCB holding the receive buffer that should be released.
+ * @param[in,out] tcb   TCB holding the receive buffer.
  */
 void _rcvbuf_release_buffer(gnrc_tcp_tcb_t *tcb);
 
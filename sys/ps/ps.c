@@ -15,6 +15,7 @@
  * @}
  */
 
+#include <inttypes.h>
 #include <stdio.h>
 
 #include "thread.h"
@@ -26,6 +27,10 @@
 #include "schedstatistics.h"
 #endif
 
+#ifdef MODULE_SCHEDLATENCY
+#include "schedlatency.h"
+#endif
+
 #ifdef MODULE_TLSF_MALLOC
 #include "tlsf.h"
 #include "tlsf-malloc.h"
@@ -68,6 +73,9 @@ void ps(void)
 #endif
 #ifdef MODULE_SCHEDSTATISTICS
            "| runtime  | switches"
+#endif
+#ifdef MODULE_SCHEDLATENCY
+           "| lat thr  | lat isr "
 #endif
            "\n",
 #ifdef DEVELHELP
@@ -116,6 +124,10 @@ void ps(void)
             unsigned runtime_major = runtime_ticks / rt_sum;
             unsigned runtime_minor = ((runtime_ticks % rt_sum) * 1000) / rt_sum;
             unsigned switches = sched_pidlist[i].schedules;
+#endif
+#ifdef MODULE_SCHEDLATENCY
+            uint32_t lat_thread = schedlatency_mean(&sched_latency[i].thread);
+            uint32_t lat_isr = schedlatency_mean(&sched_latency[i].isr);
 #endif
             printf("\t%3" PRIkernel_pid
 #ifdef DEVELHELP
@@ -127,6 +139,9 @@ void ps(void)
 #endif
 #ifdef MODULE_SCHEDSTATISTICS
                    " | %2d.%03d%% |  %8u"
+#endif
+#ifdef MODULE_SCHEDLATENCY
+                   " | %8" PRIu32 " | %8" PRIu32
 #endif
                    "\n",
                    p->pid,
@@ -139,6 +154,9 @@ void ps(void)
 #endif
 #ifdef MODULE_SCHEDSTATISTICS
                    , runtime_major, runtime_minor, switches
+#endif
+#ifdef MODULE_SCHEDLATENCY
+                   , lat_thread, lat_isr
 #endif
                   );
         }
@@ -155,4 +173,8 @@ void ps(void)
     printf("\tTotal used size: %u\n", sizes.used);
 #   endif
 #endif
+#ifdef MODULE_SCHEDLATENCY
+    puts("\nScheduling latency [" SCHEDLATENCY_UNIT "]:");
+    schedlatency_print();
+#endif
 }
@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     schedlatency
+ * @{
+ *
+ * @file
+ * @brief       Scheduling latency statistics implementation
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "bitarithm.h"
+#include "cpu.h"
+#include "irq.h"
+#include "sched.h"
+#include "schedlatency.h"
+#include "thread.h"
+#if !defined(SCHEDLATENCY_DWT) && !defined(SCHEDLATENCY_TSC)
+#include "xtimer.h"
+#endif
+
+schedlatency_t sched_latency[KERNEL_PID_LAST + 1];
+
+static inline uint32_t _now(void)
+{
+#if defined(SCHEDLATENCY_DWT)
+    return DWT->CYCCNT;
+#elif defined(SCHEDLATENCY_TSC)
+    return (uint32_t)__builtin_ia32_rdtsc();
+#else
+    return xtimer_now().ticks32;
+#endif
+}
+
+static unsigned _bucket(uint32_t latency)
+{
+    unsigned bucket;
+
+    if (latency == 0) {
+        return 0;
+    }
+    if (sizeof(unsigned) >= sizeof(uint32_t)) {
+        bucket = bitarithm_msb(latency);
+    }
+    else {
+        for (bucket = 0; latency >>= 1; bucket++) {}
+    }
+    return (bucket < CONFIG_SCHEDLATENCY_BUCKETS)
+           ? bucket
+           : (CONFIG_SCHEDLATENCY_BUCKETS - 1);
+}
+
+static void _record(schedlatency_hist_t *hist, uint32_t latency)
+{
+    uint16_t *bucket = &hist->buckets[_bucket(latency)];
+
+    hist->count++;
+    hist->sum += latency;
+    if (latency > hist->max) {
+        hist->max = latency;
+    }
+    if (*bucket < UINT16_MAX) {
+        (*bucket)++;
+    }
+}
+
+void schedlatency_woken(kernel_pid_t pid)
+{
+    schedlatency_t *lat = &sched_latency[pid];
+
+    lat->woken = _now();
+    lat->pending = (irq_is_in()) ? 2 : 1;
+}
+
+void schedlatency_scheduled(kernel_pid_t pid)
+{
+    schedlatency_t *lat = &sched_latency[pid];
+
+    if (lat->pending) {
+        _record((lat->pending == 2) ? &lat->isr : &lat->thread,
+                _now() - lat->woken);
+        lat->pending = 0;
+    }
+}
+
+void init_schedlatency(void)
+{
+#if defined(SCHEDLATENCY_DWT)
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+}
+
+void schedlatency_reset(void)
+{
+    unsigned state = irq_disable();
+
+    memset(sched_latency, 0, sizeof(sched_latency));
+    irq_restore(state);
+}
+
+static void _print_hist(kernel_pid_t pid, const char *source,
+                        const schedlatency_hist_t *hist)
+{
+    if (hist->count == 0) {
+        return;
+    }
+    printf("\t%3" PRIkernel_pid " | %-6s | %8" PRIu32 " | %8" PRIu32
+           " | %8" PRIu32 " |", pid, source, hist->count,
+           schedlatency_mean(hist), hist->max);
+    for (unsigned i = 0; i < CONFIG_SCHEDLATENCY_BUCKETS; i++) {
+        printf(" %u", hist->buckets[i]);
+    }
+    puts("");
+}
+
+void schedlatency_print(void)
+{
+    printf("\tpid | source |    count |     mean |      max | "
+           "histogram [2^n " SCHEDLATENCY_UNIT "]\n");
+    for (kernel_pid_t i = KERNEL_PID_FIRST; i <= KERNEL_PID_LAST; i++) {
+        if (sched_threads[i] != NULL) {
+            _print_hist(i, "thread", &sched_latency[i].thread);
+            _print_hist(i, "isr", &sched_latency[i].isr);
+        }
+    }
+}
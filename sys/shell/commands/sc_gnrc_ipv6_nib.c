@@ -13,9 +13,11 @@
  * @author  Martine Lenders <m.lenders@fu-berlin.de>
  */
 
+#include <inttypes.h>
 #include <stdio.h>
 #include <kernel_defines.h>
 
+#include "net/gnrc/ipv6.h"
 #include "net/gnrc/ipv6/nib.h"
 #include "net/gnrc/netif.h"
 #include "net/ipv6/addr.h"
@@ -27,6 +29,10 @@ static int _nib_route(int argc, char **argv);
 #if IS_ACTIVE(CONFIG_GNRC_IPV6_NIB_MULTIHOP_P6C)
 static int _nib_abr(int argc, char **argv);
 #endif  /* CONFIG_GNRC_IPV6_NIB_MULTIHOP_P6C */
+#if defined(MODULE_GNRC_IPV6) && (CONFIG_GNRC_IPV6_ROUTE_CACHE_SIZE > 0)
+#define NIB_ROUTE_CACHE     (1)
+static int _nib_cache(int argc, char **argv);
+#endif
 
 int _gnrc_ipv6_nib(int argc, char **argv)
 {
@@ -50,6 +56,11 @@ int _gnrc_ipv6_nib(int argc, char **argv)
         res = _nib_abr(argc, argv);
     }
 #endif  /* CONFIG_GNRC_IPV6_NIB_MULTIHOP_P6C */
+#ifdef NIB_ROUTE_CACHE
+    else if (strcmp(argv[1], "cache") == 0) {
+        res = _nib_cache(argc, argv);
+    }
+#endif  /* NIB_ROUTE_CACHE */
     else {
         _usage(argv);
     }
@@ -58,11 +69,14 @@ int _gnrc_ipv6_nib(int argc, char **argv)
 
 static void _usage(char **argv)
 {
+    printf("usage: %s {neigh|prefix|route"
 #if IS_ACTIVE(CONFIG_GNRC_IPV6_NIB_MULTIHOP_P6C)
-    printf("usage: %s {neigh|prefix|route|abr|help} ...\n", argv[0]);
-#else   /* CONFIG_GNRC_IPV6_NIB_MULTIHOP_P6C */
-    printf("usage: %s {neigh|prefix|route|help} ...\n", argv[0]);
+           "|abr"
 #endif  /* CONFIG_GNRC_IPV6_NIB_MULTIHOP_P6C */
+#ifdef NIB_ROUTE_CACHE
+           "|cache"
+#endif  /* NIB_ROUTE_CACHE */
+           "|help} ...\n", argv[0]);
 }
 
 static void _usage_nib_neigh(char **argv)
@@ -295,6 +309,23 @@ static int _nib_route(int argc, char **argv)
     return 0;
 }
 
+#ifdef NIB_ROUTE_CACHE
+static int _nib_cache(int argc, char **argv)
+{
+    if ((argc == 2) || (strcmp(argv[2], "show") == 0)) {
+        gnrc_ipv6_route_cache_stats_t stats;
+
+        gnrc_ipv6_route_cache_get_stats(&stats);
+        printf("Route cache: %u entries, %" PRIu32 " hits, %" PRIu32
+               " misses\n", (unsigned)CONFIG_GNRC_IPV6_ROUTE_CACHE_SIZE,
+               stats.hits, stats.misses);
+        return 0;
+    }
+    printf("usage: %s %s [show|help]\n", argv[0], argv[1]);
+    return (strcmp(argv[2], "help") == 0) ? 0 : 1;
+}
+#endif  /* NIB_ROUTE_CACHE */
+
 #if IS_ACTIVE(CONFIG_GNRC_IPV6_NIB_MULTIHOP_P6C)
 static void _usage_nib_abr(char **argv)
 {
@@ -128,7 +128,7 @@ static int _netif_stats(netif_t *iface, unsigned module, bool reset)
         printf("          Statistics for %s\n"
                "            RX packets %u  bytes %u\n"
                "            TX packets %u (Multicast: %u)  bytes %u\n"
-               "            TX succeeded %u errors %u\n",
+               "            TX succeeded %u errors %u dropped %u\n",
                _netstats_module_to_str(module),
                (unsigned) stats->rx_count,
                (unsigned) stats->rx_bytes,
@@ -136,7 +136,8 @@ static int _netif_stats(netif_t *iface, unsigned module, bool reset)
                (unsigned) stats->tx_mcast_count,
                (unsigned) stats->tx_bytes,
                (unsigned) stats->tx_success,
-               (unsigned) stats->tx_failed);
+               (unsigned) stats->tx_failed,
+               (unsigned) stats->tx_dropped);
         res = 0;
     }
     return res;
@@ -31,6 +31,9 @@
 #include "pm_layered.h"
 #endif
 #include "ztimer.h"
+#ifdef MODULE_ZTIMER_WHEEL
+#include "ztimer/wheel.h"
+#endif
 
 #define ENABLE_DEBUG (0)
 #include "debug.h"
@@ -49,12 +52,17 @@ static inline uint32_t _min_u32(uint32_t a, uint32_t b)
 
 static unsigned _is_set(const ztimer_clock_t *clock, const ztimer_t *t)
 {
+#ifdef MODULE_ZTIMER_WHEEL
+    (void)clock;
+    return ztimer_wheel_is_set(&t->base);
+#else
     if (!clock->list.next) {
         return 0;
     }
     else {
         return (t->base.next || &t->base == clock->last);
     }
+#endif
 }
 
 void ztimer_remove(ztimer_clock_t *clock, ztimer_t *timer)
@@ -93,7 +101,12 @@ void ztimer_set(ztimer_clock_t *clock, ztimer_t *timer, uint32_t val)
 
     timer->base.offset = val;
     _add_entry_to_list(clock, &timer->base);
-    if (clock->list.next == &timer->base) {
+    if (IS_USED(MODULE_ZTIMER_WHEEL)) {
+        /* the wheel does not know which timer was next before, so always
+         * update the clock */
+        _ztimer_update(clock);
+    }
+    else if (clock->list.next == &timer->base) {
 #ifdef MODULE_ZTIMER_EXTEND
         if (clock->max_value < UINT32_MAX) {
             val = _min_u32(val, clock->max_value >> 1);
@@ -106,6 +119,19 @@ void ztimer_set(ztimer_clock_t *clock, ztimer_t *timer, uint32_t val)
     irq_restore(state);
 }
 
+#ifdef MODULE_ZTIMER_WHEEL
+static void _add_entry_to_list(ztimer_clock_t *clock, ztimer_base_t *entry)
+{
+#ifdef MODULE_PM_LAYERED
+    /* First timer on the clock */
+    if (ztimer_wheel_is_empty(clock) &&
+        clock->required_pm_mode != ZTIMER_CLOCK_NO_REQUIRED_PM_MODE) {
+        pm_block(clock->required_pm_mode);
+    }
+#endif
+    ztimer_wheel_add(clock, entry, entry->offset);
+}
+#else   /* MODULE_ZTIMER_WHEEL */
 static void _add_entry_to_list(ztimer_clock_t *clock, ztimer_base_t *entry)
 {
     uint32_t delta_sum = 0;
@@ -144,6 +170,7 @@ static void _add_entry_to_list(ztimer_clock_t *clock, ztimer_base_t *entry)
           entry->offset);
 
 }
+#endif  /* MODULE_ZTIMER_WHEEL */
 
 static uint32_t _add_modulo(uint32_t a, uint32_t b, uint32_t mod)
 {
@@ -173,6 +200,52 @@ ztimer_now_t _ztimer_now_extend(ztimer_clock_t *clock)
 }
 #endif /* MODULE_ZTIMER_EXTEND */
 
+#ifdef MODULE_ZTIMER_WHEEL
+void ztimer_update_head_offset(ztimer_clock_t *clock)
+{
+    uint32_t now = ztimer_now(clock);
+
+    ztimer_wheel_advance(clock, now - clock->list.offset);
+}
+
+static void _del_entry_from_list(ztimer_clock_t *clock, ztimer_base_t *entry)
+{
+    DEBUG("_del_entry_from_list()\n");
+    ztimer_wheel_del(clock, entry);
+
+#ifdef MODULE_PM_LAYERED
+    /* The last timer just got removed from the clock */
+    if (ztimer_wheel_is_empty(clock) &&
+        clock->required_pm_mode != ZTIMER_CLOCK_NO_REQUIRED_PM_MODE) {
+        pm_unblock(clock->required_pm_mode);
+    }
+#endif
+}
+
+static ztimer_t *_now_next(ztimer_clock_t *clock)
+{
+    ztimer_base_t *entry = ztimer_wheel_pop(clock);
+
+#ifdef MODULE_PM_LAYERED
+    /* The last timer just got removed from the clock */
+    if (entry && ztimer_wheel_is_empty(clock) &&
+        clock->required_pm_mode != ZTIMER_CLOCK_NO_REQUIRED_PM_MODE) {
+        pm_unblock(clock->required_pm_mode);
+    }
+#endif
+    return (ztimer_t *)entry;
+}
+
+static int _next_offset(const ztimer_clock_t *clock, uint32_t *offset)
+{
+    return ztimer_wheel_next(clock, offset);
+}
+
+static void _advance(ztimer_clock_t *clock, uint32_t offset)
+{
+    ztimer_wheel_advance(clock, offset);
+}
+#else   /* MODULE_ZTIMER_WHEEL */
 void ztimer_update_head_offset(ztimer_clock_t *clock)
 {
     uint32_t old_base = clock->list.offset;
@@ -275,14 +348,32 @@ static ztimer_t *_now_next(ztimer_clock_t *clock)
     }
 }
 
+static int _next_offset(const ztimer_clock_t *clock, uint32_t *offset)
+{
+    if (!clock->list.next) {
+        return 0;
+    }
+    *offset = clock->list.next->offset;
+    return 1;
+}
+
+static void _advance(ztimer_clock_t *clock, uint32_t offset)
+{
+    /* the head has expired */
+    clock->list.offset += offset;
+    clock->list.next->offset = 0;
+}
+#endif  /* MODULE_ZTIMER_WHEEL */
+
 static void _ztimer_update(ztimer_clock_t *clock)
 {
+    uint32_t offset;
+    int set = _next_offset(clock, &offset);
+
 #ifdef MODULE_ZTIMER_EXTEND
     if (clock->max_value < UINT32_MAX) {
-        if (clock->list.next) {
-            clock->ops->set(clock,
-                            _min_u32(clock->list.next->offset,
-                                     clock->max_value >> 1));
+        if (set) {
+            clock->ops->set(clock, _min_u32(offset, clock->max_value >> 1));
         }
         else {
             clock->ops->set(clock, clock->max_value >> 1);
@@ -292,8 +383,8 @@ static void _ztimer_update(ztimer_clock_t *clock)
 #endif
     }
     else {
-        if (clock->list.next) {
-            clock->ops->set(clock, clock->list.next->offset);
+        if (set) {
+            clock->ops->set(clock, offset);
         }
         else {
             clock->ops->cancel(clock);
@@ -303,6 +394,8 @@ static void _ztimer_update(ztimer_clock_t *clock)
 
 void ztimer_handler(ztimer_clock_t *clock)
 {
+    uint32_t offset;
+
     DEBUG("ztimer_handler(): %p now=%" PRIu32 "\n", (void *)clock, clock->ops->now(
               clock));
     if (ENABLE_DEBUG) {
@@ -314,8 +407,8 @@ void ztimer_handler(ztimer_clock_t *clock)
         /* calling now triggers checkpointing */
         uint32_t now = ztimer_now(clock);
 
-        if (clock->list.next) {
-            uint32_t target = clock->list.offset + clock->list.next->offset;
+        if (_next_offset(clock, &offset)) {
+            uint32_t target = clock->list.offset + offset;
             int32_t diff = (int32_t)(target - now);
             if (diff > 0) {
                 DEBUG("ztimer_handler(): %p postponing by %" PRIi32 "\n",
@@ -339,8 +432,12 @@ void ztimer_handler(ztimer_clock_t *clock)
     }
 #endif
 
-    clock->list.offset += clock->list.next->offset;
-    clock->list.next->offset = 0;
+    if (!_next_offset(clock, &offset)) {
+        /* all timers were removed in the meantime */
+        _ztimer_update(clock);
+        return;
+    }
+    _advance(clock, offset);
 
     ztimer_t *entry = _now_next(clock);
     while (entry) {
@@ -381,4 +478,10 @@ static void _ztimer_print(const ztimer_clock_t *clock)
 
     } while ((entry = entry->next));
     puts("");
+#ifdef MODULE_ZTIMER_WHEEL
+    for (unsigned level = 0; level < ZTIMER_WHEEL_LEVELS; level++) {
+        printf("%u:0x%04x ", level, clock->wheel.occupied[level]);
+    }
+    puts("");
+#endif
 }
@@ -0,0 +1,246 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser General
+ * Public License v2.1. See the file LICENSE in the top level directory for more
+ * details.
+ */
+
+/**
+ * @ingroup     sys_ztimer_wheel
+ * @{
+ *
+ * @file
+ * @brief       ztimer timer wheel implementation
+ *
+ * A timer is put into the lowest level in which its target differs from the
+ * clock's base time (`clock->list.offset`), at the slot given by the target's
+ * bits of that level. So all timers of a level share the higher bits with the
+ * base time and the slot of the base time itself is always empty. When the
+ * base time reaches the start of an occupied slot, the slot's timers are put
+ * into the wheel again, which moves them to a lower level or, if their target
+ * is reached, to the expired timers in `clock->list`.
+ *
+ * Every timer is linked with a pointer to the pointer pointing to it, so it
+ * can be removed without walking its slot.
+ *
+ * @}
+ */
+#include <assert.h>
+#include <stdint.h>
+
+#include "bitarithm.h"
+#include "kernel_defines.h"
+#include "ztimer.h"
+#include "ztimer/wheel.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+#if (CONFIG_ZTIMER_WHEEL_BITS < 1) || (CONFIG_ZTIMER_WHEEL_BITS > 4)
+#error "CONFIG_ZTIMER_WHEEL_BITS must be in the range of 1 to 4"
+#endif
+
+#define _BITS           (CONFIG_ZTIMER_WHEEL_BITS)
+#define _SLOT_MASK      (ZTIMER_WHEEL_SLOTS - 1)
+
+/* timers farther away are first put at this distance and moved on from
+ * there, so the top level does not wrap around to the slot of the base time */
+#define _RANGE          (UINT32_MAX >> 1)
+
+static inline unsigned _slot(uint32_t time, unsigned level)
+{
+    return (time >> (level * _BITS)) & _SLOT_MASK;
+}
+
+static inline uint32_t _below(uint32_t time, unsigned level)
+{
+    return time & ((UINT32_C(1) << (level * _BITS)) - 1);
+}
+
+/* distance from slot cur to the next occupied slot, wrapping around */
+static unsigned _next_slot(unsigned occupied, unsigned cur)
+{
+    unsigned rot = occupied >> cur;
+
+    if (cur) {
+        rot |= occupied << (ZTIMER_WHEEL_SLOTS - cur);
+    }
+    return bitarithm_lsb(rot & (~0U >> ((sizeof(unsigned) * 8) -
+                                         ZTIMER_WHEEL_SLOTS)));
+}
+
+static void _link(ztimer_base_t **pprev, ztimer_base_t *entry)
+{
+    entry->next = *pprev;
+    if (entry->next) {
+        entry->next->pprev = &entry->next;
+    }
+    entry->pprev = pprev;
+    *pprev = entry;
+}
+
+static void _expire(ztimer_clock_t *clock, ztimer_base_t *entry)
+{
+    /* keep the expired timers in order by appending */
+    _link(clock->last ? &clock->last->next : &clock->list.next, entry);
+    clock->last = entry;
+}
+
+static void _insert(ztimer_clock_t *clock, ztimer_base_t *entry)
+{
+    uint32_t now = clock->list.offset;
+    uint32_t diff = entry->offset - now;
+    uint32_t target, bits;
+    unsigned level = 0, slot;
+
+    if (diff == 0) {
+        _expire(clock, entry);
+        return;
+    }
+    target = now + ((diff > _RANGE) ? _RANGE : diff);
+    bits = (target ^ now) >> _BITS;
+    while (bits) {
+        bits >>= _BITS;
+        level++;
+    }
+    slot = _slot(target, level);
+    DEBUG("ztimer_wheel: %p at level %u, slot %u\n", (void *)entry, level,
+          slot);
+    _link(&clock->wheel.slots[level][slot], entry);
+    clock->wheel.occupied[level] |= (1U << slot);
+}
+
+static void _cascade(ztimer_clock_t *clock, unsigned level, unsigned slot)
+{
+    ztimer_base_t *entry = clock->wheel.slots[level][slot];
+
+    clock->wheel.slots[level][slot] = NULL;
+    clock->wheel.occupied[level] &= ~(1U << slot);
+    while (entry) {
+        ztimer_base_t *next = entry->next;
+
+        _insert(clock, entry);
+        entry = next;
+    }
+}
+
+/* handles all slots starting at the base time */
+static void _process(ztimer_clock_t *clock)
+{
+    uint32_t now = clock->list.offset;
+
+    for (unsigned level = ZTIMER_WHEEL_LEVELS; level-- > 0;) {
+        unsigned slot = _slot(now, level);
+
+        if ((_below(now, level) == 0) &&
+            (clock->wheel.occupied[level] & (1U << slot))) {
+            _cascade(clock, level, slot);
+        }
+    }
+}
+
+static int _next_event(const ztimer_clock_t *clock, uint32_t *offset)
+{
+    uint32_t now = clock->list.offset;
+    int found = 0;
+
+    for (unsigned level = 0; level < ZTIMER_WHEEL_LEVELS; level++) {
+        unsigned occupied = clock->wheel.occupied[level];
+        uint32_t dist;
+
+        if (!occupied) {
+            continue;
+        }
+        /* slots of level 0 are due at their tick, slots of higher levels at
+         * their start */
+        dist = (uint32_t)_next_slot(occupied, _slot(now, level)) <<
+               (level * _BITS);
+        dist -= _below(now, level);
+        if (!found || (dist < *offset)) {
+            *offset = dist;
+            found = 1;
+        }
+    }
+    return found;
+}
+
+void ztimer_wheel_add(ztimer_clock_t *clock, ztimer_base_t *entry,
+                      uint32_t val)
+{
+    assert(!ztimer_wheel_is_set(entry));
+    entry->offset = clock->list.offset + val;
+    _insert(clock, entry);
+}
+
+void ztimer_wheel_del(ztimer_clock_t *clock, ztimer_base_t *entry)
+{
+    ztimer_base_t **pprev = entry->pprev;
+    uintptr_t idx = (uintptr_t)pprev - (uintptr_t)clock->wheel.slots;
+
+    assert(ztimer_wheel_is_set(entry));
+    *pprev = entry->next;
+    if (entry->next) {
+        entry->next->pprev = pprev;
+    }
+    else if (entry == clock->last) {
+        clock->last = (pprev == &clock->list.next)
+                    ? NULL
+                    : container_of(pprev, ztimer_base_t, next);
+    }
+    else if (idx < sizeof(clock->wheel.slots)) {
+        /* entry was the only timer of its slot */
+        idx /= sizeof(clock->wheel.slots[0][0]);
+        clock->wheel.occupied[idx / ZTIMER_WHEEL_SLOTS] &=
+            ~(1U << (idx & _SLOT_MASK));
+    }
+    /* reset pprev so ztimer_wheel_is_set() considers the entry unset */
+    entry->next = NULL;
+    entry->pprev = NULL;
+}
+
+int ztimer_wheel_next(const ztimer_clock_t *clock, uint32_t *offset)
+{
+    if (clock->list.next) {
+        *offset = 0;
+        return 1;
+    }
+    return _next_event(clock, offset);
+}
+
+void ztimer_wheel_advance(ztimer_clock_t *clock, uint32_t diff)
+{
+    uint32_t next;
+
+    /* visit the occupied slots only, each call of _process() empties the
+     * slot next was calculated for */
+    while (_next_event(clock, &next) && (next <= diff)) {
+        clock->list.offset += next;
+        diff -= next;
+        _process(clock);
+    }
+    clock->list.offset += diff;
+}
+
+ztimer_base_t *ztimer_wheel_pop(ztimer_clock_t *clock)
+{
+    ztimer_base_t *entry = clock->list.next;
+
+    if (entry) {
+        ztimer_wheel_del(clock, entry);
+    }
+    return entry;
+}
+
+int ztimer_wheel_is_empty(const ztimer_clock_t *clock)
+{
+    if (clock->list.next) {
+        return 0;
+    }
+    for (unsigned level = 0; level < ZTIMER_WHEEL_LEVELS; level++) {
+        if (clock->wheel.occupied[level]) {
+            return 0;
+        }
+    }
+    return 1;
+}
@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measure lookup cost of the IPv6 NIB for different table sizes
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "benchmark.h"
+#include "byteorder.h"
+#include "net/gnrc/ipv6/nib.h"
+#include "net/ipv6/addr.h"
+
+#include "_nib-internal.h"
+
+#ifndef BENCH_RUNS
+#define BENCH_RUNS          (10UL * 1000UL)
+#endif
+
+#define IFACE               (1U)
+#define PFX_LEN             (64U)
+
+static const unsigned _sizes[] = { 16, 128, 1024 };
+
+static void _neighbor(ipv6_addr_t *addr, unsigned i)
+{
+    ipv6_addr_set_link_local_prefix(addr);
+    addr->u16[4].u16 = 0;
+    addr->u16[5].u16 = 0;
+    addr->u16[6].u16 = 0;
+    addr->u16[7] = byteorder_htons(i + 1);
+}
+
+static void _route(ipv6_addr_t *addr, unsigned i)
+{
+    ipv6_addr_from_str(addr, "2001:db8::1");
+    addr->u16[3] = byteorder_htons(i + 1);
+}
+
+/* re-adding the entries of a smaller run is a no-op, so the NIB just grows */
+static int _fill(unsigned numof)
+{
+    for (unsigned i = 0; i < numof; i++) {
+        ipv6_addr_t nh, dst;
+
+        _neighbor(&nh, i);
+        _route(&dst, i);
+        if ((gnrc_ipv6_nib_nc_set(&nh, IFACE, NULL, 0) < 0) ||
+            (gnrc_ipv6_nib_ft_add(&dst, PFX_LEN, &nh, IFACE, 0) < 0)) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+int main(void)
+{
+    puts("IPv6 NIB lookup benchmark\n");
+    printf("Index: %s\n\n",
+           IS_ACTIVE(CONFIG_GNRC_IPV6_NIB_INDEX) ? "hash/trie" : "linear");
+
+    for (unsigned i = 0; i < ARRAY_SIZE(_sizes); i++) {
+        unsigned numof = _sizes[i];
+        gnrc_ipv6_nib_ft_t fte;
+        ipv6_addr_t nh, dst;
+        char name[32];
+
+        if ((numof > CONFIG_GNRC_IPV6_NIB_NUMOF) ||
+            (numof > CONFIG_GNRC_IPV6_NIB_OFFL_NUMOF)) {
+            printf("%u entries: skipped\n", numof);
+            continue;
+        }
+        if (_fill(numof) < 0) {
+            printf("%u entries: unable to fill NIB\n", numof);
+            return 1;
+        }
+        _neighbor(&nh, numof - 1);
+        _route(&dst, numof - 1);
+        if ((_nib_onl_get(&nh, IFACE) == NULL) ||
+            (gnrc_ipv6_nib_ft_get(&dst, NULL, &fte) < 0) ||
+            !ipv6_addr_equal(&fte.next_hop, &nh)) {
+            printf("%u entries: lookup failed\n", numof);
+            return 1;
+        }
+        snprintf(name, sizeof(name), "nc get (%u)", numof);
+        BENCHMARK_FUNC(name, BENCH_RUNS, _nib_onl_get(&nh, IFACE));
+        snprintf(name, sizeof(name), "ft get (%u)", numof);
+        BENCHMARK_FUNC(name, BENCH_RUNS, gnrc_ipv6_nib_ft_get(&dst, NULL, &fte));
+    }
+
+    puts("\n[SUCCESS]");
+    return 0;
+}
@@ -0,0 +1,31 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2020 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+# Linear lookups over 1024 entries take a while on slower boards
+TIMEOUT = 60
+BENCHMARK_REGEXP = r"\s+{func}:\s+\d+us\s+---\s+\d*\.*\d+us per call\s+---\s+\d+ calls per sec"
+
+
+def testfunc(child):
+    child.expect_exact('IPv6 NIB lookup benchmark')
+    for numof in (16, 128, 1024):
+        res = child.expect([BENCHMARK_REGEXP.format(func=r"nc get \({}\)".format(numof)),
+                            r"{} entries: skipped".format(numof)],
+                           timeout=TIMEOUT)
+        if res == 0:
+            child.expect(BENCHMARK_REGEXP.format(func=r"ft get \({}\)".format(numof)),
+                         timeout=TIMEOUT)
+    child.expect_exact('[SUCCESS]')
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
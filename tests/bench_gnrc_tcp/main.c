@@ -0,0 +1,140 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measure the throughput of a bulk transfer between two GNRC
+ *              TCP nodes
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "msg.h"
+#include "net/af.h"
+#include "net/gnrc/tcp.h"
+#include "shell.h"
+#include "xtimer.h"
+
+#define MAIN_QUEUE_SIZE     (8U)
+#define BUFFER_SIZE         (4096U)
+#define RECV_TIMEOUT        (10U * US_PER_SEC)
+
+static msg_t _main_queue[MAIN_QUEUE_SIZE];
+static gnrc_tcp_tcb_t _tcb;
+static uint8_t _buffer[BUFFER_SIZE];
+
+static int _server_cmd(int argc, char **argv)
+{
+    gnrc_tcp_ep_t local;
+    uint32_t start, duration;
+    unsigned long bytes = 0;
+    ssize_t res;
+
+    if (argc < 2) {
+        printf("usage: %s <port>\n", argv[0]);
+        return 1;
+    }
+    if (gnrc_tcp_ep_init(&local, AF_INET6, NULL, 0, atoi(argv[1]),
+                         0) < 0) {
+        puts("server: invalid port");
+        return 1;
+    }
+    gnrc_tcp_tcb_init(&_tcb);
+    puts("server: listening");
+    res = gnrc_tcp_open_passive(&_tcb, &local);
+    if (res < 0) {
+        printf("server: open failed (%d)\n", (int)res);
+        return 1;
+    }
+    puts("server: connected");
+    start = xtimer_now_usec();
+    /* receive until the peer closed the connection, the FIN arrives after
+     * all data */
+    while ((res = gnrc_tcp_recv(&_tcb, _buffer, sizeof(_buffer),
+                                RECV_TIMEOUT)) > 0) {
+        bytes += res;
+    }
+    duration = xtimer_now_usec() - start;
+    gnrc_tcp_close(&_tcb);
+    if (res < 0) {
+        printf("server: receive failed (%d)\n", (int)res);
+        return 1;
+    }
+    printf("server: received %lu bytes in %lu us (%lu KiB/s)\n", bytes,
+           (unsigned long)duration,
+           (unsigned long)(((uint64_t)bytes * US_PER_SEC) /
+                           ((uint64_t)duration * 1024U)));
+    return 0;
+}
+
+static int _client_cmd(int argc, char **argv)
+{
+    gnrc_tcp_ep_t remote;
+    unsigned long len, sent = 0;
+    int res;
+
+    if (argc < 3) {
+        printf("usage: %s <[addr%%netif]:port> <bytes>\n", argv[0]);
+        return 1;
+    }
+    if (gnrc_tcp_ep_from_str(&remote, argv[1]) < 0) {
+        puts("client: invalid endpoint");
+        return 1;
+    }
+    len = strtoul(argv[2], NULL, 10);
+    for (unsigned i = 0; i < sizeof(_buffer); i++) {
+        _buffer[i] = i;
+    }
+    gnrc_tcp_tcb_init(&_tcb);
+    res = gnrc_tcp_open_active(&_tcb, &remote, 0);
+    if (res < 0) {
+        printf("client: open failed (%d)\n", res);
+        return 1;
+    }
+    while (sent < len) {
+        size_t chunk = ((len - sent) < sizeof(_buffer)) ? (len - sent)
+                                                        : sizeof(_buffer);
+        ssize_t n = gnrc_tcp_send(&_tcb, _buffer, chunk, 0);
+
+        if (n < 0) {
+            printf("client: send failed (%d)\n", (int)n);
+            gnrc_tcp_abort(&_tcb);
+            return 1;
+        }
+        sent += n;
+    }
+    /* blocks until the peer acknowledged all data */
+    gnrc_tcp_close(&_tcb);
+    printf("client: sent %lu bytes\n", sent);
+    return 0;
+}
+
+static const shell_command_t _shell_commands[] = {
+    { "server", "receive a bulk transfer", _server_cmd },
+    { "client", "send a bulk transfer", _client_cmd },
+    { NULL, NULL, NULL }
+};
+
+int main(void)
+{
+    /* the shell thread receives the TCP events */
+    msg_init_queue(_main_queue, MAIN_QUEUE_SIZE);
+    puts("GNRC TCP throughput benchmark");
+    printf("Retransmission queue: %u segments, MSS: %u bytes\n",
+           CONFIG_GNRC_TCP_RTX_QUEUE_SIZE, CONFIG_GNRC_TCP_MSS);
+
+    char line_buf[SHELL_DEFAULT_BUFSIZE];
+    shell_run(_shell_commands, line_buf, SHELL_DEFAULT_BUFSIZE);
+    return 0;
+}
@@ -0,0 +1,53 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2020 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import os
+import sys
+
+import pexpect
+from testrunner import run
+
+
+PORT = 5000
+BYTES = 1024 * 1024
+TIMEOUT = 120
+
+
+def get_ll_addr(child):
+    child.sendline('ifconfig')
+    child.expect(r'Iface\s+(\d+)\s')
+    netif = child.match.group(1)
+    child.expect(r'(fe80:[0-9a-f:]+)\s')
+    return child.match.group(1).strip(), netif
+
+
+def testfunc(server):
+    server.expect_exact('GNRC TCP throughput benchmark')
+    server_addr, _ = get_ll_addr(server)
+
+    env = dict(os.environ, TAP='tap1')
+    client = pexpect.spawnu('make', ['term'], env=env, timeout=TIMEOUT)
+    client.logfile = sys.stdout
+    try:
+        client.expect_exact('GNRC TCP throughput benchmark')
+        _, client_netif = get_ll_addr(client)
+
+        server.sendline('server {}'.format(PORT))
+        server.expect_exact('server: listening')
+        client.sendline('client [{}%{}]:{} {}'.format(server_addr, client_netif,
+                                                      PORT, BYTES))
+        server.expect(r'server: received {} bytes in \d+ us \(\d+ KiB/s\)'
+                      .format(BYTES))
+        client.expect_exact('client: sent {} bytes'.format(BYTES))
+    finally:
+        client.terminate(force=True)
+    print('[SUCCESS]')
+
+
+if __name__ == '__main__':
+    sys.exit(run(testfunc, timeout=TIMEOUT))
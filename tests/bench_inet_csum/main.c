@@ -0,0 +1,113 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Verify and measure runtime of the Internet checksum
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "benchmark.h"
+#include "net/inet_csum.h"
+
+#ifndef BENCH_RUNS
+#define BENCH_RUNS          (10UL * 1000UL)
+#endif
+
+#define MAX_LEN             (1500U)
+#define MAX_OFFSET          (8U)
+
+static uint8_t _buf[MAX_LEN + MAX_OFFSET];
+
+/* byte-by-byte implementation of RFC 1071 the optimized one is checked
+ * against */
+static uint16_t _ref_csum_slice(uint16_t sum, const uint8_t *buf, uint16_t len,
+                                size_t accum_len)
+{
+    uint32_t csum = sum;
+
+    for (unsigned i = 0; i < len; i++) {
+        if ((accum_len + i) & 1) {
+            csum += buf[i];
+        }
+        else {
+            csum += (uint16_t)(buf[i] << 8);
+        }
+    }
+    while (csum >> 16) {
+        csum = (csum & 0xffff) + (csum >> 16);
+    }
+    return csum;
+}
+
+static int _verify(void)
+{
+    for (unsigned len = 1; len <= MAX_LEN; len++) {
+        for (unsigned offset = 0; offset < MAX_OFFSET; offset++) {
+            for (unsigned accum_len = 0; accum_len < 2; accum_len++) {
+                const uint8_t *buf = &_buf[offset];
+                uint16_t sum = len * 0x0101;
+                uint16_t exp = _ref_csum_slice(sum, buf, len, accum_len);
+                uint16_t res = inet_csum_slice(sum, buf, len, accum_len);
+
+                if (exp != res) {
+                    printf("mismatch: len = %u, offset = %u, accum_len = %u: "
+                           "0x%04x != 0x%04x\n", len, offset, accum_len,
+                           res, exp);
+                    return -1;
+                }
+            }
+        }
+    }
+    return 0;
+}
+
+int main(void)
+{
+    puts("Internet checksum benchmark\n");
+
+    for (unsigned i = 0; i < sizeof(_buf); i++) {
+        _buf[i] = (uint8_t)((i * 7) + 3);
+    }
+    if (_verify() < 0) {
+        puts("[FAILED]");
+        return 1;
+    }
+    /* 0xff bytes stress carry propagation */
+    for (unsigned i = 0; i < sizeof(_buf); i++) {
+        _buf[i] = 0xff;
+    }
+    if (_verify() < 0) {
+        puts("[FAILED]");
+        return 1;
+    }
+    puts("verified against reference implementation\n");
+
+    BENCHMARK_FUNC("inet_csum (8 byte)", BENCH_RUNS,
+                   inet_csum(0, _buf, 8));
+    BENCHMARK_FUNC("inet_csum (40 byte)", BENCH_RUNS,
+                   inet_csum(0, _buf, 40));
+    BENCHMARK_FUNC("inet_csum (127 byte)", BENCH_RUNS,
+                   inet_csum(0, _buf, 127));
+    BENCHMARK_FUNC("inet_csum (1280 byte)", BENCH_RUNS,
+                   inet_csum(0, _buf, 1280));
+    BENCHMARK_FUNC("inet_csum (1500 byte, unaligned)", BENCH_RUNS,
+                   inet_csum(0, &_buf[1], 1500));
+    puts("");
+    BENCHMARK_FUNC("reference (1280 byte)", BENCH_RUNS,
+                   _ref_csum_slice(0, _buf, 1280, 0));
+
+    puts("\n[SUCCESS]");
+    return 0;
+}
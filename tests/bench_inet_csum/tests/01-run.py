@@ -0,0 +1,33 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2020 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+# Verification runs over all sizes up to 1500 byte
+TIMEOUT = 60
+BENCHMARK_REGEXP = r"\s+{func}:\s+\d+us\s+---\s+\d*\.*\d+us per call\s+---\s+\d+ calls per sec"
+
+
+def testfunc(child):
+    child.expect_exact('Internet checksum benchmark')
+    child.expect_exact('verified against reference implementation',
+                       timeout=TIMEOUT)
+    for size in (8, 40, 127, 1280):
+        child.expect(BENCHMARK_REGEXP.format(
+            func=r"inet_csum \({} byte\)".format(size)), timeout=TIMEOUT)
+    child.expect(BENCHMARK_REGEXP.format(
+        func=r"inet_csum \(1500 byte, unaligned\)"), timeout=TIMEOUT)
+    child.expect(BENCHMARK_REGEXP.format(func=r"reference \(1280 byte\)"),
+                 timeout=TIMEOUT)
+    child.expect_exact('[SUCCESS]')
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
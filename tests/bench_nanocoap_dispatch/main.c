@@ -0,0 +1,165 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measure the dispatch of CoAP requests to a growing number of
+ *              resources
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "benchmark.h"
+#include "net/nanocoap.h"
+
+#ifndef BENCH_RUNS
+#define BENCH_RUNS          (10UL * 1000UL)
+#endif
+
+#ifndef RESOURCES_MAX
+#define RESOURCES_MAX       (1000U)
+#endif
+
+#define PATH_LEN            (16U)
+#define BUF_SIZE            (64U)
+
+static ssize_t _handler(coap_pkt_t *pkt, uint8_t *buf, size_t len,
+                        void *context);
+
+/* nanocoap needs a global resource list, it is not used */
+const coap_resource_t coap_resources[] = {
+    { "/", COAP_GET, _handler, NULL },
+};
+const unsigned coap_resources_numof = ARRAY_SIZE(coap_resources);
+
+static char _paths[RESOURCES_MAX][PATH_LEN];
+static coap_resource_t _resources[RESOURCES_MAX];
+static const coap_resource_t *_called;
+
+static ssize_t _handler(coap_pkt_t *pkt, uint8_t *buf, size_t len,
+                        void *context)
+{
+    (void)pkt;
+    (void)buf;
+    (void)len;
+    _called = context;
+    return 0;
+}
+
+/* LwM2M-like paths /<object>/<instance>/<resource>, the fixed width keeps
+ * them sorted */
+static void _init_resources(void)
+{
+    for (unsigned i = 0; i < RESOURCES_MAX; i++) {
+        snprintf(_paths[i], sizeof(_paths[i]), "/%04u/0/%04u", 3300 + (i / 8),
+                 5700 + (i % 8));
+        _resources[i].path = _paths[i];
+        _resources[i].methods = COAP_GET | COAP_PUT;
+        _resources[i].handler = _handler;
+        _resources[i].context = &_resources[i];
+    }
+}
+
+/* the dispatch before the resources were searched as a tree */
+static ssize_t _linear_handler(coap_pkt_t *pkt, uint8_t *resp_buf,
+                               unsigned resp_buf_len,
+                               const coap_resource_t *resources,
+                               size_t resources_numof)
+{
+    coap_method_flags_t method_flag = coap_method2flag(coap_get_code_detail(pkt));
+    uint8_t uri[CONFIG_NANOCOAP_URI_MAX];
+
+    if (coap_get_uri_path(pkt, uri) <= 0) {
+        return -EBADMSG;
+    }
+    for (unsigned i = 0; i < resources_numof; i++) {
+        const coap_resource_t *resource = &resources[i];
+        if (!(resource->methods & method_flag)) {
+            continue;
+        }
+
+        int res = coap_match_path(resource, uri);
+        if (res > 0) {
+            continue;
+        }
+        else if (res < 0) {
+            break;
+        }
+        else {
+            return resource->handler(pkt, resp_buf, resp_buf_len,
+                                     resource->context);
+        }
+    }
+    return coap_build_reply(pkt, COAP_CODE_404, resp_buf, resp_buf_len, 0);
+}
+
+static int _build_req(coap_pkt_t *pkt, uint8_t *buf, const char *path)
+{
+    ssize_t len = coap_build_hdr((coap_hdr_t *)buf, COAP_TYPE_NON, NULL, 0,
+                                 COAP_METHOD_GET, 1);
+
+    len += coap_opt_put_uri_path(&buf[len], 0, path);
+    return coap_parse(pkt, buf, len);
+}
+
+int main(void)
+{
+    static const unsigned numofs[] = { 10, 100, 1000 };
+    uint8_t req_buf[BUF_SIZE];
+    uint8_t resp_buf[BUF_SIZE];
+    coap_pkt_t pkt;
+
+    puts("CoAP resource dispatch benchmark\n");
+    printf("Resources: up to %u\n\n", RESOURCES_MAX);
+    _init_resources();
+
+    for (unsigned i = 0; i < ARRAY_SIZE(numofs); i++) {
+        unsigned numof = numofs[i];
+        const coap_resource_t *target;
+        char name[32];
+
+        if (numof > RESOURCES_MAX) {
+            break;
+        }
+        /* the last resource is the worst case of the linear search */
+        target = &_resources[numof - 1];
+        if (_build_req(&pkt, req_buf, target->path) < 0) {
+            puts("building the request failed");
+            return 1;
+        }
+        _called = NULL;
+        _linear_handler(&pkt, resp_buf, sizeof(resp_buf), _resources, numof);
+        if (_called != target) {
+            printf("linear %u: wrong resource\n", numof);
+            return 1;
+        }
+        _called = NULL;
+        coap_tree_handler(&pkt, resp_buf, sizeof(resp_buf), _resources, numof);
+        if (_called != target) {
+            printf("tree %u: wrong resource\n", numof);
+            return 1;
+        }
+
+        snprintf(name, sizeof(name), "linear %u", numof);
+        BENCHMARK_FUNC(name, BENCH_RUNS,
+                       _linear_handler(&pkt, resp_buf, sizeof(resp_buf),
+                                       _resources, numof));
+        snprintf(name, sizeof(name), "tree %u", numof);
+        BENCHMARK_FUNC(name, BENCH_RUNS,
+                       coap_tree_handler(&pkt, resp_buf, sizeof(resp_buf),
+                                         _resources, numof));
+    }
+
+    puts("\n[SUCCESS]");
+    return 0;
+}
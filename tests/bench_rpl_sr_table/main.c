@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measure DAO processing and source routing header generation
+ *              of a RPL root in non-storing mode for different DODAG sizes
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "benchmark.h"
+#include "byteorder.h"
+#include "net/gnrc/rpl/sr_table.h"
+#include "net/ipv6/addr.h"
+
+#ifndef BENCH_RUNS
+#define BENCH_RUNS          (10UL * 1000UL)
+#endif
+
+#define LIFETIME            (3600U)
+#define SRH_MAXLEN          (sizeof(gnrc_rpl_srh_t) + \
+                             (CONFIG_GNRC_RPL_SR_TABLE_MAX_HOPS * \
+                              sizeof(ipv6_addr_t)))
+
+static const unsigned _sizes[] = { 100, 500, 2000 };
+static uint8_t _srh[SRH_MAXLEN];
+
+/* node 0 is the root, the parent of node i is node i / FANOUT */
+static void _node(ipv6_addr_t *addr, unsigned i)
+{
+    ipv6_addr_from_str(addr, "2001:db8::ff:fe00:0");
+    addr->u16[7] = byteorder_htons(i);
+}
+
+static int _dao(unsigned i)
+{
+    ipv6_addr_t target, parent;
+
+    _node(&target, i);
+    _node(&parent, i / FANOUT);
+    return gnrc_rpl_sr_table_add(&target, (i < FANOUT) ? NULL : &parent,
+                                 LIFETIME);
+}
+
+static int _fill(unsigned numof)
+{
+    gnrc_rpl_sr_table_reset();
+    for (unsigned i = 1; i <= numof; i++) {
+        if (_dao(i) < 0) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+static unsigned _depth(unsigned i)
+{
+    unsigned depth = 0;
+
+    for (; i > 0; i /= FANOUT) {
+        depth++;
+    }
+    return depth;
+}
+
+int main(void)
+{
+    puts("RPL source routing benchmark\n");
+    printf("Fan-out: %u\n\n", FANOUT);
+
+    for (unsigned i = 0; i < ARRAY_SIZE(_sizes); i++) {
+        unsigned numof = _sizes[i];
+        ipv6_addr_t dst, first_hop;
+        char name[32];
+
+        if (numof > CONFIG_GNRC_RPL_SR_TABLE_SIZE) {
+            printf("%u nodes: skipped\n", numof);
+            continue;
+        }
+        if (_fill(numof) < 0) {
+            printf("%u nodes: unable to fill table\n", numof);
+            return 1;
+        }
+        /* the last node is the deepest */
+        _node(&dst, numof);
+        if (gnrc_rpl_sr_table_build_srh(&dst, (gnrc_rpl_srh_t *)_srh,
+                                        sizeof(_srh), &first_hop) <= 0) {
+            printf("%u nodes: no source route\n", numof);
+            return 1;
+        }
+        printf("%u nodes: %u hops\n", numof, _depth(numof));
+        snprintf(name, sizeof(name), "dao (%u)", numof);
+        BENCHMARK_FUNC(name, BENCH_RUNS, _dao(numof));
+        snprintf(name, sizeof(name), "srh (%u)", numof);
+        BENCHMARK_FUNC(name, BENCH_RUNS,
+                       gnrc_rpl_sr_table_build_srh(&dst,
+                                                   (gnrc_rpl_srh_t *)_srh,
+                                                   sizeof(_srh), &first_hop));
+    }
+
+    puts("\n[SUCCESS]");
+    return 0;
+}
@@ -0,0 +1,94 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Scheduling latency benchmark test application
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+
+#include "schedlatency.h"
+#include "thread.h"
+#include "thread_flags.h"
+#include "xtimer.h"
+
+#ifndef TEST_ITERATIONS
+#define TEST_ITERATIONS     (1000U)
+#endif
+
+#ifndef TEST_INTERVAL
+#define TEST_INTERVAL       (1000U)
+#endif
+
+#define FLAG_WAKEUP         (0x1)
+#define FLAG_DONE           (0x2)
+
+static char _stack[THREAD_STACKSIZE_MAIN];
+static thread_t *_main;
+
+static void _timer_callback(void *arg)
+{
+    thread_flags_set(arg, FLAG_WAKEUP);
+}
+
+static void *_second_thread(void *arg)
+{
+    (void)arg;
+
+    while (1) {
+        thread_flags_wait_any(FLAG_WAKEUP);
+        thread_flags_set(_main, FLAG_DONE);
+    }
+
+    return NULL;
+}
+
+int main(void)
+{
+    printf("main starting\n");
+
+    _main = (thread_t *)thread_get(thread_getpid());
+    kernel_pid_t other = thread_create(_stack,
+                                       sizeof(_stack),
+                                       (THREAD_PRIORITY_MAIN - 1),
+                                       THREAD_CREATE_STACKTEST,
+                                       _second_thread,
+                                       NULL,
+                                       "second_thread");
+
+    thread_t *tcb = (thread_t *)thread_get(other);
+    xtimer_t timer = { .callback = _timer_callback, .arg = tcb };
+
+    schedlatency_reset();
+
+    for (unsigned i = 0; i < TEST_ITERATIONS; i++) {
+        thread_flags_set(tcb, FLAG_WAKEUP);
+        thread_flags_wait_any(FLAG_DONE);
+    }
+
+    for (unsigned i = 0; i < TEST_ITERATIONS; i++) {
+        xtimer_set(&timer, TEST_INTERVAL);
+        thread_flags_wait_any(FLAG_DONE);
+    }
+
+    puts("Scheduling latency [" SCHEDLATENCY_UNIT "]:");
+    schedlatency_print();
+
+    printf("{ \"thread\" : %" PRIu32 ", \"isr\" : %" PRIu32 " }\n",
+           schedlatency_mean(&sched_latency[other].thread),
+           schedlatency_mean(&sched_latency[other].isr));
+
+    return 0;
+}
@@ -0,0 +1,339 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measure packets per second of IPHC compression and
+ *              decompression
+ *
+ * @}
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "benchmark.h"
+#include "msg.h"
+#include "net/gnrc.h"
+#include "net/gnrc/ipv6/hdr.h"
+#include "net/gnrc/netif.h"
+#include "net/gnrc/netif/hdr.h"
+#include "net/gnrc/sixlowpan/ctx.h"
+#include "net/gnrc/sixlowpan/iphc.h"
+#include "net/gnrc/udp.h"
+#include "net/ipv6/hdr.h"
+#include "net/netdev_test.h"
+#include "net/sixlowpan.h"
+#include "thread.h"
+
+#ifndef BENCH_RUNS
+#define BENCH_RUNS          (10UL * 1000UL)
+#endif
+
+#define CTX_ID              (0U)
+#define CTX_LTIME           (UINT16_MAX)
+#define PAYLOAD_LEN         (16U)
+#define FRAME_MAXLEN        (64U)
+#define MAIN_QUEUE_SIZE     (4U)
+
+typedef struct {
+    const char *name;
+    const char *src;
+    const char *dst;
+    uint16_t src_port;
+    uint16_t dst_port;
+    uint8_t frame[FRAME_MAXLEN];    /**< the compressed frame */
+    size_t frame_len;
+} _flow_t;
+
+static _flow_t _flows[] = {
+    { .name = "link-local", .src = "fe80::1", .dst = "fe80::2",
+      .src_port = 0xf0b1, .dst_port = 0xf0b2 },
+    { .name = "context", .src = "2001:db8::ff:fe00:1",
+      .dst = "2001:db8::ff:fe00:2", .src_port = 5683, .dst_port = 5683 },
+    { .name = "multicast", .src = "fe80::1", .dst = "ff02::1a",
+      .src_port = 0xf001, .dst_port = 521 },
+};
+
+/* the interface's IID is derived from _l2addr, that of the peer from
+ * _peer_l2addr, see _flows */
+static const uint8_t _l2addr[] = { 0x02, 0, 0, 0, 0, 0, 0, 0x01 };
+static const uint8_t _peer_l2addr[] = { 0x02, 0, 0, 0, 0, 0, 0, 0x02 };
+static const uint8_t _payload[PAYLOAD_LEN];
+
+static char _netif_stack[THREAD_STACKSIZE_DEFAULT];
+static msg_t _main_queue[MAIN_QUEUE_SIZE];
+static netdev_test_t _dev;
+static gnrc_netif_t _netif;
+static _flow_t *_capture;
+
+static int _netif_send(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt)
+{
+    gnrc_netif_hdr_t *hdr = pkt->data;
+    int res = gnrc_pkt_len(pkt->next);
+
+    (void)netif;
+    /* only capture the packets of the flows, not those of the NIB */
+    if ((_capture != NULL) && (hdr->dst_l2addr_len == sizeof(_peer_l2addr)) &&
+        (memcmp(gnrc_netif_hdr_get_dst_addr(hdr), _peer_l2addr,
+                sizeof(_peer_l2addr)) == 0) &&
+        ((size_t)res <= sizeof(_capture->frame))) {
+        _capture->frame_len = 0;
+        for (gnrc_pktsnip_t *snip = pkt->next; snip; snip = snip->next) {
+            memcpy(&_capture->frame[_capture->frame_len], snip->data,
+                   snip->size);
+            _capture->frame_len += snip->size;
+        }
+        _capture = NULL;
+    }
+    gnrc_pktbuf_release(pkt);
+    return res;
+}
+
+static gnrc_pktsnip_t *_netif_recv(gnrc_netif_t *netif)
+{
+    (void)netif;
+    return NULL;
+}
+
+static const gnrc_netif_ops_t _netif_ops = {
+    .init = gnrc_netif_default_init,
+    .send = _netif_send,
+    .recv = _netif_recv,
+    .get = gnrc_netif_get_from_netdev,
+    .set = gnrc_netif_set_from_netdev,
+};
+
+static int _get_device_type(netdev_t *dev, void *value, size_t max_len)
+{
+    (void)dev;
+    (void)max_len;
+    *((uint16_t *)value) = NETDEV_TYPE_IEEE802154;
+    return sizeof(uint16_t);
+}
+
+static int _get_proto(netdev_t *dev, void *value, size_t max_len)
+{
+    (void)dev;
+    (void)max_len;
+    *((gnrc_nettype_t *)value) = GNRC_NETTYPE_SIXLOWPAN;
+    return sizeof(gnrc_nettype_t);
+}
+
+static int _get_max_pdu_size(netdev_t *dev, void *value, size_t max_len)
+{
+    (void)dev;
+    (void)max_len;
+    *((uint16_t *)value) = 127U;
+    return sizeof(uint16_t);
+}
+
+static int _get_src_len(netdev_t *dev, void *value, size_t max_len)
+{
+    (void)dev;
+    (void)max_len;
+    *((uint16_t *)value) = sizeof(_l2addr);
+    return sizeof(uint16_t);
+}
+
+static int _get_addr_long(netdev_t *dev, void *value, size_t max_len)
+{
+    (void)dev;
+    (void)max_len;
+    memcpy(value, _l2addr, sizeof(_l2addr));
+    return sizeof(_l2addr);
+}
+
+static void _init_netif(void)
+{
+    netdev_test_setup(&_dev, NULL);
+    netdev_test_set_get_cb(&_dev, NETOPT_DEVICE_TYPE, _get_device_type);
+    netdev_test_set_get_cb(&_dev, NETOPT_PROTO, _get_proto);
+    netdev_test_set_get_cb(&_dev, NETOPT_MAX_PDU_SIZE, _get_max_pdu_size);
+    netdev_test_set_get_cb(&_dev, NETOPT_SRC_LEN, _get_src_len);
+    netdev_test_set_get_cb(&_dev, NETOPT_ADDRESS_LONG, _get_addr_long);
+    gnrc_netif_create(&_netif, _netif_stack, sizeof(_netif_stack),
+                      GNRC_NETIF_PRIO, "bench", (netdev_t *)&_dev,
+                      &_netif_ops);
+    thread_yield_higher();
+}
+
+static int _compress(_flow_t *flow, bool ref)
+{
+    gnrc_pktsnip_t *pkt, *netif;
+    ipv6_hdr_t *ipv6_hdr;
+    ipv6_addr_t src, dst;
+
+    ipv6_addr_from_str(&src, flow->src);
+    ipv6_addr_from_str(&dst, flow->dst);
+    pkt = gnrc_pktbuf_add(NULL, _payload, sizeof(_payload),
+                          GNRC_NETTYPE_UNDEF);
+    if (pkt == NULL) {
+        return -1;
+    }
+    pkt = gnrc_udp_hdr_build(pkt, flow->src_port, flow->dst_port);
+    if (pkt == NULL) {
+        return -1;
+    }
+    pkt = gnrc_ipv6_hdr_build(pkt, &src, &dst);
+    if (pkt == NULL) {
+        return -1;
+    }
+    ipv6_hdr = pkt->data;
+    ipv6_hdr->nh = PROTNUM_UDP;
+    ipv6_hdr->hl = 64;
+    ipv6_hdr->len = byteorder_htons(gnrc_pkt_len(pkt->next));
+    netif = gnrc_netif_hdr_build(NULL, 0, _peer_l2addr,
+                                 sizeof(_peer_l2addr));
+    if (netif == NULL) {
+        gnrc_pktbuf_release(pkt);
+        return -1;
+    }
+    gnrc_netif_hdr_set_netif(netif->data, &_netif);
+    netif->next = pkt;
+    if (ref) {
+        gnrc_sixlowpan_iphc_ref_send(netif, NULL, 0);
+    }
+    else {
+        gnrc_sixlowpan_iphc_send(netif, NULL, 0);
+    }
+    return 0;
+}
+
+static int _decompress(const _flow_t *flow, bool ref)
+{
+    gnrc_pktsnip_t *pkt, *netif;
+
+    pkt = gnrc_pktbuf_add(NULL, flow->frame, flow->frame_len,
+                          GNRC_NETTYPE_SIXLOWPAN);
+    if (pkt == NULL) {
+        return -1;
+    }
+    netif = gnrc_netif_hdr_build(_l2addr, sizeof(_l2addr), _peer_l2addr,
+                                 sizeof(_peer_l2addr));
+    if (netif == NULL) {
+        gnrc_pktbuf_release(pkt);
+        return -1;
+    }
+    gnrc_netif_hdr_set_netif(netif->data, &_netif);
+    /* received packets have the netif header last */
+    pkt->next = netif;
+    if (ref) {
+        gnrc_sixlowpan_iphc_ref_recv(pkt, NULL, 0);
+    }
+    else {
+        gnrc_sixlowpan_iphc_recv(pkt, NULL, 0);
+    }
+    return 0;
+}
+
+static int _check_flow(_flow_t *flow, bool ref)
+{
+    gnrc_pktsnip_t *ipv6;
+    ipv6_hdr_t *ipv6_hdr;
+    ipv6_addr_t src, dst;
+    msg_t msg;
+    int res = -1;
+
+    _capture = flow;
+    if ((_compress(flow, ref) < 0) || (flow->frame_len == 0) ||
+        !sixlowpan_iphc_is(flow->frame)) {
+        return -1;
+    }
+    if (_decompress(flow, ref) < 0) {
+        return -1;
+    }
+    do {
+        msg_receive(&msg);
+    } while (msg.type != GNRC_NETAPI_MSG_TYPE_RCV);
+    ipv6 = gnrc_pktsnip_search_type(msg.content.ptr, GNRC_NETTYPE_IPV6);
+    ipv6_addr_from_str(&src, flow->src);
+    ipv6_addr_from_str(&dst, flow->dst);
+    if (ipv6 != NULL) {
+        ipv6_hdr = ipv6->data;
+        if (ipv6_addr_equal(&ipv6_hdr->src, &src) &&
+            ipv6_addr_equal(&ipv6_hdr->dst, &dst)) {
+            res = 0;
+        }
+    }
+    gnrc_pktbuf_release(msg.content.ptr);
+    return res;
+}
+
+int main(void)
+{
+    gnrc_netreg_entry_t *ipv6_entry;
+    gnrc_netreg_entry_t main_entry = GNRC_NETREG_ENTRY_INIT_PID(
+                                            GNRC_NETREG_DEMUX_CTX_ALL,
+                                            thread_getpid()
+                                        );
+    ipv6_addr_t prefix;
+
+    msg_init_queue(_main_queue, MAIN_QUEUE_SIZE);
+    puts("IPHC compression benchmark\n");
+    printf("Context cache: %u entries per interface\n\n",
+           CONFIG_GNRC_SIXLOWPAN_CTX_CACHE_SIZE);
+
+    _init_netif();
+    ipv6_addr_from_str(&prefix, "2001:db8::");
+    gnrc_sixlowpan_ctx_update(CTX_ID, &prefix, 64, CTX_LTIME, true);
+
+    /* take decompressed packets from the IPv6 layer, so the benchmark only
+     * measures the 6LoWPAN layer */
+    while ((ipv6_entry = gnrc_netreg_lookup(GNRC_NETTYPE_IPV6,
+                                            GNRC_NETREG_DEMUX_CTX_ALL))) {
+        gnrc_netreg_unregister(GNRC_NETTYPE_IPV6, ipv6_entry);
+    }
+    gnrc_netreg_register(GNRC_NETTYPE_IPV6, &main_entry);
+    for (unsigned i = 0; i < ARRAY_SIZE(_flows); i++) {
+        _flow_t *flow = &_flows[i];
+        uint8_t ref_frame[FRAME_MAXLEN];
+        size_t ref_frame_len;
+
+        if (_check_flow(flow, true) < 0) {
+            printf("%s: round trip with reference failed\n", flow->name);
+            return 1;
+        }
+        ref_frame_len = flow->frame_len;
+        memcpy(ref_frame, flow->frame, ref_frame_len);
+        if (_check_flow(flow, false) < 0) {
+            printf("%s: round trip failed\n", flow->name);
+            return 1;
+        }
+        /* both implementations must produce the same frame, so the
+         * decompression benchmarks below measure them with the same input */
+        if ((flow->frame_len != ref_frame_len) ||
+            (memcmp(flow->frame, ref_frame, ref_frame_len) != 0)) {
+            printf("%s: frame differs from reference\n", flow->name);
+            return 1;
+        }
+    }
+    /* without receivers decompressed packets are released right away */
+    gnrc_netreg_unregister(GNRC_NETTYPE_IPV6, &main_entry);
+
+    for (unsigned i = 0; i < ARRAY_SIZE(_flows); i++) {
+        _flow_t *flow = &_flows[i];
+        char name[48];
+
+        snprintf(name, sizeof(name), "compress %s (reference)", flow->name);
+        BENCHMARK_FUNC(name, BENCH_RUNS, _compress(flow, true));
+        snprintf(name, sizeof(name), "compress %s", flow->name);
+        BENCHMARK_FUNC(name, BENCH_RUNS, _compress(flow, false));
+        snprintf(name, sizeof(name), "decompress %s (reference)", flow->name);
+        BENCHMARK_FUNC(name, BENCH_RUNS, _decompress(flow, true));
+        snprintf(name, sizeof(name), "decompress %s", flow->name);
+        BENCHMARK_FUNC(name, BENCH_RUNS, _decompress(flow, false));
+    }
+
+    puts("\n[SUCCESS]");
+    return 0;
+}
@@ -44,6 +44,9 @@
 #include "print_results.h"
 #include "spin_random.h"
 #include "bench_timers_config.h"
+#if TEST_ZTIMER_LOAD
+#include "ztimer_load.h"
+#endif
 
 #ifndef TEST_TRACE
 #define TEST_TRACE 0
@@ -613,6 +616,11 @@ static void estimate_cpu_overhead(void)
 
 int main(void)
 {
+#if TEST_ZTIMER_LOAD
+    random_init(seed);
+    ztimer_load_run();
+    return 0;
+#endif
     print_str("\nStatistical benchmark for timers\n");
     for (unsigned int k = 0; k < ARRAY_SIZE(ref_states); ++k) {
         matstat_clear(&ref_states[k]);
@@ -0,0 +1,161 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       ztimer cost under load
+ *
+ * Every operation is measured on its own with ZTIMER_USEC. As the operations
+ * start at a random phase of the clock's tick, the mean of the measured ticks
+ * converges to the actual duration, even if an operation takes less than a
+ * tick.
+ *
+ * @}
+ */
+
+#if TEST_ZTIMER_LOAD
+#include <stdint.h>
+
+#include "fmt.h"
+#include "kernel_defines.h"
+#include "random.h"
+#include "timex.h"
+#include "ztimer.h"
+
+#include "ztimer_load.h"
+
+/* Maximum number of timers set at the same time */
+/* Reduce this if RAM usage is too high */
+#ifndef ZTIMER_LOAD_TIMERS_MAX
+#define ZTIMER_LOAD_TIMERS_MAX      (1000U)
+#endif
+
+/* Number of measurements per operation and number of timers set */
+#ifndef ZTIMER_LOAD_ITERATIONS
+#define ZTIMER_LOAD_ITERATIONS      (10000U)
+#endif
+
+/* Timers are set to a random offset in [MIN, MIN + SPREAD), so none of them
+ * triggers during the measurement and they are distributed over all levels
+ * of ztimer_wheel */
+#define ZTIMER_LOAD_OFFSET_MIN      (10LU * US_PER_SEC)
+#define ZTIMER_LOAD_OFFSET_SPREAD   (1LU << 30)
+
+typedef struct {
+    uint64_t sum;
+    uint32_t max;
+} _stats_t;
+
+static ztimer_t _timers[ZTIMER_LOAD_TIMERS_MAX];
+
+static const unsigned _timers_numof[] = { 10, 100, 1000 };
+
+static void _nop(void *arg)
+{
+    (void)arg;
+}
+
+static uint32_t _offset(void)
+{
+    return ZTIMER_LOAD_OFFSET_MIN +
+           random_uint32_range(0, ZTIMER_LOAD_OFFSET_SPREAD);
+}
+
+static void _add(_stats_t *stats, uint32_t ticks)
+{
+    stats->sum += ticks;
+    if (ticks > stats->max) {
+        stats->max = ticks;
+    }
+}
+
+static void _print(const char *label, const _stats_t *stats,
+                   uint32_t overhead)
+{
+    uint32_t mean = (stats->sum * 1000) / ZTIMER_LOAD_ITERATIONS;
+
+    mean = (mean > overhead) ? (mean - overhead) : 0;
+    print_str(label);
+    print_str(" mean: ");
+    print_u32_dec(mean);
+    print_str(" ns, max: ");
+    print_u32_dec(stats->max);
+    print_str(" us\n");
+}
+
+/* mean cost of measuring an empty operation in ns */
+static uint32_t _overhead(void)
+{
+    uint64_t sum = 0;
+
+    for (unsigned i = 0; i < ZTIMER_LOAD_ITERATIONS; i++) {
+        uint32_t start = ztimer_now(ZTIMER_USEC);
+
+        sum += ztimer_now(ZTIMER_USEC) - start;
+    }
+    return (sum * 1000) / ZTIMER_LOAD_ITERATIONS;
+}
+
+static void _run(unsigned numof, uint32_t overhead)
+{
+    _stats_t set = { 0 }, remove = { 0 };
+
+    for (unsigned i = 0; i < numof; i++) {
+        ztimer_set(ZTIMER_USEC, &_timers[i], _offset());
+    }
+    for (unsigned i = 0; i < ZTIMER_LOAD_ITERATIONS; i++) {
+        ztimer_t *timer = &_timers[random_uint32_range(0, numof)];
+        uint32_t offset = _offset();
+        uint32_t start, stop;
+
+        start = ztimer_now(ZTIMER_USEC);
+        ztimer_remove(ZTIMER_USEC, timer);
+        stop = ztimer_now(ZTIMER_USEC);
+        _add(&remove, stop - start);
+
+        start = ztimer_now(ZTIMER_USEC);
+        ztimer_set(ZTIMER_USEC, timer, offset);
+        stop = ztimer_now(ZTIMER_USEC);
+        _add(&set, stop - start);
+    }
+    for (unsigned i = 0; i < numof; i++) {
+        ztimer_remove(ZTIMER_USEC, &_timers[i]);
+    }
+
+    print_u32_dec(numof);
+    print_str(" timers set:\n");
+    _print("  ztimer_set()   ", &set, overhead);
+    _print("  ztimer_remove()", &remove, overhead);
+}
+
+void ztimer_load_run(void)
+{
+    uint32_t overhead = _overhead();
+
+    print_str("ztimer load benchmark, ");
+    print_str(IS_USED(MODULE_ZTIMER_WHEEL) ? "ztimer_wheel" : "list");
+    print_str(", overhead: ");
+    print_u32_dec(overhead);
+    print_str(" ns\n");
+    for (unsigned i = 0; i < ZTIMER_LOAD_TIMERS_MAX; i++) {
+        _timers[i].callback = _nop;
+    }
+    for (unsigned i = 0; i < ARRAY_SIZE(_timers_numof); i++) {
+        if (_timers_numof[i] > ZTIMER_LOAD_TIMERS_MAX) {
+            break;
+        }
+        _run(_timers_numof[i], overhead);
+    }
+    print_str("ztimer load benchmark done\n");
+}
+#else
+typedef int dont_be_pedantic;
+#endif /* TEST_ZTIMER_LOAD */
@@ -0,0 +1,38 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       ztimer cost under load declarations
+ */
+
+#ifndef ZTIMER_LOAD_H
+#define ZTIMER_LOAD_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Measure the cost of ztimer_set() and ztimer_remove() on
+ *          ZTIMER_USEC with 10, 100 and 1000 other timers set
+ *
+ * Both functions run with interrupts disabled as a whole, so the maximum cost
+ * measured is the worst-case time interrupts are disabled by them.
+ */
+void ztimer_load_run(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZTIMER_LOAD_H */
+/** @} */
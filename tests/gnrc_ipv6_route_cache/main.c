@@ -0,0 +1,237 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Tests the route cache of GNRC's IPv6 thread
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "embUnit.h"
+#include "mutex.h"
+#include "net/ethernet/hdr.h"
+#include "net/ipv6/hdr.h"
+#include "net/protnum.h"
+#include "net/gnrc.h"
+#include "net/gnrc/ipv6.h"
+#include "net/gnrc/ipv6/nib.h"
+#include "net/netdev_test.h"
+#include "xtimer.h"
+
+#include "common.h"
+
+#define NBR1_MAC            { 0x57, 0x44, 0x33, 0x22, 0x11, 0x00, }
+#define NBR1_LINK_LOCAL     { 0xfe, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, \
+                              0x55, 0x44, 0x33, 0xff, 0xfe, 0x22, 0x11, 0x00, }
+#define NBR2_MAC            { 0x57, 0x44, 0x33, 0x22, 0x11, 0x01, }
+#define NBR2_LINK_LOCAL     { 0xfe, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, \
+                              0x55, 0x44, 0x33, 0xff, 0xfe, 0x22, 0x11, 0x01, }
+#define DST_PFX             { 0x20, 0x01, 0x0d, 0xb8, 0x00, 0x00, 0xab, 0xcd, }
+#define DST_PFX_LEN         (64U)
+#define DST1                { 0x20, 0x01, 0x0d, 0xb8, 0x00, 0x00, 0xab, 0xcd, \
+                              0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, }
+#define DST2                { 0x20, 0x01, 0x0d, 0xb8, 0x00, 0x00, 0xab, 0xcd, \
+                              0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, }
+#define SRC                 { 0x20, 0x01, 0x0d, 0xb8, 0x00, 0x00, 0xef, 0x01, \
+                              0x02, 0xca, 0x4b, 0xef, 0xf4, 0xc2, 0xde, 0x01, }
+#define PAYLOAD_LEN         (16U)
+#define SEND_TIMEOUT        (100U * US_PER_MS)
+
+static const uint8_t _nbr1_mac[] = NBR1_MAC;
+static const ipv6_addr_t _nbr1_link_local = { .u8 = NBR1_LINK_LOCAL };
+static const uint8_t _nbr2_mac[] = NBR2_MAC;
+static const ipv6_addr_t _nbr2_link_local = { .u8 = NBR2_LINK_LOCAL };
+static const ipv6_addr_t _dst_pfx = { .u8 = DST_PFX };
+static const ipv6_addr_t _dst1 = { .u8 = DST1 };
+static const ipv6_addr_t _dst2 = { .u8 = DST2 };
+static const ipv6_addr_t _src = { .u8 = SRC };
+
+static mutex_t _forwarded = MUTEX_INIT_LOCKED;
+static const ipv6_addr_t *_fwd_dst;
+static uint8_t _fwd_mac[ETHERNET_ADDR_LEN];
+
+static int _get_forwarded(netdev_t *dev, const iolist_t *iolist)
+{
+    static uint8_t outbuf[sizeof(ethernet_hdr_t) + sizeof(ipv6_hdr_t)];
+    const ethernet_hdr_t *eth = (ethernet_hdr_t *)outbuf;
+    const ipv6_hdr_t *ipv6 = (ipv6_hdr_t *)(eth + 1);
+    size_t outbuf_len = 0U;
+    int res = 0;
+
+    (void)dev;
+    while (iolist) {
+        size_t len = iolist->iol_len;
+
+        if ((outbuf_len + len) > sizeof(outbuf)) {
+            len = sizeof(outbuf) - outbuf_len;
+        }
+        memcpy(&outbuf[outbuf_len], iolist->iol_base, len);
+        outbuf_len += len;
+        res += iolist->iol_len;
+        iolist = iolist->iol_next;
+    }
+    /* ignore neighbor discovery and other traffic of the node itself */
+    if ((outbuf_len == sizeof(outbuf)) && (_fwd_dst != NULL) &&
+        ipv6_addr_equal(&ipv6->dst, _fwd_dst)) {
+        memcpy(_fwd_mac, eth->dst, sizeof(_fwd_mac));
+        _fwd_dst = NULL;
+        mutex_unlock(&_forwarded);
+    }
+    return res;
+}
+
+/* lets the node forward a packet to dst, returns once it was sent */
+static int _forward(const ipv6_addr_t *dst)
+{
+    union {
+        ipv6_hdr_t hdr;
+        uint8_t u8[sizeof(ipv6_hdr_t) + PAYLOAD_LEN];
+    } data;
+    gnrc_pktsnip_t *netif, *pkt;
+
+    memset(&data, 0, sizeof(data));
+    ipv6_hdr_set_version(&data.hdr);
+    data.hdr.len = byteorder_htons(PAYLOAD_LEN);
+    data.hdr.nh = PROTNUM_IPV6_NONXT;
+    data.hdr.hl = 64;
+    memcpy(&data.hdr.src, &_src, sizeof(_src));
+    memcpy(&data.hdr.dst, dst, sizeof(data.hdr.dst));
+    netif = gnrc_netif_hdr_build(NULL, 0, NULL, 0);
+    if (netif == NULL) {
+        return -1;
+    }
+    gnrc_netif_hdr_set_netif(netif->data, _mock_netif);
+    pkt = gnrc_pktbuf_add(netif, data.u8, sizeof(data.u8), GNRC_NETTYPE_IPV6);
+    if (pkt == NULL) {
+        gnrc_pktbuf_release(netif);
+        return -1;
+    }
+    _fwd_dst = dst;
+    if (gnrc_netapi_dispatch_receive(GNRC_NETTYPE_IPV6,
+                                     GNRC_NETREG_DEMUX_CTX_ALL, pkt) < 1) {
+        gnrc_pktbuf_release(pkt);
+        return -1;
+    }
+    return xtimer_mutex_lock_timeout(&_forwarded, SEND_TIMEOUT);
+}
+
+static void set_up(void)
+{
+    gnrc_ipv6_nib_nc_set(&_nbr1_link_local, _mock_netif->pid,
+                         _nbr1_mac, sizeof(_nbr1_mac));
+    gnrc_ipv6_nib_nc_set(&_nbr2_link_local, _mock_netif->pid,
+                         _nbr2_mac, sizeof(_nbr2_mac));
+    gnrc_ipv6_nib_ft_add(&_dst_pfx, DST_PFX_LEN, &_nbr1_link_local,
+                         _mock_netif->pid, 0);
+}
+
+static void tear_down(void)
+{
+    gnrc_ipv6_nib_ft_del(&_dst_pfx, DST_PFX_LEN);
+    gnrc_ipv6_nib_nc_del(&_nbr1_link_local, _mock_netif->pid);
+    gnrc_ipv6_nib_nc_del(&_nbr2_link_local, _mock_netif->pid);
+}
+
+/*
+ * Forwards two packets to the same destination.
+ * Expected result: the first packet needs the NIB, the second one is sent to
+ * the same neighbor from the route cache.
+ */
+static void test_route_cache__hit(void)
+{
+    gnrc_ipv6_route_cache_stats_t before, after;
+
+    gnrc_ipv6_route_cache_get_stats(&before);
+    TEST_ASSERT_EQUAL_INT(0, _forward(&_dst1));
+    gnrc_ipv6_route_cache_get_stats(&after);
+    TEST_ASSERT_EQUAL_INT(before.misses + 1, after.misses);
+    TEST_ASSERT_EQUAL_INT(before.hits, after.hits);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(_nbr1_mac, _fwd_mac, sizeof(_nbr1_mac)));
+    before = after;
+    TEST_ASSERT_EQUAL_INT(0, _forward(&_dst1));
+    gnrc_ipv6_route_cache_get_stats(&after);
+    TEST_ASSERT_EQUAL_INT(before.misses, after.misses);
+    TEST_ASSERT_EQUAL_INT(before.hits + 1, after.hits);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(_nbr1_mac, _fwd_mac, sizeof(_nbr1_mac)));
+}
+
+/*
+ * Forwards a packet, changes the route to its destination and forwards
+ * another packet to the same destination.
+ * Expected result: the cached route is not used anymore, the second packet is
+ * sent to the new next hop.
+ */
+static void test_route_cache__route_change(void)
+{
+    gnrc_ipv6_route_cache_stats_t before, after;
+
+    TEST_ASSERT_EQUAL_INT(0, _forward(&_dst1));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(_nbr1_mac, _fwd_mac, sizeof(_nbr1_mac)));
+    gnrc_ipv6_nib_ft_del(&_dst_pfx, DST_PFX_LEN);
+    TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_nib_ft_add(&_dst_pfx, DST_PFX_LEN,
+                                                  &_nbr2_link_local,
+                                                  _mock_netif->pid, 0));
+    gnrc_ipv6_route_cache_get_stats(&before);
+    TEST_ASSERT_EQUAL_INT(0, _forward(&_dst1));
+    gnrc_ipv6_route_cache_get_stats(&after);
+    TEST_ASSERT_EQUAL_INT(before.misses + 1, after.misses);
+    TEST_ASSERT_EQUAL_INT(before.hits, after.hits);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(_nbr2_mac, _fwd_mac, sizeof(_nbr2_mac)));
+}
+
+/*
+ * Forwards a packet and then another one to a different destination within
+ * the same route.
+ * Expected result: the second packet is not answered from the route cache
+ * entry of the first destination.
+ */
+static void test_route_cache__miss(void)
+{
+    gnrc_ipv6_route_cache_stats_t before, after;
+
+    TEST_ASSERT_EQUAL_INT(0, _forward(&_dst1));
+    gnrc_ipv6_route_cache_get_stats(&before);
+    TEST_ASSERT_EQUAL_INT(0, _forward(&_dst2));
+    gnrc_ipv6_route_cache_get_stats(&after);
+    TEST_ASSERT_EQUAL_INT(before.misses + 1, after.misses);
+    TEST_ASSERT_EQUAL_INT(before.hits, after.hits);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(_nbr1_mac, _fwd_mac, sizeof(_nbr1_mac)));
+}
+
+static Test *tests_gnrc_ipv6_route_cache(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_route_cache__hit),
+        new_TestFixture(test_route_cache__route_change),
+        new_TestFixture(test_route_cache__miss),
+    };
+
+    EMB_UNIT_TESTCALLER(tests, set_up, tear_down, fixtures);
+
+    return (Test *)&tests;
+}
+
+int main(void)
+{
+    _tests_init();
+    netdev_test_set_send_cb((netdev_test_t *)_mock_netif->dev,
+                            _get_forwarded);
+
+    TESTS_START();
+    TESTS_RUN(tests_gnrc_ipv6_route_cache());
+    TESTS_END();
+
+    return 0;
+}
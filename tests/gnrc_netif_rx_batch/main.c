@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Receive throughput test for gnrc_netif's batched receive mode
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "msg.h"
+#include "net/gnrc/netapi.h"
+#include "net/gnrc/netreg.h"
+#include "net/gnrc/pktbuf.h"
+#include "shell.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define RCV_MSG_QUEUE_SIZE  (32U)
+
+static char _stack[THREAD_STACKSIZE_DEFAULT];
+static msg_t _msg_queue[RCV_MSG_QUEUE_SIZE];
+static char line_buf[SHELL_DEFAULT_BUFSIZE];
+
+static uint32_t _frames;
+static uint32_t _bytes;
+static uint32_t _first;
+static uint32_t _last;
+
+static void *_rcv_thread(void *arg)
+{
+    gnrc_netreg_entry_t entry = GNRC_NETREG_ENTRY_INIT_PID(
+            GNRC_NETREG_DEMUX_CTX_ALL, sched_active_pid
+        );
+
+    (void)arg;
+    msg_init_queue(_msg_queue, RCV_MSG_QUEUE_SIZE);
+    /* the frames of the test use an EtherType unknown to GNRC */
+    gnrc_netreg_register(GNRC_NETTYPE_UNDEF, &entry);
+    while (1) {
+        msg_t msg;
+
+        msg_receive(&msg);
+        if (msg.type == GNRC_NETAPI_MSG_TYPE_RCV) {
+            gnrc_pktsnip_t *pkt = msg.content.ptr;
+            uint32_t now = xtimer_now_usec();
+
+            if (_frames++ == 0) {
+                _first = now;
+            }
+            _last = now;
+            /* only the payload, i.e. without the netif header */
+            _bytes += pkt->size;
+            gnrc_pktbuf_release(pkt);
+        }
+    }
+    return NULL;
+}
+
+static int _rx(int argc, char **argv)
+{
+    if ((argc > 1) && (strcmp(argv[1], "reset") == 0)) {
+        _frames = 0;
+        _bytes = 0;
+        puts("rx: reset");
+        return 0;
+    }
+    else if (argc > 1) {
+        printf("usage: %s [reset]\n", argv[0]);
+        return 1;
+    }
+    printf("rx: %" PRIu32 " frames, %" PRIu32 " bytes in %" PRIu32 " us\n",
+           _frames, _bytes, (_frames > 0) ? (_last - _first) : 0);
+    return 0;
+}
+
+static const shell_command_t shell_commands[] = {
+    { "rx", "Show or reset receive statistics", _rx },
+    { NULL, NULL, NULL }
+};
+
+int main(void)
+{
+    thread_create(_stack, sizeof(_stack), THREAD_PRIORITY_MAIN - 1,
+                  THREAD_CREATE_STACKTEST, _rcv_thread, NULL, "rcv");
+    shell_run(shell_commands, line_buf, SHELL_DEFAULT_BUFSIZE);
+    return 0;
+}
@@ -0,0 +1,102 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2020 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import os
+import re
+import sys
+import subprocess
+import time
+
+from scapy.all import Ether, Raw, sendp
+from testrunner import run
+
+
+FRAMES_NUMOF = 1000
+# frames may still be dropped under load, e.g. by the host
+FRAMES_MIN = FRAMES_NUMOF * 9 // 10
+PAYLOAD_LEN = 1000
+# IEEE Std 802 - Local Experimental EtherType, unknown to GNRC
+ETHERTYPE = 0x88b5
+
+
+def check_and_search_output(cmd, pattern, res_group, *args, **kwargs):
+    output = subprocess.check_output(cmd, *args, **kwargs).decode("utf-8")
+    for line in output.splitlines():
+        m = re.search(pattern, line)
+        if m is not None:
+            return m.group(res_group)
+    return None
+
+
+def get_bridge(tap):
+    res = check_and_search_output(
+            ["bridge", "link"],
+            r"{}.+master\s+(?P<master>[^\s]+)".format(tap),
+            "master"
+        )
+    return tap if res is None else res
+
+
+def rx_stats(child):
+    child.sendline("rx")
+    child.expect(r"rx: (\d+) frames, (\d+) bytes in (\d+) us")
+    return [int(child.match.group(i)) for i in range(1, 4)]
+
+
+def pktbuf_empty(child):
+    child.sendline("pktbuf")
+    child.expect(r"packet buffer: first byte: (?P<first_byte>0x[0-9a-fA-F]+), "
+                 r"last byte: 0x[0-9a-fA-F]+ \(size: (?P<size>\d+)\)")
+    first_byte = child.match.group("first_byte")
+    size = child.match.group("size")
+    child.expect(
+            r"~ unused: {} \(next: (\(nil\)|0), size: {}\) ~".format(
+                first_byte, size))
+
+
+def testfunc(child):
+    tap = get_bridge(os.environ["TAP"])
+
+    child.sendline("ifconfig")
+    child.expect(r"HWaddr: (?P<hwaddr>[A-Fa-f:0-9]+)\s")
+    hwaddr_dst = child.match.group("hwaddr").lower()
+    child.sendline("rx reset")
+    child.expect_exact("rx: reset")
+
+    frames = [Ether(dst=hwaddr_dst, type=ETHERTYPE) /
+              Raw(load=bytes([i & 0xff]) * PAYLOAD_LEN)
+              for i in range(FRAMES_NUMOF)]
+    sendp(frames, iface=tap, verbose=0)
+
+    # wait for the node to process the burst
+    stats = rx_stats(child)
+    for _ in range(10):
+        if stats[0] >= FRAMES_NUMOF:
+            break
+        time.sleep(0.5)
+        last = stats
+        stats = rx_stats(child)
+        if (stats[0] >= FRAMES_MIN) and (stats == last):
+            break
+    frames_recv, bytes_recv, usec = stats
+    assert FRAMES_MIN <= frames_recv <= FRAMES_NUMOF
+    assert bytes_recv == frames_recv * (len(frames[0]) - len(Ether()))
+    if usec > 0:
+        print("{} of {} frames in {} us ({:.0f} frames/s)".format(
+              frames_recv, FRAMES_NUMOF, usec, frames_recv * 1000000 / usec))
+    pktbuf_empty(child)
+    print("SUCCESS")
+
+
+if __name__ == "__main__":
+    if os.geteuid() != 0:
+        print("\x1b[1;31mThis test requires root privileges.\n"
+              "It's constructing and sending Ethernet frames.\x1b[0m\n",
+              file=sys.stderr)
+        sys.exit(1)
+    sys.exit(run(testfunc, timeout=10, echo=False))
@@ -0,0 +1,269 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Tests the send queue of GNRC's network interfaces
+ *
+ * @}
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "embUnit.h"
+#include "net/ethernet.h"
+#include "net/gnrc.h"
+#include "net/gnrc/netif.h"
+#include "net/gnrc/netif/ethernet.h"
+#include "net/netdev_test.h"
+#include "net/netstats.h"
+#include "test_utils/expect.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define SENT_MAX            (GNRC_NETIF_TXQ_SIZE + 2)
+
+static const uint8_t _l2addr[] = { 0xce, 0xab, 0xfe, 0xad, 0xf7, 0x26 };
+
+static gnrc_netif_t _netif;
+static netdev_test_t _dev;
+static char _netif_stack[THREAD_STACKSIZE_DEFAULT];
+
+/* payloads of the frames handed to the device, in order */
+static uint8_t _sent[SENT_MAX];
+static unsigned _sent_numof;
+/* event the device reports on its next interrupt */
+static netdev_event_t _tx_end_event;
+
+static int _get_device_type(netdev_t *dev, void *value, size_t max_len)
+{
+    (void)dev;
+    expect(max_len == sizeof(uint16_t));
+    *((uint16_t *)value) = NETDEV_TYPE_ETHERNET;
+    return sizeof(uint16_t);
+}
+
+static int _get_max_packet_size(netdev_t *dev, void *value, size_t max_len)
+{
+    (void)dev;
+    expect(max_len == sizeof(uint16_t));
+    *((uint16_t *)value) = ETHERNET_DATA_LEN;
+    return sizeof(uint16_t);
+}
+
+static int _get_address(netdev_t *dev, void *value, size_t max_len)
+{
+    (void)dev;
+    expect(max_len >= sizeof(_l2addr));
+    memcpy(value, _l2addr, sizeof(_l2addr));
+    return sizeof(_l2addr);
+}
+
+static int _set_tx_end_irq(netdev_t *dev, const void *value, size_t len)
+{
+    (void)dev;
+    (void)value;
+    return len;
+}
+
+/* takes the frame, but only reports the end of the transmission on the
+ * interrupt triggered by _tx_end() */
+static int _send(netdev_t *dev, const iolist_t *iolist)
+{
+    int res = 0;
+
+    (void)dev;
+    expect((iolist->iol_next != NULL) && (_sent_numof < SENT_MAX));
+    _sent[_sent_numof++] = *((uint8_t *)iolist->iol_next->iol_base);
+    for (; iolist; iolist = iolist->iol_next) {
+        res += iolist->iol_len;
+    }
+    return res;
+}
+
+static void _isr(netdev_t *dev)
+{
+    dev->event_callback(dev, _tx_end_event);
+}
+
+/* returns after the interface's thread handled the event */
+static void _tx_end(netdev_event_t event)
+{
+    _tx_end_event = event;
+    _dev.netdev.event_callback(&_dev.netdev, NETDEV_EVENT_ISR);
+}
+
+static int _send_pkt(uint8_t id)
+{
+    gnrc_pktsnip_t *netif, *pkt;
+    int res;
+
+    netif = gnrc_netif_hdr_build(NULL, 0, NULL, 0);
+    expect(netif != NULL);
+    ((gnrc_netif_hdr_t *)netif->data)->flags |= GNRC_NETIF_HDR_FLAGS_BROADCAST;
+    pkt = gnrc_pktbuf_add(NULL, &id, sizeof(id), GNRC_NETTYPE_UNDEF);
+    expect(pkt != NULL);
+    netif->next = pkt;
+    if ((res = gnrc_netif_send(&_netif, netif)) < 1) {
+        gnrc_pktbuf_release(netif);
+    }
+    return res;
+}
+
+/* lets the device finish all transmissions, returns the number of packets
+ * sent meanwhile */
+static unsigned _drain(void)
+{
+    unsigned start = _sent_numof, last;
+
+    do {
+        last = _sent_numof;
+        _tx_end(NETDEV_EVENT_TX_COMPLETE);
+    } while (_sent_numof != last);
+    return _sent_numof - start;
+}
+
+static netstats_t *_stats(void)
+{
+    netstats_t *stats;
+
+    expect(gnrc_netapi_get(_netif.pid, NETOPT_STATS, NETSTATS_LAYER2, &stats,
+                           sizeof(stats)) == sizeof(stats));
+    return stats;
+}
+
+static void set_up(void)
+{
+    memset(_sent, 0, sizeof(_sent));
+    _sent_numof = 0;
+}
+
+static void tear_down(void)
+{
+    _drain();
+}
+
+/*
+ * Sends three packets, the device reports the end of every transmission.
+ * Expected result: only one packet is handed to the device at a time, the
+ * next one after the previous one was reported done.
+ */
+static void test_txq__enqueue(void)
+{
+    uint32_t tx_success = _stats()->tx_success;
+
+    for (uint8_t i = 0; i < 3; i++) {
+        TEST_ASSERT_EQUAL_INT(1, _send_pkt(i));
+    }
+    TEST_ASSERT_EQUAL_INT(1, _sent_numof);
+    _tx_end(NETDEV_EVENT_TX_COMPLETE);
+    TEST_ASSERT_EQUAL_INT(2, _sent_numof);
+    _tx_end(NETDEV_EVENT_TX_COMPLETE);
+    TEST_ASSERT_EQUAL_INT(3, _sent_numof);
+    _tx_end(NETDEV_EVENT_TX_COMPLETE);
+    TEST_ASSERT_EQUAL_INT(3, _sent_numof);
+    for (uint8_t i = 0; i < 3; i++) {
+        TEST_ASSERT_EQUAL_INT(i, _sent[i]);
+    }
+    TEST_ASSERT_EQUAL_INT(tx_success + 3, _stats()->tx_success);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+/*
+ * Sends one packet more than fits into the queue while the device is busy.
+ * Expected result: the last packet is dropped and counted as such, all others
+ * are sent once the device finishes.
+ */
+static void test_txq__full(void)
+{
+    uint32_t tx_dropped = _stats()->tx_dropped;
+
+    /* the first one goes to the device right away */
+    for (uint8_t i = 0; i < (GNRC_NETIF_TXQ_SIZE + 1); i++) {
+        TEST_ASSERT_EQUAL_INT(1, _send_pkt(i));
+    }
+    TEST_ASSERT_EQUAL_INT(1, _sent_numof);
+    TEST_ASSERT_EQUAL_INT(0, _send_pkt(GNRC_NETIF_TXQ_SIZE + 1));
+    TEST_ASSERT_EQUAL_INT(tx_dropped + 1, _stats()->tx_dropped);
+    TEST_ASSERT_EQUAL_INT(GNRC_NETIF_TXQ_SIZE, _drain());
+    for (uint8_t i = 0; i < (GNRC_NETIF_TXQ_SIZE + 1); i++) {
+        TEST_ASSERT_EQUAL_INT(i, _sent[i]);
+    }
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+/*
+ * Sends three packets, the device reports failed transmissions.
+ * Expected result: the next packet is sent after any end of a transmission.
+ */
+static void test_txq__tx_failed(void)
+{
+    for (uint8_t i = 0; i < 3; i++) {
+        TEST_ASSERT_EQUAL_INT(1, _send_pkt(i));
+    }
+    TEST_ASSERT_EQUAL_INT(1, _sent_numof);
+    _tx_end(NETDEV_EVENT_TX_NOACK);
+    TEST_ASSERT_EQUAL_INT(2, _sent_numof);
+    _tx_end(NETDEV_EVENT_TX_MEDIUM_BUSY);
+    TEST_ASSERT_EQUAL_INT(3, _sent_numof);
+}
+
+/*
+ * Sends two packets, the device never reports the end of the first
+ * transmission.
+ * Expected result: the second packet is sent once the timeout passed.
+ */
+static void test_txq__tx_end_timeout(void)
+{
+    TEST_ASSERT_EQUAL_INT(1, _send_pkt(0));
+    TEST_ASSERT_EQUAL_INT(1, _send_pkt(1));
+    xtimer_usleep(CONFIG_GNRC_NETIF_TXQ_TX_END_TIMEOUT_US / 2);
+    TEST_ASSERT_EQUAL_INT(1, _sent_numof);
+    xtimer_usleep(CONFIG_GNRC_NETIF_TXQ_TX_END_TIMEOUT_US);
+    TEST_ASSERT_EQUAL_INT(2, _sent_numof);
+    TEST_ASSERT_EQUAL_INT(1, _sent[1]);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static Test *tests_gnrc_netif_txq(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_txq__enqueue),
+        new_TestFixture(test_txq__full),
+        new_TestFixture(test_txq__tx_failed),
+        new_TestFixture(test_txq__tx_end_timeout),
+    };
+
+    EMB_UNIT_TESTCALLER(tests, set_up, tear_down, fixtures);
+
+    return (Test *)&tests;
+}
+
+int main(void)
+{
+    netdev_test_setup(&_dev, 0);
+    netdev_test_set_get_cb(&_dev, NETOPT_DEVICE_TYPE, _get_device_type);
+    netdev_test_set_get_cb(&_dev, NETOPT_MAX_PDU_SIZE, _get_max_packet_size);
+    netdev_test_set_get_cb(&_dev, NETOPT_ADDRESS, _get_address);
+    netdev_test_set_set_cb(&_dev, NETOPT_TX_END_IRQ, _set_tx_end_irq);
+    netdev_test_set_send_cb(&_dev, _send);
+    netdev_test_set_isr_cb(&_dev, _isr);
+    expect(gnrc_netif_ethernet_create(&_netif, _netif_stack,
+                                      sizeof(_netif_stack), GNRC_NETIF_PRIO,
+                                      "mockup_eth", &_dev.netdev) == 0);
+
+    TESTS_START();
+    TESTS_RUN(tests_gnrc_netif_txq());
+    TESTS_END();
+
+    return 0;
+}
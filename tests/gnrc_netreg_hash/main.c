@@ -0,0 +1,30 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Runs the unittests of GNRC's network registry with
+ *              gnrc_netreg_hash
+ *
+ * @}
+ */
+
+#include "embUnit.h"
+#include "tests-netreg.h"
+
+int main(void)
+{
+    TESTS_START();
+    tests_netreg();
+    TESTS_END();
+
+    return 0;
+}
@@ -0,0 +1,172 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Tests the slab allocator backend of the GNRC packet buffer
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include "embUnit.h"
+#include "net/gnrc/pktbuf.h"
+
+#define TEST_STRING8    "PKTBUF8"
+#define TEST_STRING16   "PKTBUF-TEST-16!"
+
+static void _set_up(void)
+{
+    gnrc_pktbuf_init();
+}
+
+static void test_pktbuf_add__size_classes(void)
+{
+    gnrc_pktsnip_t *hdr, *small, *large;
+
+    hdr = gnrc_pktbuf_add(NULL, TEST_STRING8, sizeof(TEST_STRING8),
+                          GNRC_NETTYPE_TEST);
+    small = gnrc_pktbuf_add(NULL, NULL, CONFIG_GNRC_PKTBUF_SLAB_SMALL_SIZE,
+                            GNRC_NETTYPE_TEST);
+    large = gnrc_pktbuf_add(NULL, NULL, CONFIG_GNRC_PKTBUF_SLAB_LARGE_SIZE,
+                            GNRC_NETTYPE_TEST);
+    TEST_ASSERT_NOT_NULL(hdr);
+    TEST_ASSERT_NOT_NULL(small);
+    TEST_ASSERT_NOT_NULL(large);
+    TEST_ASSERT_EQUAL_STRING(TEST_STRING8, hdr->data);
+    TEST_ASSERT(gnrc_pktbuf_is_sane());
+    TEST_ASSERT(!gnrc_pktbuf_is_empty());
+    TEST_ASSERT_NULL(gnrc_pktbuf_add(NULL, NULL,
+                                     CONFIG_GNRC_PKTBUF_SLAB_LARGE_SIZE + 1,
+                                     GNRC_NETTYPE_TEST));
+    gnrc_pktbuf_release(hdr);
+    gnrc_pktbuf_release(small);
+    gnrc_pktbuf_release(large);
+    TEST_ASSERT(gnrc_pktbuf_is_sane());
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_pktbuf_add__exhaust_and_fall_back(void)
+{
+    gnrc_pktsnip_t *pkts[CONFIG_GNRC_PKTBUF_SLAB_HDR_NUMOF + 1];
+
+    /* exhaust the header class, the next allocation must fall back to a
+     * larger class */
+    for (unsigned i = 0; i < ARRAY_SIZE(pkts); i++) {
+        pkts[i] = gnrc_pktbuf_add(NULL, TEST_STRING16, sizeof(TEST_STRING16),
+                                  GNRC_NETTYPE_TEST);
+        TEST_ASSERT_NOT_NULL(pkts[i]);
+    }
+    TEST_ASSERT(gnrc_pktbuf_is_sane());
+    for (unsigned i = 0; i < ARRAY_SIZE(pkts); i++) {
+        TEST_ASSERT_EQUAL_STRING(TEST_STRING16, pkts[i]->data);
+        gnrc_pktbuf_release(pkts[i]);
+    }
+    TEST_ASSERT(gnrc_pktbuf_is_sane());
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_pktbuf_mark__shared_block(void)
+{
+    gnrc_pktsnip_t *pkt, *hdr;
+
+    pkt = gnrc_pktbuf_add(NULL, TEST_STRING16, sizeof(TEST_STRING16),
+                          GNRC_NETTYPE_TEST);
+    TEST_ASSERT_NOT_NULL(pkt);
+    hdr = gnrc_pktbuf_mark(pkt, 8, GNRC_NETTYPE_UNDEF);
+    TEST_ASSERT_NOT_NULL(hdr);
+    TEST_ASSERT(pkt->next == hdr);
+    TEST_ASSERT_EQUAL_INT(8, hdr->size);
+    TEST_ASSERT_EQUAL_INT(sizeof(TEST_STRING16) - 8, pkt->size);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(TEST_STRING16, hdr->data, 8));
+    TEST_ASSERT_EQUAL_STRING(TEST_STRING16 + 8, pkt->data);
+    TEST_ASSERT(gnrc_pktbuf_is_sane());
+    /* releasing the header snip only must keep the payload intact */
+    pkt->next = NULL;
+    gnrc_pktbuf_release(hdr);
+    TEST_ASSERT(gnrc_pktbuf_is_sane());
+    TEST_ASSERT(!gnrc_pktbuf_is_empty());
+    TEST_ASSERT_EQUAL_STRING(TEST_STRING16 + 8, pkt->data);
+    gnrc_pktbuf_release(pkt);
+    TEST_ASSERT(gnrc_pktbuf_is_sane());
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_pktbuf_realloc_data__grow_and_shrink(void)
+{
+    gnrc_pktsnip_t *pkt;
+    void *data;
+
+    pkt = gnrc_pktbuf_add(NULL, TEST_STRING8, sizeof(TEST_STRING8),
+                          GNRC_NETTYPE_TEST);
+    TEST_ASSERT_NOT_NULL(pkt);
+    data = pkt->data;
+    /* still fits into the header block => stays in place */
+    TEST_ASSERT_EQUAL_INT(0, gnrc_pktbuf_realloc_data(pkt, sizeof(TEST_STRING16)));
+    TEST_ASSERT(data == pkt->data);
+    /* needs a larger class => moves */
+    TEST_ASSERT_EQUAL_INT(0, gnrc_pktbuf_realloc_data(pkt,
+                                    CONFIG_GNRC_PKTBUF_SLAB_SMALL_SIZE));
+    TEST_ASSERT(data != pkt->data);
+    TEST_ASSERT_EQUAL_STRING(TEST_STRING8, pkt->data);
+    TEST_ASSERT_EQUAL_INT(0, gnrc_pktbuf_realloc_data(pkt, 4));
+    TEST_ASSERT_EQUAL_INT(4, pkt->size);
+    TEST_ASSERT_EQUAL_INT(ENOMEM, gnrc_pktbuf_realloc_data(pkt,
+                                    CONFIG_GNRC_PKTBUF_SLAB_LARGE_SIZE + 1));
+    TEST_ASSERT(gnrc_pktbuf_is_sane());
+    gnrc_pktbuf_release(pkt);
+    TEST_ASSERT(gnrc_pktbuf_is_sane());
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_pktbuf_start_write__copy(void)
+{
+    gnrc_pktsnip_t *pkt, *copy;
+
+    pkt = gnrc_pktbuf_add(NULL, TEST_STRING8, sizeof(TEST_STRING8),
+                          GNRC_NETTYPE_TEST);
+    TEST_ASSERT_NOT_NULL(pkt);
+    gnrc_pktbuf_hold(pkt, 1);
+    copy = gnrc_pktbuf_start_write(pkt);
+    TEST_ASSERT_NOT_NULL(copy);
+    TEST_ASSERT(copy != pkt);
+    TEST_ASSERT(copy->data != pkt->data);
+    TEST_ASSERT_EQUAL_STRING(TEST_STRING8, copy->data);
+    gnrc_pktbuf_release(copy);
+    gnrc_pktbuf_release(pkt);
+    TEST_ASSERT(gnrc_pktbuf_is_sane());
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static Test *tests_pktbuf_slab_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_pktbuf_add__size_classes),
+        new_TestFixture(test_pktbuf_add__exhaust_and_fall_back),
+        new_TestFixture(test_pktbuf_mark__shared_block),
+        new_TestFixture(test_pktbuf_realloc_data__grow_and_shrink),
+        new_TestFixture(test_pktbuf_start_write__copy),
+    };
+
+    EMB_UNIT_TESTCALLER(pktbuf_slab_tests, _set_up, NULL, fixtures);
+
+    return (Test *)&pktbuf_slab_tests;
+}
+
+int main(void)
+{
+    TESTS_START();
+    TESTS_RUN(tests_pktbuf_slab_tests());
+    TESTS_END();
+    return 0;
+}
@@ -0,0 +1,170 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2020 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import os
+import re
+import select
+import socket
+import sys
+import threading
+import time
+
+import pexpect
+from testrunner import run
+
+
+RELAY_PORT = int(os.environ.get("ZEP_RELAY_PORT", 17760))
+ROOT, ROUTER1, ROUTER2, LEAF = range(4)
+NODES = 4
+# the root can't reach the leaf directly
+LINKS = {(ROOT, ROUTER1), (ROOT, ROUTER2), (ROUTER1, LEAF), (ROUTER2, LEAF)}
+
+DODAG_ID = "2001:db8::1"
+INSTANCE_ID = 1
+OCP_MRHOF = 1
+# needs to match CONFIG_GNRC_RPL_DEFAULT_MIN_HOP_RANK_INCREASE in the Makefile
+MIN_HOP_RANK_INC = 64
+ROOT_RANK = MIN_HOP_RANK_INC
+# rank increase over a link with ETX 1 and over a link nothing was sent over
+# yet (CONFIG_GNRC_RPL_MRHOF_INIT_ETX)
+ETX_1 = 128
+INIT_ETX = 256
+JOIN_TIMEOUT = 60
+
+
+def node_port(node):
+    return RELAY_PORT + 1 + node
+
+
+def neighbors(node):
+    for a, b in LINKS:
+        if a == node:
+            yield b
+        elif b == node:
+            yield a
+
+
+class ZepRelay(threading.Thread):
+    """Forwards ZEP frames of a node to its neighbors in LINKS"""
+
+    def __init__(self):
+        super().__init__(daemon=True)
+        self.sock = socket.socket(family=socket.AF_INET6,
+                                  type=socket.SOCK_DGRAM)
+        self.sock.bind(("::1", RELAY_PORT))
+        self.stopped = threading.Event()
+
+    def run(self):
+        while not self.stopped.is_set():
+            readable, _, _ = select.select([self.sock], [], [], 0.1)
+            if not readable:
+                continue
+            data, addr = self.sock.recvfrom(1024)
+            src = addr[1] - RELAY_PORT - 1
+            for dst in neighbors(src):
+                self.sock.sendto(data, ("::1", node_port(dst)))
+
+    def stop(self):
+        self.stopped.set()
+        self.join()
+        self.sock.close()
+
+
+def spawn_node(node):
+    child = pexpect.spawnu(os.environ["ELFFILE"],
+                           ["-z", "[::1]:{},[::1]:{}".format(node_port(node),
+                                                             RELAY_PORT)],
+                           timeout=10)
+    child.logfile = sys.stdout
+    return child
+
+
+def iface(child):
+    child.sendline("ifconfig")
+    child.expect(r"Iface\s+(\d+)\s")
+    res = int(child.match.group(1))
+    child.expect_exact("> ")
+    return res
+
+
+def rpl_init(child):
+    if_id = iface(child)
+    child.sendline("rpl init {}".format(if_id))
+    child.expect_exact("successfully initialized RPL on interface {}"
+                       .format(if_id))
+    return if_id
+
+
+def wait_for_rank(child):
+    deadline = time.time() + JOIN_TIMEOUT
+    while time.time() < deadline:
+        child.sendline("rpl")
+        res = child.expect([r"instance \[(\d+) \| Iface: \d+ \| mop: \d+ \| "
+                            r"ocp: (\d+) \| mhri: (\d+) \| mri \d+\]\s+"
+                            r"dodag \[([0-9a-f:]+) \| R: (\d+)", "> "])
+        if res == 0:
+            assert int(child.match.group(1)) == INSTANCE_ID
+            assert int(child.match.group(2)) == OCP_MRHOF
+            assert int(child.match.group(3)) == MIN_HOP_RANK_INC
+            assert child.match.group(4) == DODAG_ID
+            rank = int(child.match.group(5))
+            child.expect_exact("> ")
+            if rank != 0xffff:
+                return rank
+        time.sleep(1)
+    raise RuntimeError("node did not join the DODAG")
+
+
+def testfunc(root):
+    nodes = [root] + [spawn_node(n) for n in range(1, NODES)]
+    try:
+        for node in nodes:
+            node.expect_exact("RPL MRHOF test node")
+        if_id = rpl_init(root)
+        root.sendline("ifconfig {} add {}/64".format(if_id, DODAG_ID))
+        root.expect_exact("success: added {}/64".format(DODAG_ID))
+        for node in nodes[1:]:
+            rpl_init(node)
+        root.sendline("rpl root {} {}".format(INSTANCE_ID, DODAG_ID))
+        root.expect_exact("successfully added a new RPL DODAG")
+        assert wait_for_rank(root) == ROOT_RANK
+        # the rank increases by the ETX of the link to the parent, OF0 would
+        # only add MinHopRankIncrease. Whether the link was used when the
+        # rank was calculated is up to timing, and the hysteresis keeps the
+        # rank after that.
+        router_ranks = [wait_for_rank(nodes[ROUTER1]),
+                        wait_for_rank(nodes[ROUTER2])]
+        for rank in router_ranks:
+            assert rank - ROOT_RANK in (ETX_1, INIT_ETX)
+        leaf_rank = wait_for_rank(nodes[LEAF])
+        leaf = nodes[LEAF]
+        leaf.sendline("rpl")
+        leaf.expect(r"parent \[addr: (fe80::[0-9a-f:]+) \| rank: (\d+)\]")
+        parent_rank = int(leaf.match.group(2))
+        assert parent_rank in router_ranks
+        assert leaf_rank - parent_rank in (ETX_1, INIT_ETX)
+        leaf.expect_exact("> ")
+        leaf.sendline("ping6 -c 5 {}".format(DODAG_ID))
+        leaf.expect(re.escape("bytes from {}".format(DODAG_ID)), timeout=20)
+        leaf.expect(r"(\d+) packets transmitted, (\d+) packets received",
+                    timeout=20)
+    finally:
+        for node in nodes[1:]:
+            node.close(force=True)
+
+
+if __name__ == "__main__":
+    os.environ["TERMFLAGS"] = "-z [::1]:{},[::1]:{}".format(node_port(ROOT),
+                                                             RELAY_PORT)
+    relay = ZepRelay()
+    relay.start()
+    try:
+        res = run(testfunc, timeout=10, echo=True, traceback=True)
+    finally:
+        relay.stop()
+    sys.exit(res)
@@ -18,6 +18,7 @@
  * @}
  */
 
+#include "bitfield.h"
 #include "embUnit.h"
 #include "net/gnrc/pktbuf.h"
 #include "net/gnrc/netreg.h"
@@ -235,10 +236,12 @@ static void _test_entry(const gnrc_sixlowpan_frag_rb_t *entry,
                         "entry->super.dst != TEST_NETIF_HDR_DST");
     TEST_ASSERT_EQUAL_INT(TEST_TAG, entry->super.tag);
     TEST_ASSERT_EQUAL_INT(exp_current_size, entry->super.current_size);
-    TEST_ASSERT_NOT_NULL(entry->super.ints);
-    TEST_ASSERT_NULL(entry->super.ints->next);
-    TEST_ASSERT_EQUAL_INT(exp_int_start, entry->super.ints->start);
-    TEST_ASSERT_EQUAL_INT(exp_int_end, entry->super.ints->end);
+    /* only the 8-octet blocks of the expected interval are marked received */
+    for (unsigned i = 0; i < GNRC_SIXLOWPAN_FRAG_RB_BLOCKS; i++) {
+        bool exp = ((exp_int_start / 8U) <= i) && (i <= (exp_int_end / 8U));
+
+        TEST_ASSERT(exp == bf_isset((uint8_t *)entry->received, i));
+    }
 }
 
 static void _check_pktbuf(const gnrc_sixlowpan_frag_rb_t *entry)
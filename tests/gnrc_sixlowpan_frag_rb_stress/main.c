@@ -0,0 +1,259 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Stress test for parallel reassembly of many 6LoWPAN datagrams
+ *              in the gnrc reassembly buffer
+ *
+ * @}
+ */
+
+#include <string.h>
+
+#include "embUnit.h"
+#include "net/gnrc/netreg.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/sixlowpan/frag/rb.h"
+#include "net/sixlowpan.h"
+#include "xtimer.h"
+
+#define TEST_DATAGRAMS          (64U)
+#define TEST_SOURCES            (8U)
+#define TEST_NETIF_HDR_SRC      { 0xb3, 0x47, 0x60, 0x49, \
+                                  0x78, 0xfe, 0x95, 0x00 }
+#define TEST_NETIF_HDR_DST      { 0xa4, 0xf2, 0xd2, 0xc9, \
+                                  0x13, 0xb9, 0xbb, 0x25 }
+#define TEST_NETIF_IFACE        (9)
+#define TEST_TAG                (0x690e)
+#define TEST_PAGE               (0)
+#define TEST_RECEIVE_TIMEOUT    (100U)
+
+/* every datagram consists of three fragments */
+#define TEST_DATAGRAM_SIZE      (40U)
+#define TEST_FRAGMENT1_OFFSET   (0U)
+#define TEST_FRAGMENT2_OFFSET   (16U)
+#define TEST_FRAGMENT3_OFFSET   (32U)
+
+/* reassembled datagrams are not IPv6 datagrams, see
+ * gnrc_sixlowpan_dispatch_recv() */
+#define TEST_DATAGRAM_NETTYPE   (GNRC_NETTYPE_UNDEF)
+
+static const uint8_t _test_netif_hdr_dst[] = TEST_NETIF_HDR_DST;
+static struct {
+    gnrc_netif_hdr_t hdr;
+    uint8_t src[GNRC_NETIF_HDR_L2ADDR_MAX_LEN];
+    uint8_t dst[GNRC_NETIF_HDR_L2ADDR_MAX_LEN];
+} _test_netif_hdr;
+
+static msg_t _msg_queue;
+
+static inline uint8_t _datagram_byte(unsigned dg, unsigned pos)
+{
+    return (uint8_t)(dg + pos);
+}
+
+/* datagrams are spread over several sources with several tags each */
+static void _set_netif_hdr(unsigned dg)
+{
+    uint8_t src[] = TEST_NETIF_HDR_SRC;
+
+    src[sizeof(src) - 1] = dg % TEST_SOURCES;
+    gnrc_netif_hdr_set_src_addr(&_test_netif_hdr.hdr, src, sizeof(src));
+}
+
+static inline uint16_t _tag(unsigned dg)
+{
+    return TEST_TAG + (dg / TEST_SOURCES);
+}
+
+static gnrc_pktsnip_t *_build_fragment(unsigned dg, unsigned offset)
+{
+    uint8_t buf[sizeof(sixlowpan_frag_t) + 1 + TEST_FRAGMENT2_OFFSET];
+    unsigned end = offset + TEST_FRAGMENT2_OFFSET;
+    uint8_t *payload;
+
+    if (end > TEST_DATAGRAM_SIZE) {
+        end = TEST_DATAGRAM_SIZE;
+    }
+    if (offset == 0) {
+        sixlowpan_frag_t *hdr = (sixlowpan_frag_t *)buf;
+
+        hdr->disp_size = byteorder_htons(TEST_DATAGRAM_SIZE);
+        hdr->disp_size.u8[0] |= SIXLOWPAN_FRAG_1_DISP;
+        hdr->tag = byteorder_htons(_tag(dg));
+        payload = buf + sizeof(sixlowpan_frag_t);
+        *(payload++) = SIXLOWPAN_UNCOMP;
+    }
+    else {
+        sixlowpan_frag_n_t *hdr = (sixlowpan_frag_n_t *)buf;
+
+        hdr->disp_size = byteorder_htons(TEST_DATAGRAM_SIZE);
+        hdr->disp_size.u8[0] |= SIXLOWPAN_FRAG_N_DISP;
+        hdr->tag = byteorder_htons(_tag(dg));
+        hdr->offset = offset / 8;
+        payload = buf + sizeof(sixlowpan_frag_n_t);
+    }
+    for (unsigned pos = offset; pos < end; pos++) {
+        *(payload++) = _datagram_byte(dg, pos);
+    }
+    return gnrc_pktbuf_add(NULL, buf, payload - buf, GNRC_NETTYPE_SIXLOWPAN);
+}
+
+static gnrc_sixlowpan_frag_rb_t *_add_fragment(unsigned dg, unsigned offset)
+{
+    gnrc_pktsnip_t *pkt = _build_fragment(dg, offset);
+
+    if (pkt == NULL) {
+        return NULL;
+    }
+    _set_netif_hdr(dg);
+    return gnrc_sixlowpan_frag_rb_add(&_test_netif_hdr.hdr, pkt, offset,
+                                      TEST_PAGE);
+}
+
+static void _check_datagram(unsigned dg)
+{
+    msg_t msg = { .type = 0U };
+    gnrc_pktsnip_t *datagram;
+
+    TEST_ASSERT_MESSAGE(
+            xtimer_msg_receive_timeout(&msg, TEST_RECEIVE_TIMEOUT) >= 0,
+            "Receiving reassembled datagram timed out"
+        );
+    TEST_ASSERT_EQUAL_INT(GNRC_NETAPI_MSG_TYPE_RCV, msg.type);
+    TEST_ASSERT_NOT_NULL(msg.content.ptr);
+    datagram = msg.content.ptr;
+    TEST_ASSERT_EQUAL_INT(TEST_DATAGRAM_SIZE, datagram->size);
+    for (unsigned pos = 0; pos < TEST_DATAGRAM_SIZE; pos++) {
+        TEST_ASSERT_EQUAL_INT(_datagram_byte(dg, pos),
+                              ((uint8_t *)datagram->data)[pos]);
+    }
+    gnrc_pktbuf_release(datagram);
+}
+
+static unsigned _rbuf_entries(void)
+{
+    const gnrc_sixlowpan_frag_rb_t *rbuf = gnrc_sixlowpan_frag_rb_array();
+    unsigned entries = 0;
+
+    for (unsigned i = 0; i < CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE; i++) {
+        if (!gnrc_sixlowpan_frag_rb_entry_empty(&rbuf[i])) {
+            entries++;
+        }
+    }
+    return entries;
+}
+
+static void _set_up(void)
+{
+    gnrc_sixlowpan_frag_rb_reset();
+    gnrc_pktbuf_init();
+    gnrc_netif_hdr_init(&_test_netif_hdr.hdr,
+                        GNRC_NETIF_HDR_L2ADDR_MAX_LEN,
+                        GNRC_NETIF_HDR_L2ADDR_MAX_LEN);
+    _test_netif_hdr.hdr.if_pid = TEST_NETIF_IFACE;
+    gnrc_netif_hdr_set_dst_addr(&_test_netif_hdr.hdr,
+                                (uint8_t *)_test_netif_hdr_dst,
+                                sizeof(_test_netif_hdr_dst));
+}
+
+static void test_rbuf_stress__interleaved(void)
+{
+    gnrc_sixlowpan_frag_rb_t *entries[TEST_DATAGRAMS];
+    gnrc_netreg_entry_t reg = GNRC_NETREG_ENTRY_INIT_PID(
+            GNRC_NETREG_DEMUX_CTX_ALL,
+            sched_active_pid
+        );
+
+    gnrc_netreg_register(TEST_DATAGRAM_NETTYPE, &reg);
+    /* last fragments of all datagrams first ... */
+    for (unsigned dg = 0; dg < TEST_DATAGRAMS; dg++) {
+        TEST_ASSERT_NOT_NULL((entries[dg] = _add_fragment(
+                dg, TEST_FRAGMENT3_OFFSET
+            )));
+        TEST_ASSERT_EQUAL_INT(0, gnrc_sixlowpan_frag_rb_dispatch_when_complete(
+                entries[dg], &_test_netif_hdr.hdr
+            ));
+    }
+    TEST_ASSERT_EQUAL_INT(TEST_DATAGRAMS, _rbuf_entries());
+    /* ... then the first fragments in reverse order, with duplicates of the
+     * last fragments in between ... */
+    for (unsigned i = 0; i < TEST_DATAGRAMS; i++) {
+        unsigned dg = TEST_DATAGRAMS - i - 1;
+
+        TEST_ASSERT(entries[dg] == _add_fragment(dg, TEST_FRAGMENT1_OFFSET));
+        TEST_ASSERT(entries[dg] == _add_fragment(dg, TEST_FRAGMENT3_OFFSET));
+        TEST_ASSERT_EQUAL_INT(0, gnrc_sixlowpan_frag_rb_dispatch_when_complete(
+                entries[dg], &_test_netif_hdr.hdr
+            ));
+    }
+    TEST_ASSERT_EQUAL_INT(TEST_DATAGRAMS, _rbuf_entries());
+    /* ... and finally the middle fragments, every second datagram first */
+    for (unsigned i = 0; i < TEST_DATAGRAMS; i++) {
+        unsigned dg = ((2 * i) % TEST_DATAGRAMS) + ((2 * i) / TEST_DATAGRAMS);
+
+        TEST_ASSERT(entries[dg] == _add_fragment(dg, TEST_FRAGMENT2_OFFSET));
+        TEST_ASSERT(0 < gnrc_sixlowpan_frag_rb_dispatch_when_complete(
+                entries[dg], &_test_netif_hdr.hdr
+            ));
+        _check_datagram(dg);
+    }
+    gnrc_netreg_unregister(TEST_DATAGRAM_NETTYPE, &reg);
+    TEST_ASSERT_EQUAL_INT(0, _rbuf_entries());
+    TEST_ASSERT_MESSAGE(gnrc_pktbuf_is_empty(), "Packet buffer is not empty");
+}
+
+static void test_rbuf_stress__rm_by_datagram(void)
+{
+    for (unsigned dg = 0; dg < TEST_DATAGRAMS; dg++) {
+        TEST_ASSERT_NOT_NULL(_add_fragment(dg, TEST_FRAGMENT1_OFFSET));
+    }
+    /* remove every second datagram, the rest must still be found */
+    for (unsigned dg = 0; dg < TEST_DATAGRAMS; dg += 2) {
+        _set_netif_hdr(dg);
+        gnrc_sixlowpan_frag_rb_rm_by_datagram(&_test_netif_hdr.hdr, _tag(dg));
+    }
+    for (unsigned dg = 0; dg < TEST_DATAGRAMS; dg++) {
+        _set_netif_hdr(dg);
+        TEST_ASSERT((dg % 2) == gnrc_sixlowpan_frag_rb_exists(
+                &_test_netif_hdr.hdr, _tag(dg)
+            ));
+    }
+    TEST_ASSERT_EQUAL_INT(TEST_DATAGRAMS / 2, _rbuf_entries());
+    for (unsigned dg = 1; dg < TEST_DATAGRAMS; dg += 2) {
+        _set_netif_hdr(dg);
+        gnrc_sixlowpan_frag_rb_rm_by_datagram(&_test_netif_hdr.hdr, _tag(dg));
+    }
+    TEST_ASSERT_EQUAL_INT(0, _rbuf_entries());
+    TEST_ASSERT_MESSAGE(gnrc_pktbuf_is_empty(), "Packet buffer is not empty");
+}
+
+static void run_unittests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_rbuf_stress__interleaved),
+        new_TestFixture(test_rbuf_stress__rm_by_datagram),
+    };
+
+    EMB_UNIT_TESTCALLER(sixlo_frag_rb_stress_tests, _set_up, NULL, fixtures);
+    TESTS_START();
+    TESTS_RUN((Test *)&sixlo_frag_rb_stress_tests);
+    TESTS_END();
+}
+
+int main(void)
+{
+    /* netreg requires queue, but queue size one should be enough for us */
+    msg_init_queue(&_msg_queue, 1U);
+    run_unittests();
+    return 0;
+}
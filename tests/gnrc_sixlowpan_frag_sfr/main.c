@@ -0,0 +1,779 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Tests sending, reassembly, and forwarding of 6LoWPAN
+ *              recoverable fragments in gnrc.
+ *
+ * @}
+ */
+
+#include <string.h>
+
+#include "bitfield.h"
+#include "embUnit.h"
+#include "net/gnrc/netif.h"
+#include "net/gnrc/netif/hdr.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/netreg.h"
+#include "net/gnrc/sixlowpan/frag/fb.h"
+#include "net/gnrc/sixlowpan/frag/rb.h"
+#include "net/gnrc/sixlowpan/frag/sfr.h"
+#include "net/gnrc/sixlowpan/frag/vrb.h"
+#include "net/netif.h"
+#include "net/sixlowpan.h"
+#include "utlist.h"
+#include "xtimer.h"
+
+#define TEST_NETIF_HDR_SRC      { 0xb3, 0x47, 0x60, 0x49, \
+                                  0x78, 0xfe, 0x95, 0x48 }
+#define TEST_NETIF_HDR_DST      { 0xa4, 0xf2, 0xd2, 0xc9, \
+                                  0x13, 0xb9, 0xbb, 0x25 }
+#define TEST_NEXT_HOP           { 0x36, 0xa1, 0x5e, 0x0c, \
+                                  0x8d, 0x47, 0x20, 0x1b }
+#define TEST_L2ADDR_LEN         (8U)
+#define TEST_NETIF_IFACE        (9)
+#define TEST_TAG                (0x9e)
+#define TEST_PAGE               (0)
+#define TEST_RECEIVE_TIMEOUT    (100U)
+#define TEST_MSG_QUEUE_SIZE     (8U)
+/* number of bytes recompression of the headers saves on the next hop */
+#define TEST_RECOMP_DIFF        (2)
+
+/* uncompressed ICMPv6 echo reply with 300 byte payload */
+#define TEST_DATAGRAM_SIZE      (348U)
+#ifdef MODULE_GNRC_IPV6
+#define TEST_DATAGRAM_NETTYPE   (GNRC_NETTYPE_IPV6)
+#else  /* MODULE_GNRC_IPV6 */
+#define TEST_DATAGRAM_NETTYPE   (GNRC_NETTYPE_UNDEF)
+#endif /* MODULE_GNRC_IPV6 */
+#define TEST_DATAGRAM_HDR { \
+        0x60, 0x00, 0x00, 0x00, 0x01, 0x34, 0x3a, 0x40, \
+        0xfe, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, \
+        0x7b, 0x65, 0x08, 0x22, 0x86, 0x93, 0x9d, 0x5a, \
+        0xfe, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, \
+        0x7b, 0x79, 0x7f, 0x7f, 0xa4, 0xb1, 0x55, 0x2e, \
+        0x81, 0x00, 0x7a, 0x81, 0x00, 0x54, 0x00, 0x02, \
+    }
+#define TEST_DATAGRAM_PAYLOAD   (0x54)
+/* the compressed datagram additionally carries the uncompressed IPv6
+ * dispatch */
+#define TEST_COMP_DATAGRAM_SIZE (TEST_DATAGRAM_SIZE + 1U)
+#define TEST_FRAG_SIZE          (96U)
+#define TEST_FRAGS              ((TEST_COMP_DATAGRAM_SIZE + TEST_FRAG_SIZE - 1) / \
+                                 TEST_FRAG_SIZE)
+
+static const uint8_t _test_netif_hdr_src[] = TEST_NETIF_HDR_SRC;
+static const uint8_t _test_netif_hdr_dst[] = TEST_NETIF_HDR_DST;
+static const uint8_t _test_next_hop[] = TEST_NEXT_HOP;
+static struct {
+    gnrc_netif_hdr_t hdr;
+    uint8_t src[GNRC_NETIF_HDR_L2ADDR_MAX_LEN];
+    uint8_t dst[GNRC_NETIF_HDR_L2ADDR_MAX_LEN];
+} _test_netif_hdr;
+
+static const uint8_t _datagram_hdr[] = TEST_DATAGRAM_HDR;
+static uint8_t _comp_datagram[TEST_COMP_DATAGRAM_SIZE];
+static msg_t _msg_queue[TEST_MSG_QUEUE_SIZE];
+/* interface without a thread: packets sent via it end up in the message
+ * queue of the test thread */
+static gnrc_netif_t _test_netif;
+static gnrc_sixlowpan_frag_fb_t *_fbuf;
+
+static void _set_up(void)
+{
+    gnrc_sixlowpan_frag_rb_reset();
+    gnrc_pktbuf_init();
+    gnrc_netif_hdr_init(&_test_netif_hdr.hdr,
+                        GNRC_NETIF_HDR_L2ADDR_MAX_LEN,
+                        GNRC_NETIF_HDR_L2ADDR_MAX_LEN);
+    _test_netif_hdr.hdr.if_pid = TEST_NETIF_IFACE;
+    gnrc_netif_hdr_set_src_addr(&_test_netif_hdr.hdr,
+                                (uint8_t *)_test_netif_hdr_src,
+                                sizeof(_test_netif_hdr_src));
+    gnrc_netif_hdr_set_dst_addr(&_test_netif_hdr.hdr,
+                                (uint8_t *)_test_netif_hdr_dst,
+                                sizeof(_test_netif_hdr_dst));
+    memset(_comp_datagram, TEST_DATAGRAM_PAYLOAD, sizeof(_comp_datagram));
+    _comp_datagram[0] = SIXLOWPAN_UNCOMP;
+    memcpy(&_comp_datagram[1], _datagram_hdr, sizeof(_datagram_hdr));
+}
+
+static gnrc_pktsnip_t *_sent(void)
+{
+    msg_t msg;
+
+    if ((msg_try_receive(&msg) < 0) ||
+        (msg.type != GNRC_NETAPI_MSG_TYPE_SND)) {
+        return NULL;
+    }
+    return msg.content.ptr;
+}
+
+static void _tear_down(void)
+{
+    if ((_fbuf != NULL) && (_fbuf->pkt != NULL)) {
+        xtimer_remove(&_fbuf->sfr.timer);
+        gnrc_pktbuf_release(_fbuf->pkt);
+    }
+    _fbuf = NULL;
+    gnrc_sixlowpan_frag_fb_reset();
+    gnrc_sixlowpan_frag_vrb_reset();
+    /* drop what a failed test did not check */
+    for (gnrc_pktsnip_t *pkt = _sent(); pkt != NULL; pkt = _sent()) {
+        gnrc_pktbuf_release(pkt);
+    }
+}
+
+static gnrc_pktsnip_t *_fragment(unsigned seq)
+{
+    const unsigned offset = seq * TEST_FRAG_SIZE;
+    const unsigned frag_size = (offset + TEST_FRAG_SIZE > TEST_COMP_DATAGRAM_SIZE)
+                             ? (TEST_COMP_DATAGRAM_SIZE - offset)
+                             : TEST_FRAG_SIZE;
+    gnrc_pktsnip_t *pkt = gnrc_pktbuf_add(NULL, NULL,
+                                          sizeof(sixlowpan_sfr_rfrag_t) +
+                                          frag_size, GNRC_NETTYPE_SIXLOWPAN);
+    sixlowpan_sfr_rfrag_t *hdr;
+
+    if (pkt == NULL) {
+        return NULL;
+    }
+    hdr = pkt->data;
+    memset(hdr, 0, sizeof(*hdr));
+    sixlowpan_sfr_rfrag_set_disp(&hdr->base);
+    hdr->base.tag = TEST_TAG;
+    sixlowpan_sfr_rfrag_set_seq(hdr, seq);
+    sixlowpan_sfr_rfrag_set_frag_size(hdr, frag_size);
+    /* the first fragment carries the size of the compressed datagram */
+    sixlowpan_sfr_rfrag_set_offset(hdr, (seq == 0) ? TEST_COMP_DATAGRAM_SIZE
+                                                   : offset);
+    memcpy(hdr + 1, &_comp_datagram[offset], frag_size);
+    return pkt;
+}
+
+static gnrc_pktsnip_t *_abort_fragment(void)
+{
+    gnrc_pktsnip_t *pkt = gnrc_pktbuf_add(NULL, NULL,
+                                          sizeof(sixlowpan_sfr_rfrag_t),
+                                          GNRC_NETTYPE_SIXLOWPAN);
+    sixlowpan_sfr_rfrag_t *hdr;
+
+    if (pkt == NULL) {
+        return NULL;
+    }
+    hdr = pkt->data;
+    memset(hdr, 0, sizeof(*hdr));
+    sixlowpan_sfr_rfrag_set_disp(&hdr->base);
+    hdr->base.tag = TEST_TAG;
+    return pkt;
+}
+
+static gnrc_pktsnip_t *_ack(uint8_t tag, const uint8_t *bitmap)
+{
+    gnrc_pktsnip_t *pkt = gnrc_pktbuf_add(NULL, NULL,
+                                          sizeof(sixlowpan_sfr_ack_t),
+                                          GNRC_NETTYPE_SIXLOWPAN);
+    sixlowpan_sfr_ack_t *ack;
+
+    if (pkt == NULL) {
+        return NULL;
+    }
+    ack = pkt->data;
+    ack->base.disp_ecn = 0;
+    sixlowpan_sfr_ack_set_disp(&ack->base);
+    ack->base.tag = tag;
+    memcpy(ack->bitmap, bitmap, sizeof(ack->bitmap));
+    return pkt;
+}
+
+/* passes `pkt` to selective fragment recovery as if it was received from
+ * `src` via _test_netif */
+static void _recv(gnrc_pktsnip_t *pkt, const uint8_t *src)
+{
+    gnrc_pktsnip_t *netif;
+
+    if (pkt == NULL) {
+        return;
+    }
+    netif = gnrc_netif_hdr_build(src, TEST_L2ADDR_LEN,
+                                 _test_netif_hdr_dst, TEST_L2ADDR_LEN);
+    if (netif == NULL) {
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+    gnrc_netif_hdr_set_netif(netif->data, &_test_netif);
+    LL_APPEND(pkt, netif);
+    gnrc_sixlowpan_frag_sfr_recv(pkt, NULL, TEST_PAGE);
+}
+
+/* sends the compressed datagram to TEST_NETIF_HDR_SRC via _test_netif */
+static gnrc_sixlowpan_frag_fb_t *_send_datagram(void)
+{
+    gnrc_pktsnip_t *netif, *pkt;
+
+    if ((_fbuf = gnrc_sixlowpan_frag_fb_get()) == NULL) {
+        return NULL;
+    }
+    netif = gnrc_netif_hdr_build(_test_netif_hdr_dst, TEST_L2ADDR_LEN,
+                                 _test_netif_hdr_src, TEST_L2ADDR_LEN);
+    if (netif == NULL) {
+        return NULL;
+    }
+    gnrc_netif_hdr_set_netif(netif->data, &_test_netif);
+    pkt = gnrc_pktbuf_add(NULL, _comp_datagram, sizeof(_comp_datagram),
+                          GNRC_NETTYPE_SIXLOWPAN);
+    if (pkt == NULL) {
+        gnrc_pktbuf_release(netif);
+        return NULL;
+    }
+    LL_PREPEND(pkt, netif);
+    _fbuf->pkt = pkt;
+    _fbuf->datagram_size = TEST_DATAGRAM_SIZE;
+    _fbuf->tag = TEST_TAG;
+    gnrc_sixlowpan_frag_sfr_send(pkt, _fbuf, TEST_PAGE);
+    return _fbuf;
+}
+
+/* emulates the inter-frame gap events until the current round is sent,
+ * returns the number of fragments sent */
+static unsigned _finish_round(gnrc_sixlowpan_frag_fb_t *fbuf)
+{
+    unsigned sent = 0;
+
+    while (1) {
+        for (gnrc_pktsnip_t *pkt = _sent(); pkt != NULL; pkt = _sent()) {
+            gnrc_pktbuf_release(pkt);
+            sent++;
+        }
+        if (fbuf->sfr.timer_msg.type !=
+            GNRC_SIXLOWPAN_FRAG_SFR_INTER_FRAG_GAP_MSG) {
+            return sent;
+        }
+        gnrc_sixlowpan_frag_sfr_send(NULL, fbuf, TEST_PAGE);
+    }
+}
+
+static gnrc_sixlowpan_frag_vrb_t *_add_vrbe(void)
+{
+    const gnrc_sixlowpan_frag_rb_base_t base = {
+        .src = TEST_NETIF_HDR_SRC,
+        .src_len = TEST_L2ADDR_LEN,
+        .tag = TEST_TAG,
+        .datagram_size = TEST_DATAGRAM_SIZE,
+        .arrival = xtimer_now_usec(),
+    };
+
+    return gnrc_sixlowpan_frag_vrb_add(&base, &_test_netif, _test_next_hop,
+                                       sizeof(_test_next_hop));
+}
+
+static void _check_netif_hdr(const gnrc_pktsnip_t *pkt, const uint8_t *dst)
+{
+    const gnrc_netif_hdr_t *netif_hdr = pkt->data;
+
+    TEST_ASSERT_EQUAL_INT(GNRC_NETTYPE_NETIF, pkt->type);
+    TEST_ASSERT_EQUAL_INT(_test_netif.pid, netif_hdr->if_pid);
+    TEST_ASSERT_EQUAL_INT(TEST_L2ADDR_LEN, netif_hdr->dst_l2addr_len);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(gnrc_netif_hdr_get_dst_addr(netif_hdr),
+                                    dst, TEST_L2ADDR_LEN));
+}
+
+static void _check_rfrag(const gnrc_pktsnip_t *pkt, const uint8_t *dst,
+                         uint8_t tag, unsigned seq, unsigned offset,
+                         unsigned frag_size, bool ack_req)
+{
+    sixlowpan_sfr_rfrag_t *hdr;
+
+    _check_netif_hdr(pkt, dst);
+    TEST_ASSERT_NOT_NULL(pkt->next);
+    TEST_ASSERT(pkt->next->size >= sizeof(sixlowpan_sfr_rfrag_t));
+    hdr = pkt->next->data;
+    TEST_ASSERT(sixlowpan_sfr_rfrag_is(&hdr->base));
+    TEST_ASSERT_EQUAL_INT(tag, hdr->base.tag);
+    TEST_ASSERT_EQUAL_INT(seq, sixlowpan_sfr_rfrag_get_seq(hdr));
+    TEST_ASSERT_EQUAL_INT(offset, sixlowpan_sfr_rfrag_get_offset(hdr));
+    TEST_ASSERT_EQUAL_INT(frag_size, sixlowpan_sfr_rfrag_get_frag_size(hdr));
+    TEST_ASSERT_EQUAL_INT(ack_req, sixlowpan_sfr_rfrag_ack_req(hdr));
+    TEST_ASSERT_EQUAL_INT(sizeof(sixlowpan_sfr_rfrag_t) + frag_size,
+                          gnrc_pkt_len(pkt->next));
+}
+
+static const uint8_t *_rfrag_payload(const gnrc_pktsnip_t *pkt)
+{
+    return (const uint8_t *)pkt->next->data + sizeof(sixlowpan_sfr_rfrag_t);
+}
+
+static void _check_ack(const gnrc_pktsnip_t *pkt, const uint8_t *dst,
+                       uint8_t tag, const uint8_t *bitmap)
+{
+    const sixlowpan_sfr_ack_t *ack;
+
+    _check_netif_hdr(pkt, dst);
+    TEST_ASSERT_NOT_NULL(pkt->next);
+    TEST_ASSERT_EQUAL_INT(sizeof(sixlowpan_sfr_ack_t), pkt->next->size);
+    ack = pkt->next->data;
+    TEST_ASSERT(sixlowpan_sfr_ack_is(&ack->base));
+    TEST_ASSERT_EQUAL_INT(tag, ack->base.tag);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(ack->bitmap, bitmap,
+                                    sizeof(ack->bitmap)));
+}
+
+static gnrc_sixlowpan_frag_rb_t *_add_fragment(unsigned seq)
+{
+    gnrc_pktsnip_t *pkt = _fragment(seq);
+
+    if (pkt == NULL) {
+        return NULL;
+    }
+    return gnrc_sixlowpan_frag_rb_add(
+            &_test_netif_hdr.hdr, pkt,
+            (seq == 0) ? 0 : sixlowpan_sfr_rfrag_get_offset(pkt->data),
+            TEST_PAGE
+        );
+}
+
+static const gnrc_sixlowpan_frag_rb_t *_first_non_empty_rbuf(void)
+{
+    const gnrc_sixlowpan_frag_rb_t *rbuf = gnrc_sixlowpan_frag_rb_array();
+
+    for (unsigned i = 0; i < CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE; i++) {
+        if (!gnrc_sixlowpan_frag_rb_entry_empty(&rbuf[i])) {
+            return &rbuf[i];
+        }
+    }
+    return NULL;
+}
+
+static void _check_pktbuf(const gnrc_sixlowpan_frag_rb_t *entry)
+{
+    if (entry != NULL) {
+        gnrc_pktbuf_release(entry->pkt);
+    }
+    TEST_ASSERT_MESSAGE(gnrc_pktbuf_is_empty(), "Packet buffer is not empty");
+}
+
+static void _check_datagram(const gnrc_pktsnip_t *datagram)
+{
+    TEST_ASSERT_NOT_NULL(datagram);
+    TEST_ASSERT_EQUAL_INT(TEST_DATAGRAM_SIZE, datagram->size);
+    TEST_ASSERT_MESSAGE(memcmp(&_comp_datagram[1], datagram->data,
+                               datagram->size) == 0,
+                        "Reassembled datagram unexpected");
+}
+
+static void test_rbuf_add__first_fragment(void)
+{
+    const gnrc_sixlowpan_frag_rb_t *entry;
+
+    TEST_ASSERT_NOT_NULL((entry = _add_fragment(0)));
+    TEST_ASSERT_EQUAL_INT(TEST_TAG, entry->super.tag);
+    /* dispatch is not part of the reassembled datagram */
+    TEST_ASSERT_EQUAL_INT(TEST_DATAGRAM_SIZE, entry->super.datagram_size);
+    TEST_ASSERT_EQUAL_INT(TEST_FRAG_SIZE - 1, entry->super.current_size);
+    TEST_ASSERT_EQUAL_INT(-1, entry->super.offset_diff);
+    TEST_ASSERT(bf_isset((uint8_t *)entry->received, 0));
+    for (unsigned i = 1; i < TEST_FRAGS; i++) {
+        TEST_ASSERT(!bf_isset((uint8_t *)entry->received, i));
+    }
+    _check_pktbuf(entry);
+}
+
+static void test_rbuf_add__nth_before_first(void)
+{
+    /* offset in the uncompressed datagram is unknown without the first
+     * fragment, so the fragment is dropped to be recovered later */
+    TEST_ASSERT_NULL(_add_fragment(1));
+    TEST_ASSERT_NULL(_first_non_empty_rbuf());
+    _check_pktbuf(NULL);
+}
+
+static void test_rbuf_add__duplicate(void)
+{
+    const gnrc_sixlowpan_frag_rb_t *entry1, *entry2;
+
+    TEST_ASSERT_NOT_NULL((entry1 = _add_fragment(0)));
+    TEST_ASSERT_NOT_NULL((entry2 = _add_fragment(2)));
+    TEST_ASSERT(entry1 == entry2);
+    TEST_ASSERT_NOT_NULL((entry2 = _add_fragment(2)));
+    TEST_ASSERT(entry1 == entry2);
+    TEST_ASSERT_EQUAL_INT((2 * TEST_FRAG_SIZE) - 1,
+                          entry1->super.current_size);
+    TEST_ASSERT(bf_isset((uint8_t *)entry1->received, 0));
+    TEST_ASSERT(!bf_isset((uint8_t *)entry1->received, 1));
+    TEST_ASSERT(bf_isset((uint8_t *)entry1->received, 2));
+    _check_pktbuf(entry1);
+}
+
+static void test_rbuf_add__complete_out_of_order(void)
+{
+    static const unsigned order[] = { 0, 3, 1, 2 };
+    gnrc_sixlowpan_frag_rb_t *entry = NULL;
+    msg_t msg = { .type = 0U };
+    gnrc_netreg_entry_t reg = GNRC_NETREG_ENTRY_INIT_PID(
+            GNRC_NETREG_DEMUX_CTX_ALL,
+            sched_active_pid
+        );
+
+    TEST_ASSERT_EQUAL_INT(ARRAY_SIZE(order), TEST_FRAGS);
+    gnrc_netreg_register(TEST_DATAGRAM_NETTYPE, &reg);
+    for (unsigned i = 0; i < ARRAY_SIZE(order); i++) {
+        TEST_ASSERT_NOT_NULL((entry = _add_fragment(order[i])));
+        TEST_ASSERT_EQUAL_INT(i == (ARRAY_SIZE(order) - 1),
+                              gnrc_sixlowpan_frag_rb_dispatch_when_complete(
+                                  entry, &_test_netif_hdr.hdr
+                              ) > 0);
+    }
+    TEST_ASSERT_MESSAGE(
+            xtimer_msg_receive_timeout(&msg, TEST_RECEIVE_TIMEOUT) >= 0,
+            "Receiving reassembled datagram timed out"
+        );
+    gnrc_netreg_unregister(TEST_DATAGRAM_NETTYPE, &reg);
+    TEST_ASSERT_EQUAL_INT(GNRC_NETAPI_MSG_TYPE_RCV, msg.type);
+    _check_datagram(msg.content.ptr);
+    gnrc_pktbuf_release(msg.content.ptr);
+    TEST_ASSERT_NULL(_first_non_empty_rbuf());
+    _check_pktbuf(NULL);
+}
+
+static void test_rbuf_add__too_big_fragment(void)
+{
+    gnrc_pktsnip_t *pkt;
+
+    TEST_ASSERT_NOT_NULL(_add_fragment(0));
+    TEST_ASSERT_NOT_NULL((pkt = _fragment(1)));
+    /* fragment size does not match the packet */
+    sixlowpan_sfr_rfrag_set_frag_size(pkt->data, TEST_FRAG_SIZE + 1);
+    TEST_ASSERT_NULL(gnrc_sixlowpan_frag_rb_add(
+            &_test_netif_hdr.hdr, pkt, TEST_FRAG_SIZE, TEST_PAGE
+        ));
+    /* fragment exceeds datagram */
+    TEST_ASSERT_NOT_NULL((pkt = _fragment(3)));
+    sixlowpan_sfr_rfrag_set_offset(pkt->data, TEST_COMP_DATAGRAM_SIZE);
+    TEST_ASSERT_NULL(gnrc_sixlowpan_frag_rb_add(
+            &_test_netif_hdr.hdr, pkt, TEST_COMP_DATAGRAM_SIZE, TEST_PAGE
+        ));
+    /* the whole datagram was discarded */
+    TEST_ASSERT_NULL(_first_non_empty_rbuf());
+    _check_pktbuf(NULL);
+}
+
+static void test_rbuf_rm_by_dg__abort(void)
+{
+    TEST_ASSERT_NOT_NULL(_add_fragment(0));
+    TEST_ASSERT_NOT_NULL(gnrc_sixlowpan_frag_rb_get_by_datagram(
+            &_test_netif_hdr.hdr, TEST_TAG
+        ));
+    gnrc_sixlowpan_frag_rb_rm_by_datagram(&_test_netif_hdr.hdr, TEST_TAG);
+    TEST_ASSERT_NULL(gnrc_sixlowpan_frag_rb_get_by_datagram(
+            &_test_netif_hdr.hdr, TEST_TAG
+        ));
+    TEST_ASSERT_NULL(_first_non_empty_rbuf());
+    _check_pktbuf(NULL);
+}
+
+static void test_sfr_send__window(void)
+{
+    gnrc_sixlowpan_frag_fb_t *fbuf;
+    gnrc_pktsnip_t *pkt;
+
+    TEST_ASSERT_NOT_NULL((fbuf = _send_datagram()));
+    TEST_ASSERT_EQUAL_INT(TEST_FRAGS, fbuf->sfr.frags);
+    TEST_ASSERT_EQUAL_INT(TEST_FRAG_SIZE, fbuf->sfr.frag_size);
+    TEST_ASSERT_EQUAL_INT(GNRC_SIXLOWPAN_SFR_OPT_WIN_SIZE, fbuf->sfr.window);
+    /* first fragment carries the size of the compressed datagram and
+     * announces further fragments to the link layer */
+    TEST_ASSERT_NOT_NULL((pkt = _sent()));
+    _check_rfrag(pkt, _test_netif_hdr_src, TEST_TAG, 0,
+                 TEST_COMP_DATAGRAM_SIZE, TEST_FRAG_SIZE, false);
+    TEST_ASSERT(((gnrc_netif_hdr_t *)pkt->data)->flags &
+                GNRC_NETIF_HDR_FLAGS_MORE_DATA);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(_rfrag_payload(pkt), _comp_datagram,
+                                    TEST_FRAG_SIZE));
+    gnrc_pktbuf_release(pkt);
+    /* the next fragment waits for the inter-frame gap */
+    TEST_ASSERT_NULL(_sent());
+    TEST_ASSERT_EQUAL_INT(GNRC_SIXLOWPAN_FRAG_SFR_INTER_FRAG_GAP_MSG,
+                          fbuf->sfr.timer_msg.type);
+    gnrc_sixlowpan_frag_sfr_send(NULL, fbuf, TEST_PAGE);
+    /* last fragment of the window requests an acknowledgment */
+    TEST_ASSERT_NOT_NULL((pkt = _sent()));
+    _check_rfrag(pkt, _test_netif_hdr_src, TEST_TAG, 1, TEST_FRAG_SIZE,
+                 TEST_FRAG_SIZE, true);
+    TEST_ASSERT(!(((gnrc_netif_hdr_t *)pkt->data)->flags &
+                  GNRC_NETIF_HDR_FLAGS_MORE_DATA));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(_rfrag_payload(pkt),
+                                    &_comp_datagram[TEST_FRAG_SIZE],
+                                    TEST_FRAG_SIZE));
+    gnrc_pktbuf_release(pkt);
+    TEST_ASSERT_EQUAL_INT(GNRC_SIXLOWPAN_FRAG_SFR_ARQ_TIMEOUT_MSG,
+                          fbuf->sfr.timer_msg.type);
+    /* a late inter-frame gap event does not exceed the window */
+    gnrc_sixlowpan_frag_sfr_send(NULL, fbuf, TEST_PAGE);
+    TEST_ASSERT_NULL(_sent());
+}
+
+static void test_sfr_send__selective_retransmission(void)
+{
+    BITFIELD(bitmap, SIXLOWPAN_SFR_ACK_BITMAP_SIZE) = { 0 };
+    gnrc_sixlowpan_frag_fb_t *fbuf;
+    gnrc_pktsnip_t *pkt;
+
+    TEST_ASSERT_NOT_NULL((fbuf = _send_datagram()));
+    TEST_ASSERT_EQUAL_INT(GNRC_SIXLOWPAN_SFR_OPT_WIN_SIZE,
+                          _finish_round(fbuf));
+    /* second fragment of the round got lost */
+    bf_set(bitmap, 0);
+    _recv(_ack(TEST_TAG, bitmap), _test_netif_hdr_src);
+    TEST_ASSERT(bf_isset(fbuf->sfr.acked, 0));
+    TEST_ASSERT(!bf_isset(fbuf->sfr.acked, 1));
+    /* loss decreases the window multiplicatively */
+    TEST_ASSERT_EQUAL_INT(GNRC_SIXLOWPAN_SFR_OPT_WIN_SIZE / 2,
+                          fbuf->sfr.window);
+    /* ARQ timeout follows the round-trip time of the acknowledgment */
+    TEST_ASSERT_EQUAL_INT(GNRC_SIXLOWPAN_SFR_MIN_ARQ_TIMEOUT_MS,
+                          fbuf->sfr.arq_timeout);
+    /* only the lost fragment is sent again */
+    TEST_ASSERT_NOT_NULL((pkt = _sent()));
+    _check_rfrag(pkt, _test_netif_hdr_src, TEST_TAG, 1, TEST_FRAG_SIZE,
+                 TEST_FRAG_SIZE, true);
+    gnrc_pktbuf_release(pkt);
+    TEST_ASSERT_NULL(_sent());
+    bf_set(bitmap, 1);
+    _recv(_ack(TEST_TAG, bitmap), _test_netif_hdr_src);
+    /* loss-free round increases the window additively */
+    TEST_ASSERT_EQUAL_INT((GNRC_SIXLOWPAN_SFR_OPT_WIN_SIZE / 2) + 1,
+                          fbuf->sfr.window);
+    TEST_ASSERT_NOT_NULL((pkt = _sent()));
+    _check_rfrag(pkt, _test_netif_hdr_src, TEST_TAG, 2, 2 * TEST_FRAG_SIZE,
+                 TEST_FRAG_SIZE, false);
+    gnrc_pktbuf_release(pkt);
+    gnrc_sixlowpan_frag_sfr_send(NULL, fbuf, TEST_PAGE);
+    TEST_ASSERT_NOT_NULL((pkt = _sent()));
+    _check_rfrag(pkt, _test_netif_hdr_src, TEST_TAG, 3, 3 * TEST_FRAG_SIZE,
+                 TEST_COMP_DATAGRAM_SIZE - (3 * TEST_FRAG_SIZE), true);
+    gnrc_pktbuf_release(pkt);
+    bf_set(bitmap, 2);
+    bf_set(bitmap, 3);
+    _recv(_ack(TEST_TAG, bitmap), _test_netif_hdr_src);
+    /* datagram is completely acknowledged */
+    TEST_ASSERT_NULL(fbuf->pkt);
+    TEST_ASSERT_EQUAL_INT(0, fbuf->sfr.timer_msg.type);
+    TEST_ASSERT_NULL(_sent());
+    _check_pktbuf(NULL);
+}
+
+static void test_sfr_send__ack_abort(void)
+{
+    BITFIELD(bitmap, SIXLOWPAN_SFR_ACK_BITMAP_SIZE) = { 0 };
+    gnrc_sixlowpan_frag_fb_t *fbuf;
+
+    TEST_ASSERT_NOT_NULL((fbuf = _send_datagram()));
+    TEST_ASSERT_EQUAL_INT(GNRC_SIXLOWPAN_SFR_OPT_WIN_SIZE,
+                          _finish_round(fbuf));
+    /* NULL bitmap aborts the datagram */
+    _recv(_ack(TEST_TAG, bitmap), _test_netif_hdr_src);
+    TEST_ASSERT_NULL(fbuf->pkt);
+    TEST_ASSERT_NULL(_sent());
+    _check_pktbuf(NULL);
+}
+
+static void test_sfr_send__ack_from_other_node(void)
+{
+    BITFIELD(bitmap, SIXLOWPAN_SFR_ACK_BITMAP_SIZE) = { 0 };
+    gnrc_sixlowpan_frag_fb_t *fbuf;
+
+    TEST_ASSERT_NOT_NULL((fbuf = _send_datagram()));
+    TEST_ASSERT_EQUAL_INT(GNRC_SIXLOWPAN_SFR_OPT_WIN_SIZE,
+                          _finish_round(fbuf));
+    bf_set(bitmap, 0);
+    /* only the next hop may acknowledge fragments */
+    _recv(_ack(TEST_TAG, bitmap), _test_next_hop);
+    TEST_ASSERT_NOT_NULL(fbuf->pkt);
+    TEST_ASSERT(!bf_isset(fbuf->sfr.acked, 0));
+    TEST_ASSERT_EQUAL_INT(GNRC_SIXLOWPAN_SFR_OPT_WIN_SIZE, fbuf->sfr.window);
+    TEST_ASSERT_NULL(_sent());
+}
+
+static void test_sfr_arq_timeout__retransmit(void)
+{
+    gnrc_sixlowpan_frag_fb_t *fbuf;
+    gnrc_pktsnip_t *pkt;
+
+    TEST_ASSERT_NOT_NULL((fbuf = _send_datagram()));
+    gnrc_pktbuf_release(_sent());
+    /* still in the inter-frame gap, so not waiting for an acknowledgment */
+    gnrc_sixlowpan_frag_sfr_arq_timeout(fbuf);
+    TEST_ASSERT_NULL(_sent());
+    TEST_ASSERT_EQUAL_INT(GNRC_SIXLOWPAN_SFR_OPT_WIN_SIZE, fbuf->sfr.window);
+    TEST_ASSERT_EQUAL_INT(1, _finish_round(fbuf));
+    fbuf->sfr.arq_timeout = GNRC_SIXLOWPAN_SFR_MIN_ARQ_TIMEOUT_MS;
+    gnrc_sixlowpan_frag_sfr_arq_timeout(fbuf);
+    /* window shrinks and the timeout backs off */
+    TEST_ASSERT_EQUAL_INT(GNRC_SIXLOWPAN_SFR_OPT_WIN_SIZE / 2,
+                          fbuf->sfr.window);
+    TEST_ASSERT_EQUAL_INT(2 * GNRC_SIXLOWPAN_SFR_MIN_ARQ_TIMEOUT_MS,
+                          fbuf->sfr.arq_timeout);
+    TEST_ASSERT_EQUAL_INT(1, fbuf->sfr.retrans);
+    /* lowest unacknowledged fragment is sent again */
+    TEST_ASSERT_NOT_NULL((pkt = _sent()));
+    _check_rfrag(pkt, _test_netif_hdr_src, TEST_TAG, 0,
+                 TEST_COMP_DATAGRAM_SIZE, TEST_FRAG_SIZE, true);
+    gnrc_pktbuf_release(pkt);
+    TEST_ASSERT_NULL(_sent());
+}
+
+static void test_sfr_arq_timeout__abort(void)
+{
+    gnrc_sixlowpan_frag_fb_t *fbuf;
+    gnrc_pktsnip_t *pkt;
+
+    TEST_ASSERT_NOT_NULL((fbuf = _send_datagram()));
+    TEST_ASSERT_EQUAL_INT(GNRC_SIXLOWPAN_SFR_OPT_WIN_SIZE,
+                          _finish_round(fbuf));
+    for (unsigned i = 0; i < GNRC_SIXLOWPAN_SFR_FRAG_RETRIES; i++) {
+        gnrc_sixlowpan_frag_sfr_arq_timeout(fbuf);
+        TEST_ASSERT_EQUAL_INT(1, _finish_round(fbuf));
+    }
+    gnrc_sixlowpan_frag_sfr_arq_timeout(fbuf);
+    /* sequence number, offset, and fragment size 0 abort the datagram */
+    TEST_ASSERT_NOT_NULL((pkt = _sent()));
+    _check_rfrag(pkt, _test_netif_hdr_src, TEST_TAG, 0, 0, 0, false);
+    gnrc_pktbuf_release(pkt);
+    TEST_ASSERT_NULL(_sent());
+    TEST_ASSERT_NULL(fbuf->pkt);
+    _check_pktbuf(NULL);
+}
+
+static void test_sfr_forward__offset(void)
+{
+    gnrc_sixlowpan_frag_vrb_t *vrbe;
+    gnrc_pktsnip_t *frag, *payload, *pkt;
+    sixlowpan_sfr_rfrag_t rfrag;
+
+    TEST_ASSERT_NOT_NULL((vrbe = _add_vrbe()));
+    TEST_ASSERT_NOT_NULL((frag = _fragment(0)));
+    rfrag = *((sixlowpan_sfr_rfrag_t *)frag->data);
+    /* recompression for the next hop shrinks the first fragment */
+    payload = gnrc_pktbuf_add(NULL, &_comp_datagram[TEST_RECOMP_DIFF],
+                              TEST_FRAG_SIZE - TEST_RECOMP_DIFF,
+                              GNRC_NETTYPE_UNDEF);
+    gnrc_pktbuf_release(frag);
+    TEST_ASSERT_NOT_NULL(payload);
+    TEST_ASSERT_EQUAL_INT(0, gnrc_sixlowpan_frag_sfr_forward(payload, &rfrag,
+                                                             vrbe, TEST_PAGE));
+    TEST_ASSERT_EQUAL_INT(-TEST_RECOMP_DIFF, vrbe->super.offset_diff);
+    TEST_ASSERT_NOT_NULL((pkt = _sent()));
+    _check_rfrag(pkt, _test_next_hop, (uint8_t)vrbe->out_tag, 0,
+                 TEST_COMP_DATAGRAM_SIZE - TEST_RECOMP_DIFF,
+                 TEST_FRAG_SIZE - TEST_RECOMP_DIFF, false);
+    gnrc_pktbuf_release(pkt);
+    /* subsequent fragments are forwarded with the VRB entry when received
+     * and their offsets are moved by the same difference */
+    TEST_ASSERT_NOT_NULL((frag = _fragment(1)));
+    sixlowpan_sfr_rfrag_set_ack_req(frag->data);
+    _recv(frag, _test_netif_hdr_src);
+    TEST_ASSERT_NOT_NULL((pkt = _sent()));
+    _check_rfrag(pkt, _test_next_hop, (uint8_t)vrbe->out_tag, 1,
+                 TEST_FRAG_SIZE - TEST_RECOMP_DIFF, TEST_FRAG_SIZE, true);
+    gnrc_pktbuf_release(pkt);
+    TEST_ASSERT_NULL(_sent());
+    TEST_ASSERT_NOT_NULL(gnrc_sixlowpan_frag_vrb_get(_test_netif_hdr_src,
+                                                     TEST_L2ADDR_LEN,
+                                                     TEST_TAG));
+    _check_pktbuf(NULL);
+}
+
+static void test_sfr_forward__abort(void)
+{
+    gnrc_sixlowpan_frag_vrb_t *vrbe;
+    gnrc_pktsnip_t *pkt;
+    uint8_t out_tag;
+
+    TEST_ASSERT_NOT_NULL((vrbe = _add_vrbe()));
+    out_tag = vrbe->out_tag;
+    _recv(_abort_fragment(), _test_netif_hdr_src);
+    TEST_ASSERT_NOT_NULL((pkt = _sent()));
+    _check_rfrag(pkt, _test_next_hop, out_tag, 0, 0, 0, false);
+    gnrc_pktbuf_release(pkt);
+    /* datagram is gone for this node */
+    TEST_ASSERT_NULL(gnrc_sixlowpan_frag_vrb_get(_test_netif_hdr_src,
+                                                 TEST_L2ADDR_LEN, TEST_TAG));
+    _check_pktbuf(NULL);
+}
+
+static void test_sfr_recv_ack__relay(void)
+{
+    BITFIELD(bitmap, SIXLOWPAN_SFR_ACK_BITMAP_SIZE) = { 0 };
+    gnrc_sixlowpan_frag_vrb_t *vrbe;
+    gnrc_pktsnip_t *pkt;
+    uint8_t out_tag;
+
+    TEST_ASSERT_NOT_NULL((vrbe = _add_vrbe()));
+    out_tag = vrbe->out_tag;
+    bf_set(bitmap, 0);
+    _recv(_ack(out_tag, bitmap), _test_next_hop);
+    /* acknowledgment is relayed to the previous hop with its tag */
+    TEST_ASSERT_NOT_NULL((pkt = _sent()));
+    _check_ack(pkt, _test_netif_hdr_src, TEST_TAG, bitmap);
+    gnrc_pktbuf_release(pkt);
+    TEST_ASSERT_NOT_NULL(gnrc_sixlowpan_frag_vrb_get(_test_netif_hdr_src,
+                                                     TEST_L2ADDR_LEN,
+                                                     TEST_TAG));
+    memset(bitmap, 0xff, sizeof(bitmap));
+    _recv(_ack(out_tag, bitmap), _test_next_hop);
+    TEST_ASSERT_NOT_NULL((pkt = _sent()));
+    _check_ack(pkt, _test_netif_hdr_src, TEST_TAG, bitmap);
+    gnrc_pktbuf_release(pkt);
+    /* full bitmap completes the datagram */
+    TEST_ASSERT_NULL(gnrc_sixlowpan_frag_vrb_get(_test_netif_hdr_src,
+                                                 TEST_L2ADDR_LEN, TEST_TAG));
+    _check_pktbuf(NULL);
+}
+
+static void run_unittests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_rbuf_add__first_fragment),
+        new_TestFixture(test_rbuf_add__nth_before_first),
+        new_TestFixture(test_rbuf_add__duplicate),
+        new_TestFixture(test_rbuf_add__complete_out_of_order),
+        new_TestFixture(test_rbuf_add__too_big_fragment),
+        new_TestFixture(test_rbuf_rm_by_dg__abort),
+        new_TestFixture(test_sfr_send__window),
+        new_TestFixture(test_sfr_send__selective_retransmission),
+        new_TestFixture(test_sfr_send__ack_abort),
+        new_TestFixture(test_sfr_send__ack_from_other_node),
+        new_TestFixture(test_sfr_arq_timeout__retransmit),
+        new_TestFixture(test_sfr_arq_timeout__abort),
+        new_TestFixture(test_sfr_forward__offset),
+        new_TestFixture(test_sfr_forward__abort),
+        new_TestFixture(test_sfr_recv_ack__relay),
+    };
+
+    EMB_UNIT_TESTCALLER(sixlo_frag_sfr_tests, _set_up, _tear_down, fixtures);
+    TESTS_START();
+    TESTS_RUN((Test *)&sixlo_frag_sfr_tests);
+    TESTS_END();
+}
+
+int main(void)
+{
+    /* netreg requires queue, sent packets are queued there as well */
+    msg_init_queue(_msg_queue, TEST_MSG_QUEUE_SIZE);
+    _test_netif.pid = sched_active_pid;
+    _test_netif.sixlo.max_frag_size = sizeof(sixlowpan_sfr_rfrag_t) +
+                                      TEST_FRAG_SIZE;
+    netif_register((netif_t *)&_test_netif);
+    run_unittests();
+    return 0;
+}
@@ -0,0 +1,147 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Echo server handling several TCP connections from a single
+ *              event thread
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "event.h"
+#include "msg.h"
+#include "net/ipv6/addr.h"
+#include "net/sock/async/event.h"
+#include "net/sock/tcp.h"
+#include "shell.h"
+#include "thread.h"
+
+#ifndef QUEUE_LEN
+#define QUEUE_LEN           (4U)
+#endif
+
+#define MAIN_QUEUE_SIZE     (8U)
+#define BUFFER_SIZE         (128U)
+
+static msg_t _main_queue[MAIN_QUEUE_SIZE];
+static char _server_stack[THREAD_STACKSIZE_MAIN];
+static event_queue_t _ev_queue;
+static sock_tcp_queue_t _queue;
+static sock_tcp_t _socks[QUEUE_LEN];
+static uint8_t _buffer[BUFFER_SIZE];
+static uint16_t _port;
+
+static void _print_remote(const char *what, sock_tcp_t *sock)
+{
+    char addr_str[IPV6_ADDR_MAX_STR_LEN];
+    sock_tcp_ep_t remote;
+
+    if (sock_tcp_get_remote(sock, &remote) == 0) {
+        ipv6_addr_to_str(addr_str, (ipv6_addr_t *)remote.addr.ipv6,
+                         sizeof(addr_str));
+        printf("%s [%s]:%u\n", what, addr_str, remote.port);
+    }
+}
+
+static void _conn_handler(sock_tcp_t *sock, sock_async_flags_t flags,
+                          void *arg)
+{
+    ssize_t res;
+
+    (void)arg;
+    if (flags & (SOCK_ASYNC_MSG_RECV | SOCK_ASYNC_CONN_FIN)) {
+        while ((res = sock_tcp_read(sock, _buffer, sizeof(_buffer), 0)) > 0) {
+            if (sock_tcp_write(sock, _buffer, res) < 0) {
+                break;
+            }
+        }
+        /* the peer closed the connection or it was reset */
+        if (res != -EAGAIN) {
+            _print_remote("closed", sock);
+            sock_tcp_disconnect(sock);
+        }
+    }
+}
+
+static void _queue_handler(sock_tcp_queue_t *queue, sock_async_flags_t flags,
+                           void *arg)
+{
+    sock_tcp_t *sock;
+
+    (void)arg;
+    if (flags & SOCK_ASYNC_CONN_RECV) {
+        while (sock_tcp_accept(queue, &sock, 0) == 0) {
+            _print_remote("accepted", sock);
+            sock_tcp_event_init(sock, &_ev_queue, _conn_handler, NULL);
+            /* data might have arrived before the sock was accepted */
+            _conn_handler(sock, SOCK_ASYNC_MSG_RECV, NULL);
+        }
+    }
+}
+
+static void *_server_thread(void *arg)
+{
+    (void)arg;
+    event_queue_claim(&_ev_queue);
+    /* connections might have been established before the handler was set */
+    _queue_handler(&_queue, SOCK_ASYNC_CONN_RECV, NULL);
+    event_loop(&_ev_queue);
+    return NULL;
+}
+
+static int _listen_cmd(int argc, char **argv)
+{
+    sock_tcp_ep_t local = SOCK_IPV6_EP_ANY;
+    int res;
+
+    if (argc < 2) {
+        printf("usage: %s <port>\n", argv[0]);
+        return 1;
+    }
+    if (_port != 0) {
+        puts("listen: already listening");
+        return 1;
+    }
+    local.port = atoi(argv[1]);
+    res = sock_tcp_listen(&_queue, &local, _socks, QUEUE_LEN, 0);
+    if (res < 0) {
+        printf("listen: failed (%d)\n", res);
+        return 1;
+    }
+    _port = local.port;
+    sock_tcp_queue_event_init(&_queue, &_ev_queue, _queue_handler, NULL);
+    thread_create(_server_stack, sizeof(_server_stack),
+                  THREAD_PRIORITY_MAIN - 1, THREAD_CREATE_STACKTEST,
+                  _server_thread, NULL, "echo server");
+    printf("listen: %u connections on port %u\n", QUEUE_LEN, _port);
+    return 0;
+}
+
+static const shell_command_t _shell_commands[] = {
+    { "listen", "start the echo server", _listen_cmd },
+    { NULL, NULL, NULL }
+};
+
+int main(void)
+{
+    msg_init_queue(_main_queue, MAIN_QUEUE_SIZE);
+    event_queue_init_detached(&_ev_queue);
+    puts("GNRC sock_tcp echo server");
+
+    char line_buf[SHELL_DEFAULT_BUFSIZE];
+    shell_run(_shell_commands, line_buf, SHELL_DEFAULT_BUFSIZE);
+    return 0;
+}
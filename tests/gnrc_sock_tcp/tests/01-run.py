@@ -0,0 +1,96 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2020 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import os
+import random
+import re
+import socket
+import sys
+import time
+
+from testrunner import run
+
+QUEUE_LEN = int(os.environ.get('QUEUE_LEN', 4))
+
+
+def get_host_tap_device():
+    # Check if given tap device is part of a network bridge
+    # if so use bridged interface instead of given tap device
+    tap = os.environ["TAPDEV"]
+    result = os.popen('bridge link show dev {}'.format(tap))
+    bridge = re.search('master (.*) state', result.read())
+
+    return bridge.group(1).strip() if bridge else tap
+
+
+def get_riot_ll_addr(child):
+    child.sendline('ifconfig')
+    child.expect(r'(fe80:[0-9a-f:]+)\s')
+    return child.match.group(1).strip()
+
+
+def verify_pktbuf_empty(child):
+    child.sendline('pktbuf')
+    child.expect(r'first byte: (0x[0-9a-fA-F]+).*\(size: (\d+)\)')
+
+    pktbuf_addr = child.match.group(1)
+    pktbuf_size = child.match.group(2)
+
+    child.expect(r'~ unused: {} \(next: (\(nil\)|0), size: {}\) ~'.format(pktbuf_addr, pktbuf_size))
+
+
+def echo_round(child, addr, port):
+    addr_info = socket.getaddrinfo(addr + '%' + get_host_tap_device(), port,
+                                   type=socket.SOCK_STREAM)
+    socks = []
+
+    # Open all connections at once, the server handles them concurrently
+    for _ in range(QUEUE_LEN):
+        sock = socket.socket(socket.AF_INET6, socket.SOCK_STREAM)
+        sock.settimeout(5)
+        sock.connect(addr_info[0][-1])
+        socks.append(sock)
+    for _ in range(QUEUE_LEN):
+        child.expect(r'accepted \[fe80:[0-9a-f:]+\]:\d+')
+
+    for i, sock in enumerate(socks):
+        sock.sendall('hello from connection {}'.format(i).encode('utf-8'))
+    for i, sock in enumerate(socks):
+        data = 'hello from connection {}'.format(i).encode('utf-8')
+        assert sock.recv(len(data), socket.MSG_WAITALL) == data
+
+    for sock in socks:
+        sock.close()
+    for _ in range(QUEUE_LEN):
+        child.expect(r'closed \[fe80:[0-9a-f:]+\]:\d+')
+
+
+def testfunc(child):
+    port = random.randint(1024, 65535)
+    addr = get_riot_ll_addr(child)
+
+    child.sendline('listen {}'.format(port))
+    child.expect_exact('listen: {} connections on port {}'.format(QUEUE_LEN, port))
+
+    # The second round verifies that the socks listen again once closed
+    echo_round(child, addr, port)
+    time.sleep(1)
+    echo_round(child, addr, port)
+
+    # Wait for the last ACKs and verify that pktbuf is cleared
+    time.sleep(1)
+    verify_pktbuf_empty(child)
+
+    print(os.path.basename(sys.argv[0]) + ': success')
+
+
+if __name__ == '__main__':
+    if os.environ.get("BOARD", "") != "native" and os.geteuid() != 0:
+        print("\x1b[1;31mThis test requires root privileges.\x1b[0m\n", file=sys.stderr)
+        sys.exit(1)
+    sys.exit(run(testfunc, timeout=10, echo=False, traceback=True))
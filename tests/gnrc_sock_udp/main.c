@@ -447,6 +447,63 @@ static void test_sock_udp_recv_buf__success(void)
     assert(_check_net());
 }
 
+static void test_sock_udp_buf_resize__shrink(void)
+{
+    static const ipv6_addr_t src_addr = { .u8 = _TEST_ADDR_REMOTE };
+    static const ipv6_addr_t dst_addr = { .u8 = _TEST_ADDR_LOCAL };
+    static const sock_udp_ep_t local = { .family = AF_INET6,
+                                         .port = _TEST_PORT_LOCAL };
+    void *data = NULL, *ctx = NULL, *old_data;
+
+    assert(0 == sock_udp_create(&_sock, &local, NULL, SOCK_FLAGS_REUSE_EP));
+    assert(_inject_packet(&src_addr, &dst_addr, _TEST_PORT_REMOTE,
+                          _TEST_PORT_LOCAL, "ABCD", sizeof("ABCD"),
+                          _TEST_NETIF));
+    assert(sizeof("ABCD") == sock_udp_recv_buf(&_sock, &data, &ctx,
+                                               SOCK_NO_TIMEOUT, NULL));
+    old_data = data;
+    /* resizing to the current size keeps the buffer as it is */
+    assert(0 == sock_udp_buf_resize(&data, &ctx, sizeof("ABCD")));
+    assert(data == old_data);
+    assert(memcmp(data, "ABCD", sizeof("ABCD")) == 0);
+    /* shrinking never moves the buffer */
+    assert(0 == sock_udp_buf_resize(&data, &ctx, 2));
+    assert(data == old_data);
+    assert(memcmp(data, "AB", 2) == 0);
+    assert(0 == sock_udp_recv_buf(&_sock, &data, &ctx, SOCK_NO_TIMEOUT, NULL));
+    assert(ctx == NULL);
+    assert(_check_net());
+}
+
+static void test_sock_udp_buf_resize__grow(void)
+{
+    static const ipv6_addr_t src_addr = { .u8 = _TEST_ADDR_REMOTE };
+    static const ipv6_addr_t dst_addr = { .u8 = _TEST_ADDR_LOCAL };
+    static const sock_udp_ep_t local = { .family = AF_INET6,
+                                         .port = _TEST_PORT_LOCAL };
+    void *data = NULL, *ctx = NULL;
+
+    assert(0 == sock_udp_create(&_sock, &local, NULL, SOCK_FLAGS_REUSE_EP));
+    assert(_inject_packet(&src_addr, &dst_addr, _TEST_PORT_REMOTE,
+                          _TEST_PORT_LOCAL, "ABCD", sizeof("ABCD"),
+                          _TEST_NETIF));
+    assert(sizeof("ABCD") == sock_udp_recv_buf(&_sock, &data, &ctx,
+                                               SOCK_NO_TIMEOUT, NULL));
+    /* the content is kept when growing the buffer */
+    assert(0 == sock_udp_buf_resize(&data, &ctx, _TEST_BUFFER_SIZE));
+    assert(data != NULL);
+    assert(ctx != NULL);
+    assert(memcmp(data, "ABCD", sizeof("ABCD")) == 0);
+    memset(data, 0, _TEST_BUFFER_SIZE);
+    /* too large for the packet buffer */
+    assert(-ENOMEM == sock_udp_buf_resize(&data, &ctx,
+                                          CONFIG_GNRC_PKTBUF_SIZE + 1));
+    /* the buffer context is still valid */
+    assert(0 == sock_udp_recv_buf(&_sock, &data, &ctx, SOCK_NO_TIMEOUT, NULL));
+    assert(ctx == NULL);
+    assert(_check_net());
+}
+
 static void test_sock_udp_send__EAFNOSUPPORT(void)
 {
     static const sock_udp_ep_t remote = { .addr = { .ipv6 = _TEST_ADDR_REMOTE },
@@ -719,6 +776,112 @@ static void test_sock_udp_send__no_sock(void)
     expect(_check_net());
 }
 
+static void test_sock_udp_sendv__multi_segment(void)
+{
+    static const ipv6_addr_t src_addr = { .u8 = _TEST_ADDR_LOCAL };
+    static const ipv6_addr_t dst_addr = { .u8 = _TEST_ADDR_REMOTE };
+    static const sock_udp_ep_t local = { .addr = { .ipv6 = _TEST_ADDR_LOCAL },
+                                         .family = AF_INET6,
+                                         .netif = _TEST_NETIF,
+                                         .port = _TEST_PORT_LOCAL };
+    static const sock_udp_ep_t remote = { .addr = { .ipv6 = _TEST_ADDR_REMOTE },
+                                          .family = AF_INET6,
+                                          .port = _TEST_PORT_REMOTE };
+    iolist_t tail = { NULL, "CD", sizeof("CD") };
+    iolist_t head = { &tail, "AB", sizeof("AB") - 1 };
+
+    expect(0 == sock_udp_create(&_sock, &local, &remote, SOCK_FLAGS_REUSE_EP));
+    expect(sizeof("ABCD") == sock_udp_sendv(&_sock, &head, NULL));
+    expect(_check_packet(&src_addr, &dst_addr, _TEST_PORT_LOCAL,
+                         _TEST_PORT_REMOTE, "ABCD", sizeof("ABCD"),
+                         _TEST_NETIF, false));
+    xtimer_usleep(1000);    /* let GNRC stack finish */
+    expect(_check_net());
+}
+
+static void test_sock_udp_sendv__empty_segments(void)
+{
+    static const ipv6_addr_t src_addr = { .u8 = _TEST_ADDR_LOCAL };
+    static const ipv6_addr_t dst_addr = { .u8 = _TEST_ADDR_REMOTE };
+    static const sock_udp_ep_t local = { .addr = { .ipv6 = _TEST_ADDR_LOCAL },
+                                         .family = AF_INET6,
+                                         .netif = _TEST_NETIF,
+                                         .port = _TEST_PORT_LOCAL };
+    static const sock_udp_ep_t remote = { .addr = { .ipv6 = _TEST_ADDR_REMOTE },
+                                          .family = AF_INET6,
+                                          .port = _TEST_PORT_REMOTE };
+    iolist_t last = { NULL, NULL, 0 };
+    iolist_t data = { &last, "ABCD", sizeof("ABCD") };
+    iolist_t first = { &data, _test_buffer, 0 };
+
+    expect(0 == sock_udp_create(&_sock, &local, &remote, SOCK_FLAGS_REUSE_EP));
+    expect(sizeof("ABCD") == sock_udp_sendv(&_sock, &first, NULL));
+    expect(_check_packet(&src_addr, &dst_addr, _TEST_PORT_LOCAL,
+                         _TEST_PORT_REMOTE, "ABCD", sizeof("ABCD"),
+                         _TEST_NETIF, false));
+    xtimer_usleep(1000);    /* let GNRC stack finish */
+    /* no segments at all send an empty message */
+    expect(0 == sock_udp_sendv(&_sock, NULL, NULL));
+    expect(_check_packet(&src_addr, &dst_addr, _TEST_PORT_LOCAL,
+                         _TEST_PORT_REMOTE, "", 0, _TEST_NETIF, false));
+    xtimer_usleep(1000);    /* let GNRC stack finish */
+    expect(_check_net());
+}
+
+static void test_sock_udp_send_buf__reply(void)
+{
+    static const ipv6_addr_t local_addr = { .u8 = _TEST_ADDR_LOCAL };
+    static const ipv6_addr_t remote_addr = { .u8 = _TEST_ADDR_REMOTE };
+    static const sock_udp_ep_t local = { .addr = { .ipv6 = _TEST_ADDR_LOCAL },
+                                         .family = AF_INET6,
+                                         .netif = _TEST_NETIF,
+                                         .port = _TEST_PORT_LOCAL };
+    sock_udp_ep_t remote;
+    void *data = NULL, *ctx = NULL;
+
+    expect(0 == sock_udp_create(&_sock, &local, NULL, SOCK_FLAGS_REUSE_EP));
+    expect(_inject_packet(&remote_addr, &local_addr, _TEST_PORT_REMOTE,
+                          _TEST_PORT_LOCAL, "ABCD", sizeof("ABCD"),
+                          _TEST_NETIF));
+    /* the send checks got the request as well */
+    expect(_release_injected());
+    expect(sizeof("ABCD") == sock_udp_recv_buf(&_sock, &data, &ctx,
+                                               SOCK_NO_TIMEOUT, &remote));
+    /* the reply is written over the request */
+    expect(0 == sock_udp_buf_resize(&data, &ctx, sizeof("EFGHIJ")));
+    memcpy(data, "EFGHIJ", sizeof("EFGHIJ"));
+    expect(sizeof("EFGHIJ") == sock_udp_send_buf(&_sock, ctx,
+                                                 sizeof("EFGHIJ"), &remote));
+    expect(_check_packet(&local_addr, &remote_addr, _TEST_PORT_LOCAL,
+                         _TEST_PORT_REMOTE, "EFGHIJ", sizeof("EFGHIJ"),
+                         _TEST_NETIF, false));
+    xtimer_usleep(1000);    /* let GNRC stack finish */
+    expect(_check_net());
+}
+
+static void test_sock_udp_send_buf__EINVAL_port(void)
+{
+    static const ipv6_addr_t local_addr = { .u8 = _TEST_ADDR_LOCAL };
+    static const ipv6_addr_t remote_addr = { .u8 = _TEST_ADDR_REMOTE };
+    static const sock_udp_ep_t local = { .family = AF_INET6,
+                                         .port = _TEST_PORT_LOCAL };
+    static const sock_udp_ep_t remote = { .addr = { .ipv6 = _TEST_ADDR_REMOTE },
+                                          .family = AF_INET6,
+                                          .netif = _TEST_NETIF };
+    void *data = NULL, *ctx = NULL;
+
+    expect(0 == sock_udp_create(&_sock, &local, NULL, SOCK_FLAGS_REUSE_EP));
+    expect(_inject_packet(&remote_addr, &local_addr, _TEST_PORT_REMOTE,
+                          _TEST_PORT_LOCAL, "ABCD", sizeof("ABCD"),
+                          _TEST_NETIF));
+    expect(_release_injected());
+    expect(sizeof("ABCD") == sock_udp_recv_buf(&_sock, &data, &ctx,
+                                               SOCK_NO_TIMEOUT, NULL));
+    /* the buffer is released on error as well */
+    expect(-EINVAL == sock_udp_send_buf(&_sock, ctx, sizeof("ABCD"), &remote));
+    expect(_check_net());
+}
+
 int main(void)
 {
     _net_init();
@@ -751,6 +914,8 @@ int main(void)
     CALL(test_sock_udp_recv__with_timeout());
     CALL(test_sock_udp_recv__non_blocking());
     CALL(test_sock_udp_recv_buf__success());
+    CALL(test_sock_udp_buf_resize__shrink());
+    CALL(test_sock_udp_buf_resize__grow());
     _prepare_send_checks();
     CALL(test_sock_udp_send__EAFNOSUPPORT());
     CALL(test_sock_udp_send__EINVAL_addr());
@@ -768,6 +933,10 @@ int main(void)
     CALL(test_sock_udp_send__unsocketed());
     CALL(test_sock_udp_send__no_sock_no_netif());
     CALL(test_sock_udp_send__no_sock());
+    CALL(test_sock_udp_sendv__multi_segment());
+    CALL(test_sock_udp_sendv__empty_segments());
+    CALL(test_sock_udp_send_buf__reply());
+    CALL(test_sock_udp_send_buf__EINVAL_port());
 
     puts("ALL TESTS SUCCESSFUL");
 
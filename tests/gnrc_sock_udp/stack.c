@@ -110,6 +110,18 @@ bool _inject_packet(const ipv6_addr_t *src, const ipv6_addr_t *dst,
                                          GNRC_NETREG_DEMUX_CTX_ALL, pkt) > 0);
 }
 
+bool _release_injected(void)
+{
+    msg_t msg;
+
+    msg_receive(&msg);
+    if (msg.type != GNRC_NETAPI_MSG_TYPE_RCV) {
+        return false;
+    }
+    gnrc_pktbuf_release(msg.content.ptr);
+    return true;
+}
+
 bool _check_net(void)
 {
     return (gnrc_pktbuf_is_sane() && gnrc_pktbuf_is_empty());
@@ -57,6 +57,17 @@ bool _inject_packet(const ipv6_addr_t *src, const ipv6_addr_t *dst,
                     uint16_t src_port, uint16_t dst_port,
                     void *data, size_t data_len, uint16_t netif);
 
+/**
+ * @brief   Releases the copy of a packet injected with _inject_packet() that
+ *          was delivered to the send checks
+ *
+ * @pre _prepare_send_checks() was called
+ *
+ * @return  true, if the packet was released
+ * @return  false, if no injected packet was received
+ */
+bool _release_injected(void);
+
 /**
  * @brief   Checks networking state (e.g. packet buffer state)
  *
@@ -33,6 +33,8 @@ def testfunc(child):
     child.expect_exact(u"Calling test_sock_udp_recv__unsocketed_with_remote()")
     child.expect_exact(u"Calling test_sock_udp_recv__with_timeout()")
     child.expect_exact(u"Calling test_sock_udp_recv__non_blocking()")
+    child.expect_exact(u"Calling test_sock_udp_buf_resize__shrink()")
+    child.expect_exact(u"Calling test_sock_udp_buf_resize__grow()")
     child.expect_exact(u"Calling test_sock_udp_send__EAFNOSUPPORT()")
     child.expect_exact(u"Calling test_sock_udp_send__EINVAL_addr()")
     child.expect_exact(u"Calling test_sock_udp_send__EINVAL_netif()")
@@ -49,6 +51,10 @@ def testfunc(child):
     child.expect_exact(u"Calling test_sock_udp_send__unsocketed()")
     child.expect_exact(u"Calling test_sock_udp_send__no_sock_no_netif()")
     child.expect_exact(u"Calling test_sock_udp_send__no_sock()")
+    child.expect_exact(u"Calling test_sock_udp_sendv__multi_segment()")
+    child.expect_exact(u"Calling test_sock_udp_sendv__empty_segments()")
+    child.expect_exact(u"Calling test_sock_udp_send_buf__reply()")
+    child.expect_exact(u"Calling test_sock_udp_send_buf__EINVAL_port()")
     child.expect_exact(u"ALL TESTS SUCCESSFUL")
 
 
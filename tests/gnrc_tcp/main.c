@@ -7,6 +7,7 @@
  */
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
 #include "shell.h"
@@ -200,6 +201,29 @@ int gnrc_tcp_open_passive_cmd(int argc, char **argv)
     return err;
 }
 
+int gnrc_tcp_set_rcvbuf_cmd(int argc, char **argv)
+{
+    dump_args(argc, argv);
+
+    uint32_t min = strtoul(argv[1], NULL, 10);
+    uint32_t max = strtoul(argv[2], NULL, 10);
+
+    int err = gnrc_tcp_set_rcvbuf(&tcb, min, max);
+    switch (err) {
+        case -EINVAL:
+            printf("%s: returns -EINVAL\n", argv[0]);
+            break;
+
+        case -EISCONN:
+            printf("%s: returns -EISCONN\n", argv[0]);
+            break;
+
+        default:
+            printf("%s: returns %d\n", argv[0], err);
+    }
+    return err;
+}
+
 int gnrc_tcp_send_cmd(int argc, char **argv)
 {
     dump_args(argc, argv);
@@ -300,6 +324,8 @@ static const shell_command_t shell_commands[] = {
       gnrc_tcp_open_active_cmd },
     { "gnrc_tcp_open_passive", "gnrc_tcp: open passive connection",
       gnrc_tcp_open_passive_cmd },
+    { "gnrc_tcp_set_rcvbuf", "gnrc_tcp: set receive buffer size",
+      gnrc_tcp_set_rcvbuf_cmd },
     { "gnrc_tcp_send", "gnrc_tcp: send data to connected peer",
       gnrc_tcp_send_cmd },
     { "gnrc_tcp_recv", "gnrc_tcp: recv data from connected peer",
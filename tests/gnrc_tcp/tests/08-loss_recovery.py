@@ -0,0 +1,214 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2020 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import os
+import random
+import string
+import sys
+
+from testrunner import run
+
+from shared_func import sudo_guard, get_host_tap_device, get_riot_l2_addr, \
+                        get_riot_ll_addr, generate_port_number, \
+                        setup_internal_buffer, write_data_to_internal_buffer, \
+                        read_data_from_internal_buffer, verify_pktbuf_empty
+from scapy_peer import ScapyPeer
+
+# The peer announces this MSS, so two segments carry the test data
+MSS = 100
+DATA_LEN = 2 * MSS
+
+# Well below the lower bound of the retransmission timeout (one second)
+NO_RTO = 0.3
+
+
+def testfunc(func):
+    def runner(child):
+        tap = get_host_tap_device()
+        dst_l2 = get_riot_l2_addr(child)
+        dst_ll = get_riot_ll_addr(child)
+        port = generate_port_number()
+
+        # Setup RIOT Node wait for incoming connections from the scapy peer
+        child.sendline('gnrc_tcp_tcb_init')
+        child.expect_exact('gnrc_tcp_tcb_init: argc=1, argv[0] = gnrc_tcp_tcb_init')
+        child.sendline('gnrc_tcp_open_passive [::]:{}'.format(port))
+        child.expect(r'gnrc_tcp_open_passive: argc=2, '
+                     r'argv\[0\] = gnrc_tcp_open_passive, '
+                     r'argv\[1\] = \[::\]:(\d+)\r\n')
+        assert int(child.match.group(1)) == port
+
+        with ScapyPeer(tap, dst_l2, dst_ll, port) as peer:
+            print("- {} ".format(func.__name__), end="")
+            if child.logfile == sys.stdout:
+                func(child, peer)
+                print("")
+            else:
+                try:
+                    func(child, peer)
+                    print("SUCCESS")
+                except Exception as e:
+                    print("FAILED")
+                    raise e
+
+        child.sendline('gnrc_tcp_abort')
+        child.expect_exact('gnrc_tcp_abort: argc=1, argv[0] = gnrc_tcp_abort')
+        verify_pktbuf_empty(child)
+
+    return runner
+
+
+def generate_data():
+    return ''.join(random.choice(string.ascii_letters) for _ in range(DATA_LEN))
+
+
+def open_connection(child, peer, sack):
+    peer.connect(mss=MSS, sack=sack)
+    child.expect_exact('gnrc_tcp_open_passive: returns 0')
+
+
+def send_data(child, peer, data):
+    setup_internal_buffer(child)
+    write_data_to_internal_buffer(child, data)
+    child.sendline('gnrc_tcp_send 0')
+    child.expect_exact('gnrc_tcp_send: sent {}'.format(len(data)))
+
+    # The data is split into segments of MSS bytes
+    segs = [peer.expect(), peer.expect()]
+    for i, seg in enumerate(segs):
+        assert seg is not None
+        assert bytes(seg.payload) == data[i * MSS:(i + 1) * MSS].encode()
+    return segs
+
+
+def expect_resend(peer, seg, timeout=NO_RTO):
+    rtx = peer.expect(timeout)
+    assert rtx is not None
+    assert rtx.seq == seg.seq
+    assert bytes(rtx.payload) == bytes(seg.payload)
+
+
+def end_of(seg):
+    return seg.seq + len(seg.payload)
+
+
+@testfunc
+def test_fast_retransmit_sack(child, peer):
+    open_connection(child, peer, sack=True)
+    seg1, seg2 = send_data(child, peer, generate_data())
+
+    # The first segment got lost, the peer selectively acknowledges the second.
+    # Up to two duplicate ACKs might be caused by reordering.
+    for _ in range(2):
+        peer.send_ack(seg1.seq, [(seg2.seq, end_of(seg2))])
+    peer.expect_none(NO_RTO)
+
+    # The third duplicate ACK triggers the fast retransmit long before the
+    # retransmission timeout. The SACKed segment is not sent again.
+    peer.send_ack(seg1.seq, [(seg2.seq, end_of(seg2))])
+    expect_resend(peer, seg1)
+    peer.expect_none(NO_RTO)
+
+    # After the cumulative ACK, nothing is left to retransmit
+    peer.send_ack(end_of(seg2))
+    peer.expect_none(2 * NO_RTO + 1)
+
+
+@testfunc
+def test_newreno_partial_ack(child, peer):
+    open_connection(child, peer, sack=False)
+    seg1, seg2 = send_data(child, peer, generate_data())
+
+    # Both segments got lost: Fast retransmit of the first one
+    for _ in range(3):
+        peer.send_ack(seg1.seq)
+    expect_resend(peer, seg1)
+    peer.expect_none(NO_RTO)
+
+    # A partial ACK shows that the second segment was lost as well. NewReno
+    # retransmits it right away instead of waiting for the timeout.
+    peer.send_ack(seg2.seq)
+    expect_resend(peer, seg2)
+
+    peer.send_ack(end_of(seg2))
+    peer.expect_none(2 * NO_RTO + 1)
+
+
+@testfunc
+def test_retransmission_timeout(child, peer):
+    open_connection(child, peer, sack=True)
+    seg1, seg2 = send_data(child, peer, generate_data())
+
+    # Nothing was acknowledged: The first segment is retransmitted after the
+    # timeout. The congestion window shrinks to one segment, so the second
+    # segment waits for the ACK of the first one.
+    expect_resend(peer, seg1, timeout=2)
+    peer.expect_none(NO_RTO)
+
+    peer.send_ack(seg2.seq)
+    expect_resend(peer, seg2)
+
+    peer.send_ack(end_of(seg2))
+    peer.expect_none(2 * NO_RTO + 1)
+
+
+@testfunc
+def test_reordered_acks(child, peer):
+    open_connection(child, peer, sack=True)
+    seg1, seg2 = send_data(child, peer, generate_data())
+
+    # The second segment overtook the first one: One duplicate ACK is followed
+    # by the cumulative ACK. Nothing must be retransmitted.
+    peer.send_ack(seg1.seq, [(seg2.seq, end_of(seg2))])
+    peer.send_ack(end_of(seg2))
+    peer.expect_none(2 * NO_RTO + 1)
+
+
+@testfunc
+def test_receive_reordered_segments(child, peer):
+    open_connection(child, peer, sack=True)
+    data = generate_data()
+    first = data[:MSS].encode()
+    second = data[MSS:].encode()
+
+    # An out-of-order segment is answered with a duplicate ACK
+    peer.send(flags='PA', payload=second, seq=peer.seq + MSS)
+    ack = peer.expect()
+    assert ack is not None
+    assert ack.ack == peer.seq
+
+    # The missing segment fills the gap, the out-of-order segment has to be
+    # retransmitted as it is not kept
+    peer.send(flags='PA', payload=first)
+    ack = peer.expect()
+    assert ack is not None
+    assert ack.ack == peer.seq + MSS
+
+    peer.send(flags='PA', payload=second, seq=peer.seq + MSS)
+    ack = peer.expect()
+    assert ack is not None
+    assert ack.ack == peer.seq + DATA_LEN
+    peer.seq += DATA_LEN
+
+    setup_internal_buffer(child)
+    child.sendline('gnrc_tcp_recv 1000000 {}'.format(DATA_LEN))
+    child.expect_exact('gnrc_tcp_recv: received {}'.format(DATA_LEN))
+    assert read_data_from_internal_buffer(child, DATA_LEN) == data
+
+
+if __name__ == "__main__":
+    sudo_guard(uses_scapy=True)
+    script = sys.modules[__name__]
+    tests = [getattr(script, t) for t in script.__dict__
+             if type(getattr(script, t)).__name__ == "function"
+             and t.startswith("test_")]
+    for test in tests:
+        res = run(test, timeout=10, echo=False)
+        if res != 0:
+            sys.exit(res)
+    print(os.path.basename(sys.argv[0]) + ": success\n")
@@ -0,0 +1,184 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2020 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import os
+import random
+import string
+import sys
+
+from testrunner import run
+
+from shared_func import sudo_guard, get_host_tap_device, get_riot_l2_addr, \
+                        get_riot_ll_addr, generate_port_number, \
+                        setup_internal_buffer, write_data_to_internal_buffer, \
+                        read_data_from_internal_buffer, verify_pktbuf_empty
+from scapy_peer import ScapyPeer
+
+# CONFIG_GNRC_TCP_MSS of the RIOT node, the smallest valid receive buffer
+RIOT_MSS = 1220
+
+
+def testfunc(func):
+    def runner(child):
+        tap = get_host_tap_device()
+        dst_l2 = get_riot_l2_addr(child)
+        dst_ll = get_riot_ll_addr(child)
+        port = generate_port_number()
+
+        child.sendline('gnrc_tcp_tcb_init')
+        child.expect_exact('gnrc_tcp_tcb_init: argc=1, argv[0] = gnrc_tcp_tcb_init')
+
+        with ScapyPeer(tap, dst_l2, dst_ll, port) as peer:
+            print("- {} ".format(func.__name__), end="")
+            if child.logfile == sys.stdout:
+                func(child, peer)
+                print("")
+            else:
+                try:
+                    func(child, peer)
+                    print("SUCCESS")
+                except Exception as e:
+                    print("FAILED")
+                    raise e
+
+        child.sendline('gnrc_tcp_abort')
+        child.expect_exact('gnrc_tcp_abort: argc=1, argv[0] = gnrc_tcp_abort')
+        verify_pktbuf_empty(child)
+
+    return runner
+
+
+def generate_data(length):
+    return ''.join(random.choice(string.ascii_letters) for _ in range(length))
+
+
+def set_rcvbuf(child, min_size, max_size, expected):
+    child.sendline('gnrc_tcp_set_rcvbuf {} {}'.format(min_size, max_size))
+    child.expect_exact('gnrc_tcp_set_rcvbuf: returns {}'.format(expected))
+
+
+def open_connection(child, peer, **kwargs):
+    child.sendline('gnrc_tcp_open_passive [::]:{}'.format(peer.dst_port))
+    child.expect(r'gnrc_tcp_open_passive: argc=2, '
+                 r'argv\[0\] = gnrc_tcp_open_passive, '
+                 r'argv\[1\] = \[::\]:(\d+)\r\n')
+    synack = peer.connect(**kwargs)
+    child.expect_exact('gnrc_tcp_open_passive: returns 0')
+    return synack
+
+
+def send_payload(peer, payload):
+    """Sends payload to RIOT and returns the window field of its ACK."""
+    peer.send(flags='PA', payload=payload)
+    peer.seq += len(payload)
+    ack = peer.expect()
+    assert ack is not None
+    assert ack.ack == peer.seq
+    return ack.window
+
+
+def recv_payload(child, peer, data):
+    """Reads data on RIOT and returns the window field of its window update."""
+    setup_internal_buffer(child)
+    child.sendline('gnrc_tcp_recv 1000000 {}'.format(len(data)))
+    child.expect_exact('gnrc_tcp_recv: received {}'.format(len(data)))
+    assert read_data_from_internal_buffer(child, len(data)) == data
+    update = peer.expect()
+    assert update is not None
+    return update.window
+
+
+@testfunc
+def test_set_rcvbuf_invalid(child, peer):
+    # Smaller than one segment
+    set_rcvbuf(child, RIOT_MSS - 1, 2 * RIOT_MSS, '-EINVAL')
+    # Maximum smaller than initial size
+    set_rcvbuf(child, 2 * RIOT_MSS, RIOT_MSS, '-EINVAL')
+    # Larger than a scaled window can announce
+    set_rcvbuf(child, RIOT_MSS, 0xffffffff, '-EINVAL')
+    set_rcvbuf(child, RIOT_MSS, 2 * RIOT_MSS, '0')
+
+
+@testfunc
+def test_set_rcvbuf_connected(child, peer):
+    set_rcvbuf(child, RIOT_MSS, 2 * RIOT_MSS, '0')
+    open_connection(child, peer)
+    # The buffer size is fixed once the connection is established
+    set_rcvbuf(child, RIOT_MSS, 2 * RIOT_MSS, '-EISCONN')
+
+
+@testfunc
+def test_rcvbuf_growth(child, peer):
+    max_size = 2000
+    set_rcvbuf(child, RIOT_MSS, max_size, '0')
+    synack = open_connection(child, peer)
+    assert synack.window == RIOT_MSS
+
+    # Filling the buffer closes the window. Reading it all at once shows that
+    # the window limits the peer, so the buffer grows up to its maximum.
+    data = generate_data(RIOT_MSS)
+    assert send_payload(peer, data.encode()) == 0
+    assert recv_payload(child, peer, data) == max_size
+
+    # The buffer does not grow beyond its maximum
+    data = generate_data(max_size)
+    assert send_payload(peer, data[:RIOT_MSS].encode()) == max_size - RIOT_MSS
+    assert send_payload(peer, data[RIOT_MSS:].encode()) == 0
+    assert recv_payload(child, peer, data) == max_size
+
+
+@testfunc
+def test_wscale_negotiation(child, peer):
+    # 131072 bytes need a window scale of 2 to fit into the window field
+    set_rcvbuf(child, RIOT_MSS, 131072, '0')
+    synack = open_connection(child, peer, wscale=3)
+    assert dict(synack.options).get('WScale') == 2
+    # The window of SYN segments is never scaled
+    assert synack.window == RIOT_MSS
+
+    # Windows announced by RIOT are scaled
+    payload = generate_data(100).encode()
+    assert send_payload(peer, payload) == (RIOT_MSS - len(payload)) >> 2
+
+    # Windows announced by the peer are scaled as well: 25 << 3 bytes allow
+    # two full segments of 100 bytes instead of one with 25 bytes
+    peer.window = 25
+    peer.send_ack(peer.ack)
+    data = generate_data(200)
+    setup_internal_buffer(child)
+    write_data_to_internal_buffer(child, data)
+    child.sendline('gnrc_tcp_send 0')
+    child.expect_exact('gnrc_tcp_send: sent {}'.format(len(data)))
+    for i in range(2):
+        seg = peer.expect()
+        assert seg is not None
+        assert bytes(seg.payload) == data[i * 100:(i + 1) * 100].encode()
+
+
+@testfunc
+def test_wscale_not_offered(child, peer):
+    # Without window scaling on the peer, windows are announced unscaled
+    set_rcvbuf(child, RIOT_MSS, 131072, '0')
+    synack = open_connection(child, peer)
+    assert 'WScale' not in dict(synack.options)
+
+    payload = generate_data(100).encode()
+    assert send_payload(peer, payload) == RIOT_MSS - len(payload)
+
+
+if __name__ == "__main__":
+    sudo_guard(uses_scapy=True)
+    script = sys.modules[__name__]
+    tests = [getattr(script, t) for t in script.__dict__
+             if type(getattr(script, t)).__name__ == "function"
+             and t.startswith("test_")]
+    for test in tests:
+        res = run(test, timeout=10, echo=False)
+        if res != 0:
+            sys.exit(res)
+    print(os.path.basename(sys.argv[0]) + ": success\n")
@@ -0,0 +1,119 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2020 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+import queue
+import random
+import threading
+
+from scapy.all import AsyncSniffer, Ether, IPv6, TCP, ICMPv6ND_NS, \
+                      ICMPv6ND_NA, ICMPv6NDOptSrcLLAddr, ICMPv6NDOptDstLLAddr, \
+                      sendp
+
+
+class ScapyPeer:
+    """TCP peer built from scapy packets.
+
+    The peer uses addresses of its own, so the TCP stack of the host does not
+    interfere with the connection. Every segment to the peer is captured and
+    can be taken with expect(), segments to RIOT are only sent on request.
+    This allows to drop, reorder or acknowledge segments selectively.
+    """
+    LL_ADDR = 'fe80::ff:fe42:2342'
+    L2_ADDR = '02:00:00:42:23:42'
+
+    def __init__(self, iface, dst_l2, dst_ll, dst_port, window=4096):
+        self.iface = iface
+        self.dst_l2 = dst_l2
+        self.dst_ll = dst_ll
+        self.dst_port = dst_port
+        self.src_port = random.randint(1024, 65535)
+        self.window = window
+        self.seq = random.randint(0, 0x7fffffff)
+        self.ack = 0
+        self._segments = queue.Queue()
+        self._started = threading.Event()
+        self._sniffer = AsyncSniffer(iface=iface, prn=self._handle, store=False,
+                                     started_callback=self._started.set)
+
+    def __enter__(self):
+        self._sniffer.start()
+        self._started.wait()
+        # The solicitation carries the link layer address of the peer, so RIOT
+        # can reply to the first segment without address resolution
+        sendp(self._l2_hdr(self.dst_l2) / IPv6(src=self.LL_ADDR, dst=self.dst_ll) /
+              ICMPv6ND_NS(tgt=self.dst_ll) / ICMPv6NDOptSrcLLAddr(lladdr=self.L2_ADDR),
+              iface=self.iface, verbose=0)
+        return self
+
+    def __exit__(self, exc, exc_val, exc_trace):
+        self._sniffer.stop()
+
+    def _l2_hdr(self, dst):
+        return Ether(src=self.L2_ADDR, dst=dst)
+
+    def _handle(self, pkt):
+        if (Ether not in pkt) or (IPv6 not in pkt) or \
+           (pkt[Ether].src.lower() == self.L2_ADDR):
+            return
+        if (ICMPv6ND_NS in pkt) and (pkt[ICMPv6ND_NS].tgt == self.LL_ADDR):
+            sendp(self._l2_hdr(pkt[Ether].src) /
+                  IPv6(src=self.LL_ADDR, dst=pkt[IPv6].src) /
+                  ICMPv6ND_NA(tgt=self.LL_ADDR, R=0, S=1, O=1) /
+                  ICMPv6NDOptDstLLAddr(lladdr=self.L2_ADDR),
+                  iface=self.iface, verbose=0)
+        elif (TCP in pkt) and (pkt[IPv6].dst == self.LL_ADDR) and \
+             (pkt[TCP].dport == self.src_port):
+            self._segments.put(pkt[TCP])
+
+    def send(self, flags='A', payload=b'', seq=None, ack=None, window=None,
+             options=None):
+        """Sends a segment, sequence numbers wrap around like in TCP."""
+        tcp_hdr = TCP(sport=self.src_port, dport=self.dst_port, flags=flags,
+                      seq=(self.seq if seq is None else seq) & 0xffffffff,
+                      ack=(self.ack if ack is None else ack) & 0xffffffff,
+                      window=self.window if window is None else window,
+                      options=options or [])
+        pkt = self._l2_hdr(self.dst_l2) / IPv6(src=self.LL_ADDR, dst=self.dst_ll) / tcp_hdr
+        if payload:
+            pkt = pkt / payload
+        sendp(pkt, iface=self.iface, verbose=0)
+
+    def send_ack(self, ack, sack_blocks=None):
+        options = []
+        if sack_blocks:
+            options.append(('SAck', tuple(edge & 0xffffffff
+                                          for block in sack_blocks for edge in block)))
+        self.send(flags='A', ack=ack, options=options)
+
+    def expect(self, timeout=1):
+        """Returns the next segment sent by RIOT, None if there was none."""
+        try:
+            return self._segments.get(timeout=timeout)
+        except queue.Empty:
+            return None
+
+    def expect_none(self, timeout):
+        seg = self.expect(timeout)
+        assert seg is None, "unexpected segment: " + seg.summary()
+
+    def connect(self, mss=100, sack=True, wscale=None):
+        """Opens the connection and returns the SYN+ACK of RIOT."""
+        options = [('MSS', mss)]
+        if sack:
+            options.append(('SAckOK', b''))
+        if wscale is not None:
+            options.append(('WScale', wscale))
+        self.send(flags='S', ack=0, options=options)
+        self.seq += 1
+
+        synack = self.expect(timeout=5)
+        assert synack is not None
+        assert synack.flags == 'SA'
+        assert synack.ack == self.seq
+        self.ack = synack.seq + 1
+        self.send(flags='A')
+        return synack
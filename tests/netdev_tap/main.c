@@ -0,0 +1,151 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Test application for receiving with the netdev_tap network
+ *              device driver
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "byteorder.h"
+#include "iolist.h"
+#include "msg.h"
+#include "net/ethernet/hdr.h"
+#include "netdev_tap.h"
+#include "netdev_tap_params.h"
+#include "od.h"
+#include "sched.h"
+#include "test_utils/expect.h"
+
+#define MSG_QUEUE_SIZE      (8)
+#define MSG_TYPE_ISR        (0x3456)
+#define PAYLOAD_BUF_SIZE    (64U)
+#define CANARY              (0xa5)
+
+static ethernet_hdr_t _hdr;
+/* one more byte to check nothing is written beyond the buffer */
+static uint8_t _payload[PAYLOAD_BUF_SIZE + 1];
+static msg_t _msg_queue[MSG_QUEUE_SIZE];
+static netdev_tap_t _dev;
+static kernel_pid_t _main_pid;
+
+static void _event_cb(netdev_t *dev, netdev_event_t event);
+
+static void _print_addr(const char *prefix, const uint8_t *addr)
+{
+    printf("%s%02x:%02x:%02x:%02x:%02x:%02x\n", prefix, addr[0], addr[1],
+           addr[2], addr[3], addr[4], addr[5]);
+}
+
+static void test_init(void)
+{
+    netdev_t *netdev = (netdev_t *)(&_dev);
+    uint8_t addr[ETHERNET_ADDR_LEN];
+
+    netdev_tap_setup(&_dev, &netdev_tap_params[0]);
+    netdev->event_callback = _event_cb;
+    expect(netdev->driver->init(netdev) >= 0);
+    expect(netdev->driver->get(netdev, NETOPT_ADDRESS, addr,
+                               sizeof(addr)) == sizeof(addr));
+    _print_addr("HWaddr: ", addr);
+}
+
+static void test_recv(void)
+{
+    puts("Waiting for incoming frames (use `make test`)");
+    while (1) {
+        netdev_t *netdev = (netdev_t *)(&_dev);
+        msg_t msg;
+
+        msg_receive(&msg);
+        if (msg.type == MSG_TYPE_ISR) {
+            netdev->driver->isr(netdev);
+        }
+        else {
+            puts("unexpected message type");
+        }
+    }
+}
+
+int main(void)
+{
+    puts("netdev_tap device driver test");
+    msg_init_queue(_msg_queue, MSG_QUEUE_SIZE);
+    _main_pid = sched_active_pid;
+
+    test_init();
+    test_recv();    /* does not return */
+    return 0;
+}
+
+/* receives the Ethernet header and the payload into separate buffers */
+static void _recv(netdev_t *dev)
+{
+    iolist_t iolist[2] = {
+        { .iol_next = &iolist[1], .iol_base = &_hdr,
+          .iol_len = sizeof(_hdr) },
+        { .iol_base = _payload, .iol_len = PAYLOAD_BUF_SIZE },
+    };
+    int res;
+
+    memset(&_hdr, 0, sizeof(_hdr));
+    memset(_payload, CANARY, sizeof(_payload));
+    res = dev->driver->recv_iolist(dev, iolist, NULL);
+    expect(_payload[PAYLOAD_BUF_SIZE] == CANARY);
+    if (res == 0) {
+        puts("Frame not for us");
+    }
+    else if (res < 0) {
+        puts("Received invalid frame");
+    }
+    else {
+        expect(((unsigned)res) >= sizeof(_hdr));
+        expect(((unsigned)res) <= iolist_size(iolist));
+        printf("Received %d bytes\n", res);
+        _print_addr("dst: ", _hdr.dst);
+        _print_addr("src: ", _hdr.src);
+        printf("type: 0x%04x\n", (unsigned)byteorder_ntohs(_hdr.type));
+        if ((unsigned)res > sizeof(_hdr)) {
+            puts("Payload:");
+            od_hex_dump(_payload, res - sizeof(_hdr), OD_WIDTH_DEFAULT);
+        }
+    }
+}
+
+static void _event_cb(netdev_t *dev, netdev_event_t event)
+{
+    if (event == NETDEV_EVENT_ISR) {
+        msg_t msg;
+
+        msg.type = MSG_TYPE_ISR;
+        msg.content.ptr = dev;
+
+        if (msg_send(&msg, _main_pid) <= 0) {
+            puts("possibly lost interrupt.");
+        }
+    }
+    else {
+        switch (event) {
+            case NETDEV_EVENT_RX_COMPLETE:
+            {
+                _recv(dev);
+                break;
+            }
+            default:
+                break;
+        }
+    }
+}
@@ -0,0 +1,96 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2020 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import os
+import re
+import sys
+import subprocess
+
+from scapy.all import Ether, Raw, sendp
+from testrunner import run
+
+
+ETHERNET_HDR_LEN = 14
+# must match PAYLOAD_BUF_SIZE of the application
+PAYLOAD_BUF_SIZE = 64
+# IEEE Std 802 - Local Experimental EtherType, unknown to GNRC
+ETHERTYPE = 0x88b5
+SRC_HWADDR = "3e:e6:b5:22:fd:0a"
+OTHER_HWADDR = "3e:e6:b5:22:fd:0b"
+
+
+def check_and_search_output(cmd, pattern, res_group, *args, **kwargs):
+    output = subprocess.check_output(cmd, *args, **kwargs).decode("utf-8")
+    for line in output.splitlines():
+        m = re.search(pattern, line)
+        if m is not None:
+            return m.group(res_group)
+    return None
+
+
+def get_bridge(tap):
+    res = check_and_search_output(
+            ["bridge", "link"],
+            r"{}.+master\s+(?P<master>[^\s]+)".format(tap),
+            "master"
+        )
+    return tap if res is None else res
+
+
+def expect_payload(child, payload):
+    child.expect_exact("Payload:")
+    for offset in range(0, len(payload), 16):
+        line = "{:08X}".format(offset)
+        for b in payload[offset:offset + 16]:
+            line += "  {:02X}".format(b)
+        child.expect_exact(line)
+
+
+def expect_frame(child, frame, received_len):
+    child.expect_exact("Received {} bytes".format(received_len))
+    child.expect_exact("dst: {}".format(frame.dst))
+    child.expect_exact("src: {}".format(frame.src))
+    child.expect_exact("type: 0x{:04x}".format(frame.type))
+    expect_payload(child, bytes(frame[Raw])[:received_len - ETHERNET_HDR_LEN])
+
+
+def testfunc(child):
+    tap = get_bridge(os.environ["TAP"])
+
+    child.expect_exact("netdev_tap device driver test")
+    child.expect(r"HWaddr: (?P<hwaddr>[a-f:0-9]+)\s")
+    hwaddr = child.match.group("hwaddr")
+    child.expect_exact("Waiting for incoming frames (use `make test`)")
+
+    # header and payload each land in their own buffer
+    frame = Ether(dst=hwaddr, src=SRC_HWADDR, type=ETHERTYPE) / \
+        Raw(load=bytes(range(PAYLOAD_BUF_SIZE - 16)))
+    sendp(frame, iface=tap, verbose=0)
+    expect_frame(child, frame, len(frame))
+
+    # unicast frames to other nodes are dropped
+    sendp(Ether(dst=OTHER_HWADDR, src=SRC_HWADDR, type=ETHERTYPE) /
+          Raw(load=bytes(PAYLOAD_BUF_SIZE)), iface=tap, verbose=0)
+    child.expect_exact("Frame not for us")
+
+    # a frame larger than the buffers is cut off at their end
+    frame = Ether(dst="ff:ff:ff:ff:ff:ff", src=SRC_HWADDR,
+                  type=ETHERTYPE) / \
+        Raw(load=bytes(range(PAYLOAD_BUF_SIZE + 32)))
+    sendp(frame, iface=tap, verbose=0)
+    expect_frame(child, frame, ETHERNET_HDR_LEN + PAYLOAD_BUF_SIZE)
+    print("SUCCESS")
+
+
+if __name__ == "__main__":
+    if os.geteuid() != 0:
+        print("\x1b[1;31mThis test requires root privileges.\n"
+              "It's constructing and sending Ethernet frames.\x1b[0m\n",
+              file=sys.stderr)
+        sys.exit(1)
+    sys.exit(run(testfunc, timeout=1, echo=False))
@@ -21,9 +21,12 @@
 #include <errno.h>
 #include <inttypes.h>
 #include <stdio.h>
+#include <string.h>
 
 #include "byteorder.h"
+#include "iolist.h"
 #include "net/ieee802154.h"
+#include "net/zep.h"
 #include "sched.h"
 #include "socket_zep.h"
 #include "socket_zep_params.h"
@@ -34,8 +37,14 @@
 #define MSG_QUEUE_SIZE  (8)
 #define MSG_TYPE_ISR    (0x3456)
 #define RECVBUF_SIZE    (IEEE802154_FRAME_LEN_MAX)
+#define HDRBUF_SIZE     (8U)
+#define CANARY          (0xa5)
 
 static uint8_t _recvbuf[RECVBUF_SIZE];
+/* frames received into an iolist are split over these two */
+static uint8_t _hdrbuf[HDRBUF_SIZE];
+static uint8_t _iolbuf[RECVBUF_SIZE + 1];
+static unsigned _frames;
 static msg_t _msg_queue[MSG_QUEUE_SIZE];
 static socket_zep_t _dev;
 static kernel_pid_t _main_pid;
@@ -116,6 +125,44 @@ int main(void)
     return 0;
 }
 
+/* receives the first frame with recv(), all others with recv_iolist() into
+ * two buffers: the second frame with room to spare, the third one with
+ * buffers just large enough for the frame without its FCS */
+static int _recv_frame(netdev_t *dev, int exp_len,
+                       netdev_ieee802154_rx_info_t *rx_info)
+{
+    static const size_t frame_offset = sizeof(zep_v2_data_hdr_t) +
+                                       IEEE802154_FCS_LEN;
+    iolist_t iolist[2] = {
+        { .iol_next = &iolist[1], .iol_base = _hdrbuf,
+          .iol_len = sizeof(_hdrbuf) },
+        { .iol_base = _iolbuf, .iol_len = sizeof(_iolbuf) - 1 },
+    };
+    int data_len;
+
+    switch (_frames++) {
+        case 0:
+            return dev->driver->recv(dev, _recvbuf, sizeof(_recvbuf), rx_info);
+        case 1:
+            puts("Receive into iolist");
+            break;
+        default:
+            puts("Receive into iolist without space for FCS");
+            expect(((unsigned)exp_len) > (frame_offset + sizeof(_hdrbuf)));
+            iolist[1].iol_len = exp_len - frame_offset - sizeof(_hdrbuf);
+            break;
+    }
+    memset(_iolbuf, CANARY, sizeof(_iolbuf));
+    data_len = dev->driver->recv_iolist(dev, iolist, rx_info);
+    /* the FCS goes to the driver, not beyond the buffers */
+    expect(_iolbuf[iolist[1].iol_len] == CANARY);
+    if (data_len > 0) {
+        expect(((unsigned)data_len) <= iolist_size(iolist));
+        iolist_copy(iolist, _recvbuf, data_len);
+    }
+    return data_len;
+}
+
 static void _recv(netdev_t *dev)
 {
     netdev_ieee802154_rx_info_t rx_info;
@@ -124,7 +171,7 @@ static void _recv(netdev_t *dev)
 
     expect(exp_len >= 0);
     expect(((unsigned)exp_len) <= sizeof(_recvbuf));
-    data_len = dev->driver->recv(dev, _recvbuf, sizeof(_recvbuf), &rx_info);
+    data_len = _recv_frame(dev, exp_len, &rx_info);
     if (data_len < 0) {
         puts("Received invalid packet");
     }
@@ -22,6 +22,10 @@ zep_params = {
         "remote_addr": "::1",
         "remote_port": 17754,
     }
+FRAME = b"\x45\x58\x02\x01\x1a\x44\xe0\x01\xff\xdb\xde\xa6\x1a\x00\x8b" + \
+        b"\xfd\xae\x60\xd3\x21\xf1\x00\x00\x00\x00\x00\x00\x00\x00\x00" + \
+        b"\x00\x22\x41\xdc\x02\x23\x00\x38\x30\x00\x0a\x50\x45\x5a\x00" + \
+        b"\x5b\x45\x00\x0a\x50\x45\x5a\x00Hello World\x3a\xf2"
 s = None
 
 
@@ -43,14 +47,16 @@ def testfunc(child):
     assert(len(data) == (ZEP_DATA_HEADER_SIZE + len("Hello\0World\0") + FCS_LEN))
     assert(b"Hello\0World\0" == data[ZEP_DATA_HEADER_SIZE:-2])
     child.expect_exact("Waiting for an incoming message (use `make test`)")
-    s.sendto(b"\x45\x58\x02\x01\x1a\x44\xe0\x01\xff\xdb\xde\xa6\x1a\x00\x8b" +
-             b"\xfd\xae\x60\xd3\x21\xf1\x00\x00\x00\x00\x00\x00\x00\x00\x00" +
-             b"\x00\x22\x41\xdc\x02\x23\x00\x38\x30\x00\x0a\x50\x45\x5a\x00" +
-             b"\x5b\x45\x00\x0a\x50\x45\x5a\x00Hello World\x3a\xf2",
-             ("::1", zep_params['local_port']))
-    child.expect(r"RSSI: \d+, LQI: \d+, Data:")
-    child.expect_exact(r"00000000  41  DC  02  23  00  38  30  00  0A  50  45  5A  00  5B  45  00")
-    child.expect_exact(r"00000010  0A  50  45  5A  00  48  65  6C  6C  6F  20  57  6F  72  6C  64")
+    # received with recv(), into an iolist, and into an iolist that leaves
+    # the FCS to the driver
+    for msg in (None, "Receive into iolist",
+                "Receive into iolist without space for FCS"):
+        s.sendto(FRAME, ("::1", zep_params['local_port']))
+        if msg is not None:
+            child.expect_exact(msg)
+        child.expect(r"RSSI: \d+, LQI: \d+, Data:")
+        child.expect_exact(r"00000000  41  DC  02  23  00  38  30  00  0A  50  45  5A  00  5B  45  00")
+        child.expect_exact(r"00000010  0A  50  45  5A  00  48  65  6C  6C  6F  20  57  6F  72  6C  64")
 
 
 if __name__ == "__main__":
@@ -0,0 +1,301 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup tests
+ * @{
+ *
+ * @file
+ */
+#include <stdint.h>
+#include <string.h>
+
+#include "embUnit/embUnit.h"
+
+#include "net/gnrc/netif.h"
+#include "net/gnrc/rpl.h"
+#include "net/gnrc/rpl/dodag.h"
+#include "net/gnrc/rpl/structs.h"
+#include "net/ieee802154.h"
+#include "net/netdev.h"
+#include "net/netif.h"
+#include "of_mrhof.h"
+
+#include "tests-gnrc_rpl_mrhof.h"
+
+/* a PID no thread of the unittests has */
+#define TEST_IFACE          (KERNEL_PID_LAST)
+#define TEST_MIN_HOP_INC    (CONFIG_GNRC_RPL_DEFAULT_MIN_HOP_RANK_INCREASE)
+#define TEST_PARENT_RANK    (TEST_MIN_HOP_INC)
+#define TEST_THRESHOLD      (CONFIG_GNRC_RPL_MRHOF_PARENT_SWITCH_THRESHOLD)
+#define TEST_ETX(n)         ((n) * GNRC_NETIF_ETX_DIVISOR)
+#define TEST_PARENTS_NUMOF  (2U)
+
+static const uint8_t _l2addrs[TEST_PARENTS_NUMOF][IEEE802154_LONG_ADDRESS_LEN] = {
+    { 0x3e, 0xe6, 0xb5, 0x0f, 0x19, 0x22, 0xfd, 0x0a },
+    { 0x3e, 0xe6, 0xb5, 0x0f, 0x19, 0x22, 0xfd, 0x0b },
+};
+
+/* only the ETX estimates and what is needed to derive the link-layer address
+ * of a parent from its link-local address is used by MRHOF */
+static gnrc_netif_t _netif;
+static gnrc_rpl_parent_t _parents[TEST_PARENTS_NUMOF];
+static gnrc_rpl_dodag_t *_dodag;
+static gnrc_rpl_of_t *_of;
+
+static void _init_parent(unsigned idx, uint16_t rank)
+{
+    gnrc_rpl_parent_t *parent = &_parents[idx];
+
+    ipv6_addr_set_link_local_prefix(&parent->addr);
+    memcpy(&parent->addr.u8[8], _l2addrs[idx], sizeof(_l2addrs[idx]));
+    parent->addr.u8[8] ^= 0x02;
+    parent->rank = rank;
+    parent->dodag = _dodag;
+    parent->next = NULL;
+}
+
+static void _set_etx(unsigned idx, uint16_t etx)
+{
+    gnrc_netif_etx_entry_t *entry = &_netif.etx.entries[idx];
+
+    memcpy(entry->l2addr, _l2addrs[idx], sizeof(_l2addrs[idx]));
+    entry->l2addr_len = sizeof(_l2addrs[idx]);
+    entry->etx = etx;
+}
+
+/* makes a parent the preferred one, as if the RPL core sorted the parent
+ * list and recalculated the rank */
+static void _prefer(unsigned idx)
+{
+    _dodag->parents = &_parents[idx];
+    _dodag->my_rank = _of->calc_rank(_dodag, 0);
+}
+
+static void set_up(void)
+{
+    gnrc_rpl_instance_t *inst = &gnrc_rpl_instances[0];
+
+    memset(inst, 0, sizeof(*inst));
+    inst->state = 1;
+    inst->of = _of;
+    inst->min_hop_rank_inc = TEST_MIN_HOP_INC;
+    _dodag = &inst->dodag;
+    _dodag->instance = inst;
+    _dodag->iface = TEST_IFACE;
+    _dodag->my_rank = GNRC_RPL_INFINITE_RANK;
+    memset(&_netif.etx, 0, sizeof(_netif.etx));
+    memset(_parents, 0, sizeof(_parents));
+    _of->reset(_dodag);
+}
+
+static void test_calc_rank__no_parent(void)
+{
+    TEST_ASSERT_EQUAL_INT(GNRC_RPL_INFINITE_RANK,
+                          _of->calc_rank(_dodag, 0));
+    TEST_ASSERT_EQUAL_INT(TEST_PARENT_RANK + CONFIG_GNRC_RPL_MRHOF_INIT_ETX,
+                          _of->calc_rank(_dodag, TEST_PARENT_RANK));
+}
+
+static void test_calc_rank__infinite_parent_rank(void)
+{
+    _init_parent(0, GNRC_RPL_INFINITE_RANK);
+    _set_etx(0, TEST_ETX(1));
+    _dodag->parents = &_parents[0];
+    TEST_ASSERT_EQUAL_INT(GNRC_RPL_INFINITE_RANK, _of->calc_rank(_dodag, 0));
+}
+
+static void test_calc_rank__unknown_etx(void)
+{
+    _init_parent(0, TEST_PARENT_RANK);
+    _dodag->parents = &_parents[0];
+    TEST_ASSERT_EQUAL_INT(TEST_PARENT_RANK + CONFIG_GNRC_RPL_MRHOF_INIT_ETX,
+                          _of->calc_rank(_dodag, 0));
+}
+
+static void test_calc_rank__etx(void)
+{
+    _init_parent(0, TEST_PARENT_RANK);
+    _set_etx(0, TEST_ETX(3));
+    _dodag->parents = &_parents[0];
+    TEST_ASSERT_EQUAL_INT(TEST_PARENT_RANK + TEST_ETX(3),
+                          _of->calc_rank(_dodag, 0));
+}
+
+static void test_calc_rank__min_hop_rank_inc(void)
+{
+    /* a perfect link costs less than MinHopRankIncrease */
+    _init_parent(0, TEST_PARENT_RANK);
+    _set_etx(0, TEST_ETX(1));
+    _dodag->parents = &_parents[0];
+    TEST_ASSERT_EQUAL_INT(TEST_PARENT_RANK + TEST_MIN_HOP_INC,
+                          _of->calc_rank(_dodag, 0));
+}
+
+static void test_calc_rank__hysteresis(void)
+{
+    const uint16_t rank = TEST_PARENT_RANK + TEST_ETX(3);
+
+    _init_parent(0, TEST_PARENT_RANK);
+    _set_etx(0, TEST_ETX(3));
+    _prefer(0);
+    TEST_ASSERT_EQUAL_INT(rank, _dodag->my_rank);
+    /* small changes of the link to the preferred parent keep the rank */
+    _set_etx(0, TEST_ETX(3) + TEST_THRESHOLD - 1);
+    TEST_ASSERT_EQUAL_INT(rank, _of->calc_rank(_dodag, 0));
+    _set_etx(0, TEST_ETX(3) - TEST_THRESHOLD + 1);
+    TEST_ASSERT_EQUAL_INT(rank, _of->calc_rank(_dodag, 0));
+    /* large ones don't */
+    _set_etx(0, TEST_ETX(3) + TEST_THRESHOLD);
+    TEST_ASSERT_EQUAL_INT(rank + TEST_THRESHOLD, _of->calc_rank(_dodag, 0));
+}
+
+static void test_parent_cmp__etx(void)
+{
+    _init_parent(0, TEST_PARENT_RANK);
+    _init_parent(1, TEST_PARENT_RANK);
+    _set_etx(0, TEST_ETX(2));
+    _set_etx(1, TEST_ETX(2));
+    TEST_ASSERT_EQUAL_INT(0, _of->parent_cmp(&_parents[0], &_parents[1]));
+    _set_etx(1, TEST_ETX(1));
+    TEST_ASSERT(_of->parent_cmp(&_parents[0], &_parents[1]) > 0);
+    TEST_ASSERT(_of->parent_cmp(&_parents[1], &_parents[0]) < 0);
+}
+
+static void test_parent_cmp__rank(void)
+{
+    /* the path cost and not the rank or the ETX alone decides */
+    _init_parent(0, TEST_PARENT_RANK);
+    _init_parent(1, TEST_PARENT_RANK + TEST_MIN_HOP_INC);
+    _set_etx(0, TEST_ETX(4));
+    _set_etx(1, TEST_ETX(1));
+    TEST_ASSERT(_of->parent_cmp(&_parents[0], &_parents[1]) > 0);
+    _set_etx(0, TEST_ETX(2));
+    TEST_ASSERT(_of->parent_cmp(&_parents[0], &_parents[1]) < 0);
+}
+
+static void test_parent_cmp__infinite_rank(void)
+{
+    _init_parent(0, TEST_PARENT_RANK);
+    _init_parent(1, TEST_PARENT_RANK);
+    _set_etx(0, TEST_ETX(1));
+    _set_etx(1, TEST_ETX(1));
+    _prefer(1);
+    _parents[1].rank = GNRC_RPL_INFINITE_RANK;
+    TEST_ASSERT(_of->parent_cmp(&_parents[0], &_parents[1]) < 0);
+}
+
+static void test_parent_cmp__hysteresis(void)
+{
+    _init_parent(0, TEST_PARENT_RANK);
+    _init_parent(1, TEST_PARENT_RANK);
+    _set_etx(0, TEST_ETX(3));
+    _prefer(0);
+    /* the other parent is better, but not by the threshold */
+    _set_etx(1, TEST_ETX(3) - TEST_THRESHOLD + 1);
+    TEST_ASSERT(_of->parent_cmp(&_parents[0], &_parents[1]) < 0);
+    TEST_ASSERT(_of->parent_cmp(&_parents[1], &_parents[0]) > 0);
+    /* now it is */
+    _set_etx(1, TEST_ETX(3) - TEST_THRESHOLD - 1);
+    TEST_ASSERT(_of->parent_cmp(&_parents[0], &_parents[1]) > 0);
+}
+
+static void test_parent_cmp__switch(void)
+{
+    _init_parent(0, TEST_PARENT_RANK);
+    _init_parent(1, TEST_PARENT_RANK);
+    _set_etx(0, TEST_ETX(3));
+    _set_etx(1, TEST_ETX(1));
+    _prefer(0);
+    TEST_ASSERT(_of->parent_cmp(&_parents[0], &_parents[1]) > 0);
+    _prefer(1);
+    TEST_ASSERT_EQUAL_INT(TEST_PARENT_RANK + TEST_MIN_HOP_INC,
+                          _dodag->my_rank);
+    /* the new preferred parent now has the bonus, so the old one must be
+     * better by the threshold to win back */
+    _set_etx(0, TEST_ETX(1) - 1);
+    TEST_ASSERT(_of->parent_cmp(&_parents[0], &_parents[1]) > 0);
+    _set_etx(1, TEST_ETX(1) + TEST_THRESHOLD + 1);
+    TEST_ASSERT(_of->parent_cmp(&_parents[0], &_parents[1]) < 0);
+}
+
+static void test_reset(void)
+{
+    _init_parent(0, TEST_PARENT_RANK);
+    _init_parent(1, TEST_PARENT_RANK);
+    _set_etx(0, TEST_ETX(3));
+    _set_etx(1, TEST_ETX(2));
+    _prefer(0);
+    TEST_ASSERT(_of->parent_cmp(&_parents[0], &_parents[1]) < 0);
+    /* the parents in this test are not allocated by the RPL core */
+    _dodag->parents = NULL;
+    gnrc_rpl_dodag_remove_all_parents(_dodag);
+    TEST_ASSERT_EQUAL_INT(GNRC_RPL_INFINITE_RANK, _dodag->my_rank);
+    TEST_ASSERT(_of->parent_cmp(&_parents[0], &_parents[1]) > 0);
+}
+
+static void test_etx_update(void)
+{
+    uint16_t etx;
+
+    TEST_ASSERT_EQUAL_INT(TEST_ETX(2),
+                          gnrc_netif_etx_update(GNRC_NETIF_ETX_UNKNOWN,
+                                                TEST_ETX(2)));
+    TEST_ASSERT_EQUAL_INT(TEST_ETX(1),
+                          gnrc_netif_etx_update(TEST_ETX(1), TEST_ETX(1)));
+    /* a new sample weighs 1/8 */
+    TEST_ASSERT_EQUAL_INT(TEST_ETX(1) + (TEST_ETX(5) / 8),
+                          gnrc_netif_etx_update(TEST_ETX(1),
+                                                TEST_ETX(GNRC_NETIF_ETX_NOACK_PENALTY)));
+    /* a perfect link converges to ETX 1 */
+    etx = TEST_ETX(GNRC_NETIF_ETX_NOACK_PENALTY);
+    for (unsigned i = 0; i < 64; i++) {
+        etx = gnrc_netif_etx_update(etx, TEST_ETX(1));
+    }
+    TEST_ASSERT_EQUAL_INT(TEST_ETX(1), etx);
+    /* a link needing two transmissions gets close to ETX 2 */
+    for (unsigned i = 0; i < 64; i++) {
+        etx = gnrc_netif_etx_update(etx, TEST_ETX(2));
+    }
+    TEST_ASSERT(etx <= TEST_ETX(2));
+    TEST_ASSERT(etx > (TEST_ETX(2) - (1U << GNRC_NETIF_ETX_EWMA_SHIFT)));
+}
+
+static Test *tests_gnrc_rpl_mrhof_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_calc_rank__no_parent),
+        new_TestFixture(test_calc_rank__infinite_parent_rank),
+        new_TestFixture(test_calc_rank__unknown_etx),
+        new_TestFixture(test_calc_rank__etx),
+        new_TestFixture(test_calc_rank__min_hop_rank_inc),
+        new_TestFixture(test_calc_rank__hysteresis),
+        new_TestFixture(test_parent_cmp__etx),
+        new_TestFixture(test_parent_cmp__rank),
+        new_TestFixture(test_parent_cmp__infinite_rank),
+        new_TestFixture(test_parent_cmp__hysteresis),
+        new_TestFixture(test_parent_cmp__switch),
+        new_TestFixture(test_reset),
+        new_TestFixture(test_etx_update),
+    };
+
+    EMB_UNIT_TESTCALLER(mrhof_tests, set_up, NULL, fixtures);
+
+    return (Test *)&mrhof_tests;
+}
+
+void tests_gnrc_rpl_mrhof(void)
+{
+    _of = gnrc_rpl_get_of_mrhof();
+    _netif.pid = TEST_IFACE;
+    _netif.device_type = NETDEV_TYPE_IEEE802154;
+    _netif.flags = GNRC_NETIF_FLAGS_HAS_L2ADDR;
+    netif_register(&_netif.netif);
+    TESTS_RUN(tests_gnrc_rpl_mrhof_tests());
+}
+/** @} */
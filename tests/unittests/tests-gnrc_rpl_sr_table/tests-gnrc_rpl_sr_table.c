@@ -0,0 +1,324 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup tests
+ * @{
+ *
+ * @file
+ */
+#include <errno.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "embUnit/embUnit.h"
+
+#include "net/gnrc/ipv6/ext/rh.h"
+#include "net/ipv6/ext/rh.h"
+#include "net/gnrc/rpl/sr_table.h"
+#include "net/gnrc/rpl/srh.h"
+#include "net/ipv6/addr.h"
+#include "net/ipv6/hdr.h"
+
+#include "tests-gnrc_rpl_sr_table.h"
+
+#define TEST_LIFETIME       (300U)
+#define TEST_NODES_NUMOF    (4U)
+#define TEST_SRH_SIZE       (sizeof(gnrc_rpl_srh_t) + \
+                             (TEST_NODES_NUMOF * sizeof(ipv6_addr_t)))
+
+/* nodes of a chain root <- 0 <- 1 <- 2 <- 3, all in 2001:db8::/64 */
+static ipv6_addr_t _nodes[TEST_NODES_NUMOF];
+
+static ipv6_addr_t _addr(uint16_t prefix, uint16_t iid)
+{
+    ipv6_addr_t addr = { .u16 = {
+        byteorder_htons(0x2001), byteorder_htons(0xdb8), byteorder_htons(prefix),
+    } };
+
+    addr.u16[7] = byteorder_htons(iid);
+    return addr;
+}
+
+/* adds the chain of _nodes up to node n */
+static void _add_chain(unsigned n)
+{
+    for (unsigned i = 0; i <= n; i++) {
+        TEST_ASSERT_EQUAL_INT(0, gnrc_rpl_sr_table_add(&_nodes[i],
+                                                       (i == 0) ? NULL : &_nodes[i - 1],
+                                                       TEST_LIFETIME));
+    }
+}
+
+static void _assert_route(unsigned n)
+{
+    ipv6_addr_t hops[TEST_NODES_NUMOF];
+
+    TEST_ASSERT_EQUAL_INT(n + 1, gnrc_rpl_sr_table_get_route(&_nodes[n], hops,
+                                                             ARRAY_SIZE(hops)));
+    for (unsigned i = 0; i <= n; i++) {
+        TEST_ASSERT(ipv6_addr_equal(&_nodes[i], &hops[i]));
+    }
+}
+
+static void _assert_no_route(const ipv6_addr_t *dst)
+{
+    ipv6_addr_t hops[TEST_NODES_NUMOF];
+
+    TEST_ASSERT_EQUAL_INT(-ENOENT, gnrc_rpl_sr_table_get_route(dst, hops,
+                                                               ARRAY_SIZE(hops)));
+}
+
+/* walks the source routing header the way the nodes along the route do and
+ * checks that it leads along the route to node n */
+static void _assert_srh_round_trip(unsigned n)
+{
+    union {
+        gnrc_rpl_srh_t srh;
+        uint8_t buf[TEST_SRH_SIZE];
+    } rh;
+    ipv6_hdr_t ipv6;
+    void *err_ptr = NULL;
+    int size;
+
+    memset(&rh, 0, sizeof(rh));
+    memset(&ipv6, 0, sizeof(ipv6));
+    size = gnrc_rpl_sr_table_build_srh(&_nodes[n], &rh.srh, sizeof(rh),
+                                       &ipv6.dst);
+    TEST_ASSERT(size > 0);
+    TEST_ASSERT_EQUAL_INT(0, size % 8);
+    TEST_ASSERT_EQUAL_INT(size, (rh.srh.len + 1) * 8);
+    TEST_ASSERT_EQUAL_INT(IPV6_EXT_RH_TYPE_RPL_SRH, rh.srh.type);
+    TEST_ASSERT_EQUAL_INT(n, rh.srh.seg_left);
+    TEST_ASSERT(ipv6_addr_equal(&_nodes[0], &ipv6.dst));
+    for (unsigned i = 1; i <= n; i++) {
+        TEST_ASSERT_EQUAL_INT(GNRC_IPV6_EXT_RH_FORWARDED,
+                              gnrc_rpl_srh_process(&ipv6, &rh.srh, &err_ptr));
+        TEST_ASSERT(ipv6_addr_equal(&_nodes[i], &ipv6.dst));
+    }
+    TEST_ASSERT_EQUAL_INT(0, rh.srh.seg_left);
+}
+
+static void set_up(void)
+{
+    gnrc_rpl_sr_table_reset();
+    for (unsigned i = 0; i < TEST_NODES_NUMOF; i++) {
+        _nodes[i] = _addr(0, i + 1);
+    }
+}
+
+static void test_add__child_of_root(void)
+{
+    gnrc_rpl_srh_t srh;
+    ipv6_addr_t first_hop;
+
+    _add_chain(0);
+    _assert_route(0);
+    /* children of the root are reached without source routing header */
+    TEST_ASSERT_EQUAL_INT(0, gnrc_rpl_sr_table_build_srh(&_nodes[0], &srh,
+                                                         sizeof(srh), &first_hop));
+    TEST_ASSERT(ipv6_addr_equal(&_nodes[0], &first_hop));
+}
+
+static void test_add__chain(void)
+{
+    _add_chain(TEST_NODES_NUMOF - 1);
+    for (unsigned i = 0; i < TEST_NODES_NUMOF; i++) {
+        _assert_route(i);
+    }
+}
+
+static void test_add__unknown_parent(void)
+{
+    /* the parent did not report its own parent yet */
+    TEST_ASSERT_EQUAL_INT(0, gnrc_rpl_sr_table_add(&_nodes[1], &_nodes[0],
+                                                   TEST_LIFETIME));
+    _assert_no_route(&_nodes[1]);
+    _assert_no_route(&_nodes[0]);
+    TEST_ASSERT_EQUAL_INT(0, gnrc_rpl_sr_table_add(&_nodes[0], NULL,
+                                                   TEST_LIFETIME));
+    _assert_route(1);
+}
+
+static void test_add__change_parent(void)
+{
+    ipv6_addr_t hops[TEST_NODES_NUMOF];
+
+    _add_chain(2);
+    /* node 2 moves from node 1 to node 0 */
+    TEST_ASSERT_EQUAL_INT(0, gnrc_rpl_sr_table_add(&_nodes[2], &_nodes[0],
+                                                   TEST_LIFETIME));
+    TEST_ASSERT_EQUAL_INT(2, gnrc_rpl_sr_table_get_route(&_nodes[2], hops,
+                                                         ARRAY_SIZE(hops)));
+    TEST_ASSERT(ipv6_addr_equal(&_nodes[0], &hops[0]));
+    TEST_ASSERT(ipv6_addr_equal(&_nodes[2], &hops[1]));
+    _assert_route(1);
+}
+
+static void test_add__loop(void)
+{
+    _add_chain(2);
+    /* node 0 reports its grandchild as parent */
+    TEST_ASSERT_EQUAL_INT(-EINVAL, gnrc_rpl_sr_table_add(&_nodes[0], &_nodes[2],
+                                                         TEST_LIFETIME));
+    TEST_ASSERT_EQUAL_INT(-EINVAL, gnrc_rpl_sr_table_add(&_nodes[1], &_nodes[1],
+                                                         TEST_LIFETIME));
+    /* the routes stay as they were */
+    _assert_route(2);
+}
+
+static void test_add__full(void)
+{
+    ipv6_addr_t addr;
+
+    for (unsigned i = 0; i < CONFIG_GNRC_RPL_SR_TABLE_SIZE; i++) {
+        addr = _addr(1, i + 1);
+        TEST_ASSERT_EQUAL_INT(0, gnrc_rpl_sr_table_add(&addr, NULL, TEST_LIFETIME));
+    }
+    TEST_ASSERT_EQUAL_INT(-ENOMEM, gnrc_rpl_sr_table_add(&_nodes[0], NULL,
+                                                         TEST_LIFETIME));
+    /* a known node can still be updated */
+    TEST_ASSERT_EQUAL_INT(0, gnrc_rpl_sr_table_add(&addr, NULL, TEST_LIFETIME));
+}
+
+static void test_del(void)
+{
+    _add_chain(1);
+    gnrc_rpl_sr_table_del(&_nodes[0]);
+    _assert_no_route(&_nodes[0]);
+    /* the route of the child leads through the removed node */
+    _assert_no_route(&_nodes[1]);
+    /* unknown nodes are ignored */
+    gnrc_rpl_sr_table_del(&_nodes[2]);
+    /* the child keeps its parent, the route is valid once the parent is back */
+    TEST_ASSERT_EQUAL_INT(0, gnrc_rpl_sr_table_add(&_nodes[0], NULL,
+                                                   TEST_LIFETIME));
+    _assert_route(1);
+}
+
+static void test_purge(void)
+{
+    /* nodes 0 and 1 and enough others to fill the table */
+    _add_chain(1);
+    for (unsigned i = 2; i < CONFIG_GNRC_RPL_SR_TABLE_SIZE; i++) {
+        ipv6_addr_t addr = _addr(1, i);
+
+        TEST_ASSERT_EQUAL_INT(0, gnrc_rpl_sr_table_add(&addr, NULL, TEST_LIFETIME));
+    }
+    /* node 1 still points to node 0, so its entry can not be reclaimed */
+    gnrc_rpl_sr_table_del(&_nodes[0]);
+    TEST_ASSERT_EQUAL_INT(-ENOMEM, gnrc_rpl_sr_table_add(&_nodes[2], NULL,
+                                                         TEST_LIFETIME));
+    /* the entry of node 1 is reclaimed, node 0 is still referenced while the
+     * references are counted */
+    gnrc_rpl_sr_table_del(&_nodes[1]);
+    TEST_ASSERT_EQUAL_INT(0, gnrc_rpl_sr_table_add(&_nodes[2], NULL,
+                                                   TEST_LIFETIME));
+    _assert_no_route(&_nodes[1]);
+    /* the next purge reclaims node 0 */
+    TEST_ASSERT_EQUAL_INT(0, gnrc_rpl_sr_table_add(&_nodes[3], NULL,
+                                                   TEST_LIFETIME));
+    _assert_no_route(&_nodes[0]);
+    TEST_ASSERT_EQUAL_INT(-ENOMEM, gnrc_rpl_sr_table_add(&_nodes[1], NULL,
+                                                         TEST_LIFETIME));
+}
+
+static void test_get_route__too_long(void)
+{
+    ipv6_addr_t hops[TEST_NODES_NUMOF];
+
+    _add_chain(TEST_NODES_NUMOF - 1);
+    TEST_ASSERT_EQUAL_INT(-ENOBUFS,
+                          gnrc_rpl_sr_table_get_route(&_nodes[TEST_NODES_NUMOF - 1],
+                                                      hops, TEST_NODES_NUMOF - 1));
+}
+
+static void test_build_srh__compressed(void)
+{
+    union {
+        gnrc_rpl_srh_t srh;
+        uint8_t buf[TEST_SRH_SIZE];
+    } rh;
+    ipv6_addr_t first_hop;
+
+    _add_chain(TEST_NODES_NUMOF - 1);
+    _assert_srh_round_trip(TEST_NODES_NUMOF - 1);
+    _assert_srh_round_trip(1);
+    /* all addresses differ in their last byte only: one byte per address,
+     * padded to a multiple of 8 bytes */
+    TEST_ASSERT_EQUAL_INT(sizeof(rh.srh) + 8,
+                          gnrc_rpl_sr_table_build_srh(&_nodes[3], &rh.srh, sizeof(rh),
+                                                      &first_hop));
+    TEST_ASSERT_EQUAL_INT(0xff, rh.srh.compr);
+}
+
+static void test_build_srh__uncompressed(void)
+{
+    union {
+        gnrc_rpl_srh_t srh;
+        uint8_t buf[TEST_SRH_SIZE];
+    } rh;
+    ipv6_addr_t first_hop;
+
+    /* the addresses along the route share less of their prefix */
+    _nodes[1] = _addr(0x1, 2);
+    _nodes[2] = _addr(0x100, 3);
+    _nodes[3].u8[0] = 0xfd;
+    _add_chain(TEST_NODES_NUMOF - 1);
+    _assert_srh_round_trip(TEST_NODES_NUMOF - 1);
+    _assert_srh_round_trip(2);
+    TEST_ASSERT_EQUAL_INT(sizeof(rh.srh) + (2 * (sizeof(ipv6_addr_t) - 4)) +
+                          sizeof(ipv6_addr_t),
+                          gnrc_rpl_sr_table_build_srh(&_nodes[3], &rh.srh, sizeof(rh),
+                                                      &first_hop));
+    /* the intermediate hops share the first 4 bytes with the first hop, the
+     * destination nothing */
+    TEST_ASSERT_EQUAL_INT(0x40, rh.srh.compr);
+}
+
+static void test_build_srh__errors(void)
+{
+    gnrc_rpl_srh_t srh;
+    ipv6_addr_t first_hop;
+
+    TEST_ASSERT_EQUAL_INT(-ENOENT, gnrc_rpl_sr_table_build_srh(&_nodes[1], &srh,
+                                                               sizeof(srh),
+                                                               &first_hop));
+    _add_chain(TEST_NODES_NUMOF - 1);
+    TEST_ASSERT_EQUAL_INT(-ENOBUFS, gnrc_rpl_sr_table_build_srh(&_nodes[3], &srh,
+                                                                sizeof(srh),
+                                                                &first_hop));
+}
+
+static Test *tests_gnrc_rpl_sr_table_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_add__child_of_root),
+        new_TestFixture(test_add__chain),
+        new_TestFixture(test_add__unknown_parent),
+        new_TestFixture(test_add__change_parent),
+        new_TestFixture(test_add__loop),
+        new_TestFixture(test_add__full),
+        new_TestFixture(test_del),
+        new_TestFixture(test_purge),
+        new_TestFixture(test_get_route__too_long),
+        new_TestFixture(test_build_srh__compressed),
+        new_TestFixture(test_build_srh__uncompressed),
+        new_TestFixture(test_build_srh__errors),
+    };
+
+    EMB_UNIT_TESTCALLER(sr_table_tests, set_up, NULL, fixtures);
+
+    return (Test *)&sr_table_tests;
+}
+
+void tests_gnrc_rpl_sr_table(void)
+{
+    TESTS_RUN(tests_gnrc_rpl_sr_table_tests());
+}
+/** @} */
@@ -0,0 +1,35 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     unittests
+ * @{
+ *
+ * @file
+ * @brief       Unittests for the `gnrc_rpl_sr_table` module
+ */
+#ifndef TESTS_GNRC_RPL_SR_TABLE_H
+#define TESTS_GNRC_RPL_SR_TABLE_H
+
+#include "embUnit.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   The entry point of this test suite.
+ */
+void tests_gnrc_rpl_sr_table(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TESTS_GNRC_RPL_SR_TABLE_H */
+/** @} */
@@ -36,13 +36,7 @@
  * reference for forwarding) so an uninitialized one is enough */
 static gnrc_netif_t _dummy_netif;
 
-static const gnrc_sixlowpan_frag_rb_int_t _interval = {
-    .next = NULL,
-    .start = 0,
-    .end = 116U,
-};
 static const gnrc_sixlowpan_frag_rb_base_t _base = {
-    .ints = (gnrc_sixlowpan_frag_rb_int_t *)&_interval,
     .src = TEST_SRC,
     .dst = TEST_DST,
     .src_len = TEST_SRC_LEN,
@@ -68,13 +62,9 @@ static void test_vrb_add__success(void)
                                                             &_dummy_netif,
                                                             _out_dst,
                                                             sizeof(_out_dst))));
-    TEST_ASSERT_NOT_NULL(res->super.ints);
-    TEST_ASSERT_NULL(res->super.ints->next);
     /* make sure _base and res->super are distinct*/
     TEST_ASSERT((&_base) != (&res->super));
     /* but that the values are the same */
-    TEST_ASSERT_EQUAL_INT(_interval.start, res->super.ints->start);
-    TEST_ASSERT_EQUAL_INT(_interval.end, res->super.ints->end);
     TEST_ASSERT_EQUAL_INT(_base.src_len, res->super.src_len);
     TEST_ASSERT_MESSAGE(memcmp(_base.src, res->super.src, TEST_SRC_LEN) == 0,
                         "TEST_SRC != res->super.src");
@@ -107,7 +97,8 @@ static void test_vrb_add__full(void)
 {
     gnrc_sixlowpan_frag_rb_base_t base = _base;
 
-    /* fill up VRB */
+    /* fill up VRB with entries too recent to be evicted */
+    base.arrival = xtimer_now_usec();
     for (unsigned i = 0; i < CONFIG_GNRC_SIXLOWPAN_FRAG_VRB_SIZE; i++) {
         TEST_ASSERT_NOT_NULL(gnrc_sixlowpan_frag_vrb_add(&base,
                                                          &_dummy_netif,
@@ -123,6 +114,67 @@ static void test_vrb_add__full(void)
                                                  base.tag));
 }
 
+static void test_vrb_add__full_evict_lru(void)
+{
+    gnrc_sixlowpan_frag_rb_base_t base = _base;
+    gnrc_sixlowpan_frag_vrb_t *first, *res;
+
+    /* fill up VRB with idle entries */
+    base.arrival = xtimer_now_usec() -
+                   CONFIG_GNRC_SIXLOWPAN_FRAG_VRB_EVICT_IDLE_US - 1000;
+    for (unsigned i = 0; i < CONFIG_GNRC_SIXLOWPAN_FRAG_VRB_SIZE; i++) {
+        TEST_ASSERT_NOT_NULL(gnrc_sixlowpan_frag_vrb_add(&base,
+                                                         &_dummy_netif,
+                                                         _out_dst,
+                                                         sizeof(_out_dst)));
+        base.tag++;
+    }
+    /* using the first entry makes the second the least recently used one */
+    TEST_ASSERT_NOT_NULL((first = gnrc_sixlowpan_frag_vrb_get(_base.src,
+                                                              _base.src_len,
+                                                              _base.tag)));
+    TEST_ASSERT_NOT_NULL((res = gnrc_sixlowpan_frag_vrb_add(&base,
+                                                            &_dummy_netif,
+                                                            _out_dst,
+                                                            sizeof(_out_dst))));
+    TEST_ASSERT(res != first);
+    TEST_ASSERT(res == gnrc_sixlowpan_frag_vrb_get(base.src, base.src_len,
+                                                   base.tag));
+    TEST_ASSERT(first == gnrc_sixlowpan_frag_vrb_get(_base.src, _base.src_len,
+                                                     _base.tag));
+    TEST_ASSERT_NULL(gnrc_sixlowpan_frag_vrb_get(_base.src, _base.src_len,
+                                                 _base.tag + 1));
+}
+
+static void test_vrb_add__full_no_evict_in_use(void)
+{
+    gnrc_sixlowpan_frag_rb_base_t base = _base;
+
+    /* fill up VRB with entries that arrived long ago ... */
+    base.arrival = xtimer_now_usec() -
+                   CONFIG_GNRC_SIXLOWPAN_FRAG_VRB_EVICT_IDLE_US - 1000;
+    for (unsigned i = 0; i < CONFIG_GNRC_SIXLOWPAN_FRAG_VRB_SIZE; i++) {
+        TEST_ASSERT_NOT_NULL(gnrc_sixlowpan_frag_vrb_add(&base,
+                                                         &_dummy_netif,
+                                                         _out_dst,
+                                                         sizeof(_out_dst)));
+        base.tag++;
+    }
+    /* ... but are all still used for forwarding */
+    for (unsigned i = 0; i < CONFIG_GNRC_SIXLOWPAN_FRAG_VRB_SIZE; i++) {
+        TEST_ASSERT_NOT_NULL(gnrc_sixlowpan_frag_vrb_get(_base.src,
+                                                         _base.src_len,
+                                                         _base.tag + i));
+    }
+    TEST_ASSERT_NULL(gnrc_sixlowpan_frag_vrb_add(&base, &_dummy_netif,
+                                                 _out_dst, sizeof(_out_dst)));
+    for (unsigned i = 0; i < CONFIG_GNRC_SIXLOWPAN_FRAG_VRB_SIZE; i++) {
+        TEST_ASSERT_NOT_NULL(gnrc_sixlowpan_frag_vrb_get(_base.src,
+                                                         _base.src_len,
+                                                         _base.tag + i));
+    }
+}
+
 static void test_vrb_get__empty(void)
 {
     TEST_ASSERT_NULL(gnrc_sixlowpan_frag_vrb_get(_base.src, _base.src_len,
@@ -143,6 +195,27 @@ static void test_vrb_get__after_add(void)
     TEST_ASSERT(res1 == res2);
 }
 
+static void test_vrb_reverse(void)
+{
+    gnrc_sixlowpan_frag_vrb_t *res;
+
+    TEST_ASSERT_NOT_NULL((res = gnrc_sixlowpan_frag_vrb_add(&_base,
+                                                            &_dummy_netif,
+                                                            _out_dst,
+                                                            sizeof(_out_dst))));
+    TEST_ASSERT(res == gnrc_sixlowpan_frag_vrb_reverse(&_dummy_netif,
+                                                       _out_dst,
+                                                       sizeof(_out_dst),
+                                                       res->out_tag));
+    TEST_ASSERT_NULL(gnrc_sixlowpan_frag_vrb_reverse(&_dummy_netif,
+                                                     _base.src,
+                                                     _base.src_len,
+                                                     res->out_tag));
+    TEST_ASSERT_NULL(gnrc_sixlowpan_frag_vrb_reverse(NULL, _out_dst,
+                                                     sizeof(_out_dst),
+                                                     res->out_tag));
+}
+
 static void test_vrb_rm(void)
 {
     gnrc_sixlowpan_frag_vrb_t *res;
@@ -177,8 +250,11 @@ static Test *tests_gnrc_sixlowpan_frag_vrb_tests(void)
         new_TestFixture(test_vrb_add__success),
         new_TestFixture(test_vrb_add__duplicate),
         new_TestFixture(test_vrb_add__full),
+        new_TestFixture(test_vrb_add__full_evict_lru),
+        new_TestFixture(test_vrb_add__full_no_evict_in_use),
         new_TestFixture(test_vrb_get__empty),
         new_TestFixture(test_vrb_get__after_add),
+        new_TestFixture(test_vrb_reverse),
         new_TestFixture(test_vrb_rm),
         new_TestFixture(test_vrb_gc),
     };
@@ -13,6 +13,7 @@
  */
 #include <errno.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "embUnit.h"
 
@@ -165,6 +166,53 @@ static void test_inet_csum__empty_app_buffer(void)
     TEST_ASSERT_EQUAL_INT(hdr_expected, pyld_sum);
 }
 
+static void test_inet_csum__update16(void)
+{
+    /* source: https://tools.ietf.org/html/rfc1071#section-3 */
+    uint8_t data[] = {
+        0x00, 0x01, 0xf2, 0x03, 0xf4, 0xf5, 0xf6, 0xf7
+    };
+    uint16_t csum = ~inet_csum(0, data, sizeof(data));
+
+    /* source: https://tools.ietf.org/html/rfc1624#section-4 */
+    TEST_ASSERT_EQUAL_INT(0x0000, inet_csum_update16(0xdd2f, 0x5555, 0x3285));
+    data[2] = 0x12;
+    data[3] = 0x34;
+    TEST_ASSERT_EQUAL_INT((uint16_t)~inet_csum(0, data, sizeof(data)),
+                          inet_csum_update16(csum, 0xf203, 0x1234));
+}
+
+static void test_inet_csum__update(void)
+{
+    /* source: https://www.cloudshark.org/captures/ea72fbab241b (No. 56) */
+    uint8_t data[] = {
+        0xfe, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, /* IPv6 source */
+        0x5a, 0x6d, 0x8f, 0xff, 0xfe, 0x56, 0x30, 0x09,
+        0xff, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, /* IPv6 destination */
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01,
+        0x00, 0x00, 0x00, 0x38, 0x00, 0x00, 0x00, 0x3a, /* payload length + next header */
+        0x86, 0x00, 0xab, 0x32, 0x40, 0x58, 0x07, 0x08, /* ICMPv6 payload */
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x03, 0x04, 0x40, 0xc0, 0x00, 0x00, 0x00, 0x1e,
+        0x00, 0x00, 0x00, 0x14, 0x00, 0x00, 0x00, 0x00,
+        0x20, 0x02, 0x18, 0x3d, 0xdb, 0xa4, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x01, 0x01, 0x58, 0x6d, 0x8f, 0x56, 0x30, 0x09
+    };
+    uint8_t src[] = {
+        0x20, 0x01, 0x0d, 0xb8, 0x00, 0x00, 0x00, 0x00,
+        0x5a, 0x6d, 0x8f, 0xff, 0xfe, 0x56, 0x30, 0x09,
+    };
+    uint16_t csum;
+
+    /* exchange source address, and write new checksum into ICMPv6 header */
+    csum = inet_csum_update((data[42] << 8) | data[43], data, src, sizeof(src));
+    memcpy(data, src, sizeof(src));
+    data[42] = csum >> 8;
+    data[43] = csum & 0xff;
+    TEST_ASSERT_EQUAL_INT(0xffff, inet_csum(0, data, sizeof(data)));
+}
+
 Test *tests_inet_csum_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -176,6 +224,8 @@ Test *tests_inet_csum_tests(void)
         new_TestFixture(test_inet_csum__odd_len),
         new_TestFixture(test_inet_csum__two_app_snips),
         new_TestFixture(test_inet_csum__empty_app_buffer),
+        new_TestFixture(test_inet_csum__update16),
+        new_TestFixture(test_inet_csum__update),
     };
 
     EMB_UNIT_TESTCALLER(inet_csum_tests, NULL, NULL, fixtures);
@@ -0,0 +1,113 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "embUnit.h"
+#include "iolist.h"
+
+#include "tests-iolist.h"
+
+#define CANARY          (0xa5)
+
+/* "Hello" -> (empty) -> "World" -> (empty) */
+static iolist_t _iol[4];
+static uint8_t _buf[16];
+
+static void set_up(void)
+{
+    memset(_iol, 0, sizeof(_iol));
+    _iol[0].iol_next = &_iol[1];
+    _iol[0].iol_base = "Hello";
+    _iol[0].iol_len = sizeof("Hello") - 1;
+    _iol[1].iol_next = &_iol[2];
+    _iol[2].iol_next = &_iol[3];
+    _iol[2].iol_base = "World";
+    _iol[2].iol_len = sizeof("World") - 1;
+    memset(_buf, CANARY, sizeof(_buf));
+}
+
+static void test_iolist_copy__NULL(void)
+{
+    TEST_ASSERT_EQUAL_INT(0, iolist_copy(NULL, _buf, sizeof(_buf)));
+    TEST_ASSERT_EQUAL_INT(CANARY, _buf[0]);
+}
+
+static void test_iolist_copy__len_0(void)
+{
+    TEST_ASSERT_EQUAL_INT(0, iolist_copy(_iol, _buf, 0));
+    TEST_ASSERT_EQUAL_INT(CANARY, _buf[0]);
+}
+
+static void test_iolist_copy__short_dst(void)
+{
+    /* ends within the first entry */
+    TEST_ASSERT_EQUAL_INT(3, iolist_copy(_iol, _buf, 3));
+    TEST_ASSERT_EQUAL_INT(0, memcmp("Hel", _buf, 3));
+    TEST_ASSERT_EQUAL_INT(CANARY, _buf[3]);
+}
+
+static void test_iolist_copy__empty_entries(void)
+{
+    /* the iolist fits, the empty entries contribute nothing */
+    TEST_ASSERT_EQUAL_INT(10, iolist_copy(_iol, _buf, sizeof(_buf)));
+    TEST_ASSERT_EQUAL_INT(0, memcmp("HelloWorld", _buf, 10));
+    TEST_ASSERT_EQUAL_INT(CANARY, _buf[10]);
+}
+
+static void test_iolist_copy__only_empty_entries(void)
+{
+    TEST_ASSERT_EQUAL_INT(0, iolist_copy(&_iol[3], _buf, sizeof(_buf)));
+    TEST_ASSERT_EQUAL_INT(CANARY, _buf[0]);
+}
+
+static void test_iolist_copy__exceeds_dst(void)
+{
+    /* ends within the entry after an empty one */
+    TEST_ASSERT_EQUAL_INT(7, iolist_copy(_iol, _buf, 7));
+    TEST_ASSERT_EQUAL_INT(0, memcmp("HelloWo", _buf, 7));
+    TEST_ASSERT_EQUAL_INT(CANARY, _buf[7]);
+}
+
+static void test_iolist_copy__exact_dst(void)
+{
+    /* ends with the first entry, the empty ones after it do not matter */
+    TEST_ASSERT_EQUAL_INT(5, iolist_copy(_iol, _buf, 5));
+    TEST_ASSERT_EQUAL_INT(0, memcmp("Hello", _buf, 5));
+    TEST_ASSERT_EQUAL_INT(CANARY, _buf[5]);
+}
+
+Test *tests_iolist_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_iolist_copy__NULL),
+        new_TestFixture(test_iolist_copy__len_0),
+        new_TestFixture(test_iolist_copy__short_dst),
+        new_TestFixture(test_iolist_copy__empty_entries),
+        new_TestFixture(test_iolist_copy__only_empty_entries),
+        new_TestFixture(test_iolist_copy__exceeds_dst),
+        new_TestFixture(test_iolist_copy__exact_dst),
+    };
+
+    EMB_UNIT_TESTCALLER(iolist_tests, set_up, NULL, fixtures);
+
+    return (Test *)&iolist_tests;
+}
+
+void tests_iolist(void)
+{
+    TESTS_RUN(tests_iolist_tests());
+}
+/** @} */
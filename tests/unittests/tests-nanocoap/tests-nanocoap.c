@@ -19,6 +19,7 @@
 
 #include "embUnit.h"
 
+#include "benchmark.h"
 #include "net/nanocoap.h"
 
 #include "unittests-constants.h"
@@ -26,6 +27,7 @@
 
 
 #define _BUF_SIZE (128U)
+#define _BENCHMARK_RUNS (10000U)
 
 /*
  * Validates encoded message ID byte order and put/get URI option.
@@ -836,6 +838,159 @@ static void test_nanocoap__token_length_over_limit(void)
     TEST_ASSERT_EQUAL_INT(-EBADMSG, res);
 }
 
+/*
+ * Verifies that coap_find_resource() returns the first resource in path
+ * order that matches the URI and the method.
+ */
+static void test_nanocoap__find_resource(void)
+{
+    const coap_resource_t resources[] = {
+        { "/a", COAP_GET, NULL, NULL },
+        { "/a", COAP_POST, NULL, NULL },
+        { "/a/", COAP_GET | COAP_MATCH_SUBTREE, NULL, NULL },
+        { "/a/b", COAP_GET | COAP_PUT, NULL, NULL },
+        { "/ab", COAP_PUT | COAP_MATCH_SUBTREE, NULL, NULL },
+        { "/b", COAP_GET, NULL, NULL },
+        { "/b/c", COAP_GET, NULL, NULL },
+    };
+    const struct {
+        const char *uri;
+        coap_method_flags_t method;
+        int res;
+        int idx;
+    } cases[] = {
+        { "/a", COAP_GET, 0, 0 },
+        { "/a", COAP_POST, 0, 1 },
+        { "/a", COAP_PUT, -ENOTSUP, -1 },
+        { "/a/", COAP_GET, 0, 2 },
+        { "/a/b", COAP_GET, 0, 2 },     /* subtree sorts first */
+        { "/a/b", COAP_PUT, 0, 3 },
+        { "/a/c", COAP_PUT, -ENOTSUP, -1 },
+        { "/abc", COAP_PUT, 0, 4 },
+        { "/abc", COAP_GET, -ENOTSUP, -1 },
+        { "/b/c", COAP_GET, 0, 6 },
+        { "/b/", COAP_GET, -ENOENT, -1 },
+        { "/", COAP_GET, -ENOENT, -1 },
+        { "/c", COAP_GET, -ENOENT, -1 },
+    };
+
+    for (unsigned i = 0; i < ARRAY_SIZE(cases); i++) {
+        const coap_resource_t *resource = NULL;
+        int res = coap_find_resource(resources, ARRAY_SIZE(resources),
+                                     (const uint8_t *)cases[i].uri,
+                                     cases[i].method, &resource);
+
+        TEST_ASSERT_EQUAL_INT(cases[i].res, res);
+        if (res == 0) {
+            TEST_ASSERT(resource == &resources[cases[i].idx]);
+        }
+    }
+}
+
+/*
+ * Builds a request with an option of most of the common option numbers, like
+ * a blockwise observe request through a proxy.
+ */
+static int _build_many_opts_req(coap_pkt_t *pkt, uint8_t *buf)
+{
+    coap_block1_t block2 = { .blknum = 3, .szx = 2 };
+    uint8_t *pktpos = buf;
+
+    pktpos += coap_build_hdr((coap_hdr_t *)pktpos, COAP_TYPE_CON, NULL, 0,
+                             COAP_METHOD_GET, 1);
+    pktpos += coap_put_option(pktpos, 0, COAP_OPT_URI_HOST,
+                              (uint8_t *)"host", 4);
+    pktpos += coap_opt_put_uint(pktpos, COAP_OPT_URI_HOST, COAP_OPT_OBSERVE, 0);
+    pktpos += coap_opt_put_uri_path(pktpos, COAP_OPT_OBSERVE, "/3303/0/5700");
+    pktpos += coap_opt_put_uint(pktpos, COAP_OPT_URI_PATH,
+                                COAP_OPT_CONTENT_FORMAT, COAP_FORMAT_CBOR);
+    pktpos += coap_opt_put_uri_query(pktpos, COAP_OPT_CONTENT_FORMAT, "pmin=10");
+    pktpos += coap_opt_put_block2_control(pktpos, COAP_OPT_URI_QUERY, &block2);
+    pktpos += coap_put_option(pktpos, COAP_OPT_BLOCK2, COAP_OPT_PROXY_SCHEME,
+                              (uint8_t *)"coap", 4);
+    return coap_parse(pkt, buf, pktpos - buf);
+}
+
+/*
+ * Verifies that the option getters find every option through the option
+ * index, and no option that is not in the request.
+ */
+static void test_nanocoap__options_index(void)
+{
+    uint8_t buf[_BUF_SIZE];
+    char str[32];
+    coap_pkt_t pkt;
+    uint8_t *value;
+    uint32_t blknum, uint_val;
+    unsigned szx;
+
+    TEST_ASSERT_EQUAL_INT(0, _build_many_opts_req(&pkt, buf));
+    /* the repeated Uri-Path option is indexed once */
+    TEST_ASSERT_EQUAL_INT(7, pkt.options_len);
+
+    TEST_ASSERT_EQUAL_INT(4, coap_opt_get_opaque(&pkt, COAP_OPT_URI_HOST,
+                                                 &value));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(value, "host", 4));
+    TEST_ASSERT_EQUAL_INT(0, coap_opt_get_uint(&pkt, COAP_OPT_OBSERVE,
+                                               &uint_val));
+    TEST_ASSERT_EQUAL_INT(0, uint_val);
+    TEST_ASSERT_EQUAL_INT(sizeof("/3303/0/5700"),
+                          coap_get_uri_path(&pkt, (uint8_t *)str));
+    TEST_ASSERT_EQUAL_STRING("/3303/0/5700", str);
+    TEST_ASSERT_EQUAL_INT(COAP_FORMAT_CBOR, coap_get_content_type(&pkt));
+    TEST_ASSERT_EQUAL_INT(sizeof("&pmin=10"),
+                          coap_opt_get_string(&pkt, COAP_OPT_URI_QUERY,
+                                              (uint8_t *)str, sizeof(str),
+                                              '&'));
+    TEST_ASSERT_EQUAL_STRING("&pmin=10", str);
+    TEST_ASSERT_EQUAL_INT(0, coap_get_blockopt(&pkt, COAP_OPT_BLOCK2, &blknum,
+                                               &szx));
+    TEST_ASSERT_EQUAL_INT(3, blknum);
+    TEST_ASSERT_EQUAL_INT(2, szx);
+    TEST_ASSERT_EQUAL_INT(4, coap_opt_get_opaque(&pkt, COAP_OPT_PROXY_SCHEME,
+                                                 &value));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(value, "coap", 4));
+
+    /* options not in the request, below, between and above the indexed ones */
+    TEST_ASSERT_EQUAL_INT(-ENOENT, coap_opt_get_opaque(&pkt, 1, &value));
+    TEST_ASSERT_EQUAL_INT(-ENOENT, coap_opt_get_uint(&pkt,
+                                                     COAP_OPT_LOCATION_PATH,
+                                                     &uint_val));
+    TEST_ASSERT_EQUAL_INT(-1, coap_get_blockopt(&pkt, COAP_OPT_BLOCK1, &blknum,
+                                                &szx));
+    TEST_ASSERT_EQUAL_INT(-ENOENT, coap_opt_get_opaque(&pkt, COAP_OPT_PROXY_URI,
+                                                       &value));
+    TEST_ASSERT_EQUAL_INT(-ENOENT, coap_opt_get_opaque(&pkt, 60, &value));
+}
+
+/* the option lookups of a typical resource handler */
+static void _get_handler_opts(coap_pkt_t *pkt)
+{
+    uint8_t uri[CONFIG_NANOCOAP_URI_MAX];
+    uint32_t blknum, observe;
+    unsigned szx;
+
+    coap_get_uri_path(pkt, uri);
+    coap_get_content_type(pkt);
+    coap_opt_get_uint(pkt, COAP_OPT_OBSERVE, &observe);
+    coap_get_blockopt(pkt, COAP_OPT_BLOCK1, &blknum, &szx);
+    coap_get_blockopt(pkt, COAP_OPT_BLOCK2, &blknum, &szx);
+}
+
+static void test_nanocoap__parse_benchmark(void)
+{
+    uint8_t buf[_BUF_SIZE];
+    coap_pkt_t pkt;
+
+    TEST_ASSERT_EQUAL_INT(0, _build_many_opts_req(&pkt, buf));
+    size_t len = pkt.payload - buf;
+
+    BENCHMARK_FUNC("\ncoap_parse() [7 options]", _BENCHMARK_RUNS,
+                   coap_parse(&pkt, buf, len));
+    BENCHMARK_FUNC("option lookups [5 options]", _BENCHMARK_RUNS,
+                   _get_handler_opts(&pkt));
+}
+
 Test *tests_nanocoap_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -863,6 +1018,9 @@ Test *tests_nanocoap_tests(void)
         new_TestFixture(test_nanocoap__add_path_unterminated_string),
         new_TestFixture(test_nanocoap__add_get_proxy_uri),
         new_TestFixture(test_nanocoap__token_length_over_limit),
+        new_TestFixture(test_nanocoap__find_resource),
+        new_TestFixture(test_nanocoap__options_index),
+        new_TestFixture(test_nanocoap__parse_benchmark),
     };
 
     EMB_UNIT_TESTCALLER(nanocoap_tests, NULL, NULL, fixtures);
@@ -15,16 +15,32 @@
 
 #include "embUnit.h"
 
+#include "benchmark.h"
 #include "net/gnrc/netreg.h"
 #include "net/gnrc/nettype.h"
 
 #include "unittests-constants.h"
 #include "tests-netreg.h"
 
+#define MANY_ENTRIES_NUMOF  (48U)
+#define BENCHMARK_RUNS      (10000U)
+
 static gnrc_netreg_entry_t entries[] = {
     GNRC_NETREG_ENTRY_INIT_PID(TEST_UINT16, TEST_UINT8),
     GNRC_NETREG_ENTRY_INIT_PID(TEST_UINT16, TEST_UINT8 + 1)
 };
+static gnrc_netreg_entry_t many_entries[MANY_ENTRIES_NUMOF];
+
+/* registers many_entries with the ports of a busy UDP node */
+static void _register_many(void)
+{
+    for (unsigned i = 0; i < MANY_ENTRIES_NUMOF; i++) {
+        gnrc_netreg_entry_init_pid(&many_entries[i], 5683 + (i * 7),
+                                   TEST_UINT8);
+        TEST_ASSERT_EQUAL_INT(0, gnrc_netreg_register(GNRC_NETTYPE_TEST,
+                                                      &many_entries[i]));
+    }
+}
 
 static void set_up(void)
 {
@@ -139,6 +155,66 @@ void test_netreg_getnext__2_entries(void)
     TEST_ASSERT_NOT_NULL(gnrc_netreg_getnext(res));
 }
 
+void test_netreg_lookup__other_type(void)
+{
+    gnrc_netreg_entry_t entry = GNRC_NETREG_ENTRY_INIT_PID(TEST_UINT16,
+                                                           TEST_UINT8 + 2);
+    gnrc_netreg_entry_t *res = NULL;
+
+    TEST_ASSERT_EQUAL_INT(0, gnrc_netreg_register(GNRC_NETTYPE_TEST, &entries[0]));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_netreg_register(GNRC_NETTYPE_UNDEF, &entry));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_netreg_register(GNRC_NETTYPE_TEST, &entries[1]));
+    TEST_ASSERT_NOT_NULL((res = gnrc_netreg_lookup(GNRC_NETTYPE_UNDEF, TEST_UINT16)));
+    TEST_ASSERT(&entry == res);
+    TEST_ASSERT_NULL(gnrc_netreg_getnext(res));
+    TEST_ASSERT_NOT_NULL((res = gnrc_netreg_lookup(GNRC_NETTYPE_TEST, TEST_UINT16)));
+    TEST_ASSERT(&entries[1] == res);
+    TEST_ASSERT_NOT_NULL((res = gnrc_netreg_getnext(res)));
+    TEST_ASSERT(&entries[0] == res);
+    TEST_ASSERT_NULL(gnrc_netreg_getnext(res));
+    TEST_ASSERT_EQUAL_INT(2, gnrc_netreg_num(GNRC_NETTYPE_TEST, TEST_UINT16));
+    TEST_ASSERT_EQUAL_INT(1, gnrc_netreg_num(GNRC_NETTYPE_UNDEF, TEST_UINT16));
+    gnrc_netreg_unregister(GNRC_NETTYPE_UNDEF, &entry);
+    TEST_ASSERT_NULL(gnrc_netreg_lookup(GNRC_NETTYPE_UNDEF, TEST_UINT16));
+    TEST_ASSERT_EQUAL_INT(2, gnrc_netreg_num(GNRC_NETTYPE_TEST, TEST_UINT16));
+}
+
+void test_netreg_lookup__many_entries(void)
+{
+    _register_many();
+    for (unsigned i = 0; i < MANY_ENTRIES_NUMOF; i++) {
+        gnrc_netreg_entry_t *res = gnrc_netreg_lookup(GNRC_NETTYPE_TEST,
+                                                      5683 + (i * 7));
+        TEST_ASSERT(&many_entries[i] == res);
+        TEST_ASSERT_NULL(gnrc_netreg_getnext(res));
+        TEST_ASSERT_NULL(gnrc_netreg_lookup(GNRC_NETTYPE_TEST,
+                                            5683 + (i * 7) + 1));
+    }
+    for (unsigned i = 0; i < MANY_ENTRIES_NUMOF; i += 2) {
+        gnrc_netreg_unregister(GNRC_NETTYPE_TEST, &many_entries[i]);
+    }
+    for (unsigned i = 0; i < MANY_ENTRIES_NUMOF; i++) {
+        gnrc_netreg_entry_t *res = gnrc_netreg_lookup(GNRC_NETTYPE_TEST,
+                                                      5683 + (i * 7));
+        TEST_ASSERT((i & 1) ? (&many_entries[i] == res) : (res == NULL));
+    }
+}
+
+void test_netreg_lookup__benchmark(void)
+{
+    uint32_t demux_ctx = 5683 + ((MANY_ENTRIES_NUMOF - 1) * 7);
+
+    _register_many();
+    /* the entry registered first is the last one in the list without
+     * gnrc_netreg_hash */
+    BENCHMARK_FUNC("\ngnrc_netreg_lookup() [48 entries, last]", BENCHMARK_RUNS,
+                   gnrc_netreg_lookup(GNRC_NETTYPE_TEST, 5683));
+    BENCHMARK_FUNC("gnrc_netreg_lookup() [48 entries, first]", BENCHMARK_RUNS,
+                   gnrc_netreg_lookup(GNRC_NETTYPE_TEST, demux_ctx));
+    BENCHMARK_FUNC("gnrc_netreg_lookup() [48 entries, miss]", BENCHMARK_RUNS,
+                   gnrc_netreg_lookup(GNRC_NETTYPE_TEST, 1));
+}
+
 Test *tests_netreg_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -155,6 +231,9 @@ Test *tests_netreg_tests(void)
         new_TestFixture(test_netreg_num__2_entries),
         new_TestFixture(test_netreg_getnext__NULL),
         new_TestFixture(test_netreg_getnext__2_entries),
+        new_TestFixture(test_netreg_lookup__other_type),
+        new_TestFixture(test_netreg_lookup__many_entries),
+        new_TestFixture(test_netreg_lookup__benchmark),
     };
 
     EMB_UNIT_TESTCALLER(netreg_tests, set_up, NULL, fixtures);
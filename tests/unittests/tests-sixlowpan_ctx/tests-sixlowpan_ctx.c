@@ -156,6 +156,37 @@ static void test_sixlowpan_ctx_lookup_addr__other_addr_other_prefix(void)
     TEST_ASSERT_NULL(gnrc_sixlowpan_ctx_lookup_addr(&addr));
 }
 
+static void test_sixlowpan_ctx_lookup_addr__longest_prefix(void)
+{
+    ipv6_addr_t addr1 = DEFAULT_TEST_PREFIX;
+    ipv6_addr_t addr2 = WRONG_TEST_PREFIX;
+    ipv6_addr_t addr3 = { { 0x00, 0x01, 0xff, 0xff } };
+    ipv6_addr_t other_prefix = OTHER_TEST_PREFIX;
+    gnrc_sixlowpan_ctx_t *ctx;
+
+    /* nested prefixes: addr1 matches all three, addr2 the shorter two, and
+     * addr3 only the shortest */
+    test_sixlowpan_ctx_update__success();
+    TEST_ASSERT_NOT_NULL(gnrc_sixlowpan_ctx_update(OTHER_TEST_ID, &other_prefix,
+                                                   60, TEST_UINT16, true));
+    TEST_ASSERT_NOT_NULL(gnrc_sixlowpan_ctx_update(0, &addr1, 16,
+                                                   TEST_UINT16, true));
+    TEST_ASSERT_NOT_NULL((ctx = gnrc_sixlowpan_ctx_lookup_addr(&addr1)));
+    TEST_ASSERT_EQUAL_INT(DEFAULT_TEST_ID,
+                          ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_CID_MASK);
+    TEST_ASSERT_NOT_NULL((ctx = gnrc_sixlowpan_ctx_lookup_addr(&addr2)));
+    TEST_ASSERT_EQUAL_INT(OTHER_TEST_ID,
+                          ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_CID_MASK);
+    TEST_ASSERT_NOT_NULL((ctx = gnrc_sixlowpan_ctx_lookup_addr(&addr3)));
+    TEST_ASSERT_EQUAL_INT(0, ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_CID_MASK);
+    gnrc_sixlowpan_ctx_remove(OTHER_TEST_ID);
+    TEST_ASSERT_NOT_NULL((ctx = gnrc_sixlowpan_ctx_lookup_addr(&addr1)));
+    TEST_ASSERT_EQUAL_INT(DEFAULT_TEST_ID,
+                          ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_CID_MASK);
+    TEST_ASSERT_NOT_NULL((ctx = gnrc_sixlowpan_ctx_lookup_addr(&addr2)));
+    TEST_ASSERT_EQUAL_INT(0, ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_CID_MASK);
+}
+
 static void test_sixlowpan_ctx_lookup_id__empty(void)
 {
     TEST_ASSERT_NULL(gnrc_sixlowpan_ctx_lookup_id(DEFAULT_TEST_ID));
@@ -195,6 +226,34 @@ static void test_sixlowpan_ctx_remove(void)
     TEST_ASSERT_NULL(gnrc_sixlowpan_ctx_lookup_addr(&addr));
 }
 
+#if CONFIG_GNRC_SIXLOWPAN_CTX_CACHE_SIZE > 0
+static void test_sixlowpan_ctx_lookup_addr_cached(void)
+{
+    gnrc_sixlowpan_ctx_cache_t cache = { 0 };
+    ipv6_addr_t addr = DEFAULT_TEST_PREFIX;
+    ipv6_addr_t other_prefix = OTHER_TEST_PREFIX;
+    gnrc_sixlowpan_ctx_t *ctx;
+
+    /* an address without context is cached as well */
+    TEST_ASSERT_NULL(gnrc_sixlowpan_ctx_lookup_addr_cached(&cache, &addr));
+    test_sixlowpan_ctx_update__success();
+    ctx = gnrc_sixlowpan_ctx_lookup_addr_cached(&cache, &addr);
+    TEST_ASSERT_NOT_NULL(ctx);
+    TEST_ASSERT_EQUAL_INT(DEFAULT_TEST_ID,
+                          ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_CID_MASK);
+    TEST_ASSERT(ctx == gnrc_sixlowpan_ctx_lookup_addr_cached(&cache, &addr));
+    /* any update drops the cached results */
+    TEST_ASSERT_NOT_NULL(gnrc_sixlowpan_ctx_update(OTHER_TEST_ID, &other_prefix,
+                                                   60, TEST_UINT16, true));
+    ctx = gnrc_sixlowpan_ctx_lookup_addr_cached(&cache, &addr);
+    TEST_ASSERT_NOT_NULL(ctx);
+    TEST_ASSERT(ctx == gnrc_sixlowpan_ctx_lookup_addr(&addr));
+    gnrc_sixlowpan_ctx_remove(DEFAULT_TEST_ID);
+    gnrc_sixlowpan_ctx_remove(OTHER_TEST_ID);
+    TEST_ASSERT_NULL(gnrc_sixlowpan_ctx_lookup_addr_cached(&cache, &addr));
+}
+#endif
+
 Test *tests_sixlowpan_ctx_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -207,10 +266,14 @@ Test *tests_sixlowpan_ctx_tests(void)
         new_TestFixture(test_sixlowpan_ctx_lookup_addr__same_addr),
         new_TestFixture(test_sixlowpan_ctx_lookup_addr__other_addr_same_prefix),
         new_TestFixture(test_sixlowpan_ctx_lookup_addr__other_addr_other_prefix),
+        new_TestFixture(test_sixlowpan_ctx_lookup_addr__longest_prefix),
         new_TestFixture(test_sixlowpan_ctx_lookup_id__empty),
         new_TestFixture(test_sixlowpan_ctx_lookup_id__wrong_id),
         new_TestFixture(test_sixlowpan_ctx_lookup_id__success),
         new_TestFixture(test_sixlowpan_ctx_remove),
+#if CONFIG_GNRC_SIXLOWPAN_CTX_CACHE_SIZE > 0
+        new_TestFixture(test_sixlowpan_ctx_lookup_addr_cached),
+#endif
     };
 
     EMB_UNIT_TESTCALLER(sixlowpan_ctx_tests, NULL, tear_down, fixtures);
@@ -0,0 +1,189 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ * @brief       Unittests for ztimer with the ztimer_wheel backend
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "embUnit.h"
+#include "kernel_defines.h"
+#include "ztimer.h"
+#include "ztimer/mock.h"
+#include "ztimer/wheel.h"
+
+#include "tests-ztimer_wheel.h"
+
+/* a target in [S^l, 2 * S^l) set at time 0 goes to slot 1 of level l */
+#define S               (ZTIMER_WHEEL_SLOTS)
+#define TIMERS_NUMOF    (8U)
+
+static ztimer_mock_t _zmock;
+static ztimer_clock_t *const _z = &_zmock.super;
+static ztimer_t _timers[TIMERS_NUMOF];
+/* indices of the timers in the order they were triggered */
+static unsigned _fired[TIMERS_NUMOF];
+/* time every timer was triggered at */
+static uint32_t _fired_at[TIMERS_NUMOF];
+static unsigned _fired_numof;
+
+static void _cb(void *arg)
+{
+    const unsigned idx = (ztimer_t *)arg - _timers;
+
+    _fired[_fired_numof++] = idx;
+    _fired_at[idx] = ztimer_now(_z);
+}
+
+static void set_up(void)
+{
+    ztimer_mock_init(&_zmock, 32);
+    memset(_timers, 0, sizeof(_timers));
+    for (unsigned i = 0; i < TIMERS_NUMOF; i++) {
+        _timers[i].callback = _cb;
+        _timers[i].arg = &_timers[i];
+    }
+    memset(_fired, 0, sizeof(_fired));
+    memset(_fired_at, 0, sizeof(_fired_at));
+    _fired_numof = 0;
+}
+
+static void test_ztimer_wheel_order(void)
+{
+    /* spread over several levels, set in no particular order and with a
+     * base time not aligned to any slot */
+    static const uint32_t targets[] = {
+        259, 5, 16, 1, 4097, 15, 32, 70000,
+    };
+    static const unsigned order[] = { 3, 1, 5, 2, 6, 0, 4, 7 };
+    const uint32_t start = 0x12345;
+
+    ztimer_mock_advance(&_zmock, start);
+    for (unsigned i = 0; i < ARRAY_SIZE(targets); i++) {
+        ztimer_set(_z, &_timers[i], targets[i]);
+    }
+    ztimer_mock_advance(&_zmock, 69999);
+    TEST_ASSERT_EQUAL_INT(ARRAY_SIZE(targets) - 1, _fired_numof);
+    ztimer_mock_advance(&_zmock, 1);
+    TEST_ASSERT_EQUAL_INT(ARRAY_SIZE(targets), _fired_numof);
+    for (unsigned i = 0; i < ARRAY_SIZE(targets); i++) {
+        TEST_ASSERT_EQUAL_INT(order[i], _fired[i]);
+        TEST_ASSERT_EQUAL_INT(start + targets[i], _fired_at[i]);
+    }
+    TEST_ASSERT(ztimer_wheel_is_empty(_z));
+}
+
+static void test_ztimer_wheel_cascade(void)
+{
+    /* lands in slot 1 of every level from 3 down to 0 */
+    const uint32_t target = (S * S * S) + (S * S) + S + 1;
+
+    ztimer_set(_z, &_timers[0], target);
+    TEST_ASSERT_EQUAL_INT(1U << 1, _z->wheel.occupied[3]);
+    ztimer_mock_advance(&_zmock, (S * S * S) - 1);
+    TEST_ASSERT_EQUAL_INT(1U << 1, _z->wheel.occupied[3]);
+    /* start of the slot moves the timer one level down */
+    ztimer_mock_advance(&_zmock, 1);
+    TEST_ASSERT_EQUAL_INT(0, _z->wheel.occupied[3]);
+    TEST_ASSERT_EQUAL_INT(1U << 1, _z->wheel.occupied[2]);
+    ztimer_mock_advance(&_zmock, S * S);
+    TEST_ASSERT_EQUAL_INT(0, _z->wheel.occupied[2]);
+    TEST_ASSERT_EQUAL_INT(1U << 1, _z->wheel.occupied[1]);
+    ztimer_mock_advance(&_zmock, S);
+    TEST_ASSERT_EQUAL_INT(0, _z->wheel.occupied[1]);
+    TEST_ASSERT_EQUAL_INT(1U << 1, _z->wheel.occupied[0]);
+    TEST_ASSERT_EQUAL_INT(0, _fired_numof);
+    ztimer_mock_advance(&_zmock, 1);
+    TEST_ASSERT_EQUAL_INT(1, _fired_numof);
+    TEST_ASSERT_EQUAL_INT(target, _fired_at[0]);
+    TEST_ASSERT(ztimer_wheel_is_empty(_z));
+}
+
+static void test_ztimer_wheel_remove_first_last(void)
+{
+    /* all in slot 1 of level 2, the slot starts with the timer set last */
+    for (unsigned i = 0; i < 3; i++) {
+        ztimer_set(_z, &_timers[i], (S * S) + i);
+    }
+    TEST_ASSERT(_z->wheel.slots[2][1] == &_timers[2].base);
+    TEST_ASSERT_NULL(_timers[0].base.next);
+    ztimer_remove(_z, &_timers[2]);
+    ztimer_remove(_z, &_timers[0]);
+    TEST_ASSERT(_z->wheel.slots[2][1] == &_timers[1].base);
+    TEST_ASSERT_NULL(_timers[1].base.next);
+    TEST_ASSERT_EQUAL_INT(1U << 1, _z->wheel.occupied[2]);
+    ztimer_mock_advance(&_zmock, (S * S) + 2);
+    TEST_ASSERT_EQUAL_INT(1, _fired_numof);
+    TEST_ASSERT_EQUAL_INT(1, _fired[0]);
+    TEST_ASSERT_EQUAL_INT((S * S) + 1, _fired_at[1]);
+    TEST_ASSERT(ztimer_wheel_is_empty(_z));
+}
+
+static void test_ztimer_wheel_remove_only(void)
+{
+    ztimer_set(_z, &_timers[0], S);
+    ztimer_set(_z, &_timers[1], S * S);
+    TEST_ASSERT_EQUAL_INT(S, _zmock.target);
+    ztimer_remove(_z, &_timers[0]);
+    TEST_ASSERT_EQUAL_INT(0, _z->wheel.occupied[1]);
+    TEST_ASSERT_EQUAL_INT(1U << 1, _z->wheel.occupied[2]);
+    /* clock is set to the remaining timer */
+    TEST_ASSERT_EQUAL_INT(S * S, _zmock.target);
+    ztimer_mock_advance(&_zmock, S * S);
+    TEST_ASSERT_EQUAL_INT(1, _fired_numof);
+    TEST_ASSERT_EQUAL_INT(1, _fired[0]);
+    TEST_ASSERT(ztimer_wheel_is_empty(_z));
+}
+
+static void test_ztimer_wheel_beyond_range(void)
+{
+    /* more than half of the clock's range ahead, the target wraps around to
+     * just before the base time and would share its slots */
+    const uint32_t start = 0x90000100;
+    const uint32_t far = UINT32_MAX - 0xff;
+
+    ztimer_mock_advance(&_zmock, start);
+    ztimer_set(_z, &_timers[0], far);
+    ztimer_set(_z, &_timers[1], 100);
+    ztimer_mock_advance(&_zmock, 100);
+    TEST_ASSERT_EQUAL_INT(1, _fired_numof);
+    TEST_ASSERT_EQUAL_INT(1, _fired[0]);
+    ztimer_mock_advance(&_zmock, far - 101);
+    TEST_ASSERT_EQUAL_INT(1, _fired_numof);
+    ztimer_mock_advance(&_zmock, 1);
+    TEST_ASSERT_EQUAL_INT(2, _fired_numof);
+    TEST_ASSERT_EQUAL_INT(0, _fired[1]);
+    TEST_ASSERT_EQUAL_INT((uint32_t)(start + far), _fired_at[0]);
+    TEST_ASSERT(ztimer_wheel_is_empty(_z));
+}
+
+Test *tests_ztimer_wheel_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_ztimer_wheel_order),
+        new_TestFixture(test_ztimer_wheel_cascade),
+        new_TestFixture(test_ztimer_wheel_remove_first_last),
+        new_TestFixture(test_ztimer_wheel_remove_only),
+        new_TestFixture(test_ztimer_wheel_beyond_range),
+    };
+
+    EMB_UNIT_TESTCALLER(ztimer_wheel_tests, set_up, NULL, fixtures);
+
+    return (Test *)&ztimer_wheel_tests;
+}
+
+void tests_ztimer_wheel(void)
+{
+    TESTS_RUN(tests_ztimer_wheel_tests());
+}
+/** @} */